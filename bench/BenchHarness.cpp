@@ -0,0 +1,147 @@
+#include "BenchHarness.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <thread>
+
+#ifndef LOOM_GIT_REVISION
+#define LOOM_GIT_REVISION "unknown"
+#endif
+
+namespace ethereal {
+namespace bench {
+
+namespace {
+
+struct Registration {
+    std::string name;
+    BenchmarkFn fn;
+    int64_t arg;
+};
+
+std::vector<Registration>& registry() {
+    static std::vector<Registration> benchmarks;
+    return benchmarks;
+}
+
+bool startsWith(const std::string& text, const char* prefix, std::string& rest) {
+    size_t length = std::char_traits<char>::length(prefix);
+    if (text.compare(0, length, prefix) != 0) return false;
+    rest = text.substr(length);
+    return true;
+}
+
+} // namespace
+
+void registerBenchmark(const std::string& name, BenchmarkFn fn, std::vector<int64_t> args) {
+    if (args.empty()) {
+        registry().push_back({name, std::move(fn), 0});
+        return;
+    }
+    for (int64_t arg : args) {
+        registry().push_back({name + "/" + std::to_string(arg), fn, arg});
+    }
+}
+
+bool parseOptions(int argc, char** argv, RunOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        std::string value;
+        if (startsWith(argument, "--json=", value)) {
+            options.jsonPath = value;
+        } else if (startsWith(argument, "--filter=", value)) {
+            options.filter = value;
+        } else if (startsWith(argument, "--min-time=", value)) {
+            options.minTimeSeconds = std::max(0.001, std::atof(value.c_str()));
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter=substring] [--min-time=seconds] [--json=path]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<BenchmarkResult> runAll(const RunOptions& options) {
+    std::vector<BenchmarkResult> results;
+    std::printf("%-44s %14s %12s %16s\n", "Benchmark", "Time (ns)", "Iterations", "Items/s");
+
+    for (const auto& benchmark : registry()) {
+        if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos) continue;
+
+        // Grow the batch until it runs long enough to time reliably
+        uint64_t iterations = 1;
+        for (;;) {
+            State state(iterations, benchmark.arg);
+            benchmark.fn(state);
+            double seconds = state.elapsedSeconds();
+
+            if (seconds >= options.minTimeSeconds || iterations >= (1ull << 32)) {
+                BenchmarkResult result;
+                result.name = benchmark.name;
+                result.iterations = state.iterations();
+                result.nsPerIteration = seconds * 1e9 / std::max<uint64_t>(state.iterations(), 1);
+                result.cpuNsPerIteration = state.cpuSeconds() * 1e9 / std::max<uint64_t>(state.iterations(), 1);
+                if (state.getItemsPerIteration() > 0.0 && seconds > 0.0) {
+                    result.itemsPerSecond = state.getItemsPerIteration() * state.iterations() / seconds;
+                }
+                std::printf("%-44s %14.1f %12llu %16.4g\n", result.name.c_str(), result.nsPerIteration,
+                            static_cast<unsigned long long>(result.iterations), result.itemsPerSecond);
+                results.push_back(result);
+                break;
+            }
+
+            // Aim 40% past the target so the next batch is usually the last
+            double perIteration = seconds / iterations;
+            uint64_t next = perIteration > 0.0
+                ? static_cast<uint64_t>(options.minTimeSeconds * 1.4 / perIteration)
+                : iterations * 10;
+            iterations = std::clamp<uint64_t>(next, iterations * 2, iterations * 100);
+        }
+    }
+    return results;
+}
+
+bool writeJson(const std::string& path, const std::vector<BenchmarkResult>& results) {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    // Same layout as Google Benchmark's JSON reporter, so existing comparison tools work
+    out << std::setprecision(10);
+    out << "{\n  \"context\": {\n"
+        << "    \"date\": \"" << date << "\",\n"
+        << "    \"git_revision\": \"" << LOOM_GIT_REVISION << "\",\n"
+        << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+#if defined(NDEBUG)
+        << "    \"library_build_type\": \"release\"\n"
+#else
+        << "    \"library_build_type\": \"debug\"\n"
+#endif
+        << "  },\n  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& r = results[i];
+        out << (i > 0 ? "," : "") << "\n    {\n"
+            << "      \"name\": \"" << r.name << "\",\n"
+            << "      \"run_type\": \"iteration\",\n"
+            << "      \"iterations\": " << r.iterations << ",\n"
+            << "      \"real_time\": " << r.nsPerIteration << ",\n"
+            << "      \"cpu_time\": " << r.cpuNsPerIteration << ",\n"
+            << "      \"time_unit\": \"ns\"";
+        if (r.itemsPerSecond > 0.0) {
+            out << ",\n      \"items_per_second\": " << r.itemsPerSecond;
+        }
+        out << "\n    }";
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+} // namespace bench
+} // namespace ethereal
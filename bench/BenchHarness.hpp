@@ -0,0 +1,91 @@
+#pragma once
+#include <chrono>
+#include <ctime>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ethereal {
+namespace bench {
+
+// Minimal Google Benchmark-style harness: each benchmark body runs
+// `while (state.keepRunning())` and the harness grows the iteration count
+// until one batch takes at least the minimum time.
+class State {
+public:
+    State(uint64_t iterations, int64_t arg) : maxIterations(iterations), argument(arg) {}
+
+    bool keepRunning() {
+        if (!started) {
+            started = true;
+            cpuStart = std::clock();
+            start = Clock::now();
+        }
+        if (completed < maxIterations) {
+            ++completed;
+            return true;
+        }
+        stop = Clock::now();
+        cpuStop = std::clock();
+        return false;
+    }
+
+    int64_t arg() const { return argument; }
+    uint64_t iterations() const { return completed; }
+    double elapsedSeconds() const { return std::chrono::duration<double>(stop - start).count(); }
+    double cpuSeconds() const { return static_cast<double>(cpuStop - cpuStart) / CLOCKS_PER_SEC; }
+
+    // Per iteration; reported as a rate
+    void setItemsPerIteration(double items) { itemsPerIteration = items; }
+    double getItemsPerIteration() const { return itemsPerIteration; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    uint64_t maxIterations;
+    uint64_t completed = 0;
+    int64_t argument;
+    bool started = false;
+    double itemsPerIteration = 0.0;
+    Clock::time_point start;
+    Clock::time_point stop;
+    std::clock_t cpuStart = 0;
+    std::clock_t cpuStop = 0;
+};
+
+using BenchmarkFn = std::function<void(State&)>;
+
+struct BenchmarkResult {
+    std::string name;
+    uint64_t iterations = 0;
+    double nsPerIteration = 0.0;
+    double cpuNsPerIteration = 0.0;     // Process CPU time, all threads
+    double itemsPerSecond = 0.0;
+};
+
+struct RunOptions {
+    double minTimeSeconds = 0.25;
+    std::string filter;             // Substring match on the full name
+    std::string jsonPath;           // Empty = console only
+};
+
+// Register `fn` once per argument as "name/arg" (or just "name" when args is empty)
+void registerBenchmark(const std::string& name, BenchmarkFn fn, std::vector<int64_t> args = {});
+
+bool parseOptions(int argc, char** argv, RunOptions& options);
+std::vector<BenchmarkResult> runAll(const RunOptions& options);
+bool writeJson(const std::string& path, const std::vector<BenchmarkResult>& results);
+
+// Keeps the optimizer from discarding a computed value
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+} // namespace bench
+} // namespace ethereal
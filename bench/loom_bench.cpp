@@ -0,0 +1,809 @@
+#include "BenchHarness.hpp"
+#include "audio/WindSoundSynthesizer.hpp"
+#include "entities/Character3D.hpp"
+#include "entities/FlightController3D.hpp"
+#include "entities/FlyerCrowd3D.hpp"
+#include "entities/FlyerSnapshot.hpp"
+#include "core/Matrix4.hpp"
+#include "core/Quaternion.hpp"
+#include "environment/Terrain.hpp"
+#include "physics/Cape3D.hpp"
+#include "physics/ClothWorld.hpp"
+#include "physics/WindField3D.hpp"
+#include "rendering/ViewCuller.hpp"
+#include "utils/FractalNoise.hpp"
+#include "utils/FrameArena.hpp"
+#include "utils/JobSystem.hpp"
+#include "utils/PerlinNoise.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace ethereal;
+using namespace ethereal::bench;
+
+namespace {
+
+// Cape grids: rows x columns = arg x (arg * 5 / 7), starting at the default 14 x 10
+CapeConfig3D capeConfigFor(int64_t segments) {
+    CapeConfig3D config;
+    config.segments = static_cast<int>(segments);
+    config.width = static_cast<int>(segments * 5 / 7);
+    return config;
+}
+
+// Settled wind field so the benchmarks do not time start-up transients
+WindField3D makeWindField() {
+    WindField3D wind;
+    for (int i = 0; i < 60; ++i) wind.update(1.0f / 60.0f);
+    return wind;
+}
+
+std::vector<Vector3D> makeSamplePositions(size_t count) {
+    std::vector<Vector3D> positions(count);
+    for (size_t i = 0; i < count; ++i) {
+        float t = static_cast<float>(i);
+        positions[i] = Vector3D(std::fmod(t * 7.31f, 800.0f) - 400.0f,
+                                50.0f + std::fmod(t * 3.17f, 200.0f),
+                                std::fmod(t * 5.93f, 800.0f) - 400.0f);
+    }
+    return positions;
+}
+
+// === Math ===
+
+Matrix4 makeViewProjection(float t) {
+    Matrix4 view = Matrix4::lookAt(Vector3D(std::cos(t) * 50.0f, 20.0f, std::sin(t) * 50.0f), Vector3D::zero(), Vector3D(0, 1, 0));
+    return Matrix4::perspective(1.1f, 16.0f / 9.0f, 0.1f, 1000.0f) * view;
+}
+
+void benchMatrixMultiply(State& state) {
+    Matrix4 a = makeViewProjection(0.3f);
+    Matrix4 b = ethereal::Quaternion::fromAxisAngle(Vector3D(1, 2, 3), 0.7f).toMatrix();
+    while (state.keepRunning()) {
+        a = a * b;
+        doNotOptimize(a);
+    }
+}
+
+void benchMatrixInverse(State& state) {
+    Matrix4 a = makeViewProjection(0.3f);
+    while (state.keepRunning()) {
+        a = a.inverted();
+        doNotOptimize(a);
+    }
+}
+
+void benchTransformPoints(State& state) {
+    const size_t count = static_cast<size_t>(state.arg());
+    std::vector<float> x(count), y(count), z(count), ox(count), oy(count), oz(count);
+    for (size_t i = 0; i < count; ++i) {
+        x[i] = std::cos(i * 0.37f) * 30.0f;
+        y[i] = (i % 17) * 2.0f;
+        z[i] = std::sin(i * 0.37f) * 30.0f;
+    }
+    Matrix4 m = makeViewProjection(0.3f);
+    state.setItemsPerIteration(static_cast<double>(count));
+    while (state.keepRunning()) {
+        m.transformPoints(x.data(), y.data(), z.data(), ox.data(), oy.data(), oz.data(), count);
+        doNotOptimize(ox.data()[0]);
+    }
+}
+
+void benchVectorNormalize(State& state) {
+    const size_t count = static_cast<size_t>(state.arg());
+    std::vector<Vector3D> vectors(count);
+    for (size_t i = 0; i < count; ++i) vectors[i] = Vector3D(std::cos(i * 0.1f), (i % 7) * 0.3f, std::sin(i * 0.2f) + 2.0f);
+    state.setItemsPerIteration(static_cast<double>(count));
+    while (state.keepRunning()) {
+        Vector3D sum;
+        for (const Vector3D& v : vectors) sum += v.normalized();
+        doNotOptimize(sum);
+    }
+}
+
+void benchVectorNormalizeFast(State& state) {
+    const size_t count = static_cast<size_t>(state.arg());
+    std::vector<Vector3D> vectors(count);
+    for (size_t i = 0; i < count; ++i) vectors[i] = Vector3D(std::cos(i * 0.1f), (i % 7) * 0.3f, std::sin(i * 0.2f) + 2.0f);
+    state.setItemsPerIteration(static_cast<double>(count));
+    while (state.keepRunning()) {
+        Vector3D sum;
+        for (const Vector3D& v : vectors) sum += v.normalizedFast();
+        doNotOptimize(sum);
+    }
+}
+
+// === Cloth ===
+
+void benchCapeUpdate(State& state) {
+    WindField3D wind = makeWindField();
+    Cape3D cape(Vector3D(0, 100, 0), Vector3D(0, 0, 1), capeConfigFor(state.arg()));
+    state.setItemsPerIteration(static_cast<double>(cape.getSegments() * cape.getWidth()));
+    while (state.keepRunning()) {
+        cape.update(1.0f / 60.0f, wind);
+    }
+}
+
+void benchCapeUpdateParallel(State& state) {
+    static JobSystem jobs;
+    WindField3D wind = makeWindField();
+    Cape3D cape(Vector3D(0, 100, 0), Vector3D(0, 0, 1), capeConfigFor(state.arg()));
+    state.setItemsPerIteration(static_cast<double>(cape.getSegments() * cape.getWidth()));
+    while (state.keepRunning()) {
+        cape.update(1.0f / 60.0f, wind, jobs);
+    }
+}
+
+void benchCapeSolve(State& state) {
+    WindField3D wind = makeWindField();
+    Cape3D cape(Vector3D(0, 100, 0), Vector3D(0, 0, 1), capeConfigFor(state.arg()));
+    cape.update(1.0f / 60.0f, wind);
+    state.setItemsPerIteration(static_cast<double>(cape.getSegments() * cape.getWidth()));
+    while (state.keepRunning()) {
+        cape.solveConstraints(5);
+    }
+}
+
+void benchCapeSolveParallel(State& state) {
+    static JobSystem jobs;
+    WindField3D wind = makeWindField();
+    Cape3D cape(Vector3D(0, 100, 0), Vector3D(0, 0, 1), capeConfigFor(state.arg()));
+    cape.update(1.0f / 60.0f, wind);
+    state.setItemsPerIteration(static_cast<double>(cape.getSegments() * cape.getWidth()));
+    while (state.keepRunning()) {
+        cape.solveConstraints(5, jobs);
+    }
+}
+
+// One full frame: force gather plus all substeps
+void benchCapeXPBD(State& state) {
+    WindField3D wind = makeWindField();
+    CapeConfig3D config = capeConfigFor(state.arg());
+    config.solver = ClothSolver3D::XPBD;
+    Cape3D cape(Vector3D(0, 100, 0), Vector3D(0, 0, 1), config);
+    state.setItemsPerIteration(static_cast<double>(cape.getSegments() * cape.getWidth()));
+    while (state.keepRunning()) {
+        cape.update(1.0f / 60.0f, wind);
+        cape.solveConstraints();
+    }
+}
+
+void benchCapeCollisions(State& state) {
+    WindField3D wind = makeWindField();
+    Cape3D cape(Vector3D(0, 100, 0), Vector3D(0, 0, 1), capeConfigFor(state.arg()));
+    ClothColliders3D colliders;
+    colliders.capsules.push_back({Vector3D(0, 95, 0), Vector3D(0, 105, 0), 5.0f});
+    colliders.groundHeights = [](const float*, const float*, float* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) out[i] = 0.0f;
+    };
+    cape.setColliders(&colliders);
+    cape.update(1.0f / 60.0f, wind);
+    state.setItemsPerIteration(static_cast<double>(cape.getSegments() * cape.getWidth()));
+    while (state.keepRunning()) {
+        cape.solveCollisions();
+    }
+}
+
+// A row of small banners receding from a viewer; arg 0 simulates all of them
+// at full rate, arg 1 enables sleep and distance LOD
+void benchClothWorldBanners(State& state) {
+    WindField3D wind = makeWindField();
+    ClothWorldConfig worldConfig;
+    worldConfig.allowSleep = state.arg() != 0;
+    ClothWorld world(worldConfig);
+    CapeConfig3D banner = capeConfigFor(7);
+    for (int i = 0; i < 32; ++i) {
+        world.addCape(Vector3D(i * 60.0f, 100, 0), Vector3D(0, -1, 0.01f), banner);
+    }
+    if (state.arg() != 0) world.setViewer(Vector3D(-50, 100, 0), Vector3D(1, 0, 0));
+    state.setItemsPerIteration(static_cast<double>(world.getCapeCount()));
+    while (state.keepRunning()) {
+        world.step(1.0f / 60.0f, wind);
+    }
+}
+
+// === Wind ===
+
+void benchWindScalar(State& state) {
+    WindField3D wind = makeWindField();
+    std::vector<Vector3D> positions = makeSamplePositions(1024);
+    state.setItemsPerIteration(static_cast<double>(positions.size()));
+    while (state.keepRunning()) {
+        for (const Vector3D& p : positions) {
+            Vector3D w = wind.getWindAt(p);
+            doNotOptimize(w);
+        }
+    }
+}
+
+void benchWindBatch(State& state) {
+    WindField3D wind = makeWindField();
+    std::vector<Vector3D> positions = makeSamplePositions(static_cast<size_t>(state.arg()));
+    std::vector<Vector3D> out(positions.size());
+    state.setItemsPerIteration(static_cast<double>(positions.size()));
+    while (state.keepRunning()) {
+        wind.getWindAt(positions.data(), out.data(), positions.size());
+        doNotOptimize(out.front());
+    }
+}
+
+// Storm: arg gusts plus a vortex column per eight, scattered over the sample area
+void benchWindStorm(State& state) {
+    WindField3D wind = makeWindField();
+    for (int i = 0; i < state.arg(); ++i) {
+        float t = static_cast<float>(i);
+        Vector3D center(std::fmod(t * 211.7f, 800.0f) - 400.0f, 120.0f, std::fmod(t * 137.3f, 800.0f) - 400.0f);
+        wind.addGust(center, Vector3D(1.0f, 0.2f, 0.5f), 80.0f, 60.0f, 4.0f);
+        if (i % 8 == 0) wind.addVortex(center, Vector3D(0, 1, 0), 60.0f, 80.0f, 5.0f);
+    }
+    wind.update(1.0f / 60.0f);
+    std::vector<Vector3D> positions = makeSamplePositions(4096);
+    std::vector<Vector3D> out(positions.size());
+    state.setItemsPerIteration(static_cast<double>(positions.size()));
+    while (state.keepRunning()) {
+        wind.getWindAt(positions.data(), out.data(), positions.size());
+        doNotOptimize(out.front());
+    }
+}
+
+void benchWindUpdate(State& state) {
+    WindField3D wind = makeWindField();
+    while (state.keepRunning()) {
+        wind.update(1.0f / 60.0f);
+    }
+}
+
+// === Terrain ===
+
+void benchTerrainGenerate(State& state) {
+    TerrainConfig config;
+    config.gridSize = static_cast<int>(state.arg());
+    Terrain terrain(config);
+    state.setItemsPerIteration(static_cast<double>((config.gridSize + 1) * (config.gridSize + 1)));
+    uint32_t seed = 1;
+    while (state.keepRunning()) {
+        terrain.generate(seed++);
+    }
+}
+
+void benchTerrainGenerateParallel(State& state) {
+    static JobSystem jobs;
+    TerrainConfig config;
+    config.gridSize = static_cast<int>(state.arg());
+    Terrain terrain(config);
+    state.setItemsPerIteration(static_cast<double>((config.gridSize + 1) * (config.gridSize + 1)));
+    uint32_t seed = 1;
+    while (state.keepRunning()) {
+        terrain.generate(seed++, jobs);
+    }
+}
+
+void benchTerrainLoadCache(State& state) {
+    TerrainConfig config;
+    config.gridSize = static_cast<int>(state.arg());
+    Terrain terrain(config);
+    const std::string path = "loom_bench_terrain.cache";
+    terrain.generate(12345);
+    if (!terrain.saveCache(path)) return;
+    state.setItemsPerIteration(static_cast<double>((config.gridSize + 1) * (config.gridSize + 1)));
+    while (state.keepRunning()) {
+        terrain.loadCache(path, 12345);
+    }
+    std::remove(path.c_str());
+}
+
+// Streamed chunk through the on-disk cache; 0: every call hits, 1: every call misses
+// (the file is deleted first) and regenerates and rewrites it
+void benchTerrainChunkCached(State& state) {
+    const bool hit = state.arg() == 0;
+    TerrainConfig config;
+    Terrain terrain(config);
+    terrain.reseed(12345);
+    const std::string directory = ".";
+    TerrainChunk chunk;
+    if (terrain.generateChunkCached(3, -2, directory, chunk)) std::fprintf(stderr, "generateChunkCached: stale cache file\n");
+    const std::string path = terrain.chunkCachePath(3, -2, directory);
+    state.setItemsPerIteration(static_cast<double>((config.chunkResolution + 1) * (config.chunkResolution + 1)));
+
+    int unexpected = 0;
+    while (state.keepRunning()) {
+        if (!hit) std::remove(path.c_str());
+        if (terrain.generateChunkCached(3, -2, directory, chunk) != hit) unexpected++;
+    }
+    if (unexpected > 0) std::fprintf(stderr, "generateChunkCached: %d unexpected hits or misses\n", unexpected);
+    std::remove(path.c_str());
+}
+
+void benchTerrainChunk(State& state) {
+    TerrainConfig config;
+    config.chunkResolution = static_cast<int>(state.arg());
+    Terrain terrain(config);
+    terrain.reseed(12345);
+    TerrainChunk chunk;
+    int index = 0;
+    state.setItemsPerIteration(static_cast<double>((config.chunkResolution + 1) * (config.chunkResolution + 1)));
+    while (state.keepRunning()) {
+        terrain.generateChunk(index % 16, index / 16, chunk);
+        ++index;
+    }
+}
+
+// === Character ===
+
+// Arg = trail capacity; one point is pushed every step at full speed
+// Camera-style rays: from above the patch toward a random ground point
+struct TerrainRays {
+    std::vector<Vector3D> origins;
+    std::vector<Vector3D> directions;
+};
+
+TerrainRays makeTerrainRays(const Terrain& terrain, size_t count) {
+    TerrainRays rays;
+    float half = terrain.getTotalSize() * 0.45f;
+    for (size_t i = 0; i < count; ++i) {
+        float a = static_cast<float>(i) * 2.399f;
+        Vector3D origin(std::cos(a) * half * 0.5f, 300.0f, std::sin(a) * half * 0.5f);
+        Vector3D target(std::sin(a * 1.7f) * half, -100.0f, std::cos(a * 1.3f) * half);
+        rays.origins.push_back(origin);
+        rays.directions.push_back((target - origin).normalized());
+    }
+    return rays;
+}
+
+// Arg = grid size of the generated patch
+void benchTerrainRaycast(State& state) {
+    TerrainConfig config;
+    config.gridSize = static_cast<int>(state.arg());
+    Terrain terrain(config);
+    terrain.generate(12345);
+    TerrainRays rays = makeTerrainRays(terrain, 256);
+    state.setItemsPerIteration(static_cast<double>(rays.origins.size()));
+    while (state.keepRunning()) {
+        int hits = 0;
+        TerrainRayHit hit;
+        for (size_t i = 0; i < rays.origins.size(); ++i) {
+            hits += terrain.raycast(rays.origins[i], rays.directions[i], 4000.0f, hit);
+        }
+        doNotOptimize(hits);
+    }
+}
+
+// Baseline: march the exact heights one tile per step
+void benchTerrainRaymarch(State& state) {
+    TerrainConfig config;
+    config.gridSize = static_cast<int>(state.arg());
+    Terrain terrain(config);
+    terrain.generate(12345);
+    TerrainRays rays = makeTerrainRays(terrain, 256);
+    state.setItemsPerIteration(static_cast<double>(rays.origins.size()));
+    while (state.keepRunning()) {
+        int hits = 0;
+        for (size_t i = 0; i < rays.origins.size(); ++i) {
+            for (float t = 0.0f; t < 4000.0f; t += config.tileSize) {
+                Vector3D p = rays.origins[i] + rays.directions[i] * t;
+                if (p.y <= terrain.getHeightAt(p.x, p.z)) {
+                    hits++;
+                    break;
+                }
+            }
+        }
+        doNotOptimize(hits);
+    }
+}
+
+void benchCharacterTrail(State& state) {
+    CharacterConfig3D config;
+    config.trailLength = static_cast<int>(state.arg());
+    Character3D character(Vector3D(0, 100, 0), config);
+    character.setVelocity(Vector3D(config.maxSpeed, 0, 0));
+    for (int i = 0; i < config.trailLength; ++i) character.update(1.0f / 60.0f);
+    while (state.keepRunning()) {
+        character.applyForce(Vector3D(config.acceleration, 0, 0));
+        character.update(1.0f / 60.0f);
+        doNotOptimize(character.getTrailBuffer().size());
+    }
+}
+
+// Arg = flyers. One Character3D + FlightController3D per flyer, as the player runs
+void benchFlyersObjects(State& state) {
+    WindField3D wind = makeWindField();
+    size_t count = static_cast<size_t>(state.arg());
+    std::vector<Vector3D> starts = makeSamplePositions(count);
+    std::vector<Character3D> characters;
+    characters.reserve(count);
+    for (const Vector3D& start : starts) characters.emplace_back(start);
+    std::vector<FlightController3D> controllers;
+    controllers.reserve(count);
+    for (Character3D& character : characters) controllers.emplace_back(&character, FlightConfig3D{});
+    state.setItemsPerIteration(static_cast<double>(count));
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < count; ++i) {
+            controllers[i].updateMouseControl(1.0f, 0.0f, true, 1.0f / 60.0f);
+            controllers[i].update(1.0f / 60.0f, wind);
+            characters[i].update(1.0f / 60.0f);
+        }
+        doNotOptimize(characters.back().getPosition());
+    }
+}
+
+FlyerCrowd3D makeCrowd(size_t count) {
+    FlyerCrowd3D crowd;
+    for (const Vector3D& start : makeSamplePositions(count)) crowd.spawn(start, Vector3D(0, 0, 60));
+    crowd.setLeader(Vector3D(0, 150, 0));
+    return crowd;
+}
+
+void benchFlyerCrowd(State& state) {
+    WindField3D wind = makeWindField();
+    FlyerCrowd3D crowd = makeCrowd(static_cast<size_t>(state.arg()));
+    state.setItemsPerIteration(static_cast<double>(crowd.size()));
+    while (state.keepRunning()) {
+        crowd.update(1.0f / 60.0f, wind);
+        doNotOptimize(crowd.positionsX()[0]);
+    }
+}
+
+void benchFlyerCrowdParallel(State& state) {
+    static JobSystem jobs;
+    WindField3D wind = makeWindField();
+    FlyerCrowd3D crowd = makeCrowd(static_cast<size_t>(state.arg()));
+    state.setItemsPerIteration(static_cast<double>(crowd.size()));
+    while (state.keepRunning()) {
+        crowd.update(1.0f / 60.0f, wind, jobs);
+        doNotOptimize(crowd.positionsX()[0]);
+    }
+}
+
+// Arg = flyers. Each tick encodes every flyer against the tick acknowledged six
+// ticks ago (100 ms round trip) and decodes it again, as a relay would
+void benchFlyerSnapshots(State& state) {
+    const size_t count = static_cast<size_t>(state.arg());
+    std::vector<Vector3D> starts = makeSamplePositions(count);
+    std::vector<FlyerSnapshotEncoder> encoders(count);
+    std::vector<FlyerSnapshotDecoder> decoders(count);
+    std::vector<FlyerNetState> flyers(count);
+    for (size_t i = 0; i < count; ++i) flyers[i].character.position = starts[i];
+
+    BitWriter packet;
+    uint16_t tick = 0;
+    state.setItemsPerIteration(static_cast<double>(count));
+    while (state.keepRunning()) {
+        packet.clear();
+        for (size_t i = 0; i < count; ++i) {
+            CharacterState3D& character = flyers[i].character;
+            float yaw = tick * 0.01f + i;
+            character.velocity = Vector3D(std::sin(yaw) * 120.0f, std::sin(tick * 0.02f) * 15.0f, std::cos(yaw) * 120.0f);
+            character.position += character.velocity * (1.0f / 60.0f);
+            character.rotation = ethereal::Quaternion::fromEuler(0.0f, yaw, std::sin(tick * 0.05f) * 0.6f);
+            encoders[i].encode(tick, flyers[i], packet);
+        }
+
+        BitReader reader(packet.getData().data(), packet.getByteCount());
+        for (size_t i = 0; i < count; ++i) {
+            FlyerNetState decoded;
+            uint16_t decodedTick;
+            if (decoders[i].decode(reader, decoded, decodedTick) && tick >= 6) {
+                encoders[i].acknowledge(static_cast<uint16_t>(decodedTick - 6));
+            }
+        }
+        doNotOptimize(packet.getByteCount());
+        tick++;
+    }
+}
+
+// === Culling ===
+
+void benchFrustumSpheres(State& state) {
+    const size_t count = static_cast<size_t>(state.arg());
+    std::vector<float> x(count), y(count), z(count), radius(count);
+    for (size_t i = 0; i < count; ++i) {
+        float angle = i * 2.39996f;
+        float distance = 20.0f + (i % 97) * 10.0f;
+        x[i] = std::cos(angle) * distance;
+        y[i] = 40.0f + (i % 13) * 15.0f;
+        z[i] = std::sin(angle) * distance;
+        radius[i] = 2.0f + (i % 7);
+    }
+    std::vector<uint8_t> visible(count);
+    Frustum frustum = Frustum::fromCamera(Vector3D(0, 80, 0), Vector3D(0, 60, -100), 65.0f, 16.0f / 9.0f, 0.01f, 1000.0f);
+    state.setItemsPerIteration(static_cast<double>(count));
+    while (state.keepRunning()) {
+        doNotOptimize(frustum.testSpheres(x.data(), y.data(), z.data(), radius.data(), visible.data(), count));
+    }
+}
+
+// Arg = chunk radius: (2r + 1)^2 chunks feed occluders, then 16 boxes per chunk are tested
+void benchViewCullerTerrain(State& state) {
+    const int chunkRadius = static_cast<int>(state.arg());
+    TerrainConfig config;
+    config.chunkResolution = 32;
+    Terrain terrain(config);
+    terrain.reseed(12345);
+    std::vector<TerrainChunk> chunks((2 * chunkRadius + 1) * (2 * chunkRadius + 1));
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        terrain.generateChunk(static_cast<int>(i % (2 * chunkRadius + 1)) - chunkRadius,
+                              static_cast<int>(i / (2 * chunkRadius + 1)) - chunkRadius, chunks[i]);
+    }
+    // Height bounds of each chunk's 4 x 4 blocks, like TerrainLodMesh's quadrants
+    std::vector<Vector3D> boxes;
+    for (const TerrainChunk& chunk : chunks) {
+        const HeightTile& tile = chunk.heights;
+        const int block = tile.resolution / 4;
+        for (int q = 0; q < 16; ++q) {
+            int x0 = (q % 4) * block;
+            int z0 = (q / 4) * block;
+            float low = tile.heights[z0 * (tile.resolution + 1) + x0];
+            float high = low;
+            for (int z = z0; z <= z0 + block; ++z) {
+                for (int x = x0; x <= x0 + block; ++x) {
+                    low = std::min(low, tile.heights[z * (tile.resolution + 1) + x]);
+                    high = std::max(high, tile.heights[z * (tile.resolution + 1) + x]);
+                }
+            }
+            boxes.emplace_back(tile.originX + x0 * tile.spacing, low, tile.originZ + z0 * tile.spacing);
+            boxes.emplace_back(tile.originX + (x0 + block) * tile.spacing, high, tile.originZ + (z0 + block) * tile.spacing);
+        }
+    }
+    float chunkSize = terrain.getChunkSize();
+    Vector3D eye(chunkSize * 0.5f, terrain.getHeightAt(chunkSize * 0.5f, chunkSize * 0.5f) + 20.0f, chunkSize * 0.5f);
+
+    ViewCuller culler;
+    state.setItemsPerIteration(static_cast<double>(boxes.size() / 2));
+    while (state.keepRunning()) {
+        culler.begin(eye, eye + Vector3D(1, -0.1f, 0.3f), 65.0f, 16.0f / 9.0f, 0.01f, 1000.0f);
+        for (const TerrainChunk& chunk : chunks) culler.addOccluders(chunk.heights);
+        int visible = 0;
+        for (size_t b = 0; b < boxes.size(); b += 2) {
+            visible += culler.isVisible(boxes[b], boxes[b + 1]) ? 1 : 0;
+        }
+        doNotOptimize(visible);
+    }
+}
+
+// === Noise ===
+
+void benchOctaveNoise2(State& state) {
+    PerlinNoise noise(7);
+    int octaves = static_cast<int>(state.arg());
+    state.setItemsPerIteration(1024);
+    float offset = 0.0f;
+    while (state.keepRunning()) {
+        float sum = 0.0f;
+        for (int i = 0; i < 1024; ++i) {
+            sum += noise.octaveNoise(i * 0.037f + offset, i * 0.011f, octaves);
+        }
+        offset += 0.5f;
+        doNotOptimize(sum);
+    }
+}
+
+void benchOctaveNoise3(State& state) {
+    PerlinNoise noise(7);
+    int octaves = static_cast<int>(state.arg());
+    state.setItemsPerIteration(1024);
+    float offset = 0.0f;
+    while (state.keepRunning()) {
+        float sum = 0.0f;
+        for (int i = 0; i < 1024; ++i) {
+            sum += noise.octaveNoise(i * 0.037f + offset, i * 0.011f, i * 0.023f, octaves);
+        }
+        offset += 0.5f;
+        doNotOptimize(sum);
+    }
+}
+
+// Same loop as benchOctaveNoise2/3 through the compile-time octave tables
+void benchFractalNoise2(State& state) {
+    PerlinNoise noise(7);
+    FractalSample2 octaves = selectFractal(FractalType::Fbm, static_cast<int>(state.arg())).sample2;
+    state.setItemsPerIteration(1024);
+    float offset = 0.0f;
+    while (state.keepRunning()) {
+        float sum = 0.0f;
+        for (int i = 0; i < 1024; ++i) {
+            sum += octaves(noise, i * 0.037f + offset, i * 0.011f);
+        }
+        offset += 0.5f;
+        doNotOptimize(sum);
+    }
+}
+
+void benchFractalNoise3(State& state) {
+    PerlinNoise noise(7);
+    FractalSample3 octaves = selectFractal(FractalType::Fbm, static_cast<int>(state.arg())).sample3;
+    state.setItemsPerIteration(1024);
+    float offset = 0.0f;
+    while (state.keepRunning()) {
+        float sum = 0.0f;
+        for (int i = 0; i < 1024; ++i) {
+            sum += octaves(noise, i * 0.037f + offset, i * 0.011f, i * 0.023f);
+        }
+        offset += 0.5f;
+        doNotOptimize(sum);
+    }
+}
+
+void benchOctaveNoise2Batch(State& state) {
+    PerlinNoise noise(7);
+    int octaves = static_cast<int>(state.arg());
+    std::vector<float> xs(1024), ys(1024), out(1024);
+    for (int i = 0; i < 1024; ++i) {
+        xs[i] = i * 0.037f;
+        ys[i] = i * 0.011f;
+    }
+    state.setItemsPerIteration(1024);
+    while (state.keepRunning()) {
+        noise.octaveNoise2(xs.data(), ys.data(), out.data(), xs.size(), octaves);
+        doNotOptimize(out.front());
+    }
+}
+
+// === Audio ===
+
+void runWindSynth(State& state, WindSoundEngine engine) {
+    // Offline: never initialized, so no audio device is opened
+    WindSoundConfig config;
+    config.engine = engine;
+    WindSoundSynthesizer synth(config);
+    synth.update(1.0f / 60.0f, 160.0f, 60.0f, 350.0f);
+    synth.triggerGust(1.0f);
+
+    std::vector<short> buffer(static_cast<size_t>(state.arg()));
+    state.setItemsPerIteration(static_cast<double>(buffer.size()));
+    while (state.keepRunning()) {
+        synth.render(buffer.data(), static_cast<unsigned int>(buffer.size()));
+        doNotOptimize(buffer.front());
+    }
+}
+
+// Stereo with every voice bound to a nearby gust or vortex
+void benchWindSynth(State& state) {
+    runWindSynth(state, WindSoundEngine::Procedural);
+}
+
+void benchWindSynthWavetable(State& state) {
+    runWindSynth(state, WindSoundEngine::Wavetable);
+}
+
+void benchWindSynthSpatial(State& state) {
+    WindField3D wind = makeWindField();
+    for (int i = 0; i < WindSoundSynthesizer::MAX_VOICES; ++i) {
+        float angle = i * 0.785f;
+        Vector3D center(std::cos(angle) * 150.0f, 100.0f, std::sin(angle) * 150.0f);
+        if (i % 2 == 0) wind.addGust(center, Vector3D(1, 0, 0), 90.0f, 60.0f, 4.0f);
+        else wind.addVortex(center, Vector3D(0, 1, 0), 90.0f, 60.0f, 4.0f);
+    }
+    wind.update(1.0f);
+
+    WindSoundConfig config;
+    config.spatialVoices = WindSoundSynthesizer::MAX_VOICES;
+    WindSoundSynthesizer synth(config);
+    WindListener listener;
+    listener.position = Vector3D(0, 100, 0);
+    synth.update(1.0f / 60.0f, 160.0f, 350.0f, listener, wind);
+
+    std::vector<short> buffer(static_cast<size_t>(state.arg()) * 2);
+    state.setItemsPerIteration(static_cast<double>(state.arg()));
+    while (state.keepRunning()) {
+        synth.render(buffer.data(), static_cast<unsigned int>(state.arg()));
+        doNotOptimize(buffer.front());
+    }
+}
+
+// === Memory ===
+
+// Arg = triangles; the same scratch shape as a terrain mesh build, from the heap
+void benchScratchHeap(State& state) {
+    size_t triangles = static_cast<size_t>(state.arg());
+    state.setItemsPerIteration(static_cast<double>(triangles));
+    while (state.keepRunning()) {
+        std::vector<Vector3D> corners;
+        std::vector<float> heights;
+        corners.reserve(triangles * 3);
+        heights.reserve(triangles * 3);
+        for (size_t i = 0; i < triangles * 3; ++i) {
+            corners.emplace_back(static_cast<float>(i), 0.0f, 0.0f);
+            heights.push_back(corners.back().x);
+        }
+        doNotOptimize(heights.back());
+    }
+}
+
+// Same, from a frame arena reset every iteration
+void benchScratchArena(State& state) {
+    size_t triangles = static_cast<size_t>(state.arg());
+    FrameArena arena;
+    FrameArenaScope scope(&arena);
+    state.setItemsPerIteration(static_cast<double>(triangles));
+    while (state.keepRunning()) {
+        arena.reset();
+        ArenaVector<Vector3D> corners;
+        ArenaVector<float> heights;
+        corners.reserve(triangles * 3);
+        heights.reserve(triangles * 3);
+        for (size_t i = 0; i < triangles * 3; ++i) {
+            corners.emplace_back(static_cast<float>(i), 0.0f, 0.0f);
+            heights.push_back(corners.back().x);
+        }
+        doNotOptimize(heights.back());
+    }
+}
+
+// Arg = chunks; small jobs so submission cost shows
+void benchParallelFor(State& state) {
+    JobSystem jobs;
+    std::vector<float> values(static_cast<size_t>(state.arg()) * 64, 1.0f);
+    state.setItemsPerIteration(static_cast<double>(state.arg()));
+    while (state.keepRunning()) {
+        jobs.parallelFor(values.size(), 64, [&values](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) values[i] *= 1.0001f;
+        });
+        doNotOptimize(values.front());
+    }
+}
+
+void registerAll() {
+    registerBenchmark("Matrix4::operator*", benchMatrixMultiply);
+    registerBenchmark("Matrix4::inverted", benchMatrixInverse);
+    registerBenchmark("Matrix4::transformPoints(batch)", benchTransformPoints, {1024});
+    registerBenchmark("Vector3D::normalized", benchVectorNormalize, {1024});
+    registerBenchmark("Vector3D::normalizedFast", benchVectorNormalizeFast, {1024});
+    registerBenchmark("Cape3D::update", benchCapeUpdate, {14, 28, 56});
+    registerBenchmark("Cape3D::update(jobs)", benchCapeUpdateParallel, {28, 56});
+    registerBenchmark("Cape3D::solveConstraints", benchCapeSolve, {14, 28, 56});
+    registerBenchmark("Cape3D::solveConstraints(jobs)", benchCapeSolveParallel, {28, 56});
+    registerBenchmark("Cape3D::update+solve(xpbd)", benchCapeXPBD, {14, 28, 56});
+    registerBenchmark("Cape3D::solveCollisions", benchCapeCollisions, {14, 28, 56});
+    registerBenchmark("ClothWorld::step(banners)", benchClothWorldBanners, {0, 1});
+    registerBenchmark("WindField3D::getWindAt", benchWindScalar);
+    registerBenchmark("WindField3D::getWindAt(batch)", benchWindBatch, {256, 4096});
+    registerBenchmark("WindField3D::getWindAt(storm)", benchWindStorm, {16, 128});
+    registerBenchmark("WindField3D::update", benchWindUpdate);
+    registerBenchmark("Terrain::generate", benchTerrainGenerate, {32, 64, 128, 256});
+    registerBenchmark("Terrain::generate(jobs)", benchTerrainGenerateParallel, {128, 256, 512});
+    registerBenchmark("Terrain::loadCache", benchTerrainLoadCache, {32, 64, 128, 256});
+    registerBenchmark("Terrain::generateChunkCached", benchTerrainChunkCached, {0, 1});
+    registerBenchmark("Terrain::generateChunk", benchTerrainChunk, {16, 32, 64});
+    registerBenchmark("Terrain::raycast", benchTerrainRaycast, {64, 256});
+    registerBenchmark("Terrain::raycast(march)", benchTerrainRaymarch, {64, 256});
+    registerBenchmark("Character3D::update(trail)", benchCharacterTrail, {20, 4096});
+    registerBenchmark("flyers(objects)", benchFlyersObjects, {64, 512});
+    registerBenchmark("FlyerCrowd3D::update", benchFlyerCrowd, {64, 512});
+    registerBenchmark("FlyerCrowd3D::update(jobs)", benchFlyerCrowdParallel, {512});
+    registerBenchmark("FlyerSnapshot::encode+decode", benchFlyerSnapshots, {64});
+    registerBenchmark("Frustum::testSpheres", benchFrustumSpheres, {256, 4096});
+    registerBenchmark("ViewCuller::terrain", benchViewCullerTerrain, {2, 4});
+    registerBenchmark("PerlinNoise::octaveNoise2D", benchOctaveNoise2, {1, 4, 8});
+    registerBenchmark("PerlinNoise::octaveNoise3D", benchOctaveNoise3, {1, 4, 8});
+    registerBenchmark("PerlinNoise::octaveNoise2(batch)", benchOctaveNoise2Batch, {4, 8});
+    registerBenchmark("FractalNoise::Fbm2D", benchFractalNoise2, {1, 4, 8});
+    registerBenchmark("FractalNoise::Fbm3D", benchFractalNoise3, {1, 4, 8});
+    registerBenchmark("WindSoundSynthesizer::render", benchWindSynth, {512, 4096});
+    registerBenchmark("WindSoundSynthesizer::render(wavetable)", benchWindSynthWavetable, {512, 4096});
+    registerBenchmark("WindSoundSynthesizer::render(spatial)", benchWindSynthSpatial, {512, 4096});
+    registerBenchmark("scratch(heap)", benchScratchHeap, {1024, 16384});
+    registerBenchmark("scratch(FrameArena)", benchScratchArena, {1024, 16384});
+    registerBenchmark("JobSystem::parallelFor", benchParallelFor, {16, 256});
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    RunOptions options;
+    if (!parseOptions(argc, argv, options)) return 1;
+
+    registerAll();
+    std::vector<BenchmarkResult> results = runAll(options);
+
+    if (!options.jsonPath.empty()) {
+        if (!writeJson(options.jsonPath, results)) {
+            std::fprintf(stderr, "could not write %s\n", options.jsonPath.c_str());
+            return 1;
+        }
+        std::printf("\nWrote %s\n", options.jsonPath.c_str());
+    }
+    return 0;
+}
@@ -1,11 +1,39 @@
 #include "WindSoundSynthesizer.hpp"
+#include "utils/MemoryTracker.hpp"
+#include "utils/Telemetry.hpp"
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 
 namespace ethereal {
 
-// Static instance pointer for audio callback
-WindSoundSynthesizer* WindSoundSynthesizer::activeInstance = nullptr;
+// Instance bound to each callback slot; written on the game thread, read by the audio thread
+std::array<std::atomic<WindSoundSynthesizer*>, WindSoundSynthesizer::MAX_INSTANCES> WindSoundSynthesizer::instances{};
+int WindSoundSynthesizer::deviceUsers = 0;
+
+namespace {
+
+// Voss-McCartney row refreshed by each step of the 16-step counter (its trailing zeros)
+constexpr int kPinkRow[16] = {0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0};
+
+// Seed salts, one per random source
+enum SeedSalt : uint64_t {
+    SaltNoiseLow, SaltNoiseMid, SaltNoiseHigh, SaltNoiseGust,
+    SaltLfoSlow, SaltLfoMedium, SaltLfoFast, SaltLfoGust,
+    SaltGustShape, SaltGustTiming,
+    SaltVoice,  // + voice index
+    SaltLoop = SaltVoice + 64   // + loop bank layer
+};
+
+// Rational tanh approximation (within 2.5% for |x| < 3), saturating beyond
+inline float softClip(float x) {
+    if (x > 3.0f) return 1.0f;
+    if (x < -3.0f) return -1.0f;
+    float x2 = x * x;
+    return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+}
+
+} // namespace
 
 // ============================================================================
 // BiquadFilter Implementation
@@ -71,6 +99,29 @@ float BiquadFilter::process(float input) {
     return output;
 }
 
+void BiquadFilter::processBlock(float* data, int count) {
+    float s1 = x1, s2 = x2, r1 = y1, r2 = y2;
+    
+    for (int i = 0; i < count; ++i) {
+        float input = data[i];
+        float output = b0 * input + b1 * s1 + b2 * s2 - a1 * r1 - a2 * r2;
+        s2 = s1;
+        s1 = input;
+        r2 = r1;
+        r1 = output;
+        data[i] = output;
+    }
+    
+    // Prevent denormals (once per block)
+    if (std::abs(r1) < 1e-15f) r1 = 0.0f;
+    if (std::abs(r2) < 1e-15f) r2 = 0.0f;
+    
+    x1 = s1;
+    x2 = s2;
+    y1 = r1;
+    y2 = r2;
+}
+
 void BiquadFilter::reset() {
     x1 = x2 = y1 = y2 = 0.0f;
 }
@@ -90,12 +141,10 @@ float LFO::triangle() {
 
 float LFO::smoothRandom() {
     // Interpolated random values for organic movement
-    static std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
-    
     // Update target periodically
     float cyclePos = std::fmod(phase * 4.0f, 1.0f);
     if (cyclePos < 0.01f) {
-        targetValue = dist(rng);
+        targetValue = rng.nextSigned();
     }
     
     // Smooth interpolation toward target
@@ -108,36 +157,46 @@ void LFO::advance() {
     if (phase > 1000.0f) phase -= 1000.0f;  // Prevent overflow
 }
 
+float LFO::smoothRandomBlock(int samples) {
+    float cyclePos = std::fmod(phase * 4.0f, 1.0f);
+    if (cyclePos < 0.01f) {
+        targetValue = rng.nextSigned();
+    }
+    
+    // Same one-pole glide as smoothRandom(), applied for the whole block
+    float blend = 1.0f - std::pow(1.0f - 0.001f, static_cast<float>(samples));
+    smoothValue += (targetValue - smoothValue) * blend;
+    return smoothValue;
+}
+
+void LFO::advance(int samples) {
+    phase += rate * samples / sampleRate;
+    if (phase > 1000.0f) phase -= 1000.0f;  // Prevent overflow
+}
+
 // ============================================================================
 // NoiseGenerator Implementation
 // ============================================================================
 
-NoiseGenerator::NoiseGenerator() : rng(std::random_device{}()) {
+NoiseGenerator::NoiseGenerator(uint64_t seed) : rng(seed) {
     pinkRows.fill(0.0f);
 }
 
 float NoiseGenerator::white() {
-    return dist(rng);
+    return rng.nextSigned();
 }
 
 float NoiseGenerator::pink() {
     // Voss-McCartney algorithm for pink noise
-    float whiteNoise = dist(rng);
+    float whiteNoise = rng.nextSigned();
     
     pinkIndex = (pinkIndex + 1) & 15;
     
     if (pinkIndex != 0) {
-        int numZeros = 0;
-        int n = pinkIndex;
-        while ((n & 1) == 0) {
-            n >>= 1;
-            numZeros++;
-        }
-        
-        pinkRunningSum -= pinkRows[numZeros];
-        float newRandom = dist(rng);
-        pinkRunningSum += newRandom;
-        pinkRows[numZeros] = newRandom;
+        int row = kPinkRow[pinkIndex];
+        float newRandom = rng.nextSigned();
+        pinkRunningSum += newRandom - pinkRows[row];
+        pinkRows[row] = newRandom;
     }
     
     return (pinkRunningSum + whiteNoise) / 5.0f;
@@ -145,19 +204,66 @@ float NoiseGenerator::pink() {
 
 float NoiseGenerator::brown() {
     // Brown noise: integrated white noise
-    float whiteNoise = dist(rng);
+    float whiteNoise = rng.nextSigned();
     brownValue += whiteNoise * 0.02f;
     brownValue *= 0.998f;  // Leak to prevent drift
     return std::clamp(brownValue, -1.0f, 1.0f);
 }
 
 float NoiseGenerator::filtered(float cutoff, float resonance) {
-    float whiteNoise = dist(rng);
+    float whiteNoise = rng.nextSigned();
     float alpha = cutoff;  // Simplified filter coefficient
     filterState = filterState + alpha * (whiteNoise - filterState);
     return filterState * (1.0f + resonance);
 }
 
+void NoiseGenerator::whiteBlock(float* out, int count) {
+    rng.fillSigned(out, count);
+}
+
+void NoiseGenerator::pinkBlock(float* out, int count) {
+    // White term for the whole block first, then one row refresh per sample
+    rng.fillSigned(out, count);
+    
+    int index = pinkIndex;
+    float sum = pinkRunningSum;
+    for (int i = 0; i < count; ++i) {
+        index = (index + 1) & 15;
+        if (index != 0) {
+            int row = kPinkRow[index];
+            float newRandom = rng.nextSigned();
+            sum += newRandom - pinkRows[row];
+            pinkRows[row] = newRandom;
+        }
+        out[i] = (sum + out[i]) * 0.2f;
+    }
+    pinkIndex = index;
+    pinkRunningSum = sum;
+}
+
+void NoiseGenerator::brownBlock(float* out, int count) {
+    rng.fillSigned(out, count);
+    
+    float value = brownValue;
+    for (int i = 0; i < count; ++i) {
+        value = (value + out[i] * 0.02f) * 0.998f;
+        out[i] = std::clamp(value, -1.0f, 1.0f);
+    }
+    brownValue = value;
+}
+
+void NoiseGenerator::filteredBlock(float* out, int count, float cutoff, float resonance) {
+    rng.fillSigned(out, count);
+    
+    float state = filterState;
+    float gain = 1.0f + resonance;
+    for (int i = 0; i < count; ++i) {
+        state += cutoff * (out[i] - state);
+        out[i] = state * gain;
+    }
+    filterState = state;
+}
+
 void NoiseGenerator::reset() {
     pinkRows.fill(0.0f);
     pinkIndex = 0;
@@ -170,19 +276,16 @@ void NoiseGenerator::reset() {
 // GustGenerator Implementation
 // ============================================================================
 
-GustGenerator::GustGenerator(float sampleRate) : sampleRate(sampleRate) {}
+GustGenerator::GustGenerator(float sampleRate, uint64_t seed) : sampleRate(sampleRate), rng(seed) {}
 
 void GustGenerator::trigger(float gustIntensity) {
     if (active) return;  // Don't interrupt existing gust
     
-    std::uniform_real_distribution<float> durDist(0.8f, 2.5f);
-    std::uniform_real_distribution<float> attackDist(0.15f, 0.4f);
-    
     active = true;
     phase = 0.0f;
     intensity = gustIntensity;
-    duration = durDist(rng);
-    attackTime = attackDist(rng) * duration;
+    duration = rng.range(0.8f, 2.5f);
+    attackTime = rng.range(0.15f, 0.4f) * duration;
     decayTime = duration - attackTime;
 }
 
@@ -190,6 +293,15 @@ float GustGenerator::generate() {
     if (!active) return 0.0f;
     
     float time = phase / sampleRate;
+    if (time >= duration) {
+        active = false;
+        return 0.0f;
+    }
+    
+    return envelopeAt(time) * intensity;
+}
+
+float GustGenerator::envelopeAt(float time) const {
     float envelope = 0.0f;
     
     if (time < attackTime) {
@@ -204,12 +316,23 @@ float GustGenerator::generate() {
         envelope *= envelope;  // Quadratic decay
         // Add subtle ripples during decay
         envelope *= 1.0f + 0.1f * std::sin(t * 12.0f) * (1.0f - t);
-    } else {
-        active = false;
-        return 0.0f;
     }
     
-    return envelope * intensity;
+    return envelope;
+}
+
+void GustGenerator::advanceBlock(int samples, float& startEnvelope, float& endEnvelope) {
+    startEnvelope = generate();
+    endEnvelope = 0.0f;
+    if (!active) return;
+    
+    phase += static_cast<float>(samples);
+    float endTime = phase / sampleRate;
+    if (endTime >= duration) {
+        active = false;
+    } else {
+        endEnvelope = envelopeAt(endTime) * intensity;
+    }
 }
 
 void GustGenerator::update() {
@@ -218,6 +341,109 @@ void GustGenerator::update() {
     }
 }
 
+// ============================================================================
+// WindLoopBank Implementation
+// ============================================================================
+
+void WindLoopBank::build(const WindSoundConfig& config) {
+    MEMORY_TAG(Audio);
+    const float sampleRate = config.sampleRate;
+    const size_t baseLength = std::max<size_t>(static_cast<size_t>(config.loopSeconds * sampleRate), 256);
+    const size_t fade = std::min(baseLength / 4, static_cast<size_t>(0.1f * sampleRate));
+    const size_t warmup = static_cast<size_t>(0.05f * sampleRate);   // Lets the filters settle
+    const int filteredLevels = std::max(config.loopLevels, 1);
+    
+    std::vector<float> raw;
+    for (int layer = 0; layer < LayerCount; ++layer) {
+        LayerLoops& loops = layers[layer];
+        const bool followsIntensity = layer == Low || layer == Mid || layer == High;
+        loops.levels = followsIntensity ? filteredLevels : 1;
+        loops.length = static_cast<size_t>(baseLength * (1.0f + 0.07f * layer));
+        loops.samples.assign(loops.length * loops.levels, 0.0f);
+        raw.resize(warmup + loops.length + fade);
+        
+        for (int level = 0; level < loops.levels; ++level) {
+            // Same noise for every level, through the filters updateFilters() sets at that intensity
+            float intensity = loops.levels > 1 ? static_cast<float>(level) / (loops.levels - 1) : 0.5f;
+            float intensityMod = 0.8f + intensity * 0.4f;
+            NoiseGenerator noise(mixSeed(config.seed, SaltLoop + layer));
+            BiquadFilter first, second;
+            float* data = raw.data();
+            const int count = static_cast<int>(raw.size());
+            
+            switch (layer) {
+                case Low:
+                    noise.brownBlock(data, count);
+                    first.setCoefficients(BiquadFilter::Type::LowPass, config.lowPassBase * intensityMod, 0.7f, sampleRate);
+                    first.processBlock(data, count);
+                    break;
+                case Mid:
+                    noise.pinkBlock(data, count);
+                    first.setCoefficients(BiquadFilter::Type::LowPass, config.midLowPass * intensityMod, 0.5f, sampleRate);
+                    second.setCoefficients(BiquadFilter::Type::HighPass, config.midHighPass, 0.5f, sampleRate);
+                    first.processBlock(data, count);
+                    second.processBlock(data, count);
+                    break;
+                case High:
+                    noise.pinkBlock(data, count);
+                    first.setCoefficients(BiquadFilter::Type::HighPass, config.highPassBase + intensity * 1500.0f, 0.6f, sampleRate);
+                    second.setCoefficients(BiquadFilter::Type::LowPass, 8000.0f, 0.4f, sampleRate);
+                    first.processBlock(data, count);
+                    second.processBlock(data, count);
+                    break;
+                case Gust:
+                    noise.pinkBlock(data, count);
+                    first.setCoefficients(BiquadFilter::Type::BandPass, 400.0f, 1.5f, sampleRate);
+                    first.processBlock(data, count);
+                    break;
+                case Whoosh:
+                    noise.whiteBlock(data, count);      // Its one-pole follows the speed live
+                    break;
+                default:
+                    noise.pinkBlock(data, count);
+                    break;
+            }
+            
+            // Equal-power crossfade of the tail into the head, so the end runs into the start
+            const float* source = data + warmup;
+            float* loop = loops.samples.data() + level * loops.length;
+            for (size_t i = 0; i < fade; ++i) {
+                float w = (i + 0.5f) / fade;
+                loop[i] = source[i] * std::sqrt(w) + source[loops.length + i] * std::sqrt(1.0f - w);
+            }
+            std::copy(source + fade, source + loops.length, loop + fade);
+        }
+    }
+    
+    builtConfig = config;
+    built = true;
+}
+
+void WindLoopBank::clear() {
+    for (LayerLoops& loops : layers) {
+        loops = LayerLoops();
+    }
+    built = false;
+}
+
+bool WindLoopBank::matches(const WindSoundConfig& config) const {
+    return built
+        && builtConfig.seed == config.seed
+        && builtConfig.sampleRate == config.sampleRate
+        && builtConfig.loopSeconds == config.loopSeconds
+        && builtConfig.loopLevels == config.loopLevels
+        && builtConfig.lowPassBase == config.lowPassBase
+        && builtConfig.midLowPass == config.midLowPass
+        && builtConfig.midHighPass == config.midHighPass
+        && builtConfig.highPassBase == config.highPassBase;
+}
+
+size_t WindLoopBank::getMemoryBytes() const {
+    size_t bytes = 0;
+    for (const LayerLoops& loops : layers) bytes += loops.samples.capacity() * sizeof(float);
+    return bytes;
+}
+
 // ============================================================================
 // WindSoundSynthesizer Implementation
 // ============================================================================
@@ -226,17 +452,33 @@ WindSoundSynthesizer::WindSoundSynthesizer() : WindSoundSynthesizer(WindSoundCon
 
 WindSoundSynthesizer::WindSoundSynthesizer(const WindSoundConfig& cfg) 
     : config(cfg)
+    , gustRng(mixSeed(cfg.seed, SaltGustTiming))
     , buffer(BUFFER_SIZE * 2)
-    , lfoSlow(cfg.slowLfoRate)
-    , lfoMedium(cfg.mediumLfoRate)
-    , lfoFast(cfg.fastLfoRate)
-    , lfoGust(cfg.gustRate)
-    , gustGen(cfg.sampleRate) {
+    , appliedSeed(cfg.seed)
+    , noiseGenLow(mixSeed(cfg.seed, SaltNoiseLow))
+    , noiseGenMid(mixSeed(cfg.seed, SaltNoiseMid))
+    , noiseGenHigh(mixSeed(cfg.seed, SaltNoiseHigh))
+    , noiseGenGust(mixSeed(cfg.seed, SaltNoiseGust))
+    , lfoSlow(cfg.slowLfoRate, 0.0f, mixSeed(cfg.seed, SaltLfoSlow))
+    , lfoMedium(cfg.mediumLfoRate, 0.0f, mixSeed(cfg.seed, SaltLfoMedium))
+    , lfoFast(cfg.fastLfoRate, 0.0f, mixSeed(cfg.seed, SaltLfoFast))
+    , lfoGust(cfg.gustRate, 0.0f, mixSeed(cfg.seed, SaltLfoGust))
+    , gustGen(cfg.sampleRate, mixSeed(cfg.seed, SaltGustShape)) {
     
     lfoSlow.setSampleRate(cfg.sampleRate);
     lfoMedium.setSampleRate(cfg.sampleRate);
     lfoFast.setSampleRate(cfg.sampleRate);
     lfoGust.setSampleRate(cfg.sampleRate);
+    
+    channels = cfg.spatialVoices > 0 ? 2 : 1;
+    if (channels == 2) stereoBuffer.resize(buffer.size() * 2);
+    selectEngine(cfg);
+    for (int i = 0; i < MAX_VOICES; ++i) {
+        voices[i].noise.reseed(mixSeed(cfg.seed, SaltVoice + i));
+    }
+    
+    params.config = cfg;
+    publishParams();
 }
 
 WindSoundSynthesizer::~WindSoundSynthesizer() {
@@ -247,19 +489,38 @@ WindSoundSynthesizer::~WindSoundSynthesizer() {
 
 void WindSoundSynthesizer::initialize() {
     if (initialized) return;
+    MEMORY_TAG(Audio);
+    
+    static constexpr AudioCallback callbacks[MAX_INSTANCES] = {
+        &audioCallback<0>, &audioCallback<1>, &audioCallback<2>, &audioCallback<3>
+    };
+    
+    // Claim a free callback slot; without one this instance stays silent
+    for (int i = 0; i < MAX_INSTANCES && slot < 0; ++i) {
+        WindSoundSynthesizer* expected = nullptr;
+        if (instances[i].compare_exchange_strong(expected, this, std::memory_order_acq_rel)) {
+            slot = i;
+        }
+    }
+    if (slot < 0) return;
     
-    InitAudioDevice();
+    // The device is shared by every synthesizer
+    if (deviceUsers++ == 0) {
+        InitAudioDevice();
+    }
     
-    // Create audio stream: mono, 16-bit, at configured sample rate
-    stream = LoadAudioStream((unsigned int)config.sampleRate, 16, 1);
+    // Create audio stream: 16-bit at configured sample rate, stereo in spatial mode
+    stream = LoadAudioStream((unsigned int)config.sampleRate, 16, channels);
     
-    // Set up filters with initial values
-    updateFilters();
+    // Set up filters with initial values (the callback is not running yet)
+    paramBuffer.acquire();
+    applyParams();
     
     // Start playback
-    activeInstance = this;
-    SetAudioStreamCallback(stream, audioCallback);
-    PlayAudioStream(stream);
+    SetAudioStreamCallback(stream, callbacks[slot]);
+    if (isEnabled()) {
+        PlayAudioStream(stream);
+    }
     
     initialized = true;
 }
@@ -267,58 +528,138 @@ void WindSoundSynthesizer::initialize() {
 void WindSoundSynthesizer::shutdown() {
     if (!initialized) return;
     
+    // Unloading the stream waits out a callback in progress, so the slot is free after it
     StopAudioStream(stream);
     UnloadAudioStream(stream);
-    CloseAudioDevice();
+    if (--deviceUsers == 0) {
+        CloseAudioDevice();
+    }
     
-    activeInstance = nullptr;
+    instances[slot].store(nullptr, std::memory_order_release);
+    slot = -1;
     initialized = false;
 }
 
 void WindSoundSynthesizer::update(float dt, float playerSpeed, float windIntensity, float altitude) {
-    if (!initialized || !enabled) return;
+    if (!isEnabled()) return;
+    MEMORY_TAG(Audio);
+    updateAmbient(dt, playerSpeed, windIntensity, altitude);
     
+    // Smoothing and filter coefficients follow on the audio thread
+    publishParams();
+}
+
+void WindSoundSynthesizer::update(float dt, float playerSpeed, float altitude,
+                                  const WindListener& listener, const WindField3D& wind) {
+    if (!isEnabled()) return;
+    MEMORY_TAG(Audio);
+    updateAmbient(dt, playerSpeed, wind.getWindAt(listener.position).length(), altitude);
+    if (channels == 2) assignVoices(listener, wind);
+    publishParams();
+}
+
+void WindSoundSynthesizer::updateAmbient(float dt, float playerSpeed, float windIntensity, float altitude) {
     // Normalize inputs
-    playerSpeedNorm = std::clamp(playerSpeed / 200.0f, 0.0f, 1.0f);  // 200 = max expected speed
+    params.playerSpeedNorm = std::clamp(playerSpeed / 200.0f, 0.0f, 1.0f);  // 200 = max expected speed
     windIntensityNorm = std::clamp(windIntensity / 100.0f, 0.0f, 1.0f);
-    altitudeNorm = std::clamp(altitude / 500.0f, 0.0f, 1.0f);  // 500 = high altitude
+    params.altitudeNorm = std::clamp(altitude / 500.0f, 0.0f, 1.0f);  // 500 = high altitude
     
     // Calculate target intensity from all factors
-    float speedContrib = playerSpeedNorm * config.speedInfluence;
+    float speedContrib = params.playerSpeedNorm * config.speedInfluence;
     float windContrib = windIntensityNorm * config.windInfluence;
-    float altContrib = altitudeNorm * config.altitudeInfluence;
+    float altContrib = params.altitudeNorm * config.altitudeInfluence;
     
     // Combine with slight minimum so there's always some ambient wind
-    targetIntensity = 0.08f + speedContrib * 0.5f + windContrib * 0.3f + altContrib * 0.2f;
-    targetIntensity = std::clamp(targetIntensity, 0.0f, 1.0f);
-    
-    // Smooth intensity changes
-    float smoothing = dt * 3.0f;
-    currentIntensity += (targetIntensity - currentIntensity) * smoothing;
+    float targetIntensity = 0.08f + speedContrib * 0.5f + windContrib * 0.3f + altContrib * 0.2f;
+    params.targetIntensity = std::clamp(targetIntensity, 0.0f, 1.0f);
     
     // Check for random gusts
     checkForGust(dt);
+}
+
+void WindSoundSynthesizer::assignVoices(const WindListener& listener, const WindField3D& wind) {
+    wind.getEmitters(emitterScratch);
     
-    // Update filter parameters based on intensity
-    updateFilters();
+    Vector3D forward = listener.forward.normalized();
+    Vector3D right = forward.cross(listener.up).normalized();
+    
+    voiceCandidates.clear();
+    for (const WindEmitter3D& emitter : emitterScratch) {
+        Vector3D toEmitter = emitter.position - listener.position;
+        float distance = toEmitter.length();
+        float beyond = std::max(0.0f, distance - emitter.radius);
+        if (beyond > config.voiceRange) continue;
+        
+        float proximity = beyond / config.voiceRolloff;
+        float loudness = std::min(1.0f, std::abs(emitter.strength) / 100.0f) / (1.0f + proximity * proximity);
+        if (loudness < 0.01f) continue;
+        
+        // Narrows to the center as the listener enters the emitter
+        Vector3D direction = distance > 1e-3f ? toEmitter * (1.0f / distance) : forward;
+        float width = std::min(1.0f, distance / std::max(emitter.radius, 1.0f));
+        // Sources behind the listener come through duller
+        float muffle = 1.0f - 0.4f * std::max(0.0f, -direction.dot(forward));
+        
+        WindVoiceParams voice;
+        voice.emitterId = emitter.id;
+        voice.gain = loudness * (0.6f + 0.4f * muffle);
+        voice.pan = std::clamp(direction.dot(right) * width, -1.0f, 1.0f);
+        voice.vortex = emitter.vortex;
+        float cutoff = emitter.vortex ? 250.0f + 500.0f * loudness : 600.0f + 3000.0f / (1.0f + proximity);
+        voice.cutoff = std::clamp(cutoff * muffle, 80.0f, 8000.0f);
+        voiceCandidates.push_back(voice);
+    }
+    
+    const int voiceCount = std::clamp(config.spatialVoices, 0, MAX_VOICES);
+    const size_t keep = std::min<size_t>(voiceCount, voiceCandidates.size());
+    std::partial_sort(voiceCandidates.begin(), voiceCandidates.begin() + keep, voiceCandidates.end(),
+        [](const WindVoiceParams& a, const WindVoiceParams& b) { return a.gain > b.gain; });
+    
+    // Emitters still among the loudest keep their voice, so nothing jumps channels
+    std::array<bool, MAX_VOICES> taken{};
+    std::array<bool, MAX_VOICES> placed{};
+    for (size_t c = 0; c < keep; ++c) {
+        for (int i = 0; i < voiceCount; ++i) {
+            if (!taken[i] && params.voices[i].emitterId == voiceCandidates[c].emitterId) {
+                params.voices[i] = voiceCandidates[c];
+                taken[i] = placed[c] = true;
+                break;
+            }
+        }
+    }
+    // The rest fade out, keeping their emitter until a newcomer needs the slot
+    for (int i = 0; i < MAX_VOICES; ++i) {
+        if (!taken[i]) params.voices[i].gain = 0.0f;
+    }
+    for (size_t c = 0, i = 0; c < keep; ++c) {
+        if (placed[c]) continue;
+        while (taken[i]) ++i;
+        params.voices[i] = voiceCandidates[c];
+        taken[i] = true;
+    }
 }
 
 void WindSoundSynthesizer::setIntensity(float intensity) {
-    targetIntensity = std::clamp(intensity, 0.0f, 1.0f);
+    params.targetIntensity = std::clamp(intensity, 0.0f, 1.0f);
+    publishParams();
 }
 
 void WindSoundSynthesizer::triggerGust(float intensity) {
-    gustGen.trigger(intensity);
+    params.gustSerial++;
+    params.gustIntensity = intensity;
+    publishParams();
 }
 
 void WindSoundSynthesizer::setMasterVolume(float volume) {
     config.masterVolume = std::clamp(volume, 0.0f, 1.0f);
+    params.config.masterVolume = config.masterVolume;
+    publishParams();
 }
 
 void WindSoundSynthesizer::setEnabled(bool isEnabled) {
-    enabled = isEnabled;
+    enabled.store(isEnabled, std::memory_order_relaxed);
     if (initialized) {
-        if (enabled) {
+        if (isEnabled) {
             PlayAudioStream(stream);
         } else {
             PauseAudioStream(stream);
@@ -327,7 +668,91 @@ void WindSoundSynthesizer::setEnabled(bool isEnabled) {
 }
 
 void WindSoundSynthesizer::setConfig(const WindSoundConfig& cfg) {
+    if (cfg.seed != config.seed) {
+        gustRng.reseed(mixSeed(cfg.seed, SaltGustTiming));
+    }
     config = cfg;
+    params.config = cfg;
+    // A running stream keeps its channel count and engine until the next initialize()
+    if (!initialized) {
+        channels = cfg.spatialVoices > 0 ? 2 : 1;
+        stereoBuffer.resize(channels == 2 ? buffer.size() * 2 : 0);
+        selectEngine(cfg);
+    }
+    publishParams();
+}
+
+void WindSoundSynthesizer::selectEngine(const WindSoundConfig& cfg) {
+    engine = cfg.engine;
+    if (engine == WindSoundEngine::Wavetable) {
+        if (!loopBank.matches(cfg)) {
+            loopBank.build(cfg);
+            loopPhase.fill(0);
+        }
+    } else {
+        loopBank.clear();
+    }
+}
+
+void WindSoundSynthesizer::publishParams() {
+    paramBuffer.back() = params;
+    paramBuffer.publish();
+}
+
+template <int Slot>
+void WindSoundSynthesizer::audioCallback(void* bufferData, unsigned int frames) {
+    WindSoundSynthesizer* synth = instances[Slot].load(std::memory_order_acquire);
+    if (!synth || !synth->isEnabled()) {
+        std::memset(bufferData, 0, frames * sizeof(short) * (synth ? synth->channels : 1));
+        return;
+    }
+#if !defined(LOOM_DISABLE_TELEMETRY)
+    auto start = std::chrono::steady_clock::now();
+    synth->render(static_cast<short*>(bufferData), frames);
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    TELEMETRY_PEAK("audio.callbackUs", elapsed.count());
+#else
+    synth->render(static_cast<short*>(bufferData), frames);
+#endif
+}
+
+void WindSoundSynthesizer::render(short* output, unsigned int frames) {
+    if (paramBuffer.acquire()) {
+        applyParams();
+    }
+    
+    unsigned int done = 0;
+    while (done < frames) {
+        int count = static_cast<int>(std::min<size_t>(frames - done, buffer.size()));
+        generateSamples(buffer.data(), count);
+        
+        // Apply master volume and convert to 16-bit
+        float volume = paramBuffer.front().config.masterVolume;
+        if (channels == 1) {
+            for (int i = 0; i < count; ++i) {
+                float sample = std::clamp(buffer[i] * volume, -1.0f, 1.0f);
+                output[done + i] = static_cast<short>(sample * 32767.0f);
+            }
+        } else {
+            // Ambient layers sit in the center, the voices on top
+            renderVoices(stereoBuffer.data(), count);
+            short* frame = output + done * 2;
+            for (int i = 0; i < count; ++i) {
+                float left = std::clamp((buffer[i] + softClip(stereoBuffer[i * 2])) * volume, -1.0f, 1.0f);
+                float right = std::clamp((buffer[i] + softClip(stereoBuffer[i * 2 + 1])) * volume, -1.0f, 1.0f);
+                frame[i * 2] = static_cast<short>(left * 32767.0f);
+                frame[i * 2 + 1] = static_cast<short>(right * 32767.0f);
+            }
+        }
+        done += count;
+    }
+    
+    gustActive.store(gustGen.isActive(), std::memory_order_relaxed);
+}
+
+void WindSoundSynthesizer::applyParams() {
+    const WindSoundParams& p = paramBuffer.front();
+    const WindSoundConfig& cfg = p.config;
     
     lfoSlow.setRate(cfg.slowLfoRate);
     lfoSlow.setSampleRate(cfg.sampleRate);
@@ -340,134 +765,307 @@ void WindSoundSynthesizer::setConfig(const WindSoundConfig& cfg) {
     
     gustGen.setSampleRate(cfg.sampleRate);
     
+    if (cfg.seed != appliedSeed) {
+        reseedSources(cfg.seed);
+    }
+    
+    if (p.gustSerial != lastGustSerial) {
+        lastGustSerial = p.gustSerial;
+        gustGen.trigger(p.gustIntensity);
+    }
+    
     updateFilters();
 }
 
-void WindSoundSynthesizer::audioCallback(void* bufferData, unsigned int frames) {
-    if (!activeInstance || !activeInstance->enabled) {
-        std::memset(bufferData, 0, frames * sizeof(short));
-        return;
+void WindSoundSynthesizer::reseedSources(uint32_t seed) {
+    appliedSeed = seed;
+    noiseGenLow.reseed(mixSeed(seed, SaltNoiseLow));
+    noiseGenMid.reseed(mixSeed(seed, SaltNoiseMid));
+    noiseGenHigh.reseed(mixSeed(seed, SaltNoiseHigh));
+    noiseGenGust.reseed(mixSeed(seed, SaltNoiseGust));
+    lfoSlow.reseed(mixSeed(seed, SaltLfoSlow));
+    lfoMedium.reseed(mixSeed(seed, SaltLfoMedium));
+    lfoFast.reseed(mixSeed(seed, SaltLfoFast));
+    lfoGust.reseed(mixSeed(seed, SaltLfoGust));
+    gustGen.reseed(mixSeed(seed, SaltGustShape));
+    for (int i = 0; i < MAX_VOICES; ++i) {
+        voices[i].noise.reseed(mixSeed(seed, SaltVoice + i));
     }
-    
-    short* output = static_cast<short*>(bufferData);
-    
-    for (unsigned int i = 0; i < frames; ++i) {
-        float sample = activeInstance->synthesizeSample();
-        
-        // Apply master volume and convert to 16-bit
-        sample *= activeInstance->config.masterVolume;
-        sample = std::clamp(sample, -1.0f, 1.0f);
-        output[i] = static_cast<short>(sample * 32767.0f);
+}
+
+void WindSoundSynthesizer::generateSamples(float* output, int frameCount) {
+    for (int offset = 0; offset < frameCount; offset += CONTROL_BLOCK) {
+        synthesizeBlock(output + offset, std::min(CONTROL_BLOCK, frameCount - offset));
     }
 }
 
-float WindSoundSynthesizer::synthesizeSample() {
-    // Get modulation values
-    float slowMod = lfoSlow.sine() * 0.5f + 0.5f;      // 0 to 1
-    float medMod = lfoMedium.triangle() * 0.5f + 0.5f; // 0 to 1
-    float fastMod = lfoFast.sine() * 0.2f + 0.8f;      // 0.6 to 1 (less aggressive)
-    float randomMod = lfoSlow.smoothRandom() * 0.15f + 0.85f;  // 0.7 to 1
+void WindSoundSynthesizer::synthesizeBlock(float* output, int count) {
+    const WindSoundParams& p = paramBuffer.front();
+    const WindSoundConfig& cfg = p.config;
+    const float playerSpeedNorm = p.playerSpeedNorm;
+    const float altitudeNorm = p.altitudeNorm;
+    
+    // === Control rate: intensity glides toward the published target in sample time ===
+    float intensityStart = currentIntensity;
+    float blend = 1.0f - std::exp(-cfg.intensitySmoothing * count / cfg.sampleRate);
+    currentIntensity += (p.targetIntensity - currentIntensity) * blend;
+    if (currentIntensity != intensityStart) {
+        updateFilters();
+    }
+    
+    // === Control rate: modulation at both block edges, ramped per sample ===
+    float slowStart = lfoSlow.sine() * 0.5f + 0.5f;          // 0 to 1
+    float medStart = lfoMedium.triangle() * 0.5f + 0.5f;     // 0 to 1
+    float fastStart = lfoFast.sine() * 0.2f + 0.8f;          // 0.6 to 1 (less aggressive)
+    float randomMod = lfoSlow.smoothRandomBlock(count) * 0.15f + 0.85f;  // 0.7 to 1
+    
+    lfoSlow.advance(count);
+    lfoMedium.advance(count);
+    lfoFast.advance(count);
     
-    // Advance LFOs
-    lfoSlow.advance();
-    lfoMedium.advance();
-    lfoFast.advance();
+    float slowEnd = lfoSlow.sine() * 0.5f + 0.5f;
+    float medEnd = lfoMedium.triangle() * 0.5f + 0.5f;
+    float fastEnd = lfoFast.sine() * 0.2f + 0.8f;
     
-    // Base intensity with modulation - smoother overall
-    float intensity = currentIntensity * slowMod * randomMod;
-    intensity = std::sqrt(intensity);  // Softer response curve
+    float gustStart, gustEnd;
+    gustGen.advanceBlock(count, gustStart, gustEnd);
+    
+    // Per-layer gains, same shaping for both engines
+    bool whooshActive = playerSpeedNorm > 0.35f;
+    bool airActive = altitudeNorm > 0.5f;
+    float whooshIntensity = whooshActive ? std::sqrt((playerSpeedNorm - 0.35f) / 0.65f) : 0.0f;
+    float airIntensity = airActive ? std::sqrt((altitudeNorm - 0.5f) / 0.5f) : 0.0f;
+    
+    auto layerGains = [&](float baseIntensity, float slowMod, float medMod, float fastMod, float gustEnvelope) {
+        // Base intensity with modulation - smoother overall
+        float intensity = std::sqrt(baseIntensity * slowMod * randomMod);  // Softer response curve
+        float midBrightness = 1.0f + intensity * 0.3f;
+        float highIntensity = intensity * intensity * intensity;  // Cubic - only present at high speeds
+        
+        LayerGains g;
+        g.low = cfg.lowWindVolume * intensity * 0.6f;
+        g.mid = cfg.midWindVolume * intensity * medMod * midBrightness * 0.85f;
+        g.high = cfg.highWindVolume * highIntensity * fastMod * 0.25f;
+        g.gust = gustEnvelope * cfg.gustVolume * 0.7f;
+        g.whoosh = whooshIntensity * 0.3f * medMod;
+        g.air = 0.2f * airIntensity * 0.15f * (1.0f + slowMod * 0.2f);
+        return g;
+    };
+    
+    LayerGains g0 = layerGains(intensityStart, slowStart, medStart, fastStart, gustStart);
+    LayerGains g1 = layerGains(currentIntensity, slowEnd, medEnd, fastEnd, gustEnd);
+    
+    if (engine == WindSoundEngine::Wavetable) {
+        renderLoopLayers(count, playerSpeedNorm, whooshActive, airActive);
+    } else {
+        renderProceduralLayers(count, playerSpeedNorm, whooshActive, airActive);
+    }
     
+    // ========================================
+    // Mix all layers with gentler balance
+    // ========================================
+    const float step = 1.0f / count;
+    for (int i = 0; i < count; ++i) {
+        float t = i * step;
+        float mix = lowBlock[i] * (g0.low + (g1.low - g0.low) * t)
+                  + midBlock[i] * (g0.mid + (g1.mid - g0.mid) * t)
+                  + highBlock[i] * (g0.high + (g1.high - g0.high) * t)
+                  + gustBlock[i] * (g0.gust + (g1.gust - g0.gust) * t)
+                  + whooshBlock[i] * (g0.whoosh + (g1.whoosh - g0.whoosh) * t)
+                  + airBlock[i] * (g0.air + (g1.air - g0.air) * t);
+        
+        // Softer saturation curve
+        output[i] = softClip(mix * 0.6f);  // Less aggressive saturation
+    }
+    
+    // Update sample time
+    sampleTime += count / cfg.sampleRate;
+}
+
+void WindSoundSynthesizer::renderProceduralLayers(int count, float playerSpeedNorm, bool whooshActive, bool airActive) {
     // ========================================
     // LAYER 1: Deep rumble (low frequencies)
     // ========================================
-    float lowNoise = noiseGenLow.brown();
-    lowNoise = lowPassLow.process(lowNoise);
-    float lowLayer = lowNoise * config.lowWindVolume * intensity * 0.6f;
+    noiseGenLow.brownBlock(lowBlock.data(), count);
+    lowPassLow.processBlock(lowBlock.data(), count);
     
     // ========================================
     // LAYER 2: Main woosh (mid frequencies) - smoother
     // ========================================
-    float midNoise = noiseGenMid.pink();
-    midNoise = lowPassMid.process(midNoise);
-    midNoise = highPassMid.process(midNoise);
-    // Gentler brightness scaling
-    float midBrightness = 1.0f + intensity * 0.3f;
-    float midLayer = midNoise * config.midWindVolume * intensity * medMod * midBrightness * 0.85f;
+    noiseGenMid.pinkBlock(midBlock.data(), count);
+    lowPassMid.processBlock(midBlock.data(), count);
+    highPassMid.processBlock(midBlock.data(), count);
     
     // ========================================
     // LAYER 3: High whistle (MUCH softer)
     // ========================================
-    float highNoise = noiseGenHigh.pink();  // Pink instead of white for softer highs
-    highNoise = highPassHigh.process(highNoise);
-    highNoise = lowPassHigh.process(highNoise);
-    // Very gentle high frequency response
-    float highIntensity = std::pow(intensity, 3.0f);  // Cubic - only present at high speeds
-    float highLayer = highNoise * config.highWindVolume * highIntensity * fastMod * 0.25f;  // Much quieter
+    noiseGenHigh.pinkBlock(highBlock.data(), count);  // Pink instead of white for softer highs
+    highPassHigh.processBlock(highBlock.data(), count);
+    lowPassHigh.processBlock(highBlock.data(), count);
     
     // ========================================
     // LAYER 4: Gusts (dynamic bursts) - gentler
     // ========================================
-    float gustEnvelope = gustGen.generate();
-    gustGen.update();
-    
-    float gustNoise = noiseGenGust.pink();
-    gustNoise = gustFilter.process(gustNoise);
-    float gustLayer = gustNoise * gustEnvelope * config.gustVolume * 0.7f;
+    noiseGenGust.pinkBlock(gustBlock.data(), count);
+    gustFilter.processBlock(gustBlock.data(), count);
     
     // ========================================
     // LAYER 5: Speed-dependent whoosh - smoother
     // ========================================
-    float speedWhoosh = 0.0f;
-    if (playerSpeedNorm > 0.35f) {
-        float whooshNoise = noiseGenMid.filtered(0.08f + playerSpeedNorm * 0.2f, 0.3f);  // Lower resonance
-        float whooshIntensity = (playerSpeedNorm - 0.35f) / 0.65f;
-        whooshIntensity = std::sqrt(whooshIntensity);  // Softer curve
-        speedWhoosh = whooshNoise * whooshIntensity * 0.3f * medMod;  // Use medium mod, not fast
+    if (whooshActive) {
+        noiseGenMid.filteredBlock(whooshBlock.data(), count, 0.08f + playerSpeedNorm * 0.2f, 0.3f);  // Lower resonance
+    } else {
+        std::fill(whooshBlock.begin(), whooshBlock.begin() + count, 0.0f);
     }
     
     // ========================================
     // LAYER 6: Altitude-dependent thin air - very subtle
     // ========================================
-    float altitudeLayer = 0.0f;
-    if (altitudeNorm > 0.5f) {
-        float thinAirNoise = noiseGenHigh.pink() * 0.2f;  // Pink, not white
-        float altIntensity = (altitudeNorm - 0.5f) / 0.5f;
-        altIntensity = std::sqrt(altIntensity);
-        altitudeLayer = thinAirNoise * altIntensity * 0.15f * (1.0f + slowMod * 0.2f);
+    if (airActive) {
+        noiseGenHigh.pinkBlock(airBlock.data(), count);  // Pink, not white
+    } else {
+        std::fill(airBlock.begin(), airBlock.begin() + count, 0.0f);
     }
+}
+
+void WindSoundSynthesizer::renderLoopLayers(int count, float playerSpeedNorm, bool whooshActive, bool airActive) {
+    // The loops already carry the layer filters; only the whoosh keeps a live one-pole
+    readLoop(WindLoopBank::Low, lowBlock.data(), count);
+    readLoop(WindLoopBank::Mid, midBlock.data(), count);
+    readLoop(WindLoopBank::High, highBlock.data(), count);
+    readLoop(WindLoopBank::Gust, gustBlock.data(), count);
     
-    // ========================================
-    // Mix all layers with gentler balance
-    // ========================================
-    float mix = lowLayer + midLayer + highLayer + gustLayer + speedWhoosh + altitudeLayer;
+    if (whooshActive) {
+        readLoop(WindLoopBank::Whoosh, whooshBlock.data(), count);
+        float cutoff = 0.08f + playerSpeedNorm * 0.2f;
+        float state = whooshState;
+        for (int i = 0; i < count; ++i) {
+            state += cutoff * (whooshBlock[i] - state);
+            whooshBlock[i] = state * 1.3f;
+        }
+        whooshState = state;
+    } else {
+        std::fill(whooshBlock.begin(), whooshBlock.begin() + count, 0.0f);
+    }
     
-    // Softer saturation curve
-    mix = std::tanh(mix * 0.6f);  // Less aggressive saturation
+    if (airActive) {
+        readLoop(WindLoopBank::Air, airBlock.data(), count);
+    } else {
+        std::fill(airBlock.begin(), airBlock.begin() + count, 0.0f);
+    }
+}
+
+void WindSoundSynthesizer::readLoop(WindLoopBank::Layer layer, float* out, int count) {
+    // Crossfade between the two loops rendered nearest the current intensity
+    const int levels = loopBank.getLevels(layer);
+    const size_t length = loopBank.getLength(layer);
+    int lower = 0;
+    float blend = 0.0f;
+    if (levels > 1) {
+        float position = std::clamp(currentIntensity, 0.0f, 1.0f) * (levels - 1);
+        lower = std::min(static_cast<int>(position), levels - 2);
+        blend = position - lower;
+    }
+    const float* a = loopBank.getLoop(layer, lower);
+    const float* b = levels > 1 ? loopBank.getLoop(layer, lower + 1) : a;
     
-    // Update sample time
-    sampleTime += 1.0f / config.sampleRate;
+    size_t phase = loopPhase[layer];
+    for (int i = 0; i < count; ++i) {
+        out[i] = a[phase] + (b[phase] - a[phase]) * blend;
+        if (++phase == length) phase = 0;
+    }
+    loopPhase[layer] = phase;
+}
+
+void WindSoundSynthesizer::renderVoices(float* stereo, int frameCount) {
+    std::fill(stereo, stereo + frameCount * 2, 0.0f);
+    const WindSoundParams& p = paramBuffer.front();
+    for (int offset = 0; offset < frameCount; offset += CONTROL_BLOCK) {
+        int count = std::min(CONTROL_BLOCK, frameCount - offset);
+        for (int i = 0; i < MAX_VOICES; ++i) {
+            renderVoiceBlock(voices[i], p.voices[i], stereo + offset * 2, count);
+        }
+    }
+}
+
+void WindSoundSynthesizer::renderVoiceBlock(SpatialVoice& voice, const WindVoiceParams& target, float* stereo, int count) {
+    const WindSoundConfig& cfg = paramBuffer.front().config;
+    
+    // A slot handed to another emitter fades the old sound out before switching
+    bool switching = target.emitterId != voice.emitterId;
+    if (switching && voice.gain < 1e-3f) {
+        voice.emitterId = target.emitterId;
+        voice.pan = target.pan;
+        voice.vortex = target.vortex;
+        voice.cutoff = 0.0f;
+        voice.filter.reset();
+        switching = false;
+    }
+    float targetGain = switching ? 0.0f : target.gain;
+    if (voice.gain < 1e-4f && targetGain < 1e-4f) {
+        voice.gain = 0.0f;
+        return;     // Idle voices cost nothing
+    }
     
-    return mix;
+    // === Control rate: glide gain and pan, retune once the cutoff moved a few percent ===
+    float blend = 1.0f - std::exp(-cfg.voiceSmoothing * count / cfg.sampleRate);
+    float gainStart = voice.gain;
+    float panStart = voice.pan;
+    voice.gain += (targetGain - voice.gain) * blend;
+    if (!switching) {
+        voice.pan += (target.pan - voice.pan) * blend;
+        if (std::abs(target.cutoff - voice.cutoff) > voice.cutoff * 0.03f) {
+            voice.cutoff = target.cutoff;
+            if (voice.vortex) {
+                voice.filter.setCoefficients(BiquadFilter::Type::BandPass, voice.cutoff, 2.5f, cfg.sampleRate);
+            } else {
+                voice.filter.setCoefficients(BiquadFilter::Type::LowPass, voice.cutoff, 0.7f, cfg.sampleRate);
+            }
+        }
+    }
+    
+    voice.noise.pinkBlock(voiceBlock.data(), count);
+    voice.filter.processBlock(voiceBlock.data(), count);
+    
+    // Equal-power pan at both block edges, ramped per sample
+    auto panGains = [&cfg](float pan, float gain, float& left, float& right) {
+        float angle = (pan + 1.0f) * 0.25f * 3.14159265f;
+        left = std::cos(angle) * gain * cfg.voiceVolume;
+        right = std::sin(angle) * gain * cfg.voiceVolume;
+    };
+    float left0, right0, left1, right1;
+    panGains(panStart, gainStart, left0, right0);
+    panGains(voice.pan, voice.gain, left1, right1);
+    
+    const float step = 1.0f / count;
+    for (int i = 0; i < count; ++i) {
+        float t = i * step;
+        float sample = voiceBlock[i];
+        stereo[i * 2] += sample * (left0 + (left1 - left0) * t);
+        stereo[i * 2 + 1] += sample * (right0 + (right1 - right0) * t);
+    }
 }
 
 void WindSoundSynthesizer::updateFilters() {
-    float sampleRate = config.sampleRate;
+    if (engine == WindSoundEngine::Wavetable) return;   // The loops carry their filters
+    const WindSoundConfig& cfg = paramBuffer.front().config;
+    float sampleRate = cfg.sampleRate;
     
     // Intensity affects filter cutoffs for more dynamic sound
     float intensityMod = 0.8f + currentIntensity * 0.4f;
     
     // Low rumble filter
-    float lowCutoff = config.lowPassBase * intensityMod;
+    float lowCutoff = cfg.lowPassBase * intensityMod;
     lowPassLow.setCoefficients(BiquadFilter::Type::LowPass, lowCutoff, 0.7f, sampleRate);
     
     // Mid woosh bandpass
-    float midLow = config.midLowPass * intensityMod;
-    float midHigh = config.midHighPass;
+    float midLow = cfg.midLowPass * intensityMod;
+    float midHigh = cfg.midHighPass;
     lowPassMid.setCoefficients(BiquadFilter::Type::LowPass, midLow, 0.5f, sampleRate);
     highPassMid.setCoefficients(BiquadFilter::Type::HighPass, midHigh, 0.5f, sampleRate);
     
     // High whistle filter - opens up with intensity
-    float highCutoff = config.highPassBase + currentIntensity * 1500.0f;
+    float highCutoff = cfg.highPassBase + currentIntensity * 1500.0f;
     highPassHigh.setCoefficients(BiquadFilter::Type::HighPass, highCutoff, 0.6f, sampleRate);
     lowPassHigh.setCoefficients(BiquadFilter::Type::LowPass, 8000.0f, 0.4f, sampleRate);
     
@@ -476,18 +1074,19 @@ void WindSoundSynthesizer::updateFilters() {
 }
 
 void WindSoundSynthesizer::checkForGust(float dt) {
-    if (gustGen.isActive()) return;
+    if (gustActive.load(std::memory_order_relaxed)) return;
     
     gustTimer += dt;
     
     // Random gust chance based on wind intensity
-    float gustChance = config.gustRate * (0.3f + windIntensityNorm * 0.7f + playerSpeedNorm * 0.5f);
+    float gustChance = config.gustRate * (0.3f + windIntensityNorm * 0.7f + params.playerSpeedNorm * 0.5f);
     
     if (gustTimer > 1.0f / gustChance) {
         // Trigger gust with random intensity
-        float gustIntensity = 0.4f + (float)(rand() % 60) / 100.0f;
-        gustIntensity *= (0.5f + currentIntensity * 0.5f);
-        gustGen.trigger(gustIntensity);
+        float gustIntensity = gustRng.range(0.4f, 1.0f);
+        gustIntensity *= (0.5f + params.targetIntensity * 0.5f);
+        params.gustSerial++;
+        params.gustIntensity = gustIntensity;
         gustTimer = 0.0f;
     }
 }
@@ -1,13 +1,21 @@
 #pragma once
 #include "raylib.h"
 #include "core/Vector3D.hpp"
+#include "physics/WindField3D.hpp"
+#include "utils/Random.hpp"
+#include "utils/TripleBuffer.hpp"
+#include <atomic>
 #include <cmath>
-#include <random>
+#include <cstdint>
 #include <vector>
 #include <array>
 
 namespace ethereal {
 
+// Procedural filters noise per sample; Wavetable replays pre-rendered loops of the
+// same layers, for low-end devices
+enum class WindSoundEngine : uint8_t { Procedural, Wavetable };
+
 struct WindSoundConfig {
     float masterVolume = 0.7f;
     float sampleRate = 44100.0f;
@@ -34,6 +42,57 @@ struct WindSoundConfig {
     float speedInfluence = 0.8f;     // How much player speed affects sound
     float windInfluence = 0.6f;      // How much wind field affects sound
     float altitudeInfluence = 0.3f;  // How altitude affects sound
+    
+    // Audio-side smoothing of the published intensity (per second)
+    float intensitySmoothing = 3.0f;
+    
+    // Every noise source, LFO and gust derives its generator from this
+    uint32_t seed = 0x57494e44;
+    
+    // Spatial mode: a stereo stream with one cheap voice per nearby gust or vortex,
+    // panned and filtered from the listener. 0 keeps the mono ambient synth; the
+    // channel count is fixed when the stream is created.
+    int spatialVoices = 0;           // Up to MAX_VOICES
+    float voiceVolume = 0.5f;
+    float voiceRange = 600.0f;       // Emitters farther than this past their radius are silent
+    float voiceRolloff = 120.0f;     // Distance past the radius where a voice is at half loudness
+    float voiceSmoothing = 6.0f;     // Gain and pan glide (per second)
+    
+    // Engine for the ambient layers, fixed when the stream is created like the
+    // channel count. The wavetable loops are rendered once per seed and filter
+    // settings (about loopSeconds * sampleRate * 12 floats).
+    WindSoundEngine engine = WindSoundEngine::Procedural;
+    float loopSeconds = 1.5f;
+    int loopLevels = 3;              // Intensity steps rendered for each filtered layer
+};
+
+// Where the spatial voices are heard from
+struct WindListener {
+    Vector3D position;
+    Vector3D forward = Vector3D(0, 0, 1);
+    Vector3D up = Vector3D(0, 1, 0);
+};
+
+// One emitter voice as seen by the listener; emitterId 0 is an idle slot
+struct WindVoiceParams {
+    uint32_t emitterId = 0;
+    float gain = 0.0f;
+    float pan = 0.0f;                // -1 left, 1 right
+    float cutoff = 1000.0f;          // Hz: low-pass for gusts, band center for vortices
+    bool vortex = false;
+};
+
+constexpr int kMaxWindVoices = 8;
+
+// Game-thread state handed to the audio callback once per update
+struct WindSoundParams {
+    WindSoundConfig config;
+    float targetIntensity = 0.0f;
+    float playerSpeedNorm = 0.0f;
+    float altitudeNorm = 0.0f;
+    uint32_t gustSerial = 0;         // Bumped for every requested gust
+    float gustIntensity = 0.0f;
+    std::array<WindVoiceParams, kMaxWindVoices> voices{};
 };
 
 // Simple biquad filter for shaping noise
@@ -45,6 +104,8 @@ public:
     
     void setCoefficients(Type type, float frequency, float q, float sampleRate);
     float process(float input);
+    // In-place over a buffer; state stays in registers for the whole block
+    void processBlock(float* data, int count);
     void reset();
     
 private:
@@ -55,41 +116,52 @@ private:
 // Low-frequency oscillator for natural modulation
 class LFO {
 public:
-    LFO(float rate = 1.0f, float phase = 0.0f) 
-        : rate(rate), phase(phase), sampleRate(44100.0f) {}
+    LFO(float rate = 1.0f, float phase = 0.0f, uint64_t seed = 0) 
+        : rate(rate), phase(phase), sampleRate(44100.0f), rng(seed) {}
     
     void setRate(float r) { rate = r; }
     void setSampleRate(float sr) { sampleRate = sr; }
+    void reseed(uint64_t seed) { rng.reseed(seed); }
     
     float sine();           // Smooth sine wave
     float triangle();       // Triangle wave
     float smoothRandom();   // Smoothed random (Perlin-like)
     void advance();
     
+    // Control-rate versions: advance by a whole block of samples at once
+    float smoothRandomBlock(int samples);
+    void advance(int samples);
+    
 private:
     float rate;
     float phase;
     float sampleRate;
     float smoothValue = 0.0f;
     float targetValue = 0.0f;
-    std::mt19937 rng{std::random_device{}()};
+    Pcg32 rng;
 };
 
 // Noise generator with different characteristics
 class NoiseGenerator {
 public:
-    NoiseGenerator();
+    explicit NoiseGenerator(uint64_t seed = 0);
     
     float white();          // Pure white noise
     float pink();           // Pink noise (1/f)
     float brown();          // Brown/red noise (1/f²)
     float filtered(float cutoff, float resonance);  // Filtered noise
     
+    // Block versions of the generators above
+    void whiteBlock(float* out, int count);
+    void pinkBlock(float* out, int count);
+    void brownBlock(float* out, int count);
+    void filteredBlock(float* out, int count, float cutoff, float resonance);
+    
     void reset();
+    void reseed(uint64_t seed) { rng.reseed(seed); }
     
 private:
-    std::mt19937 rng;
-    std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+    Pcg32 rng;
     
     // Pink noise state (Voss-McCartney algorithm)
     std::array<float, 16> pinkRows{};
@@ -106,14 +178,17 @@ private:
 // Wind gust generator for natural-sounding gusts
 class GustGenerator {
 public:
-    GustGenerator(float sampleRate = 44100.0f);
+    explicit GustGenerator(float sampleRate = 44100.0f, uint64_t seed = 0);
     
     float generate();
     void trigger(float intensity = 1.0f);
     void update();
+    // Envelope at the start and end of the next `samples`, then advances past them
+    void advanceBlock(int samples, float& startEnvelope, float& endEnvelope);
     bool isActive() const { return active; }
     
     void setSampleRate(float sr) { sampleRate = sr; }
+    void reseed(uint64_t seed) { rng.reseed(seed); }
     
 private:
     float sampleRate;
@@ -124,7 +199,41 @@ private:
     float attackTime = 0.0f;
     float decayTime = 0.0f;
     
-    std::mt19937 rng{std::random_device{}()};
+    Pcg32 rng;
+    
+    float envelopeAt(float time) const;
+};
+
+// Seamless loops of each ambient layer, rendered with the procedural noise and
+// filters. Layers whose filters follow the intensity are rendered at loopLevels
+// intensities (from the same noise, so neighbours crossfade cleanly); each layer
+// has a slightly different length so the loops never repeat in step.
+class WindLoopBank {
+public:
+    enum Layer { Low, Mid, High, Gust, Whoosh, Air, LayerCount };
+    
+    void build(const WindSoundConfig& config);
+    void clear();
+    bool isBuilt() const { return built; }
+    // True when the loops were rendered with the settings `config` asks for
+    bool matches(const WindSoundConfig& config) const;
+    
+    int getLevels(Layer layer) const { return layers[layer].levels; }
+    size_t getLength(Layer layer) const { return layers[layer].length; }
+    const float* getLoop(Layer layer, int level) const {
+        return layers[layer].samples.data() + static_cast<size_t>(level) * layers[layer].length;
+    }
+    size_t getMemoryBytes() const;
+    
+private:
+    struct LayerLoops {
+        size_t length = 0;
+        int levels = 0;
+        std::vector<float> samples;  // levels x length
+    };
+    std::array<LayerLoops, LayerCount> layers;
+    WindSoundConfig builtConfig;
+    bool built = false;
 };
 
 class WindSoundSynthesizer {
@@ -138,6 +247,9 @@ public:
     
     // Main update - call each frame with game state
     void update(float dt, float playerSpeed, float windIntensity, float altitude);
+    // Spatial update: ambient intensity from the wind at the listener, and the
+    // loudest emitters (stable per voice while they stay audible) for the voices
+    void update(float dt, float playerSpeed, float altitude, const WindListener& listener, const WindField3D& wind);
     
     // Set intensity directly (0-1)
     void setIntensity(float intensity);
@@ -151,27 +263,85 @@ public:
     
     // Enable/disable
     void setEnabled(bool enabled);
-    bool isEnabled() const { return enabled; }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
     
     // Access config
     const WindSoundConfig& getConfig() const { return config; }
     void setConfig(const WindSoundConfig& cfg);
+    
+    // Renders the next frames as 16-bit samples, interleaved stereo in spatial mode.
+    // The stream callback calls this; without initialize() it renders offline
+    // (benchmarks, bouncing to disk)
+    void render(short* output, unsigned int frames);
+    int getChannels() const { return channels; }
+    WindSoundEngine getEngine() const { return engine; }
+    const WindLoopBank& getLoopBank() const { return loopBank; }
+    
+    // Streams that can play at once (one raylib callback slot each)
+    static constexpr int MAX_INSTANCES = 4;
+    static constexpr int MAX_VOICES = kMaxWindVoices;
 
 private:
+    // === Game thread ===
     WindSoundConfig config;
+    WindSoundParams params;
     bool initialized = false;
-    bool enabled = true;
+    std::atomic<bool> enabled{true};
+    int slot = -1;
+    float windIntensityNorm = 0.0f;
+    float gustTimer = 0.0f;
+    Pcg32 gustRng;
+    int channels = 1;
+    WindSoundEngine engine = WindSoundEngine::Procedural;
+    std::vector<WindEmitter3D> emitterScratch;
+    std::vector<WindVoiceParams> voiceCandidates;
+    
+    // Latest params, published by update() and picked up per callback
+    TripleBuffer<WindSoundParams> paramBuffer;
+    std::atomic<bool> gustActive{false};
     
     AudioStream stream;
     std::vector<float> buffer;
     static constexpr int BUFFER_SIZE = 4096;
     
+    // === Audio thread ===
+    // Modulation and parameters run at control rate, once per this many samples
+    static constexpr int CONTROL_BLOCK = 64;
+    std::array<float, CONTROL_BLOCK> lowBlock{};
+    std::array<float, CONTROL_BLOCK> midBlock{};
+    std::array<float, CONTROL_BLOCK> highBlock{};
+    std::array<float, CONTROL_BLOCK> gustBlock{};
+    std::array<float, CONTROL_BLOCK> whooshBlock{};
+    std::array<float, CONTROL_BLOCK> airBlock{};
+    
+    // Per-layer gains at a control block's edges, ramped per sample by the mix
+    struct LayerGains {
+        float low, mid, high, gust, whoosh, air;
+    };
+    
+    // Wavetable engine: built on the game thread before the stream starts, then read-only
+    WindLoopBank loopBank;
+    std::array<size_t, WindLoopBank::LayerCount> loopPhase{};
+    float whooshState = 0.0f;
+    
+    // Cheap emitter voice: one pink noise source through one filter
+    struct SpatialVoice {
+        NoiseGenerator noise;
+        BiquadFilter filter;
+        uint32_t emitterId = 0;
+        float gain = 0.0f;
+        float pan = 0.0f;
+        float cutoff = 0.0f;
+        bool vortex = false;
+    };
+    std::array<SpatialVoice, MAX_VOICES> voices;
+    std::array<float, CONTROL_BLOCK> voiceBlock{};
+    std::vector<float> stereoBuffer;
+    
     // Current state
     float currentIntensity = 0.0f;
-    float targetIntensity = 0.0f;
-    float playerSpeedNorm = 0.0f;
-    float windIntensityNorm = 0.0f;
-    float altitudeNorm = 0.0f;
+    uint32_t lastGustSerial = 0;
+    uint32_t appliedSeed = 0;
     
     // Synthesis components
     NoiseGenerator noiseGenLow;
@@ -195,18 +365,29 @@ private:
     
     // Time tracking
     float sampleTime = 0.0f;
-    float gustTimer = 0.0f;
     
     // Internal methods
+    void publishParams();
+    void applyParams();
+    void reseedSources(uint32_t seed);
     void generateSamples(float* output, int frameCount);
-    float synthesizeSample();
+    void synthesizeBlock(float* output, int count);
+    void renderProceduralLayers(int count, float playerSpeedNorm, bool whooshActive, bool airActive);
+    void renderLoopLayers(int count, float playerSpeedNorm, bool whooshActive, bool airActive);
+    void readLoop(WindLoopBank::Layer layer, float* out, int count);
+    void selectEngine(const WindSoundConfig& cfg);
     void updateFilters();
-    void updateModulation();
     void checkForGust(float dt);
+    void updateAmbient(float dt, float playerSpeed, float windIntensity, float altitude);
+    void assignVoices(const WindListener& listener, const WindField3D& wind);
+    void renderVoices(float* stereo, int frameCount);
+    void renderVoiceBlock(SpatialVoice& voice, const WindVoiceParams& target, float* stereo, int count);
     
-    // Audio callback (static for raylib)
+    // raylib callbacks carry no user pointer, so each slot gets its own trampoline
+    template <int Slot>
     static void audioCallback(void* bufferData, unsigned int frames);
-    static WindSoundSynthesizer* activeInstance;
+    static std::array<std::atomic<WindSoundSynthesizer*>, MAX_INSTANCES> instances;
+    static int deviceUsers;
 };
 
 } // namespace ethereal
@@ -1,40 +1,466 @@
 #pragma once
+#include "Simd.hpp"
 #include "Vector3D.hpp"
 #include <array>
 #include <cmath>
+#include <cstddef>
 
 namespace ethereal {
 
+// Column-major 4x4 (m[col * 4 + row]), column vectors, GL clip conventions.
+// Header-only: construction and element access are constexpr, and the product,
+// inverse and point transforms use SSE/NEON when Simd.hpp finds a vector unit.
 struct Matrix4 {
     std::array<float, 16> m;
 
-    Matrix4();
-    
-    static Matrix4 identity();
-    static Matrix4 translation(float x, float y, float z);
-    static Matrix4 translation(const Vector3D& v);
-    static Matrix4 scale(float x, float y, float z);
-    static Matrix4 scale(float s);
+    constexpr Matrix4() : m{} {}
+
+    static constexpr Matrix4 identity();
+    static constexpr Matrix4 translation(float x, float y, float z);
+    static constexpr Matrix4 translation(const Vector3D& v) { return translation(v.x, v.y, v.z); }
+    static constexpr Matrix4 scale(float x, float y, float z);
+    static constexpr Matrix4 scale(float s) { return scale(s, s, s); }
     static Matrix4 rotationX(float angle);
     static Matrix4 rotationY(float angle);
     static Matrix4 rotationZ(float angle);
     static Matrix4 rotation(const Vector3D& axis, float angle);
     static Matrix4 lookAt(const Vector3D& eye, const Vector3D& target, const Vector3D& up);
     static Matrix4 perspective(float fov, float aspect, float near, float far);
-    static Matrix4 orthographic(float left, float right, float bottom, float top, float near, float far);
+    static constexpr Matrix4 orthographic(float left, float right, float bottom, float top, float near, float far);
 
     Matrix4 operator*(const Matrix4& other) const;
-    Vector3D operator*(const Vector3D& v) const;
-    
-    Matrix4 transposed() const;
+    Vector3D operator*(const Vector3D& v) const { return transformPoint(v); }
+
+    constexpr Matrix4 transposed() const;
     Matrix4 inverted() const;
-    float determinant() const;
+    constexpr float determinant() const;
 
     Vector3D transformPoint(const Vector3D& p) const;
-    Vector3D transformDirection(const Vector3D& d) const;
+    constexpr Vector3D transformDirection(const Vector3D& d) const {
+        return Vector3D(m[0] * d.x + m[4] * d.y + m[8] * d.z,
+                        m[1] * d.x + m[5] * d.y + m[9] * d.z,
+                        m[2] * d.x + m[6] * d.y + m[10] * d.z);
+    }
+    // Batched transformPoint; in and out may alias
+    void transformPoints(const Vector3D* in, Vector3D* out, size_t count) const;
+    // Same over separate x/y/z arrays, four points per SIMD step
+    void transformPoints(const float* x, const float* y, const float* z,
+                         float* outX, float* outY, float* outZ, size_t count) const;
 
-    float& at(int row, int col);
-    float at(int row, int col) const;
+    constexpr float& at(int row, int col) { return m[col * 4 + row]; }
+    constexpr float at(int row, int col) const { return m[col * 4 + row]; }
+
+    // Reference paths, also used where no vector unit is available
+    constexpr Matrix4 multiplyScalar(const Matrix4& other) const;
+    Matrix4 invertedScalar() const;
 };
 
+// === Construction ===
+
+constexpr Matrix4 Matrix4::identity() {
+    Matrix4 result;
+    result.m[0] = result.m[5] = result.m[10] = result.m[15] = 1.0f;
+    return result;
+}
+
+constexpr Matrix4 Matrix4::translation(float x, float y, float z) {
+    Matrix4 result = identity();
+    result.m[12] = x;
+    result.m[13] = y;
+    result.m[14] = z;
+    return result;
+}
+
+constexpr Matrix4 Matrix4::scale(float x, float y, float z) {
+    Matrix4 result = identity();
+    result.m[0] = x;
+    result.m[5] = y;
+    result.m[10] = z;
+    return result;
+}
+
+inline Matrix4 Matrix4::rotationX(float angle) {
+    Matrix4 result = identity();
+    float c = std::cos(angle);
+    float s = std::sin(angle);
+    result.m[5] = c;
+    result.m[6] = s;
+    result.m[9] = -s;
+    result.m[10] = c;
+    return result;
+}
+
+inline Matrix4 Matrix4::rotationY(float angle) {
+    Matrix4 result = identity();
+    float c = std::cos(angle);
+    float s = std::sin(angle);
+    result.m[0] = c;
+    result.m[2] = -s;
+    result.m[8] = s;
+    result.m[10] = c;
+    return result;
+}
+
+inline Matrix4 Matrix4::rotationZ(float angle) {
+    Matrix4 result = identity();
+    float c = std::cos(angle);
+    float s = std::sin(angle);
+    result.m[0] = c;
+    result.m[1] = s;
+    result.m[4] = -s;
+    result.m[5] = c;
+    return result;
+}
+
+inline Matrix4 Matrix4::rotation(const Vector3D& axis, float angle) {
+    Matrix4 result = identity();
+    Vector3D a = axis.normalized();
+    float c = std::cos(angle);
+    float s = std::sin(angle);
+    float t = 1.0f - c;
+
+    result.m[0] = t * a.x * a.x + c;
+    result.m[1] = t * a.x * a.y + s * a.z;
+    result.m[2] = t * a.x * a.z - s * a.y;
+
+    result.m[4] = t * a.x * a.y - s * a.z;
+    result.m[5] = t * a.y * a.y + c;
+    result.m[6] = t * a.y * a.z + s * a.x;
+
+    result.m[8] = t * a.x * a.z + s * a.y;
+    result.m[9] = t * a.y * a.z - s * a.x;
+    result.m[10] = t * a.z * a.z + c;
+
+    return result;
+}
+
+inline Matrix4 Matrix4::lookAt(const Vector3D& eye, const Vector3D& target, const Vector3D& up) {
+    Vector3D f = (target - eye).normalized();
+    Vector3D r = f.cross(up).normalized();
+    Vector3D u = r.cross(f);
+
+    Matrix4 result = identity();
+    result.m[0] = r.x;
+    result.m[4] = r.y;
+    result.m[8] = r.z;
+    result.m[1] = u.x;
+    result.m[5] = u.y;
+    result.m[9] = u.z;
+    result.m[2] = -f.x;
+    result.m[6] = -f.y;
+    result.m[10] = -f.z;
+    result.m[12] = -r.dot(eye);
+    result.m[13] = -u.dot(eye);
+    result.m[14] = f.dot(eye);
+    return result;
+}
+
+inline Matrix4 Matrix4::perspective(float fov, float aspect, float near, float far) {
+    Matrix4 result;
+    float tanHalf = std::tan(fov * 0.5f);
+    result.m[0] = 1.0f / (aspect * tanHalf);
+    result.m[5] = 1.0f / tanHalf;
+    result.m[10] = -(far + near) / (far - near);
+    result.m[11] = -1.0f;
+    result.m[14] = -(2.0f * far * near) / (far - near);
+    return result;
+}
+
+constexpr Matrix4 Matrix4::orthographic(float left, float right, float bottom, float top, float near, float far) {
+    Matrix4 result = identity();
+    result.m[0] = 2.0f / (right - left);
+    result.m[5] = 2.0f / (top - bottom);
+    result.m[10] = -2.0f / (far - near);
+    result.m[12] = -(right + left) / (right - left);
+    result.m[13] = -(top + bottom) / (top - bottom);
+    result.m[14] = -(far + near) / (far - near);
+    return result;
+}
+
+// === Scalar reference ===
+
+constexpr Matrix4 Matrix4::multiplyScalar(const Matrix4& other) const {
+    Matrix4 result;
+    for (int row = 0; row < 4; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            result.m[col * 4 + row] =
+                m[0 * 4 + row] * other.m[col * 4 + 0] +
+                m[1 * 4 + row] * other.m[col * 4 + 1] +
+                m[2 * 4 + row] * other.m[col * 4 + 2] +
+                m[3 * 4 + row] * other.m[col * 4 + 3];
+        }
+    }
+    return result;
+}
+
+constexpr Matrix4 Matrix4::transposed() const {
+    Matrix4 result;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            result.m[j * 4 + i] = m[i * 4 + j];
+        }
+    }
+    return result;
+}
+
+constexpr float Matrix4::determinant() const {
+    float a = m[0], b = m[1], c = m[2], d = m[3];
+    float e = m[4], f = m[5], g = m[6], h = m[7];
+    float i = m[8], j = m[9], k = m[10], l = m[11];
+    float n = m[12], o = m[13], p = m[14], q = m[15];
+
+    return a * (f * (k * q - l * p) - g * (j * q - l * o) + h * (j * p - k * o))
+         - b * (e * (k * q - l * p) - g * (i * q - l * n) + h * (i * p - k * n))
+         + c * (e * (j * q - l * o) - f * (i * q - l * n) + h * (i * o - j * n))
+         - d * (e * (j * p - k * o) - f * (i * p - k * n) + g * (i * o - j * n));
+}
+
+inline Matrix4 Matrix4::invertedScalar() const {
+    Matrix4 inv;
+    float det;
+
+    inv.m[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+    inv.m[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+    inv.m[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+    inv.m[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+    inv.m[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+    inv.m[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+    inv.m[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+    inv.m[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+    inv.m[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+    inv.m[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+    inv.m[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+    inv.m[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+    inv.m[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+    inv.m[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+    inv.m[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+    inv.m[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+    det = m[0] * inv.m[0] + m[1] * inv.m[4] + m[2] * inv.m[8] + m[3] * inv.m[12];
+
+    if (std::abs(det) < 0.0001f) return identity();
+
+    det = 1.0f / det;
+    for (int i = 0; i < 16; i++) inv.m[i] *= det;
+
+    return inv;
+}
+
+// === SIMD ===
+
+#if defined(LOOM_SIMD_SSE)
+namespace simd {
+
+#define LOOM_SHUFFLE(a, b, x, y, z, w) _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+#define LOOM_SWIZZLE(v, x, y, z, w) LOOM_SHUFFLE(v, v, x, y, z, w)
+
+// 2x2 blocks packed (m00, m01, m10, m11): A * B, adj(A) * B and A * adj(B)
+inline __m128 mat2Mul(__m128 a, __m128 b) {
+    return _mm_add_ps(_mm_mul_ps(a, LOOM_SWIZZLE(b, 0, 3, 0, 3)),
+                      _mm_mul_ps(LOOM_SWIZZLE(a, 1, 0, 3, 2), LOOM_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+inline __m128 mat2AdjMul(__m128 a, __m128 b) {
+    return _mm_sub_ps(_mm_mul_ps(LOOM_SWIZZLE(a, 3, 3, 0, 0), b),
+                      _mm_mul_ps(LOOM_SWIZZLE(a, 1, 1, 2, 2), LOOM_SWIZZLE(b, 2, 3, 0, 1)));
+}
+
+inline __m128 mat2MulAdj(__m128 a, __m128 b) {
+    return _mm_sub_ps(_mm_mul_ps(a, LOOM_SWIZZLE(b, 3, 0, 3, 0)),
+                      _mm_mul_ps(LOOM_SWIZZLE(a, 1, 0, 3, 2), LOOM_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+} // namespace simd
+#endif
+
+inline Matrix4 Matrix4::operator*(const Matrix4& other) const {
+#if defined(LOOM_SIMD_SSE)
+    // Each result column is this matrix's columns weighted by the other's column
+    const __m128 c0 = _mm_loadu_ps(&m[0]);
+    const __m128 c1 = _mm_loadu_ps(&m[4]);
+    const __m128 c2 = _mm_loadu_ps(&m[8]);
+    const __m128 c3 = _mm_loadu_ps(&m[12]);
+    Matrix4 result;
+    for (int col = 0; col < 4; ++col) {
+        const float* b = &other.m[col * 4];
+        __m128 sum = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(b[0])), _mm_mul_ps(c1, _mm_set1_ps(b[1])));
+        sum = _mm_add_ps(sum, _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(b[2])), _mm_mul_ps(c3, _mm_set1_ps(b[3]))));
+        _mm_storeu_ps(&result.m[col * 4], sum);
+    }
+    return result;
+#elif defined(LOOM_SIMD_NEON)
+    const float32x4_t c0 = vld1q_f32(&m[0]);
+    const float32x4_t c1 = vld1q_f32(&m[4]);
+    const float32x4_t c2 = vld1q_f32(&m[8]);
+    const float32x4_t c3 = vld1q_f32(&m[12]);
+    Matrix4 result;
+    for (int col = 0; col < 4; ++col) {
+        const float* b = &other.m[col * 4];
+        float32x4_t sum = vmulq_n_f32(c0, b[0]);
+        sum = vmlaq_n_f32(sum, c1, b[1]);
+        sum = vmlaq_n_f32(sum, c2, b[2]);
+        sum = vmlaq_n_f32(sum, c3, b[3]);
+        vst1q_f32(&result.m[col * 4], sum);
+    }
+    return result;
+#else
+    return multiplyScalar(other);
+#endif
+}
+
+inline Matrix4 Matrix4::inverted() const {
+#if defined(LOOM_SIMD_SSE)
+    // Block inverse over 2x2 sub-matrices. The columns are treated as rows, which
+    // inverts the transpose; storing the rows back as columns undoes it.
+    const __m128 r0 = _mm_loadu_ps(&m[0]);
+    const __m128 r1 = _mm_loadu_ps(&m[4]);
+    const __m128 r2 = _mm_loadu_ps(&m[8]);
+    const __m128 r3 = _mm_loadu_ps(&m[12]);
+
+    __m128 a = _mm_movelh_ps(r0, r1);
+    __m128 b = _mm_movehl_ps(r1, r0);
+    __m128 c = _mm_movelh_ps(r2, r3);
+    __m128 d = _mm_movehl_ps(r3, r2);
+
+    // (|A|, |B|, |C|, |D|)
+    __m128 detSub = _mm_sub_ps(
+        _mm_mul_ps(LOOM_SHUFFLE(r0, r2, 0, 2, 0, 2), LOOM_SHUFFLE(r1, r3, 1, 3, 1, 3)),
+        _mm_mul_ps(LOOM_SHUFFLE(r0, r2, 1, 3, 1, 3), LOOM_SHUFFLE(r1, r3, 0, 2, 0, 2)));
+    __m128 detA = LOOM_SWIZZLE(detSub, 0, 0, 0, 0);
+    __m128 detB = LOOM_SWIZZLE(detSub, 1, 1, 1, 1);
+    __m128 detC = LOOM_SWIZZLE(detSub, 2, 2, 2, 2);
+    __m128 detD = LOOM_SWIZZLE(detSub, 3, 3, 3, 3);
+
+    __m128 dC = simd::mat2AdjMul(d, c);
+    __m128 aB = simd::mat2AdjMul(a, b);
+    __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), simd::mat2Mul(b, dC));
+    __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), simd::mat2Mul(c, aB));
+    __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), simd::mat2MulAdj(d, aB));
+    __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), simd::mat2MulAdj(a, dC));
+
+    // |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+    __m128 tr = _mm_mul_ps(aB, LOOM_SWIZZLE(dC, 0, 2, 1, 3));
+    tr = _mm_add_ps(tr, LOOM_SWIZZLE(tr, 2, 3, 0, 1));
+    tr = _mm_add_ps(tr, LOOM_SWIZZLE(tr, 1, 0, 3, 2));
+    __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+    if (std::abs(_mm_cvtss_f32(detM)) < 0.0001f) return identity();
+
+    __m128 rDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+    x = _mm_mul_ps(x, rDetM);
+    y = _mm_mul_ps(y, rDetM);
+    z = _mm_mul_ps(z, rDetM);
+    w = _mm_mul_ps(w, rDetM);
+
+    Matrix4 result;
+    _mm_storeu_ps(&result.m[0], LOOM_SHUFFLE(x, y, 3, 1, 3, 1));
+    _mm_storeu_ps(&result.m[4], LOOM_SHUFFLE(x, y, 2, 0, 2, 0));
+    _mm_storeu_ps(&result.m[8], LOOM_SHUFFLE(z, w, 3, 1, 3, 1));
+    _mm_storeu_ps(&result.m[12], LOOM_SHUFFLE(z, w, 2, 0, 2, 0));
+    return result;
+#else
+    return invertedScalar();
+#endif
+}
+
+#if defined(LOOM_SIMD_SSE)
+#undef LOOM_SWIZZLE
+#undef LOOM_SHUFFLE
+#endif
+
+// === Transforms ===
+
+inline Vector3D Matrix4::transformPoint(const Vector3D& p) const {
+#if defined(LOOM_SIMD_SSE)
+    __m128 r = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&m[0]), _mm_set1_ps(p.x)),
+                          _mm_mul_ps(_mm_loadu_ps(&m[4]), _mm_set1_ps(p.y)));
+    r = _mm_add_ps(r, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&m[8]), _mm_set1_ps(p.z)), _mm_loadu_ps(&m[12])));
+    float v[4];
+    _mm_storeu_ps(v, r);
+#elif defined(LOOM_SIMD_NEON)
+    float32x4_t r = vmlaq_n_f32(vld1q_f32(&m[12]), vld1q_f32(&m[0]), p.x);
+    r = vmlaq_n_f32(r, vld1q_f32(&m[4]), p.y);
+    r = vmlaq_n_f32(r, vld1q_f32(&m[8]), p.z);
+    float v[4];
+    vst1q_f32(v, r);
+#else
+    const float v[4] = {
+        m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12],
+        m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13],
+        m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14],
+        m[3] * p.x + m[7] * p.y + m[11] * p.z + m[15]
+    };
+#endif
+    float w = v[3];
+    if (std::abs(w) < 0.0001f) w = 1.0f;
+    return Vector3D(v[0] / w, v[1] / w, v[2] / w);
+}
+
+inline void Matrix4::transformPoints(const Vector3D* in, Vector3D* out, size_t count) const {
+    for (size_t i = 0; i < count; ++i) out[i] = transformPoint(in[i]);
+}
+
+inline void Matrix4::transformPoints(const float* x, const float* y, const float* z,
+                                     float* outX, float* outY, float* outZ, size_t count) const {
+    size_t i = 0;
+#if defined(LOOM_SIMD_SSE)
+    const __m128 epsilon = _mm_set1_ps(0.0001f);
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    auto row = [&](int r, __m128 px, __m128 py, __m128 pz) {
+        __m128 sum = _mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(m[r])), _mm_mul_ps(py, _mm_set1_ps(m[4 + r])));
+        return _mm_add_ps(sum, _mm_add_ps(_mm_mul_ps(pz, _mm_set1_ps(m[8 + r])), _mm_set1_ps(m[12 + r])));
+    };
+    for (; i + 4 <= count; i += 4) {
+        __m128 px = _mm_loadu_ps(x + i);
+        __m128 py = _mm_loadu_ps(y + i);
+        __m128 pz = _mm_loadu_ps(z + i);
+        __m128 w = row(3, px, py, pz);
+        // Same degenerate-w rule as transformPoint
+        __m128 tiny = _mm_cmplt_ps(_mm_andnot_ps(signBit, w), epsilon);
+        w = _mm_or_ps(_mm_and_ps(tiny, one), _mm_andnot_ps(tiny, w));
+        __m128 rw = _mm_div_ps(one, w);
+        __m128 rx = _mm_mul_ps(row(0, px, py, pz), rw);
+        __m128 ry = _mm_mul_ps(row(1, px, py, pz), rw);
+        __m128 rz = _mm_mul_ps(row(2, px, py, pz), rw);
+        _mm_storeu_ps(outX + i, rx);
+        _mm_storeu_ps(outY + i, ry);
+        _mm_storeu_ps(outZ + i, rz);
+    }
+#elif defined(LOOM_SIMD_NEON)
+    const float32x4_t epsilon = vdupq_n_f32(0.0001f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    auto row = [&](int r, float32x4_t px, float32x4_t py, float32x4_t pz) {
+        float32x4_t sum = vmlaq_n_f32(vdupq_n_f32(m[12 + r]), px, m[r]);
+        sum = vmlaq_n_f32(sum, py, m[4 + r]);
+        return vmlaq_n_f32(sum, pz, m[8 + r]);
+    };
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t px = vld1q_f32(x + i);
+        float32x4_t py = vld1q_f32(y + i);
+        float32x4_t pz = vld1q_f32(z + i);
+        float32x4_t w = row(3, px, py, pz);
+        w = vbslq_f32(vcltq_f32(vabsq_f32(w), epsilon), one, w);
+        float32x4_t rx = row(0, px, py, pz);
+        float32x4_t ry = row(1, px, py, pz);
+        float32x4_t rz = row(2, px, py, pz);
+        float wl[4], xl[4], yl[4], zl[4];
+        vst1q_f32(wl, w);
+        vst1q_f32(xl, rx);
+        vst1q_f32(yl, ry);
+        vst1q_f32(zl, rz);
+        for (int lane = 0; lane < 4; ++lane) {
+            outX[i + lane] = xl[lane] / wl[lane];
+            outY[i + lane] = yl[lane] / wl[lane];
+            outZ[i + lane] = zl[lane] / wl[lane];
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        Vector3D p = transformPoint(Vector3D(x[i], y[i], z[i]));
+        outX[i] = p.x;
+        outY[i] = p.y;
+        outZ[i] = p.z;
+    }
+}
+
 } // namespace ethereal
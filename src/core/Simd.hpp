@@ -0,0 +1,36 @@
+#pragma once
+
+// Compile-time SIMD backend selection shared by the batched kernels.
+// Exactly one of LOOM_SIMD_AVX, LOOM_SIMD_SSE, LOOM_SIMD_NEON is defined when
+// a vector unit is available; otherwise kernels fall back to scalar loops.
+// Defining LOOM_DISABLE_SIMD forces the scalar paths.
+
+#if !defined(LOOM_DISABLE_SIMD)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define LOOM_SIMD_AVX 1
+#define LOOM_SIMD_SSE 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LOOM_SIMD_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define LOOM_SIMD_NEON 1
+#endif
+#endif
+
+namespace ethereal {
+
+inline const char* simdBackendName() {
+#if defined(LOOM_SIMD_AVX)
+    return "avx";
+#elif defined(LOOM_SIMD_SSE)
+    return "sse";
+#elif defined(LOOM_SIMD_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace ethereal
@@ -1,42 +1,76 @@
 #pragma once
 #include <cmath>
+#include "Simd.hpp"
 #include "Vector2D.hpp"
 
 namespace ethereal {
 
+// Header-only so every operator inlines into the physics and rendering loops.
+// Everything except the length/normalize family is constexpr.
 struct Vector3D {
     float x = 0.0f;
     float y = 0.0f;
     float z = 0.0f;
 
-    Vector3D() = default;
-    Vector3D(float x, float y, float z);
-    Vector3D(const Vector2D& v2, float z = 0.0f);
+    constexpr Vector3D() = default;
+    constexpr Vector3D(float x, float y, float z) : x(x), y(y), z(z) {}
+    constexpr Vector3D(const Vector2D& v2, float z = 0.0f) : x(v2.x), y(v2.y), z(z) {}
 
-    Vector3D operator+(const Vector3D& other) const;
-    Vector3D operator-(const Vector3D& other) const;
-    Vector3D operator*(float scalar) const;
-    Vector3D operator/(float scalar) const;
+    constexpr Vector3D operator+(const Vector3D& other) const { return Vector3D(x + other.x, y + other.y, z + other.z); }
+    constexpr Vector3D operator-(const Vector3D& other) const { return Vector3D(x - other.x, y - other.y, z - other.z); }
+    constexpr Vector3D operator*(float scalar) const { return Vector3D(x * scalar, y * scalar, z * scalar); }
+    constexpr Vector3D operator/(float scalar) const { return Vector3D(x / scalar, y / scalar, z / scalar); }
 
-    Vector3D& operator+=(const Vector3D& other);
-    Vector3D& operator-=(const Vector3D& other);
-    Vector3D& operator*=(float scalar);
+    constexpr Vector3D& operator+=(const Vector3D& other) { x += other.x; y += other.y; z += other.z; return *this; }
+    constexpr Vector3D& operator-=(const Vector3D& other) { x -= other.x; y -= other.y; z -= other.z; return *this; }
+    constexpr Vector3D& operator*=(float scalar) { x *= scalar; y *= scalar; z *= scalar; return *this; }
 
-    float length() const;
-    float lengthSquared() const;
+    float length() const { return std::sqrt(x * x + y * y + z * z); }
+    constexpr float lengthSquared() const { return x * x + y * y + z * z; }
     Vector3D normalized() const;
-    float dot(const Vector3D& other) const;
-    Vector3D cross(const Vector3D& other) const;
-    Vector3D lerp(const Vector3D& target, float t) const;
+    // rsqrt estimate plus one Newton step (~1e-6 relative error); same zero-length rule
+    Vector3D normalizedFast() const;
+    constexpr float dot(const Vector3D& other) const { return x * other.x + y * other.y + z * other.z; }
+    constexpr Vector3D cross(const Vector3D& other) const {
+        return Vector3D(y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x);
+    }
+    constexpr Vector3D lerp(const Vector3D& target, float t) const { return *this + (target - *this) * t; }
 
-    Vector2D xy() const;
-    Vector2D xz() const;
+    Vector2D xy() const { return Vector2D(x, y); }
+    Vector2D xz() const { return Vector2D(x, z); }
 
-    static Vector3D zero();
-    static Vector3D up();
-    static Vector3D forward();
+    static constexpr Vector3D zero() { return Vector3D(0, 0, 0); }
+    static constexpr Vector3D up() { return Vector3D(0, -1, 0); }
+    static constexpr Vector3D forward() { return Vector3D(0, 0, 1); }
 };
 
-Vector3D operator*(float scalar, const Vector3D& v);
+constexpr Vector3D operator*(float scalar, const Vector3D& v) { return v * scalar; }
+
+// 1 / sqrt(value) from the hardware estimate refined by one Newton-Raphson step
+inline float rsqrtApprox(float value) {
+#if defined(LOOM_SIMD_SSE)
+    float estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(value)));
+    return estimate * (1.5f - 0.5f * value * estimate * estimate);
+#elif defined(LOOM_SIMD_NEON)
+    float32x2_t v = vdup_n_f32(value);
+    float32x2_t estimate = vrsqrte_f32(v);
+    estimate = vmul_f32(estimate, vrsqrts_f32(vmul_f32(v, estimate), estimate));
+    return vget_lane_f32(estimate, 0);
+#else
+    return 1.0f / std::sqrt(value);
+#endif
+}
+
+inline Vector3D Vector3D::normalized() const {
+    float len = length();
+    if (len > 0.0001f) return *this / len;
+    return Vector3D::zero();
+}
+
+inline Vector3D Vector3D::normalizedFast() const {
+    float lenSq = lengthSquared();
+    if (lenSq > 0.0001f * 0.0001f) return *this * rsqrtApprox(lenSq);
+    return Vector3D::zero();
+}
 
 } // namespace ethereal
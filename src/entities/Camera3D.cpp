@@ -1,4 +1,5 @@
 #include "Camera3D.hpp"
+#include "environment/TerrainStreamer.hpp"
 #include <cmath>
 #include <algorithm>
 
@@ -8,6 +9,7 @@ FlightCamera::FlightCamera()
     : position(0, 50, 100)
     , target(0, 0, 0)
     , velocity(Vector3D::zero())
+    , terrain(nullptr)
     , yaw(0)
     , pitch(0.2f)
     , currentDistance(80.0f)
@@ -20,6 +22,7 @@ FlightCamera::FlightCamera(const Vector3D& position, const Vector3D& target, con
     , target(target)
     , velocity(Vector3D::zero())
     , config(config)
+    , terrain(nullptr)
     , yaw(0)
     , pitch(0.2f)
     , currentDistance(config.followDistance)
@@ -75,10 +78,35 @@ void FlightCamera::followTarget(const Vector3D& targetPos, const Vector3D& targe
     float smoothFactor = config.smoothSpeed * dt;
     smoothFactor = std::min(smoothFactor, 1.0f);
     position = position.lerp(idealPos, smoothFactor);
+    resolveTerrainCollision(targetPos);
     
     update(dt);
 }
 
+void FlightCamera::resolveTerrainCollision(const Vector3D& targetPos) {
+    if (!terrain) return;
+    
+    // Cast from the player back to the camera; ground in between pulls the camera
+    // in front of it, so a ridge never hides the player
+    Vector3D toCamera = position - targetPos;
+    float distance = toCamera.length();
+    if (distance < 1e-3f) return;
+    Vector3D direction = toCamera / distance;
+    
+    TerrainRayHit hit;
+    if (!terrain->raycast(targetPos, direction, distance + config.collisionRadius, hit)) return;
+    float pulledIn = hit.distance - config.collisionRadius;
+    float minimum = std::min(distance, config.minCollisionDistance);
+    if (pulledIn >= minimum) {
+        position = targetPos + direction * pulledIn;
+        return;
+    }
+    
+    // Ground right behind the player: hold the minimum distance, lifted over the slope
+    position = targetPos + direction * minimum;
+    position.y = std::max(position.y, hit.position.y + config.collisionRadius);
+}
+
 void FlightCamera::orbit(float deltaYaw, float deltaPitch) {
     yaw += deltaYaw * config.orbitSpeed;
     pitch += deltaPitch * config.orbitSpeed;
@@ -5,6 +5,8 @@
 
 namespace ethereal {
 
+class TerrainStreamer;
+
 struct FlightCameraConfig {
     float followDistance = 80.0f;
     float followHeight = 30.0f;
@@ -16,6 +18,8 @@ struct FlightCameraConfig {
     float minPitch = -0.5f;
     float maxPitch = 1.2f;
     float orbitSpeed = 2.0f;
+    float collisionRadius = 4.0f;       // Kept between the camera and the ground it would clip
+    float minCollisionDistance = 10.0f; // Closest a blocked camera is pulled in to the target
 };
 
 class FlightCamera {
@@ -45,6 +49,8 @@ public:
     
     void shake(float intensity, float duration);
     void setConfig(const FlightCameraConfig& cfg) { config = cfg; }
+    // Ground the follow camera must not pass behind or through; null disables it
+    void setTerrain(const TerrainStreamer* streamer) { terrain = streamer; }
     const FlightCameraConfig& getConfig() const { return config; }
 
 private:
@@ -52,6 +58,7 @@ private:
     Vector3D target;
     Vector3D velocity;
     FlightCameraConfig config;
+    const TerrainStreamer* terrain;
     
     float yaw;
     float pitch;
@@ -63,6 +70,7 @@ private:
     
     Vector3D calculateIdealPosition(const Vector3D& targetPos, const Vector3D& targetVelocity) const;
     Vector3D applyShake() const;
+    void resolveTerrainCollision(const Vector3D& targetPos);
 };
 
 } // namespace ethereal
@@ -4,6 +4,14 @@
 
 namespace ethereal {
 
+CharacterState3D CharacterState3D::interpolate(const CharacterState3D& previous, const CharacterState3D& current, float alpha) {
+    CharacterState3D state;
+    state.position = previous.position.lerp(current.position, alpha);
+    state.velocity = previous.velocity.lerp(current.velocity, alpha);
+    state.rotation = Quaternion::slerp(previous.rotation, current.rotation, alpha);
+    return state;
+}
+
 Character3D::Character3D() : Character3D(Vector3D::zero()) {}
 
 Character3D::Character3D(const Vector3D& position, const CharacterConfig3D& config)
@@ -13,9 +21,9 @@ Character3D::Character3D(const Vector3D& position, const CharacterConfig3D& conf
     , rotation(Quaternion::identity())
     , targetRotation(Quaternion::identity())
     , config(config)
-    , trailTimer(0) {
-    trail.reserve(config.trailLength);
-}
+    , trail(static_cast<size_t>(std::max(config.trailLength, 1)))
+    , trailTimer(0)
+    , trailTime(0) {}
 
 void Character3D::update(float dt) {
     velocity += acceleration * dt;
@@ -59,33 +67,17 @@ void Character3D::updateRotation(float dt) {
 
 void Character3D::updateTrail(float dt) {
     trailTimer += dt;
+    trailTime += dt;
     
     float speed = velocity.length();
     float interval = config.trailSpacing / std::max(speed * 0.01f, 0.5f);
     
+    // Fading happens when the trail is viewed; only new points cost anything here
     if (trailTimer >= interval && speed > 10.0f) {
         trailTimer = 0;
-        
-        TrailPoint point;
-        point.position = position - velocity.normalized() * config.radius;
-        point.alpha = 1.0f;
-        point.size = config.radius * 0.8f * std::min(speed / config.maxSpeed, 1.0f);
-        
-        trail.insert(trail.begin(), point);
-        
-        while (trail.size() > static_cast<size_t>(config.trailLength)) {
-            trail.pop_back();
-        }
-    }
-    
-    for (size_t i = 0; i < trail.size(); ++i) {
-        float t = static_cast<float>(i) / config.trailLength;
-        trail[i].alpha = (1.0f - t) * 0.6f;
-        trail[i].size *= 0.98f;
+        trail.push(position - velocity.normalized() * config.radius,
+                   config.radius * 0.8f * std::min(speed / config.maxSpeed, 1.0f), trailTime);
     }
-    
-    trail.erase(std::remove_if(trail.begin(), trail.end(),
-        [](const TrailPoint& p) { return p.alpha < 0.01f || p.size < 0.1f; }), trail.end());
 }
 
 void Character3D::setPosition(const Vector3D& pos) {
@@ -96,6 +88,13 @@ void Character3D::setVelocity(const Vector3D& vel) {
     velocity = vel;
 }
 
+void Character3D::setState(const CharacterState3D& state) {
+    position = state.position;
+    velocity = state.velocity;
+    rotation = state.rotation;
+    targetRotation = state.rotation;
+}
+
 void Character3D::applyForce(const Vector3D& force) {
     acceleration += force;
 }
@@ -116,6 +115,19 @@ Vector3D Character3D::getCapeAttachPoint() const {
     return position + back * config.capeOffset + Vector3D(0, config.radius * 0.3f, 0);
 }
 
+CollisionCapsule Character3D::getCollisionCapsule() const {
+    // The attach point sits capeOffset behind the center, so the proxy must stay
+    // thinner than that or it would shove the cape's top rows off their pins
+    float radius = std::min(config.radius * 0.8f, config.capeOffset * 0.75f);
+    Vector3D halfAxis = getUp() * (config.radius * 0.6f);
+    
+    CollisionCapsule capsule;
+    capsule.a = position - halfAxis;
+    capsule.b = position + halfAxis;
+    capsule.radius = radius;
+    return capsule;
+}
+
 Vector3D Character3D::getForward() const {
     return rotation * Vector3D(0, 0, 1);
 }
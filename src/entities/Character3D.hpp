@@ -1,7 +1,8 @@
 #pragma once
 #include "core/Vector3D.hpp"
 #include "core/Quaternion.hpp"
-#include <vector>
+#include "entities/TrailBuffer.hpp"
+#include "physics/ClothCollision3D.hpp"
 
 namespace ethereal {
 
@@ -12,14 +13,19 @@ struct CharacterConfig3D {
     float drag = 0.985f;
     float capeOffset = 6.0f;
     float rotationSpeed = 5.0f;
-    int trailLength = 20;
+    int trailLength = 20;       // Ring capacity; thousands are fine
     float trailSpacing = 0.05f;
+    TrailFade trailFade;
 };
 
-struct TrailPoint {
+// Render-facing snapshot of one simulation step
+struct CharacterState3D {
     Vector3D position;
-    float alpha;
-    float size;
+    Vector3D velocity;
+    Quaternion rotation;
+
+    // Blends two consecutive steps; the trail is not snapshotted
+    static CharacterState3D interpolate(const CharacterState3D& previous, const CharacterState3D& current, float alpha);
 };
 
 class Character3D {
@@ -31,6 +37,8 @@ public:
     
     void setPosition(const Vector3D& pos);
     void setVelocity(const Vector3D& vel);
+    // Puppets driven from outside (remote flyers): no smoothing toward the rotation
+    void setState(const CharacterState3D& state);
     void applyForce(const Vector3D& force);
     void rotateYaw(float angle);
     void setYaw(float angle);
@@ -41,12 +49,18 @@ public:
     float getRadius() const { return config.radius; }
     
     Vector3D getCapeAttachPoint() const;
+    // Body proxy for cloth collision, kept inside the cape attach point
+    CollisionCapsule getCollisionCapsule() const;
     Vector3D getForward() const;
     Vector3D getRight() const;
     Vector3D getUp() const;
     const Quaternion& getRotation() const { return rotation; }
+    CharacterState3D getState() const { return { position, velocity, rotation }; }
     
-    const std::vector<TrailPoint>& getTrail() const { return trail; }
+    // Faded at the character's own clock; newest point first
+    TrailBuffer::View getTrail() const { return trail.view(trailTime, config.trailFade); }
+    const TrailBuffer& getTrailBuffer() const { return trail; }
+    float getTrailTime() const { return trailTime; }
     const CharacterConfig3D& getConfig() const { return config; }
 
 private:
@@ -57,8 +71,9 @@ private:
     Quaternion targetRotation;
     CharacterConfig3D config;
     
-    std::vector<TrailPoint> trail;
+    TrailBuffer trail;
     float trailTimer;
+    float trailTime;    // Spawn clock for trail samples
     
     void updateRotation(float dt);
     void updateTrail(float dt);
@@ -288,4 +288,14 @@ float FlightController3D::getAltitude() const {
     return character->getPosition().y;
 }
 
+FlightSnapshot3D FlightController3D::getSnapshot() const {
+    FlightSnapshot3D snapshot;
+    snapshot.state = state;
+    snapshot.energy = energy;
+    snapshot.glideEfficiency = getGlideEfficiency();
+    snapshot.altitude = getAltitude();
+    snapshot.flying = flying;
+    return snapshot;
+}
+
 } // namespace ethereal
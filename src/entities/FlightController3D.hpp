@@ -36,6 +36,15 @@ enum class FlightState3D {
     Soaring
 };
 
+// What the HUD reads, copied out so it can be drawn while the next step simulates
+struct FlightSnapshot3D {
+    FlightState3D state = FlightState3D::Gliding;
+    float energy = 0.0f;
+    float glideEfficiency = 0.0f;
+    float altitude = 0.0f;
+    bool flying = false;
+};
+
 class FlightController3D {
 public:
     FlightController3D();
@@ -62,8 +71,10 @@ public:
     float getEnergy() const { return energy; }
     float getGlideEfficiency() const;
     float getAltitude() const;
+    FlightSnapshot3D getSnapshot() const;
     
     void setCharacter(Character3D* character);
+    const Character3D* getCharacter() const { return character; }
     const FlightConfig3D& getConfig() const { return config; }
 
 private:
@@ -0,0 +1,331 @@
+#include "FlyerCrowd3D.hpp"
+#include "utils/JobSystem.hpp"
+#include "utils/Profiler.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ethereal {
+
+namespace {
+
+constexpr float kTwoPi = 6.28318530718f;
+
+} // namespace
+
+FlyerCrowd3D::FlyerCrowd3D() : FlyerCrowd3D(FlyerCrowdConfig3D{}) {}
+
+FlyerCrowd3D::FlyerCrowd3D(const FlyerCrowdConfig3D& config)
+    : config(config)
+    , random(config.seed) {}
+
+size_t FlyerCrowd3D::spawn(const Vector3D& position, const Vector3D& velocity) {
+    Vector3D heading = velocity.lengthSquared() > 0.01f ? velocity : Vector3D(0, 0, 1);
+    float startYaw = std::atan2(heading.x, heading.z);
+    Quaternion rotation = Quaternion::fromAxisAngle(Vector3D(0, 1, 0), startYaw);
+
+    posX.push_back(position.x); posY.push_back(position.y); posZ.push_back(position.z);
+    velX.push_back(velocity.x); velY.push_back(velocity.y); velZ.push_back(velocity.z);
+    rotW.push_back(rotation.w); rotX.push_back(rotation.x); rotY.push_back(rotation.y); rotZ.push_back(rotation.z);
+    yaw.push_back(startYaw);
+    pitch.push_back(0.0f);
+    energy.push_back(random.range(60.0f, 100.0f));
+    stateTimer.push_back(0.0f);
+    wanderPhase.push_back(random.range(0.0f, kTwoPi));
+    turbulence.push_back(0.0f);
+    groundY.push_back(-1e9f);
+    state.push_back(static_cast<uint8_t>(FlightState3D::Gliding));
+    flying.push_back(1);
+
+    prevX.push_back(position.x); prevY.push_back(position.y); prevZ.push_back(position.z);
+    prevVelX.push_back(velocity.x); prevVelY.push_back(velocity.y); prevVelZ.push_back(velocity.z);
+    samplePositions.push_back(position);
+    windSamples.push_back(Vector3D::zero());
+    return posX.size() - 1;
+}
+
+void FlyerCrowd3D::spawnFlock(const Vector3D& center, float radius, size_t count, const Vector3D& heading) {
+    Vector3D velocity = heading.lengthSquared() > 0.01f ? heading.normalized() * 60.0f : Vector3D(0, 0, 60.0f);
+    for (size_t i = 0; i < count; ++i) {
+        // Rejection sample the unit ball
+        Vector3D offset;
+        do {
+            offset = Vector3D(random.nextSigned(), random.nextSigned(), random.nextSigned());
+        } while (offset.lengthSquared() > 1.0f);
+        spawn(center + offset * radius, velocity);
+    }
+}
+
+void FlyerCrowd3D::clear() {
+    for (auto* array : { &posX, &posY, &posZ, &velX, &velY, &velZ, &rotW, &rotX, &rotY, &rotZ,
+                         &yaw, &pitch, &energy, &stateTimer, &wanderPhase, &turbulence, &groundY,
+                         &prevX, &prevY, &prevZ, &prevVelX, &prevVelY, &prevVelZ }) {
+        array->clear();
+    }
+    state.clear();
+    flying.clear();
+    samplePositions.clear();
+    windSamples.clear();
+}
+
+void FlyerCrowd3D::setLeader(const Vector3D& position, bool active) {
+    leader = position;
+    hasLeader = active;
+}
+
+void FlyerCrowd3D::update(float dt, const WindField3D& wind) {
+    if (posX.empty()) return;
+    PROFILE_SCOPE("FlyerCrowd3D::update");
+    beginStep(dt, wind);
+    stepRange(0, posX.size());
+    collideGround();
+}
+
+void FlyerCrowd3D::update(float dt, const WindField3D& wind, JobSystem& jobs) {
+    if (posX.empty()) return;
+    PROFILE_SCOPE("FlyerCrowd3D::update");
+    beginStep(dt, wind);
+    // Capturing only `this` keeps the std::function inline, so no step allocates
+    jobs.parallelFor(posX.size(), config.parallelGrain, [this](size_t begin, size_t end) { stepRange(begin, end); });
+    collideGround();
+}
+
+void FlyerCrowd3D::beginStep(float dt, const WindField3D& wind) {
+    stepDt = dt;
+    stepWind = &wind;
+    elapsed += dt;
+    stepIndex++;
+
+    // Every range reads neighbours from this frozen copy, never from live state
+    prevX = posX; prevY = posY; prevZ = posZ;
+    prevVelX = velX; prevVelY = velY; prevVelZ = velZ;
+    neighbors.build(prevX.data(), prevY.data(), prevZ.data(), prevX.size(), config.neighborRadius);
+}
+
+Vector3D FlyerCrowd3D::steer(size_t i) const {
+    Vector3D p(prevX[i], prevY[i], prevZ[i]);
+    Vector3D forward(std::sin(yaw[i]) * std::cos(pitch[i]), std::sin(pitch[i]), std::cos(yaw[i]) * std::cos(pitch[i]));
+
+    float neighborRadius2 = config.neighborRadius * config.neighborRadius;
+    float separationRadius2 = config.separationRadius * config.separationRadius;
+    Vector3D separation = Vector3D::zero();
+    Vector3D sumPosition = Vector3D::zero();
+    Vector3D sumVelocity = Vector3D::zero();
+    int count = 0;
+
+    neighbors.forEachNear(p.x, p.y, p.z, [&](uint32_t j) {
+        if (j == i) return;
+        Vector3D d(prevX[j] - p.x, prevY[j] - p.y, prevZ[j] - p.z);
+        float dist2 = d.lengthSquared();
+        if (dist2 > neighborRadius2) return;
+        count++;
+        sumPosition += Vector3D(prevX[j], prevY[j], prevZ[j]);
+        sumVelocity += Vector3D(prevVelX[j], prevVelY[j], prevVelZ[j]);
+        if (dist2 < separationRadius2) {
+            separation -= d * (config.separationRadius / std::max(dist2, 1.0f));
+        }
+    });
+
+    Vector3D desired = forward;
+    if (count > 0) {
+        float inverseCount = 1.0f / count;
+        desired += separation * config.separationWeight;
+        Vector3D averageVelocity = sumVelocity * inverseCount;
+        if (averageVelocity.lengthSquared() > 1.0f) {
+            desired += (averageVelocity.normalized() - forward) * config.alignmentWeight;
+        }
+        Vector3D toCenter = sumPosition * inverseCount - p;
+        if (toCenter.lengthSquared() > 1.0f) {
+            desired += toCenter.normalized() * config.cohesionWeight;
+        }
+    }
+
+    if (hasLeader) {
+        Vector3D toLeader = leader - p;
+        float distance = toLeader.length();
+        if (distance > config.leaderRadius) {
+            float pull = std::min((distance - config.leaderRadius) / config.leaderRadius, 2.0f);
+            desired += toLeader * (config.leaderWeight * pull / distance);
+        }
+    }
+
+    float phase = wanderPhase[i];
+    desired += Vector3D(std::sin(elapsed * 0.7f + phase),
+                        0.3f * std::sin(elapsed * 1.1f + phase * 2.0f),
+                        std::cos(elapsed * 0.7f + phase)) * config.wanderWeight;
+
+    // Damp climb/dive rate, or the glide model's dive pull makes altitude overshoot
+    desired.y -= prevVelY[i] * config.verticalDamping;
+
+    // Pull up before the terrain does it for us
+    float clearance = p.y - groundY[i];
+    if (clearance < config.minClearance) {
+        desired.y += 2.0f * (1.0f - clearance / config.minClearance);
+    }
+    return desired;
+}
+
+void FlyerCrowd3D::stepRange(size_t begin, size_t end) {
+    const FlightConfig3D& flight = config.flight;
+    const CharacterConfig3D& body = config.body;
+    const WindField3D& wind = *stepWind;
+    float dt = stepDt;
+
+    for (size_t i = begin; i < end; ++i) samplePositions[i] = Vector3D(prevX[i], prevY[i], prevZ[i]);
+    wind.getWindAt(samplePositions.data() + begin, windSamples.data() + begin, end - begin);
+
+    int interval = std::max(config.turbulenceInterval, 1);
+    for (size_t i = begin; i < end; ++i) {
+        Vector3D vel(velX[i], velY[i], velZ[i]);
+        Vector3D accel = Vector3D::zero();
+
+        // === Steering, in place of updateMouseControl's mouse input ===
+        Vector3D desired = steer(i);
+        float targetYaw = std::atan2(desired.x, desired.z);
+        float targetPitch = std::clamp(std::atan2(desired.y, std::sqrt(desired.x * desired.x + desired.z * desired.z)),
+                                       -config.maxPitch, config.maxPitch);
+
+        // Unlike the player's accumulated yaw, the target wraps; turn the short way
+        float smoothing = flight.turnSmoothing * dt;
+        yaw[i] += std::remainder(targetYaw - yaw[i], kTwoPi) * smoothing;
+        pitch[i] += (targetPitch - pitch[i]) * smoothing;
+        if (std::abs(yaw[i]) > kTwoPi) yaw[i] = std::remainder(yaw[i], kTwoPi);
+
+        // Flap until exhausted, glide back up to resumeEnergy. The cutoff sits above
+        // zero since regen would otherwise top up just enough for one more beat.
+        if (energy[i] < 1.0f) flying[i] = 0;
+        else if (!flying[i] && energy[i] > config.resumeEnergy) flying[i] = 1;
+
+        float e = energy[i];
+        if (flying[i]) {
+            Vector3D forward(std::sin(yaw[i]) * std::cos(pitch[i]), std::sin(pitch[i]), std::cos(yaw[i]) * std::cos(pitch[i]));
+            if (vel.length() < flight.thrustMaxSpeed) {
+                if (pitch[i] > 0.1f) {
+                    e -= dt * (10.0f + pitch[i] * 15.0f);
+                } else if (pitch[i] < -0.1f) {
+                    e += dt * 5.0f * std::abs(pitch[i]);
+                } else {
+                    e -= dt * 3.0f;
+                }
+                accel += forward * flight.thrustAcceleration;
+            }
+        } else {
+            accel.y -= 35.0f;
+            float horizontalSpeed = std::sqrt(vel.x * vel.x + vel.z * vel.z);
+            if (horizontalSpeed > flight.naturalGlideSpeed) {
+                accel.y += (horizontalSpeed - flight.naturalGlideSpeed) * 0.3f;
+            }
+            vel *= flight.idleDeceleration;
+            e += dt * 12.0f;
+        }
+        e = std::clamp(e, 0.0f, 100.0f);
+
+        // Thrust alone cannot out-climb the dive pull; a steep target also holds
+        // the player's ascend input (moveUp), paid for out of the same energy
+        bool climbing = targetPitch > config.climbPitch && e > 0.0f;
+        if (climbing) {
+            accel.y += flight.liftForce;
+            e = std::max(e - dt * 12.0f, 0.0f);
+        }
+
+        // === FlightController3D::updateState + applyGlidePhysics ===
+        float speed = vel.length();
+        float horizontalSpeed = std::sqrt(vel.x * vel.x + vel.z * vel.z);
+        FlightState3D s;
+        if (climbing) {
+            s = FlightState3D::Climbing;
+        } else if (vel.y < -20.0f) {
+            s = FlightState3D::Diving;
+        } else if (horizontalSpeed > flight.minGlideSpeed * 2.0f && std::abs(vel.y) < 10.0f) {
+            s = FlightState3D::Soaring;
+        } else if (horizontalSpeed > flight.minGlideSpeed || std::abs(vel.y) > 5.0f) {
+            s = FlightState3D::Gliding;
+        } else {
+            s = FlightState3D::Hovering;
+        }
+
+        switch (s) {
+            case FlightState3D::Climbing:
+                if (speed > flight.minGlideSpeed) vel *= 1.0f - (1.0f - flight.speedLossOnClimb) * dt * 60.0f;
+                break;
+            case FlightState3D::Diving:
+                if (speed < flight.maxGlideSpeed) vel *= 1.0f + (flight.speedGainOnDive - 1.0f) * dt * 60.0f;
+                accel.y -= 50.0f;
+                break;
+            case FlightState3D::Soaring:
+                accel.y += horizontalSpeed * flight.altitudeGain * 0.5f;
+                break;
+            case FlightState3D::Gliding:
+                accel.y -= 30.0f * (1.0f - std::min(speed / flight.maxGlideSpeed, 1.0f) * 0.6f);
+                if (horizontalSpeed > flight.minGlideSpeed) accel.y += horizontalSpeed * flight.altitudeGain * 0.2f;
+                break;
+            case FlightState3D::Hovering:
+                accel.y -= 40.0f;
+                break;
+        }
+
+        // === Wind; turbulence staggered across steps ===
+        if ((i + stepIndex) % static_cast<uint32_t>(interval) == 0) {
+            turbulence[i] = wind.getTurbulenceAt(samplePositions[i]) * flight.turbulenceEffect;
+        }
+        float t = stateTimer[i] + dt;
+        float turb = turbulence[i];
+        accel += windSamples[i] * flight.windAssist;
+        accel += Vector3D(std::sin(t * 5.0f) * turb, std::cos(t * 7.0f) * turb * 0.5f, std::sin(t * 6.0f) * turb) * 20.0f;
+
+        if (!climbing) e = std::min(e + dt * 8.0f, 100.0f);
+        energy[i] = e;
+        state[i] = static_cast<uint8_t>(s);
+        stateTimer[i] += 2.0f * dt;     // updateMouseControl and update each advance it
+
+        // === Character3D::update ===
+        vel += accel * dt;
+        speed = vel.length();
+        if (speed > body.maxSpeed) {
+            vel = vel * (body.maxSpeed / speed);
+            speed = body.maxSpeed;
+        }
+        vel *= body.drag;
+        posX[i] += vel.x * dt;
+        posY[i] += vel.y * dt;
+        posZ[i] += vel.z * dt;
+        velX[i] = vel.x; velY[i] = vel.y; velZ[i] = vel.z;
+
+        Quaternion target = Quaternion::fromAxisAngle(Vector3D(0, 1, 0), yaw[i]);
+        if (speed > 20.0f) {
+            float tilt = std::clamp(std::atan2(-vel.y, std::sqrt(vel.x * vel.x + vel.z * vel.z)) * 0.3f, -0.4f, 0.4f);
+            target = target * Quaternion::fromAxisAngle(Vector3D(1, 0, 0), tilt);
+        }
+        Quaternion rotation = Quaternion::slerp(Quaternion(rotW[i], rotX[i], rotY[i], rotZ[i]), target, body.rotationSpeed * dt);
+        rotW[i] = rotation.w; rotX[i] = rotation.x; rotY[i] = rotation.y; rotZ[i] = rotation.z;
+    }
+}
+
+void FlyerCrowd3D::collideGround() {
+    if (!groundHeight) return;
+    // Serial: height queries (TerrainStreamer's tile cache) are not safe to share across jobs
+    float lift = config.body.radius + 2.0f;
+    for (size_t i = 0; i < posX.size(); ++i) {
+        groundY[i] = groundHeight(posX[i], posZ[i]);
+        float floor = groundY[i] + lift;
+        if (posY[i] < floor) {
+            posY[i] = floor;
+            if (velY[i] < 0.0f) velY[i] *= -0.3f;
+        }
+    }
+}
+
+void FlyerCrowd3D::capture(FlyerCrowdSnapshot3D& out) const {
+    size_t n = posX.size();
+    out.previous.resize(n);
+    out.current.resize(n);
+    out.velocity.resize(n);
+    out.energy.assign(energy.begin(), energy.end());
+    for (size_t i = 0; i < n; ++i) {
+        out.previous[i] = Vector3D(prevX[i], prevY[i], prevZ[i]);
+        out.current[i] = Vector3D(posX[i], posY[i], posZ[i]);
+        out.velocity[i] = Vector3D(velX[i], velY[i], velZ[i]);
+    }
+    out.radius = config.body.radius;
+}
+
+} // namespace ethereal
@@ -0,0 +1,134 @@
+#pragma once
+#include "core/Vector3D.hpp"
+#include "core/Quaternion.hpp"
+#include "entities/Character3D.hpp"
+#include "entities/FlightController3D.hpp"
+#include "physics/ClothCollision3D.hpp"
+#include "physics/WindField3D.hpp"
+#include "utils/Random.hpp"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace ethereal {
+
+class JobSystem;
+
+struct FlyerCrowdConfig3D {
+    CharacterConfig3D body;     // Radius, speed limit, drag and turn rate; no trails
+    FlightConfig3D flight;
+
+    // Flocking replaces the player's mouse input: each flyer steers toward a
+    // blend of these, then flies with the same thrust/glide model
+    float neighborRadius = 60.0f;
+    float separationRadius = 22.0f;
+    float separationWeight = 1.8f;
+    float alignmentWeight = 0.9f;
+    float cohesionWeight = 0.5f;
+    float leaderWeight = 1.5f;
+    float leaderRadius = 120.0f;    // Flyers orbit the leader outside this distance
+    float wanderWeight = 0.35f;
+    float maxPitch = 0.9f;          // Shallower than the player's 1.2 rad, which overshoots when steered
+    float verticalDamping = 0.02f;  // Per unit of vertical speed, against altitude overshoot
+    float climbPitch = 0.45f;       // Target pitch above which a flyer also lifts, like the ascend input
+    float minClearance = 40.0f;     // Climb when closer than this to the ground
+    float resumeEnergy = 35.0f;     // A gliding flyer flaps again above this energy
+
+    // Turbulence noise is sampled for 1 in `turbulenceInterval` flyers per step
+    int turbulenceInterval = 4;
+    size_t parallelGrain = 64;
+    uint32_t seed = 0x464c4f43;
+};
+
+// Render-side copy of one simulated frame, filled in place so its buffers are reused
+struct FlyerCrowdSnapshot3D {
+    std::vector<Vector3D> previous;     // Before the frame's last step
+    std::vector<Vector3D> current;
+    std::vector<Vector3D> velocity;
+    std::vector<float> energy;
+    float radius = 0.0f;
+
+    size_t size() const { return current.size(); }
+    Vector3D positionAt(size_t i, float alpha) const { return previous[i].lerp(current[i], alpha); }
+};
+
+// Many AI flyers with the physics of Character3D + FlightController3D, stored as
+// structure-of-arrays. A step builds one neighbour hash from the start-of-step
+// state, then steers, flies, integrates and collides every flyer from those
+// frozen arrays, so ranges are independent and run in parallel without locks.
+// Wind is sampled per range through the batched WindField3D query.
+class FlyerCrowd3D {
+public:
+    FlyerCrowd3D();
+    explicit FlyerCrowd3D(const FlyerCrowdConfig3D& config);
+
+    size_t spawn(const Vector3D& position, const Vector3D& velocity);
+    // `count` flyers scattered in a sphere around `center`, heading along `heading`
+    void spawnFlock(const Vector3D& center, float radius, size_t count, const Vector3D& heading);
+    void clear();
+
+    // Flyers gather around the leader, e.g. the player; inactive = free roaming
+    void setLeader(const Vector3D& position, bool active = true);
+    // Terrain height under (x, z); must be safe to call from job threads. Empty = no ground.
+    void setGround(std::function<float(float, float)> heightAt) { groundHeight = std::move(heightAt); }
+
+    void update(float dt, const WindField3D& wind);
+    // Same, with each pass split across the job system
+    void update(float dt, const WindField3D& wind, JobSystem& jobs);
+
+    void capture(FlyerCrowdSnapshot3D& out) const;
+
+    size_t size() const { return posX.size(); }
+    Vector3D getPosition(size_t i) const { return Vector3D(posX[i], posY[i], posZ[i]); }
+    Vector3D getVelocity(size_t i) const { return Vector3D(velX[i], velY[i], velZ[i]); }
+    Quaternion getRotation(size_t i) const { return Quaternion(rotW[i], rotX[i], rotY[i], rotZ[i]); }
+    float getEnergy(size_t i) const { return energy[i]; }
+    FlightState3D getState(size_t i) const { return static_cast<FlightState3D>(state[i]); }
+    bool isFlying(size_t i) const { return flying[i] != 0; }
+
+    const float* positionsX() const { return posX.data(); }
+    const float* positionsY() const { return posY.data(); }
+    const float* positionsZ() const { return posZ.data(); }
+    const FlyerCrowdConfig3D& getConfig() const { return config; }
+
+private:
+    FlyerCrowdConfig3D config;
+
+    // === Per-flyer state ===
+    std::vector<float> posX, posY, posZ;
+    std::vector<float> velX, velY, velZ;
+    std::vector<float> rotW, rotX, rotY, rotZ;
+    std::vector<float> yaw, pitch;              // Smoothed heading, as in updateMouseControl
+    std::vector<float> energy;
+    std::vector<float> stateTimer;
+    std::vector<float> wanderPhase;
+    std::vector<float> turbulence;              // Refreshed every turbulenceInterval steps
+    std::vector<float> groundY;                 // Height under the flyer at its last collision
+    std::vector<uint8_t> state;                 // FlightState3D
+    std::vector<uint8_t> flying;
+
+    // === Start-of-step copies the passes read from ===
+    std::vector<float> prevX, prevY, prevZ;
+    std::vector<float> prevVelX, prevVelY, prevVelZ;
+    std::vector<Vector3D> samplePositions;
+    std::vector<Vector3D> windSamples;
+    SpatialHash3D neighbors;
+
+    std::function<float(float, float)> groundHeight;
+    Vector3D leader;
+    bool hasLeader = false;
+    uint32_t stepIndex = 0;
+    float elapsed = 0.0f;
+    Pcg32 random;
+
+    // The step's inputs, so the parallelFor job only captures `this`
+    float stepDt = 0.0f;
+    const WindField3D* stepWind = nullptr;
+
+    void beginStep(float dt, const WindField3D& wind);
+    void stepRange(size_t begin, size_t end);
+    void collideGround();
+    Vector3D steer(size_t i) const;
+};
+
+} // namespace ethereal
@@ -0,0 +1,358 @@
+#include "FlyerSnapshot.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ethereal {
+
+namespace {
+
+const int kAgeBits = 5;                 // Fits FlyerSnapshotEncoder::kHistory - 1
+const int kFlightStateBits = 3;
+const int kEnergyBits = 8;
+const int kCapeCountBits = 5;           // Segments and width, 1..32
+const int kCapeLengthBits = 8;          // Sixteenths of a unit, up to ~16
+const float kMaxEnergy = 100.0f;
+
+static_assert((1u << kAgeBits) >= FlyerSnapshotEncoder::kHistory, "baseline age field too narrow");
+
+// Delta widths for one field; a 2-bit prefix picks the narrowest that fits
+struct DeltaBuckets {
+    int bits[4];
+};
+
+struct FieldBuckets {
+    DeltaBuckets position;
+    DeltaBuckets velocity;
+    DeltaBuckets rotation;
+};
+
+// A tick of flight moves a few hundred position steps; the widest bucket of each
+// field holds any difference of two clamped values
+FieldBuckets makeBuckets(const FlyerQuantization& quantization) {
+    FieldBuckets buckets;
+    buckets.position = {{ 5, 9, 14, quantization.positionBits + 1 }};
+    buckets.velocity = {{ 3, 7, 11, quantization.velocityBits + 1 }};
+    buckets.rotation = {{ 3, 6, 9, quantization.rotationBits + 1 }};
+    return buckets;
+}
+
+int32_t quantizeClamped(float value, float step, int bits) {
+    const float limit = static_cast<float>((1 << (bits - 1)) - 1);
+    return static_cast<int32_t>(std::clamp(std::round(value / step), -limit, limit));
+}
+
+uint32_t quantizeUnsigned(float value, float step, int bits) {
+    const float limit = static_cast<float>((1u << bits) - 1u);
+    return static_cast<uint32_t>(std::clamp(std::round(value / step), 0.0f, limit));
+}
+
+void writeDelta(BitWriter& out, int32_t delta, const DeltaBuckets& buckets) {
+    uint32_t code = BitWriter::zigzag(delta);
+    uint32_t bucket = 0;
+    while (bucket < 3 && code >= (1u << buckets.bits[bucket])) ++bucket;
+    out.writeBits(bucket, 2);
+    out.writeBits(code, buckets.bits[bucket]);
+}
+
+int32_t readDelta(BitReader& in, const DeltaBuckets& buckets) {
+    uint32_t bucket = in.readBits(2);
+    return BitWriter::unzigzag(in.readBits(buckets.bits[bucket]));
+}
+
+// Axis-wise delta behind one "changed" bit
+template <size_t N>
+void writeVector(BitWriter& out, const std::array<int32_t, N>& value, const std::array<int32_t, N>& base,
+                 const DeltaBuckets& buckets) {
+    bool changed = value != base;
+    out.writeBool(changed);
+    if (!changed) return;
+    for (size_t i = 0; i < N; ++i) writeDelta(out, value[i] - base[i], buckets);
+}
+
+template <size_t N>
+void readVector(BitReader& in, std::array<int32_t, N>& value, const std::array<int32_t, N>& base,
+                const DeltaBuckets& buckets) {
+    value = base;
+    if (!in.readBool()) return;
+    for (size_t i = 0; i < N; ++i) value[i] = base[i] + readDelta(in, buckets);
+}
+
+void writeFlight(BitWriter& out, const QuantizedFlyer& state) {
+    out.writeBits(state.flightState, kFlightStateBits);
+    out.writeBits(state.energy, kEnergyBits);
+    out.writeBool(state.flying);
+}
+
+void readFlight(BitReader& in, QuantizedFlyer& state) {
+    state.flightState = in.readBits(kFlightStateBits);
+    state.energy = in.readBits(kEnergyBits);
+    state.flying = in.readBool();
+}
+
+void writeAppearance(BitWriter& out, const QuantizedFlyer& state) {
+    out.writeBits(state.capeSegments, kCapeCountBits);
+    out.writeBits(state.capeWidth, kCapeCountBits);
+    out.writeBits(state.capeSegmentLength, kCapeLengthBits);
+    out.writeBits(state.capeWidthSpacing, kCapeLengthBits);
+    out.writeBool(state.capeXpbd);
+}
+
+void readAppearance(BitReader& in, QuantizedFlyer& state) {
+    state.capeSegments = in.readBits(kCapeCountBits);
+    state.capeWidth = in.readBits(kCapeCountBits);
+    state.capeSegmentLength = in.readBits(kCapeLengthBits);
+    state.capeWidthSpacing = in.readBits(kCapeLengthBits);
+    state.capeXpbd = in.readBool();
+}
+
+bool sameFlight(const QuantizedFlyer& a, const QuantizedFlyer& b) {
+    return a.flightState == b.flightState && a.energy == b.energy && a.flying == b.flying;
+}
+
+bool sameAppearance(const QuantizedFlyer& a, const QuantizedFlyer& b) {
+    return a.capeSegments == b.capeSegments && a.capeWidth == b.capeWidth &&
+           a.capeSegmentLength == b.capeSegmentLength && a.capeWidthSpacing == b.capeWidthSpacing &&
+           a.capeXpbd == b.capeXpbd;
+}
+
+} // namespace
+
+// === FlyerAppearance ===
+
+FlyerAppearance FlyerAppearance::fromCape(const CapeConfig3D& config) {
+    FlyerAppearance appearance;
+    appearance.capeSegments = config.segments;
+    appearance.capeWidth = config.width;
+    appearance.capeSegmentLength = config.segmentLength;
+    appearance.capeWidthSpacing = config.widthSpacing;
+    appearance.capeSolver = config.solver;
+    return appearance;
+}
+
+CapeConfig3D FlyerAppearance::toCapeConfig(const CapeConfig3D& base) const {
+    CapeConfig3D config = base;
+    config.segments = capeSegments;
+    config.width = capeWidth;
+    config.segmentLength = capeSegmentLength;
+    config.widthSpacing = capeWidthSpacing;
+    config.solver = capeSolver;
+    return config;
+}
+
+// === FlyerSnapshotCodec ===
+
+FlyerSnapshotCodec::FlyerSnapshotCodec() : FlyerSnapshotCodec(FlyerQuantization{}) {}
+
+FlyerSnapshotCodec::FlyerSnapshotCodec(const FlyerQuantization& config)
+    : quantization(config)
+    // Smallest-three components lie in [-1/sqrt(2), 1/sqrt(2)]
+    , rotationScale(static_cast<float>((1 << (config.rotationBits - 1)) - 1) * std::sqrt(2.0f)) {}
+
+QuantizedFlyer FlyerSnapshotCodec::quantize(const FlyerNetState& state) const {
+    QuantizedFlyer q;
+    const Vector3D& position = state.character.position;
+    const Vector3D& velocity = state.character.velocity;
+    q.position = { quantizeClamped(position.x, quantization.positionStep, quantization.positionBits),
+                   quantizeClamped(position.y, quantization.positionStep, quantization.positionBits),
+                   quantizeClamped(position.z, quantization.positionStep, quantization.positionBits) };
+    q.velocity = { quantizeClamped(velocity.x, quantization.velocityStep, quantization.velocityBits),
+                   quantizeClamped(velocity.y, quantization.velocityStep, quantization.velocityBits),
+                   quantizeClamped(velocity.z, quantization.velocityStep, quantization.velocityBits) };
+
+    // Smallest three: drop the largest component, flipping the sign so it is
+    // positive (q and -q are the same rotation) and rebuilt from unit length
+    Quaternion rotation = state.character.rotation.normalized();
+    float components[4] = { rotation.w, rotation.x, rotation.y, rotation.z };
+    uint32_t largest = 0;
+    for (uint32_t i = 1; i < 4; ++i) {
+        if (std::abs(components[i]) > std::abs(components[largest])) largest = i;
+    }
+    const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+    const float limit = static_cast<float>((1 << (quantization.rotationBits - 1)) - 1);
+    q.rotationLargest = largest;
+    for (uint32_t i = 0, k = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        q.rotation[k++] = static_cast<int32_t>(std::clamp(std::round(components[i] * sign * rotationScale), -limit, limit));
+    }
+
+    q.flightState = static_cast<uint32_t>(state.flightState);
+    q.energy = quantizeUnsigned(state.energy, kMaxEnergy / ((1 << kEnergyBits) - 1), kEnergyBits);
+    q.flying = state.flying;
+
+    const FlyerAppearance& look = state.appearance;
+    const int maxCount = 1 << kCapeCountBits;
+    q.capeSegments = static_cast<uint32_t>(std::clamp(look.capeSegments, 1, maxCount) - 1);
+    q.capeWidth = static_cast<uint32_t>(std::clamp(look.capeWidth, 1, maxCount) - 1);
+    q.capeSegmentLength = quantizeUnsigned(look.capeSegmentLength, 1.0f / 16.0f, kCapeLengthBits);
+    q.capeWidthSpacing = quantizeUnsigned(look.capeWidthSpacing, 1.0f / 16.0f, kCapeLengthBits);
+    q.capeXpbd = look.capeSolver == ClothSolver3D::XPBD;
+    return q;
+}
+
+FlyerNetState FlyerSnapshotCodec::dequantize(const QuantizedFlyer& q) const {
+    FlyerNetState state;
+    const float ps = quantization.positionStep;
+    const float vs = quantization.velocityStep;
+    state.character.position = Vector3D(q.position[0] * ps, q.position[1] * ps, q.position[2] * ps);
+    state.character.velocity = Vector3D(q.velocity[0] * vs, q.velocity[1] * vs, q.velocity[2] * vs);
+
+    float components[4];
+    float sumSquares = 0.0f;
+    for (uint32_t i = 0, k = 0; i < 4; ++i) {
+        if (i == q.rotationLargest) continue;
+        components[i] = q.rotation[k++] / rotationScale;
+        sumSquares += components[i] * components[i];
+    }
+    components[q.rotationLargest] = std::sqrt(std::max(0.0f, 1.0f - sumSquares));
+    state.character.rotation = Quaternion(components[0], components[1], components[2], components[3]).normalized();
+
+    state.flightState = static_cast<FlightState3D>(std::min<uint32_t>(q.flightState, static_cast<uint32_t>(FlightState3D::Soaring)));
+    state.energy = q.energy * (kMaxEnergy / ((1 << kEnergyBits) - 1));
+    state.flying = q.flying;
+
+    state.appearance.capeSegments = static_cast<int>(q.capeSegments) + 1;
+    state.appearance.capeWidth = static_cast<int>(q.capeWidth) + 1;
+    state.appearance.capeSegmentLength = q.capeSegmentLength / 16.0f;
+    state.appearance.capeWidthSpacing = q.capeWidthSpacing / 16.0f;
+    state.appearance.capeSolver = q.capeXpbd ? ClothSolver3D::XPBD : ClothSolver3D::Iterative;
+    return state;
+}
+
+void FlyerSnapshotCodec::encode(BitWriter& out, const QuantizedFlyer& state, const QuantizedFlyer* baseline) const {
+    if (!baseline) {
+        for (int32_t axis : state.position) out.writeSigned(axis, quantization.positionBits);
+        for (int32_t axis : state.velocity) out.writeSigned(axis, quantization.velocityBits);
+        out.writeBits(state.rotationLargest, 2);
+        for (int32_t component : state.rotation) out.writeSigned(component, quantization.rotationBits);
+        writeFlight(out, state);
+        writeAppearance(out, state);
+        return;
+    }
+
+    const FieldBuckets buckets = makeBuckets(quantization);
+    writeVector(out, state.position, baseline->position, buckets.position);
+    writeVector(out, state.velocity, baseline->velocity, buckets.velocity);
+
+    // The components only line up when the same one was dropped
+    bool rotationChanged = state.rotationLargest != baseline->rotationLargest || state.rotation != baseline->rotation;
+    out.writeBool(rotationChanged);
+    if (rotationChanged) {
+        bool sameLargest = state.rotationLargest == baseline->rotationLargest;
+        out.writeBool(sameLargest);
+        if (sameLargest) {
+            for (size_t i = 0; i < 3; ++i) writeDelta(out, state.rotation[i] - baseline->rotation[i], buckets.rotation);
+        } else {
+            out.writeBits(state.rotationLargest, 2);
+            for (int32_t component : state.rotation) out.writeSigned(component, quantization.rotationBits);
+        }
+    }
+
+    bool flightChanged = !sameFlight(state, *baseline);
+    out.writeBool(flightChanged);
+    if (flightChanged) writeFlight(out, state);
+
+    bool appearanceChanged = !sameAppearance(state, *baseline);
+    out.writeBool(appearanceChanged);
+    if (appearanceChanged) writeAppearance(out, state);
+}
+
+bool FlyerSnapshotCodec::decode(BitReader& in, QuantizedFlyer& state, const QuantizedFlyer* baseline) const {
+    if (!baseline) {
+        for (int32_t& axis : state.position) axis = in.readSigned(quantization.positionBits);
+        for (int32_t& axis : state.velocity) axis = in.readSigned(quantization.velocityBits);
+        state.rotationLargest = in.readBits(2);
+        for (int32_t& component : state.rotation) component = in.readSigned(quantization.rotationBits);
+        readFlight(in, state);
+        readAppearance(in, state);
+        return in.isOk();
+    }
+
+    const FieldBuckets buckets = makeBuckets(quantization);
+    state = *baseline;
+    readVector(in, state.position, baseline->position, buckets.position);
+    readVector(in, state.velocity, baseline->velocity, buckets.velocity);
+
+    if (in.readBool()) {
+        if (in.readBool()) {
+            for (size_t i = 0; i < 3; ++i) state.rotation[i] = baseline->rotation[i] + readDelta(in, buckets.rotation);
+        } else {
+            state.rotationLargest = in.readBits(2);
+            for (int32_t& component : state.rotation) component = in.readSigned(quantization.rotationBits);
+        }
+    }
+
+    if (in.readBool()) readFlight(in, state);
+    if (in.readBool()) readAppearance(in, state);
+    return in.isOk();
+}
+
+// === Streams ===
+
+void FlyerSnapshotEncoder::encode(uint16_t tick, const FlyerNetState& state, BitWriter& out) {
+    QuantizedFlyer quantized = codec.quantize(state);
+
+    const QuantizedFlyer* baseline = nullptr;
+    uint16_t age = 0;
+    if (acked) {
+        const Entry& entry = history[ackedTick % kHistory];
+        uint16_t ackAge = static_cast<uint16_t>(tick - ackedTick);
+        if (entry.valid && entry.tick == ackedTick && ackAge > 0 && ackAge < kHistory) {
+            baseline = &entry.state;
+            age = ackAge;
+        }
+    }
+
+    out.writeBits(tick, 16);
+    out.writeBits(age, kAgeBits);
+    codec.encode(out, quantized, baseline);
+
+    Entry& slot = history[tick % kHistory];
+    slot.state = quantized;
+    slot.tick = tick;
+    slot.valid = true;
+}
+
+void FlyerSnapshotEncoder::acknowledge(uint16_t tick) {
+    const Entry& entry = history[tick % kHistory];
+    if (!entry.valid || entry.tick != tick) return;
+    // Ticks wrap; only a newer ack moves the baseline
+    if (acked && static_cast<int16_t>(tick - ackedTick) <= 0) return;
+    ackedTick = tick;
+    acked = true;
+}
+
+void FlyerSnapshotEncoder::reset() {
+    history.fill(Entry{});
+    acked = false;
+}
+
+bool FlyerSnapshotDecoder::decode(BitReader& in, FlyerNetState& state, uint16_t& tick) {
+    tick = static_cast<uint16_t>(in.readBits(16));
+    uint16_t age = static_cast<uint16_t>(in.readBits(kAgeBits));
+
+    const QuantizedFlyer* baseline = nullptr;
+    bool known = true;
+    QuantizedFlyer missing;     // Stands in for a lost baseline so the bits are still consumed
+    if (age > 0) {
+        uint16_t baseTick = static_cast<uint16_t>(tick - age);
+        const Entry& entry = history[baseTick % FlyerSnapshotEncoder::kHistory];
+        known = entry.valid && entry.tick == baseTick;
+        baseline = known ? &entry.state : &missing;
+    }
+
+    QuantizedFlyer quantized;
+    if (!codec.decode(in, quantized, baseline) || !known) return false;
+
+    Entry& slot = history[tick % FlyerSnapshotEncoder::kHistory];
+    slot.state = quantized;
+    slot.tick = tick;
+    slot.valid = true;
+    state = codec.dequantize(quantized);
+    return true;
+}
+
+void FlyerSnapshotDecoder::reset() {
+    history.fill(Entry{});
+}
+
+} // namespace ethereal
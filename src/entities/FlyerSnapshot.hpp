@@ -0,0 +1,139 @@
+#pragma once
+#include "entities/Character3D.hpp"
+#include "entities/FlightController3D.hpp"
+#include "physics/Cape3D.hpp"
+#include "utils/BitStream.hpp"
+#include <array>
+#include <cstdint>
+
+namespace ethereal {
+
+// The shape of a flyer's cape. Remote capes are rebuilt from this and
+// re-simulated against the flyer's transform instead of receiving particles.
+struct FlyerAppearance {
+    int capeSegments = 14;
+    int capeWidth = 10;
+    float capeSegmentLength = 6.0f;
+    float capeWidthSpacing = 4.0f;
+    ClothSolver3D capeSolver = ClothSolver3D::Iterative;
+
+    static FlyerAppearance fromCape(const CapeConfig3D& config);
+    // `base` supplies everything the appearance does not carry (stiffness, wind, ...)
+    CapeConfig3D toCapeConfig(const CapeConfig3D& base = CapeConfig3D{}) const;
+};
+
+// What another player needs to draw a flyer. The energy orbs follow the
+// character state (EnergyBeingRenderer::update), so they add nothing here.
+struct FlyerNetState {
+    CharacterState3D character;
+    FlightState3D flightState = FlightState3D::Gliding;
+    float energy = 0.0f;            // 0..100
+    bool flying = false;
+    FlyerAppearance appearance;
+};
+
+struct FlyerQuantization {
+    float positionStep = 1.0f / 64.0f;     // World units per step
+    int positionBits = 26;                  // Per axis in a full snapshot, about +-520k units
+    float velocityStep = 1.0f / 8.0f;      // Only drives the cape and the orbs remotely
+    int velocityBits = 16;
+    int rotationBits = 11;                  // Per smallest-three component
+};
+
+// Integer form of FlyerNetState. Deltas are taken between these, so the sender
+// and the receiver hold the same baseline bit for bit.
+struct QuantizedFlyer {
+    std::array<int32_t, 3> position{};
+    std::array<int32_t, 3> velocity{};
+    uint32_t rotationLargest = 0;           // Dropped component: 0 = w, 1 = x, 2 = y, 3 = z
+    std::array<int32_t, 3> rotation{};      // The other three, in w, x, y, z order
+    uint32_t flightState = 0;
+    uint32_t energy = 0;
+    bool flying = false;
+    uint32_t capeSegments = 0;              // Minus one
+    uint32_t capeWidth = 0;                 // Minus one
+    uint32_t capeSegmentLength = 0;         // Sixteenths
+    uint32_t capeWidthSpacing = 0;          // Sixteenths
+    bool capeXpbd = false;
+};
+
+// Bit-packed flyer snapshots. A full snapshot is 25 bytes; a delta against a
+// recent baseline spends one bit per unchanged group (position, velocity,
+// rotation, flight, appearance) and a short bucketed code per changed axis, so
+// a flyer banking and climbing at full speed costs about 18 bytes a tick
+// against a baseline 100 ms old.
+class FlyerSnapshotCodec {
+public:
+    FlyerSnapshotCodec();
+    explicit FlyerSnapshotCodec(const FlyerQuantization& quantization);
+
+    QuantizedFlyer quantize(const FlyerNetState& state) const;
+    FlyerNetState dequantize(const QuantizedFlyer& state) const;
+
+    // No baseline: every field in full
+    void encode(BitWriter& out, const QuantizedFlyer& state, const QuantizedFlyer* baseline) const;
+    // `baseline` must be the one the encoder was given; false on truncated data
+    bool decode(BitReader& in, QuantizedFlyer& state, const QuantizedFlyer* baseline) const;
+
+    const FlyerQuantization& getQuantization() const { return quantization; }
+
+private:
+    FlyerQuantization quantization;
+    float rotationScale;
+};
+
+// === Streams ===
+// One flyer toward one receiver. Each message is [tick:16][baseline age:5][payload];
+// age 0 is a full snapshot, otherwise the payload is a delta against tick - age.
+
+// Kept per receiver: deltas go against the newest tick that receiver acknowledged,
+// and fall back to full snapshots until one arrives or when it is too old
+class FlyerSnapshotEncoder {
+public:
+    static constexpr uint16_t kHistory = 32;    // Ticks a baseline stays usable
+
+    FlyerSnapshotEncoder() = default;
+    explicit FlyerSnapshotEncoder(const FlyerSnapshotCodec& codec) : codec(codec) {}
+
+    void encode(uint16_t tick, const FlyerNetState& state, BitWriter& out);
+    // The receiver decoded `tick`; older or unknown ticks are ignored
+    void acknowledge(uint16_t tick);
+    // Full snapshots again, e.g. after the receiver rejoined
+    void reset();
+
+private:
+    struct Entry {
+        QuantizedFlyer state;
+        uint16_t tick = 0;
+        bool valid = false;
+    };
+
+    FlyerSnapshotCodec codec;
+    std::array<Entry, kHistory> history{};
+    uint16_t ackedTick = 0;
+    bool acked = false;
+};
+
+class FlyerSnapshotDecoder {
+public:
+    FlyerSnapshotDecoder() = default;
+    explicit FlyerSnapshotDecoder(const FlyerSnapshotCodec& codec) : codec(codec) {}
+
+    // On success acknowledge `tick` to the sender. False on truncated data or a
+    // baseline this decoder no longer has; the message's bits are consumed either
+    // way, so the flyers after it in the same packet still decode.
+    bool decode(BitReader& in, FlyerNetState& state, uint16_t& tick);
+    void reset();
+
+private:
+    struct Entry {
+        QuantizedFlyer state;
+        uint16_t tick = 0;
+        bool valid = false;
+    };
+
+    FlyerSnapshotCodec codec;
+    std::array<Entry, FlyerSnapshotEncoder::kHistory> history{};
+};
+
+} // namespace ethereal
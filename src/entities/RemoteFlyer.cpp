@@ -0,0 +1,61 @@
+#include "RemoteFlyer.hpp"
+#include <algorithm>
+
+namespace ethereal {
+
+namespace {
+
+bool sameShape(const FlyerAppearance& a, const FlyerAppearance& b) {
+    return a.capeSegments == b.capeSegments && a.capeWidth == b.capeWidth &&
+           a.capeSegmentLength == b.capeSegmentLength && a.capeWidthSpacing == b.capeWidthSpacing &&
+           a.capeSolver == b.capeSolver;
+}
+
+} // namespace
+
+RemoteFlyer::RemoteFlyer() : RemoteFlyer(RemoteFlyerConfig{}) {}
+
+RemoteFlyer::RemoteFlyer(const RemoteFlyerConfig& config)
+    : config(config)
+    , body(Vector3D::zero(), config.character) {}
+
+void RemoteFlyer::receive(uint16_t tick, const FlyerNetState& state) {
+    // Ticks wrap, so order by the signed difference
+    if (received && static_cast<int16_t>(tick - latestTick) <= 0) return;
+
+    int ticks = received ? static_cast<uint16_t>(tick - latestTick) : 0;
+    from = received ? drawn : state.character;
+    latest = state;
+    latestTick = tick;
+    blend = 0.0f;
+    blendDuration = ticks / std::max(config.tickRate, 1.0f);
+
+    if (!received) {
+        drawn = state.character;
+        body.setState(drawn);
+        received = true;
+    }
+    if (!capeBuilt || !sameShape(capeAppearance, state.appearance)) rebuildCape();
+}
+
+void RemoteFlyer::update(float dt, const WindField3D& wind) {
+    if (!received) return;
+
+    // Eases over the gap since the previous tick, then holds until the next one
+    blend = blendDuration > 0.0f ? std::min(1.0f, blend + dt / blendDuration) : 1.0f;
+    drawn = CharacterState3D::interpolate(from, latest.character, blend);
+    body.setState(drawn);
+
+    cape.setAttachPoint(body.getCapeAttachPoint(), body.getForward());
+    cape.setAttachVelocity(drawn.velocity);
+    cape.update(dt, wind);
+    cape.solveConstraints(config.capeIterations);
+}
+
+void RemoteFlyer::rebuildCape() {
+    capeAppearance = latest.appearance;
+    cape = Cape3D(body.getCapeAttachPoint(), body.getForward(), capeAppearance.toCapeConfig(config.cape));
+    capeBuilt = true;
+}
+
+} // namespace ethereal
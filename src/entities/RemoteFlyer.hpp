@@ -0,0 +1,55 @@
+#pragma once
+#include "entities/Character3D.hpp"
+#include "entities/FlyerSnapshot.hpp"
+#include "physics/Cape3D.hpp"
+#include "physics/WindField3D.hpp"
+#include <cstdint>
+
+namespace ethereal {
+
+struct RemoteFlyerConfig {
+    float tickRate = 60.0f;         // Snapshot ticks per second
+    int capeIterations = 4;
+    CharacterConfig3D character;    // Proportions of the stand-in body (cape attach point)
+    CapeConfig3D cape;              // Everything FlyerAppearance does not carry
+};
+
+// Another player's flyer, driven by decoded snapshots. The drawn transform eases
+// from where it was toward each newly received tick over that tick's interval, and
+// the cape is rebuilt from the appearance and re-simulated locally in the local
+// wind. Energy orbs follow getCharacterState() through EnergyBeingRenderer::update.
+class RemoteFlyer {
+public:
+    RemoteFlyer();
+    explicit RemoteFlyer(const RemoteFlyerConfig& config);
+
+    // Ticks at or before the newest one received are dropped
+    void receive(uint16_t tick, const FlyerNetState& state);
+    void update(float dt, const WindField3D& wind);
+
+    bool hasState() const { return received; }
+    uint16_t getLatestTick() const { return latestTick; }
+    const FlyerNetState& getLatest() const { return latest; }
+    const CharacterState3D& getCharacterState() const { return drawn; }
+    const Character3D& getBody() const { return body; }
+    const Cape3D& getCape() const { return cape; }
+
+private:
+    RemoteFlyerConfig config;
+    Character3D body;
+    Cape3D cape;
+    FlyerAppearance capeAppearance;
+    bool capeBuilt = false;
+
+    FlyerNetState latest;
+    CharacterState3D from;          // Drawn state when the latest tick arrived
+    CharacterState3D drawn;
+    float blend = 1.0f;
+    float blendDuration = 0.0f;
+    uint16_t latestTick = 0;
+    bool received = false;
+
+    void rebuildCape();
+};
+
+} // namespace ethereal
@@ -0,0 +1,54 @@
+#include "TrailBuffer.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ethereal {
+
+TrailBuffer::TrailBuffer() : TrailBuffer(20) {}
+
+TrailBuffer::TrailBuffer(size_t capacity) {
+    setCapacity(capacity);
+}
+
+void TrailBuffer::setCapacity(size_t capacity) {
+    samples.assign(std::max<size_t>(capacity, 1), Sample{});
+    clear();
+}
+
+void TrailBuffer::push(const Vector3D& position, float size, float time) {
+    samples[head] = { position, time, size };
+    head = (head + 1) % samples.size();
+    count = std::min(count + 1, samples.size());
+}
+
+void TrailBuffer::clear() {
+    head = 0;
+    count = 0;
+}
+
+const TrailBuffer::Sample& TrailBuffer::sample(size_t index) const {
+    size_t capacity = samples.size();
+    return samples[(head + capacity - 1 - index) % capacity];
+}
+
+// === View ===
+
+TrailBuffer::View::View(const TrailBuffer& buffer, float time, const TrailFade& fade)
+    : buffer(&buffer)
+    , time(time)
+    , fade(fade)
+    , count(buffer.size()) {
+    while (count > 0 && sizeAt(count - 1) < fade.minSize) --count;
+}
+
+float TrailBuffer::View::sizeAt(size_t index) const {
+    const Sample& s = buffer->sample(index);
+    return s.spawnSize * std::exp(-fade.shrinkRate * std::max(time - s.spawnTime, 0.0f));
+}
+
+TrailPoint TrailBuffer::View::operator[](size_t index) const {
+    float t = static_cast<float>(index) / buffer->capacity();
+    return { buffer->sample(index).position, (1.0f - t) * fade.maxAlpha, sizeAt(index) };
+}
+
+} // namespace ethereal
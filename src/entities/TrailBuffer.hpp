@@ -0,0 +1,96 @@
+#pragma once
+#include "core/Vector3D.hpp"
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace ethereal {
+
+// Faded trail point as the renderers draw it
+struct TrailPoint {
+    Vector3D position;
+    float alpha;
+    float size;
+};
+
+struct TrailFade {
+    float maxAlpha = 0.6f;      // Alpha of the newest point; falls linearly to 0 at capacity
+    float shrinkRate = 1.21f;   // Size decays as exp(-shrinkRate * age)
+    float minSize = 0.1f;       // Points smaller than this are expired
+};
+
+// Fixed-capacity ring of trail samples, newest last in storage. Pushing is O(1);
+// alpha and size are not stored but derived from each sample's index and spawn
+// time when viewed, so nothing walks the whole trail per step.
+class TrailBuffer {
+public:
+    struct Sample {
+        Vector3D position;
+        float spawnTime;
+        float spawnSize;
+    };
+
+    // Read-only faded window over a buffer; index 0 is the newest point
+    class View {
+    public:
+        class Iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = TrailPoint;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = TrailPoint;
+
+            Iterator(const View* view, size_t index) : view(view), index(index) {}
+            TrailPoint operator*() const { return (*view)[index]; }
+            Iterator& operator++() { ++index; return *this; }
+            bool operator==(const Iterator& other) const { return index == other.index; }
+            bool operator!=(const Iterator& other) const { return index != other.index; }
+
+        private:
+            const View* view;
+            size_t index;
+        };
+
+        View(const TrailBuffer& buffer, float time, const TrailFade& fade);
+
+        // Live points only: the expired tail is trimmed when the view is made
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        TrailPoint operator[](size_t index) const;
+
+        Iterator begin() const { return Iterator(this, 0); }
+        Iterator end() const { return Iterator(this, count); }
+
+    private:
+        const TrailBuffer* buffer;
+        float time;
+        TrailFade fade;
+        size_t count;
+
+        float sizeAt(size_t index) const;
+    };
+
+    TrailBuffer();
+    explicit TrailBuffer(size_t capacity);
+
+    // Drops all samples
+    void setCapacity(size_t capacity);
+    size_t capacity() const { return samples.size(); }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    void push(const Vector3D& position, float size, float time);
+    void clear();
+
+    // index 0 is the newest sample
+    const Sample& sample(size_t index) const;
+    View view(float time, const TrailFade& fade = TrailFade{}) const { return View(*this, time, fade); }
+
+private:
+    std::vector<Sample> samples;
+    size_t head = 0;    // Slot the next push writes
+    size_t count = 0;
+};
+
+} // namespace ethereal
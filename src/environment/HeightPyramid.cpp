@@ -0,0 +1,180 @@
+#include "HeightPyramid.hpp"
+#include "environment/Terrain.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ethereal {
+
+namespace {
+
+// Clips [t0, t1] to the slab lo <= o + d * t <= hi; false when nothing is left
+bool clipSlab(float o, float d, float lo, float hi, float& t0, float& t1) {
+    if (std::abs(d) < 1e-12f) return o >= lo && o <= hi;
+    float inv = 1.0f / d;
+    float a = (lo - o) * inv;
+    float b = (hi - o) * inv;
+    if (a > b) std::swap(a, b);
+    t0 = std::max(t0, a);
+    t1 = std::min(t1, b);
+    return t0 <= t1;
+}
+
+} // namespace
+
+void HeightPyramid::build(const HeightTile& tile) {
+    levels.clear();
+    const int res = tile.resolution;
+    if (res <= 0) return;
+
+    const int stride = res + 1;
+    Level cells;
+    cells.size = res;
+    cells.ranges.resize(static_cast<size_t>(res) * res * 2);
+    for (int z = 0; z < res; ++z) {
+        const float* row0 = &tile.heights[z * stride];
+        const float* row1 = row0 + stride;
+        for (int x = 0; x < res; ++x) {
+            float* range = &cells.ranges[(z * res + x) * 2];
+            range[0] = std::min(std::min(row0[x], row0[x + 1]), std::min(row1[x], row1[x + 1]));
+            range[1] = std::max(std::max(row0[x], row0[x + 1]), std::max(row1[x], row1[x + 1]));
+        }
+    }
+    levels.push_back(std::move(cells));
+
+    while (levels.back().size > 1) {
+        const Level& child = levels.back();
+        Level parent;
+        parent.size = (child.size + 1) / 2;
+        parent.ranges.resize(static_cast<size_t>(parent.size) * parent.size * 2);
+        for (int z = 0; z < parent.size; ++z) {
+            for (int x = 0; x < parent.size; ++x) {
+                float lo = std::numeric_limits<float>::max();
+                float hi = -std::numeric_limits<float>::max();
+                // Odd sizes leave the last row/column with a single child
+                for (int cz = 2 * z; cz < std::min(2 * z + 2, child.size); ++cz) {
+                    for (int cx = 2 * x; cx < std::min(2 * x + 2, child.size); ++cx) {
+                        const float* range = &child.ranges[(cz * child.size + cx) * 2];
+                        lo = std::min(lo, range[0]);
+                        hi = std::max(hi, range[1]);
+                    }
+                }
+                parent.ranges[(z * parent.size + x) * 2] = lo;
+                parent.ranges[(z * parent.size + x) * 2 + 1] = hi;
+            }
+        }
+        levels.push_back(std::move(parent));
+    }
+}
+
+void HeightPyramid::clear() {
+    levels.clear();
+}
+
+bool HeightPyramid::raycast(const HeightTile& tile, const Vector3D& origin, const Vector3D& direction,
+                            float minDistance, float maxDistance, TerrainRayHit& hit) const {
+    if (levels.empty()) return false;
+    const int res = tile.resolution;
+    const int stride = res + 1;
+
+    // Grid space: one unit per cell in x/z, world units in y; t stays world distance
+    const float inverseSpacing = 1.0f / tile.spacing;
+    const float ox = (origin.x - tile.originX) * inverseSpacing;
+    const float oz = (origin.z - tile.originZ) * inverseSpacing;
+    const float dx = direction.x * inverseSpacing;
+    const float dz = direction.z * inverseSpacing;
+    const float oy = origin.y;
+    const float dy = direction.y;
+
+    float tileT0 = minDistance, tileT1 = maxDistance;
+    if (!clipSlab(ox, dx, 0.0f, static_cast<float>(res), tileT0, tileT1)) return false;
+    if (!clipSlab(oz, dz, 0.0f, static_cast<float>(res), tileT0, tileT1)) return false;
+
+    auto finish = [&](float t, int cx, int cz) {
+        float u = std::clamp(ox + dx * t - cx, 0.0f, 1.0f);
+        float v = std::clamp(oz + dz * t - cz, 0.0f, 1.0f);
+        const float* row0 = &tile.heights[cz * stride + cx];
+        const float* row1 = row0 + stride;
+        float e = row0[1] - row0[0];
+        float g = row1[0] - row0[0];
+        float k = row0[0] - row0[1] - row1[0] + row1[1];
+        hit.distance = t;
+        hit.position = origin + direction * t;
+        hit.position.y = row0[0] + e * u + g * v + k * u * v;
+        hit.normal = Vector3D(-(e + k * v) * inverseSpacing, 1.0f, -(g + k * u) * inverseSpacing).normalized();
+        return true;
+    };
+
+    // Depth-first, nearest child on top, so the first cell that hits is the closest.
+    // A line crosses at most three of a node's four children.
+    struct Node { int level, x, z; };
+    Node stack[128];
+    int top = 0;
+    stack[top++] = { static_cast<int>(levels.size()) - 1, 0, 0 };
+    const int nearX = dx >= 0.0f ? 0 : 1;
+    const int nearZ = dz >= 0.0f ? 0 : 1;
+
+    while (top > 0) {
+        Node node = stack[--top];
+        const Level& level = levels[node.level];
+        const int span = 1 << node.level;
+        const int x0 = node.x * span, z0 = node.z * span;
+        const int x1 = std::min(x0 + span, res), z1 = std::min(z0 + span, res);
+
+        float t0 = tileT0, t1 = tileT1;
+        if (!clipSlab(ox, dx, static_cast<float>(x0), static_cast<float>(x1), t0, t1)) continue;
+        if (!clipSlab(oz, dz, static_cast<float>(z0), static_cast<float>(z1), t0, t1)) continue;
+
+        const float* range = &level.ranges[(node.z * level.size + node.x) * 2];
+        float y0 = oy + dy * t0, y1 = oy + dy * t1;
+        if (std::min(y0, y1) > range[1]) continue;     // Passes over the whole node
+        if (std::max(y0, y1) < range[0]) {
+            // Under the whole node: the crossing was at the entry (or the ray starts underground)
+            int cx = std::clamp(static_cast<int>(ox + dx * t0), x0, x1 - 1);
+            int cz = std::clamp(static_cast<int>(oz + dz * t0), z0, z1 - 1);
+            return finish(t0, cx, cz);
+        }
+
+        if (node.level == 0) {
+            // Exact crossing with the bilinear cell: y(t) - h(u(t), v(t)) is quadratic in t
+            const float* row0 = &tile.heights[node.z * stride + node.x];
+            const float* row1 = row0 + stride;
+            float e = row0[1] - row0[0];
+            float g = row1[0] - row0[0];
+            float k = row0[0] - row0[1] - row1[0] + row1[1];
+            float au = ox - node.x, av = oz - node.z;
+            float c = oy - (row0[0] + e * au + g * av + k * au * av);
+            float b = dy - (e * dx + g * dz + k * (au * dz + av * dx));
+            float a = -k * dx * dz;
+
+            if (c + (b + a * t0) * t0 <= 0.0f) return finish(t0, node.x, node.z);
+            float root = std::numeric_limits<float>::max();
+            if (std::abs(a) < 1e-9f) {
+                if (std::abs(b) > 1e-12f) root = -c / b;
+            } else {
+                float disc = b * b - 4.0f * a * c;
+                if (disc >= 0.0f) {
+                    float q = -0.5f * (b + std::copysign(std::sqrt(disc), b));
+                    float r0 = q / a;
+                    float r1 = std::abs(q) > 1e-12f ? c / q : r0;
+                    if (r0 > r1) std::swap(r0, r1);
+                    root = r0 >= t0 ? r0 : r1;
+                }
+            }
+            if (root >= t0 && root <= t1) return finish(root, node.x, node.z);
+            continue;
+        }
+
+        const Level& child = levels[node.level - 1];
+        // Far-far first, near-near last (popped first)
+        const int order[4][2] = { { 1 - nearX, 1 - nearZ }, { nearX, 1 - nearZ }, { 1 - nearX, nearZ }, { nearX, nearZ } };
+        for (const auto& pick : order) {
+            int cx = node.x * 2 + pick[0];
+            int cz = node.z * 2 + pick[1];
+            if (cx < child.size && cz < child.size) stack[top++] = { node.level - 1, cx, cz };
+        }
+    }
+    return false;
+}
+
+} // namespace ethereal
@@ -0,0 +1,46 @@
+#pragma once
+#include "core/Vector3D.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace ethereal {
+
+struct HeightTile;
+
+struct TerrainRayHit {
+    Vector3D position;
+    Vector3D normal;
+    float distance = 0.0f;      // Along the ray's unit direction
+};
+
+// Min/max mip pyramid over a HeightTile. Level 0 holds each cell's height range
+// (its four corners bound the bilinear surface); every level above halves the
+// grid. A ray descends from the single top node, skipping any node it passes
+// over entirely, and solves the exact bilinear crossing only in the few cells
+// left, so a query touches O(log n) nodes instead of marching every cell.
+// The pyramid keeps no pointer to its tile; queries are handed the tile it was
+// built from.
+class HeightPyramid {
+public:
+    void build(const HeightTile& tile);
+    void clear();
+    bool isBuilt() const { return !levels.empty(); }
+
+    // First crossing within [minDistance, maxDistance] along the unit `direction`
+    bool raycast(const HeightTile& tile, const Vector3D& origin, const Vector3D& direction,
+                 float minDistance, float maxDistance, TerrainRayHit& hit) const;
+
+    int getLevelCount() const { return static_cast<int>(levels.size()); }
+    float getMinHeight() const { return levels.empty() ? 0.0f : levels.back().ranges[0]; }
+    float getMaxHeight() const { return levels.empty() ? 0.0f : levels.back().ranges[1]; }
+
+private:
+    struct Level {
+        int size = 0;                   // Nodes per edge
+        std::vector<float> ranges;      // Interleaved min, max per node, row-major
+    };
+
+    std::vector<Level> levels;          // levels[0] = cells, back() = one node
+};
+
+} // namespace ethereal
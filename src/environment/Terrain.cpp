@@ -1,95 +1,509 @@
 #include "Terrain.hpp"
+#include "utils/MemoryTracker.hpp"
+#include "utils/JobSystem.hpp"
+#include "utils/MappedFile.hpp"
+#include "utils/Profiler.hpp"
 #include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <algorithm>
 
 namespace ethereal {
 
+namespace {
+
+// Bump whenever the noise, normals or peak search change what generate() produces
+const uint32_t kCacheVersion = 1;
+const size_t kCacheHeaderSize = 40;
+const size_t kVertexFloats = 7;     // position, normal, height
+const size_t kMountainFloats = 6;   // position, height, radius, steepness
+
+struct CacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t seed;
+    uint32_t gridSize;
+    uint64_t configHash;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t mountainCount;
+    uint32_t reserved;
+};
+static_assert(sizeof(CacheHeader) == kCacheHeaderSize, "terrain cache header layout");
+
+// Bump whenever generateChunk() changes what it produces
+const uint32_t kChunkCacheVersion = 1;
+const size_t kChunkHeaderSize = 40;
+
+struct ChunkCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    int32_t chunkX;
+    int32_t chunkZ;
+    uint32_t resolution;
+    uint32_t vertexCount;
+    uint64_t reserved;
+};
+static_assert(sizeof(ChunkCacheHeader) == kChunkHeaderSize, "terrain chunk cache header layout");
+
+uint64_t hashBytes(uint64_t hash, const void* bytes, size_t size) {
+    const unsigned char* p = static_cast<const unsigned char*>(bytes);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ p[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+template <typename T>
+uint64_t hashValue(uint64_t hash, T value) {
+    return hashBytes(hash, &value, sizeof(value));
+}
+
+// Fixed-shape layers; the mountain and primary dune layers follow the config
+using RidgeLayer = Fbm<3, 2, std::ratio<3, 5>>;
+using SecondaryDuneLayer = Fbm<2, 2, std::ratio<2, 5>>;
+using DetailLayer = Fbm<2, 2, std::ratio<3, 10>>;
+
+// Rows per task: enough noise work to amortize a job, small enough to balance
+const size_t kRowGrain = 8;
+
+// fn(beginRow, endRow) over [0, rows), split across the job system when there is one
+template <typename Fn>
+void forEachRowBand(JobSystem* jobs, int rows, const Fn& fn) {
+    if (!jobs || rows <= static_cast<int>(kRowGrain)) {
+        fn(0, rows);
+        return;
+    }
+    jobs->parallelFor(static_cast<size_t>(rows), kRowGrain, [&fn](size_t begin, size_t end) {
+        fn(static_cast<int>(begin), static_cast<int>(end));
+    });
+}
+
+} // namespace
+
 Terrain::Terrain() : Terrain(TerrainConfig{}) {}
 
 Terrain::Terrain(const TerrainConfig& config)
     : config(config)
     , mountainNoise(42)
     , duneNoise(123)
-    , detailNoise(456) {}
+    , detailNoise(456) {
+    selectLayers();
+}
 
-void Terrain::generate(uint32_t seed) {
+void Terrain::selectLayers() {
+    mountainLayer = &selectFractal(config.mountainFractal, config.mountainOctaves);
+    duneLayer = &selectFractal(FractalType::Fbm, config.duneOctaves);
+}
+
+void Terrain::reseed(uint32_t seed) {
     mountainNoise.reseed(seed);
     duneNoise.reseed(seed + 1000);
     detailNoise.reseed(seed + 2000);
-    
-    vertices.clear();
-    indices.clear();
+    noiseSeed = seed;
+    reseeded = true;
+}
+
+void Terrain::generate(uint32_t seed) {
+    generatePatch(seed, nullptr);
+}
+
+void Terrain::generate(uint32_t seed, JobSystem& jobs) {
+    generatePatch(seed, &jobs);
+}
+
+void Terrain::generatePatch(uint32_t seed, JobSystem* jobs) {
+    PROFILE_SCOPE("Terrain::generate");
+    MEMORY_TAG(Terrain);
+    reseed(seed);
     
     int gridSize = config.gridSize;
+    int samples = gridSize + 1;
     float tileSize = config.tileSize;
     float halfSize = (gridSize * tileSize) * 0.5f;
     
-    vertices.reserve((gridSize + 1) * (gridSize + 1));
+    std::vector<float> axis(samples);
+    for (int i = 0; i < samples; ++i) {
+        axis[i] = i * tileSize - halfSize;
+    }
+    std::vector<float> heights(axis.size() * axis.size());
+    vertices.resize(heights.size());
     
-    for (int z = 0; z <= gridSize; ++z) {
-        for (int x = 0; x <= gridSize; ++x) {
-            float worldX = x * tileSize - halfSize;
-            float worldZ = z * tileSize - halfSize;
-            
-            float height = getHeightAt(worldX, worldZ);
+    // Rows only read the noise tables, so bands of them evaluate independently
+    forEachRowBand(jobs, samples, [&](int begin, int end) {
+        getHeightsOnGrid(axis.data(), samples, axis.data() + begin, end - begin, heights.data() + begin * samples);
+        
+        for (int z = begin; z < end; ++z) {
+            for (int x = 0; x < samples; ++x) {
+                float height = heights[z * samples + x];
+                
+                TerrainVertex& vertex = vertices[z * samples + x];
+                vertex.position = Vector3D(axis[x], height, axis[z]);
+                vertex.height = height;
+                vertex.normal = Vector3D(0, 1, 0);
+            }
+        }
+    });
+    
+    calculateNormals(jobs);
+    forEachRowBand(jobs, samples, [&](int begin, int end) {
+        bakeVertexAttributes(vertices.data(), static_cast<size_t>(begin) * samples, static_cast<size_t>(end) * samples);
+    });
+    
+    buildGridIndices(gridSize, indices, jobs);
+    
+    patchHeights.originX = -halfSize;
+    patchHeights.originZ = -halfSize;
+    patchHeights.spacing = tileSize;
+    patchHeights.resolution = gridSize;
+    patchHeights.heights = std::move(heights);
+    patchPyramid.build(patchHeights);
+    
+    generateMountainPeaks();
+    patchSeed = seed;
+    ++revision;
+}
+
+uint64_t Terrain::hashConfig(const TerrainConfig& cfg) {
+    uint64_t hash = 14695981039346656037ull;
+    hash = hashValue(hash, cfg.gridSize);
+    hash = hashValue(hash, cfg.tileSize);
+    hash = hashValue(hash, cfg.maxHeight);
+    hash = hashValue(hash, cfg.mountainFrequency);
+    hash = hashValue(hash, cfg.duneFrequency);
+    hash = hashValue(hash, cfg.mountainPower);
+    hash = hashValue(hash, cfg.duneAmplitude);
+    hash = hashValue(hash, cfg.mountainOctaves);
+    hash = hashValue(hash, cfg.duneOctaves);
+    hash = hashValue(hash, cfg.baseHeight);
+    hash = hashValue(hash, cfg.mountainFractal);
+    return hash;
+}
+
+bool Terrain::saveCache(const std::string& path) const {
+    PROFILE_SCOPE("Terrain::saveCache");
+    if (vertices.empty()) return false;
+    
+    CacheHeader header = {};
+    std::memcpy(header.magic, "LTRC", 4);
+    header.version = kCacheVersion;
+    header.seed = patchSeed;
+    header.gridSize = static_cast<uint32_t>(config.gridSize);
+    header.configHash = hashConfig(config);
+    header.vertexCount = static_cast<uint32_t>(vertices.size());
+    header.indexCount = static_cast<uint32_t>(indices.size());
+    header.mountainCount = static_cast<uint32_t>(mountains.size());
+    
+    std::vector<float> vertexData;
+    vertexData.reserve(vertices.size() * kVertexFloats);
+    for (const auto& v : vertices) {
+        float packed[kVertexFloats] = { v.position.x, v.position.y, v.position.z,
+                                        v.normal.x, v.normal.y, v.normal.z, v.height };
+        vertexData.insert(vertexData.end(), packed, packed + kVertexFloats);
+    }
+    std::vector<float> mountainData;
+    mountainData.reserve(mountains.size() * kMountainFloats);
+    for (const auto& m : mountains) {
+        float packed[kMountainFloats] = { m.position.x, m.position.y, m.position.z,
+                                          m.height, m.radius, m.steepness };
+        mountainData.insert(mountainData.end(), packed, packed + kMountainFloats);
+    }
+    
+    // Write beside the target and rename, so a crash never leaves a torn cache
+    std::string tempPath = path + ".tmp";
+    std::FILE* out = std::fopen(tempPath.c_str(), "wb");
+    if (!out) return false;
+    bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1 &&
+              std::fwrite(vertexData.data(), sizeof(float), vertexData.size(), out) == vertexData.size() &&
+              std::fwrite(indices.data(), sizeof(unsigned int), indices.size(), out) == indices.size() &&
+              std::fwrite(mountainData.data(), sizeof(float), mountainData.size(), out) == mountainData.size();
+    ok = std::fclose(out) == 0 && ok;
+    
+    std::remove(path.c_str());
+    if (!ok || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool Terrain::loadCache(const std::string& path, uint32_t seed) {
+    PROFILE_SCOPE("Terrain::loadCache");
+    MEMORY_TAG(Terrain);
+    MappedFile file;
+    if (!file.open(path) || file.size() < kCacheHeaderSize) return false;
+    
+    CacheHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, "LTRC", 4) != 0 || header.version != kCacheVersion) return false;
+    if (header.seed != seed || header.configHash != hashConfig(config)) return false;
+    
+    const size_t gridVertices = static_cast<size_t>(config.gridSize + 1) * (config.gridSize + 1);
+    if (header.gridSize != static_cast<uint32_t>(config.gridSize) || header.vertexCount != gridVertices) return false;
+    
+    const size_t vertexBytes = header.vertexCount * kVertexFloats * sizeof(float);
+    const size_t indexBytes = header.indexCount * sizeof(unsigned int);
+    const size_t mountainBytes = header.mountainCount * kMountainFloats * sizeof(float);
+    if (file.size() < kCacheHeaderSize + vertexBytes + indexBytes + mountainBytes) return false;
+    
+    // A bad index would draw out of bounds, so check them all before adopting anything
+    const size_t gridIndices = static_cast<size_t>(config.gridSize) * config.gridSize * 6;
+    if (header.indexCount != gridIndices) return false;
+    const unsigned char* indexData = file.data() + kCacheHeaderSize + vertexBytes;
+    for (size_t i = 0; i < header.indexCount; ++i) {
+        unsigned int index;
+        std::memcpy(&index, indexData + i * sizeof(unsigned int), sizeof(index));
+        if (index >= header.vertexCount) return false;
+    }
+    
+    const unsigned char* cursor = file.data() + kCacheHeaderSize;
+    auto readFloats = [&cursor](float* out, size_t count) {
+        std::memcpy(out, cursor, count * sizeof(float));
+        cursor += count * sizeof(float);
+    };
+    
+    vertices.resize(header.vertexCount);
+    for (auto& v : vertices) {
+        float packed[kVertexFloats];
+        readFloats(packed, kVertexFloats);
+        v.position = Vector3D(packed[0], packed[1], packed[2]);
+        v.normal = Vector3D(packed[3], packed[4], packed[5]);
+        v.height = packed[6];
+    }
+    // Colors are not part of the cache key, so the albedos are always rebaked
+    bakeVertexAttributes(vertices.data(), 0, vertices.size());
+    
+    indices.resize(header.indexCount);
+    std::memcpy(indices.data(), cursor, indexBytes);
+    cursor += indexBytes;
+    
+    mountains.resize(header.mountainCount);
+    for (auto& m : mountains) {
+        float packed[kMountainFloats];
+        readFloats(packed, kMountainFloats);
+        m.position = Vector3D(packed[0], packed[1], packed[2]);
+        m.height = packed[3];
+        m.radius = packed[4];
+        m.steepness = packed[5];
+    }
+    
+    // Exact queries outside the patch still evaluate the noise
+    reseed(seed);
+    rebuildPatchHeights();
+    patchSeed = seed;
+    ++revision;
+    return true;
+}
+
+void Terrain::rebuildPatchHeights() {
+    float halfSize = getTotalSize() * 0.5f;
+    patchHeights.originX = -halfSize;
+    patchHeights.originZ = -halfSize;
+    patchHeights.spacing = config.tileSize;
+    patchHeights.resolution = config.gridSize;
+    patchHeights.heights.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        patchHeights.heights[i] = vertices[i].height;
+    }
+    patchPyramid.build(patchHeights);
+}
+
+void Terrain::generateChunk(int chunkX, int chunkZ, TerrainChunk& chunk) const {
+    PROFILE_SCOPE("Terrain::generateChunk");
+    MEMORY_TAG(Terrain);
+    const int resolution = std::max(1, config.chunkResolution);
+    const float tileSize = config.tileSize;
+    const float originX = chunkX * getChunkSize();
+    const float originZ = chunkZ * getChunkSize();
+    
+    chunk.chunkX = chunkX;
+    chunk.chunkZ = chunkZ;
+    
+    // One extra ring of samples so edge normals match the neighbouring chunk
+    const int samples = resolution + 3;
+    std::vector<float> axisX(samples), axisZ(samples);
+    for (int i = 0; i < samples; ++i) {
+        axisX[i] = originX + (i - 1) * tileSize;
+        axisZ[i] = originZ + (i - 1) * tileSize;
+    }
+    std::vector<float> heights(static_cast<size_t>(samples) * samples);
+    getHeightsOnGrid(axisX.data(), samples, axisZ.data(), samples, heights.data());
+    
+    auto heightAt = [&](int x, int z) { return heights[(z + 1) * samples + (x + 1)]; };
+    
+    chunk.vertices.clear();
+    chunk.vertices.reserve((resolution + 1) * (resolution + 1));
+    for (int z = 0; z <= resolution; ++z) {
+        for (int x = 0; x <= resolution; ++x) {
+            float height = heightAt(x, z);
             
             TerrainVertex vertex;
-            vertex.position = Vector3D(worldX, height, worldZ);
+            vertex.position = Vector3D(axisX[x + 1], height, axisZ[z + 1]);
             vertex.height = height;
-            vertex.normal = Vector3D(0, 1, 0);
+            // Central differences, as in getNormalAt
+            vertex.normal = Vector3D(
+                heightAt(x - 1, z) - heightAt(x + 1, z),
+                2.0f * tileSize,
+                heightAt(x, z - 1) - heightAt(x, z + 1)
+            ).normalized();
             
-            vertices.push_back(vertex);
+            chunk.vertices.push_back(vertex);
         }
     }
+    bakeVertexAttributes(chunk.vertices.data(), 0, chunk.vertices.size());
+    finishChunk(chunk);
+}
+
+void Terrain::finishChunk(TerrainChunk& chunk) const {
+    const int resolution = std::max(1, config.chunkResolution);
+    buildGridIndices(resolution, chunk.indices);
     
-    calculateNormals();
+    chunk.heights.originX = chunk.chunkX * getChunkSize();
+    chunk.heights.originZ = chunk.chunkZ * getChunkSize();
+    chunk.heights.spacing = config.tileSize;
+    chunk.heights.resolution = resolution;
+    chunk.heights.heights.resize((resolution + 1) * (resolution + 1));
+    for (size_t i = 0; i < chunk.vertices.size(); ++i) {
+        chunk.heights.heights[i] = chunk.vertices[i].height;
+    }
+    chunk.pyramid.build(chunk.heights);
+}
+
+uint64_t Terrain::chunkCacheKey(int chunkX, int chunkZ) const {
+    uint64_t hash = hashConfig(config);
+    hash = hashValue(hash, config.chunkResolution);
+    hash = hashValue(hash, reseeded);
+    hash = hashValue(hash, noiseSeed);
+    hash = hashValue(hash, chunkX);
+    hash = hashValue(hash, chunkZ);
+    return hash;
+}
+
+std::string Terrain::chunkCachePath(int chunkX, int chunkZ, const std::string& directory) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.chunk", static_cast<unsigned long long>(chunkCacheKey(chunkX, chunkZ)));
+    return directory.empty() ? std::string(name) : directory + "/" + name;
+}
+
+bool Terrain::generateChunkCached(int chunkX, int chunkZ, const std::string& directory, TerrainChunk& chunk) const {
+    if (loadChunkCache(chunkX, chunkZ, directory, chunk)) return true;
+    generateChunk(chunkX, chunkZ, chunk);
+    saveChunkCache(chunk, directory);
+    return false;
+}
+
+bool Terrain::saveChunkCache(const TerrainChunk& chunk, const std::string& directory) const {
+    PROFILE_SCOPE("Terrain::saveChunkCache");
+    if (chunk.vertices.empty()) return false;
     
-    indices.reserve(gridSize * gridSize * 6);
+    ChunkCacheHeader header = {};
+    std::memcpy(header.magic, "LTCK", 4);
+    header.version = kChunkCacheVersion;
+    header.key = chunkCacheKey(chunk.chunkX, chunk.chunkZ);
+    header.chunkX = chunk.chunkX;
+    header.chunkZ = chunk.chunkZ;
+    header.resolution = static_cast<uint32_t>(std::max(1, config.chunkResolution));
+    header.vertexCount = static_cast<uint32_t>(chunk.vertices.size());
     
-    for (int z = 0; z < gridSize; ++z) {
-        for (int x = 0; x < gridSize; ++x) {
-            unsigned int topLeft = z * (gridSize + 1) + x;
-            unsigned int topRight = topLeft + 1;
-            unsigned int bottomLeft = (z + 1) * (gridSize + 1) + x;
-            unsigned int bottomRight = bottomLeft + 1;
-            
-            indices.push_back(topLeft);
-            indices.push_back(bottomLeft);
-            indices.push_back(topRight);
-            
-            indices.push_back(topRight);
-            indices.push_back(bottomLeft);
-            indices.push_back(bottomRight);
-        }
+    std::vector<float> vertexData;
+    vertexData.reserve(chunk.vertices.size() * kVertexFloats);
+    for (const auto& v : chunk.vertices) {
+        float packed[kVertexFloats] = { v.position.x, v.position.y, v.position.z,
+                                        v.normal.x, v.normal.y, v.normal.z, v.height };
+        vertexData.insert(vertexData.end(), packed, packed + kVertexFloats);
     }
     
-    generateMountainPeaks();
+    // Same write-and-rename as saveCache
+    std::string path = chunkCachePath(chunk.chunkX, chunk.chunkZ, directory);
+    std::string tempPath = path + ".tmp";
+    std::FILE* out = std::fopen(tempPath.c_str(), "wb");
+    if (!out) return false;
+    bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1 &&
+              std::fwrite(vertexData.data(), sizeof(float), vertexData.size(), out) == vertexData.size();
+    ok = std::fclose(out) == 0 && ok;
+    
+    std::remove(path.c_str());
+    if (!ok || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
 }
 
-void Terrain::generateChunk(int chunkX, int chunkZ) {
-    // For streaming terrain - generates a specific chunk
-    // Can be expanded for infinite terrain
+bool Terrain::loadChunkCache(int chunkX, int chunkZ, const std::string& directory, TerrainChunk& chunk) const {
+    PROFILE_SCOPE("Terrain::loadChunkCache");
+    MEMORY_TAG(Terrain);
+    MappedFile file;
+    if (!file.open(chunkCachePath(chunkX, chunkZ, directory)) || file.size() < kChunkHeaderSize) return false;
+    
+    ChunkCacheHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, "LTCK", 4) != 0 || header.version != kChunkCacheVersion) return false;
+    // The name is only a hash, so the header confirms which chunk and shape this is
+    const int resolution = std::max(1, config.chunkResolution);
+    const size_t chunkVertices = static_cast<size_t>(resolution + 1) * (resolution + 1);
+    if (header.key != chunkCacheKey(chunkX, chunkZ) || header.chunkX != chunkX || header.chunkZ != chunkZ ||
+        header.resolution != static_cast<uint32_t>(resolution) || header.vertexCount != chunkVertices) {
+        return false;
+    }
+    if (file.size() < kChunkHeaderSize + chunkVertices * kVertexFloats * sizeof(float)) return false;
+    
+    const unsigned char* cursor = file.data() + kChunkHeaderSize;
+    chunk.chunkX = chunkX;
+    chunk.chunkZ = chunkZ;
+    chunk.vertices.resize(chunkVertices);
+    for (auto& v : chunk.vertices) {
+        float packed[kVertexFloats];
+        std::memcpy(packed, cursor, sizeof(packed));
+        cursor += sizeof(packed);
+        v.position = Vector3D(packed[0], packed[1], packed[2]);
+        v.normal = Vector3D(packed[3], packed[4], packed[5]);
+        v.height = packed[6];
+    }
+    // Colors are not part of the key, as for the patch cache
+    bakeVertexAttributes(chunk.vertices.data(), 0, chunk.vertices.size());
+    finishChunk(chunk);
+    return true;
+}
+
+void Terrain::buildGridIndices(int resolution, std::vector<unsigned int>& out, JobSystem* jobs) {
+    out.resize(static_cast<size_t>(resolution) * resolution * 6);
+    
+    forEachRowBand(jobs, resolution, [&](int begin, int end) {
+        for (int z = begin; z < end; ++z) {
+            unsigned int* quad = out.data() + static_cast<size_t>(z) * resolution * 6;
+            for (int x = 0; x < resolution; ++x, quad += 6) {
+                unsigned int topLeft = z * (resolution + 1) + x;
+                unsigned int topRight = topLeft + 1;
+                unsigned int bottomLeft = (z + 1) * (resolution + 1) + x;
+                unsigned int bottomRight = bottomLeft + 1;
+                
+                quad[0] = topLeft;
+                quad[1] = bottomLeft;
+                quad[2] = topRight;
+                
+                quad[3] = topRight;
+                quad[4] = bottomLeft;
+                quad[5] = bottomRight;
+            }
+        }
+    });
 }
 
 float Terrain::sampleMountainHeight(float x, float z) const {
-    float n = mountainNoise.octaveNoise(
-        x * config.mountainFrequency,
-        z * config.mountainFrequency,
-        config.mountainOctaves,
-        0.5f
-    );
+    float n = mountainLayer->sample2(mountainNoise, x * config.mountainFrequency, z * config.mountainFrequency);
     
     n = (n + 1.0f) * 0.5f;
     n = std::pow(n, config.mountainPower);
     
-    float ridgeNoise = mountainNoise.octaveNoise(
+    float ridgeNoise = RidgeLayer::sample(
+        mountainNoise,
         x * config.mountainFrequency * 2.0f + 500,
-        z * config.mountainFrequency * 2.0f + 500,
-        3,
-        0.6f
+        z * config.mountainFrequency * 2.0f + 500
     );
     ridgeNoise = 1.0f - std::abs(ridgeNoise);
-    ridgeNoise = std::pow(ridgeNoise, 2.0f);
+    ridgeNoise = ridgeNoise * ridgeNoise;
     
     n = n * 0.7f + ridgeNoise * 0.3f * n;
     
@@ -97,25 +511,18 @@ float Terrain::sampleMountainHeight(float x, float z) const {
 }
 
 float Terrain::sampleDuneHeight(float x, float z) const {
-    float primary = duneNoise.octaveNoise(
-        x * config.duneFrequency,
-        z * config.duneFrequency * 0.5f,
-        config.duneOctaves,
-        0.5f
-    );
+    float primary = duneLayer->sample2(duneNoise, x * config.duneFrequency, z * config.duneFrequency * 0.5f);
     
-    float secondary = duneNoise.octaveNoise(
+    float secondary = SecondaryDuneLayer::sample(
+        duneNoise,
         x * config.duneFrequency * 0.7f + 200,
-        z * config.duneFrequency * 1.2f + 200,
-        2,
-        0.4f
+        z * config.duneFrequency * 1.2f + 200
     );
     
-    float detail = detailNoise.octaveNoise(
+    float detail = DetailLayer::sample(
+        detailNoise,
         x * config.duneFrequency * 3.0f,
-        z * config.duneFrequency * 3.0f,
-        2,
-        0.3f
+        z * config.duneFrequency * 3.0f
     );
     
     float dune = primary * 0.6f + secondary * 0.3f + detail * 0.1f;
@@ -137,6 +544,139 @@ float Terrain::getHeightAt(float x, float z) const {
     return config.baseHeight + blendedHeight;
 }
 
+void Terrain::getHeightsOnGrid(const float* xs, int width, const float* zs, int height, float* out) const {
+    if (width <= 0 || height <= 0) return;
+
+    const size_t count = static_cast<size_t>(width) * height;
+    std::vector<float> ax(width), row(width);
+    std::vector<float> mountain(count), ridge(count), primary(count), secondary(count), detail(count);
+
+    // Each layer is an affine remap of the lattice axes, so every layer is one grid fill
+    auto fill = [&](const PerlinNoise& source, float frequency, float sx, float ox, float sz, float oz,
+                    FractalBatch2 layerNoise, std::vector<float>& layer) {
+        for (int i = 0; i < width; ++i) ax[i] = xs[i] * frequency * sx + ox;
+        for (int j = 0; j < height; ++j) {
+            std::fill(row.begin(), row.end(), zs[j] * frequency * sz + oz);
+            layerNoise(source, ax.data(), row.data(), layer.data() + static_cast<size_t>(j) * width, width);
+        }
+    };
+
+    const float mf = config.mountainFrequency;
+    const float df = config.duneFrequency;
+    fill(mountainNoise, mf, 1.0f, 0.0f, 1.0f, 0.0f, mountainLayer->batch2, mountain);
+    fill(mountainNoise, mf, 2.0f, 500.0f, 2.0f, 500.0f, &RidgeLayer::batch, ridge);
+    fill(duneNoise, df, 1.0f, 0.0f, 0.5f, 0.0f, duneLayer->batch2, primary);
+    fill(duneNoise, df, 0.7f, 200.0f, 1.2f, 200.0f, &SecondaryDuneLayer::batch, secondary);
+    fill(detailNoise, df, 3.0f, 0.0f, 3.0f, 0.0f, &DetailLayer::batch, detail);
+
+    for (int j = 0; j < height; ++j) {
+        for (int i = 0; i < width; ++i) {
+            size_t k = static_cast<size_t>(j) * width + i;
+            out[k] = combineLayers(mountain[k], ridge[k], primary[k], secondary[k], detail[k], xs[i], zs[j]);
+        }
+    }
+}
+
+void Terrain::getHeightsAt(const float* xs, const float* zs, float* out, size_t n) const {
+    constexpr size_t kBlock = 64;
+    float ax[kBlock], az[kBlock];
+    float mountain[kBlock], ridge[kBlock], primary[kBlock], secondary[kBlock], detail[kBlock];
+
+    const float mf = config.mountainFrequency;
+    const float df = config.duneFrequency;
+
+    for (size_t base = 0; base < n; base += kBlock) {
+        const size_t count = std::min(kBlock, n - base);
+        const float* bx = xs + base;
+        const float* bz = zs + base;
+
+        // Same layers as getHeightsOnGrid, on a point list instead of a lattice
+        auto fill = [&](const PerlinNoise& source, float frequency, float sx, float ox, float sz, float oz,
+                        FractalBatch2 layerNoise, float* layer) {
+            for (size_t i = 0; i < count; ++i) {
+                ax[i] = bx[i] * frequency * sx + ox;
+                az[i] = bz[i] * frequency * sz + oz;
+            }
+            layerNoise(source, ax, az, layer, count);
+        };
+
+        fill(mountainNoise, mf, 1.0f, 0.0f, 1.0f, 0.0f, mountainLayer->batch2, mountain);
+        fill(mountainNoise, mf, 2.0f, 500.0f, 2.0f, 500.0f, &RidgeLayer::batch, ridge);
+        fill(duneNoise, df, 1.0f, 0.0f, 0.5f, 0.0f, duneLayer->batch2, primary);
+        fill(duneNoise, df, 0.7f, 200.0f, 1.2f, 200.0f, &SecondaryDuneLayer::batch, secondary);
+        fill(detailNoise, df, 3.0f, 0.0f, 3.0f, 0.0f, &DetailLayer::batch, detail);
+
+        for (size_t i = 0; i < count; ++i) {
+            out[base + i] = combineLayers(mountain[i], ridge[i], primary[i], secondary[i], detail[i], bx[i], bz[i]);
+        }
+    }
+}
+
+float Terrain::combineLayers(float mountain, float ridge, float primary, float secondary, float detail,
+                             float x, float z) const {
+    // Same combination as sampleMountainHeight / sampleDuneHeight / getHeightAt
+    float n = (mountain + 1.0f) * 0.5f;
+    n = std::pow(n, config.mountainPower);
+    float r = 1.0f - std::abs(ridge);
+    r = r * r;
+    n = n * 0.7f + r * 0.3f * n;
+    float mountainHeight = n * config.maxHeight;
+
+    float dune = primary * 0.6f + secondary * 0.3f + detail * 0.1f;
+    dune = (dune + 1.0f) * 0.5f;
+    float windward = std::sin(x * 0.01f + z * 0.005f);
+    dune *= (0.8f + windward * 0.2f);
+    float duneHeight = dune * config.duneAmplitude;
+
+    float mountainFactor = mountainHeight / config.maxHeight;
+    float blendedHeight = mountainHeight + duneHeight * (1.0f - mountainFactor * 0.8f);
+    return config.baseHeight + blendedHeight;
+}
+
+float Terrain::sampleHeight(float x, float z) const {
+    return patchHeights.contains(x, z) ? patchHeights.sample(x, z) : getHeightAt(x, z);
+}
+
+bool Terrain::raycast(const Vector3D& origin, const Vector3D& direction, float maxDistance, TerrainRayHit& hit) const {
+    return patchPyramid.raycast(patchHeights, origin, direction, 0.0f, maxDistance, hit);
+}
+
+Vector3D Terrain::sampleNormal(float x, float z) const {
+    // Same stencil as getNormalAt, on the cached heights
+    float epsilon = config.tileSize * 0.5f;
+    
+    float hL = sampleHeight(x - epsilon, z);
+    float hR = sampleHeight(x + epsilon, z);
+    float hD = sampleHeight(x, z - epsilon);
+    float hU = sampleHeight(x, z + epsilon);
+    
+    Vector3D normal(hL - hR, 2.0f * epsilon, hD - hU);
+    return normal.normalized();
+}
+
+bool HeightTile::contains(float x, float z) const {
+    float extent = resolution * spacing;
+    return resolution > 0
+        && x >= originX && x <= originX + extent
+        && z >= originZ && z <= originZ + extent;
+}
+
+float HeightTile::sample(float x, float z) const {
+    float fx = (x - originX) / spacing;
+    float fz = (z - originZ) / spacing;
+    int ix = std::clamp(static_cast<int>(fx), 0, resolution - 1);
+    int iz = std::clamp(static_cast<int>(fz), 0, resolution - 1);
+    float tx = std::clamp(fx - ix, 0.0f, 1.0f);
+    float tz = std::clamp(fz - iz, 0.0f, 1.0f);
+
+    const int stride = resolution + 1;
+    const float* row0 = &heights[iz * stride + ix];
+    const float* row1 = row0 + stride;
+    float top = row0[0] + (row0[1] - row0[0]) * tx;
+    float bottom = row1[0] + (row1[1] - row1[0]) * tx;
+    return top + (bottom - top) * tz;
+}
+
 Vector3D Terrain::getNormalAt(float x, float z) const {
     float epsilon = config.tileSize * 0.5f;
     
@@ -150,11 +690,43 @@ Vector3D Terrain::getNormalAt(float x, float z) const {
 }
 
 Color Terrain::getColorAt(float x, float z, float height) const {
+    if (!patchHeights.contains(x, z)) {
+        return shadeAlbedo(x, z, height, getNormalAt(x, z).y);
+    }
+    
+    // Bilinear blend of the four baked corners, same cell lookup as HeightTile::sample
+    const HeightTile& tile = patchHeights;
+    float fx = (x - tile.originX) / tile.spacing;
+    float fz = (z - tile.originZ) / tile.spacing;
+    int ix = std::clamp(static_cast<int>(fx), 0, tile.resolution - 1);
+    int iz = std::clamp(static_cast<int>(fz), 0, tile.resolution - 1);
+    float tx = std::clamp(fx - ix, 0.0f, 1.0f);
+    float tz = std::clamp(fz - iz, 0.0f, 1.0f);
+    
+    const int stride = tile.resolution + 1;
+    const TerrainVertex* row0 = &vertices[iz * stride + ix];
+    const TerrainVertex* row1 = row0 + stride;
+    auto blend = [&](unsigned char Color::*channel) {
+        float top = row0[0].albedo.*channel + (row0[1].albedo.*channel - row0[0].albedo.*channel) * tx;
+        float bottom = row1[0].albedo.*channel + (row1[1].albedo.*channel - row1[0].albedo.*channel) * tx;
+        return static_cast<unsigned char>(top + (bottom - top) * tz + 0.5f);
+    };
+    return { blend(&Color::r), blend(&Color::g), blend(&Color::b), 255 };
+}
+
+void Terrain::bakeVertexAttributes(TerrainVertex* target, size_t begin, size_t end) const {
+    for (size_t i = begin; i < end; ++i) {
+        TerrainVertex& v = target[i];
+        v.steepness = 1.0f - v.normal.y;
+        v.albedo = shadeAlbedo(v.position.x, v.position.z, v.height, v.normal.y);
+    }
+}
+
+Color Terrain::shadeAlbedo(float x, float z, float height, float normalY) const {
     float normalizedHeight = (height - config.baseHeight) / config.maxHeight;
     normalizedHeight = std::clamp(normalizedHeight, 0.0f, 1.0f);
     
-    Vector3D normal = getNormalAt(x, z);
-    float steepness = 1.0f - normal.y;
+    float steepness = 1.0f - normalY;
     
     Color baseColor;
     
@@ -193,7 +765,7 @@ Color Terrain::getColorAt(float x, float z, float height) const {
         };
     }
     
-    float shadowFactor = 0.7f + normal.y * 0.3f;
+    float shadowFactor = 0.7f + normalY * 0.3f;
     baseColor.r = static_cast<unsigned char>(baseColor.r * shadowFactor);
     baseColor.g = static_cast<unsigned char>(baseColor.g * shadowFactor);
     baseColor.b = static_cast<unsigned char>(baseColor.b * shadowFactor);
@@ -201,38 +773,53 @@ Color Terrain::getColorAt(float x, float z, float height) const {
     return baseColor;
 }
 
-void Terrain::calculateNormals() {
+void Terrain::calculateNormals(JobSystem* jobs) {
     int gridSize = config.gridSize;
+    int samples = gridSize + 1;
     
-    for (size_t i = 0; i < vertices.size(); ++i) {
-        vertices[i].normal = Vector3D(0, 0, 0);
-    }
-    
-    for (int z = 0; z < gridSize; ++z) {
-        for (int x = 0; x < gridSize; ++x) {
-            int idx0 = z * (gridSize + 1) + x;
-            int idx1 = idx0 + 1;
-            int idx2 = (z + 1) * (gridSize + 1) + x;
-            int idx3 = idx2 + 1;
-            
-            Vector3D v0 = vertices[idx0].position;
-            Vector3D v1 = vertices[idx1].position;
-            Vector3D v2 = vertices[idx2].position;
-            Vector3D v3 = vertices[idx3].position;
-            
-            Vector3D n1 = (v2 - v0).cross(v1 - v0).normalized();
-            Vector3D n2 = (v1 - v3).cross(v2 - v3).normalized();
-            
-            vertices[idx0].normal += n1;
-            vertices[idx1].normal += n1 + n2;
-            vertices[idx2].normal += n1 + n2;
-            vertices[idx3].normal += n2;
+    // Pass 1: the two triangle normals of every cell
+    std::vector<Vector3D> faceA(static_cast<size_t>(gridSize) * gridSize);
+    std::vector<Vector3D> faceB(faceA.size());
+    forEachRowBand(jobs, gridSize, [&](int begin, int end) {
+        for (int z = begin; z < end; ++z) {
+            for (int x = 0; x < gridSize; ++x) {
+                int idx0 = z * samples + x;
+                int idx1 = idx0 + 1;
+                int idx2 = (z + 1) * samples + x;
+                int idx3 = idx2 + 1;
+                
+                Vector3D v0 = vertices[idx0].position;
+                Vector3D v1 = vertices[idx1].position;
+                Vector3D v2 = vertices[idx2].position;
+                Vector3D v3 = vertices[idx3].position;
+                
+                faceA[z * gridSize + x] = (v2 - v0).cross(v1 - v0).normalized();
+                faceB[z * gridSize + x] = (v1 - v3).cross(v2 - v3).normalized();
+            }
         }
-    }
+    });
     
-    for (auto& vertex : vertices) {
-        vertex.normal = vertex.normal.normalized();
-    }
+    // Pass 2: each vertex gathers its cells (no scatter, so rows never race), summed
+    // in the order the former scatter loop added them: up-left, up, left, own cell
+    forEachRowBand(jobs, samples, [&](int begin, int end) {
+        for (int z = begin; z < end; ++z) {
+            for (int x = 0; x < samples; ++x) {
+                Vector3D sum(0, 0, 0);
+                bool hasLeft = x > 0, hasRight = x < gridSize;
+                if (z > 0) {
+                    size_t up = static_cast<size_t>(z - 1) * gridSize;
+                    if (hasLeft) sum += faceB[up + x - 1];
+                    if (hasRight) sum += faceA[up + x] + faceB[up + x];
+                }
+                if (z < gridSize) {
+                    size_t own = static_cast<size_t>(z) * gridSize;
+                    if (hasLeft) sum += faceA[own + x - 1] + faceB[own + x - 1];
+                    if (hasRight) sum += faceA[own + x];
+                }
+                vertices[z * samples + x].normal = sum.normalized();
+            }
+        }
+    });
 }
 
 void Terrain::generateMountainPeaks() {
@@ -275,6 +862,7 @@ void Terrain::generateMountainPeaks() {
 
 void Terrain::setConfig(const TerrainConfig& cfg) {
     config = cfg;
+    selectLayers();
 }
 
 } // namespace ethereal
@@ -1,15 +1,25 @@
 #pragma once
 #include "raylib.h"
 #include "core/Vector3D.hpp"
+#include "environment/HeightPyramid.hpp"
+#include "utils/FractalNoise.hpp"
 #include "utils/PerlinNoise.hpp"
+#include <cstdint>
+#include <string>
 #include <vector>
 
 namespace ethereal {
 
+class JobSystem;
+
+// Normal, steepness and albedo are static, baked when the vertex is generated;
+// only view-dependent lighting and fog are left for the frame
 struct TerrainVertex {
     Vector3D position;
     Vector3D normal;
     float height;
+    float steepness = 0.0f;                 // 1 - normal.y
+    Color albedo = {255, 255, 255, 255};    // Config palette, slope-shaded
 };
 
 struct TerrainConfig {
@@ -20,9 +30,11 @@ struct TerrainConfig {
     float duneFrequency = 0.025f;
     float mountainPower = 2.5f;
     float duneAmplitude = 15.0f;
-    int mountainOctaves = 5;
+    int mountainOctaves = 5;       // 1..kMaxFractalOctaves
     int duneOctaves = 3;
+    FractalType mountainFractal = FractalType::Fbm;
     float baseHeight = -50.0f;
+    int chunkResolution = 32;   // Tiles along each edge of a streamed chunk
     
     // Colors
     Color sandColorLight = {235, 220, 180, 255};
@@ -35,16 +47,75 @@ struct TerrainConfig {
     float peakThreshold = 0.85f;
 };
 
+// Regular grid of sampled heights with bilinear lookup (fixed patch or streamed chunk)
+struct HeightTile {
+    float originX = 0.0f;
+    float originZ = 0.0f;
+    float spacing = 1.0f;
+    int resolution = 0;             // Cells per edge; heights holds (resolution + 1)^2 samples
+    std::vector<float> heights;     // Row-major, z rows
+
+    bool contains(float x, float z) const;
+    // Caller checks contains()
+    float sample(float x, float z) const;
+};
+
+// Square tile of streamed terrain in world space. Chunk (cx, cz) covers
+// [cx, cx + 1) x [cz, cz + 1) chunk sizes, so neighbours share their edge vertices.
+struct TerrainChunk {
+    int chunkX = 0;
+    int chunkZ = 0;
+    std::vector<TerrainVertex> vertices;
+    std::vector<unsigned int> indices;
+    HeightTile heights;
+    HeightPyramid pyramid;          // Min/max mips of `heights`, for raycasts
+};
+
 class Terrain {
 public:
     Terrain();
     explicit Terrain(const TerrainConfig& config);
 
     void generate(uint32_t seed = 42);
-    void generateChunk(int chunkX, int chunkZ);
+    // Same patch, with rows split across the job system's workers
+    void generate(uint32_t seed, JobSystem& jobs);
+    // Cache file: versioned header keyed by seed + hashConfig(), then the raw
+    // vertex, index and mountain arrays (little-endian, memory-mapped on load)
+    bool saveCache(const std::string& path) const;
+    bool loadCache(const std::string& path, uint32_t seed);
+    // Hash of the fields that shape the generated terrain (colors are excluded)
+    static uint64_t hashConfig(const TerrainConfig& config);
+    // Reseeds the noise without building the fixed patch (for streaming)
+    void reseed(uint32_t seed);
+    // Only reads the noise tables, so workers may build different chunks concurrently
+    void generateChunk(int chunkX, int chunkZ, TerrainChunk& chunk) const;
+    // Chunk cache: one file per chunk in `directory`, named by chunkCacheKey() and
+    // holding the baked vertices; indices, heights and albedos are rebuilt on load.
+    // Loads the chunk when its file matches, otherwise generates and writes it.
+    // Returns true on a cache hit; safe to call from workers for different chunks.
+    bool generateChunkCached(int chunkX, int chunkZ, const std::string& directory, TerrainChunk& chunk) const;
+    bool saveChunkCache(const TerrainChunk& chunk, const std::string& directory) const;
+    bool loadChunkCache(int chunkX, int chunkZ, const std::string& directory, TerrainChunk& chunk) const;
+    // Hash of the noise seed, hashConfig() and the chunk coordinates
+    uint64_t chunkCacheKey(int chunkX, int chunkZ) const;
+    std::string chunkCachePath(int chunkX, int chunkZ, const std::string& directory) const;
+    float getChunkSize() const { return config.chunkResolution * config.tileSize; }
     
+    // Exact procedural height (full noise evaluation)
     float getHeightAt(float x, float z) const;
+    // Exact heights for n arbitrary points, noise evaluated in SIMD batches
+    void getHeightsAt(const float* xs, const float* zs, float* out, size_t n) const;
+    // Heights over the lattice xs[0..width) x zs[0..height), row-major (z rows) into out
+    void getHeightsOnGrid(const float* xs, int width, const float* zs, int height, float* out) const;
     Vector3D getNormalAt(float x, float z) const;
+    
+    // Bilinear lookups in the generated patch; exact evaluation outside it
+    float sampleHeight(float x, float z) const;
+    Vector3D sampleNormal(float x, float z) const;
+    // First ground hit inside the generated patch along the unit `direction`
+    bool raycast(const Vector3D& origin, const Vector3D& direction, float maxDistance, TerrainRayHit& hit) const;
+    // Inside the patch this blends the baked vertex albedos (height is ignored);
+    // outside it the palette is evaluated for the given height
     Color getColorAt(float x, float z, float height) const;
     
     const std::vector<TerrainVertex>& getVertices() const { return vertices; }
@@ -54,6 +125,8 @@ public:
     const TerrainConfig& getConfig() const { return config; }
     
     float getTotalSize() const { return config.gridSize * config.tileSize; }
+    // Bumped by every generate() so GPU copies can tell when to re-upload
+    uint32_t getRevision() const { return revision; }
     
     struct Mountain {
         Vector3D position;
@@ -69,15 +142,35 @@ private:
     PerlinNoise mountainNoise;
     PerlinNoise duneNoise;
     PerlinNoise detailNoise;
+    // Resolved from the config's octave counts and fractal type
+    const FractalKernels* mountainLayer = nullptr;
+    const FractalKernels* duneLayer = nullptr;
     
     std::vector<TerrainVertex> vertices;
     std::vector<unsigned int> indices;
     std::vector<Mountain> mountains;
+    HeightTile patchHeights;
+    HeightPyramid patchPyramid;
+    uint32_t revision = 0;
+    uint32_t patchSeed = 0;
+    uint32_t noiseSeed = 0;
+    bool reseeded = false;          // False while the constructor's fixed noise seeds are in use
     
+    float combineLayers(float mountain, float ridge, float primary, float secondary, float detail,
+                        float x, float z) const;
+    void selectLayers();
     float sampleMountainHeight(float x, float z) const;
     float sampleDuneHeight(float x, float z) const;
-    void calculateNormals();
+    void generatePatch(uint32_t seed, JobSystem* jobs);
+    void calculateNormals(JobSystem* jobs);
+    // Steepness and albedo of vertices [begin, end) from their height and normal
+    void bakeVertexAttributes(TerrainVertex* target, size_t begin, size_t end) const;
+    Color shadeAlbedo(float x, float z, float height, float normalY) const;
+    static void buildGridIndices(int resolution, std::vector<unsigned int>& out, JobSystem* jobs = nullptr);
+    // Indices, height tile and pyramid of a chunk whose vertices are in place
+    void finishChunk(TerrainChunk& chunk) const;
     void generateMountainPeaks();
+    void rebuildPatchHeights();
 };
 
 } // namespace ethereal
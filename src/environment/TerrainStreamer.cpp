@@ -0,0 +1,345 @@
+#include "TerrainStreamer.hpp"
+#include "utils/MemoryTracker.hpp"
+#include "utils/Profiler.hpp"
+#include "entities/FlightController3D.hpp"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <system_error>
+
+namespace ethereal {
+
+TerrainStreamer::TerrainStreamer(const Terrain& terrain, const TerrainStreamConfig& config, JobSystem* jobs)
+    : terrain(terrain)
+    , config(config)
+    , jobs(jobs)
+    , focus(Vector3D::zero()) {}
+
+TerrainStreamer::~TerrainStreamer() {
+    // Workers hold a pointer to this streamer until their chunk is handed over
+    if (jobs) jobs->wait(inFlight);
+}
+
+void TerrainStreamer::update(const FlightController3D& flight) {
+    const Character3D* character = flight.getCharacter();
+    if (!character) return;
+    update(character->getPosition(), character->getVelocity());
+}
+
+void TerrainStreamer::update(const Vector3D& position, const Vector3D& velocity) {
+    PROFILE_SCOPE("TerrainStreamer::update");
+    MEMORY_TAG(Terrain);
+    adoptCompleted();
+
+    const float chunkSize = terrain.getChunkSize();
+    const int radius = std::max(0, config.loadRadius);
+
+    // Lead along the velocity, but keep the player well inside the load radius
+    Vector3D lead(velocity.x, 0.0f, velocity.z);
+    lead *= config.lookAheadTime;
+    float maxLead = radius * chunkSize * 0.5f;
+    if (lead.length() > maxLead) {
+        lead = lead.normalized() * maxLead;
+    }
+    focus = Vector3D(position.x, 0.0f, position.z) + lead;
+
+    const int focusX = static_cast<int>(std::floor(focus.x / chunkSize));
+    const int focusZ = static_cast<int>(std::floor(focus.z / chunkSize));
+
+    // Touch wanted chunks (keeps them at the LRU front) and collect missing ones
+    candidates.clear();
+    for (int dz = -radius; dz <= radius; ++dz) {
+        for (int dx = -radius; dx <= radius; ++dx) {
+            if (dx * dx + dz * dz > radius * radius) continue;
+
+            int chunkX = focusX + dx;
+            int chunkZ = focusZ + dz;
+            int64_t key = chunkKey(chunkX, chunkZ);
+
+            auto it = resident.find(key);
+            if (it != resident.end()) {
+                lru.splice(lru.begin(), lru, it->second.lruPosition);
+                continue;
+            }
+            if (requested.count(key)) continue;
+
+            float centerX = (chunkX + 0.5f) * chunkSize - focus.x;
+            float centerZ = (chunkZ + 0.5f) * chunkSize - focus.z;
+            candidates.push_back({centerX * centerX + centerZ * centerZ, chunkX, chunkZ});
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        return a.distanceSq < b.distanceSq;
+    });
+
+    if (jobs && jobs->getWorkerCount() > 0) {
+        for (const auto& c : candidates) {
+            if (static_cast<int>(requested.size()) >= config.maxJobsInFlight) break;
+            generateAsync(c.chunkX, c.chunkZ);
+        }
+    } else {
+        int budget = config.maxSyncChunksPerUpdate;
+        for (size_t i = 0; i < candidates.size() && budget > 0; ++i, --budget) {
+            auto chunk = std::make_unique<TerrainChunk>();
+            terrain.generateChunk(candidates[i].chunkX, candidates[i].chunkZ, *chunk);
+            adopt(std::move(chunk));
+        }
+    }
+
+    evictOverCapacity();
+    rebuildResidentList();
+}
+
+void TerrainStreamer::prime(const Vector3D& position, int radius) {
+    adoptCompleted();
+
+    const float chunkSize = terrain.getChunkSize();
+    const int centerX = static_cast<int>(std::floor(position.x / chunkSize));
+    const int centerZ = static_cast<int>(std::floor(position.z / chunkSize));
+
+    std::vector<std::unique_ptr<TerrainChunk>> chunks;
+    for (int dz = -radius; dz <= radius; ++dz) {
+        for (int dx = -radius; dx <= radius; ++dx) {
+            int64_t key = chunkKey(centerX + dx, centerZ + dz);
+            if (resident.count(key) || requested.count(key)) continue;
+            chunks.push_back(std::make_unique<TerrainChunk>());
+            chunks.back()->chunkX = centerX + dx;
+            chunks.back()->chunkZ = centerZ + dz;
+        }
+    }
+
+    // A missing directory only turns the cache into plain generation
+    const std::string& cacheDirectory = config.cacheDirectory;
+    if (!cacheDirectory.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(cacheDirectory, error);
+    }
+
+    // One chunk per job; without workers parallelFor runs them inline
+    auto generate = [this, &chunks, &cacheDirectory](size_t begin, size_t end) {
+        MEMORY_TAG(Terrain);
+        for (size_t i = begin; i < end; ++i) {
+            TerrainChunk& chunk = *chunks[i];
+            if (cacheDirectory.empty()) terrain.generateChunk(chunk.chunkX, chunk.chunkZ, chunk);
+            else terrain.generateChunkCached(chunk.chunkX, chunk.chunkZ, cacheDirectory, chunk);
+        }
+    };
+    if (jobs) jobs->parallelFor(chunks.size(), 1, generate);
+    else generate(0, chunks.size());
+
+    for (auto& chunk : chunks) adopt(std::move(chunk));
+
+    focus = Vector3D(position.x, 0.0f, position.z);
+    rebuildResidentList();
+}
+
+float TerrainStreamer::getHeightAt(float x, float z) const {
+    const HeightTile* tile = findTile(x, z);
+    return tile ? tile->sample(x, z) : terrain.getHeightAt(x, z);
+}
+
+Vector3D TerrainStreamer::getNormalAt(float x, float z) const {
+    // Same stencil as Terrain::getNormalAt, on the cached heights
+    float epsilon = terrain.getConfig().tileSize * 0.5f;
+    
+    float hL = getHeightAt(x - epsilon, z);
+    float hR = getHeightAt(x + epsilon, z);
+    float hD = getHeightAt(x, z - epsilon);
+    float hU = getHeightAt(x, z + epsilon);
+    
+    Vector3D normal(hL - hR, 2.0f * epsilon, hD - hU);
+    return normal.normalized();
+}
+
+void TerrainStreamer::getHeightsAt(const float* xs, const float* zs, float* out, size_t n) const {
+    missX.clear();
+    missZ.clear();
+    missIndex.clear();
+
+    for (size_t i = 0; i < n; ++i) {
+        const HeightTile* tile = findTile(xs[i], zs[i]);
+        if (tile) {
+            out[i] = tile->sample(xs[i], zs[i]);
+        } else {
+            missX.push_back(xs[i]);
+            missZ.push_back(zs[i]);
+            missIndex.push_back(i);
+        }
+    }
+
+    if (missIndex.empty()) return;
+    missHeights.resize(missIndex.size());
+    terrain.getHeightsAt(missX.data(), missZ.data(), missHeights.data(), missIndex.size());
+    for (size_t m = 0; m < missIndex.size(); ++m) {
+        out[missIndex[m]] = missHeights[m];
+    }
+}
+
+bool TerrainStreamer::raycast(const Vector3D& origin, const Vector3D& direction, float maxDistance,
+                              TerrainRayHit& hit) const {
+    if (maxDistance <= 0.0f) return false;
+    const float chunkSize = terrain.getChunkSize();
+
+    // 2D DDA over the chunk grid, one [t, tNext] span per chunk crossed
+    int chunkX = static_cast<int>(std::floor(origin.x / chunkSize));
+    int chunkZ = static_cast<int>(std::floor(origin.z / chunkSize));
+    const int stepX = direction.x >= 0.0f ? 1 : -1;
+    const int stepZ = direction.z >= 0.0f ? 1 : -1;
+    const float infinity = std::numeric_limits<float>::infinity();
+    const float deltaX = std::abs(direction.x) > 1e-9f ? chunkSize / std::abs(direction.x) : infinity;
+    const float deltaZ = std::abs(direction.z) > 1e-9f ? chunkSize / std::abs(direction.z) : infinity;
+    float nextX = deltaX == infinity ? infinity
+        : ((chunkX + (stepX > 0 ? 1 : 0)) * chunkSize - origin.x) / direction.x;
+    float nextZ = deltaZ == infinity ? infinity
+        : ((chunkZ + (stepZ > 0 ? 1 : 0)) * chunkSize - origin.z) / direction.z;
+
+    float t = 0.0f;
+    while (t < maxDistance) {
+        float tEnd = std::min(std::min(nextX, nextZ), maxDistance);
+        auto it = resident.find(chunkKey(chunkX, chunkZ));
+        if (it != resident.end()) {
+            const TerrainChunk& chunk = *it->second.chunk;
+            if (chunk.pyramid.raycast(chunk.heights, origin, direction, t, tEnd, hit)) return true;
+        } else if (marchExact(origin, direction, t, tEnd, hit)) {
+            return true;
+        }
+
+        t = tEnd;
+        if (nextX < nextZ) {
+            chunkX += stepX;
+            nextX += deltaX;
+        } else {
+            chunkZ += stepZ;
+            nextZ += deltaZ;
+        }
+    }
+    return false;
+}
+
+bool TerrainStreamer::hasLineOfSight(const Vector3D& from, const Vector3D& to) const {
+    Vector3D delta = to - from;
+    float distance = delta.length();
+    if (distance < 1e-4f) return true;
+    TerrainRayHit hit;
+    return !raycast(from, delta / distance, distance, hit);
+}
+
+bool TerrainStreamer::marchExact(const Vector3D& origin, const Vector3D& direction, float t0, float t1,
+                                 TerrainRayHit& hit) const {
+    const float step = terrain.getConfig().tileSize * 2.0f;
+    float prevT = t0;
+    Vector3D p = origin + direction * t0;
+    float prevGap = p.y - terrain.getHeightAt(p.x, p.z);
+    if (prevGap <= 0.0f) {
+        hit.distance = t0;
+        hit.position = Vector3D(p.x, p.y - prevGap, p.z);
+        hit.normal = terrain.getNormalAt(p.x, p.z);
+        return true;
+    }
+    while (prevT < t1) {
+        float t = std::min(prevT + step, t1);
+        p = origin + direction * t;
+        float gap = p.y - terrain.getHeightAt(p.x, p.z);
+        if (gap <= 0.0f) {
+            // Linear crossing between the two samples
+            float crossing = prevT + (t - prevT) * prevGap / (prevGap - gap);
+            p = origin + direction * crossing;
+            hit.distance = crossing;
+            hit.position = Vector3D(p.x, terrain.getHeightAt(p.x, p.z), p.z);
+            hit.normal = terrain.getNormalAt(p.x, p.z);
+            return true;
+        }
+        prevT = t;
+        prevGap = gap;
+    }
+    return false;
+}
+
+const HeightTile* TerrainStreamer::findTile(float x, float z) const {
+    if (lastTile && lastTile->contains(x, z)) return lastTile;
+
+    const float chunkSize = terrain.getChunkSize();
+    int chunkX = static_cast<int>(std::floor(x / chunkSize));
+    int chunkZ = static_cast<int>(std::floor(z / chunkSize));
+    auto it = resident.find(chunkKey(chunkX, chunkZ));
+    if (it == resident.end()) return nullptr;
+
+    lastTile = &it->second.chunk->heights;
+    return lastTile;
+}
+
+void TerrainStreamer::generateAsync(int chunkX, int chunkZ) {
+    requested.insert(chunkKey(chunkX, chunkZ));
+
+    jobs->run(inFlight, [this, chunkX, chunkZ]() {
+        MEMORY_TAG(Terrain);
+        auto chunk = std::make_unique<TerrainChunk>();
+        terrain.generateChunk(chunkX, chunkZ, *chunk);
+
+        std::lock_guard<std::mutex> lock(completedMutex);
+        completed.push_back(std::move(chunk));
+    });
+}
+
+void TerrainStreamer::adoptCompleted() {
+    std::vector<std::unique_ptr<TerrainChunk>> ready;
+    {
+        std::lock_guard<std::mutex> lock(completedMutex);
+        ready.swap(completed);
+    }
+
+    for (auto& chunk : ready) {
+        requested.erase(chunkKey(chunk->chunkX, chunk->chunkZ));
+        adopt(std::move(chunk));
+    }
+}
+
+void TerrainStreamer::adopt(std::unique_ptr<TerrainChunk> chunk) {
+    int64_t key = chunkKey(chunk->chunkX, chunk->chunkZ);
+    if (resident.count(key)) return;
+
+    lru.push_front(key);
+    Entry entry;
+    entry.chunk = std::move(chunk);
+    entry.lruPosition = lru.begin();
+    resident.emplace(key, std::move(entry));
+}
+
+size_t TerrainStreamer::effectiveCapacity() const {
+    // Never evict below the working set, or wanted chunks would thrash
+    int diameter = 2 * std::max(0, config.loadRadius) + 1;
+    return std::max<size_t>(config.cacheCapacity, static_cast<size_t>(diameter) * diameter);
+}
+
+void TerrainStreamer::evictOverCapacity() {
+    const size_t capacity = effectiveCapacity();
+    while (resident.size() > capacity) {
+        lastTile = nullptr;
+        resident.erase(lru.back());
+        lru.pop_back();
+    }
+}
+
+void TerrainStreamer::rebuildResidentList() {
+    const float chunkSize = terrain.getChunkSize();
+
+    candidates.clear();
+    for (const auto& pair : resident) {
+        const TerrainChunk& chunk = *pair.second.chunk;
+        float centerX = (chunk.chunkX + 0.5f) * chunkSize - focus.x;
+        float centerZ = (chunk.chunkZ + 0.5f) * chunkSize - focus.z;
+        candidates.push_back({centerX * centerX + centerZ * centerZ, chunk.chunkX, chunk.chunkZ});
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        return a.distanceSq < b.distanceSq;
+    });
+
+    residentList.clear();
+    for (const auto& c : candidates) {
+        residentList.push_back(resident.find(chunkKey(c.chunkX, c.chunkZ))->second.chunk.get());
+    }
+}
+
+} // namespace ethereal
@@ -0,0 +1,119 @@
+#pragma once
+#include "core/Vector3D.hpp"
+#include "environment/Terrain.hpp"
+#include "utils/JobSystem.hpp"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace ethereal {
+
+class FlightController3D;
+
+struct TerrainStreamConfig {
+    int loadRadius = 4;             // Chunks kept around the focus point
+    int cacheCapacity = 112;        // Resident chunks before least-recently-wanted eviction
+    float lookAheadTime = 1.5f;     // Seconds of velocity the focus leads the player by
+    int maxJobsInFlight = 4;
+    int maxSyncChunksPerUpdate = 1; // Used when the job system has no workers
+    // Primed chunks are read from and baked into this directory (Terrain::generateChunkCached);
+    // empty generates them every time. Streamed chunks are always generated.
+    std::string cacheDirectory;
+};
+
+// Keeps the chunks around the player resident. Missing chunks are generated on the
+// job system's workers, nearest-to-focus first, and adopted on the next update().
+// The focus leads the player along its velocity so chunks ahead arrive early and the
+// ones falling behind age out of the LRU first.
+class TerrainStreamer {
+public:
+    explicit TerrainStreamer(const Terrain& terrain,
+                             const TerrainStreamConfig& config = TerrainStreamConfig{},
+                             JobSystem* jobs = nullptr);
+    ~TerrainStreamer();
+
+    TerrainStreamer(const TerrainStreamer&) = delete;
+    TerrainStreamer& operator=(const TerrainStreamer&) = delete;
+
+    // Main thread only. Terrain noise must not be reseeded while streaming.
+    void update(const FlightController3D& flight);
+    void update(const Vector3D& position, const Vector3D& velocity);
+    // Blocking generation of the chunks within `radius` of position (startup),
+    // through the chunk cache when one is configured
+    void prime(const Vector3D& position, int radius);
+
+    // === Height queries ===
+    // Bilinear lookups in resident chunk tiles; fall back to the exact procedural height
+    // where no chunk is resident. One querying thread at a time, never during update().
+    float getHeightAt(float x, float z) const;
+    Vector3D getNormalAt(float x, float z) const;
+    // Batched: tile hits are sampled directly, misses are evaluated in one noise batch
+    void getHeightsAt(const float* xs, const float* zs, float* out, size_t n) const;
+
+    // === Ray queries ===
+    // First ground hit along the unit `direction`. Resident chunks answer through
+    // their height pyramids; gaps between them are marched on the exact heights,
+    // two tiles per step. Only reads chunk data, so it may run alongside the one
+    // getHeightAt caller, but never during update().
+    bool raycast(const Vector3D& origin, const Vector3D& direction, float maxDistance, TerrainRayHit& hit) const;
+    bool hasLineOfSight(const Vector3D& from, const Vector3D& to) const;
+
+    // Resident chunks, nearest to the focus first; valid until the next update()
+    const std::vector<const TerrainChunk*>& getResidentChunks() const { return residentList; }
+    bool isResident(int chunkX, int chunkZ) const { return resident.count(chunkKey(chunkX, chunkZ)) > 0; }
+    size_t getPendingCount() const { return requested.size(); }
+    const Vector3D& getFocus() const { return focus; }
+    const Terrain& getTerrain() const { return terrain; }
+
+    static int64_t chunkKey(int chunkX, int chunkZ) {
+        return (static_cast<int64_t>(chunkX) << 32) | static_cast<uint32_t>(chunkZ);
+    }
+
+private:
+    struct Entry {
+        std::unique_ptr<TerrainChunk> chunk;
+        std::list<int64_t>::iterator lruPosition;
+    };
+
+    struct Candidate {
+        float distanceSq;
+        int chunkX;
+        int chunkZ;
+    };
+
+    const Terrain& terrain;
+    TerrainStreamConfig config;
+    JobSystem* jobs;
+    Vector3D focus;
+
+    std::unordered_map<int64_t, Entry> resident;
+    std::list<int64_t> lru;                 // Front = most recently wanted
+    std::unordered_set<int64_t> requested;  // Generating on a worker
+    std::vector<const TerrainChunk*> residentList;
+    std::vector<Candidate> candidates;
+
+    // Probes are spatially coherent, so remember the last tile hit
+    mutable const HeightTile* lastTile = nullptr;
+    mutable std::vector<float> missX, missZ, missHeights;
+    mutable std::vector<size_t> missIndex;
+
+    JobGroup inFlight;
+    std::mutex completedMutex;
+    std::vector<std::unique_ptr<TerrainChunk>> completed;
+
+    void adoptCompleted();
+    void adopt(std::unique_ptr<TerrainChunk> chunk);
+    void generateAsync(int chunkX, int chunkZ);
+    void evictOverCapacity();
+    void rebuildResidentList();
+    size_t effectiveCapacity() const;
+    const HeightTile* findTile(float x, float z) const;
+    bool marchExact(const Vector3D& origin, const Vector3D& direction, float t0, float t1, TerrainRayHit& hit) const;
+};
+
+} // namespace ethereal
@@ -2,19 +2,431 @@
 #include "core/Vector3D.hpp"
 #include "core/Quaternion.hpp"
 #include "physics/WindField3D.hpp"
+#include "physics/WindMap.hpp"
 #include "entities/Character3D.hpp"
 #include "entities/Camera3D.hpp"
 #include "entities/FlightController3D.hpp"
+#include "entities/FlyerCrowd3D.hpp"
 #include "environment/Terrain.hpp"
+#include "environment/TerrainStreamer.hpp"
 #include "rendering/Renderer3D.hpp"
 #include "rendering/EnergyBeingRenderer.hpp"
 #include "rendering/EnvironmentRenderer.hpp"
+#include "rendering/GpuCloth.hpp"
 #include "audio/WindSoundSynthesizer.hpp"
+#include "utils/MemoryTracker.hpp"
 #include "utils/PerformanceMonitor.hpp"
+#include "utils/Profiler.hpp"
+#include "utils/QualityGovernor.hpp"
+#include "utils/JobSystem.hpp"
+#include "utils/SimulationClock.hpp"
+#include "utils/StartupGraph.hpp"
+#include "utils/FramePipeline.hpp"
+#include "utils/FrameArena.hpp"
+#include "utils/InputLog.hpp"
+#include "utils/Telemetry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
 
 using namespace ethereal;
 
-int main() {
+namespace {
+
+const Vector3D kStartPosition(0.0f, 100.0f, 0.0f);
+constexpr size_t kCrowdSize = 240;
+
+struct LaunchOptions {
+    uint32_t seed = 12345;
+    std::string recordPath;         // --record <file>: log this session's input
+    std::string replayPath;         // --replay <file>: rerun a log headless and exit
+    std::string tracePath;          // --trace <file>: Chrome trace of the replay
+    WindSoundEngine audioEngine = WindSoundEngine::Procedural;  // --audio wavetable: low-end devices
+    std::string telemetryTarget;    // --telemetry <ip[:port]>: stream counters to a statsd agent
+    bool gpuClothCheck = false;     // --check gpu-cloth: compare GpuCloth with Cape3D and exit
+};
+
+LaunchOptions parseOptions(int argc, char** argv) {
+    LaunchOptions options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--record") == 0) options.recordPath = argv[i + 1];
+        else if (std::strcmp(argv[i], "--replay") == 0) options.replayPath = argv[i + 1];
+        else if (std::strcmp(argv[i], "--trace") == 0) options.tracePath = argv[i + 1];
+        else if (std::strcmp(argv[i], "--audio") == 0 && std::strcmp(argv[i + 1], "wavetable") == 0) options.audioEngine = WindSoundEngine::Wavetable;
+        else if (std::strcmp(argv[i], "--telemetry") == 0) options.telemetryTarget = argv[i + 1];
+        else if (std::strcmp(argv[i], "--check") == 0 && std::strcmp(argv[i + 1], "gpu-cloth") == 0) options.gpuClothCheck = true;
+        else if (std::strcmp(argv[i], "--seed") == 0) options.seed = static_cast<uint32_t>(std::strtoul(argv[i + 1], nullptr, 10));
+    }
+    return options;
+}
+
+TelemetryConfig makeTelemetryConfig(const std::string& target) {
+    TelemetryConfig config;
+    size_t colon = target.find(':');
+    config.host = target.substr(0, colon);
+    if (colon != std::string::npos) {
+        config.port = static_cast<uint16_t>(std::strtoul(target.c_str() + colon + 1, nullptr, 10));
+    }
+    return config;
+}
+
+WindConfig3D makeWindConfig() {
+    // Wind disabled by default for calm flight
+    WindConfig3D windConfig;
+    windConfig.baseStrength = 0.0f;
+    windConfig.gustStrength = 0.0f;
+    windConfig.turbulence = 0.0f;
+    windConfig.noiseScale = 0.004f;
+    windConfig.timeScale = 0.3f;
+    windConfig.baseDirection = Vector3D(0.0f, 0.0f, 0.0f);
+    windConfig.curlStrength = 0.0f;
+    return windConfig;
+}
+
+CharacterConfig3D makeCharacterConfig() {
+    CharacterConfig3D charConfig;
+    charConfig.radius = 6.0f;
+    charConfig.maxSpeed = 160.0f;
+    charConfig.acceleration = 120.0f;
+    charConfig.drag = 0.985f;
+    charConfig.trailLength = 20;
+    charConfig.rotationSpeed = 5.0f;
+    return charConfig;
+}
+
+FlightConfig3D makeFlightConfig() {
+    // Smooth, responsive flight with mouse controls
+    FlightConfig3D flightConfig;
+    flightConfig.liftForce = 90.0f;
+    flightConfig.diveForce = 40.0f;
+    flightConfig.horizontalForce = 85.0f;
+    flightConfig.glideRatio = 3.5f;
+    flightConfig.windAssist = 0.0f;
+    flightConfig.mouseSensitivity = 0.002f;
+    flightConfig.turnSmoothing = 6.0f;
+    flightConfig.thrustAcceleration = 100.0f;
+    flightConfig.thrustMaxSpeed = 180.0f;
+    flightConfig.climbSensitivity = 0.6f;
+    return flightConfig;
+}
+
+FlyerCrowdConfig3D makeCrowdConfig() {
+    // Companions share the player's body and thrust model, a little slower
+    FlyerCrowdConfig3D crowdConfig;
+    crowdConfig.body = makeCharacterConfig();
+    crowdConfig.body.radius = 2.5f;
+    crowdConfig.flight = makeFlightConfig();
+    crowdConfig.flight.thrustMaxSpeed = 150.0f;
+    crowdConfig.leaderRadius = 90.0f;
+    return crowdConfig;
+}
+
+TerrainConfig makeTerrainConfig() {
+    // Procedural terrain - dramatic mountains with desert sand
+    TerrainConfig terrainConfig;
+    terrainConfig.gridSize = 100;
+    terrainConfig.tileSize = 18.0f;
+    terrainConfig.maxHeight = 350.0f;
+    terrainConfig.mountainFrequency = 0.004f;
+    terrainConfig.duneFrequency = 0.015f;
+    terrainConfig.mountainPower = 2.2f;
+    terrainConfig.duneAmplitude = 18.0f;
+    terrainConfig.mountainOctaves = 6;
+    terrainConfig.duneOctaves = 4;
+    terrainConfig.baseHeight = -80.0f;
+    
+    // Warm sand and cool rock colors
+    terrainConfig.sandColorLight = {245, 230, 200, 255};
+    terrainConfig.sandColorDark = {215, 190, 155, 255};
+    terrainConfig.rockColorLight = {175, 155, 140, 255};
+    terrainConfig.rockColorDark = {110, 95, 85, 255};
+    terrainConfig.peakColor = {255, 250, 245, 255};
+    terrainConfig.rockThreshold = 0.40f;
+    terrainConfig.peakThreshold = 0.78f;
+    return terrainConfig;
+}
+
+TerrainStreamConfig makeTerrainStreamConfig() {
+    // The chunks primed before the first frame are baked here on the first launch
+    TerrainStreamConfig streamConfig;
+    streamConfig.cacheDirectory = "cache/terrain";
+    return streamConfig;
+}
+
+// GpuCloth against the Cape3D step it replaces, in a baked wind grid that both
+// sample the same way. Float differences between the shader and the SIMD path
+// stay far below a particle radius; a damping or step-length mismatch does not.
+int runGpuClothCheck() {
+    WindField3D wind(makeWindConfig());
+    wind.enableGrid(WindGridConfig3D{}, kStartPosition);
+    CapeConfig3D capeConfig;
+    float divergence = GpuCloth::measureDivergence(capeConfig, wind);
+    if (divergence < 0.0f) {
+        TraceLog(LOG_WARNING, "GPUCLOTH: No OpenGL 4.3 compute context, check skipped");
+        return 1;
+    }
+    bool ok = divergence <= capeConfig.particleRadius;
+    TraceLog(ok ? LOG_INFO : LOG_ERROR, "GPUCLOTH: %.4f units from the CPU cape (limit %.2f)", divergence,
+             capeConfig.particleRadius);
+    return ok ? 0 : 1;
+}
+
+// Everything the fixed-step simulation owns. The live game and the headless replay
+// drive it through the same two calls, so a recorded session reruns step for step.
+struct FlightSimulation {
+    WindField3D wind;
+    WindMap windMap;
+    Character3D character;
+    FlightController3D flight;
+    FlyerCrowd3D crowd;
+    Terrain terrain;
+    TerrainStreamer terrainStreamer;
+    JobSystem* jobs;
+    // Physics runs at a fixed 60 Hz whatever the render rate; the drawn
+    // character is interpolated between the last two steps
+    SimulationClock simClock;
+    Vector2 pendingMouse = { 0.0f, 0.0f };
+    Vector2 stepMouse = { 0.0f, 0.0f };
+    // Collide against the analytic heights rather than whichever streamed chunks
+    // the workers have finished, which differs run to run
+    bool deterministicGround = false;
+
+    FlightSimulation(uint32_t seed, JobSystem* jobs)
+        : wind(makeWindConfig())
+        , character(kStartPosition, makeCharacterConfig())
+        , flight(&character, makeFlightConfig())
+        , crowd(makeCrowdConfig())
+        , terrain(makeTerrainConfig())
+        , terrainStreamer(terrain, makeTerrainStreamConfig(), jobs)
+        , jobs(jobs) {
+        // Streaming has not started, so the noise may still be reseeded
+        terrain.reseed(seed);
+
+        // A flock that follows the player around
+        crowd.spawnFlock(kStartPosition + Vector3D(0, 20, 60), 50.0f, kCrowdSize, Vector3D(0, 0, 1));
+        crowd.setGround([this](float x, float z) {
+            return deterministicGround ? terrain.getHeightAt(x, z) : terrainStreamer.getHeightAt(x, z);
+        });
+    }
+
+    // The expensive setup, as independent startup tasks; all must finish before prepare()
+    void addStartupTasks(StartupGraph& startup) {
+        startup.add("wind", [this]() {
+            // Bake the ambient wind around the player; recentered every frame
+            wind.enableGrid(WindGridConfig3D{}, kStartPosition);
+            // Authored wind (tools/wind_map_generator.py); memory-mapped, toggled with F6
+            windMap.open("assets/windmaps/default.wind");
+        });
+        // Only the ground under the start position is generated before the first frame
+        startup.add("terrain", [this]() { terrainStreamer.prime(kStartPosition, 1); });
+    }
+
+    // Main thread, with no simulation in flight. Applies the frame's one-shot input,
+    // advances wind and streaming, and returns how many steps simulate() must run.
+    int prepare(const InputFrame& input) {
+        PROFILE_SCOPE("Frame::prepareSimulation");
+        if (input.has(InputBoost)) flight.boost();
+        if (input.has(InputToggleWindMap) && windMap.isOpen()) {
+            wind.setWindMap(wind.getWindMap() ? nullptr : &windMap);
+        }
+        if (input.has(InputReset)) {
+            character.setPosition(kStartPosition);
+            character.setVelocity(Vector3D::zero());
+        }
+
+        // Mouse motion is consumed by the next simulation step, even if this frame runs none
+        pendingMouse.x += input.mouseDeltaX;
+        pendingMouse.y += input.mouseDeltaY;
+
+        int steps = simClock.advance(input.frameTime);
+        stepMouse = pendingMouse;
+        if (steps > 0) pendingMouse = { 0.0f, 0.0f };
+
+        // Wind and streaming advance here, once per frame, so the worker only reads them
+        wind.setGridCenter(character.getPosition());
+        wind.update(steps * simClock.getStep());
+        terrainStreamer.update(character.getPosition(), character.getVelocity());
+        return steps;
+    }
+
+    // May run on a worker. `previous` ends as the state before the last step.
+    void simulate(int steps, const InputFrame& input, CharacterState3D& previous) {
+        float step = simClock.getStep();
+        for (int i = 0; i < steps; ++i) {
+            previous = character.getState();
+            
+            // Right-click for quick ascent (optional)
+            if (input.has(InputAscending) && flight.getEnergy() > 0) {
+                character.applyForce(Vector3D(0, 120.0f, 0));
+            }
+            
+            // Use mouse-based flight control
+            flight.updateMouseControl(i == 0 ? stepMouse.x : 0.0f, i == 0 ? stepMouse.y : 0.0f,
+                                      input.has(InputFlying), step);
+            flight.update(step, wind);
+            character.update(step);
+            
+            // Ground collision with terrain
+            Vector3D pos = character.getPosition();
+            float ground = deterministicGround ? terrain.getHeightAt(pos.x, pos.z)
+                                               : terrainStreamer.getHeightAt(pos.x, pos.z);
+            float groundHeight = ground + character.getRadius() + 2.0f;
+            if (pos.y < groundHeight) {
+                pos.y = groundHeight;
+                character.setPosition(pos);
+                
+                // Dampen vertical velocity on ground contact
+                Vector3D vel = character.getVelocity();
+                if (vel.y < 0) {
+                    vel.y *= -0.3f;  // Small bounce
+                    character.setVelocity(vel);
+                }
+            }
+
+            crowd.setLeader(character.getPosition());
+            if (jobs) crowd.update(step, wind, *jobs);
+            else crowd.update(step, wind);
+        }
+    }
+
+    // FNV-1a over the state a replay must reproduce exactly
+    uint64_t checksum() const {
+        CharacterState3D state = character.getState();
+        float values[] = { state.position.x, state.position.y, state.position.z,
+                           state.velocity.x, state.velocity.y, state.velocity.z,
+                           state.rotation.w, state.rotation.x, state.rotation.y, state.rotation.z,
+                           flight.getEnergy() };
+        uint64_t hash = 1469598103934665603ull;
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(values);
+        for (size_t i = 0; i < sizeof(values); ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+};
+
+// Everything the render side reads from one simulated frame
+struct SimulationSnapshot {
+    CharacterState3D previous;      // Before the frame's last step
+    CharacterState3D current;
+    float alpha = 0.0f;             // Blend between them
+    TrailBuffer trail;              // Copied ring plus the clock to fade it at
+    float trailTime = 0.0f;
+    FlightSnapshot3D flight;
+    FlyerCrowdSnapshot3D crowd;
+};
+
+// Fills in place: assigning a fresh snapshot would drop the crowd buffers every frame
+void captureSnapshot(SimulationSnapshot& snapshot, const FlightSimulation& sim,
+                     const CharacterState3D& previous, float alpha) {
+    snapshot.previous = previous;
+    snapshot.current = sim.character.getState();
+    snapshot.alpha = alpha;
+    snapshot.trail = sim.character.getTrailBuffer();
+    snapshot.trailTime = sim.character.getTrailTime();
+    snapshot.flight = sim.flight.getSnapshot();
+    sim.crowd.capture(snapshot.crowd);
+}
+
+SimulationSnapshot captureSnapshot(const FlightSimulation& sim, const CharacterState3D& previous, float alpha) {
+    SimulationSnapshot snapshot;
+    captureSnapshot(snapshot, sim, previous, alpha);
+    return snapshot;
+}
+
+void drawLoadingFrame(const StartupGraph& startup, Color background) {
+    const int width = GetScreenWidth();
+    const int height = GetScreenHeight();
+    const int barWidth = width / 3;
+    BeginDrawing();
+    ClearBackground(background);
+    DrawRectangleLines((width - barWidth) / 2, height / 2, barWidth, 6, Fade(WHITE, 0.4f));
+    DrawRectangle((width - barWidth) / 2, height / 2, static_cast<int>(barWidth * startup.getProgress()), 6,
+                  Fade(WHITE, 0.8f));
+    DrawText(TextFormat("Loading %s", startup.getCurrentName().c_str()), (width - barWidth) / 2, height / 2 + 14,
+             14, Fade(WHITE, 0.6f));
+    EndDrawing();
+}
+
+// Headless: reruns a recorded session serially with no window, audio or rendering,
+// and reports simulation cost plus whether the final state matched the recording
+int runReplay(const LaunchOptions& options) {
+    InputLog log;
+    if (!log.load(options.replayPath)) {
+        std::fprintf(stderr, "replay: cannot read %s\n", options.replayPath.c_str());
+        return 1;
+    }
+
+    JobSystem jobs;
+    FlightSimulation sim(log.getSeed(), &jobs);
+    {
+        StartupGraph startup(&jobs);
+        sim.addStartupTasks(startup);
+        startup.wait();
+    }
+    SimulationClockConfig clockConfig;
+    clockConfig.stepRate = log.getStepRate();
+    sim.simClock.setConfig(clockConfig);
+    sim.deterministicGround = true;
+
+    Profiler& profiler = Profiler::instance();
+    if (!options.tracePath.empty()) profiler.beginTrace();
+
+    using Clock = std::chrono::steady_clock;
+    std::vector<double> frameMs;
+    frameMs.reserve(log.size());
+    long long totalSteps = 0;
+    CharacterState3D previous = sim.character.getState();
+    for (const InputFrame& input : log.getFrames()) {
+        Clock::time_point start = Clock::now();
+        int steps = sim.prepare(input);
+        {
+            PROFILE_SCOPE("Frame::simulate");
+            sim.simulate(steps, input, previous);
+        }
+        frameMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        totalSteps += steps;
+        profiler.endFrame();
+    }
+
+    if (!options.tracePath.empty()) profiler.endTrace(options.tracePath);
+
+    double total = 0.0;
+    for (double ms : frameMs) total += ms;
+    std::vector<double> sorted = frameMs;
+    std::sort(sorted.begin(), sorted.end());
+    double p99 = sorted.empty() ? 0.0 : sorted[std::min(sorted.size() - 1, sorted.size() * 99 / 100)];
+    double worst = sorted.empty() ? 0.0 : sorted.back();
+
+    uint64_t checksum = sim.checksum();
+    bool matched = checksum == log.getChecksum();
+    std::printf("replay: %zu frames, %lld steps, seed %u\n", log.size(), totalSteps, log.getSeed());
+    std::printf("replay: %.1f ms total, %.3f ms/frame avg, %.3f p99, %.3f max\n",
+                total, frameMs.empty() ? 0.0 : total / frameMs.size(), p99, worst);
+    std::printf("replay: checksum %016llx %s\n", static_cast<unsigned long long>(checksum),
+                matched ? "matches the recording" : "DIFFERS from the recording");
+    for (const auto& scope : profiler.getScopeStats()) {
+        std::printf("  %*s%-32s %.3f / %.3f / %.3f ms\n", scope.depth * 2, "", scope.name.c_str(),
+                    scope.avgMs, scope.p99Ms, scope.maxMs);
+    }
+    return matched ? 0 : 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    LaunchOptions options = parseOptions(argc, argv);
+    if (!options.replayPath.empty()) return runReplay(options);
+
+    if (!options.telemetryTarget.empty() &&
+        !Telemetry::instance().startExport(makeTelemetryConfig(options.telemetryTarget))) {
+        std::fprintf(stderr, "telemetry: cannot export to %s\n", options.telemetryTarget.c_str());
+    }
+
     RenderConfig3D renderConfig;
     renderConfig.screenWidth = 1280;
     renderConfig.screenHeight = 720;
@@ -36,29 +448,28 @@ int main() {
     Renderer3D renderer(renderConfig);
     renderer.initialize();
 
-    // Wind disabled by default for calm flight
-    WindConfig3D windConfig;
-    windConfig.baseStrength = 0.0f;
-    windConfig.gustStrength = 0.0f;
-    windConfig.turbulence = 0.0f;
-    windConfig.noiseScale = 0.004f;
-    windConfig.timeScale = 0.3f;
-    windConfig.baseDirection = Vector3D(0.0f, 0.0f, 0.0f);
-    windConfig.curlStrength = 0.0f;
-    
-    WindField3D wind(windConfig);
+    // Needs the window's GL context, so unlike --replay it cannot run headless
+    if (options.gpuClothCheck) {
+        int status = runGpuClothCheck();
+        renderer.shutdown();
+        return status;
+    }
 
-    Vector3D startPos(0.0f, 100.0f, 0.0f);
-    
-    CharacterConfig3D charConfig;
-    charConfig.radius = 6.0f;
-    charConfig.maxSpeed = 160.0f;
-    charConfig.acceleration = 120.0f;
-    charConfig.drag = 0.985f;
-    charConfig.trailLength = 20;
-    charConfig.rotationSpeed = 5.0f;
-    
-    Character3D character(startPos, charConfig);
+    // Wind, character, flight and streamed terrain; chunks stream around the
+    // player instead of one fixed patch
+    JobSystem jobs;
+    FlightSimulation sim(options.seed, &jobs);
+    Character3D& character = sim.character;
+    WindField3D& wind = sim.wind;
+    TerrainStreamer& terrainStreamer = sim.terrainStreamer;
+
+    // --record: the input log replays this session headless (--replay) bit for bit
+    InputLog inputLog;
+    bool recording = !options.recordPath.empty();
+    if (recording) {
+        inputLog.begin(options.seed, sim.simClock.getConfig().stepRate);
+        sim.deterministicGround = true;
+    }
 
     // Energy Being renderer (procedural orbs that merge/separate)
     EnergyBeingConfig energyConfig;
@@ -78,7 +489,6 @@ int main() {
     energyConfig.glowIntensity = 0.85f;
     
     EnergyBeingRenderer energyBeing(energyConfig);
-    energyBeing.initialize();
     
     // Environment renderer - NIGHT SCENE
     EnvironmentConfig envConfig;
@@ -100,23 +510,10 @@ int main() {
     envConfig.starBrightness = 0.95f;
     
     EnvironmentRenderer envRenderer(envConfig);
-    envRenderer.initialize();
+    // Renderer3D rebuilds the culler every beginFrame(); terrain feeds it occluders
+    envRenderer.setViewCuller(&renderer.getViewCuller());
+    energyBeing.setViewCuller(&renderer.getViewCuller());
 
-    // Smooth, responsive flight with mouse controls
-    FlightConfig3D flightConfig;
-    flightConfig.liftForce = 90.0f;
-    flightConfig.diveForce = 40.0f;
-    flightConfig.horizontalForce = 85.0f;
-    flightConfig.glideRatio = 3.5f;
-    flightConfig.windAssist = 0.0f;
-    flightConfig.mouseSensitivity = 0.002f;
-    flightConfig.turnSmoothing = 6.0f;
-    flightConfig.thrustAcceleration = 100.0f;
-    flightConfig.thrustMaxSpeed = 180.0f;
-    flightConfig.climbSensitivity = 0.6f;
-    
-    FlightController3D flight(&character, flightConfig);
-    
     // Hide and capture mouse cursor for mouse look
     DisableCursor();
 
@@ -127,32 +524,9 @@ int main() {
     cameraConfig.smoothSpeed = 6.0f;
     cameraConfig.fov = 65.0f;
     
-    FlightCamera camera(startPos + Vector3D(0, 30, 80), startPos, cameraConfig);
-
-    // Procedural terrain - dramatic mountains with desert sand
-    TerrainConfig terrainConfig;
-    terrainConfig.gridSize = 100;
-    terrainConfig.tileSize = 18.0f;
-    terrainConfig.maxHeight = 350.0f;
-    terrainConfig.mountainFrequency = 0.004f;
-    terrainConfig.duneFrequency = 0.015f;
-    terrainConfig.mountainPower = 2.2f;
-    terrainConfig.duneAmplitude = 18.0f;
-    terrainConfig.mountainOctaves = 6;
-    terrainConfig.duneOctaves = 4;
-    terrainConfig.baseHeight = -80.0f;
-    
-    // Warm sand and cool rock colors
-    terrainConfig.sandColorLight = {245, 230, 200, 255};
-    terrainConfig.sandColorDark = {215, 190, 155, 255};
-    terrainConfig.rockColorLight = {175, 155, 140, 255};
-    terrainConfig.rockColorDark = {110, 95, 85, 255};
-    terrainConfig.peakColor = {255, 250, 245, 255};
-    terrainConfig.rockThreshold = 0.40f;
-    terrainConfig.peakThreshold = 0.78f;
-    
-    Terrain terrain(terrainConfig);
-    terrain.generate(12345);
+    FlightCamera camera(kStartPosition + Vector3D(0, 30, 80), kStartPosition, cameraConfig);
+    // Ridges between the player and the camera pull it in instead of hiding the player
+    camera.setTerrain(&terrainStreamer);
 
     // Procedural wind sound synthesizer
     WindSoundConfig windSoundConfig;
@@ -165,28 +539,101 @@ int main() {
     windSoundConfig.windInfluence = 0.5f;
     windSoundConfig.altitudeInfluence = 0.35f;
     windSoundConfig.gustRate = 0.12f;
+    windSoundConfig.spatialVoices = 6;
     
+    // The wavetable loops are baked by the startup task below, not here
     WindSoundSynthesizer windSound(windSoundConfig);
-    windSound.initialize();
+    windSoundConfig.engine = options.audioEngine;
 
+    // Main-thread scratch (terrain mesh builds and the like), recycled every frame
+    FrameArena frameArena(4 * 1024 * 1024);
+    FrameArenaScope frameArenaScope(&frameArena);
     PerformanceMonitor perfMonitor;
+    perfMonitor.setFrameArena(&frameArena);
+
+    // Budgets the governor trades for frame time, least visible first; F4 toggles it
+    QualityGovernor governor;
+    governor.registerKnob("particles", static_cast<float>(renderer.getConfig().particleCount),
+                          60.0f, static_cast<float>(renderer.getConfig().particleCount), 60.0f, 0,
+                          [&renderer](float value) { renderer.setParticleCount(static_cast<int>(value)); });
+    governor.registerKnob("clouds", static_cast<float>(envConfig.cloudsPerLayer),
+                          2.0f, static_cast<float>(envConfig.cloudsPerLayer), 1.0f, 1,
+                          [&envRenderer](float value) {
+                              EnvironmentConfig cfg = envRenderer.getConfig();
+                              cfg.cloudsPerLayer = static_cast<int>(value);
+                              envRenderer.setConfig(cfg);
+                          });
+    governor.registerKnob("stars", static_cast<float>(envConfig.starCount),
+                          100.0f, static_cast<float>(envConfig.starCount), 100.0f, 2,
+                          [&envRenderer](float value) {
+                              EnvironmentConfig cfg = envRenderer.getConfig();
+                              cfg.starCount = static_cast<int>(value);
+                              envRenderer.setConfig(cfg);
+                          });
+    governor.registerKnob("terrainViewDistance", envConfig.terrainViewDistance,
+                          envConfig.terrainViewDistance * 0.5f, envConfig.terrainViewDistance,
+                          envConfig.terrainViewDistance * 0.1f, 3,
+                          [&envRenderer](float value) {
+                              EnvironmentConfig cfg = envRenderer.getConfig();
+                              cfg.terrainViewDistance = value;
+                              envRenderer.setConfig(cfg);
+                          });
+
+    // CPU setup runs on the workers while loading frames draw; device and GPU
+    // steps follow on the main thread as each task completes
+    StartupGraph startup(&jobs);
+    sim.addStartupTasks(startup);
+    startup.add("environment", [&envRenderer, &energyBeing]() {
+        // The only GetRandomValue() caller while loading, so the sequence is unchanged
+        envRenderer.initialize();
+        energyBeing.initialize();
+    });
+    startup.add("audio", [&windSound, &windSoundConfig]() { windSound.setConfig(windSoundConfig); },
+                [&windSound]() { windSound.initialize(); });
+    while (!startup.poll() && !renderer.shouldClose()) {
+        drawLoadingFrame(startup, envConfig.skyColorZenith);
+    }
+    startup.wait();
+    // Through raylib's log, like the window and device messages around it
+    TraceLog(LOG_INFO, "STARTUP: %.1f ms from window to first frame", startup.getElapsedMs());
+    for (int i = 0; i < static_cast<int>(startup.getTaskCount()); ++i) {
+        TraceLog(LOG_INFO, "STARTUP:     > %-12s %.1f ms + %.1f ms on the main thread", startup.getTaskName(i).c_str(),
+                 startup.getWorkMs(i), startup.getFinishMs(i));
+    }
+
     float time = 0.0f;
     bool showWindDebug = false;
 
+
+    // Frame N+1 simulates on a worker while frame N renders from its snapshot
+    FramePipeline<SimulationSnapshot> pipeline(&jobs);
+    pipeline.reset(captureSnapshot(sim, character.getState(), 0.0f));
+
     while (!renderer.shouldClose()) {
         perfMonitor.beginFrame();
         
-        float dt = GetFrameTime();
-        dt = std::min(dt, 0.033f);
+        float frameTime = GetFrameTime();
+        float dt = std::min(frameTime, 0.033f);
         time += dt;
 
+        // The simulation launched last frame is done; until launch() below the
+        // main thread owns the simulation
+        {
+            PROFILE_SCOPE("Frame::syncSimulation");
+            pipeline.sync();
+        }
+        const SimulationSnapshot& snapshot = pipeline.front();
+
         // === MOUSE + LEFT-CLICK CONTROLS ===
         // Mouse movement controls direction
         // Left-click (hold) to fly/thrust forward
         // Release to glide naturally
-        
+        InputFrame input;
+        input.frameTime = frameTime;
         Vector2 mouseDelta = GetMouseDelta();
-        bool isFlying = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
+        input.mouseDeltaX = mouseDelta.x;
+        input.mouseDeltaY = mouseDelta.y;
+        if (IsMouseButtonDown(MOUSE_BUTTON_LEFT)) input.buttons |= InputFlying;
         
         // Double-click detection for boost
         static float lastClickTime = 0.0f;
@@ -194,7 +641,7 @@ int main() {
         if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
             float currentTime = GetTime();
             if (currentTime - lastClickTime < 0.3f && wasClicked) {
-                flight.boost();
+                input.buttons |= InputBoost;
                 wasClicked = false;
             } else {
                 wasClicked = true;
@@ -202,10 +649,7 @@ int main() {
             lastClickTime = currentTime;
         }
         
-        // Right-click for quick ascent (optional)
-        if (IsMouseButtonDown(MOUSE_BUTTON_RIGHT) && flight.getEnergy() > 0) {
-            character.applyForce(Vector3D(0, 120.0f, 0));
-        }
+        if (IsMouseButtonDown(MOUSE_BUTTON_RIGHT)) input.buttons |= InputAscending;
         
         if (IsKeyPressed(KEY_V)) {
             showWindDebug = !showWindDebug;
@@ -214,11 +658,16 @@ int main() {
             renderer.setConfig(cfg);
         }
         
-        if (IsKeyPressed(KEY_R)) {
-            character.setPosition(Vector3D(0, 100, 0));
-            character.setVelocity(Vector3D::zero());
+        if (IsKeyPressed(KEY_F3)) {
+            RenderConfig3D cfg = renderer.getConfig();
+            cfg.showFrameGraph = !cfg.showFrameGraph;
+            renderer.setConfig(cfg);
         }
         
+        if (IsKeyPressed(KEY_F4)) governor.setEnabled(!governor.isEnabled());
+        if (IsKeyPressed(KEY_F6)) input.buttons |= InputToggleWindMap;
+        if (IsKeyPressed(KEY_R)) input.buttons |= InputReset;
+        
         if (IsKeyPressed(KEY_M)) {
             windSound.setEnabled(!windSound.isEnabled());
         }
@@ -226,79 +675,120 @@ int main() {
         if (IsKeyPressed(KEY_ESCAPE)) {
             EnableCursor();
         }
-
-        wind.update(dt);
-        
-        // Use mouse-based flight control
-        flight.updateMouseControl(mouseDelta.x, mouseDelta.y, isFlying, dt);
-        flight.update(dt, wind);
-        character.update(dt);
         
-        // Update wind sound based on game state
-        float playerSpeed = character.getSpeed();
-        float windIntensity = wind.getWindAt(character.getPosition()).length();
-        float altitude = character.getPosition().y;
-        windSound.update(dt, playerSpeed, windIntensity, altitude);
-
-        // Ground collision with terrain
-        Vector3D pos = character.getPosition();
-        float groundHeight = terrain.getHeightAt(pos.x, pos.z) + character.getRadius() + 2.0f;
-        if (pos.y < groundHeight) {
-            pos.y = groundHeight;
-            character.setPosition(pos);
-            
-            // Dampen vertical velocity on ground contact
-            Vector3D vel = character.getVelocity();
-            if (vel.y < 0) {
-                vel.y *= -0.3f;  // Small bounce
-                character.setVelocity(vel);
+        // F9 starts/stops a Chrome trace capture (open in chrome://tracing or Perfetto)
+        if (IsKeyPressed(KEY_F9)) {
+            Profiler& profiler = Profiler::instance();
+            if (profiler.isTracing()) {
+                profiler.endTrace("loom_trace.json");
+            } else {
+                profiler.beginTrace();
             }
         }
 
+        if (recording) inputLog.append(input);
+        int steps = sim.prepare(input);
+        float alpha = sim.simClock.getAlpha();
+        if (input.has(InputReset)) {
+            // Teleport: nothing to interpolate from
+            pipeline.reset(captureSnapshot(sim, character.getState(), 0.0f));
+        }
+
+        {
+            PROFILE_SCOPE("Frame::updateAmbience");
+            // Update wind sound based on game state; gusts and vortices are heard from the camera
+            WindListener listener;
+            listener.position = camera.getPosition();
+            listener.forward = camera.getTarget() - camera.getPosition();
+            windSound.update(dt, character.getSpeed(), character.getPosition().y, listener, wind);
+
+            // Update environment
+            envRenderer.update(dt, camera.getPosition(), wind);
+        }
+
+        // With no steps this frame, keep blending across the same pair of states
+        CharacterState3D previous = snapshot.previous;
+
+        pipeline.launch([&sim, steps, alpha, input, previous](SimulationSnapshot& out) mutable {
+            PROFILE_SCOPE("Frame::simulate");
+            sim.simulate(steps, input, previous);
+            captureSnapshot(out, sim, previous, alpha);
+        });
+
+        CharacterState3D renderState = CharacterState3D::interpolate(snapshot.previous, snapshot.current, snapshot.alpha);
+
         // Update energy being
-        energyBeing.update(dt, character);
-        
-        // Update environment
-        envRenderer.update(dt, camera.getPosition(), wind);
+        energyBeing.update(dt, renderState);
 
-        camera.followTarget(character.getPosition(), character.getVelocity(), dt);
+        camera.followTarget(renderState.position, renderState.velocity, dt);
 
-        renderer.beginFrame(camera);
+        {
+            PROFILE_SCOPE("Frame::render");
+            MEMORY_TAG(Rendering);
+            renderer.beginFrame(camera);
         
-        // Use new environment renderer - NIGHT SCENE
-        envRenderer.renderSky(camera, time);
-        envRenderer.renderMoonAndStars(camera, time);
-        envRenderer.renderDistantMountains(camera, time);
-        envRenderer.renderTerrain(terrain, camera);
-        envRenderer.renderAtmosphere(camera, dt);
+            // Use new environment renderer - NIGHT SCENE
+            envRenderer.renderSky(camera, time);
+            envRenderer.renderDistantMountains(camera, time);
+            envRenderer.renderTerrain(terrainStreamer, camera);
+            envRenderer.renderAtmosphere(camera, dt);
         
-        renderer.drawWindField(wind, character.getPosition());
+            renderer.drawWindField(wind, renderState.position);
         
-        // Render energy being (replaces character + cape)
-        BeginMode3D({
-            {camera.getPosition().x, camera.getPosition().y, camera.getPosition().z},
-            {camera.getTarget().x, camera.getTarget().y, camera.getTarget().z},
-            {0, 1, 0}, 65.0f, CAMERA_PERSPECTIVE
-        });
-        energyBeing.render(character);
-        EndMode3D();
+            // Render energy being (replaces character + cape)
+            BeginMode3D({
+                {camera.getPosition().x, camera.getPosition().y, camera.getPosition().z},
+                {camera.getTarget().x, camera.getTarget().y, camera.getTarget().z},
+                {0, 1, 0}, 65.0f, CAMERA_PERSPECTIVE
+            });
+            energyBeing.render(renderState);
+            EndMode3D();
+
+            renderer.drawCrowd(snapshot.crowd, snapshot.alpha);
         
-        renderer.drawUI(flight, perfMonitor, camera);
+            renderer.drawUI(snapshot.flight, perfMonitor, camera);
 
-        if (IsKeyDown(KEY_TAB)) {
-            Vector3D pos = character.getPosition();
-            Vector3D vel = character.getVelocity();
-            DrawText(TextFormat("Pos: %.0f, %.0f, %.0f", pos.x, pos.y, pos.z), 20, 160, 14, WHITE);
-            DrawText(TextFormat("Vel: %.0f, %.0f, %.0f", vel.x, vel.y, vel.z), 20, 180, 14, WHITE);
-            DrawText(TextFormat("Speed: %.0f", character.getSpeed()), 20, 200, 14, WHITE);
-            DrawText(TextFormat("Glide Eff: %.0f%%", flight.getGlideEfficiency() * 100), 20, 220, 14, WHITE);
-        }
+            if (IsKeyDown(KEY_TAB)) {
+                const CharacterState3D& state = snapshot.current;
+                DrawText(TextFormat("Pos: %.0f, %.0f, %.0f", state.position.x, state.position.y, state.position.z), 20, 160, 14, WHITE);
+                DrawText(TextFormat("Vel: %.0f, %.0f, %.0f", state.velocity.x, state.velocity.y, state.velocity.z), 20, 180, 14, WHITE);
+                DrawText(TextFormat("Speed: %.0f", state.velocity.length()), 20, 200, 14, WHITE);
+                DrawText(TextFormat("Glide Eff: %.0f%%", snapshot.flight.glideEfficiency * 100), 20, 220, 14, WHITE);
+                DrawText(pipeline.isPipelined() ? "Sim: pipelined" : "Sim: serial", 20, 240, 14, WHITE);
+                const ViewCuller::Stats& cull = renderer.getViewCuller().getStats();
+                DrawText(TextFormat("Cull: %d tested, %d frustum, %d occluded", cull.tested, cull.frustumCulled,
+                                    cull.occlusionCulled), 20, 255, 12, WHITE);
+                DrawText(TextFormat("Quality: %.0f%% %s (p90 %.1f ms, busy %.1f ms)", governor.getQualityLevel() * 100.0f,
+                                    governor.isEnabled() ? "auto" : "fixed", governor.getWindowFrameMs(),
+                                    governor.getWindowBusyMs()), 20, 270, 12, WHITE);
+            
+                int lineY = 285;
+                for (const auto& scope : perfMonitor.getScopeStats()) {
+                    DrawText(TextFormat("%*s%s  %.2f / %.2f / %.2f ms", scope.depth * 2, "", scope.name.c_str(),
+                                        scope.avgMs, scope.p99Ms, scope.maxMs), 20, lineY, 12, WHITE);
+                    lineY += 14;
+                }
+            }
         
-        renderer.endFrame();
+            // Presenting blocks on vsync; that wait is not frame work
+            perfMonitor.beginWait();
+            renderer.endFrame();
+            perfMonitor.endWait();
+        }
         perfMonitor.endFrame();
+        governor.update(perfMonitor);
     }
 
+    pipeline.sync();
+    if (recording) {
+        inputLog.setChecksum(sim.checksum());
+        if (!inputLog.save(options.recordPath)) {
+            std::fprintf(stderr, "record: cannot write %s\n", options.recordPath.c_str());
+        }
+    }
     windSound.shutdown();
+    envRenderer.shutdown();
     renderer.shutdown();
+    Telemetry::instance().stopExport();
     return 0;
 }
@@ -1,8 +1,25 @@
 #include "Cape3D.hpp"
+#include "core/Simd.hpp"
+#include "utils/JobSystem.hpp"
+#include "utils/MemoryTracker.hpp"
+#include "utils/Profiler.hpp"
+#include "utils/Telemetry.hpp"
+#include <algorithm>
 #include <cmath>
 
 namespace ethereal {
 
+namespace {
+
+// Batches smaller than this are cheaper to solve inline than to dispatch
+constexpr size_t kMinParallelBatch = 256;
+// Capes with fewer particles run the force pass inline
+constexpr size_t kMinParallelForces = 1024;
+// config.damping is the velocity kept per step of this length
+constexpr float kDampingStep = 1.0f / 60.0f;
+
+} // namespace
+
 Cape3D::Cape3D() : Cape3D(Vector3D::zero(), Vector3D(0, 0, -1)) {}
 
 Cape3D::Cape3D(const Vector3D& attachPoint, const Vector3D& forward, const CapeConfig3D& config)
@@ -12,6 +29,8 @@ Cape3D::Cape3D(const Vector3D& attachPoint, const Vector3D& forward, const CapeC
     createParticles(attachPoint, forward);
     createConstraints();
     createBendingConstraints();
+    constraints.build(particles);
+    computeNormals();
 }
 
 int Cape3D::getIndex(int row, int col) const {
@@ -21,6 +40,7 @@ int Cape3D::getIndex(int row, int col) const {
 void Cape3D::createParticles(const Vector3D& attachPoint, const Vector3D& forward) {
     particles.clear();
     particles.reserve(config.segments * config.width);
+    aeroMask.clear();
 
     Vector3D fwd = forward.normalized();
     Vector3D right = Vector3D(0, 1, 0).cross(fwd).normalized();
@@ -29,7 +49,6 @@ void Cape3D::createParticles(const Vector3D& attachPoint, const Vector3D& forwar
     }
     
     float halfWidth = (config.width - 1) * config.widthSpacing * 0.5f;
-
     for (int row = 0; row < config.segments; ++row) {
         for (int col = 0; col < config.width; ++col) {
             Vector3D pos = attachPoint;
@@ -39,166 +58,461 @@ void Cape3D::createParticles(const Vector3D& attachPoint, const Vector3D& forwar
             bool isPinned = (row == 0);
             float mass = 1.0f + row * 0.08f;
             
-            particles.emplace_back(pos, mass, isPinned);
-            particles.back().damping = config.damping;
+            particles.add(pos, mass, isPinned, config.damping, config.particleRadius);
+            bool interior = row > 0 && row < config.segments - 1 && col > 0 && col < config.width - 1;
+            aeroMask.push_back(interior && !isPinned ? 1.0f : 0.0f);
         }
     }
+    viewDirty = true;
 }
 
 void Cape3D::createConstraints() {
     constraints.clear();
+    float diagLen = std::sqrt(config.segmentLength * config.segmentLength +
+                              config.widthSpacing * config.widthSpacing);
 
     for (int row = 0; row < config.segments; ++row) {
         for (int col = 0; col < config.width; ++col) {
             if (row < config.segments - 1) {
-                constraints.emplace_back(
-                    &particles[getIndex(row, col)],
-                    &particles[getIndex(row + 1, col)],
-                    config.segmentLength,
-                    config.stiffness
-                );
+                constraints.addDistance(getIndex(row, col), getIndex(row + 1, col),
+                                        config.segmentLength, config.stiffness);
             }
 
             if (col < config.width - 1) {
-                constraints.emplace_back(
-                    &particles[getIndex(row, col)],
-                    &particles[getIndex(row, col + 1)],
-                    config.widthSpacing,
-                    config.stiffness * 0.9f
-                );
+                constraints.addDistance(getIndex(row, col), getIndex(row, col + 1),
+                                        config.widthSpacing, config.stiffness * 0.9f);
             }
 
             if (row < config.segments - 1 && col < config.width - 1) {
-                float diagLen = std::sqrt(config.segmentLength * config.segmentLength + 
-                                         config.widthSpacing * config.widthSpacing);
-                constraints.emplace_back(
-                    &particles[getIndex(row, col)],
-                    &particles[getIndex(row + 1, col + 1)],
-                    diagLen,
-                    config.stiffness * 0.5f
-                );
+                constraints.addDistance(getIndex(row, col), getIndex(row + 1, col + 1),
+                                        diagLen, config.stiffness * 0.5f, ClothConstraintGroup::Shear);
             }
             if (row < config.segments - 1 && col > 0) {
-                float diagLen = std::sqrt(config.segmentLength * config.segmentLength + 
-                                         config.widthSpacing * config.widthSpacing);
-                constraints.emplace_back(
-                    &particles[getIndex(row, col)],
-                    &particles[getIndex(row + 1, col - 1)],
-                    diagLen,
-                    config.stiffness * 0.5f
-                );
+                constraints.addDistance(getIndex(row, col), getIndex(row + 1, col - 1),
+                                        diagLen, config.stiffness * 0.5f, ClothConstraintGroup::Shear);
             }
         }
     }
 }
 
 void Cape3D::createBendingConstraints() {
-    bendConstraints.clear();
-
     for (int row = 0; row < config.segments - 2; ++row) {
         for (int col = 0; col < config.width; ++col) {
-            bendConstraints.emplace_back(
-                &particles[getIndex(row, col)],
-                &particles[getIndex(row + 1, col)],
-                &particles[getIndex(row + 2, col)],
-                config.bendStiffness
-            );
+            constraints.addBend(particles, getIndex(row, col), getIndex(row + 1, col), getIndex(row + 2, col),
+                                config.bendStiffness);
         }
     }
 
     for (int row = 0; row < config.segments; ++row) {
         for (int col = 0; col < config.width - 2; ++col) {
-            bendConstraints.emplace_back(
-                &particles[getIndex(row, col)],
-                &particles[getIndex(row, col + 1)],
-                &particles[getIndex(row, col + 2)],
-                config.bendStiffness * 0.6f
-            );
+            constraints.addBend(particles, getIndex(row, col), getIndex(row, col + 1), getIndex(row, col + 2),
+                                config.bendStiffness * 0.6f);
         }
     }
 }
 
-void Cape3D::applyAerodynamics(float dt, const WindField3D& wind) {
-    for (int row = 1; row < config.segments - 1; ++row) {
-        for (int col = 1; col < config.width - 1; ++col) {
-            auto& particle = particles[getIndex(row, col)];
-            if (particle.pinned) continue;
+// Per-frame constants of the force pass
+struct Cape3D::ForceFrame {
+    float gravity;
+    Vector3D attachVelocity;
+    Vector3D swayAxis;
+    float attachSpeed;
+    float swayPhase;
+};
 
-            Vector3D normal = getNormal(row, col);
-            Vector3D windVel = wind.getWindAt(particle.position);
-            Vector3D relativeVel = windVel - particle.getVelocity();
-            
-            float normalComponent = relativeVel.dot(normal);
-            
-            Vector3D dragForce = normal * (normalComponent * config.aerodynamicDrag * std::abs(normalComponent));
-            particle.applyForce(dragForce);
-            
-            if (normalComponent > 0) {
-                Vector3D liftDir = Vector3D(0, 1, 0) - normal * normal.y;
-                if (liftDir.lengthSquared() > 0.01f) {
-                    liftDir = liftDir.normalized();
-                    float liftMagnitude = normalComponent * normalComponent * config.liftCoefficient;
-                    particle.applyForce(liftDir * liftMagnitude);
-                }
-            }
-        }
+void Cape3D::update(float dt, const WindField3D& wind) {
+    PROFILE_SCOPE("Cape3D::update");
+    MEMORY_TAG(Physics);
+    accumulateForces(dt, wind, nullptr);
+    if (config.solver == ClothSolver3D::XPBD) {
+        pendingStep += dt;
+        return;
     }
+    beginStep(dt);
+    particles.integrate(dt);
+    viewDirty = true;
 }
 
-void Cape3D::update(float dt, const WindField3D& wind) {
-    Vector3D gravity(0.0f, -config.gravity, 0.0f);
+void Cape3D::update(float dt, const WindField3D& wind, JobSystem& jobs) {
+    PROFILE_SCOPE("Cape3D::update");
+    MEMORY_TAG(Physics);
+    accumulateForces(dt, wind, &jobs);
+    if (config.solver == ClothSolver3D::XPBD) {
+        pendingStep += dt;
+        return;
+    }
+    beginStep(dt);
+    particles.integrate(dt);
+    viewDirty = true;
+}
 
-    for (int row = 0; row < config.segments; ++row) {
-        for (int col = 0; col < config.width; ++col) {
-            auto& particle = particles[getIndex(row, col)];
-            if (particle.pinned) continue;
+// Verlet keeps velocity as pos - prev, which only holds for a constant step. When
+// the step changes (ClothWorld LOD intervals, frame-time jitter) rescale it, and
+// re-derive damping so the loss per second stays that of config.damping per 60 Hz step.
+void Cape3D::beginStep(float step) {
+    if (step == lastStep) return;
+    if (lastStep > 0.0f) particles.rescaleVelocities(step / lastStep);
+    float damping = getStepDamping(step);
+    for (size_t i = 0; i < particles.size(); ++i) particles.setDamping(i, damping);
+    lastStep = step;
+}
 
-            // Gravity with mass
-            particle.applyForce(gravity * particle.mass);
+float Cape3D::getStepDamping(float step) const {
+    return std::pow(config.damping, step / kDampingStep);
+}
+
+void Cape3D::accumulateForces(float dt, const WindField3D& wind, JobSystem* jobs) {
+    const size_t count = particles.size();
+    samplePositions.resize(count);
+    windSamples.resize(count);
+
+    ForceFrame frame;
+    frame.gravity = -config.gravity;
+    frame.attachVelocity = attachVelocity;
+    frame.swayAxis = currentForward.cross(Vector3D(0, 1, 0));
+    frame.attachSpeed = attachVelocity.length();
+    frame.swayPhase = dt * 3.0f;
+
+    if (!jobs || jobs->getWorkerCount() == 0 || count < kMinParallelForces) {
+        accumulateForceRows(frame, wind, 0, config.segments);
+        return;
+    }
+    // Rows are independent: each job samples and forces its own slice
+    size_t rowGrain = std::max<size_t>(1, kMinParallelBatch / std::max(1, config.width));
+    jobs->parallelFor(static_cast<size_t>(config.segments), rowGrain, [&](size_t begin, size_t end) {
+        accumulateForceRows(frame, wind, static_cast<int>(begin), static_cast<int>(end));
+    });
+}
 
-            // Wind force increases toward cape end
-            Vector3D windForce = wind.getWindAt(particle.position) * config.windInfluence;
-            float rowFactor = static_cast<float>(row) / config.segments;
-            windForce *= (0.3f + rowFactor * 0.7f);
-            particle.applyForce(windForce);
+// Gravity, wind, billowing, sway, quadratic drag and the pressure/lift model in one
+// pass. Wind is sampled once per particle; pinned particles have zero inverse mass
+// and interior-only terms are masked, so the vector body has no branches.
+void Cape3D::accumulateForceRows(const ForceFrame& frame, const WindField3D& wind, int rowBegin, int rowEnd) {
+    const size_t width = static_cast<size_t>(config.width);
+    const size_t first = rowBegin * width;
+    const size_t last = rowEnd * width;
+
+    const float* px = particles.positionsX();
+    const float* py = particles.positionsY();
+    const float* pz = particles.positionsZ();
+    const float* invMass = particles.inverseMasses();
+    // Pinned particles take no force, so only free ones are sampled: pack them at the
+    // front of this slice, sample, then spread the results back from the end (in place,
+    // since a packed index never exceeds its particle's)
+    size_t sampled = first;
+    for (size_t i = first; i < last; ++i) {
+        if (invMass[i] > 0.0f) samplePositions[sampled++] = Vector3D(px[i], py[i], pz[i]);
+    }
+    wind.getWindAt(samplePositions.data() + first, windSamples.data() + first, sampled - first);
+    for (size_t i = last; i-- > first;) {
+        windSamples[i] = invMass[i] > 0.0f ? windSamples[--sampled] : Vector3D::zero();
+    }
 
-            // Movement-based billowing - cape flows behind when moving
-            Vector3D moveForce = attachVelocity * (-0.08f * rowFactor);
-            particle.applyForce(moveForce);
-            
-            // Subtle lateral sway based on movement
-            float sway = std::sin(row * 0.5f + dt * 3.0f) * attachVelocity.length() * 0.002f;
-            Vector3D swayForce = currentForward.cross(Vector3D(0, 1, 0)) * sway;
-            particle.applyForce(swayForce);
+    const float* qx = particles.previousPositionsX();
+    const float* qy = particles.previousPositionsY();
+    const float* qz = particles.previousPositionsZ();
+    const float* mass = particles.masses();
+    const float* nx = normalX.data();
+    const float* ny = normalY.data();
+    const float* nz = normalZ.data();
+    const float* aero = aeroMask.data();
+    const Vector3D* windVel = windSamples.data();
+    float* ax = particles.accelerationsX();
+    float* ay = particles.accelerationsY();
+    float* az = particles.accelerationsZ();
+    const float drag = config.aerodynamicDrag;
+    const float lift = config.liftCoefficient;
+
+    for (int row = rowBegin; row < rowEnd; ++row) {
+        float rowFactor = static_cast<float>(row) / config.segments;
+        float sway = std::sin(row * 0.5f + frame.swayPhase) * frame.attachSpeed * 0.002f;
+        // Wind force increases toward cape end
+        float windScale = config.windInfluence * (0.3f + rowFactor * 0.7f);
+        // Billowing (cape flows behind when moving) plus subtle lateral sway
+        Vector3D drift = frame.attachVelocity * (-0.08f * rowFactor) + frame.swayAxis * sway;
+
+        size_t i = row * width;
+        const size_t end = i + width;
+#if defined(LOOM_SIMD_SSE)
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 signBit = _mm_set1_ps(-0.0f);
+        const __m128 minSpeed = _mm_set1_ps(0.1f);
+        const __m128 minLift = _mm_set1_ps(0.01f);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 gravity = _mm_set1_ps(frame.gravity);
+        const __m128 scale = _mm_set1_ps(windScale);
+        const __m128 dragCoeff = _mm_set1_ps(drag);
+        const __m128 liftCoeff = _mm_set1_ps(lift);
+        const __m128 airDrag = _mm_set1_ps(-0.0015f);
+        const __m128 driftX = _mm_set1_ps(drift.x);
+        const __m128 driftY = _mm_set1_ps(drift.y);
+        const __m128 driftZ = _mm_set1_ps(drift.z);
+        for (; i + 4 <= end; i += 4) {
+            __m128 vx = _mm_sub_ps(_mm_loadu_ps(px + i), _mm_loadu_ps(qx + i));
+            __m128 vy = _mm_sub_ps(_mm_loadu_ps(py + i), _mm_loadu_ps(qy + i));
+            __m128 vz = _mm_sub_ps(_mm_loadu_ps(pz + i), _mm_loadu_ps(qz + i));
+            __m128 wx = _mm_setr_ps(windVel[i].x, windVel[i + 1].x, windVel[i + 2].x, windVel[i + 3].x);
+            __m128 wy = _mm_setr_ps(windVel[i].y, windVel[i + 1].y, windVel[i + 2].y, windVel[i + 3].y);
+            __m128 wz = _mm_setr_ps(windVel[i].z, windVel[i + 1].z, windVel[i + 2].z, windVel[i + 3].z);
+
+            __m128 fx = _mm_add_ps(_mm_mul_ps(wx, scale), driftX);
+            __m128 fy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(wy, scale), driftY), _mm_mul_ps(gravity, _mm_loadu_ps(mass + i)));
+            __m128 fz = _mm_add_ps(_mm_mul_ps(wz, scale), driftZ);
+
+            // Air resistance, only once the particle is actually moving
+            __m128 speed = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz)));
+            __m128 resist = _mm_and_ps(_mm_cmpgt_ps(speed, minSpeed), _mm_mul_ps(airDrag, speed));
+            fx = _mm_add_ps(fx, _mm_mul_ps(vx, resist));
+            fy = _mm_add_ps(fy, _mm_mul_ps(vy, resist));
+            fz = _mm_add_ps(fz, _mm_mul_ps(vz, resist));
+
+            // Pressure along the normal, and lift when the wind hits the front face
+            __m128 mask = _mm_loadu_ps(aero + i);
+            __m128 nxv = _mm_loadu_ps(nx + i);
+            __m128 nyv = _mm_loadu_ps(ny + i);
+            __m128 nzv = _mm_loadu_ps(nz + i);
+            __m128 normalComponent = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_sub_ps(wx, vx), nxv),
+                                                           _mm_mul_ps(_mm_sub_ps(wy, vy), nyv)),
+                                                _mm_mul_ps(_mm_sub_ps(wz, vz), nzv));
+            __m128 pressure = _mm_mul_ps(_mm_mul_ps(normalComponent, dragCoeff), _mm_andnot_ps(signBit, normalComponent));
+            pressure = _mm_mul_ps(pressure, mask);
+            fx = _mm_add_ps(fx, _mm_mul_ps(nxv, pressure));
+            fy = _mm_add_ps(fy, _mm_mul_ps(nyv, pressure));
+            fz = _mm_add_ps(fz, _mm_mul_ps(nzv, pressure));
+
+            __m128 lx = _mm_sub_ps(zero, _mm_mul_ps(nxv, nyv));
+            __m128 ly = _mm_sub_ps(one, _mm_mul_ps(nyv, nyv));
+            __m128 lz = _mm_sub_ps(zero, _mm_mul_ps(nzv, nyv));
+            __m128 liftLenSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lx, lx), _mm_mul_ps(ly, ly)), _mm_mul_ps(lz, lz));
+            __m128 liftOn = _mm_and_ps(_mm_cmpgt_ps(normalComponent, zero), _mm_cmpgt_ps(liftLenSq, minLift));
+            __m128 liftScale = _mm_div_ps(_mm_mul_ps(_mm_mul_ps(normalComponent, normalComponent), liftCoeff),
+                                          _mm_sqrt_ps(_mm_max_ps(liftLenSq, minLift)));
+            liftScale = _mm_mul_ps(_mm_and_ps(liftOn, liftScale), mask);
+            fx = _mm_add_ps(fx, _mm_mul_ps(lx, liftScale));
+            fy = _mm_add_ps(fy, _mm_mul_ps(ly, liftScale));
+            fz = _mm_add_ps(fz, _mm_mul_ps(lz, liftScale));
+
+            __m128 w = _mm_loadu_ps(invMass + i);
+            _mm_storeu_ps(ax + i, _mm_add_ps(_mm_loadu_ps(ax + i), _mm_mul_ps(fx, w)));
+            _mm_storeu_ps(ay + i, _mm_add_ps(_mm_loadu_ps(ay + i), _mm_mul_ps(fy, w)));
+            _mm_storeu_ps(az + i, _mm_add_ps(_mm_loadu_ps(az + i), _mm_mul_ps(fz, w)));
+        }
+#endif
+        for (; i < end; ++i) {
+            Vector3D vel(px[i] - qx[i], py[i] - qy[i], pz[i] - qz[i]);
+            Vector3D force = windVel[i] * windScale + drift;
+            force.y += frame.gravity * mass[i];
 
             // Air resistance / drag
-            Vector3D vel = particle.getVelocity();
             float speed = vel.length();
-            if (speed > 0.1f) {
-                Vector3D dragForce = vel.normalized() * (-0.15f * speed * speed * 0.01f);
-                particle.applyForce(dragForce);
+            if (speed > 0.1f) force += vel * (-0.0015f * speed);
+
+            if (aero[i] > 0.0f) {
+                Vector3D normal(nx[i], ny[i], nz[i]);
+                float normalComponent = (windVel[i] - vel).dot(normal);
+                force += normal * (normalComponent * drag * std::abs(normalComponent));
+                if (normalComponent > 0) {
+                    Vector3D liftDir = Vector3D(0, 1, 0) - normal * normal.y;
+                    float liftLenSq = liftDir.lengthSquared();
+                    if (liftLenSq > 0.01f) {
+                        force += liftDir * (normalComponent * normalComponent * lift / std::sqrt(liftLenSq));
+                    }
+                }
             }
+
+            ax[i] += force.x * invMass[i];
+            ay[i] += force.y * invMass[i];
+            az[i] += force.z * invMass[i];
         }
     }
+}
 
-    applyAerodynamics(dt, wind);
+void Cape3D::solveConstraints(int iterations) {
+    PROFILE_SCOPE("Cape3D::solveConstraints");
+    if (config.solver == ClothSolver3D::XPBD) {
+        solveSubsteps(nullptr);
+        return;
+    }
+    TELEMETRY_COUNT("cloth.constraintSolves", iterativeSolveCount(iterations));
+    for (int i = 0; i < iterations; ++i) {
+        constraints.solveDistances(particles);
 
-    for (auto& particle : particles) {
-        particle.update(dt);
+        if (i % 2 == 0) {
+            constraints.solveBends(particles);
+        }
     }
+    solveCollisions();
+    computeNormals();
+    viewDirty = true;
 }
 
-void Cape3D::solveConstraints(int iterations) {
-    for (int i = 0; i < iterations; ++i) {
-        for (auto& constraint : constraints) {
-            constraint.solve();
+void Cape3D::solveConstraints(int iterations, JobSystem& jobs) {
+    PROFILE_SCOPE("Cape3D::solveConstraints");
+    if (config.solver == ClothSolver3D::XPBD) {
+        solveSubsteps(&jobs);
+        return;
+    }
+
+    auto solveBatches = [&](const std::vector<ClothConstraintBatch>& batches, bool bending) {
+        for (const ClothConstraintBatch& batch : batches) {
+            size_t count = batch.end - batch.begin;
+            if (!batch.independent || count < kMinParallelBatch) {
+                if (bending) constraints.solveBendRange(particles, batch.begin, batch.end);
+                else constraints.solveDistanceRange(particles, batch.begin, batch.end, batch.independent);
+                continue;
+            }
+            jobs.parallelFor(count, kMinParallelBatch / 4, [&, batch, bending](size_t begin, size_t end) {
+                uint32_t first = batch.begin + static_cast<uint32_t>(begin);
+                uint32_t last = batch.begin + static_cast<uint32_t>(end);
+                if (bending) constraints.solveBendRange(particles, first, last);
+                else constraints.solveDistanceRange(particles, first, last);
+            });
         }
-        
+    };
+
+    TELEMETRY_COUNT("cloth.constraintSolves", iterativeSolveCount(iterations));
+    for (int i = 0; i < iterations; ++i) {
+        solveBatches(constraints.getDistanceBatches(), false);
+
         if (i % 2 == 0) {
-            for (auto& bend : bendConstraints) {
-                bend.solve();
+            solveBatches(constraints.getBendBatches(), true);
+        }
+    }
+    solveCollisions();
+    computeNormals();
+    viewDirty = true;
+}
+
+// Bends run on every other iteration
+size_t Cape3D::iterativeSolveCount(int iterations) const {
+    size_t passes = static_cast<size_t>(std::max(iterations, 0));
+    return passes * constraints.getDistanceCount() + (passes + 1) / 2 * constraints.getBendCount();
+}
+
+void Cape3D::solveSubsteps(JobSystem* jobs) {
+    const int substeps = std::max(1, config.substeps);
+    const float h = pendingStep / substeps;
+    pendingStep = 0.0f;
+    if (h <= 0.0f) return;
+    const float invH2 = 1.0f / (h * h);
+    TELEMETRY_COUNT("cloth.constraintSolves",
+                    substeps * (constraints.getDistanceCount() + constraints.getBendCount()));
+    beginStep(h);
+
+    auto solveBatches = [&](const std::vector<ClothConstraintBatch>& batches, bool bending) {
+        for (const ClothConstraintBatch& batch : batches) {
+            float compliance = bending ? config.bendCompliance
+                             : batch.group == ClothConstraintGroup::Shear ? config.shearCompliance
+                             : config.stretchCompliance;
+            float alpha = compliance * invH2;
+            size_t count = batch.end - batch.begin;
+            if (!jobs || !batch.independent || count < kMinParallelBatch) {
+                if (bending) constraints.solveBendRangeXPBD(particles, batch.begin, batch.end, alpha);
+                else constraints.solveDistanceRangeXPBD(particles, batch.begin, batch.end, alpha);
+                continue;
             }
+            jobs->parallelFor(count, kMinParallelBatch / 4, [&, batch, bending, alpha](size_t begin, size_t end) {
+                uint32_t first = batch.begin + static_cast<uint32_t>(begin);
+                uint32_t last = batch.begin + static_cast<uint32_t>(end);
+                if (bending) constraints.solveBendRangeXPBD(particles, first, last, alpha);
+                else constraints.solveDistanceRangeXPBD(particles, first, last, alpha);
+            });
         }
+    };
+
+    // Forces from update() are held for every substep and cleared by the last
+    for (int s = 0; s < substeps; ++s) {
+        particles.integrate(h, s + 1 < substeps);
+        solveBatches(constraints.getDistanceBatches(), false);
+        solveBatches(constraints.getBendBatches(), true);
+    }
+    solveCollisions();
+    computeNormals();
+    viewDirty = true;
+}
+
+void Cape3D::solveCollisions() {
+    PROFILE_SCOPE("Cape3D::solveCollisions");
+    if (config.selfCollision) collideSelf();
+    if (colliders) {
+        collideBodies();
+        collideGround();
+    }
+    viewDirty = true;
+}
+
+void Cape3D::collideSelf() {
+    const size_t count = particles.size();
+    float* px = particles.positionsX();
+    float* py = particles.positionsY();
+    float* pz = particles.positionsZ();
+    const float* invMass = particles.inverseMasses();
+    const float* radius = particles.radii();
+    
+    float maxRadius = 0.0f;
+    for (size_t i = 0; i < count; ++i) maxRadius = std::max(maxRadius, radius[i]);
+    if (maxRadius <= 0.0f) return;
+    
+    // Rebuilt from this substep's positions; cells span the largest contact distance
+    selfHash.build(px, py, pz, count, maxRadius * 2.0f);
+    
+    const int width = config.width;
+    for (size_t i = 0; i < count; ++i) {
+        int rowI = static_cast<int>(i) / width;
+        int colI = static_cast<int>(i) % width;
+        selfHash.forEachNear(px[i], py[i], pz[i], [&](uint32_t j) {
+            // A repeated j is harmless: once separated the distance test rejects it
+            if (j <= i) return;
+            // Grid neighbours are held apart by their constraints already
+            int rowJ = static_cast<int>(j) / width;
+            int colJ = static_cast<int>(j) % width;
+            if (std::abs(rowJ - rowI) <= 1 && std::abs(colJ - colI) <= 1) return;
+            
+            float w = invMass[i] + invMass[j];
+            if (w <= 0.0f) return;
+            float dx = px[j] - px[i], dy = py[j] - py[i], dz = pz[j] - pz[i];
+            float minDist = radius[i] + radius[j];
+            float distSq = dx * dx + dy * dy + dz * dz;
+            if (distSq >= minDist * minDist || distSq < 1e-12f) return;
+            
+            float dist = std::sqrt(distSq);
+            float push = (minDist - dist) / (dist * w);
+            px[i] -= dx * push * invMass[i]; py[i] -= dy * push * invMass[i]; pz[i] -= dz * push * invMass[i];
+            px[j] += dx * push * invMass[j]; py[j] += dy * push * invMass[j]; pz[j] += dz * push * invMass[j];
+        });
+    }
+}
+
+void Cape3D::collideBodies() {
+    const size_t count = particles.size();
+    for (const CollisionCapsule& capsule : colliders->capsules) {
+        for (size_t i = 0; i < count; ++i) {
+            if (particles.isPinned(i)) continue;
+            Vector3D p = particles.getPosition(i);
+            Vector3D offset = p - capsule.closestPoint(p);
+            float minDist = capsule.radius + particles.getRadius(i);
+            float distSq = offset.lengthSquared();
+            if (distSq >= minDist * minDist) continue;
+            
+            // Dead center: push out along the capsule's side rather than not at all
+            float dist = std::sqrt(distSq);
+            Vector3D normal = dist > 1e-5f ? offset / dist : currentForward * -1.0f;
+            particles.setPosition(i, p + normal * (minDist - dist));
+        }
+    }
+}
+
+void Cape3D::collideGround() {
+    if (!colliders->groundHeights) return;
+    const size_t count = particles.size();
+    groundHeights.resize(count);
+    colliders->groundHeights(particles.positionsX(), particles.positionsZ(), groundHeights.data(), count);
+    
+    float* py = particles.positionsY();
+    const float* radius = particles.radii();
+    for (size_t i = 0; i < count; ++i) {
+        if (particles.isPinned(i)) continue;
+        py[i] = std::max(py[i], groundHeights[i] + radius[i]);
     }
 }
 
@@ -212,56 +526,138 @@ void Cape3D::setAttachPoint(const Vector3D& point, const Vector3D& forward) {
     float halfWidth = (config.width - 1) * config.widthSpacing * 0.5f;
     
     for (int col = 0; col < config.width; ++col) {
-        auto& particle = particles[getIndex(0, col)];
         Vector3D pos = point + right * (col * config.widthSpacing - halfWidth);
-        particle.moveTo(pos);
+        particles.moveTo(getIndex(0, col), pos);
     }
+    viewDirty = true;
 }
 
 void Cape3D::setAttachVelocity(const Vector3D& velocity) {
     attachVelocity = velocity;
     for (int col = 0; col < config.width; ++col) {
-        auto& particle = particles[getIndex(0, col)];
-        particle.setVelocity(velocity * 0.05f);
+        particles.setVelocity(getIndex(0, col), velocity * 0.05f);
     }
+    viewDirty = true;
 }
 
-VerletParticle3D& Cape3D::getParticle(int row, int col) {
-    return particles[getIndex(row, col)];
+const std::vector<VerletParticle3D>& Cape3D::getParticles() const {
+    if (viewDirty) {
+        particleView.resize(particles.size());
+        for (size_t i = 0; i < particles.size(); ++i) {
+            VerletParticle3D& p = particleView[i];
+            p.position = particles.getPosition(i);
+            p.previousPosition = particles.getPreviousPosition(i);
+            p.acceleration = particles.getAcceleration(i);
+            p.mass = particles.getMass(i);
+            p.pinned = particles.isPinned(i);
+            p.damping = particles.getDamping(i);
+            p.radius = particles.getRadius(i);
+        }
+        viewDirty = false;
+    }
+    return particleView;
 }
 
 const VerletParticle3D& Cape3D::getParticle(int row, int col) const {
-    return particles[getIndex(row, col)];
+    return getParticles()[getIndex(row, col)];
+}
+
+Vector3D Cape3D::getParticlePosition(int row, int col) const {
+    return particles.getPosition(getIndex(row, col));
+}
+
+void Cape3D::computeNormals() {
+    const int segments = config.segments;
+    const int width = config.width;
+    const size_t count = particles.size();
+    normalX.resize(count);
+    normalY.resize(count);
+    normalZ.resize(count);
+    const float* px = particles.positionsX();
+    const float* py = particles.positionsY();
+    const float* pz = particles.positionsZ();
+
+    // Central differences across the grid, one-sided along the edges
+    for (int row = 0; row < segments; ++row) {
+        int up = std::max(row - 1, 0) * width;
+        int down = std::min(row + 1, segments - 1) * width;
+        for (int col = 0; col < width; ++col) {
+            int i = row * width + col;
+            int left = row * width + std::max(col - 1, 0);
+            int right = row * width + std::min(col + 1, width - 1);
+
+            float hx = px[right] - px[left], hy = py[right] - py[left], hz = pz[right] - pz[left];
+            float vx = px[down + col] - px[up + col];
+            float vy = py[down + col] - py[up + col];
+            float vz = pz[down + col] - pz[up + col];
+            float nx = hy * vz - hz * vy;
+            float ny = hz * vx - hx * vz;
+            float nz = hx * vy - hy * vx;
+            float len = std::sqrt(nx * nx + ny * ny + nz * nz);
+            float inv = len > 1e-6f ? 1.0f / len : 0.0f;
+            normalX[i] = nx * inv;
+            normalY[i] = ny * inv;
+            normalZ[i] = nz * inv;
+        }
+    }
 }
 
 Vector3D Cape3D::getNormal(int row, int col) const {
     row = std::clamp(row, 1, config.segments - 2);
     col = std::clamp(col, 1, config.width - 2);
-    
-    const Vector3D& center = particles[getIndex(row, col)].position;
-    const Vector3D& up = particles[getIndex(row - 1, col)].position;
-    const Vector3D& down = particles[getIndex(row + 1, col)].position;
-    const Vector3D& left = particles[getIndex(row, col - 1)].position;
-    const Vector3D& right = particles[getIndex(row, col + 1)].position;
-    
-    Vector3D tangentV = (down - up).normalized();
-    Vector3D tangentH = (right - left).normalized();
-    
-    return tangentH.cross(tangentV).normalized();
+    int i = getIndex(row, col);
+    return Vector3D(normalX[i], normalY[i], normalZ[i]);
 }
 
 Vector3D Cape3D::getAverageNormal() const {
-    Vector3D sum = Vector3D::zero();
+    float sx = 0.0f, sy = 0.0f, sz = 0.0f;
     int count = 0;
     
     for (int row = 1; row < config.segments - 1; ++row) {
         for (int col = 1; col < config.width - 1; ++col) {
-            sum += getNormal(row, col);
+            int i = getIndex(row, col);
+            sx += normalX[i];
+            sy += normalY[i];
+            sz += normalZ[i];
             count++;
         }
     }
     
-    return count > 0 ? (sum / static_cast<float>(count)).normalized() : Vector3D(0, 0, 1);
+    return count > 0 ? Vector3D(sx, sy, sz).normalized() : Vector3D(0, 0, 1);
+}
+
+float Cape3D::getKineticEnergy() const {
+    if (lastStep <= 0.0f) return 0.0f;
+    float energy = 0.0f;
+    size_t count = 0;
+    for (size_t i = 0; i < particles.size(); ++i) {
+        if (particles.isPinned(i)) continue;
+        energy += particles.getMass(i) * particles.getVelocity(i).lengthSquared();
+        count++;
+    }
+    if (count == 0) return 0.0f;
+    return 0.5f * energy / (lastStep * lastStep * count);
+}
+
+void Cape3D::loadPositions(const float* xyzw, size_t count) {
+    count = std::min(count, particles.size());
+    for (size_t i = 0; i < count; ++i) {
+        if (particles.isPinned(i)) continue;
+        const float* p = xyzw + i * 4;
+        Vector3D next(p[0], p[1], p[2]);
+        Vector3D moved = next - particles.getPosition(i);
+        particles.setPosition(i, next);
+        particles.setVelocity(i, moved);
+    }
+    computeNormals();
+    viewDirty = true;
+}
+
+void Cape3D::settle() {
+    for (size_t i = 0; i < particles.size(); ++i) {
+        particles.setVelocity(i, Vector3D::zero());
+    }
+    viewDirty = true;
 }
 
 } // namespace ethereal
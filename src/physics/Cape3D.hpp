@@ -1,10 +1,20 @@
 #pragma once
 #include <vector>
 #include "VerletParticle3D.hpp"
+#include "ClothParticles3D.hpp"
+#include "ClothConstraints3D.hpp"
+#include "ClothCollision3D.hpp"
 #include "WindField3D.hpp"
 
 namespace ethereal {
 
+class JobSystem;
+
+enum class ClothSolver3D {
+    Iterative,  // One Verlet step, then `iterations` stiffness-weighted passes
+    XPBD        // `substeps` small steps, one compliance-based pass each
+};
+
 struct CapeConfig3D {
     int segments = 14;
     int width = 10;
@@ -14,9 +24,19 @@ struct CapeConfig3D {
     float bendStiffness = 0.25f;
     float gravity = 25.0f;
     float windInfluence = 1.4f;
-    float damping = 0.985f;
+    float damping = 0.985f;         // Velocity kept per 1/60 s, whatever the step length
     float aerodynamicDrag = 0.02f;
     float liftCoefficient = 0.3f;
+    float particleRadius = 0.5f;    // Collision radius of each cloth particle
+    bool selfCollision = true;
+
+    // XPBD mode ignores the stiffness factors above and the iteration count;
+    // compliance is in units of 1/stiffness, 0 = rigid
+    ClothSolver3D solver = ClothSolver3D::Iterative;
+    int substeps = 8;
+    float stretchCompliance = 0.0f;
+    float shearCompliance = 1e-6f;
+    float bendCompliance = 2e-6f;
 };
 
 class Cape3D {
@@ -24,36 +44,90 @@ public:
     Cape3D();
     Cape3D(const Vector3D& attachPoint, const Vector3D& forward, const CapeConfig3D& config = CapeConfig3D{});
 
+    // In XPBD mode update() only gathers forces; solveConstraints() then runs
+    // all substeps (integrate + project) over the dt given here
     void update(float dt, const WindField3D& wind);
+    // Same, with wind sampling and the force pass split by rows across the job system
+    void update(float dt, const WindField3D& wind, JobSystem& jobs);
     void solveConstraints(int iterations = 5);
+    // Same solve with each color batch split across the job system
+    void solveConstraints(int iterations, JobSystem& jobs);
+    // Body capsules and ground pushed against after every solve; not owned, may be null
+    void setColliders(const ClothColliders3D* colliders) { this->colliders = colliders; }
+    // Self, body and ground contacts; solveConstraints() runs this last
+    void solveCollisions();
     
     void setAttachPoint(const Vector3D& point, const Vector3D& forward);
     void setAttachVelocity(const Vector3D& velocity);
     
-    const std::vector<VerletParticle3D>& getParticles() const { return particles; }
+    // AoS view over the particle store, refreshed lazily after each step
+    const std::vector<VerletParticle3D>& getParticles() const;
+    const ClothParticles3D& getParticleStore() const { return particles; }
+    const ClothConstraints3D& getConstraints() const { return constraints; }
     const CapeConfig3D& getConfig() const { return config; }
     
     int getWidth() const { return config.width; }
     int getSegments() const { return config.segments; }
     
-    VerletParticle3D& getParticle(int row, int col);
     const VerletParticle3D& getParticle(int row, int col) const;
+    Vector3D getParticlePosition(int row, int col) const;
     
+    // Normals come from one shared buffer rebuilt at the end of every solve and
+    // reused by the aerodynamics pass, the renderer and getAverageNormal()
     Vector3D getNormal(int row, int col) const;
     Vector3D getAverageNormal() const;
+    const float* normalsX() const { return normalX.data(); }
+    const float* normalsY() const { return normalY.data(); }
+    const float* normalsZ() const { return normalZ.data(); }
+
+    // Mean 0.5 * m * v^2 over free particles, v measured across the last integrate
+    float getKineticEnergy() const;
+    // dt of the last integrate (one substep in XPBD mode); 0 before the first
+    float getLastStep() const { return lastStep; }
+    // Velocity kept across one integrate of `step` seconds (config.damping is per 1/60 s)
+    float getStepDamping(float step) const;
+    // Zero every particle's velocity, e.g. before the cloth is put to sleep
+    void settle();
+
+    const Vector3D& getAttachVelocity() const { return attachVelocity; }
+    const Vector3D& getForward() const { return currentForward; }
+    // Free-particle positions solved elsewhere (GpuCloth readback, xyz + w per
+    // particle). Stands in for a CPU step: the old positions become the previous
+    // ones, normals are rebuilt and pinned particles are left alone.
+    void loadPositions(const float* xyzw, size_t count);
 
 private:
-    std::vector<VerletParticle3D> particles;
-    std::vector<VerletConstraint3D> constraints;
-    std::vector<BendingConstraint3D> bendConstraints;
+    ClothParticles3D particles;
+    ClothConstraints3D constraints;
+    std::vector<Vector3D> samplePositions;
+    std::vector<Vector3D> windSamples;
+    std::vector<float> aeroMask;    // 1 where the pressure/lift model applies (interior particles)
+    std::vector<float> normalX, normalY, normalZ;
+    mutable std::vector<VerletParticle3D> particleView;
+    mutable bool viewDirty = true;
     CapeConfig3D config;
     Vector3D attachVelocity;
     Vector3D currentForward;
+    float pendingStep = 0.0f;   // XPBD: dt gathered by update(), consumed by the solve
+    float lastStep = 0.0f;      // dt of the last integrate (one substep in XPBD mode)
+    
+    const ClothColliders3D* colliders = nullptr;
+    SpatialHash3D selfHash;
+    std::vector<float> groundHeights;
 
     void createParticles(const Vector3D& attachPoint, const Vector3D& forward);
     void createConstraints();
     void createBendingConstraints();
-    void applyAerodynamics(float dt, const WindField3D& wind);
+    struct ForceFrame;
+    void accumulateForces(float dt, const WindField3D& wind, JobSystem* jobs);
+    void accumulateForceRows(const ForceFrame& frame, const WindField3D& wind, int rowBegin, int rowEnd);
+    void computeNormals();
+    void solveSubsteps(JobSystem* jobs);
+    void beginStep(float step);
+    size_t iterativeSolveCount(int iterations) const;
+    void collideSelf();
+    void collideBodies();
+    void collideGround();
     
     int getIndex(int row, int col) const;
 };
@@ -0,0 +1,46 @@
+#include "ClothCollision3D.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ethereal {
+
+Vector3D CollisionCapsule::closestPoint(const Vector3D& p) const {
+    Vector3D axis = b - a;
+    float lengthSq = axis.lengthSquared();
+    if (lengthSq < 1e-8f) return a;
+    float t = std::clamp((p - a).dot(axis) / lengthSq, 0.0f, 1.0f);
+    return a + axis * t;
+}
+
+void SpatialHash3D::build(const float* xs, const float* ys, const float* zs, size_t count, float cellSize) {
+    inverseCellSize = 1.0f / std::max(cellSize, 1e-4f);
+
+    // Power of two at least twice the point count keeps buckets short
+    size_t tableSize = 1;
+    while (tableSize < count * 2) tableSize <<= 1;
+    tableMask = static_cast<uint32_t>(tableSize - 1);
+
+    cellStart.assign(tableSize + 1, 0);
+    entries.resize(count);
+    pointBucket.resize(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t bucket = hashCell(cellCoord(xs[i]), cellCoord(ys[i]), cellCoord(zs[i]));
+        pointBucket[i] = bucket;
+        cellStart[bucket + 1]++;
+    }
+    for (size_t b = 0; b < tableSize; ++b) {
+        cellStart[b + 1] += cellStart[b];
+    }
+    // Fill each bucket from its end so the offsets settle back onto the starts
+    for (size_t i = count; i-- > 0;) {
+        entries[--cellStart[pointBucket[i] + 1]] = static_cast<uint32_t>(i);
+    }
+    // cellStart[b + 1] now holds bucket b's start; shift the table down by one
+    for (size_t b = 0; b < tableSize; ++b) {
+        cellStart[b] = cellStart[b + 1];
+    }
+    cellStart[tableSize] = static_cast<uint32_t>(count);
+}
+
+} // namespace ethereal
@@ -0,0 +1,71 @@
+#pragma once
+#include "core/Vector3D.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace ethereal {
+
+// Segment a-b swept by a sphere (character bodies, limbs)
+struct CollisionCapsule {
+    Vector3D a;
+    Vector3D b;
+    float radius = 1.0f;
+
+    Vector3D closestPoint(const Vector3D& p) const;
+};
+
+// Everything a cloth collides with besides itself
+struct ClothColliders3D {
+    std::vector<CollisionCapsule> capsules;
+    // Batched ground heights under (xs[i], zs[i]), e.g. TerrainStreamer::getHeightsAt
+    std::function<void(const float* xs, const float* zs, float* out, size_t n)> groundHeights;
+};
+
+// Uniform grid hashed into a table sized to the point count. build() is a counting
+// sort on cell hashes, so both building and neighbour queries are O(n) overall and
+// nothing is allocated once the buffers have grown to the cloth's size.
+class SpatialHash3D {
+public:
+    // cellSize should be at least the largest interaction distance
+    void build(const float* xs, const float* ys, const float* zs, size_t count, float cellSize);
+
+    // Calls fn(index) for every point hashed into the 27 cells around (x, y, z).
+    // Hash collisions can add far points, or repeat a bucket shared by two of the
+    // cells, so callers test the distance and must tolerate seeing a point twice.
+    template <typename Fn>
+    void forEachNear(float x, float y, float z, const Fn& fn) const {
+        if (cellStart.empty()) return;
+        int cx = cellCoord(x), cy = cellCoord(y), cz = cellCoord(z);
+        for (int dz = -1; dz <= 1; ++dz) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    uint32_t bucket = hashCell(cx + dx, cy + dy, cz + dz);
+                    for (uint32_t e = cellStart[bucket]; e < cellStart[bucket + 1]; ++e) {
+                        fn(entries[e]);
+                    }
+                }
+            }
+        }
+    }
+
+    size_t getTableSize() const { return cellStart.empty() ? 0 : cellStart.size() - 1; }
+
+private:
+    float inverseCellSize = 1.0f;
+    uint32_t tableMask = 0;
+    std::vector<uint32_t> cellStart;    // tableSize + 1 prefix offsets into entries
+    std::vector<uint32_t> entries;      // Point indices grouped by bucket
+    std::vector<uint32_t> pointBucket;
+
+    int cellCoord(float v) const { return static_cast<int>(std::floor(v * inverseCellSize)); }
+    uint32_t hashCell(int x, int y, int z) const {
+        uint32_t h = (static_cast<uint32_t>(x) * 92837111u) ^ (static_cast<uint32_t>(y) * 689287499u) ^
+                     (static_cast<uint32_t>(z) * 283923481u);
+        return h & tableMask;
+    }
+};
+
+} // namespace ethereal
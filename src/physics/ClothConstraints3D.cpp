@@ -0,0 +1,426 @@
+#include "ClothConstraints3D.hpp"
+#include "core/Simd.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ethereal {
+
+namespace {
+
+constexpr int kMaxColors = 64;
+
+// Lowest color not set in usedMask, or kMaxColors when all are taken
+int firstFreeColor(uint64_t usedMask) {
+    for (int c = 0; c < kMaxColors; ++c) {
+        if ((usedMask & (uint64_t(1) << c)) == 0) return c;
+    }
+    return kMaxColors;
+}
+
+// Greedy graph coloring of one constraint group. Constraints are bucketed by color;
+// the last bucket holds any that could not be colored and must be solved serially.
+template <typename ParticlesOf>
+std::vector<std::vector<uint32_t>> colorGroup(const std::vector<uint32_t>& members, size_t particleCount,
+                                              ParticlesOf particlesOf) {
+    std::vector<std::vector<uint32_t>> buckets(kMaxColors + 1);
+    std::vector<uint64_t> used(particleCount, 0);
+
+    for (uint32_t index : members) {
+        uint32_t touched[3];
+        int count = particlesOf(index, touched);
+
+        uint64_t mask = 0;
+        for (int k = 0; k < count; ++k) mask |= used[touched[k]];
+
+        int color = firstFreeColor(mask);
+        if (color < kMaxColors) {
+            for (int k = 0; k < count; ++k) used[touched[k]] |= uint64_t(1) << color;
+        }
+        buckets[color].push_back(index);
+    }
+    return buckets;
+}
+
+inline void solveDistanceScalar(float* x, float* y, float* z, uint32_t a, uint32_t b,
+                                float rest, float wA, float wB) {
+    float dx = x[b] - x[a];
+    float dy = y[b] - y[a];
+    float dz = z[b] - z[a];
+    float len = std::sqrt(dx * dx + dy * dy + dz * dz);
+    if (len < 0.0001f) return;
+
+    float diff = (len - rest) / len;
+    float sa = diff * wA;
+    float sb = diff * wB;
+    x[a] += dx * sa; y[a] += dy * sa; z[a] += dz * sa;
+    x[b] -= dx * sb; y[b] -= dy * sb; z[b] -= dz * sb;
+}
+
+} // namespace
+
+void ClothConstraints3D::clear() {
+    pendingDistances.clear();
+    pendingBends.clear();
+    distA.clear(); distB.clear();
+    distRest.clear();
+    distStiffness.clear();
+    weightA.clear(); weightB.clear();
+    bendA.clear(); bendB.clear(); bendC.clear();
+    bendRest.clear();
+    bendStiffness.clear();
+    distanceBatches.clear();
+    bendBatches.clear();
+}
+
+void ClothConstraints3D::addDistance(uint32_t a, uint32_t b, float restLength, float stiffness,
+                                     ClothConstraintGroup group) {
+    pendingDistances.push_back({a, b, restLength, stiffness, group});
+}
+
+void ClothConstraints3D::addBend(const ClothParticles3D& particles, uint32_t a, uint32_t b, uint32_t c,
+                                 float stiffness) {
+    Vector3D ba = particles.getPosition(a) - particles.getPosition(b);
+    Vector3D bc = particles.getPosition(c) - particles.getPosition(b);
+    float dot = ba.normalized().dot(bc.normalized());
+    float restAngle = std::acos(std::clamp(dot, -1.0f, 1.0f));
+    pendingBends.push_back({a, b, c, restAngle, stiffness});
+}
+
+void ClothConstraints3D::build(const ClothParticles3D& particles) {
+    const size_t particleCount = particles.size();
+
+    // === Distance constraints: color structural and shear groups separately ===
+    distA.clear(); distB.clear();
+    distRest.clear();
+    distStiffness.clear();
+    distanceBatches.clear();
+
+    const ClothConstraintGroup distanceGroups[] = { ClothConstraintGroup::Structural, ClothConstraintGroup::Shear };
+    for (ClothConstraintGroup group : distanceGroups) {
+        std::vector<uint32_t> members;
+        for (uint32_t i = 0; i < pendingDistances.size(); ++i) {
+            if (pendingDistances[i].group == group) members.push_back(i);
+        }
+
+        auto buckets = colorGroup(members, particleCount, [this](uint32_t i, uint32_t* out) {
+            out[0] = pendingDistances[i].a;
+            out[1] = pendingDistances[i].b;
+            return 2;
+        });
+
+        for (size_t color = 0; color < buckets.size(); ++color) {
+            if (buckets[color].empty()) continue;
+            ClothConstraintBatch batch;
+            batch.begin = static_cast<uint32_t>(distA.size());
+            batch.group = group;
+            batch.independent = color < kMaxColors;
+            for (uint32_t i : buckets[color]) {
+                const PendingDistance& d = pendingDistances[i];
+                distA.push_back(d.a);
+                distB.push_back(d.b);
+                distRest.push_back(d.restLength);
+                distStiffness.push_back(d.stiffness);
+            }
+            batch.end = static_cast<uint32_t>(distA.size());
+            distanceBatches.push_back(batch);
+        }
+    }
+
+    // === Bending constraints: all three particles count as touched ===
+    bendA.clear(); bendB.clear(); bendC.clear();
+    bendRest.clear();
+    bendStiffness.clear();
+    bendBatches.clear();
+
+    std::vector<uint32_t> bendMembers(pendingBends.size());
+    for (uint32_t i = 0; i < bendMembers.size(); ++i) bendMembers[i] = i;
+
+    auto bendBuckets = colorGroup(bendMembers, particleCount, [this](uint32_t i, uint32_t* out) {
+        out[0] = pendingBends[i].a;
+        out[1] = pendingBends[i].b;
+        out[2] = pendingBends[i].c;
+        return 3;
+    });
+
+    for (size_t color = 0; color < bendBuckets.size(); ++color) {
+        if (bendBuckets[color].empty()) continue;
+        ClothConstraintBatch batch;
+        batch.begin = static_cast<uint32_t>(bendA.size());
+        batch.group = ClothConstraintGroup::Bending;
+        batch.independent = color < kMaxColors;
+        for (uint32_t i : bendBuckets[color]) {
+            const PendingBend& bend = pendingBends[i];
+            bendA.push_back(bend.a);
+            bendB.push_back(bend.b);
+            bendC.push_back(bend.c);
+            bendRest.push_back(bend.restAngle);
+            bendStiffness.push_back(bend.stiffness);
+        }
+        batch.end = static_cast<uint32_t>(bendA.size());
+        bendBatches.push_back(batch);
+    }
+
+    refreshWeights(particles);
+}
+
+void ClothConstraints3D::refreshWeights(const ClothParticles3D& particles) {
+    weightA.resize(distA.size());
+    weightB.resize(distA.size());
+
+    for (size_t i = 0; i < distA.size(); ++i) {
+        uint32_t a = distA[i];
+        uint32_t b = distB[i];
+        float s = distStiffness[i];
+        bool pinnedA = particles.isPinned(a);
+        bool pinnedB = particles.isPinned(b);
+
+        if (!pinnedA && !pinnedB) {
+            // Heavier particles move less
+            float massA = particles.getMass(a);
+            float massB = particles.getMass(b);
+            float totalMass = massA + massB;
+            weightA[i] = 0.5f * s * (massB / totalMass);
+            weightB[i] = 0.5f * s * (massA / totalMass);
+        } else {
+            // A free endpoint takes the full correction
+            weightA[i] = pinnedA ? 0.0f : s;
+            weightB[i] = pinnedB ? 0.0f : s;
+        }
+    }
+}
+
+ClothDistanceView3D ClothConstraints3D::getDistanceView() const {
+    ClothDistanceView3D view;
+    view.a = distA.data();
+    view.b = distB.data();
+    view.restLength = distRest.data();
+    view.weightA = weightA.data();
+    view.weightB = weightB.data();
+    view.count = distA.size();
+    return view;
+}
+
+ClothBendView3D ClothConstraints3D::getBendView() const {
+    ClothBendView3D view;
+    view.a = bendA.data();
+    view.b = bendB.data();
+    view.c = bendC.data();
+    view.restAngle = bendRest.data();
+    view.stiffness = bendStiffness.data();
+    view.count = bendA.size();
+    return view;
+}
+
+void ClothConstraints3D::solveDistances(ClothParticles3D& particles) const {
+    for (const ClothConstraintBatch& batch : distanceBatches) {
+        solveDistanceRange(particles, batch.begin, batch.end, batch.independent);
+    }
+}
+
+void ClothConstraints3D::solveBends(ClothParticles3D& particles) const {
+    for (const ClothConstraintBatch& batch : bendBatches) {
+        solveBendRange(particles, batch.begin, batch.end);
+    }
+}
+
+void ClothConstraints3D::solveDistanceRange(ClothParticles3D& particles, uint32_t begin, uint32_t end,
+                                            bool independent) const {
+    float* x = particles.positionsX();
+    float* y = particles.positionsY();
+    float* z = particles.positionsZ();
+    uint32_t i = begin;
+
+    // Four constraints per step. Lanes are gathered and scattered by index, which is
+    // only safe because a colored range never touches the same particle twice.
+#if defined(LOOM_SIMD_SSE) || defined(LOOM_SIMD_NEON)
+    if (independent) {
+        alignas(16) float ax[4], ay[4], az[4], bx[4], by[4], bz[4];
+        for (; i + 4 <= end; i += 4) {
+            for (int k = 0; k < 4; ++k) {
+                uint32_t a = distA[i + k];
+                uint32_t b = distB[i + k];
+                ax[k] = x[a]; ay[k] = y[a]; az[k] = z[a];
+                bx[k] = x[b]; by[k] = y[b]; bz[k] = z[b];
+            }
+
+#if defined(LOOM_SIMD_SSE)
+            __m128 pax = _mm_load_ps(ax), pay = _mm_load_ps(ay), paz = _mm_load_ps(az);
+            __m128 pbx = _mm_load_ps(bx), pby = _mm_load_ps(by), pbz = _mm_load_ps(bz);
+            __m128 dx = _mm_sub_ps(pbx, pax);
+            __m128 dy = _mm_sub_ps(pby, pay);
+            __m128 dz = _mm_sub_ps(pbz, paz);
+            __m128 lenSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            __m128 len = _mm_sqrt_ps(lenSq);
+            __m128 valid = _mm_cmpge_ps(len, _mm_set1_ps(0.0001f));
+            __m128 safeLen = _mm_max_ps(len, _mm_set1_ps(0.0001f));
+            __m128 diff = _mm_and_ps(valid, _mm_div_ps(_mm_sub_ps(len, _mm_loadu_ps(&distRest[i])), safeLen));
+            __m128 sa = _mm_mul_ps(diff, _mm_loadu_ps(&weightA[i]));
+            __m128 sb = _mm_mul_ps(diff, _mm_loadu_ps(&weightB[i]));
+            _mm_store_ps(ax, _mm_add_ps(pax, _mm_mul_ps(dx, sa)));
+            _mm_store_ps(ay, _mm_add_ps(pay, _mm_mul_ps(dy, sa)));
+            _mm_store_ps(az, _mm_add_ps(paz, _mm_mul_ps(dz, sa)));
+            _mm_store_ps(bx, _mm_sub_ps(pbx, _mm_mul_ps(dx, sb)));
+            _mm_store_ps(by, _mm_sub_ps(pby, _mm_mul_ps(dy, sb)));
+            _mm_store_ps(bz, _mm_sub_ps(pbz, _mm_mul_ps(dz, sb)));
+#else
+            float32x4_t pax = vld1q_f32(ax), pay = vld1q_f32(ay), paz = vld1q_f32(az);
+            float32x4_t pbx = vld1q_f32(bx), pby = vld1q_f32(by), pbz = vld1q_f32(bz);
+            float32x4_t dx = vsubq_f32(pbx, pax);
+            float32x4_t dy = vsubq_f32(pby, pay);
+            float32x4_t dz = vsubq_f32(pbz, paz);
+            float32x4_t lenSq = vmlaq_f32(vmlaq_f32(vmulq_f32(dx, dx), dy, dy), dz, dz);
+            float lenLanes[4], diffLanes[4];
+            vst1q_f32(lenLanes, lenSq);
+            for (int k = 0; k < 4; ++k) {
+                float len = std::sqrt(lenLanes[k]);
+                diffLanes[k] = len < 0.0001f ? 0.0f : (len - distRest[i + k]) / len;
+            }
+            float32x4_t diff = vld1q_f32(diffLanes);
+            float32x4_t sa = vmulq_f32(diff, vld1q_f32(&weightA[i]));
+            float32x4_t sb = vmulq_f32(diff, vld1q_f32(&weightB[i]));
+            vst1q_f32(ax, vmlaq_f32(pax, dx, sa));
+            vst1q_f32(ay, vmlaq_f32(pay, dy, sa));
+            vst1q_f32(az, vmlaq_f32(paz, dz, sa));
+            vst1q_f32(bx, vmlsq_f32(pbx, dx, sb));
+            vst1q_f32(by, vmlsq_f32(pby, dy, sb));
+            vst1q_f32(bz, vmlsq_f32(pbz, dz, sb));
+#endif
+
+            for (int k = 0; k < 4; ++k) {
+                uint32_t a = distA[i + k];
+                uint32_t b = distB[i + k];
+                x[a] = ax[k]; y[a] = ay[k]; z[a] = az[k];
+                x[b] = bx[k]; y[b] = by[k]; z[b] = bz[k];
+            }
+        }
+    }
+#else
+    (void)independent;
+#endif
+
+    for (; i < end; ++i) {
+        solveDistanceScalar(x, y, z, distA[i], distB[i], distRest[i], weightA[i], weightB[i]);
+    }
+}
+
+void ClothConstraints3D::solveBendRange(ClothParticles3D& particles, uint32_t begin, uint32_t end) const {
+    const float* invMass = particles.inverseMasses();
+
+    for (uint32_t i = begin; i < end; ++i) {
+        uint32_t a = bendA[i];
+        uint32_t b = bendB[i];
+        uint32_t c = bendC[i];
+
+        Vector3D pa = particles.getPosition(a);
+        Vector3D pb = particles.getPosition(b);
+        Vector3D pc = particles.getPosition(c);
+
+        Vector3D ba = pa - pb;
+        Vector3D bc = pc - pb;
+
+        float baLen = ba.length();
+        float bcLen = bc.length();
+        if (baLen < 0.001f || bcLen < 0.001f) continue;
+
+        Vector3D baNorm = ba / baLen;
+        Vector3D bcNorm = bc / bcLen;
+
+        float dot = std::clamp(baNorm.dot(bcNorm), -1.0f, 1.0f);
+        float angleDiff = std::acos(dot) - bendRest[i];
+        if (std::abs(angleDiff) < 0.001f) continue;
+
+        Vector3D axis = baNorm.cross(bcNorm);
+        float axisLen = axis.length();
+        if (axisLen < 0.001f) continue;
+        axis = axis / axisLen;
+
+        float correction = angleDiff * bendStiffness[i] * 0.5f;
+
+        if (invMass[a] > 0.0f) {
+            particles.setPosition(a, pa + axis.cross(ba) * correction);
+        }
+        if (invMass[c] > 0.0f) {
+            particles.setPosition(c, pc + axis.cross(bc) * (-correction));
+        }
+    }
+}
+
+void ClothConstraints3D::solveDistancesXPBD(ClothParticles3D& particles, float dt,
+                                            float structuralCompliance, float shearCompliance) const {
+    const float invDt2 = dt > 0.0f ? 1.0f / (dt * dt) : 0.0f;
+    for (const ClothConstraintBatch& batch : distanceBatches) {
+        float compliance = batch.group == ClothConstraintGroup::Shear ? shearCompliance : structuralCompliance;
+        solveDistanceRangeXPBD(particles, batch.begin, batch.end, compliance * invDt2);
+    }
+}
+
+void ClothConstraints3D::solveBendsXPBD(ClothParticles3D& particles, float dt, float compliance) const {
+    const float alpha = dt > 0.0f ? compliance / (dt * dt) : 0.0f;
+    for (const ClothConstraintBatch& batch : bendBatches) {
+        solveBendRangeXPBD(particles, batch.begin, batch.end, alpha);
+    }
+}
+
+void ClothConstraints3D::solveDistanceRangeXPBD(ClothParticles3D& particles, uint32_t begin, uint32_t end,
+                                                float alpha) const {
+    float* x = particles.positionsX();
+    float* y = particles.positionsY();
+    float* z = particles.positionsZ();
+    const float* invMass = particles.inverseMasses();
+
+    for (uint32_t i = begin; i < end; ++i) {
+        uint32_t a = distA[i];
+        uint32_t b = distB[i];
+        float w = invMass[a] + invMass[b] + alpha;
+        if (w <= 0.0f) continue;
+
+        float dx = x[b] - x[a];
+        float dy = y[b] - y[a];
+        float dz = z[b] - z[a];
+        float len = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (len < 0.0001f) continue;
+
+        // dLambda = -C / (wA + wB + alpha); the gradient is the unit direction a -> b
+        float s = (len - distRest[i]) / (len * w);
+        x[a] += dx * s * invMass[a]; y[a] += dy * s * invMass[a]; z[a] += dz * s * invMass[a];
+        x[b] -= dx * s * invMass[b]; y[b] -= dy * s * invMass[b]; z[b] -= dz * s * invMass[b];
+    }
+}
+
+void ClothConstraints3D::solveBendRangeXPBD(ClothParticles3D& particles, uint32_t begin, uint32_t end,
+                                            float alpha) const {
+    float* x = particles.positionsX();
+    float* y = particles.positionsY();
+    float* z = particles.positionsZ();
+    const float* invMass = particles.inverseMasses();
+
+    // Bending as a distance between a and c. The angle gradient is singular for a
+    // straight triple, which rest angles near pi make the common case, so the rest
+    // angle is turned into a rest span from the current arm lengths instead.
+    for (uint32_t i = begin; i < end; ++i) {
+        uint32_t a = bendA[i];
+        uint32_t b = bendB[i];
+        uint32_t c = bendC[i];
+        float w = invMass[a] + invMass[c] + alpha;
+        if (w <= 0.0f) continue;
+
+        float bax = x[a] - x[b], bay = y[a] - y[b], baz = z[a] - z[b];
+        float bcx = x[c] - x[b], bcy = y[c] - y[b], bcz = z[c] - z[b];
+        float baLen = std::sqrt(bax * bax + bay * bay + baz * baz);
+        float bcLen = std::sqrt(bcx * bcx + bcy * bcy + bcz * bcz);
+        float restSq = baLen * baLen + bcLen * bcLen - 2.0f * baLen * bcLen * std::cos(bendRest[i]);
+        float rest = std::sqrt(std::max(restSq, 0.0f));
+
+        float dx = x[c] - x[a];
+        float dy = y[c] - y[a];
+        float dz = z[c] - z[a];
+        float len = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (len < 0.0001f) continue;
+
+        float s = (len - rest) / (len * w);
+        x[a] += dx * s * invMass[a]; y[a] += dy * s * invMass[a]; z[a] += dz * s * invMass[a];
+        x[c] -= dx * s * invMass[c]; y[c] -= dy * s * invMass[c]; z[c] -= dz * s * invMass[c];
+    }
+}
+
+} // namespace ethereal
@@ -0,0 +1,116 @@
+#pragma once
+#include "ClothParticles3D.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace ethereal {
+
+enum class ClothConstraintGroup : uint8_t {
+    Structural,
+    Shear,
+    Bending
+};
+
+// Contiguous range of packed constraints. When `independent` is set no two
+// constraints in the range touch the same particle, so the range may be
+// solved in any order, in SIMD lanes, or split across threads.
+struct ClothConstraintBatch {
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    ClothConstraintGroup group = ClothConstraintGroup::Structural;
+    bool independent = true;
+};
+
+// Read-only views of the packed arrays, in batch order, e.g. for a GPU upload
+struct ClothDistanceView3D {
+    const uint32_t* a = nullptr;
+    const uint32_t* b = nullptr;
+    const float* restLength = nullptr;
+    const float* weightA = nullptr;     // Stiffness already folded in
+    const float* weightB = nullptr;
+    size_t count = 0;
+};
+
+struct ClothBendView3D {
+    const uint32_t* a = nullptr;
+    const uint32_t* b = nullptr;
+    const uint32_t* c = nullptr;
+    const float* restAngle = nullptr;
+    const float* stiffness = nullptr;
+    size_t count = 0;
+};
+
+// Index-based constraint storage for a ClothParticles3D store.
+// Constraints are collected with add*(), then build() graph-colors each group
+// and packs them into structure-of-arrays batches ordered by group and color.
+class ClothConstraints3D {
+public:
+    void clear();
+
+    void addDistance(uint32_t a, uint32_t b, float restLength, float stiffness,
+                     ClothConstraintGroup group = ClothConstraintGroup::Structural);
+    // Rest angle at b is taken from the current particle positions
+    void addBend(const ClothParticles3D& particles, uint32_t a, uint32_t b, uint32_t c, float stiffness);
+
+    void build(const ClothParticles3D& particles);
+    // Recompute per-constraint mass weights after pinning or unpinning particles
+    void refreshWeights(const ClothParticles3D& particles);
+
+    void solveDistances(ClothParticles3D& particles) const;
+    void solveBends(ClothParticles3D& particles) const;
+    // A range may only be vectorized when it lies inside one independent batch
+    void solveDistanceRange(ClothParticles3D& particles, uint32_t begin, uint32_t end,
+                            bool independent = true) const;
+    void solveBendRange(ClothParticles3D& particles, uint32_t begin, uint32_t end) const;
+
+    // XPBD projection for one substep of length dt. Compliance (inverse stiffness,
+    // 0 = rigid) replaces the per-constraint stiffness, so the result no longer
+    // depends on the iteration count. One pass per substep, lambdas start at zero.
+    void solveDistancesXPBD(ClothParticles3D& particles, float dt,
+                            float structuralCompliance, float shearCompliance) const;
+    void solveBendsXPBD(ClothParticles3D& particles, float dt, float compliance) const;
+    // `alpha` is the time-scaled compliance, compliance / dt^2. Bends are solved as
+    // a distance between a and c, so their compliance is in the same units.
+    void solveDistanceRangeXPBD(ClothParticles3D& particles, uint32_t begin, uint32_t end, float alpha) const;
+    void solveBendRangeXPBD(ClothParticles3D& particles, uint32_t begin, uint32_t end, float alpha) const;
+
+    const std::vector<ClothConstraintBatch>& getDistanceBatches() const { return distanceBatches; }
+    const std::vector<ClothConstraintBatch>& getBendBatches() const { return bendBatches; }
+    size_t getDistanceCount() const { return distA.size(); }
+    size_t getBendCount() const { return bendA.size(); }
+    ClothDistanceView3D getDistanceView() const;
+    ClothBendView3D getBendView() const;
+
+private:
+    struct PendingDistance {
+        uint32_t a, b;
+        float restLength;
+        float stiffness;
+        ClothConstraintGroup group;
+    };
+
+    struct PendingBend {
+        uint32_t a, b, c;
+        float restAngle;
+        float stiffness;
+    };
+
+    std::vector<PendingDistance> pendingDistances;
+    std::vector<PendingBend> pendingBends;
+
+    // Packed distance constraints: a += delta * diff * weightA, b -= delta * diff * weightB
+    std::vector<uint32_t> distA, distB;
+    std::vector<float> distRest;
+    std::vector<float> distStiffness;
+    std::vector<float> weightA, weightB;
+
+    // Packed bending constraints (b is read, a and c are moved)
+    std::vector<uint32_t> bendA, bendB, bendC;
+    std::vector<float> bendRest;
+    std::vector<float> bendStiffness;
+
+    std::vector<ClothConstraintBatch> distanceBatches;
+    std::vector<ClothConstraintBatch> bendBatches;
+};
+
+} // namespace ethereal
@@ -0,0 +1,197 @@
+#include "ClothParticles3D.hpp"
+#include <algorithm>
+#include "core/Simd.hpp"
+
+namespace ethereal {
+
+namespace {
+
+// One axis of the Verlet step: p' = p + mask * ((p - q) * damping + a * dt^2), q' = free ? p : q
+inline void integrateAxisScalar(float& p, float& q, float a, float mask, float damp, float dt2) {
+    float velocity = (p - q) * damp;
+    float next = p + mask * (velocity + a * dt2);
+    if (mask > 0.0f) q = p;
+    p = next;
+}
+
+#if defined(LOOM_SIMD_AVX)
+inline void integrateAxis8(float* p, float* q, const float* a, __m256 mask, __m256 sel, __m256 damp, __m256 dt2) {
+    __m256 pos = _mm256_loadu_ps(p);
+    __m256 prev = _mm256_loadu_ps(q);
+    __m256 acc = _mm256_loadu_ps(a);
+    __m256 velocity = _mm256_mul_ps(_mm256_sub_ps(pos, prev), damp);
+    __m256 step = _mm256_add_ps(velocity, _mm256_mul_ps(acc, dt2));
+    _mm256_storeu_ps(p, _mm256_add_ps(pos, _mm256_mul_ps(mask, step)));
+    _mm256_storeu_ps(q, _mm256_blendv_ps(prev, pos, sel));
+}
+#elif defined(LOOM_SIMD_SSE)
+inline void integrateAxis4(float* p, float* q, const float* a, __m128 mask, __m128 sel, __m128 damp, __m128 dt2) {
+    __m128 pos = _mm_loadu_ps(p);
+    __m128 prev = _mm_loadu_ps(q);
+    __m128 acc = _mm_loadu_ps(a);
+    __m128 velocity = _mm_mul_ps(_mm_sub_ps(pos, prev), damp);
+    __m128 step = _mm_add_ps(velocity, _mm_mul_ps(acc, dt2));
+    _mm_storeu_ps(p, _mm_add_ps(pos, _mm_mul_ps(mask, step)));
+    _mm_storeu_ps(q, _mm_or_ps(_mm_and_ps(sel, pos), _mm_andnot_ps(sel, prev)));
+}
+#elif defined(LOOM_SIMD_NEON)
+inline void integrateAxis4(float* p, float* q, const float* a, float32x4_t mask, uint32x4_t sel, float32x4_t damp, float32x4_t dt2) {
+    float32x4_t pos = vld1q_f32(p);
+    float32x4_t prev = vld1q_f32(q);
+    float32x4_t acc = vld1q_f32(a);
+    float32x4_t velocity = vmulq_f32(vsubq_f32(pos, prev), damp);
+    float32x4_t step = vmlaq_f32(velocity, acc, dt2);
+    vst1q_f32(p, vmlaq_f32(pos, mask, step));
+    vst1q_f32(q, vbslq_f32(sel, pos, prev));
+}
+#endif
+
+} // namespace
+
+void ClothParticles3D::clear() {
+    posX.clear(); posY.clear(); posZ.clear();
+    prevX.clear(); prevY.clear(); prevZ.clear();
+    accX.clear(); accY.clear(); accZ.clear();
+    mass.clear();
+    invMass.clear();
+    freeMask.clear();
+    damping.clear();
+    radius.clear();
+    pinned.clear();
+}
+
+void ClothParticles3D::reserve(size_t count) {
+    posX.reserve(count); posY.reserve(count); posZ.reserve(count);
+    prevX.reserve(count); prevY.reserve(count); prevZ.reserve(count);
+    accX.reserve(count); accY.reserve(count); accZ.reserve(count);
+    mass.reserve(count);
+    invMass.reserve(count);
+    freeMask.reserve(count);
+    damping.reserve(count);
+    radius.reserve(count);
+    pinned.reserve(count);
+}
+
+size_t ClothParticles3D::add(const Vector3D& position, float particleMass, bool isPinned, float particleDamping, float particleRadius) {
+    posX.push_back(position.x); posY.push_back(position.y); posZ.push_back(position.z);
+    prevX.push_back(position.x); prevY.push_back(position.y); prevZ.push_back(position.z);
+    accX.push_back(0.0f); accY.push_back(0.0f); accZ.push_back(0.0f);
+    mass.push_back(particleMass);
+    invMass.push_back(isPinned ? 0.0f : 1.0f / particleMass);
+    freeMask.push_back(isPinned ? 0.0f : 1.0f);
+    damping.push_back(particleDamping);
+    radius.push_back(particleRadius);
+    pinned.push_back(isPinned ? 1 : 0);
+    return posX.size() - 1;
+}
+
+Vector3D ClothParticles3D::getVelocity(size_t i) const {
+    return Vector3D(posX[i] - prevX[i], posY[i] - prevY[i], posZ[i] - prevZ[i]);
+}
+
+void ClothParticles3D::setVelocity(size_t i, const Vector3D& vel) {
+    prevX[i] = posX[i] - vel.x;
+    prevY[i] = posY[i] - vel.y;
+    prevZ[i] = posZ[i] - vel.z;
+}
+
+void ClothParticles3D::rescaleVelocities(float ratio) {
+    for (size_t i = 0; i < posX.size(); ++i) {
+        if (pinned[i]) continue;
+        prevX[i] = posX[i] - (posX[i] - prevX[i]) * ratio;
+        prevY[i] = posY[i] - (posY[i] - prevY[i]) * ratio;
+        prevZ[i] = posZ[i] - (posZ[i] - prevZ[i]) * ratio;
+    }
+}
+
+void ClothParticles3D::applyForce(size_t i, const Vector3D& force) {
+    float w = invMass[i];
+    accX[i] += force.x * w;
+    accY[i] += force.y * w;
+    accZ[i] += force.z * w;
+}
+
+void ClothParticles3D::moveTo(size_t i, const Vector3D& position) {
+    if (pinned[i]) {
+        prevX[i] = position.x;
+        prevY[i] = position.y;
+        prevZ[i] = position.z;
+    } else {
+        prevX[i] += position.x - posX[i];
+        prevY[i] += position.y - posY[i];
+        prevZ[i] += position.z - posZ[i];
+    }
+    setPosition(i, position);
+}
+
+void ClothParticles3D::pin(size_t i) {
+    pinned[i] = 1;
+    invMass[i] = 0.0f;
+    freeMask[i] = 0.0f;
+}
+
+void ClothParticles3D::unpin(size_t i) {
+    pinned[i] = 0;
+    invMass[i] = 1.0f / mass[i];
+    freeMask[i] = 1.0f;
+}
+
+void ClothParticles3D::integrate(float dt, bool keepForces) {
+    const size_t count = size();
+    const float dt2 = dt * dt;
+    size_t i = 0;
+
+#if defined(LOOM_SIMD_AVX)
+    const __m256 vdt2 = _mm256_set1_ps(dt2);
+    const __m256 zero = _mm256_setzero_ps();
+    for (; i + 8 <= count; i += 8) {
+        __m256 mask = _mm256_loadu_ps(&freeMask[i]);
+        __m256 sel = _mm256_cmp_ps(mask, zero, _CMP_GT_OQ);
+        __m256 damp = _mm256_loadu_ps(&damping[i]);
+        integrateAxis8(&posX[i], &prevX[i], &accX[i], mask, sel, damp, vdt2);
+        integrateAxis8(&posY[i], &prevY[i], &accY[i], mask, sel, damp, vdt2);
+        integrateAxis8(&posZ[i], &prevZ[i], &accZ[i], mask, sel, damp, vdt2);
+    }
+#elif defined(LOOM_SIMD_SSE)
+    const __m128 vdt2 = _mm_set1_ps(dt2);
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        __m128 mask = _mm_loadu_ps(&freeMask[i]);
+        __m128 sel = _mm_cmpgt_ps(mask, zero);
+        __m128 damp = _mm_loadu_ps(&damping[i]);
+        integrateAxis4(&posX[i], &prevX[i], &accX[i], mask, sel, damp, vdt2);
+        integrateAxis4(&posY[i], &prevY[i], &accY[i], mask, sel, damp, vdt2);
+        integrateAxis4(&posZ[i], &prevZ[i], &accZ[i], mask, sel, damp, vdt2);
+    }
+#elif defined(LOOM_SIMD_NEON)
+    const float32x4_t vdt2 = vdupq_n_f32(dt2);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t mask = vld1q_f32(&freeMask[i]);
+        uint32x4_t sel = vcgtq_f32(mask, zero);
+        float32x4_t damp = vld1q_f32(&damping[i]);
+        integrateAxis4(&posX[i], &prevX[i], &accX[i], mask, sel, damp, vdt2);
+        integrateAxis4(&posY[i], &prevY[i], &accY[i], mask, sel, damp, vdt2);
+        integrateAxis4(&posZ[i], &prevZ[i], &accZ[i], mask, sel, damp, vdt2);
+    }
+#endif
+
+    // Scalar tail (and the whole range when no SIMD backend is available)
+    for (; i < count; ++i) {
+        integrateAxisScalar(posX[i], prevX[i], accX[i], freeMask[i], damping[i], dt2);
+        integrateAxisScalar(posY[i], prevY[i], accY[i], freeMask[i], damping[i], dt2);
+        integrateAxisScalar(posZ[i], prevZ[i], accZ[i], freeMask[i], damping[i], dt2);
+    }
+
+    if (!keepForces) {
+        std::fill(accX.begin(), accX.end(), 0.0f);
+        std::fill(accY.begin(), accY.end(), 0.0f);
+        std::fill(accZ.begin(), accZ.end(), 0.0f);
+    }
+}
+
+const char* ClothParticles3D::simdBackend() {
+    return simdBackendName();
+}
+
+} // namespace ethereal
@@ -0,0 +1,79 @@
+#pragma once
+#include "core/Vector3D.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ethereal {
+
+// Structure-of-arrays particle store for cloth simulation.
+// Every attribute lives in its own contiguous array so the Verlet integrator
+// can advance 4 (SSE/NEON) or 8 (AVX) particles per instruction.
+class ClothParticles3D {
+public:
+    void clear();
+    void reserve(size_t count);
+    size_t add(const Vector3D& position, float mass = 1.0f, bool pinned = false,
+               float damping = 0.99f, float radius = 0.5f);
+    size_t size() const { return posX.size(); }
+
+    Vector3D getPosition(size_t i) const { return Vector3D(posX[i], posY[i], posZ[i]); }
+    Vector3D getPreviousPosition(size_t i) const { return Vector3D(prevX[i], prevY[i], prevZ[i]); }
+    Vector3D getAcceleration(size_t i) const { return Vector3D(accX[i], accY[i], accZ[i]); }
+    Vector3D getVelocity(size_t i) const;
+    void setPosition(size_t i, const Vector3D& p) { posX[i] = p.x; posY[i] = p.y; posZ[i] = p.z; }
+    void setVelocity(size_t i, const Vector3D& vel);
+    // Velocity is stored per step (pos - prev); keeps it when the step length changes
+    void rescaleVelocities(float ratio);
+
+    void applyForce(size_t i, const Vector3D& force);
+    void moveTo(size_t i, const Vector3D& position);
+
+    bool isPinned(size_t i) const { return pinned[i] != 0; }
+    void pin(size_t i);
+    void unpin(size_t i);
+
+    float getMass(size_t i) const { return mass[i]; }
+    float getInverseMass(size_t i) const { return invMass[i]; }
+    float getDamping(size_t i) const { return damping[i]; }
+    float getRadius(size_t i) const { return radius[i]; }
+    void setDamping(size_t i, float d) { damping[i] = d; }
+
+    // Verlet step for all particles; pinned particles stay put. Accumulated forces
+    // are cleared unless keepForces is set (substeps sharing one force evaluation).
+    void integrate(float dt, bool keepForces = false);
+
+    // Raw attribute arrays for batched kernels
+    float* positionsX() { return posX.data(); }
+    float* positionsY() { return posY.data(); }
+    float* positionsZ() { return posZ.data(); }
+    const float* positionsX() const { return posX.data(); }
+    const float* positionsY() const { return posY.data(); }
+    const float* positionsZ() const { return posZ.data(); }
+    const float* previousPositionsX() const { return prevX.data(); }
+    const float* previousPositionsY() const { return prevY.data(); }
+    const float* previousPositionsZ() const { return prevZ.data(); }
+    // Accumulated force * inverse mass, consumed by integrate()
+    float* accelerationsX() { return accX.data(); }
+    float* accelerationsY() { return accY.data(); }
+    float* accelerationsZ() { return accZ.data(); }
+    const float* masses() const { return mass.data(); }
+    const float* inverseMasses() const { return invMass.data(); }
+    const float* radii() const { return radius.data(); }
+
+    // Name of the integrate kernel compiled into this build ("avx", "sse", "neon", "scalar")
+    static const char* simdBackend();
+
+private:
+    std::vector<float> posX, posY, posZ;
+    std::vector<float> prevX, prevY, prevZ;
+    std::vector<float> accX, accY, accZ;
+    std::vector<float> mass;
+    std::vector<float> invMass;     // 0 for pinned particles
+    std::vector<float> freeMask;    // 1 for free particles, 0 for pinned
+    std::vector<float> damping;
+    std::vector<float> radius;
+    std::vector<uint8_t> pinned;
+};
+
+} // namespace ethereal
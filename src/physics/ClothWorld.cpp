@@ -0,0 +1,143 @@
+#include "ClothWorld.hpp"
+#include "utils/JobSystem.hpp"
+#include "utils/MemoryTracker.hpp"
+#include "utils/Profiler.hpp"
+#include <algorithm>
+
+namespace ethereal {
+
+ClothWorld::ClothWorld() : ClothWorld(ClothWorldConfig{}) {}
+
+ClothWorld::ClothWorld(const ClothWorldConfig& config, JobSystem* jobs)
+    : config(config)
+    , jobs(jobs)
+    , viewerPosition(Vector3D::zero())
+    , viewerForward(Vector3D(0, 0, -1)) {}
+
+Cape3D& ClothWorld::addCape(const Vector3D& attachPoint, const Vector3D& forward, const CapeConfig3D& capeConfig) {
+    capes.emplace_back(attachPoint, forward, capeConfig);
+    activity.emplace_back();
+    activity.back().phase = static_cast<unsigned>(capes.size() - 1);
+    return capes.back();
+}
+
+void ClothWorld::clear() {
+    capes.clear();
+    activity.clear();
+    scheduled.clear();
+    sleepingCount = 0;
+}
+
+void ClothWorld::setViewer(const Vector3D& position, const Vector3D& forward) {
+    viewerPosition = position;
+    viewerForward = forward.normalized();
+    hasViewer = true;
+}
+
+void ClothWorld::wake(size_t index) {
+    activity[index].asleep = false;
+    activity[index].restTime = 0.0f;
+}
+
+Vector3D ClothWorld::getAnchor(const Cape3D& cape) const {
+    return cape.getParticlePosition(0, cape.getWidth() / 2);
+}
+
+int ClothWorld::selectLod(const Cape3D& cape) const {
+    if (!hasViewer) return LodFull;
+    Vector3D toCape = getAnchor(cape) - viewerPosition;
+    float distSq = toCape.lengthSquared();
+    if (distSq <= config.lodNearDistance * config.lodNearDistance) return LodFull;
+    if (toCape.dot(viewerForward) < 0.0f) return LodFar;
+    if (distSq <= config.lodFarDistance * config.lodFarDistance) return LodHalf;
+    return LodFar;
+}
+
+void ClothWorld::step(float dt, const WindField3D& wind) {
+    PROFILE_SCOPE("ClothWorld::step");
+    MEMORY_TAG(Physics);
+    schedule(dt, wind);
+    simulate(wind);
+    updateSleep(wind);
+    frame++;
+}
+
+void ClothWorld::schedule(float dt, const WindField3D& wind) {
+    scheduled.clear();
+    sleepingCount = 0;
+
+    for (size_t i = 0; i < capes.size(); ++i) {
+        ClothActivity& state = activity[i];
+        if (state.asleep) {
+            Vector3D windChange = wind.getWindAt(state.sleepAnchor) - state.sleepWind;
+            Vector3D anchorMove = getAnchor(capes[i]) - state.sleepAnchor;
+            bool disturbed = windChange.lengthSquared() > config.wakeWindChange * config.wakeWindChange ||
+                             anchorMove.lengthSquared() > config.wakeAnchorMove * config.wakeAnchorMove;
+            if (!disturbed) {
+                sleepingCount++;
+                continue;
+            }
+            wake(i);
+        }
+
+        // Reduced levels step every 2^lod frames with the skipped time folded in
+        state.lod = selectLod(capes[i]);
+        state.pendingDt += dt;
+        unsigned interval = 1u << state.lod;
+        if ((frame + state.phase) % interval != 0) continue;
+
+        int iterations = std::max(1, config.solverIterations >> state.lod);
+        scheduled.push_back({i, state.pendingDt, iterations});
+        state.pendingDt = 0.0f;
+    }
+}
+
+void ClothWorld::simulate(const WindField3D& wind) {
+    auto stepCape = [&](const ScheduledCape& entry) {
+        Cape3D& cape = capes[entry.index];
+        cape.update(entry.dt, wind);
+        cape.solveConstraints(entry.iterations);
+    };
+
+    if (!jobs || jobs->getWorkerCount() == 0) {
+        for (const ScheduledCape& entry : scheduled) stepCape(entry);
+        return;
+    }
+
+    // Enough capes to keep every thread busy: one task per cape
+    if (scheduled.size() >= jobs->getConcurrency()) {
+        jobs->parallelFor(scheduled.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) stepCape(scheduled[i]);
+        });
+        return;
+    }
+
+    // Few large capes: spread each cape's force rows and constraint colors across the pool instead
+    for (const ScheduledCape& entry : scheduled) {
+        Cape3D& cape = capes[entry.index];
+        cape.update(entry.dt, wind, *jobs);
+        cape.solveConstraints(entry.iterations, *jobs);
+    }
+}
+
+void ClothWorld::updateSleep(const WindField3D& wind) {
+    if (!config.allowSleep) return;
+
+    for (const ScheduledCape& entry : scheduled) {
+        Cape3D& cape = capes[entry.index];
+        ClothActivity& state = activity[entry.index];
+        if (cape.getKineticEnergy() >= config.sleepEnergy) {
+            state.restTime = 0.0f;
+            continue;
+        }
+        state.restTime += entry.dt;
+        if (state.restTime < config.sleepDelay) continue;
+
+        cape.settle();
+        state.asleep = true;
+        state.sleepAnchor = getAnchor(cape);
+        state.sleepWind = wind.getWindAt(state.sleepAnchor);
+    }
+}
+
+} // namespace ethereal
@@ -0,0 +1,100 @@
+#pragma once
+#include <cstddef>
+#include <deque>
+#include <vector>
+#include "Cape3D.hpp"
+
+namespace ethereal {
+
+class JobSystem;
+
+struct ClothWorldConfig {
+    int solverIterations = 5;
+
+    // Sleep: a cape whose kinetic energy stays under the threshold for sleepDelay
+    // seconds stops simulating until its anchor moves or the wind at it changes
+    bool allowSleep = true;
+    float sleepEnergy = 0.5f;       // Mean 0.5 * m * v^2 per particle
+    float sleepDelay = 1.0f;
+    float wakeWindChange = 4.0f;    // Wind delta at the anchor that wakes a cape
+    float wakeAnchorMove = 0.05f;
+
+    // Distance LOD from the viewer: each level past near halves the update rate
+    // and the iteration count. Capes behind the viewer drop to the far level.
+    float lodNearDistance = 300.0f;
+    float lodFarDistance = 900.0f;
+};
+
+// Owns every cloth object in the scene (player cape, NPC capes, flags, banners)
+// and steps them together. With a JobSystem the batch runs one task per cape,
+// or one task per constraint color when there are fewer capes than threads.
+class ClothWorld {
+public:
+    enum { LodFull = 0, LodHalf = 1, LodFar = 2 };
+
+    ClothWorld();
+    explicit ClothWorld(const ClothWorldConfig& config, JobSystem* jobs = nullptr);
+
+    // Returned references stay valid until clear()
+    Cape3D& addCape(const Vector3D& attachPoint, const Vector3D& forward,
+                    const CapeConfig3D& capeConfig = CapeConfig3D{});
+    void clear();
+
+    void step(float dt, const WindField3D& wind);
+
+    // Camera position and view direction used for LOD; without one every cape is near
+    void setViewer(const Vector3D& position, const Vector3D& forward);
+    void clearViewer() { hasViewer = false; }
+
+    // Force a cape awake, e.g. after moving it by hand
+    void wake(size_t index);
+    bool isAsleep(size_t index) const { return activity[index].asleep; }
+    int getLod(size_t index) const { return activity[index].lod; }
+    // Capes stepped / asleep during the last step()
+    size_t getSimulatedCount() const { return scheduled.size(); }
+    size_t getSleepingCount() const { return sleepingCount; }
+
+    size_t getCapeCount() const { return capes.size(); }
+    Cape3D& getCape(size_t index) { return capes[index]; }
+    const Cape3D& getCape(size_t index) const { return capes[index]; }
+
+    void setJobSystem(JobSystem* jobSystem) { jobs = jobSystem; }
+    const ClothWorldConfig& getConfig() const { return config; }
+
+private:
+    struct ClothActivity {
+        float restTime = 0.0f;      // Seconds spent under the sleep threshold
+        float pendingDt = 0.0f;     // Time skipped by LOD, handed to the next step
+        Vector3D sleepWind;         // Wind and anchor when the cape fell asleep
+        Vector3D sleepAnchor;
+        int lod = LodFull;
+        unsigned phase = 0;         // Staggers reduced-rate capes across frames
+        bool asleep = false;
+    };
+
+    struct ScheduledCape {
+        size_t index;
+        float dt;
+        int iterations;
+    };
+
+    std::deque<Cape3D> capes;
+    std::deque<ClothActivity> activity;
+    std::vector<ScheduledCape> scheduled;
+    ClothWorldConfig config;
+    JobSystem* jobs;
+
+    Vector3D viewerPosition;
+    Vector3D viewerForward;
+    bool hasViewer = false;
+    unsigned frame = 0;
+    size_t sleepingCount = 0;
+
+    Vector3D getAnchor(const Cape3D& cape) const;
+    int selectLod(const Cape3D& cape) const;
+    void schedule(float dt, const WindField3D& wind);
+    void simulate(const WindField3D& wind);
+    void updateSleep(const WindField3D& wind);
+};
+
+} // namespace ethereal
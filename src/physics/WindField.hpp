@@ -1,6 +1,7 @@
 #pragma once
 #include "core/Vector2D.hpp"
 #include "utils/PerlinNoise.hpp"
+#include <vector>
 
 namespace ethereal {
 
@@ -1,9 +1,52 @@
 #include "WindField3D.hpp"
+#include "WindMap.hpp"
+#include "utils/MemoryTracker.hpp"
+#include "utils/Profiler.hpp"
+#include "utils/Telemetry.hpp"
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace ethereal {
 
+namespace {
+
+// Points per stack-allocated block in the batched samplers
+constexpr size_t kBlockSize = 64;
+
+// Below this many emitters a plain scan is cheaper than the column lookup
+constexpr size_t kMinBinnedEmitters = 8;
+// Column budget per axis of the emitter grid; wide spreads get coarser cells
+constexpr int kMaxEmitterColumns = 64;
+
+// Broad gust swells stay two plain octaves whatever the turbulence shape
+using GustNoise = Fbm<2>;
+
+float lifetimePulse(float elapsed, float duration) {
+    return std::sin(elapsed / duration * 3.14159f);
+}
+
+int clampColumn(float coord, float origin, float invCell, int count) {
+    return std::clamp(static_cast<int>(std::floor((coord - origin) * invCell)), 0, count - 1);
+}
+
+// Index to overwrite when the pool is full: the emitter nearest the end of its life
+template <typename Emitter>
+size_t recycledSlot(const std::vector<Emitter>& emitters) {
+    size_t slot = 0;
+    float oldest = -1.0f;
+    for (size_t i = 0; i < emitters.size(); ++i) {
+        float age = emitters[i].elapsed / emitters[i].duration;
+        if (age > oldest) {
+            oldest = age;
+            slot = i;
+        }
+    }
+    return slot;
+}
+
+} // namespace
+
 WindField3D::WindField3D() : WindField3D(WindConfig3D{}) {}
 
 WindField3D::WindField3D(const WindConfig3D& config) 
@@ -11,10 +54,16 @@ WindField3D::WindField3D(const WindConfig3D& config)
     , noiseY(54321)
     , noiseZ(98765)
     , config(config)
-    , time(0.0f) {}
+    , time(0.0f) {
+    turbulenceNoise = &selectFractal(config.noiseFractal, config.noiseOctaves);
+    reserveEmitters();
+}
 
 void WindField3D::update(float dt) {
+    PROFILE_SCOPE("WindField3D::update");
+    MEMORY_TAG(Physics);
     time += dt * config.timeScale;
+    mapTime += dt;
 
     gusts.erase(std::remove_if(gusts.begin(), gusts.end(),
         [](const Gust3D& g) { return g.elapsed >= g.duration; }), gusts.end());
@@ -22,78 +71,342 @@ void WindField3D::update(float dt) {
     vortices.erase(std::remove_if(vortices.begin(), vortices.end(),
         [](const Vortex& v) { return v.elapsed >= v.duration; }), vortices.end());
 
-    for (auto& gust : gusts) gust.elapsed += dt;
-    for (auto& vortex : vortices) vortex.elapsed += dt;
+    for (auto& gust : gusts) {
+        gust.elapsed += dt;
+        refreshEmitter(gust);
+    }
+    for (auto& vortex : vortices) {
+        vortex.elapsed += dt;
+        refreshEmitter(vortex);
+    }
+    rebuildEmitterBins();
+
+    if (gridEnabled) {
+        bakeSlices(gridConfig.slicesPerUpdate);
+    }
 }
 
 Vector3D WindField3D::sampleNoise(float x, float y, float z, float t) const {
     float scale = config.noiseScale;
-    float nx = noise.octaveNoise(x * scale, y * scale, z * scale + t, 3, 0.5f);
-    float ny = noiseY.octaveNoise(x * scale + 100, y * scale + 100, z * scale + t + 50, 3, 0.5f);
-    float nz = noiseZ.octaveNoise(x * scale + 200, y * scale + 200, z * scale + t + 100, 3, 0.5f);
+    FractalSample3 octaves = turbulenceNoise->sample3;
+    float nx = octaves(noise, x * scale, y * scale, z * scale + t);
+    float ny = octaves(noiseY, x * scale + 100, y * scale + 100, z * scale + t + 50);
+    float nz = octaves(noiseZ, x * scale + 200, y * scale + 200, z * scale + t + 100);
     return Vector3D(nx, ny * config.verticalInfluence, nz);
 }
 
+Vector3D WindField3D::sampleNoise(float x, float y, float z, float t, Vector3D& curl) const {
+    float scale = config.noiseScale;
+    Vector3D gx, gy, gz;
+    FractalSample3Gradient octaves = turbulenceNoise->sample3Gradient;
+    float nx = octaves(noise, x * scale, y * scale, z * scale + t, gx);
+    float ny = octaves(noiseY, x * scale + 100, y * scale + 100, z * scale + t + 50, gy);
+    float nz = octaves(noiseZ, x * scale + 200, y * scale + 200, z * scale + t + 100, gz);
+
+    // Chain rule: each channel is sampled at position * scale, and y is scaled by verticalInfluence
+    float vy = config.verticalInfluence;
+    curl = Vector3D(
+        gz.y - gy.z * vy,
+        gx.z - gz.x,
+        gy.x * vy - gx.y
+    ) * scale;
+    return Vector3D(nx, ny * vy, nz);
+}
+
 Vector3D WindField3D::getWindAt(const Vector3D& position) const {
     return getWindAt(position.x, position.y, position.z);
 }
 
 Vector3D WindField3D::getWindAt(float x, float y, float z) const {
-    Vector3D noiseVec = sampleNoise(x, y, z, time);
+    TELEMETRY_COUNT("wind.samples", 1);
+    Vector3D ambient;
+    if (!gridEnabled || !sampleGrid(x, y, z, ambient)) {
+        ambient = sampleAmbient(x, y, z);
+    }
+    return addEmitters(Vector3D(x, y, z), ambient);
+}
+
+void WindField3D::getWindAt(const Vector3D* positions, Vector3D* out, size_t count) const {
+    PROFILE_SCOPE("WindField3D::getWindAt");
+    TELEMETRY_COUNT("wind.samples", count);
+    // Grid hits are resolved directly; misses are gathered and evaluated in batches
+    float xs[kBlockSize], ys[kBlockSize], zs[kBlockSize];
+    size_t missIndex[kBlockSize];
+    Vector3D ambient[kBlockSize];
+    size_t misses = 0;
+
+    auto flushMisses = [&]() {
+        sampleAmbientBatch(xs, ys, zs, misses, ambient);
+        for (size_t k = 0; k < misses; ++k) {
+            out[missIndex[k]] = addEmitters(positions[missIndex[k]], ambient[k]);
+        }
+        misses = 0;
+    };
+
+    for (size_t i = 0; i < count; ++i) {
+        const Vector3D& p = positions[i];
+        Vector3D cached;
+        if (gridEnabled && sampleGrid(p.x, p.y, p.z, cached)) {
+            out[i] = addEmitters(p, cached);
+            continue;
+        }
+        xs[misses] = p.x;
+        ys[misses] = p.y;
+        zs[misses] = p.z;
+        missIndex[misses] = i;
+        if (++misses == kBlockSize) flushMisses();
+    }
+    if (misses > 0) flushMisses();
+}
+
+void WindField3D::sampleNoiseBatch(const float* xs, const float* ys, const float* zs, size_t n,
+                                   Vector3D* out, Vector3D* curl) const {
+    const float scale = config.noiseScale;
+    const float t = time;
+    const float vy = config.verticalInfluence;
+    float ax[kBlockSize], ay[kBlockSize], az[kBlockSize];
+    float nx[kBlockSize], ny[kBlockSize], nz[kBlockSize];
+    float g[3][3][kBlockSize];  // [channel][axis][point]
+    FractalBatch3Gradient octaves = turbulenceNoise->batch3Gradient;
+
+    for (size_t k = 0; k < n; ++k) {
+        ax[k] = xs[k] * scale; ay[k] = ys[k] * scale; az[k] = zs[k] * scale + t;
+    }
+    octaves(noise, ax, ay, az, nx, g[0][0], g[0][1], g[0][2], n);
+
+    for (size_t k = 0; k < n; ++k) {
+        ax[k] = xs[k] * scale + 100; ay[k] = ys[k] * scale + 100; az[k] = zs[k] * scale + t + 50;
+    }
+    octaves(noiseY, ax, ay, az, ny, g[1][0], g[1][1], g[1][2], n);
+
+    for (size_t k = 0; k < n; ++k) {
+        ax[k] = xs[k] * scale + 200; ay[k] = ys[k] * scale + 200; az[k] = zs[k] * scale + t + 100;
+    }
+    octaves(noiseZ, ax, ay, az, nz, g[2][0], g[2][1], g[2][2], n);
+
+    for (size_t k = 0; k < n; ++k) {
+        out[k] = Vector3D(nx[k], ny[k] * vy, nz[k]);
+        curl[k] = Vector3D(
+            g[2][1][k] - g[1][2][k] * vy,
+            g[0][2][k] - g[2][0][k],
+            g[1][0][k] * vy - g[0][1][k]
+        ) * scale;
+    }
+}
+
+void WindField3D::sampleAmbientBatch(const float* xs, const float* ys, const float* zs, size_t n, Vector3D* out) const {
+    if (windMap) {
+        for (size_t i = 0; i < n; ++i) out[i] = windMap->sample(xs[i], ys[i], zs[i], mapTime);
+        return;
+    }
+
+    const Vector3D baseDir = config.baseDirection.normalized();
+    float gx[kBlockSize], gz[kBlockSize], gt[kBlockSize], gust[kBlockSize];
+    Vector3D noiseVec[kBlockSize], curl[kBlockSize];
+
+    for (size_t begin = 0; begin < n; begin += kBlockSize) {
+        size_t count = std::min(kBlockSize, n - begin);
+        const float* x = xs + begin;
+        const float* z = zs + begin;
+
+        sampleNoiseBatch(x, ys + begin, z, count, noiseVec, curl);
+
+        for (size_t k = 0; k < count; ++k) {
+            gx[k] = x[k] * config.noiseScale * 0.5f;
+            gz[k] = z[k] * config.noiseScale * 0.5f;
+            gt[k] = time * 0.3f;
+        }
+        GustNoise::batch(noise, gx, gz, gt, gust, count);
+
+        for (size_t k = 0; k < count; ++k) {
+            Vector3D turbulentWind = noiseVec[k] * config.turbulence * config.baseStrength;
+            Vector3D baseWind = baseDir * config.baseStrength;
+            Vector3D gustWind = baseDir * std::max(0.0f, gust[k]) * config.gustStrength;
+            out[begin + k] = baseWind + turbulentWind + gustWind + curl[k] * config.curlStrength;
+        }
+    }
+}
+
+Vector3D WindField3D::sampleAmbient(float x, float y, float z) const {
+    if (windMap) return windMap->sample(x, y, z, mapTime);
+
+    Vector3D curl;
+    Vector3D noiseVec = sampleNoise(x, y, z, time, curl);
     
     Vector3D turbulentWind = noiseVec * config.turbulence * config.baseStrength;
     Vector3D baseWind = config.baseDirection.normalized() * config.baseStrength;
     
-    float gustNoise = noise.octaveNoise(x * config.noiseScale * 0.5f, z * config.noiseScale * 0.5f, time * 0.3f, 2);
+    float gustNoise = GustNoise::sample(noise, x * config.noiseScale * 0.5f, z * config.noiseScale * 0.5f, time * 0.3f);
     gustNoise = std::max(0.0f, gustNoise);
     Vector3D gustWind = config.baseDirection.normalized() * gustNoise * config.gustStrength;
     
-    Vector3D curlWind = getCurlAt(Vector3D(x, y, z)) * config.curlStrength;
+    Vector3D curlWind = curl * config.curlStrength;
     
-    Vector3D totalWind = baseWind + turbulentWind + gustWind + curlWind;
-
-    for (const auto& gust : gusts) {
-        Vector3D toPoint = Vector3D(x, y, z) - gust.position;
-        float dist = toPoint.length();
-        if (dist < gust.radius) {
-            float falloff = 1.0f - (dist / gust.radius);
-            falloff = falloff * falloff;
-            float timeRatio = gust.elapsed / gust.duration;
-            float timeFalloff = std::sin(timeRatio * 3.14159f);
-            totalWind += gust.direction.normalized() * gust.strength * falloff * timeFalloff;
+    return baseWind + turbulentWind + gustWind + curlWind;
+}
+
+Vector3D WindField3D::addEmitters(const Vector3D& position, Vector3D totalWind) const {
+    auto applyGust = [&](const Gust3D& gust) {
+        Vector3D toPoint = position - gust.position;
+        float distSq = toPoint.lengthSquared();
+        if (distSq < gust.radiusSq) {
+            float falloff = 1.0f - std::sqrt(distSq) * gust.invRadius;
+            totalWind += gust.push * (falloff * falloff);
         }
-    }
+    };
 
-    for (const auto& vortex : vortices) {
-        Vector3D toPoint = Vector3D(x, y, z) - vortex.position;
+    auto applyVortex = [&](const Vortex& vortex) {
+        Vector3D toPoint = position - vortex.position;
         Vector3D projected = toPoint - vortex.axis * toPoint.dot(vortex.axis);
-        float dist = projected.length();
-        if (dist < vortex.radius && dist > 0.1f) {
-            float falloff = 1.0f - (dist / vortex.radius);
-            falloff = falloff * falloff;
-            float timeRatio = vortex.elapsed / vortex.duration;
-            float timeFalloff = std::sin(timeRatio * 3.14159f);
-            
-            Vector3D tangent = vortex.axis.cross(projected).normalized();
-            totalWind += tangent * vortex.strength * falloff * timeFalloff;
+        float distSq = projected.lengthSquared();
+        if (distSq < vortex.radiusSq && distSq > 0.01f) {
+            float dist = std::sqrt(distSq);
+            float falloff = 1.0f - dist * vortex.invRadius;
+            // Unit axis perpendicular to projected: the cross product has length dist
+            Vector3D tangent = vortex.axis.cross(projected) * (1.0f / dist);
+            totalWind += tangent * (vortex.amplitude * falloff * falloff);
         }
+    };
+
+    if (binsActive) {
+        float fx = (position.x - binOriginX) * binInvCell;
+        float fz = (position.z - binOriginZ) * binInvCell;
+        if (fx >= 0.0f && fz >= 0.0f) {
+            int ix = static_cast<int>(fx);
+            int iz = static_cast<int>(fz);
+            if (ix < binColumns && iz < binRows) {
+                size_t cell = static_cast<size_t>(iz) * binColumns + ix;
+                for (uint32_t k = gustBins.cellStart[cell]; k < gustBins.cellStart[cell + 1]; ++k) {
+                    applyGust(gusts[gustBins.items[k]]);
+                }
+                for (uint32_t k = vortexBins.cellStart[cell]; k < vortexBins.cellStart[cell + 1]; ++k) {
+                    applyVortex(vortices[vortexBins.items[k]]);
+                }
+            }
+        }
+        for (uint32_t index : unboundedVortices) applyVortex(vortices[index]);
     }
 
+    for (size_t i = binnedGusts; i < gusts.size(); ++i) applyGust(gusts[i]);
+    for (size_t i = binnedVortices; i < vortices.size(); ++i) applyVortex(vortices[i]);
+
     return totalWind;
 }
 
-Vector3D WindField3D::getCurlAt(const Vector3D& position, float epsilon) const {
-    float px = position.x, py = position.y, pz = position.z;
-    
-    Vector3D dFdx = (sampleNoise(px + epsilon, py, pz, time) - sampleNoise(px - epsilon, py, pz, time)) / (2.0f * epsilon);
-    Vector3D dFdy = (sampleNoise(px, py + epsilon, pz, time) - sampleNoise(px, py - epsilon, pz, time)) / (2.0f * epsilon);
-    Vector3D dFdz = (sampleNoise(px, py, pz + epsilon, time) - sampleNoise(px, py, pz - epsilon, time)) / (2.0f * epsilon);
-    
-    return Vector3D(
-        dFdy.z - dFdz.y,
-        dFdz.x - dFdx.z,
-        dFdx.y - dFdy.x
-    );
+void WindField3D::refreshEmitter(Gust3D& gust) {
+    gust.push = gust.direction.normalized() * (gust.strength * lifetimePulse(gust.elapsed, gust.duration));
+    gust.radiusSq = gust.radius * gust.radius;
+    gust.invRadius = 1.0f / gust.radius;
+}
+
+void WindField3D::refreshEmitter(Vortex& vortex) {
+    vortex.amplitude = vortex.strength * lifetimePulse(vortex.elapsed, vortex.duration);
+    vortex.radiusSq = vortex.radius * vortex.radius;
+    vortex.invRadius = 1.0f / vortex.radius;
+}
+
+void WindField3D::rebuildEmitterBins() {
+    binnedGusts = 0;
+    binnedVortices = 0;
+    binColumns = 0;
+    binRows = 0;
+    unboundedVortices.clear();
+    binsActive = gusts.size() + vortices.size() >= kMinBinnedEmitters;
+    if (!binsActive) return;
+
+    binnedGusts = gusts.size();
+    binnedVortices = vortices.size();
+
+    // Only an exactly vertical axis keeps a vortex inside one set of columns
+    auto isVertical = [](const Vortex& vortex) { return vortex.axis.x == 0.0f && vortex.axis.z == 0.0f; };
+
+    float minX = std::numeric_limits<float>::max();
+    float minZ = minX;
+    float maxX = -minX;
+    float maxZ = -minX;
+    float radiusSum = 0.0f;
+    size_t bounded = 0;
+    auto include = [&](const Vector3D& center, float radius) {
+        minX = std::min(minX, center.x - radius);
+        maxX = std::max(maxX, center.x + radius);
+        minZ = std::min(minZ, center.z - radius);
+        maxZ = std::max(maxZ, center.z + radius);
+        radiusSum += radius;
+        bounded++;
+    };
+    for (const Gust3D& gust : gusts) include(gust.position, gust.radius);
+    for (size_t i = 0; i < vortices.size(); ++i) {
+        if (isVertical(vortices[i])) include(vortices[i].position, vortices[i].radius);
+        else unboundedVortices.push_back(static_cast<uint32_t>(i));
+    }
+    if (bounded == 0) return;
+
+    // Cells about one emitter across, coarsened to stay within the column budget
+    float extent = std::max(maxX - minX, maxZ - minZ);
+    float cell = std::max({1.0f, 2.0f * radiusSum / bounded, extent / (kMaxEmitterColumns - 1)});
+    binInvCell = 1.0f / cell;
+    binOriginX = minX;
+    binOriginZ = minZ;
+    binColumns = std::min(kMaxEmitterColumns, static_cast<int>((maxX - minX) * binInvCell) + 1);
+    binRows = std::min(kMaxEmitterColumns, static_cast<int>((maxZ - minZ) * binInvCell) + 1);
+    const size_t cells = static_cast<size_t>(binColumns) * binRows;
+
+    // Counting sort: tally each column, prefix-sum, then scatter in emitter order
+    auto fill = [&](EmitterBins& bins, size_t count, auto footprint) {
+        bins.cellStart.assign(cells + 1, 0);
+        for (int pass = 0; pass < 2; ++pass) {
+            for (size_t i = 0; i < count; ++i) {
+                Vector3D center;
+                float radius;
+                if (!footprint(i, center, radius)) continue;
+                int x0 = clampColumn(center.x - radius, binOriginX, binInvCell, binColumns);
+                int x1 = clampColumn(center.x + radius, binOriginX, binInvCell, binColumns);
+                int z0 = clampColumn(center.z - radius, binOriginZ, binInvCell, binRows);
+                int z1 = clampColumn(center.z + radius, binOriginZ, binInvCell, binRows);
+                for (int iz = z0; iz <= z1; ++iz) {
+                    for (int ix = x0; ix <= x1; ++ix) {
+                        size_t c = static_cast<size_t>(iz) * binColumns + ix;
+                        if (pass == 0) bins.cellStart[c + 1]++;
+                        else bins.items[bins.cellStart[c]++] = static_cast<uint32_t>(i);
+                    }
+                }
+            }
+            if (pass == 0) {
+                for (size_t c = 0; c < cells; ++c) bins.cellStart[c + 1] += bins.cellStart[c];
+                bins.items.resize(bins.cellStart[cells]);
+            }
+        }
+        // Scattering advanced every start to the next column's; shift them back
+        for (size_t c = cells; c > 0; --c) bins.cellStart[c] = bins.cellStart[c - 1];
+        bins.cellStart[0] = 0;
+    };
+
+    fill(gustBins, gusts.size(), [&](size_t i, Vector3D& center, float& radius) {
+        center = gusts[i].position;
+        radius = gusts[i].radius;
+        return true;
+    });
+    fill(vortexBins, vortices.size(), [&](size_t i, Vector3D& center, float& radius) {
+        center = vortices[i].position;
+        radius = vortices[i].radius;
+        return isVertical(vortices[i]);
+    });
+}
+
+Vector3D WindField3D::getCurlAt(const Vector3D& position) const {
+    if (windMap) {
+        // Central differences over one map cell
+        float h = windMap->getInfo().cellSize * 0.5f;
+        float inv = 0.5f / h;
+        const Vector3D& p = position;
+        Vector3D dx = (windMap->sample(p.x + h, p.y, p.z, mapTime) - windMap->sample(p.x - h, p.y, p.z, mapTime)) * inv;
+        Vector3D dy = (windMap->sample(p.x, p.y + h, p.z, mapTime) - windMap->sample(p.x, p.y - h, p.z, mapTime)) * inv;
+        Vector3D dz = (windMap->sample(p.x, p.y, p.z + h, mapTime) - windMap->sample(p.x, p.y, p.z - h, mapTime)) * inv;
+        return Vector3D(dy.z - dz.y, dz.x - dx.z, dx.y - dy.x);
+    }
+    Vector3D curl;
+    sampleNoise(position.x, position.y, position.z, time, curl);
+    return curl;
 }
 
 float WindField3D::getStrengthAt(const Vector3D& position) const {
@@ -106,14 +419,173 @@ float WindField3D::getTurbulenceAt(const Vector3D& position) const {
 
 void WindField3D::setConfig(const WindConfig3D& newConfig) {
     config = newConfig;
+    turbulenceNoise = &selectFractal(config.noiseFractal, config.noiseOctaves);
+    reserveEmitters();
+}
+
+void WindField3D::reserveEmitters() {
+    gusts.reserve(static_cast<size_t>(std::max(config.maxGusts, 1)));
+    vortices.reserve(static_cast<size_t>(std::max(config.maxVortices, 1)));
 }
 
 void WindField3D::addGust(const Vector3D& position, const Vector3D& direction, float strength, float radius, float duration) {
-    gusts.push_back({position, direction, strength, radius, duration, 0.0f});
+    Gust3D gust = {position, direction, strength, radius, duration, 0.0f};
+    gust.id = nextEmitterId++;
+    refreshEmitter(gust);
+    if (gusts.size() < static_cast<size_t>(std::max(config.maxGusts, 1))) {
+        gusts.push_back(gust);
+        return;
+    }
+    // A recycled binned slot is still listed under the old emitter's columns
+    size_t slot = recycledSlot(gusts);
+    gusts[slot] = gust;
+    if (slot < binnedGusts) rebuildEmitterBins();
 }
 
 void WindField3D::addVortex(const Vector3D& position, const Vector3D& axis, float strength, float radius, float duration) {
-    vortices.push_back({position, axis.normalized(), strength, radius, duration, 0.0f});
+    Vortex vortex = {position, axis.normalized(), strength, radius, duration, 0.0f};
+    vortex.id = nextEmitterId++;
+    refreshEmitter(vortex);
+    if (vortices.size() < static_cast<size_t>(std::max(config.maxVortices, 1))) {
+        vortices.push_back(vortex);
+        return;
+    }
+    size_t slot = recycledSlot(vortices);
+    vortices[slot] = vortex;
+    if (slot < binnedVortices) rebuildEmitterBins();
+}
+
+void WindField3D::getEmitters(std::vector<WindEmitter3D>& out) const {
+    out.clear();
+    for (const Gust3D& gust : gusts) {
+        out.push_back({gust.position, gust.strength * lifetimePulse(gust.elapsed, gust.duration), gust.radius, gust.id, false});
+    }
+    for (const Vortex& vortex : vortices) {
+        out.push_back({vortex.position, vortex.amplitude, vortex.radius, vortex.id, true});
+    }
+}
+
+void WindField3D::enableGrid(const WindGridConfig3D& newGridConfig, const Vector3D& center) {
+    gridConfig = newGridConfig;
+    gridConfig.resolution = std::max(2, gridConfig.resolution);
+    gridConfig.slicesPerUpdate = std::max(1, gridConfig.slicesPerUpdate);
+    gridCenter = center;
+    gridEnabled = true;
+
+    size_t nodes = static_cast<size_t>(gridConfig.resolution) * gridConfig.resolution * gridConfig.resolution;
+    for (VelocityGrid* grid : {&gridFront, &gridBack}) {
+        grid->vx.assign(nodes, 0.0f);
+        grid->vy.assign(nodes, 0.0f);
+        grid->vz.assign(nodes, 0.0f);
+        grid->valid = false;
+    }
+
+    // Bake the first grid in full so lookups are available immediately
+    bakeSlice = 0;
+    bakeSlices(gridConfig.resolution);
+}
+
+void WindField3D::disableGrid() {
+    gridEnabled = false;
+    gridFront = VelocityGrid{};
+    gridBack = VelocityGrid{};
+    bakeSlice = 0;
+}
+
+bool WindField3D::getGridView(WindGridView3D& view) const {
+    if (!gridEnabled || !gridFront.valid) return false;
+    view.vx = gridFront.vx.data();
+    view.vy = gridFront.vy.data();
+    view.vz = gridFront.vz.data();
+    view.resolution = gridConfig.resolution;
+    view.cellSize = gridConfig.cellSize;
+    view.origin = gridFront.origin;
+    return true;
+}
+
+void WindField3D::bakeSlices(int count) {
+    const int n = gridConfig.resolution;
+    const float cell = gridConfig.cellSize;
+
+    for (int s = 0; s < count; ++s) {
+        if (bakeSlice == 0) {
+            // Snap to whole cells so consecutive grids sample the same lattice
+            float half = (n - 1) * cell * 0.5f;
+            gridBack.origin = Vector3D(
+                std::floor((gridCenter.x - half) / cell) * cell,
+                std::floor((gridCenter.y - half) / cell) * cell,
+                std::floor((gridCenter.z - half) / cell) * cell
+            );
+        }
+
+        // One x-slice is n*n nodes, sampled in a single batch
+        const size_t sliceNodes = static_cast<size_t>(n) * n;
+        bakeX.assign(sliceNodes, gridBack.origin.x + bakeSlice * cell);
+        bakeY.resize(sliceNodes);
+        bakeZ.resize(sliceNodes);
+        bakeOut.resize(sliceNodes);
+        for (int iy = 0, k = 0; iy < n; ++iy) {
+            for (int iz = 0; iz < n; ++iz, ++k) {
+                bakeY[k] = gridBack.origin.y + iy * cell;
+                bakeZ[k] = gridBack.origin.z + iz * cell;
+            }
+        }
+        sampleAmbientBatch(bakeX.data(), bakeY.data(), bakeZ.data(), sliceNodes, bakeOut.data());
+
+        size_t index = static_cast<size_t>(bakeSlice) * sliceNodes;
+        for (size_t k = 0; k < sliceNodes; ++k, ++index) {
+            gridBack.vx[index] = bakeOut[k].x;
+            gridBack.vy[index] = bakeOut[k].y;
+            gridBack.vz[index] = bakeOut[k].z;
+        }
+
+        if (++bakeSlice == n) {
+            gridBack.valid = true;
+            std::swap(gridFront, gridBack);
+            gridRevision++;
+            bakeSlice = 0;
+        }
+    }
+}
+
+bool WindField3D::sampleGrid(float x, float y, float z, Vector3D& out) const {
+    if (!gridFront.valid) return false;
+
+    const int n = gridConfig.resolution;
+    const float invCell = 1.0f / gridConfig.cellSize;
+    float fx = (x - gridFront.origin.x) * invCell;
+    float fy = (y - gridFront.origin.y) * invCell;
+    float fz = (z - gridFront.origin.z) * invCell;
+
+    const float maxCoord = static_cast<float>(n - 1);
+    if (fx < 0.0f || fy < 0.0f || fz < 0.0f || fx >= maxCoord || fy >= maxCoord || fz >= maxCoord) {
+        return false;
+    }
+
+    int ix = static_cast<int>(fx);
+    int iy = static_cast<int>(fy);
+    int iz = static_cast<int>(fz);
+    float tx = fx - ix;
+    float ty = fy - iy;
+    float tz = fz - iz;
+
+    const size_t strideX = static_cast<size_t>(n) * n;
+    const size_t strideY = static_cast<size_t>(n);
+    size_t base = ix * strideX + iy * strideY + iz;
+
+    auto trilinear = [&](const std::vector<float>& v) {
+        const float* c = v.data() + base;
+        float c00 = c[0] + (c[1] - c[0]) * tz;
+        float c01 = c[strideY] + (c[strideY + 1] - c[strideY]) * tz;
+        float c10 = c[strideX] + (c[strideX + 1] - c[strideX]) * tz;
+        float c11 = c[strideX + strideY] + (c[strideX + strideY + 1] - c[strideX + strideY]) * tz;
+        float c0 = c00 + (c01 - c00) * ty;
+        float c1 = c10 + (c11 - c10) * ty;
+        return c0 + (c1 - c0) * tx;
+    };
+
+    out = Vector3D(trilinear(gridFront.vx), trilinear(gridFront.vy), trilinear(gridFront.vz));
+    return true;
 }
 
 } // namespace ethereal
@@ -1,9 +1,15 @@
 #pragma once
 #include "core/Vector3D.hpp"
+#include "utils/FractalNoise.hpp"
 #include "utils/PerlinNoise.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 namespace ethereal {
 
+class WindMap;
+
 struct WindConfig3D {
     float baseStrength = 60.0f;
     float gustStrength = 100.0f;
@@ -13,6 +19,41 @@ struct WindConfig3D {
     Vector3D baseDirection = Vector3D(1.0f, 0.0f, 0.2f);
     float verticalInfluence = 0.3f;
     float curlStrength = 0.5f;
+    // Shape of the turbulence noise; octaves are clamped to 1..kMaxFractalOctaves
+    FractalType noiseFractal = FractalType::Fbm;
+    int noiseOctaves = 3;
+    // Emitter pools are reserved up front; a full pool recycles the emitter
+    // closest to expiring, so adding one never reallocates
+    int maxGusts = 64;
+    int maxVortices = 32;
+};
+
+// Baked velocity grid for the ambient (noise) part of the field.
+// Gusts and vortices are always added analytically on top.
+struct WindGridConfig3D {
+    int resolution = 16;        // nodes per axis
+    float cellSize = 16.0f;     // world units between nodes
+    int slicesPerUpdate = 2;    // x-slices rebaked per update()
+};
+
+// Read-only view of the completed grid, e.g. for a GPU upload.
+// Nodes are x-major: index = (ix * resolution + iy) * resolution + iz.
+struct WindGridView3D {
+    const float* vx = nullptr;
+    const float* vy = nullptr;
+    const float* vz = nullptr;
+    int resolution = 0;
+    float cellSize = 0.0f;
+    Vector3D origin;
+};
+
+// Snapshot of a live gust or vortex, e.g. for positional audio
+struct WindEmitter3D {
+    Vector3D position;
+    float strength = 0.0f;      // Current, lifetime-scaled
+    float radius = 0.0f;
+    uint32_t id = 0;            // Stable while the emitter lives; never 0
+    bool vortex = false;
 };
 
 class WindField3D {
@@ -24,7 +65,9 @@ public:
     
     Vector3D getWindAt(const Vector3D& position) const;
     Vector3D getWindAt(float x, float y, float z) const;
-    Vector3D getCurlAt(const Vector3D& position, float epsilon = 0.5f) const;
+    void getWindAt(const Vector3D* positions, Vector3D* out, size_t count) const;
+    // Curl of the turbulence field from analytic noise derivatives
+    Vector3D getCurlAt(const Vector3D& position) const;
     
     float getStrengthAt(const Vector3D& position) const;
     float getTurbulenceAt(const Vector3D& position) const;
@@ -34,16 +77,43 @@ public:
     
     void addGust(const Vector3D& position, const Vector3D& direction, float strength, float radius, float duration);
     void addVortex(const Vector3D& position, const Vector3D& axis, float strength, float radius, float duration);
+    // Replaces out with every live gust and vortex
+    void getEmitters(std::vector<WindEmitter3D>& out) const;
 
     float getTime() const { return time; }
 
+    // === Authored wind ===
+    // While set, the ambient field is sampled from the map (trilinear, lerped between
+    // keyframes in real seconds) instead of live noise; gusts and vortices still apply.
+    // Not owned; nullptr returns to procedural wind.
+    void setWindMap(const WindMap* map) { windMap = map; }
+    const WindMap* getWindMap() const { return windMap; }
+
+    // === Baked grid ===
+    // Samples inside the grid become trilinear lookups; outside it the full noise
+    // is evaluated. The grid is rebaked around the latest center a few slices per
+    // update() and swapped in when complete.
+    void enableGrid(const WindGridConfig3D& gridConfig, const Vector3D& center);
+    void disableGrid();
+    void setGridCenter(const Vector3D& center) { gridCenter = center; }
+    bool isGridEnabled() const { return gridEnabled; }
+    // False until the first bake completes
+    bool getGridView(WindGridView3D& view) const;
+    // Bumped every time a freshly baked grid is swapped in
+    uint32_t getGridRevision() const { return gridRevision; }
+
 private:
     PerlinNoise noise;
     PerlinNoise noiseY;
     PerlinNoise noiseZ;
+    const FractalKernels* turbulenceNoise = nullptr;   // Resolved from noiseFractal/noiseOctaves
     WindConfig3D config;
     float time;
+    float mapTime = 0.0f;
+    const WindMap* windMap = nullptr;
 
+    // Push and radius terms are cached per update() so samples skip the
+    // normalize and the lifetime sine
     struct Gust3D {
         Vector3D position;
         Vector3D direction;
@@ -51,6 +121,10 @@ private:
         float radius;
         float duration;
         float elapsed;
+        Vector3D push;
+        float radiusSq = 0.0f;
+        float invRadius = 0.0f;
+        uint32_t id = 0;
     };
     
     struct Vortex {
@@ -60,12 +134,67 @@ private:
         float radius;
         float duration;
         float elapsed;
+        float amplitude = 0.0f;
+        float radiusSq = 0.0f;
+        float invRadius = 0.0f;
+        uint32_t id = 0;
     };
     
     std::vector<Gust3D> gusts;
     std::vector<Vortex> vortices;
+    uint32_t nextEmitterId = 1;
+
+    // Coarse XZ column grid over the emitters, rebuilt in update(). Each emitter is
+    // listed in every column its radius reaches, so a sample only visits the emitters
+    // of its own column. Vortices act along an unbounded axis; only vertical ones
+    // have a finite footprint, tilted ones are visited by every sample. Emitters
+    // added since the last rebuild sit past binnedGusts/binnedVortices and are
+    // always visited; one recycled into a binned slot rebuilds the bins at once.
+    struct EmitterBins {
+        std::vector<uint32_t> cellStart;    // columns + 1 offsets into items
+        std::vector<uint32_t> items;
+    };
+    EmitterBins gustBins;
+    EmitterBins vortexBins;
+    std::vector<uint32_t> unboundedVortices;
+    float binOriginX = 0.0f;
+    float binOriginZ = 0.0f;
+    float binInvCell = 0.0f;
+    int binColumns = 0;
+    int binRows = 0;
+    bool binsActive = false;
+    size_t binnedGusts = 0;
+    size_t binnedVortices = 0;
+
+    struct VelocityGrid {
+        std::vector<float> vx, vy, vz;
+        Vector3D origin;
+        bool valid = false;
+    };
+
+    WindGridConfig3D gridConfig;
+    VelocityGrid gridFront;     // sampled
+    VelocityGrid gridBack;      // being baked
+    Vector3D gridCenter;
+    int bakeSlice = 0;
+    bool gridEnabled = false;
+    uint32_t gridRevision = 0;
+    std::vector<float> bakeX, bakeY, bakeZ;
+    std::vector<Vector3D> bakeOut;
 
     Vector3D sampleNoise(float x, float y, float z, float t) const;
+    Vector3D sampleNoise(float x, float y, float z, float t, Vector3D& curl) const;
+    Vector3D sampleAmbient(float x, float y, float z) const;
+    void sampleNoiseBatch(const float* xs, const float* ys, const float* zs, size_t n,
+                          Vector3D* out, Vector3D* curl) const;
+    void sampleAmbientBatch(const float* xs, const float* ys, const float* zs, size_t n, Vector3D* out) const;
+    Vector3D addEmitters(const Vector3D& position, Vector3D wind) const;
+    static void refreshEmitter(Gust3D& gust);
+    static void refreshEmitter(Vortex& vortex);
+    void rebuildEmitterBins();
+    void reserveEmitters();
+    bool sampleGrid(float x, float y, float z, Vector3D& out) const;
+    void bakeSlices(int count);
 };
 
 } // namespace ethereal
@@ -0,0 +1,224 @@
+#include "WindMap.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace ethereal {
+
+namespace {
+
+const size_t kHeaderSizeV1 = 16;
+const size_t kHeaderSizeV2 = 64;
+const uint32_t kFlagWrap = 1u << 0;
+
+uint32_t readU32(const unsigned char* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+float readF32(const unsigned char* p) {
+    uint32_t bits = readU32(p);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void writeU32(unsigned char* p, uint32_t value) {
+    p[0] = static_cast<unsigned char>(value);
+    p[1] = static_cast<unsigned char>(value >> 8);
+    p[2] = static_cast<unsigned char>(value >> 16);
+    p[3] = static_cast<unsigned char>(value >> 24);
+}
+
+void writeF32(unsigned char* p, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeU32(p, bits);
+}
+
+// Cell pair and blend weight along one axis
+void axisCoords(float f, int n, bool wrap, int& i0, int& i1, float& t) {
+    if (n <= 1) {
+        i0 = i1 = 0;
+        t = 0.0f;
+        return;
+    }
+    if (wrap) {
+        float whole = std::floor(f);
+        t = f - whole;
+        i0 = static_cast<int>(std::fmod(whole, static_cast<float>(n)));
+        if (i0 < 0) i0 += n;
+        i1 = (i0 + 1) % n;
+        return;
+    }
+    f = std::clamp(f, 0.0f, static_cast<float>(n - 1));
+    i0 = std::min(static_cast<int>(f), n - 2);
+    i1 = i0 + 1;
+    t = f - i0;
+}
+
+} // namespace
+
+WindMap::~WindMap() {
+    close();
+}
+
+bool WindMap::open(const std::string& path, bool verify) {
+    close();
+    if (!file.open(path)) return false;
+    if (!parseHeader() || (verify && !verifyChecksum())) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void WindMap::close() {
+    file.close();
+    info = WindMapInfo{};
+    data = nullptr;
+    dataBytes = 0;
+}
+
+bool WindMap::parseHeader() {
+    const unsigned char* bytes = file.data();
+    const size_t mappingSize = file.size();
+    if (mappingSize < kHeaderSizeV1 || std::memcmp(bytes, "WIND", 4) != 0) return false;
+
+    WindMapInfo parsed;
+    parsed.version = readU32(bytes + 4);
+    size_t headerSize = 0;
+
+    if (parsed.version == 1) {
+        // Horizontal slice only, centered on the world origin
+        parsed.width = static_cast<int>(readU32(bytes + 8));
+        parsed.depth = static_cast<int>(readU32(bytes + 12));
+        parsed.components = 2;
+        parsed.origin = Vector3D(-(parsed.width - 1) * parsed.cellSize * 0.5f, 0.0f,
+                                 -(parsed.depth - 1) * parsed.cellSize * 0.5f);
+        headerSize = kHeaderSizeV1;
+    } else if (parsed.version == 2) {
+        if (mappingSize < kHeaderSizeV2) return false;
+        parsed.width = static_cast<int>(readU32(bytes + 8));
+        parsed.depth = static_cast<int>(readU32(bytes + 12));
+        parsed.layers = static_cast<int>(readU32(bytes + 16));
+        parsed.keyframes = static_cast<int>(readU32(bytes + 20));
+        parsed.components = static_cast<int>(readU32(bytes + 24));
+        parsed.wrap = (readU32(bytes + 28) & kFlagWrap) != 0;
+        parsed.origin = Vector3D(readF32(bytes + 32), readF32(bytes + 36), readF32(bytes + 40));
+        parsed.cellSize = readF32(bytes + 44);
+        parsed.layerHeight = readF32(bytes + 48);
+        parsed.keyframeInterval = readF32(bytes + 52);
+        parsed.checksum = readU32(bytes + 56);
+        headerSize = kHeaderSizeV2;
+    } else {
+        return false;
+    }
+
+    if (parsed.width <= 0 || parsed.depth <= 0 || parsed.layers <= 0 || parsed.keyframes <= 0) return false;
+    if (parsed.components != 2 && parsed.components != 3) return false;
+    if (!(parsed.cellSize > 0.0f) || !(parsed.layerHeight > 0.0f)) return false;
+
+    size_t vectors = static_cast<size_t>(parsed.width) * parsed.depth * parsed.layers * parsed.keyframes;
+    size_t bytesNeeded = vectors * parsed.components * sizeof(float);
+    if (mappingSize - headerSize < bytesNeeded) return false;
+
+    // Zero-copy: floats are read in place, so this assumes a little-endian host
+    info = parsed;
+    data = reinterpret_cast<const float*>(bytes + headerSize);
+    dataBytes = bytesNeeded;
+    return true;
+}
+
+bool WindMap::verifyChecksum() const {
+    if (!data) return false;
+    if (info.version < 2) return true;
+    return crc32(data, dataBytes) == info.checksum;
+}
+
+Vector3D WindMap::fetch(int keyframe, int layer, int row, int col) const {
+    size_t index = ((static_cast<size_t>(keyframe) * info.layers + layer) * info.depth + row) * info.width + col;
+    const float* v = data + index * info.components;
+    if (info.components == 2) return Vector3D(v[0], 0.0f, v[1]);
+    return Vector3D(v[0], v[1], v[2]);
+}
+
+Vector3D WindMap::sample(float x, float y, float z, float time) const {
+    if (!data) return Vector3D::zero();
+
+    int x0, x1, y0, y1, z0, z1, k0, k1;
+    float tx, ty, tz, tk;
+    axisCoords((x - info.origin.x) / info.cellSize, info.width, info.wrap, x0, x1, tx);
+    axisCoords((z - info.origin.z) / info.cellSize, info.depth, info.wrap, z0, z1, tz);
+    axisCoords((y - info.origin.y) / info.layerHeight, info.layers, false, y0, y1, ty);
+    float keyCoord = info.keyframeInterval > 0.0f ? time / info.keyframeInterval : 0.0f;
+    axisCoords(keyCoord, info.keyframes, true, k0, k1, tk);
+
+    auto trilinear = [&](int k) {
+        Vector3D c00 = fetch(k, y0, z0, x0) + (fetch(k, y0, z0, x1) - fetch(k, y0, z0, x0)) * tx;
+        Vector3D c01 = fetch(k, y0, z1, x0) + (fetch(k, y0, z1, x1) - fetch(k, y0, z1, x0)) * tx;
+        Vector3D c10 = fetch(k, y1, z0, x0) + (fetch(k, y1, z0, x1) - fetch(k, y1, z0, x0)) * tx;
+        Vector3D c11 = fetch(k, y1, z1, x0) + (fetch(k, y1, z1, x1) - fetch(k, y1, z1, x0)) * tx;
+        Vector3D c0 = c00 + (c01 - c00) * tz;
+        Vector3D c1 = c10 + (c11 - c10) * tz;
+        return c0 + (c1 - c0) * ty;
+    };
+
+    Vector3D a = trilinear(k0);
+    if (k1 == k0 || tk == 0.0f) return a;
+    return a + (trilinear(k1) - a) * tk;
+}
+
+uint32_t WindMap::crc32(const void* bytes, size_t size) {
+    static const std::vector<uint32_t> table = [] {
+        std::vector<uint32_t> t(256);
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+
+    const unsigned char* p = static_cast<const unsigned char*>(bytes);
+    uint32_t crc = 0xffffffffu;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+    }
+    return crc ^ 0xffffffffu;
+}
+
+bool WindMap::writeV2(const std::string& path, const WindMapInfo& map, const float* vectors) {
+    if (map.width <= 0 || map.depth <= 0 || map.layers <= 0 || map.keyframes <= 0) return false;
+    if (map.components != 2 && map.components != 3) return false;
+
+    size_t count = static_cast<size_t>(map.width) * map.depth * map.layers * map.keyframes * map.components;
+    size_t bytes = count * sizeof(float);
+
+    unsigned char header[kHeaderSizeV2] = {};
+    std::memcpy(header, "WIND", 4);
+    writeU32(header + 4, 2);
+    writeU32(header + 8, static_cast<uint32_t>(map.width));
+    writeU32(header + 12, static_cast<uint32_t>(map.depth));
+    writeU32(header + 16, static_cast<uint32_t>(map.layers));
+    writeU32(header + 20, static_cast<uint32_t>(map.keyframes));
+    writeU32(header + 24, static_cast<uint32_t>(map.components));
+    writeU32(header + 28, map.wrap ? kFlagWrap : 0u);
+    writeF32(header + 32, map.origin.x);
+    writeF32(header + 36, map.origin.y);
+    writeF32(header + 40, map.origin.z);
+    writeF32(header + 44, map.cellSize);
+    writeF32(header + 48, map.layerHeight);
+    writeF32(header + 52, map.keyframeInterval);
+    writeU32(header + 56, crc32(vectors, bytes));
+
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) return false;
+    bool ok = std::fwrite(header, 1, sizeof(header), out) == sizeof(header) &&
+              std::fwrite(vectors, 1, bytes, out) == bytes;
+    return std::fclose(out) == 0 && ok;
+}
+
+} // namespace ethereal
@@ -0,0 +1,70 @@
+#pragma once
+#include "core/Vector3D.hpp"
+#include "utils/MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ethereal {
+
+// Layout of a .wind file as written by tools/wind_map_generator.py.
+//  v1: 16-byte header ("WIND", version, width, height) + width*height float2,
+//      a single horizontal slice (x, z) with no placement information.
+//  v2: 64-byte header + keyframes * layers * depth * width vectors of
+//      `components` floats, x fastest, followed by nothing. The header carries
+//      placement, layer spacing, keyframe interval and a CRC-32 of the data.
+// All values are little-endian.
+struct WindMapInfo {
+    uint32_t version = 0;
+    int width = 0;              // Cells along x
+    int depth = 0;              // Cells along z (v1 "height")
+    int layers = 1;             // Cells along y
+    int keyframes = 1;
+    int components = 3;         // 2 = horizontal (x, z) only
+    bool wrap = false;          // Tile horizontally instead of clamping
+    Vector3D origin;            // World position of cell (0, 0, 0)
+    float cellSize = 16.0f;     // Horizontal spacing
+    float layerHeight = 32.0f;  // Vertical spacing
+    float keyframeInterval = 4.0f;
+    uint32_t checksum = 0;
+};
+
+// Read-only, memory-mapped wind map. Vectors are sampled straight out of the
+// mapping (no copy, no parse step), so opening is O(1) even for large maps.
+class WindMap {
+public:
+    WindMap() = default;
+    ~WindMap();
+
+    WindMap(const WindMap&) = delete;
+    WindMap& operator=(const WindMap&) = delete;
+
+    // Validates the header and size; the checksum pass touches every page, so it is opt-in
+    bool open(const std::string& path, bool verify = false);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    const WindMapInfo& getInfo() const { return info; }
+    // CRC-32 of the data block against the v2 header (v1 has none and always passes)
+    bool verifyChecksum() const;
+
+    // Trilinear in space, linear between keyframes; `time` loops over the keyframes
+    Vector3D sample(float x, float y, float z, float time) const;
+    Vector3D sample(const Vector3D& position, float time) const { return sample(position.x, position.y, position.z, time); }
+
+    // Writes a v2 file; `vectors` holds keyframes * layers * depth * width * components floats
+    static bool writeV2(const std::string& path, const WindMapInfo& info, const float* vectors);
+    static uint32_t crc32(const void* bytes, size_t size);
+
+private:
+    WindMapInfo info;
+    const float* data = nullptr;
+    size_t dataBytes = 0;
+
+    MappedFile file;
+
+    bool parseHeader();
+    Vector3D fetch(int keyframe, int layer, int row, int col) const;
+};
+
+} // namespace ethereal
@@ -0,0 +1,286 @@
+#include "CapeMesh.hpp"
+#include "GpuCloth.hpp"
+#include "rlgl.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ethereal {
+
+namespace {
+
+const char* kCapeVertexShader = R"(#version 330
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;     // column ratio, row ratio
+in vec3 vertexNormal;
+in vec4 vertexColor;
+
+uniform mat4 mvp;
+
+out vec3 fragPosition;
+out vec3 fragNormal;
+out vec2 fragGrid;
+out vec4 fragColor;
+
+void main() {
+    fragPosition = vertexPosition;
+    fragNormal = vertexNormal;
+    fragGrid = vertexTexCoord;
+    fragColor = vertexColor;
+    gl_Position = mvp * vec4(vertexPosition, 1.0);
+}
+)";
+
+const char* kCapeFragmentShader = R"(#version 330
+in vec3 fragPosition;
+in vec3 fragNormal;
+in vec2 fragGrid;
+in vec4 fragColor;
+
+uniform vec3 viewPos;
+uniform vec3 sunDir;
+uniform float time;
+uniform float opacity;
+
+out vec4 finalColor;
+
+void main() {
+    // Both sides of the cloth are visible
+    vec3 normal = normalize(fragNormal);
+    if (!gl_FrontFacing) normal = -normal;
+
+    vec3 toCamera = normalize(viewPos - fragPosition);
+    float diffuse = 0.45 + max(dot(normal, sunDir), 0.0) * 0.55;
+    float rim = pow(1.0 - abs(dot(normal, toCamera)), 2.0) * 0.6;
+
+    // Organic energy pulse flowing down the cape
+    float wave = (sin(time * 1.2 + fragGrid.y * 5.0 + fragGrid.x * 3.0) * 0.3 + 0.7)
+               * (sin(time * 0.7 + fragGrid.x * 7.2) * 0.2 + 0.8);
+
+    vec3 color = min(fragColor.rgb * diffuse + vec3(rim), vec3(1.0));
+    finalColor = vec4(color, fragColor.a * opacity * wave);
+}
+)";
+
+bool sameColor(Color a, Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+} // namespace
+
+CapeMesh::CapeMesh(int maxCapes)
+    : maxCapes(std::max(maxCapes, 1)) {}
+
+CapeMesh::~CapeMesh() {
+    unload();
+}
+
+bool CapeMesh::load() {
+    unload();
+
+    shader = LoadShaderFromMemory(kCapeVertexShader, kCapeFragmentShader);
+    if (shader.id == 0) return false;
+
+    locViewPos = GetShaderLocation(shader, "viewPos");
+    locSunDir = GetShaderLocation(shader, "sunDir");
+    locTime = GetShaderLocation(shader, "time");
+    locOpacity = GetShaderLocation(shader, "opacity");
+
+    material = LoadMaterialDefault();
+    material.shader = shader;
+    loaded = true;
+    return true;
+}
+
+void CapeMesh::unload() {
+    releaseGrid();
+    if (!loaded) return;
+    UnloadMaterial(material);   // also releases the shader
+    material = { 0 };
+    shader = { 0 };
+    loaded = false;
+}
+
+void CapeMesh::releaseGrid() {
+    if (meshLoaded) UnloadMesh(mesh);
+    mesh = { 0 };
+    meshLoaded = false;
+    capacity = 0;
+    segments = 0;
+    width = 0;
+    capeCount = 0;
+    deviceCapes.clear();
+}
+
+bool CapeMesh::buildGrid(int gridSegments, int gridWidth) {
+    releaseGrid();
+    if (gridSegments < 2 || gridWidth < 2) return false;
+
+    int vertsPerCape = gridSegments * gridWidth;
+    capacity = std::min(maxCapes, 65535 / vertsPerCape);
+    if (capacity == 0) return false;
+
+    segments = gridSegments;
+    width = gridWidth;
+    int vertexCount = capacity * vertsPerCape;
+    int trisPerCape = (segments - 1) * (width - 1) * 2;
+
+    mesh.vertexCount = vertexCount;
+    mesh.triangleCount = capacity * trisPerCape;
+    mesh.vertices = static_cast<float*>(MemAlloc(vertexCount * 3 * sizeof(float)));
+    mesh.normals = static_cast<float*>(MemAlloc(vertexCount * 3 * sizeof(float)));
+    mesh.texcoords = static_cast<float*>(MemAlloc(vertexCount * 2 * sizeof(float)));
+    mesh.colors = static_cast<unsigned char*>(MemAlloc(vertexCount * 4));
+    mesh.indices = static_cast<unsigned short*>(MemAlloc(capacity * trisPerCape * 3 * sizeof(unsigned short)));
+
+    unsigned short* index = mesh.indices;
+    for (int cape = 0; cape < capacity; ++cape) {
+        int base = cape * vertsPerCape;
+        for (int row = 0; row < segments; ++row) {
+            for (int col = 0; col < width; ++col) {
+                float* uv = mesh.texcoords + (base + row * width + col) * 2;
+                uv[0] = static_cast<float>(col) / (width - 1);
+                uv[1] = static_cast<float>(row) / (segments - 1);
+            }
+        }
+        for (int row = 0; row < segments - 1; ++row) {
+            for (int col = 0; col < width - 1; ++col) {
+                unsigned short a = static_cast<unsigned short>(base + row * width + col);
+                unsigned short b = static_cast<unsigned short>(a + 1);
+                unsigned short c = static_cast<unsigned short>(a + width);
+                unsigned short d = static_cast<unsigned short>(c + 1);
+                *index++ = a; *index++ = c; *index++ = b;
+                *index++ = b; *index++ = c; *index++ = d;
+            }
+        }
+    }
+
+    UploadMesh(&mesh, true);
+    meshLoaded = true;
+    deviceCapes.assign(capacity, nullptr);
+    builtInner = { 0 };
+    builtOuter = { 0 };
+    return true;
+}
+
+void CapeMesh::writeColors(const CapeMeshStyle& style) {
+    int vertsPerCape = segments * width;
+    for (int row = 0; row < segments; ++row) {
+        float rowRatio = static_cast<float>(row) / (segments - 1);
+        // Fade in from nothing at the top and thin out toward the tip
+        float emergeFade = std::min(rowRatio * 4.0f, 1.0f);
+        float tipFade = 1.0f - std::pow(rowRatio, 1.5f) * 0.6f;
+
+        for (int col = 0; col < width; ++col) {
+            float colRatio = static_cast<float>(col) / (width - 1);
+            float edge = std::min(std::abs(colRatio - 0.5f) * 2.0f * 0.7f + rowRatio * 0.3f, 1.0f);
+            float colCenter = 1.0f - std::abs(colRatio - 0.5f) * 1.6f;
+
+            Color c = {
+                (unsigned char)(style.innerColor.r + (style.outerColor.r - style.innerColor.r) * edge),
+                (unsigned char)(style.innerColor.g + (style.outerColor.g - style.innerColor.g) * edge),
+                (unsigned char)(style.innerColor.b + (style.outerColor.b - style.innerColor.b) * edge),
+                (unsigned char)(255 * std::clamp(emergeFade * tipFade * colCenter, 0.0f, 1.0f))
+            };
+            for (int cape = 0; cape < capacity; ++cape) {
+                unsigned char* out = mesh.colors + (cape * vertsPerCape + row * width + col) * 4;
+                out[0] = c.r; out[1] = c.g; out[2] = c.b; out[3] = c.a;
+            }
+        }
+    }
+    UpdateMeshBuffer(mesh, 3, mesh.colors, mesh.vertexCount * 4, 0);
+    builtInner = style.innerColor;
+    builtOuter = style.outerColor;
+}
+
+void CapeMesh::begin() {
+    capeCount = 0;
+}
+
+bool CapeMesh::reserveSlot(int capeSegments, int capeWidth) {
+    if (!loaded) return false;
+    if (capeSegments != segments || capeWidth != width) {
+        if (capeCount > 0) return false;
+        if (!buildGrid(capeSegments, capeWidth)) return false;
+    }
+    return capeCount < capacity;
+}
+
+bool CapeMesh::add(const Cape3D& cape) {
+    if (!reserveSlot(cape.getSegments(), cape.getWidth())) return false;
+
+    const ClothParticles3D& store = cape.getParticleStore();
+    const float* px = store.positionsX();
+    const float* py = store.positionsY();
+    const float* pz = store.positionsZ();
+
+    const float* nx = cape.normalsX();
+    const float* ny = cape.normalsY();
+    const float* nz = cape.normalsZ();
+
+    // Normals were computed by the cape's last solve; this is a straight copy
+    int base = capeCount * segments * width;
+    for (int i = 0; i < segments * width; ++i) {
+        float* v = mesh.vertices + (base + i) * 3;
+        float* n = mesh.normals + (base + i) * 3;
+        v[0] = px[i]; v[1] = py[i]; v[2] = pz[i];
+        n[0] = nx[i]; n[1] = ny[i]; n[2] = nz[i];
+    }
+    deviceCapes[capeCount] = nullptr;
+    capeCount++;
+    return true;
+}
+
+bool CapeMesh::add(GpuCloth& cloth) {
+    if (!cloth.isLoaded() || !reserveSlot(cloth.getSegments(), cloth.getWidth())) return false;
+    deviceCapes[capeCount] = &cloth;
+    capeCount++;
+    return true;
+}
+
+void CapeMesh::uploadHostRange(int first, int last) {
+    if (last <= first) return;
+    int vertsPerCape = segments * width;
+    int offset = first * vertsPerCape * 3 * static_cast<int>(sizeof(float));
+    int size = (last - first) * vertsPerCape * 3 * static_cast<int>(sizeof(float));
+    UpdateMeshBuffer(mesh, 0, mesh.vertices + first * vertsPerCape * 3, size, offset);
+    UpdateMeshBuffer(mesh, 2, mesh.normals + first * vertsPerCape * 3, size, offset);
+}
+
+void CapeMesh::draw(const Vector3D& cameraPosition, const CapeMeshStyle& style, float time) {
+    if (!loaded || !meshLoaded || capeCount == 0) return;
+    if (!sameColor(style.innerColor, builtInner) || !sameColor(style.outerColor, builtOuter)) {
+        writeColors(style);
+    }
+
+    // Host-filled runs are uploaded; GPU-solved capes write their own slots
+    int hostStart = 0;
+    for (int cape = 0; cape < capeCount; ++cape) {
+        if (!deviceCapes[cape]) continue;
+        uploadHostRange(hostStart, cape);
+        deviceCapes[cape]->writeMesh(mesh.vboId[0], mesh.vboId[2], cape * segments * width);
+        hostStart = cape + 1;
+    }
+    uploadHostRange(hostStart, capeCount);
+
+    Vector3D sun = style.sunDirection.normalized();
+    float viewPos[3] = { cameraPosition.x, cameraPosition.y, cameraPosition.z };
+    float sunDir[3] = { sun.x, sun.y, sun.z };
+    SetShaderValue(shader, locViewPos, viewPos, SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, locSunDir, sunDir, SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, locTime, &time, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shader, locOpacity, &style.opacity, SHADER_UNIFORM_FLOAT);
+
+    Mesh pending = mesh;
+    pending.triangleCount = capeCount * (segments - 1) * (width - 1) * 2;
+    Matrix identity = { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1 };
+
+    // Translucent and two-sided
+    rlDrawRenderBatchActive();
+    rlDisableBackfaceCulling();
+    rlDisableDepthMask();
+    DrawMesh(pending, material, identity);
+    rlEnableDepthMask();
+    rlEnableBackfaceCulling();
+}
+
+} // namespace ethereal
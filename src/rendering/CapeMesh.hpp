@@ -0,0 +1,74 @@
+#pragma once
+#include "raylib.h"
+#include "core/Vector3D.hpp"
+#include "physics/Cape3D.hpp"
+#include <vector>
+
+namespace ethereal {
+
+class GpuCloth;
+
+struct CapeMeshStyle {
+    Color innerColor = {230, 180, 140, 255};    // Center columns
+    Color outerColor = {255, 220, 180, 255};    // Side edges and tip
+    float opacity = 0.55f;
+    Vector3D sunDirection = Vector3D(0.5f, 0.8f, 0.3f);
+};
+
+// Cape surfaces streamed into one persistent dynamic mesh. The index buffer,
+// colors and texcoords are built once per grid size; each frame only positions
+// and normals are rewritten, normals copied from the cape's own buffer. Several capes with the same grid share a single draw call.
+// GpuCloth capes fill their slots from compute, without a trip through the CPU.
+class CapeMesh {
+public:
+    // 16-bit indices bound the batch; fewer capes fit when the grid is large
+    explicit CapeMesh(int maxCapes = 4);
+    ~CapeMesh();
+
+    CapeMesh(const CapeMesh&) = delete;
+    CapeMesh& operator=(const CapeMesh&) = delete;
+
+    // Requires an open window
+    bool load();
+    void unload();
+    bool isLoaded() const { return loaded; }
+
+    void begin();
+    // False when the batch is full or the grid differs from the batch's; draw and begin again
+    bool add(const Cape3D& cape);
+    // Compute-solved cape: draw() has it write its slot of the VBOs on the GPU
+    bool add(GpuCloth& cloth);
+    // Call between BeginMode3D/EndMode3D
+    void draw(const Vector3D& cameraPosition, const CapeMeshStyle& style, float time);
+
+    int getCapeCount() const { return capeCount; }
+
+private:
+    int maxCapes;
+    int capacity = 0;           // Capes the current grid buffers hold
+    int segments = 0;
+    int width = 0;
+    int capeCount = 0;
+    std::vector<GpuCloth*> deviceCapes;     // Per slot; null when the slot was filled on the host
+
+    Mesh mesh = { 0 };
+    bool meshLoaded = false;
+    Shader shader = { 0 };
+    Material material = { 0 };
+    bool loaded = false;
+    Color builtInner = { 0 };
+    Color builtOuter = { 0 };
+
+    int locViewPos = -1;
+    int locSunDir = -1;
+    int locTime = -1;
+    int locOpacity = -1;
+
+    bool reserveSlot(int capeSegments, int capeWidth);
+    void uploadHostRange(int first, int last);
+    bool buildGrid(int gridSegments, int gridWidth);
+    void releaseGrid();
+    void writeColors(const CapeMeshStyle& style);
+};
+
+} // namespace ethereal
@@ -1,4 +1,6 @@
 #include "EnergyBeingRenderer.hpp"
+#include "utils/MemoryTracker.hpp"
+#include "utils/Profiler.hpp"
 #include "rlgl.h"
 #include <algorithm>
 #include <random>
@@ -84,10 +86,14 @@ void EnergyBeingRenderer::createOrbs() {
 }
 
 void EnergyBeingRenderer::update(float dt, const Character3D& character) {
+    update(dt, character.getState());
+}
+
+void EnergyBeingRenderer::update(float dt, const CharacterState3D& state) {
     time += dt;
     
-    Vector3D currentPos = character.getPosition();
-    Vector3D currentVel = character.getVelocity();
+    Vector3D currentPos = state.position;
+    Vector3D currentVel = state.velocity;
     float speed = currentVel.length();
     
     // Smooth velocity for more organic response
@@ -168,27 +174,45 @@ void EnergyBeingRenderer::updateOrbPositions(float dt, float speed, const Vector
 }
 
 void EnergyBeingRenderer::render(const Character3D& character) {
-    Vector3D center = character.getPosition();
-    float speed = character.getVelocity().length();
+    render(character.getState());
+}
+
+void EnergyBeingRenderer::render(const CharacterState3D& state) {
+    if (!glow.isLoaded()) glow.load();
+    glow.begin();
+    render(state, glow);
+    
+    // Translucent sprites blend; keep them out of the depth buffer
+    rlDisableDepthMask();
+    glow.flush();
+    rlEnableDepthMask();
+}
+
+void EnergyBeingRenderer::render(const CharacterState3D& state, GlowBatch& batch) {
+    PROFILE_SCOPE("EnergyBeingRenderer::render");
+    MEMORY_TAG(Rendering);
+    Vector3D center = state.position;
+    float speed = state.velocity.length();
     float speedFactor = std::min(speed / 150.0f, 1.0f);
+    if (viewCuller && !viewCuller->isVisible(center, getBoundingRadius(speedFactor))) return;
     
-    // Render glow first (background)
-    renderGlow(center, speedFactor);
+    // Sprites draw in the order added: glow first (background)
+    renderGlow(batch, center, speedFactor);
     
-    // Render connections between nearby orbs
-    renderConnections(center, speedFactor);
+    // Connections between nearby orbs
+    renderConnections(batch, center, speedFactor);
     
-    // Render orbs back to front (outer first, core last)
+    // Orbs back to front (outer first, core last)
     for (int layer = 2; layer >= 0; --layer) {
         for (const auto& orb : orbs) {
             if (orb.layer == layer) {
-                renderOrb(orb, center, speedFactor);
+                renderOrb(batch, orb, center, speedFactor);
             }
         }
     }
 }
 
-void EnergyBeingRenderer::renderOrb(const EnergyOrb& orb, const Vector3D& center, float speedFactor) {
+void EnergyBeingRenderer::renderOrb(GlowBatch& batch, const EnergyOrb& orb, const Vector3D& center, float speedFactor) {
     Vector3D worldPos = center + orb.localPosition;
     
     // Size pulses slightly
@@ -206,106 +230,93 @@ void EnergyBeingRenderer::renderOrb(const EnergyOrb& orb, const Vector3D& center
     float brightness = orb.brightness;
     
     // === STRONG MULTI-LAYER GLOW ===
-    // Outermost bloom (very large, subtle)
-    DrawSphere({worldPos.x, worldPos.y, worldPos.z}, radius * 5.0f, 
-               {255, 200, 100, (unsigned char)(25 * brightness)});
-    
-    // Outer glow
-    DrawSphere({worldPos.x, worldPos.y, worldPos.z}, radius * 3.5f, 
-               {255, 220, 150, (unsigned char)(40 * brightness)});
-    
-    // Mid glow
-    DrawSphere({worldPos.x, worldPos.y, worldPos.z}, radius * 2.2f, 
-               {255, 235, 180, (unsigned char)(80 * brightness)});
-    
-    // Inner glow
-    DrawSphere({worldPos.x, worldPos.y, worldPos.z}, radius * 1.5f, 
-               {255, 245, 210, (unsigned char)(140 * brightness)});
-    
-    // Core
-    DrawSphere({worldPos.x, worldPos.y, worldPos.z}, radius, 
-               {baseColor.r, baseColor.g, baseColor.b, baseColor.a});
+    // Wide faint bloom, then the solid core inside a brighter inner glow
+    batch.add(worldPos, radius * 5.0f, {255, 205, 120, (unsigned char)(60 * brightness)});
+    batch.add(worldPos, radius, baseColor, radius * 2.2f, {255, 240, 195, (unsigned char)(170 * brightness)});
     
     // Bright hot center
     if (orb.layer == 0) {
-        DrawSphere({worldPos.x, worldPos.y, worldPos.z}, radius * 0.6f, 
-                   {255, 255, 255, 255});
-        DrawSphere({worldPos.x, worldPos.y, worldPos.z}, radius * 0.3f, 
-                   {255, 255, 255, 255});
+        batch.add(worldPos, radius * 0.6f, {255, 255, 255, 255});
     } else if (orb.layer == 1) {
-        DrawSphere({worldPos.x, worldPos.y, worldPos.z}, radius * 0.5f, 
-                   {255, 255, 245, 230});
+        batch.add(worldPos, radius * 0.5f, {255, 255, 245, 230});
     }
 }
 
-void EnergyBeingRenderer::renderGlow(const Vector3D& center, float speedFactor) {
+void EnergyBeingRenderer::renderGlow(GlowBatch& batch, const Vector3D& center, float speedFactor) {
     // Strong ambient glow - very visible in dark
-    float glowPulse = 1.0f + std::sin(time * 1.5f) * 0.15f;
-    float glowSize = 18.0f * glowPulse * (1.0f + speedFactor * 0.4f);
+    float glowSize = getGlowSize(speedFactor);
     
-    // === MASSIVE MULTI-LAYER GLOW FOR VISIBILITY ===
-    // Outermost atmospheric glow
-    DrawSphere({center.x, center.y, center.z}, glowSize * 4.0f, 
-               {255, 180, 80, 10});
-    DrawSphere({center.x, center.y, center.z}, glowSize * 3.0f, 
-               {255, 200, 100, 18});
-    DrawSphere({center.x, center.y, center.z}, glowSize * 2.2f, 
-               {255, 215, 130, 30});
-    DrawSphere({center.x, center.y, center.z}, glowSize * 1.6f, 
-               {255, 230, 160, 45});
-    DrawSphere({center.x, center.y, center.z}, glowSize * 1.2f, 
-               {255, 240, 190, 60});
-    DrawSphere({center.x, center.y, center.z}, glowSize * 0.9f, 
-               {255, 250, 220, 80});
+    // === LAYERED GLOW FOR VISIBILITY ===
+    // Outer atmosphere, then a warmer inner body
+    batch.add(center, glowSize * 4.0f, {255, 190, 90, 45});
+    batch.add(center, glowSize * 0.9f, {255, 250, 220, 110}, glowSize * 2.2f, {255, 225, 150, 80});
     
     // Speed-based energy burst
     if (speedFactor > 0.3f) {
         float burstIntensity = (speedFactor - 0.3f) / 0.7f;
         float burstAlpha = burstIntensity * 50.0f;
-        DrawSphere({center.x, center.y, center.z}, glowSize * 2.5f, 
-                   {255, 220, 150, (unsigned char)burstAlpha});
-        DrawSphere({center.x, center.y, center.z}, glowSize * 3.5f, 
-                   {255, 200, 100, (unsigned char)(burstAlpha * 0.4f)});
+        batch.add(center, glowSize * 2.5f, {255, 220, 150, (unsigned char)burstAlpha},
+                  glowSize * 3.5f, {255, 200, 100, (unsigned char)(burstAlpha * 0.4f)});
     }
 }
 
-void EnergyBeingRenderer::renderConnections(const Vector3D& center, float speedFactor) {
+float EnergyBeingRenderer::getGlowSize(float speedFactor) const {
+    float glowPulse = 1.0f + std::sin(time * 1.5f) * 0.15f;
+    return 18.0f * glowPulse * (1.0f + speedFactor * 0.4f);
+}
+
+float EnergyBeingRenderer::getBoundingRadius(float speedFactor) const {
+    // Outer atmosphere sprite, or the furthest orb's bloom (radius * 5 at peak pulse)
+    float radius = getGlowSize(speedFactor) * 4.0f;
+    for (const EnergyOrb& orb : orbs) {
+        radius = std::max(radius, orb.localPosition.length() + orb.radius * orb.brightness * 1.3f * 1.15f * 5.0f);
+    }
+    return radius;
+}
+
+void EnergyBeingRenderer::renderConnections(GlowBatch& batch, const Vector3D& center, float speedFactor) {
     // When merged (low speed), draw soft connections between close orbs
     if (speedFactor > 0.7f) return; // Skip when moving fast
     
     float connectionStrength = 1.0f - speedFactor * 1.3f;
     connectionStrength = std::max(0.0f, connectionStrength);
     
-    for (size_t i = 0; i < orbs.size(); ++i) {
-        for (size_t j = i + 1; j < orbs.size(); ++j) {
-            const EnergyOrb& a = orbs[i];
-            const EnergyOrb& b = orbs[j];
+    // Sweep along x: once the x gap exceeds the widest possible link, no later orb can connect
+    float maxRadius = 0.0f;
+    for (const EnergyOrb& orb : orbs) maxRadius = std::max(maxRadius, orb.radius);
+    float neighborRadius = maxRadius * 2.0f * config.connectionReach;
+    
+    sweepOrder.resize(orbs.size());
+    for (size_t i = 0; i < orbs.size(); ++i) sweepOrder[i] = static_cast<uint32_t>(i);
+    std::sort(sweepOrder.begin(), sweepOrder.end(), [&](uint32_t a, uint32_t b) {
+        return orbs[a].localPosition.x < orbs[b].localPosition.x;
+    });
+    
+    for (size_t i = 0; i < sweepOrder.size(); ++i) {
+        const EnergyOrb& a = orbs[sweepOrder[i]];
+        for (size_t j = i + 1; j < sweepOrder.size(); ++j) {
+            const EnergyOrb& b = orbs[sweepOrder[j]];
+            if (b.localPosition.x - a.localPosition.x > neighborRadius) break;
             
             // Only connect orbs that are close
-            float dist = (a.localPosition - b.localPosition).length();
-            float maxDist = (a.radius + b.radius) * 5.0f;
+            float maxDist = (a.radius + b.radius) * config.connectionReach;
+            float distSq = (a.localPosition - b.localPosition).lengthSquared();
+            if (distSq >= maxDist * maxDist) continue;
             
-            if (dist < maxDist) {
-                float proximity = 1.0f - dist / maxDist;
-                float alpha = proximity * connectionStrength * 120.0f;  // Brighter connections
-                if (alpha < 8.0f) continue;
-                
-                Vector3D worldA = center + a.localPosition;
-                Vector3D worldB = center + b.localPosition;
-                Vector3D mid = (worldA + worldB) * 0.5f;
+            float proximity = 1.0f - std::sqrt(distSq) / maxDist;
+            float alpha = proximity * connectionStrength * 120.0f;  // Brighter connections
+            if (alpha < 8.0f) continue;
+            
+            Vector3D worldA = center + a.localPosition;
+            Vector3D worldB = center + b.localPosition;
+            
+            // Multiple interpolation points for smooth connection
+            for (float t = 0.25f; t <= 0.75f; t += 0.25f) {
+                Vector3D point = worldA + (worldB - worldA) * t;
+                float pointSize = (a.radius + b.radius) * 0.4f * proximity * (1.0f - std::abs(t - 0.5f) * 1.5f);
                 
-                // Multiple interpolation points for smooth connection
-                for (float t = 0.25f; t <= 0.75f; t += 0.25f) {
-                    Vector3D point = worldA + (worldB - worldA) * t;
-                    float pointSize = (a.radius + b.radius) * 0.4f * proximity * (1.0f - std::abs(t - 0.5f) * 1.5f);
-                    
-                    DrawSphere({point.x, point.y, point.z}, pointSize * 2.5f, 
-                              {255, 220, 150, (unsigned char)(alpha * 0.3f)});
-                    DrawSphere({point.x, point.y, point.z}, pointSize * 1.5f, 
-                              {255, 240, 200, (unsigned char)(alpha * 0.6f)});
-                    DrawSphere({point.x, point.y, point.z}, pointSize, 
-                              {255, 250, 230, (unsigned char)alpha});
-                }
+                batch.add(point, pointSize, {255, 250, 230, (unsigned char)alpha},
+                          pointSize * 2.5f, {255, 225, 170, (unsigned char)(alpha * 0.5f)});
             }
         }
     }
@@ -2,6 +2,9 @@
 #include "raylib.h"
 #include "core/Vector3D.hpp"
 #include "entities/Character3D.hpp"
+#include "rendering/GlowBatch.hpp"
+#include "rendering/ViewCuller.hpp"
+#include <cstdint>
 #include <vector>
 #include <cmath>
 
@@ -43,6 +46,7 @@ struct EnergyBeingConfig {
     float glowIntensity = 0.8f;
     float pulseSpeed = 2.0f;
     float trailLength = 0.3f;        // Trail behind moving orbs
+    float connectionReach = 5.0f;    // Orbs link within (radiusA + radiusB) * reach
     
     // Colors (warm energy palette)
     Color coreColor = {255, 255, 250, 255};
@@ -59,6 +63,15 @@ public:
     void initialize();
     void update(float dt, const Character3D& character);
     void render(const Character3D& character);
+    // Same, from an interpolated snapshot instead of the live character
+    void update(float dt, const CharacterState3D& state);
+    void render(const CharacterState3D& state);
+    // Appends this being's sprites to a shared batch so many beings draw together;
+    // the caller owns begin()/flush() and the depth/blend state
+    void render(const CharacterState3D& state, GlowBatch& batch);
+    
+    // Beings whose outermost glow is outside the culler's view are skipped
+    void setViewCuller(const ViewCuller* culler) { viewCuller = culler; }
     
     void setConfig(const EnergyBeingConfig& cfg) { config = cfg; }
     const EnergyBeingConfig& getConfig() const { return config; }
@@ -71,11 +84,17 @@ private:
     Vector3D lastPosition;
     Vector3D smoothedVelocity;
     
+    GlowBatch glow;
+    const ViewCuller* viewCuller = nullptr;
+    std::vector<uint32_t> sweepOrder;   // Orb indices sorted by x for connection pruning
+    
     void createOrbs();
     void updateOrbPositions(float dt, float speed, const Vector3D& velocity);
-    void renderOrb(const EnergyOrb& orb, const Vector3D& center, float speedFactor);
-    void renderGlow(const Vector3D& center, float speedFactor);
-    void renderConnections(const Vector3D& center, float speedFactor);
+    void renderOrb(GlowBatch& batch, const EnergyOrb& orb, const Vector3D& center, float speedFactor);
+    void renderGlow(GlowBatch& batch, const Vector3D& center, float speedFactor);
+    void renderConnections(GlowBatch& batch, const Vector3D& center, float speedFactor);
+    float getGlowSize(float speedFactor) const;
+    float getBoundingRadius(float speedFactor) const;
     
     // Smooth interpolation helpers
     float smoothstep(float edge0, float edge1, float x);
@@ -1,4 +1,6 @@
 #include "EnvironmentRenderer.hpp"
+#include "utils/MemoryTracker.hpp"
+#include "utils/Profiler.hpp"
 #include "rlgl.h"
 #include <algorithm>
 #include <cmath>
@@ -15,30 +17,6 @@ EnvironmentRenderer::EnvironmentRenderer(const EnvironmentConfig& cfg)
 
 void EnvironmentRenderer::initialize() {
     initParticles(Vector3D::zero());
-    initStars();
-}
-
-void EnvironmentRenderer::initStars() {
-    starPositions.clear();
-    starBrightnesses.clear();
-    
-    for (int i = 0; i < config.starCount; ++i) {
-        // Random position on a sphere
-        float theta = GetRandomValue(0, 628) * 0.01f;
-        float phi = std::acos(1.0f - 2.0f * GetRandomValue(0, 1000) / 1000.0f);
-        
-        Vector3D pos(
-            std::sin(phi) * std::cos(theta),
-            std::cos(phi),
-            std::sin(phi) * std::sin(theta)
-        );
-        
-        // Only keep stars in upper hemisphere
-        if (pos.y > -0.1f) {
-            starPositions.push_back(pos * 800.0f);  // Far distance
-            starBrightnesses.push_back(0.3f + GetRandomValue(0, 70) / 100.0f);
-        }
-    }
 }
 
 void EnvironmentRenderer::initParticles(const Vector3D& center) {
@@ -62,6 +40,8 @@ void EnvironmentRenderer::initParticles(const Vector3D& center) {
 }
 
 void EnvironmentRenderer::update(float dt, const Vector3D& cameraPos, const WindField3D& wind) {
+    PROFILE_SCOPE("EnvironmentRenderer::update");
+    MEMORY_TAG(Rendering);
     time += dt;
     updateParticles(dt, cameraPos, wind);
 }
@@ -101,146 +81,148 @@ void EnvironmentRenderer::updateParticles(float dt, const Vector3D& cameraPos, c
 }
 
 void EnvironmentRenderer::renderSky(const FlightCamera& camera, float gameTime) {
-    int screenWidth = GetScreenWidth();
-    int screenHeight = GetScreenHeight();
-    
-    // Dark night sky gradient
-    for (int y = 0; y < screenHeight; ++y) {
-        float t = static_cast<float>(y) / screenHeight;
-        t = t * t * (3.0f - 2.0f * t);
-        Color lineColor = blendColors(config.skyColorZenith, config.skyColorHorizon, t);
-        DrawLine(0, y, screenWidth, y, lineColor);
-    }
+    PROFILE_SCOPE("EnvironmentRenderer::renderSky");
+    MEMORY_TAG(Rendering);
+    if (!sky.isLoaded()) sky.load();
+    sky.draw(camera.getPosition(), camera.getTarget(), 65.0f, makeSkyShading(), gameTime);
 }
 
-void EnvironmentRenderer::renderMoonAndStars(const FlightCamera& camera, float gameTime) {
-    Vector3D camPos = camera.getPosition();
+void EnvironmentRenderer::renderTerrain(const Terrain& terrain, const FlightCamera& camera) {
+    if (!terrainShader.isLoaded()) terrainShader.load();
+    if (terrainMesh.isStale(terrain)) {
+        terrainMesh.upload(terrain, [this](float normalizedHeight, const Vector3D& faceNormal) {
+            return getTerrainColor(normalizedHeight, faceNormal.y);
+        });
+    }
+    
+    TerrainShading shading = makeTerrainShading();
     
     BeginMode3D({
-        {camPos.x, camPos.y, camPos.z},
+        {camera.getPosition().x, camera.getPosition().y, camera.getPosition().z},
         {camera.getTarget().x, camera.getTarget().y, camera.getTarget().z},
         {0, 1, 0}, 65.0f, CAMERA_PERSPECTIVE
     });
+    terrainShader.apply(camera.getPosition(), shading);
+    terrainMesh.draw(terrainShader);
+    EndMode3D();
+}
+
+void EnvironmentRenderer::renderTerrain(const TerrainStreamer& streamer, const FlightCamera& camera) {
+    PROFILE_SCOPE("EnvironmentRenderer::renderTerrain");
+    MEMORY_TAG(Rendering);
+    if (!terrainShader.isLoaded()) terrainShader.load();
     
-    rlDisableDepthMask();
-    rlDisableDepthTest();
+    const auto& chunks = streamer.getResidentChunks();
+    const TerrainConfig& terrainConfig = streamer.getTerrain().getConfig();
     
-    // === STARS ===
-    for (size_t i = 0; i < starPositions.size(); ++i) {
-        Vector3D starPos = camPos + starPositions[i];
-        float brightness = starBrightnesses[i];
-        
-        // Twinkling effect
-        float twinkle = std::sin(gameTime * (2.0f + i * 0.1f) + i * 0.5f);
-        twinkle = twinkle * 0.3f + 0.7f;
-        brightness *= twinkle * config.starBrightness;
-        
-        unsigned char alpha = (unsigned char)(brightness * 255);
-        float size = 0.8f + brightness * 1.2f;
-        
-        // Star core
-        DrawSphere({starPos.x, starPos.y, starPos.z}, size, {255, 255, 255, alpha});
-        // Subtle glow
-        DrawSphere({starPos.x, starPos.y, starPos.z}, size * 2.5f, {200, 220, 255, (unsigned char)(alpha / 5)});
+    // Drop meshes whose chunk was evicted
+    for (auto it = chunkMeshes.begin(); it != chunkMeshes.end();) {
+        const int64_t key = it->first;
+        bool stillResident = std::any_of(chunks.begin(), chunks.end(), [key](const TerrainChunk* chunk) {
+            return TerrainStreamer::chunkKey(chunk->chunkX, chunk->chunkZ) == key;
+        });
+        it = stillResident ? std::next(it) : chunkMeshes.erase(it);
     }
     
-    // === MOON ===
-    if (config.enableMoon) {
-        Vector3D moonDir = config.moonDirection.normalized();
-        Vector3D moonPos = camPos + moonDir * 700.0f;
-        
-        float moonPulse = 1.0f + std::sin(gameTime * 0.2f) * 0.02f;
-        
-        // Moon glow layers (soft ethereal glow)
-        DrawSphere({moonPos.x, moonPos.y, moonPos.z}, config.moonGlowSize * 3.0f * moonPulse, {180, 200, 255, 8});
-        DrawSphere({moonPos.x, moonPos.y, moonPos.z}, config.moonGlowSize * 2.0f * moonPulse, {200, 215, 255, 15});
-        DrawSphere({moonPos.x, moonPos.y, moonPos.z}, config.moonGlowSize * 1.3f * moonPulse, {210, 225, 255, 30});
-        DrawSphere({moonPos.x, moonPos.y, moonPos.z}, config.moonGlowSize * moonPulse, {220, 235, 255, 50});
-        
-        // Moon body
-        DrawSphere({moonPos.x, moonPos.y, moonPos.z}, config.moonSize * 1.2f, {230, 240, 255, 180});
-        DrawSphere({moonPos.x, moonPos.y, moonPos.z}, config.moonSize, config.moonColor);
-        
-        // Bright center
-        DrawSphere({moonPos.x, moonPos.y, moonPos.z}, config.moonSize * 0.7f, {240, 245, 255, 255});
-    }
+    Vector3D camPos = camera.getPosition();
+    float chunkSize = streamer.getTerrain().getChunkSize();
+    float cullDistance = config.terrainViewDistance + chunkSize * 0.75f;
+    auto palette = [this](float normalizedHeight, const Vector3D& faceNormal) {
+        return getTerrainColor(normalizedHeight, faceNormal.y);
+    };
     
-    rlEnableDepthTest();
-    rlEnableDepthMask();
+    TerrainLodSettings lod;
+    lod.leafTiles = config.terrainLodPatchTiles;
+    lod.baseRange = config.terrainLodDistance;
+    lod.morphStart = config.terrainLodMorphStart;
+    
+    terrainShader.apply(camPos, makeTerrainShading());
+    terrainTrianglesDrawn = 0;
+    
+    // Every resident chunk can hide another, including ones not drawn yet
+    if (viewCuller) {
+        for (const TerrainChunk* chunk : chunks) {
+            viewCuller->addOccluders(chunk->heights);
+        }
+    }
     
-    EndMode3D();
-}
-
-void EnvironmentRenderer::renderTerrain(const Terrain& terrain, const FlightCamera& camera) {
     BeginMode3D({
-        {camera.getPosition().x, camera.getPosition().y, camera.getPosition().z},
+        {camPos.x, camPos.y, camPos.z},
         {camera.getTarget().x, camera.getTarget().y, camera.getTarget().z},
         {0, 1, 0}, 65.0f, CAMERA_PERSPECTIVE
     });
     
-    const auto& vertices = terrain.getVertices();
-    const auto& indices = terrain.getIndices();
-    const auto& terrainConfig = terrain.getConfig();
-    
-    Vector3D camPos = camera.getPosition();
-    Vector3D sunDir = config.sunDirection.normalized();
-    
-    for (size_t i = 0; i < indices.size(); i += 3) {
-        const auto& v0 = vertices[indices[i]];
-        const auto& v1 = vertices[indices[i + 1]];
-        const auto& v2 = vertices[indices[i + 2]];
-        
-        Vector3D center = (v0.position + v1.position + v2.position) * (1.0f / 3.0f);
-        float dist = (center - camPos).length();
-        
-        if (dist > config.terrainViewDistance) continue;
-        
-        // Face normal for lighting
-        Vector3D edge1 = v1.position - v0.position;
-        Vector3D edge2 = v2.position - v0.position;
-        Vector3D faceNormal = edge1.cross(edge2).normalized();
-        
-        // Lighting
-        float diffuse = std::max(0.0f, faceNormal.dot(sunDir));
-        diffuse = 0.35f + diffuse * 0.65f;
-        
-        // Rim lighting
-        Vector3D toCamera = (camPos - center).normalized();
-        float rim = 1.0f - std::max(0.0f, faceNormal.dot(toCamera));
-        rim = std::pow(rim, 2.5f) * 0.12f;
-        
-        // Height-based color
-        float avgHeight = (v0.height + v1.height + v2.height) / 3.0f;
-        float normalizedHeight = std::clamp((avgHeight - terrainConfig.baseHeight) / terrainConfig.maxHeight, 0.0f, 1.0f);
-        
-        Color baseColor = getTerrainColor(normalizedHeight, faceNormal.y);
-        
-        // Apply lighting
-        float light = std::clamp(diffuse + rim, 0.0f, 1.2f);
-        baseColor.r = (unsigned char)std::clamp((int)(baseColor.r * light), 0, 255);
-        baseColor.g = (unsigned char)std::clamp((int)(baseColor.g * light), 0, 255);
-        baseColor.b = (unsigned char)std::clamp((int)(baseColor.b * light), 0, 255);
-        
-        // Apply fog
-        Color finalColor = applyFog(baseColor, dist, center.y);
-        
-        DrawTriangle3D(
-            {v0.position.x, v0.position.y, v0.position.z},
-            {v1.position.x, v1.position.y, v1.position.z},
-            {v2.position.x, v2.position.y, v2.position.z},
-            finalColor
-        );
-        DrawTriangle3D(
-            {v0.position.x, v0.position.y, v0.position.z},
-            {v2.position.x, v2.position.y, v2.position.z},
-            {v1.position.x, v1.position.y, v1.position.z},
-            finalColor
-        );
+    // Chunks arrive nearest-first, so the upload budget goes to what the player sees
+    int uploads = 0;
+    for (const TerrainChunk* chunk : chunks) {
+        float centerX = (chunk->chunkX + 0.5f) * chunkSize - camPos.x;
+        float centerZ = (chunk->chunkZ + 0.5f) * chunkSize - camPos.z;
+        if (centerX * centerX + centerZ * centerZ > cullDistance * cullDistance) continue;
+        
+        auto& mesh = chunkMeshes[TerrainStreamer::chunkKey(chunk->chunkX, chunk->chunkZ)];
+        if (!mesh) {
+            if (uploads >= config.maxChunkUploadsPerFrame) continue;
+            mesh = std::make_unique<TerrainLodMesh>();
+            mesh->build(*chunk, terrainConfig, palette, lod);
+            ++uploads;
+        }
+        terrainTrianglesDrawn += mesh->draw(terrainShader, camPos, config.terrainViewDistance, viewCuller);
     }
     
     EndMode3D();
 }
 
+bool EnvironmentRenderer::isVisible(const Vector3D& center, float radius) const {
+    return !viewCuller || viewCuller->isVisible(center, radius);
+}
+
+TerrainShading EnvironmentRenderer::makeTerrainShading() const {
+    // Same lighting and night fog as applyFog(), evaluated per pixel
+    TerrainShading shading;
+    shading.sunDirection = config.sunDirection;
+    shading.ambient = 0.35f;
+    shading.diffuse = 0.65f;
+    shading.rimStrength = 0.12f;
+    shading.rimPower = 2.5f;
+    shading.maxLight = 1.2f;
+    shading.fogStart = config.fogStart;
+    shading.fogEnd = config.fogEnd;
+    shading.fogAmount = 0.9f;
+    shading.fogHeightRange = 250.0f;
+    shading.fogColorLow = {15, 18, 30, 255};
+    shading.fogColorHigh = {20, 25, 40, 255};
+    shading.viewDistance = config.terrainViewDistance;
+    return shading;
+}
+
+SkyShading EnvironmentRenderer::makeSkyShading() const {
+    SkyShading shading;
+    shading.zenithColor = config.skyColorZenith;
+    shading.horizonColor = config.skyColorHorizon;
+    shading.sunEnabled = config.showSun;
+    shading.sunDirection = config.sunDirection;
+    shading.sunColor = config.sunColor;
+    shading.sunSize = config.sunSize;
+    shading.sunGlowSize = config.sunGlowSize;
+    shading.moonEnabled = config.enableMoon;
+    shading.moonDirection = config.moonDirection;
+    shading.moonColor = config.moonColor;
+    shading.moonSize = config.moonSize;
+    shading.moonGlowSize = config.moonGlowSize;
+    shading.starCount = config.starCount;
+    shading.starBrightness = config.starBrightness;
+    shading.scattering = config.skyScattering;
+    return shading;
+}
+
+void EnvironmentRenderer::shutdown() {
+    sky.unload();
+    glow.unload();
+    chunkMeshes.clear();
+    terrainMesh.unload();
+    terrainShader.unload();
+}
+
 Color EnvironmentRenderer::getTerrainColor(float height, float steepness) {
     // Dark night palette - cool blues and purples
     if (height > 0.82f) {
@@ -300,6 +282,9 @@ void EnvironmentRenderer::renderClouds(const FlightCamera& camera, float gameTim
     
     Vector3D camPos = camera.getPosition();
     
+    if (!glow.isLoaded()) glow.load();
+    glow.begin();
+    
     for (int layer = 0; layer < config.cloudLayers; ++layer) {
         float layerHeight = config.cloudBaseHeight + layer * config.cloudLayerSpacing;
         float layerRadius = 400.0f + layer * 100.0f;
@@ -314,12 +299,12 @@ void EnvironmentRenderer::renderClouds(const FlightCamera& camera, float gameTim
             float y = layerHeight + std::sin(angle * 1.3f + gameTime * 0.06f) * 10.0f;
             
             float baseSize = 55.0f + (i % 4) * 12.0f - layer * 6.0f;
+            if (!isVisible({x, y, z}, baseSize * 1.4f)) continue;
             unsigned char alpha = (unsigned char)(28 * layerAlpha);
             
             // Soft layered cloud
-            DrawSphere({x, y, z}, baseSize * 0.5f, {255, 253, 250, (unsigned char)(alpha * 1.3f)});
-            DrawSphere({x, y, z}, baseSize * 0.75f, {255, 252, 248, (unsigned char)(alpha * 0.8f)});
-            DrawSphere({x, y, z}, baseSize, {255, 250, 245, (unsigned char)(alpha * 0.4f)});
+            glow.add({x, y, z}, baseSize * 0.6f, {255, 253, 250, (unsigned char)(alpha * 1.8f)},
+                     baseSize, {255, 250, 245, (unsigned char)(alpha * 1.2f)});
             
             // Puffs
             for (int p = 0; p < 3; ++p) {
@@ -329,8 +314,8 @@ void EnvironmentRenderer::renderClouds(const FlightCamera& camera, float gameTim
                 float py = y + std::sin(pAngle * 2.0f) * baseSize * 0.2f;
                 float pSize = baseSize * (0.35f + (p % 2) * 0.1f);
                 
-                DrawSphere({px, py, pz}, pSize * 0.6f, {255, 252, 248, (unsigned char)(alpha * 0.9f)});
-                DrawSphere({px, py, pz}, pSize, {255, 250, 245, (unsigned char)(alpha * 0.5f)});
+                glow.add({px, py, pz}, pSize * 0.6f, {255, 252, 248, (unsigned char)(alpha * 1.2f)},
+                         pSize, {255, 250, 245, (unsigned char)(alpha * 0.5f)});
             }
         }
     }
@@ -343,16 +328,22 @@ void EnvironmentRenderer::renderClouds(const FlightCamera& camera, float gameTim
         float z = camPos.z + std::sin(angle) * radius;
         float y = 350.0f + (i % 4) * 20.0f;
         float size = 80.0f + (i % 2) * 25.0f;
+        if (!isVisible({x, y, z}, size)) continue;
         
-        DrawSphere({x, y, z}, size * 0.35f, {248, 250, 255, 15});
-        DrawSphere({x, y, z}, size * 0.6f, {245, 248, 255, 8});
-        DrawSphere({x, y, z}, size, {242, 245, 255, 4});
+        glow.add({x, y, z}, size * 0.4f, {248, 250, 255, 20}, size, {242, 245, 255, 12});
     }
     
+    // Translucent layers blend; keep them out of the depth buffer
+    rlDisableDepthMask();
+    glow.flush();
+    rlEnableDepthMask();
+    
     EndMode3D();
 }
 
 void EnvironmentRenderer::renderAtmosphere(const FlightCamera& camera, float dt) {
+    PROFILE_SCOPE("EnvironmentRenderer::renderAtmosphere");
+    MEMORY_TAG(Rendering);
     BeginMode3D({
         {camera.getPosition().x, camera.getPosition().y, camera.getPosition().z},
         {camera.getTarget().x, camera.getTarget().y, camera.getTarget().z},
@@ -361,6 +352,9 @@ void EnvironmentRenderer::renderAtmosphere(const FlightCamera& camera, float dt)
     
     Vector3D camPos = camera.getPosition();
     
+    if (!glow.isLoaded()) glow.load();
+    glow.begin();
+    
     for (size_t i = 0; i < particles.size(); ++i) {
         const auto& p = particles[i];
         
@@ -368,6 +362,7 @@ void EnvironmentRenderer::renderAtmosphere(const FlightCamera& camera, float dt)
         float distFade = 1.0f - std::pow(std::min(dist / config.particleSpawnRadius, 1.0f), 1.3f);
         
         if (distFade < 0.05f) continue;
+        if (!isVisible(p.position, p.size * 2.5f)) continue;
         
         float phase = time * 2.0f + i * 0.5f;
         
@@ -376,8 +371,7 @@ void EnvironmentRenderer::renderAtmosphere(const FlightCamera& camera, float dt)
             float pulse = 0.75f + 0.25f * std::sin(phase * 0.4f);
             unsigned char alpha = (unsigned char)(p.alpha * distFade * 140 * pulse);
             if (alpha > 6) {
-                DrawSphere({p.position.x, p.position.y, p.position.z}, p.size * 0.7f, {255, 248, 235, alpha});
-                DrawSphere({p.position.x, p.position.y, p.position.z}, p.size * 1.5f, {255, 242, 220, (unsigned char)(alpha / 4)});
+                glow.add(p.position, p.size * 0.7f, {255, 248, 235, alpha}, p.size * 1.5f, {255, 242, 220, (unsigned char)(alpha / 4)});
             }
         } else if (p.type == 1) {
             // Sparkles
@@ -388,8 +382,7 @@ void EnvironmentRenderer::renderAtmosphere(const FlightCamera& camera, float dt)
                 unsigned char alpha = (unsigned char)(p.alpha * distFade * 200 * intensity);
                 if (alpha > 12) {
                     float size = p.size * 0.4f * (0.6f + intensity * 0.4f);
-                    DrawSphere({p.position.x, p.position.y, p.position.z}, size, {255, 255, 250, alpha});
-                    DrawSphere({p.position.x, p.position.y, p.position.z}, size * 2.5f, {255, 235, 190, (unsigned char)(alpha / 3)});
+                    glow.add(p.position, size, {255, 255, 250, alpha}, size * 2.5f, {255, 235, 190, (unsigned char)(alpha / 3)});
                 }
             }
         } else {
@@ -397,12 +390,15 @@ void EnvironmentRenderer::renderAtmosphere(const FlightCamera& camera, float dt)
             float drift = std::sin(phase * 0.25f) * 0.5f + 0.5f;
             unsigned char alpha = (unsigned char)(p.alpha * distFade * 80 * drift);
             if (alpha > 4) {
-                DrawSphere({p.position.x, p.position.y, p.position.z}, p.size * 1.0f, {245, 248, 255, alpha});
-                DrawSphere({p.position.x, p.position.y, p.position.z}, p.size * 2.0f, {240, 245, 255, (unsigned char)(alpha / 4)});
+                glow.add(p.position, p.size * 1.0f, {245, 248, 255, alpha}, p.size * 2.0f, {240, 245, 255, (unsigned char)(alpha / 4)});
             }
         }
     }
     
+    rlDisableDepthMask();
+    glow.flush();
+    rlEnableDepthMask();
+    
     EndMode3D();
 }
 
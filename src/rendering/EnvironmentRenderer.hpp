@@ -2,8 +2,16 @@
 #include "raylib.h"
 #include "core/Vector3D.hpp"
 #include "environment/Terrain.hpp"
+#include "environment/TerrainStreamer.hpp"
 #include "entities/Camera3D.hpp"
 #include "physics/WindField3D.hpp"
+#include "rendering/GlowBatch.hpp"
+#include "rendering/SkyShader.hpp"
+#include "rendering/TerrainMesh.hpp"
+#include "rendering/TerrainLodMesh.hpp"
+#include "rendering/ViewCuller.hpp"
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace ethereal {
@@ -16,6 +24,8 @@ struct EnvironmentConfig {
     Vector3D sunDirection = Vector3D(0.4f, 0.7f, 0.3f);
     float sunSize = 35.0f;
     float sunGlowSize = 120.0f;
+    bool showSun = false;               // Night scene: the sun only lights the terrain
+    bool skyScattering = false;         // GPU single scattering around the sun
     
     // Moon
     bool enableMoon = true;
@@ -42,7 +52,10 @@ struct EnvironmentConfig {
     
     // Terrain
     float terrainViewDistance = 1000.0f;
-    float terrainLodDistance = 400.0f;
+    float terrainLodDistance = 400.0f;     // Range of the finest LOD level; doubles per level
+    int terrainLodPatchTiles = 8;
+    float terrainLodMorphStart = 0.7f;
+    int maxChunkUploadsPerFrame = 4;
     bool smoothShading = true;
     
     // Atmosphere particles
@@ -65,33 +78,50 @@ public:
     explicit EnvironmentRenderer(const EnvironmentConfig& config);
     
     void initialize();
+    // Releases GPU resources; call before the window closes
+    void shutdown();
     void update(float dt, const Vector3D& cameraPos, const WindField3D& wind);
     
+    // Gradient, moon, sun and star field in one full-screen shader pass
     void renderSky(const FlightCamera& camera, float time);
-    void renderMoonAndStars(const FlightCamera& camera, float time);
     void renderTerrain(const Terrain& terrain, const FlightCamera& camera);
+    // Streamed terrain: uploads newly resident chunks (budgeted) and frees evicted ones
+    void renderTerrain(const TerrainStreamer& streamer, const FlightCamera& camera);
     void renderClouds(const FlightCamera& camera, float time);
     void renderAtmosphere(const FlightCamera& camera, float dt);
     void renderDistantMountains(const FlightCamera& camera, float time);
     
+    int getTerrainTrianglesDrawn() const { return terrainTrianglesDrawn; }
+    
+    // Frame culler begun by the owner of the frame; streamed terrain adds its
+    // occluders to it, so passes drawn after renderTerrain() also get occlusion
+    void setViewCuller(ViewCuller* culler) { viewCuller = culler; }
+    
     void setConfig(const EnvironmentConfig& cfg) { config = cfg; }
     const EnvironmentConfig& getConfig() const { return config; }
 
 private:
     EnvironmentConfig config;
     std::vector<AtmosphereParticle3D> particles;
-    std::vector<Vector3D> starPositions;
-    std::vector<float> starBrightnesses;
     float time;
+    TerrainShader terrainShader;
+    TerrainMesh terrainMesh;
+    GlowBatch glow;
+    SkyShader sky;
+    ViewCuller* viewCuller = nullptr;
+    std::unordered_map<int64_t, std::unique_ptr<TerrainLodMesh>> chunkMeshes;
+    int terrainTrianglesDrawn = 0;
     
     void initParticles(const Vector3D& center);
-    void initStars();
     void updateParticles(float dt, const Vector3D& cameraPos, const WindField3D& wind);
     
     Color blendColors(Color a, Color b, float t);
     Color applyFog(Color color, float distance, float height);
     Color getTerrainColor(float height, float steepness);
+    TerrainShading makeTerrainShading() const;
+    SkyShading makeSkyShading() const;
     float calculateLighting(const Vector3D& normal);
+    bool isVisible(const Vector3D& center, float radius) const;
 };
 
 } // namespace ethereal
@@ -0,0 +1,192 @@
+#include "GlowBatch.hpp"
+#include "utils/Telemetry.hpp"
+#include "rlgl.h"
+#include <algorithm>
+
+namespace ethereal {
+
+namespace {
+
+// One sprite = 4 vertices sharing the sprite center; the corner goes in the
+// texcoords and the vertex shader spreads it along the camera's right/up axes.
+const char* kGlowVertexShader = R"(#version 330
+in vec3 vertexPosition;     // sprite center
+in vec2 vertexTexCoord;     // corner, -1..1
+in vec3 vertexNormal;       // x = halo radius, y = core radius / halo radius
+in vec4 vertexColor;        // core color
+in vec4 vertexTangent;      // halo color
+
+uniform mat4 mvp;
+uniform mat4 matView;
+
+out vec2 fragCorner;
+out float fragCore;
+out vec4 fragCoreColor;
+out vec4 fragHaloColor;
+
+void main() {
+    vec3 right = vec3(matView[0][0], matView[1][0], matView[2][0]);
+    vec3 up = vec3(matView[0][1], matView[1][1], matView[2][1]);
+    vec3 position = vertexPosition + (right * vertexTexCoord.x + up * vertexTexCoord.y) * vertexNormal.x;
+
+    fragCorner = vertexTexCoord;
+    fragCore = vertexNormal.y;
+    fragCoreColor = vertexColor;
+    fragHaloColor = vertexTangent;
+    gl_Position = mvp * vec4(position, 1.0);
+}
+)";
+
+const char* kGlowFragmentShader = R"(#version 330
+in vec2 fragCorner;
+in float fragCore;
+in vec4 fragCoreColor;
+in vec4 fragHaloColor;
+
+out vec4 finalColor;
+
+void main() {
+    float d = length(fragCorner);
+    if (d > 1.0) discard;
+
+    float core = fragCore > 0.0 ? 1.0 - smoothstep(fragCore * 0.6, fragCore, d) : 0.0;
+    float halo = 1.0 - d * d;
+
+    // Core composited over the halo, as the nested spheres used to be
+    float coreAlpha = core * fragCoreColor.a;
+    float haloAlpha = halo * fragHaloColor.a * (1.0 - coreAlpha);
+    float alpha = coreAlpha + haloAlpha;
+    if (alpha < 0.002) discard;
+
+    finalColor = vec4((fragCoreColor.rgb * coreAlpha + fragHaloColor.rgb * haloAlpha) / alpha, alpha);
+}
+)";
+
+const float kCorners[4][2] = { {-1, -1}, {1, -1}, {1, 1}, {-1, 1} };
+
+// Largest sprite count whose vertices fit 16-bit indices
+const size_t kMaxCapacity = 65535 / 4;
+
+} // namespace
+
+GlowBatch::GlowBatch(size_t capacity)
+    : capacity(std::clamp<size_t>(capacity, 1, kMaxCapacity)) {}
+
+GlowBatch::~GlowBatch() {
+    unload();
+}
+
+bool GlowBatch::load() {
+    unload();
+
+    shader = LoadShaderFromMemory(kGlowVertexShader, kGlowFragmentShader);
+    if (shader.id == 0) return false;
+
+    int vertexCount = static_cast<int>(capacity * 4);
+    mesh = { 0 };
+    mesh.vertexCount = vertexCount;
+    mesh.triangleCount = static_cast<int>(capacity * 2);
+    mesh.vertices = static_cast<float*>(MemAlloc(vertexCount * 3 * sizeof(float)));
+    mesh.texcoords = static_cast<float*>(MemAlloc(vertexCount * 2 * sizeof(float)));
+    mesh.normals = static_cast<float*>(MemAlloc(vertexCount * 3 * sizeof(float)));
+    mesh.colors = static_cast<unsigned char*>(MemAlloc(vertexCount * 4));
+    mesh.tangents = static_cast<float*>(MemAlloc(vertexCount * 4 * sizeof(float)));
+    mesh.indices = static_cast<unsigned short*>(MemAlloc(capacity * 6 * sizeof(unsigned short)));
+
+    // Corners and indices never change; only centers, sizes and colors are streamed
+    for (size_t i = 0; i < capacity; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            mesh.texcoords[(i * 4 + c) * 2 + 0] = kCorners[c][0];
+            mesh.texcoords[(i * 4 + c) * 2 + 1] = kCorners[c][1];
+        }
+        unsigned short base = static_cast<unsigned short>(i * 4);
+        unsigned short* tri = mesh.indices + i * 6;
+        tri[0] = base; tri[1] = base + 1; tri[2] = base + 2;
+        tri[3] = base; tri[4] = base + 2; tri[5] = base + 3;
+    }
+    UploadMesh(&mesh, true);
+
+    material = LoadMaterialDefault();
+    material.shader = shader;
+    loaded = true;
+    return true;
+}
+
+void GlowBatch::unload() {
+    if (!loaded) return;
+    UnloadMesh(mesh);
+    UnloadMaterial(material);   // also releases the shader
+    mesh = { 0 };
+    material = { 0 };
+    shader = { 0 };
+    count = 0;
+    loaded = false;
+}
+
+const char* GlowBatch::getFragmentShaderSource() {
+    return kGlowFragmentShader;
+}
+
+void GlowBatch::begin() {
+    count = 0;
+    totalSprites = 0;
+    drawCalls = 0;
+}
+
+void GlowBatch::add(const Vector3D& center, float radius, Color color) {
+    add(center, 0.0f, color, radius, color);
+}
+
+void GlowBatch::add(const Vector3D& center, float coreRadius, Color coreColor, float haloRadius, Color haloColor) {
+    if (!loaded) return;
+    if (count == capacity) drawPending();
+
+    float radius = std::max(haloRadius, coreRadius);
+    if (radius <= 0.0f) return;
+    float coreFraction = coreRadius / radius;
+    float halo[4] = { haloColor.r / 255.0f, haloColor.g / 255.0f, haloColor.b / 255.0f, haloColor.a / 255.0f };
+
+    for (size_t v = count * 4; v < count * 4 + 4; ++v) {
+        mesh.vertices[v * 3 + 0] = center.x;
+        mesh.vertices[v * 3 + 1] = center.y;
+        mesh.vertices[v * 3 + 2] = center.z;
+        mesh.normals[v * 3 + 0] = radius;
+        mesh.normals[v * 3 + 1] = coreFraction;
+        mesh.normals[v * 3 + 2] = 0.0f;
+        mesh.colors[v * 4 + 0] = coreColor.r;
+        mesh.colors[v * 4 + 1] = coreColor.g;
+        mesh.colors[v * 4 + 2] = coreColor.b;
+        mesh.colors[v * 4 + 3] = coreColor.a;
+        std::copy(halo, halo + 4, mesh.tangents + v * 4);
+    }
+    count++;
+    totalSprites++;
+}
+
+void GlowBatch::flush() {
+    if (!loaded || count == 0) return;
+    drawPending();
+}
+
+void GlowBatch::drawPending() {
+    // Immediate-mode geometry queued earlier must land first, under its own state
+    rlDrawRenderBatchActive();
+
+    int vertexCount = static_cast<int>(count * 4);
+    UpdateMeshBuffer(mesh, 0, mesh.vertices, vertexCount * 3 * sizeof(float), 0);
+    UpdateMeshBuffer(mesh, 2, mesh.normals, vertexCount * 3 * sizeof(float), 0);
+    UpdateMeshBuffer(mesh, 3, mesh.colors, vertexCount * 4, 0);
+    UpdateMeshBuffer(mesh, 4, mesh.tangents, vertexCount * 4 * sizeof(float), 0);
+
+    Mesh pending = mesh;
+    pending.triangleCount = static_cast<int>(count * 2);
+    Matrix identity = { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1 };
+    DrawMesh(pending, material, identity);
+
+    drawCalls++;
+    TELEMETRY_COUNT("render.drawCalls", 1);
+    TELEMETRY_COUNT("render.triangles", pending.triangleCount);
+    count = 0;
+}
+
+} // namespace ethereal
@@ -0,0 +1,54 @@
+#pragma once
+#include "raylib.h"
+#include "core/Vector3D.hpp"
+#include <cstddef>
+
+namespace ethereal {
+
+// Camera-facing soft glow sprites (stars, cloud puffs, atmosphere motes) gathered
+// into one dynamic quad buffer and drawn with a single DrawMesh per flush. Each
+// sprite is a bright core fading into a wider halo, replacing the stacks of
+// concentric translucent DrawSphere calls the renderers used before.
+class GlowBatch {
+public:
+    // 16-bit indices cap one buffer at 16383 sprites; larger batches flush in chunks
+    explicit GlowBatch(size_t capacity = 4096);
+    ~GlowBatch();
+
+    GlowBatch(const GlowBatch&) = delete;
+    GlowBatch& operator=(const GlowBatch&) = delete;
+
+    // Requires an open window
+    bool load();
+    void unload();
+    bool isLoaded() const { return loaded; }
+
+    void begin();
+    // Soft sprite fading from `color` at the center to nothing at `radius`
+    void add(const Vector3D& center, float radius, Color color);
+    // Core of `coreRadius` inside a halo of `haloRadius`, each with its own color
+    void add(const Vector3D& center, float coreRadius, Color coreColor, float haloRadius, Color haloColor);
+    // Call between BeginMode3D/EndMode3D; depth/blend state is the caller's
+    void flush();
+
+    // Core-over-halo fragment program, for other sprite sources that share the look
+    static const char* getFragmentShaderSource();
+
+    size_t getSpriteCount() const { return totalSprites; }
+    int getDrawCalls() const { return drawCalls; }
+
+private:
+    size_t capacity;
+    size_t count = 0;
+    size_t totalSprites = 0;
+    int drawCalls = 0;
+
+    Mesh mesh = { 0 };
+    Shader shader = { 0 };
+    Material material = { 0 };
+    bool loaded = false;
+
+    void drawPending();
+};
+
+} // namespace ethereal
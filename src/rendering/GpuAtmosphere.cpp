@@ -0,0 +1,434 @@
+#include "GpuAtmosphere.hpp"
+#include "rendering/GlowBatch.hpp"
+#include "utils/Random.hpp"
+#include "rlgl.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ethereal {
+
+namespace {
+
+const char* kUpdateVertexShader = R"(#version 330
+in vec3 vertexPosition;
+uniform mat4 mvp;
+
+void main() {
+    gl_Position = mvp * vec4(vertexPosition, 1.0);
+}
+)";
+
+// One fragment per particle: reads last frame's state, writes the next one
+const char* kUpdateFragmentShader = R"(#version 330
+uniform sampler2D statePosition;    // xyz, w = lifetime
+uniform sampler2D stateVelocity;    // xyz, w = size
+uniform sampler2D windGrid;         // x-major nodes: row = ix, column = iy * resolution + iz
+uniform vec4 windOrigin;            // xyz, w = cell size
+uniform int windResolution;         // 0 = no grid baked yet
+uniform vec3 windFallback;
+uniform vec3 cameraPos;
+uniform vec4 params;                // dt, respawn radius, unused, state width
+uniform int frame;
+
+layout(location = 0) out vec4 outPosition;
+layout(location = 1) out vec4 outVelocity;
+
+uint hash(uint x) {
+    x ^= x >> 16; x *= 0x7feb352du;
+    x ^= x >> 15; x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+float random(inout uint state) {
+    state = hash(state);
+    return float(state >> 8) * (1.0 / 16777216.0);
+}
+
+vec3 windNode(int ix, int iy, int iz) {
+    return texelFetch(windGrid, ivec2(iy * windResolution + iz, ix), 0).xyz;
+}
+
+// Trilinear lookup matching WindField3D::sampleGrid
+vec3 sampleWind(vec3 p) {
+    if (windResolution < 2) return windFallback;
+    vec3 f = (p - windOrigin.xyz) / windOrigin.w;
+    if (any(lessThan(f, vec3(0.0))) || any(greaterThanEqual(f, vec3(float(windResolution - 1))))) {
+        return windFallback;
+    }
+    ivec3 i = ivec3(f);
+    vec3 t = f - vec3(i);
+    vec3 c00 = mix(windNode(i.x, i.y, i.z), windNode(i.x, i.y, i.z + 1), t.z);
+    vec3 c01 = mix(windNode(i.x, i.y + 1, i.z), windNode(i.x, i.y + 1, i.z + 1), t.z);
+    vec3 c10 = mix(windNode(i.x + 1, i.y, i.z), windNode(i.x + 1, i.y, i.z + 1), t.z);
+    vec3 c11 = mix(windNode(i.x + 1, i.y + 1, i.z), windNode(i.x + 1, i.y + 1, i.z + 1), t.z);
+    return mix(mix(c00, c01, t.y), mix(c10, c11, t.y), t.x);
+}
+
+void main() {
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    vec4 position = texelFetch(statePosition, texel, 0);
+    vec4 velocity = texelFetch(stateVelocity, texel, 0);
+    float dt = params.x;
+    float life = position.w;
+
+    // Same motion as Renderer3D::updateParticles: damped wind drift plus a gentle swirl
+    float swirl = sin(life * 2.0 + position.x * 0.01) * 0.5;
+    vec3 drift = vec3(swirl, 0.3, cos(life * 1.5) * 0.3);
+    velocity.xyz = velocity.xyz * 0.96 + sampleWind(position.xyz) * 0.003 + drift * dt;
+    position.xyz += velocity.xyz * dt * 40.0;
+    life += dt;
+
+    float alpha = 0.4 - life * 0.02;
+    if (distance(position.xyz, cameraPos) > params.y || position.y < -60.0 || alpha <= 0.0) {
+        uint state = hash(uint(texel.x) + uint(texel.y) * uint(params.w)) ^ hash(uint(frame));
+        float angle = random(state) * 6.28318;
+        float spawnDistance = 50.0 + random(state) * 250.0;
+        position.xyz = cameraPos + vec3(cos(angle) * spawnDistance, -30.0 + random(state) * 180.0,
+                                        sin(angle) * spawnDistance);
+        velocity = vec4(0.0, 0.0, 0.0, 0.8 + random(state) * 1.5);
+        life = 0.0;
+    }
+
+    outPosition = vec4(position.xyz, life);
+    outVelocity = velocity;
+}
+)";
+
+// Expands each particle's quad from the state textures; looks match Renderer3D::drawAtmosphere
+const char* kDrawVertexShader = R"(#version 330
+in vec3 vertexPosition;     // quad corner, -1..1
+
+uniform mat4 mvp;
+uniform mat4 matView;
+uniform sampler2D texture0; // position + lifetime
+uniform sampler2D texture1; // velocity + size
+uniform int particleOffset;
+uniform int stateWidth;
+uniform vec3 cameraPos;
+uniform vec4 params;        // time, fade radius
+
+out vec2 fragCorner;
+out float fragCore;
+out vec4 fragCoreColor;
+out vec4 fragHaloColor;
+
+uint hash(uint x) {
+    x ^= x >> 16; x *= 0x7feb352du;
+    x ^= x >> 15; x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+void main() {
+    int id = particleOffset + gl_VertexID / 4;
+    ivec2 texel = ivec2(id % stateWidth, id / stateWidth);
+    vec4 state = texelFetch(texture0, texel, 0);
+    float size = texelFetch(texture1, texel, 0).w;
+
+    float alpha = max(0.4 - state.w * 0.02, 0.0);
+    float distFade = 1.0 - pow(min(distance(state.xyz, cameraPos) / params.y, 1.0), 1.5);
+    float phase = params.x * 2.0 + float(id) * 0.7;
+    uint type = hash(uint(id)) % 3u;
+
+    float coreSize;
+    float haloSize;
+    vec4 coreColor;
+    vec4 haloColor;
+    if (type == 0u) {
+        // Floating dust motes
+        float a = alpha * distFade * (160.0 / 255.0) * (0.7 + 0.3 * sin(phase * 0.5));
+        coreSize = size * 0.8;
+        haloSize = size * 1.8;
+        coreColor = vec4(1.0, 0.973, 0.922, a);
+        haloColor = vec4(1.0, 0.941, 0.824, a * 0.25);
+    } else if (type == 1u) {
+        // Firefly sparkles with sharp peaks
+        float sparkle = sin(phase * 3.0);
+        sparkle = sparkle * sparkle * sparkle;
+        float intensity = max((sparkle - 0.3) / 0.7, 0.0);
+        float a = alpha * distFade * (220.0 / 255.0) * intensity;
+        coreSize = size * 0.5 * (0.5 + intensity * 0.5);
+        haloSize = coreSize * 3.0;
+        coreColor = vec4(1.0, 1.0, 0.98, a);
+        haloColor = vec4(1.0, 0.902, 0.706, a / 3.0);
+    } else {
+        // Drifting light wisps
+        float drift = sin(phase * 0.3) * 0.5 + 0.5;
+        float a = alpha * distFade * (100.0 / 255.0) * drift;
+        coreSize = size * 1.2;
+        haloSize = size * 2.5;
+        coreColor = vec4((240.0 + drift * 15.0) / 255.0, (245.0 + drift * 10.0) / 255.0, 1.0, a);
+        haloColor = vec4(coreColor.rgb, a * 0.2);
+    }
+
+    fragCorner = vertexPosition.xy;
+    fragCore = coreSize / haloSize;
+    fragCoreColor = coreColor;
+    fragHaloColor = haloColor;
+
+    if (coreColor.a < 0.02) {
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);     // Outside the clip volume
+        return;
+    }
+    vec3 right = vec3(matView[0][0], matView[1][0], matView[2][0]);
+    vec3 up = vec3(matView[0][1], matView[1][1], matView[2][1]);
+    vec3 position = state.xyz + (right * vertexPosition.x + up * vertexPosition.y) * haloSize;
+    gl_Position = mvp * vec4(position, 1.0);
+}
+)";
+
+const int kStateWidth = 256;
+
+// Particles per draw call; 4 vertices each must fit 16-bit indices
+const int kQuadsPerDraw = 16383;
+
+const float kCorners[4][2] = { {-1, -1}, {1, -1}, {1, 1}, {-1, 1} };
+
+Texture2D makeFloatTexture(const float* data, int width, int height, int format) {
+    Texture2D texture = { 0 };
+    texture.id = rlLoadTexture(data, width, height, format, 1);
+    texture.width = width;
+    texture.height = height;
+    texture.mipmaps = 1;
+    texture.format = format;
+    return texture;
+}
+
+} // namespace
+
+GpuAtmosphere::GpuAtmosphere() : GpuAtmosphere(GpuAtmosphereConfig{}) {}
+
+GpuAtmosphere::GpuAtmosphere(const GpuAtmosphereConfig& cfg)
+    : config(cfg) {
+    config.particleCount = std::max(config.particleCount, 1);
+}
+
+GpuAtmosphere::~GpuAtmosphere() {
+    unload();
+}
+
+bool GpuAtmosphere::load(const Vector3D& cameraPosition) {
+    unload();
+
+    stateWidth = kStateWidth;
+    stateHeight = (config.particleCount + stateWidth - 1) / stateWidth;
+    size_t texels = static_cast<size_t>(stateWidth) * stateHeight;
+
+    // Seed around the camera with staggered lifetimes so respawns spread out
+    std::vector<float> positions(texels * 4);
+    std::vector<float> velocities(texels * 4, 0.0f);
+    Pcg32 rng(config.seed);
+    for (size_t i = 0; i < texels; ++i) {
+        float angle = rng.range(0.0f, 6.28318f);
+        float distance = rng.range(50.0f, 300.0f);
+        positions[i * 4 + 0] = cameraPosition.x + std::cos(angle) * distance;
+        positions[i * 4 + 1] = cameraPosition.y + rng.range(-30.0f, 150.0f);
+        positions[i * 4 + 2] = cameraPosition.z + std::sin(angle) * distance;
+        positions[i * 4 + 3] = rng.range(0.0f, 20.0f);
+        velocities[i * 4 + 3] = rng.range(0.8f, 2.3f);
+    }
+
+    if (!createTarget(targets[0], positions.data(), velocities.data()) ||
+        !createTarget(targets[1], nullptr, nullptr)) {
+        releaseTarget(targets[0]);
+        releaseTarget(targets[1]);
+        return false;
+    }
+
+    updateShader = LoadShaderFromMemory(kUpdateVertexShader, kUpdateFragmentShader);
+    Shader drawShader = LoadShaderFromMemory(kDrawVertexShader, GlowBatch::getFragmentShaderSource());
+    if (updateShader.id == 0 || drawShader.id == 0) {
+        if (updateShader.id != 0) UnloadShader(updateShader);
+        if (drawShader.id != 0) UnloadShader(drawShader);
+        updateShader = { 0 };
+        releaseTarget(targets[0]);
+        releaseTarget(targets[1]);
+        return false;
+    }
+
+    locUpdatePosition = GetShaderLocation(updateShader, "statePosition");
+    locUpdateVelocity = GetShaderLocation(updateShader, "stateVelocity");
+    locUpdateWind = GetShaderLocation(updateShader, "windGrid");
+    locUpdateWindOrigin = GetShaderLocation(updateShader, "windOrigin");
+    locUpdateWindResolution = GetShaderLocation(updateShader, "windResolution");
+    locUpdateWindFallback = GetShaderLocation(updateShader, "windFallback");
+    locUpdateCamera = GetShaderLocation(updateShader, "cameraPos");
+    locUpdateParams = GetShaderLocation(updateShader, "params");
+    locUpdateFrame = GetShaderLocation(updateShader, "frame");
+    locDrawOffset = GetShaderLocation(drawShader, "particleOffset");
+    locDrawStateWidth = GetShaderLocation(drawShader, "stateWidth");
+    locDrawCamera = GetShaderLocation(drawShader, "cameraPos");
+    locDrawParams = GetShaderLocation(drawShader, "params");
+
+    // Corner-only quads; the vertex shader finds its particle from gl_VertexID
+    int quadCount = std::min(config.particleCount, kQuadsPerDraw);
+    quads = { 0 };
+    quads.vertexCount = quadCount * 4;
+    quads.triangleCount = quadCount * 2;
+    quads.vertices = static_cast<float*>(MemAlloc(quads.vertexCount * 3 * sizeof(float)));
+    quads.indices = static_cast<unsigned short*>(MemAlloc(quadCount * 6 * sizeof(unsigned short)));
+    for (int i = 0; i < quadCount; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            float* v = quads.vertices + (i * 4 + c) * 3;
+            v[0] = kCorners[c][0];
+            v[1] = kCorners[c][1];
+            v[2] = 0.0f;
+        }
+        unsigned short base = static_cast<unsigned short>(i * 4);
+        unsigned short* tri = quads.indices + i * 6;
+        tri[0] = base; tri[1] = base + 1; tri[2] = base + 2;
+        tri[3] = base; tri[4] = base + 2; tri[5] = base + 3;
+    }
+    UploadMesh(&quads, false);
+
+    drawMaterial = LoadMaterialDefault();
+    drawMaterial.shader = drawShader;
+    current = 0;
+    time = 0.0f;
+    frame = 0;
+    windResolution = 0;
+    loaded = true;
+    return true;
+}
+
+void GpuAtmosphere::unload() {
+    if (!loaded) return;
+    UnloadMesh(quads);
+    // The state textures are ours, not the material's
+    drawMaterial.maps[MATERIAL_MAP_DIFFUSE].texture.id = rlGetTextureIdDefault();
+    drawMaterial.maps[MATERIAL_MAP_SPECULAR].texture.id = rlGetTextureIdDefault();
+    UnloadMaterial(drawMaterial);   // also releases the draw shader
+    UnloadShader(updateShader);
+    releaseTarget(targets[0]);
+    releaseTarget(targets[1]);
+    if (windTexture.id != 0) rlUnloadTexture(windTexture.id);
+
+    quads = { 0 };
+    drawMaterial = { 0 };
+    updateShader = { 0 };
+    windTexture = { 0 };
+    windResolution = 0;
+    loaded = false;
+}
+
+bool GpuAtmosphere::createTarget(StateTarget& target, const float* positions, const float* velocities) {
+    target.position = makeFloatTexture(positions, stateWidth, stateHeight, PIXELFORMAT_UNCOMPRESSED_R32G32B32A32);
+    target.velocity = makeFloatTexture(velocities, stateWidth, stateHeight, PIXELFORMAT_UNCOMPRESSED_R32G32B32A32);
+    if (target.position.id == 0 || target.velocity.id == 0) return false;
+
+    target.framebuffer = rlLoadFramebuffer(stateWidth, stateHeight);
+    if (target.framebuffer == 0) return false;
+    rlFramebufferAttach(target.framebuffer, target.position.id, RL_ATTACHMENT_COLOR_CHANNEL0, RL_ATTACHMENT_TEXTURE2D, 0);
+    rlFramebufferAttach(target.framebuffer, target.velocity.id, RL_ATTACHMENT_COLOR_CHANNEL1, RL_ATTACHMENT_TEXTURE2D, 0);
+
+    // Draw buffers are framebuffer state, so this sticks to the target
+    rlEnableFramebuffer(target.framebuffer);
+    rlActiveDrawBuffers(2);
+    rlDisableFramebuffer();
+    return rlFramebufferComplete(target.framebuffer);
+}
+
+void GpuAtmosphere::releaseTarget(StateTarget& target) {
+    if (target.framebuffer != 0) rlUnloadFramebuffer(target.framebuffer);
+    if (target.position.id != 0) rlUnloadTexture(target.position.id);
+    if (target.velocity.id != 0) rlUnloadTexture(target.velocity.id);
+    target = StateTarget{};
+}
+
+void GpuAtmosphere::uploadWind(const WindField3D& wind) {
+    WindGridView3D view;
+    windRevision = wind.getGridRevision();
+    if (!wind.getGridView(view)) {
+        windResolution = 0;
+        return;
+    }
+
+    // Interleave the SoA grid; node order already matches the texture's row-major layout
+    const int n = view.resolution;
+    const size_t nodes = static_cast<size_t>(n) * n * n;
+    windStaging.resize(nodes * 3);
+    for (size_t i = 0; i < nodes; ++i) {
+        windStaging[i * 3 + 0] = view.vx[i];
+        windStaging[i * 3 + 1] = view.vy[i];
+        windStaging[i * 3 + 2] = view.vz[i];
+    }
+
+    if (windTexture.id == 0 || n != windResolution) {
+        if (windTexture.id != 0) rlUnloadTexture(windTexture.id);
+        windTexture = makeFloatTexture(windStaging.data(), n * n, n, PIXELFORMAT_UNCOMPRESSED_R32G32B32);
+    } else {
+        rlUpdateTexture(windTexture.id, 0, 0, n * n, n, PIXELFORMAT_UNCOMPRESSED_R32G32B32, windStaging.data());
+    }
+    windResolution = windTexture.id != 0 ? n : 0;
+    windOrigin = view.origin;
+    windCellSize = view.cellSize;
+}
+
+void GpuAtmosphere::update(float dt, const Vector3D& cameraPosition, const WindField3D& wind) {
+    if (!loaded) return;
+    time += dt;
+    frame++;
+
+    if (wind.getGridRevision() != windRevision || wind.isGridEnabled() != (windResolution > 0)) {
+        uploadWind(wind);
+    }
+
+    // Outside the grid the particles see the wind at the camera
+    Vector3D fallback = wind.getWindAt(cameraPosition);
+    const StateTarget& source = targets[current];
+    const StateTarget& destination = targets[1 - current];
+
+    float origin[4] = { windOrigin.x, windOrigin.y, windOrigin.z, windCellSize };
+    float fallbackWind[3] = { fallback.x, fallback.y, fallback.z };
+    float camera[3] = { cameraPosition.x, cameraPosition.y, cameraPosition.z };
+    float params[4] = { dt, config.respawnRadius, 0.0f, static_cast<float>(stateWidth) };
+
+    RenderTexture2D target = { destination.framebuffer, destination.position, { 0 } };
+    BeginTextureMode(target);
+    rlDisableColorBlend();      // State is data, not color
+    BeginShaderMode(updateShader);
+    SetShaderValueTexture(updateShader, locUpdatePosition, source.position);
+    SetShaderValueTexture(updateShader, locUpdateVelocity, source.velocity);
+    if (windResolution > 0) SetShaderValueTexture(updateShader, locUpdateWind, windTexture);
+    SetShaderValue(updateShader, locUpdateWindOrigin, origin, SHADER_UNIFORM_VEC4);
+    SetShaderValue(updateShader, locUpdateWindResolution, &windResolution, SHADER_UNIFORM_INT);
+    SetShaderValue(updateShader, locUpdateWindFallback, fallbackWind, SHADER_UNIFORM_VEC3);
+    SetShaderValue(updateShader, locUpdateCamera, camera, SHADER_UNIFORM_VEC3);
+    SetShaderValue(updateShader, locUpdateParams, params, SHADER_UNIFORM_VEC4);
+    SetShaderValue(updateShader, locUpdateFrame, &frame, SHADER_UNIFORM_INT);
+    DrawRectangle(0, 0, stateWidth, stateHeight, WHITE);
+    EndShaderMode();
+    rlEnableColorBlend();
+    EndTextureMode();
+
+    current = 1 - current;
+}
+
+void GpuAtmosphere::draw(const Vector3D& cameraPosition) {
+    if (!loaded) return;
+
+    const StateTarget& state = targets[current];
+    drawMaterial.maps[MATERIAL_MAP_DIFFUSE].texture = state.position;
+    drawMaterial.maps[MATERIAL_MAP_SPECULAR].texture = state.velocity;
+
+    Shader shader = drawMaterial.shader;
+    float camera[3] = { cameraPosition.x, cameraPosition.y, cameraPosition.z };
+    float params[4] = { time, config.fadeRadius, 0.0f, 0.0f };
+    SetShaderValue(shader, locDrawStateWidth, &stateWidth, SHADER_UNIFORM_INT);
+    SetShaderValue(shader, locDrawCamera, camera, SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, locDrawParams, params, SHADER_UNIFORM_VEC4);
+
+    rlDrawRenderBatchActive();
+    rlDisableDepthMask();
+    Matrix identity = { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1 };
+    for (int offset = 0; offset < config.particleCount; offset += kQuadsPerDraw) {
+        Mesh chunk = quads;
+        chunk.triangleCount = std::min(config.particleCount - offset, kQuadsPerDraw) * 2;
+        SetShaderValue(shader, locDrawOffset, &offset, SHADER_UNIFORM_INT);
+        DrawMesh(chunk, drawMaterial, identity);
+    }
+    rlEnableDepthMask();
+}
+
+} // namespace ethereal
@@ -0,0 +1,91 @@
+#pragma once
+#include "raylib.h"
+#include "core/Vector3D.hpp"
+#include "physics/WindField3D.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace ethereal {
+
+struct GpuAtmosphereConfig {
+    int particleCount = 32768;
+    float respawnRadius = 500.0f;   // Particles farther than this from the camera respawn
+    float fadeRadius = 450.0f;      // Distance where particles have faded out
+    uint32_t seed = 0x41544d4f;
+};
+
+// Atmosphere dust, sparkles and wisps simulated entirely on the GPU. Particle
+// state lives in two ping-ponged float render targets (position + lifetime,
+// velocity + size) advanced by a fragment-shader pass; wind comes from the
+// WindField3D baked grid uploaded as a texture, so no particle ever travels
+// between CPU and GPU after the initial seeding. The draw pass reads the state
+// back in the vertex shader and expands camera-facing glow quads.
+class GpuAtmosphere {
+public:
+    GpuAtmosphere();
+    explicit GpuAtmosphere(const GpuAtmosphereConfig& config);
+    ~GpuAtmosphere();
+
+    GpuAtmosphere(const GpuAtmosphere&) = delete;
+    GpuAtmosphere& operator=(const GpuAtmosphere&) = delete;
+
+    // Requires an open window with float render target support
+    bool load(const Vector3D& cameraPosition);
+    void unload();
+    bool isLoaded() const { return loaded; }
+
+    // Call outside BeginMode3D; re-uploads the wind grid when it was rebaked
+    void update(float dt, const Vector3D& cameraPosition, const WindField3D& wind);
+    // Call between BeginMode3D/EndMode3D
+    void draw(const Vector3D& cameraPosition);
+
+    int getParticleCount() const { return config.particleCount; }
+    const GpuAtmosphereConfig& getConfig() const { return config; }
+
+private:
+    struct StateTarget {
+        unsigned int framebuffer = 0;
+        Texture2D position = { 0 };     // xyz, w = lifetime
+        Texture2D velocity = { 0 };     // xyz, w = size
+    };
+
+    GpuAtmosphereConfig config;
+    int stateWidth = 0;
+    int stateHeight = 0;
+    StateTarget targets[2];
+    int current = 0;
+
+    Texture2D windTexture = { 0 };
+    int windResolution = 0;
+    uint32_t windRevision = 0;
+    Vector3D windOrigin;
+    float windCellSize = 0.0f;
+    std::vector<float> windStaging;
+
+    Shader updateShader = { 0 };
+    Mesh quads = { 0 };
+    Material drawMaterial = { 0 };
+    bool loaded = false;
+    float time = 0.0f;
+    int frame = 0;
+
+    int locUpdatePosition = -1;
+    int locUpdateVelocity = -1;
+    int locUpdateWind = -1;
+    int locUpdateWindOrigin = -1;
+    int locUpdateWindResolution = -1;
+    int locUpdateWindFallback = -1;
+    int locUpdateCamera = -1;
+    int locUpdateParams = -1;
+    int locUpdateFrame = -1;
+    int locDrawOffset = -1;
+    int locDrawStateWidth = -1;
+    int locDrawCamera = -1;
+    int locDrawParams = -1;
+
+    bool createTarget(StateTarget& target, const float* positions, const float* velocities);
+    void releaseTarget(StateTarget& target);
+    void uploadWind(const WindField3D& wind);
+};
+
+} // namespace ethereal
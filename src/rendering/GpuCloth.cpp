@@ -0,0 +1,563 @@
+#include "GpuCloth.hpp"
+#include "rlgl.h"
+#include "utils/Profiler.hpp"
+#include <algorithm>
+#include <cmath>
+
+// rlgl has no wrapper for glMemoryBarrier; GLFW resolves it from the live context
+extern "C" void (*glfwGetProcAddress(const char* procname))(void);
+
+namespace ethereal {
+
+namespace {
+
+const char* kClothComputeShader = R"(#version 430
+layout(local_size_x = 64) in;
+
+struct Distance {
+    uint a;
+    uint b;
+    float rest;
+    float weightA;
+    float weightB;
+    float pad0, pad1, pad2;
+};
+
+struct Bend {
+    uint a;
+    uint b;
+    uint c;
+    float restAngle;
+    float stiffness;
+    float pad0, pad1, pad2;
+};
+
+layout(std430, binding = 0) buffer Positions { vec4 positions[]; };     // xyz, w = inverse mass
+layout(std430, binding = 1) buffer Previous { vec4 previous[]; };       // xyz, w = mass
+layout(std430, binding = 2) buffer Normals { vec4 normals[]; };         // xyz, w = aero mask
+layout(std430, binding = 3) readonly buffer Distances { Distance distances[]; };
+layout(std430, binding = 4) readonly buffer Bends { Bend bends[]; };
+layout(std430, binding = 5) readonly buffer Wind { float windNodes[]; }; // x-major nodes, xyz interleaved
+layout(std430, binding = 6) writeonly buffer MeshPositions { float meshPositions[]; };
+layout(std430, binding = 7) writeonly buffer MeshNormals { float meshNormals[]; };
+
+uniform int stage;              // 0 integrate, 1 distances, 2 bends, 3 normals
+uniform ivec2 grid;             // width, segments
+uniform ivec2 range;            // constraint batch [begin, end)
+uniform int serial;             // Overflow batch: one invocation walks it in order
+uniform vec4 frameParams;       // dt, gravity, attach speed, sway phase
+uniform vec4 attachVelocity;    // xyz, w = velocity kept this step (damping, step-length change)
+uniform vec3 swayAxis;
+uniform vec4 aero;              // wind influence, drag, lift
+uniform vec4 windOrigin;        // xyz, w = cell size
+uniform int windResolution;     // 0 = no grid baked
+uniform vec3 windFallback;
+uniform int meshBase;           // < 0: normals pass without mesh output
+
+vec3 windNode(int ix, int iy, int iz) {
+    int i = ((ix * windResolution + iy) * windResolution + iz) * 3;
+    return vec3(windNodes[i], windNodes[i + 1], windNodes[i + 2]);
+}
+
+// Trilinear lookup matching WindField3D::sampleGrid
+vec3 sampleWind(vec3 p) {
+    if (windResolution < 2) return windFallback;
+    vec3 f = (p - windOrigin.xyz) / windOrigin.w;
+    if (any(lessThan(f, vec3(0.0))) || any(greaterThanEqual(f, vec3(float(windResolution - 1))))) {
+        return windFallback;
+    }
+    ivec3 i = ivec3(f);
+    vec3 t = f - vec3(i);
+    vec3 c00 = mix(windNode(i.x, i.y, i.z), windNode(i.x, i.y, i.z + 1), t.z);
+    vec3 c01 = mix(windNode(i.x, i.y + 1, i.z), windNode(i.x, i.y + 1, i.z + 1), t.z);
+    vec3 c10 = mix(windNode(i.x + 1, i.y, i.z), windNode(i.x + 1, i.y, i.z + 1), t.z);
+    vec3 c11 = mix(windNode(i.x + 1, i.y + 1, i.z), windNode(i.x + 1, i.y + 1, i.z + 1), t.z);
+    return mix(mix(c00, c01, t.y), mix(c10, c11, t.y), t.x);
+}
+
+// Cape3D::accumulateForceRows followed by ClothParticles3D::integrate
+void integrate(uint i) {
+    vec4 p = positions[i];
+    vec4 q = previous[i];
+    vec4 n = normals[i];
+    if (p.w == 0.0) return;     // Pinned: keeps the position uploaded from the cape
+
+    float row = float(int(i) / grid.x);
+    float rowFactor = row / float(grid.y);
+    float sway = sin(row * 0.5 + frameParams.w) * frameParams.z * 0.002;
+    float windScale = aero.x * (0.3 + rowFactor * 0.7);
+    vec3 drift = attachVelocity.xyz * (-0.08 * rowFactor) + swayAxis * sway;
+
+    vec3 vel = p.xyz - q.xyz;
+    vec3 windVel = sampleWind(p.xyz);
+    vec3 force = windVel * windScale + drift;
+    force.y += frameParams.y * q.w;
+
+    float speed = length(vel);
+    if (speed > 0.1) force += vel * (-0.0015 * speed);
+
+    if (n.w > 0.0) {
+        float normalComponent = dot(windVel - vel, n.xyz);
+        force += n.xyz * (normalComponent * aero.y * abs(normalComponent));
+        if (normalComponent > 0.0) {
+            vec3 liftDir = vec3(0.0, 1.0, 0.0) - n.xyz * n.y;
+            float liftLenSq = dot(liftDir, liftDir);
+            if (liftLenSq > 0.01) {
+                force += liftDir * (normalComponent * normalComponent * aero.z * inversesqrt(liftLenSq));
+            }
+        }
+    }
+
+    float dt = frameParams.x;
+    previous[i].xyz = p.xyz;
+    positions[i].xyz = p.xyz + vel * attachVelocity.w + force * (p.w * dt * dt);
+}
+
+void solveDistance(uint k) {
+    Distance c = distances[k];
+    vec3 pa = positions[c.a].xyz;
+    vec3 pb = positions[c.b].xyz;
+    vec3 d = pb - pa;
+    float len = length(d);
+    if (len < 0.0001) return;
+
+    float diff = (len - c.rest) / len;
+    positions[c.a].xyz = pa + d * (diff * c.weightA);
+    positions[c.b].xyz = pb - d * (diff * c.weightB);
+}
+
+void solveBend(uint k) {
+    Bend c = bends[k];
+    vec4 pa = positions[c.a];
+    vec3 pb = positions[c.b].xyz;
+    vec4 pc = positions[c.c];
+
+    vec3 ba = pa.xyz - pb;
+    vec3 bc = pc.xyz - pb;
+    float baLen = length(ba);
+    float bcLen = length(bc);
+    if (baLen < 0.001 || bcLen < 0.001) return;
+
+    vec3 baNorm = ba / baLen;
+    vec3 bcNorm = bc / bcLen;
+    float angleDiff = acos(clamp(dot(baNorm, bcNorm), -1.0, 1.0)) - c.restAngle;
+    if (abs(angleDiff) < 0.001) return;
+
+    vec3 axis = cross(baNorm, bcNorm);
+    float axisLen = length(axis);
+    if (axisLen < 0.001) return;
+    axis /= axisLen;
+
+    float correction = angleDiff * c.stiffness * 0.5;
+    if (pa.w > 0.0) positions[c.a].xyz = pa.xyz + cross(axis, ba) * correction;
+    if (pc.w > 0.0) positions[c.c].xyz = pc.xyz - cross(axis, bc) * correction;
+}
+
+// Cape3D::computeNormals: central differences, one-sided along the edges
+void writeNormal(uint i) {
+    int row = int(i) / grid.x;
+    int col = int(i) - row * grid.x;
+    int up = max(row - 1, 0) * grid.x + col;
+    int down = min(row + 1, grid.y - 1) * grid.x + col;
+    int left = row * grid.x + max(col - 1, 0);
+    int right = row * grid.x + min(col + 1, grid.x - 1);
+
+    vec3 h = positions[right].xyz - positions[left].xyz;
+    vec3 v = positions[down].xyz - positions[up].xyz;
+    vec3 n = cross(h, v);
+    float len = length(n);
+    n = len > 1e-6 ? n / len : vec3(0.0);
+    normals[i].xyz = n;
+
+    if (meshBase >= 0) {
+        int o = (meshBase + int(i)) * 3;
+        vec3 p = positions[i].xyz;
+        meshPositions[o] = p.x; meshPositions[o + 1] = p.y; meshPositions[o + 2] = p.z;
+        meshNormals[o] = n.x; meshNormals[o + 1] = n.y; meshNormals[o + 2] = n.z;
+    }
+}
+
+void main() {
+    uint id = gl_GlobalInvocationID.x;
+    uint count = uint(grid.x * grid.y);
+    if (stage == 0 || stage == 3) {
+        if (id >= count) return;
+        if (stage == 0) integrate(id);
+        else writeNormal(id);
+        return;
+    }
+
+    uint begin = uint(range.x);
+    uint end = uint(range.y);
+    if (serial != 0) {
+        if (id != 0u) return;
+        for (uint k = begin; k < end; ++k) {
+            if (stage == 1) solveDistance(k);
+            else solveBend(k);
+        }
+        return;
+    }
+    uint k = begin + id;
+    if (k >= end) return;
+    if (stage == 1) solveDistance(k);
+    else solveBend(k);
+}
+)";
+
+const uint32_t kGroupSize = 64;
+
+const int kStageIntegrate = 0;
+const int kStageDistances = 1;
+const int kStageBends = 2;
+const int kStageNormals = 3;
+
+// glMemoryBarrier bits
+const unsigned int kVertexAttribBarrier = 0x00000001;
+const unsigned int kBufferUpdateBarrier = 0x00000200;
+const unsigned int kStorageBarrier = 0x00002000;
+
+struct GpuDistance {
+    uint32_t a, b;
+    float rest;
+    float weightA, weightB;
+    float pad[3];
+};
+static_assert(sizeof(GpuDistance) == 32, "std430 Distance layout");
+
+struct GpuBend {
+    uint32_t a, b, c;
+    float restAngle;
+    float stiffness;
+    float pad[3];
+};
+static_assert(sizeof(GpuBend) == 32, "std430 Bend layout");
+
+#if defined(_WIN32)
+typedef void (__stdcall* MemoryBarrierProc)(unsigned int barriers);
+#else
+typedef void (*MemoryBarrierProc)(unsigned int barriers);
+#endif
+
+MemoryBarrierProc memoryBarrierProc = nullptr;
+
+void memoryBarrier(unsigned int barriers) {
+    if (memoryBarrierProc) memoryBarrierProc(barriers);
+}
+
+} // namespace
+
+GpuCloth::GpuCloth() : GpuCloth(GpuClothConfig{}) {}
+
+GpuCloth::GpuCloth(const GpuClothConfig& cfg)
+    : config(cfg) {
+    config.iterations = std::max(config.iterations, 1);
+}
+
+GpuCloth::~GpuCloth() {
+    unload();
+}
+
+bool GpuCloth::load(const Cape3D& cape) {
+    unload();
+    if (rlGetVersion() != RL_OPENGL_43) return false;
+    if (cape.getConfig().solver != ClothSolver3D::Iterative) return false;
+
+    if (!memoryBarrierProc) {
+        memoryBarrierProc = reinterpret_cast<MemoryBarrierProc>(glfwGetProcAddress("glMemoryBarrier"));
+        if (!memoryBarrierProc) return false;
+    }
+
+    unsigned int shaderId = rlCompileShader(kClothComputeShader, RL_COMPUTE_SHADER);
+    if (shaderId == 0) return false;
+    program = rlLoadComputeShaderProgram(shaderId);
+    if (program == 0) return false;
+
+    width = cape.getWidth();
+    segments = cape.getSegments();
+    const ClothParticles3D& store = cape.getParticleStore();
+    particleCount = store.size();
+
+    // Particle state, interleaved xyzw
+    std::vector<float> positions(particleCount * 4);
+    std::vector<float> previous(particleCount * 4);
+    std::vector<float> normals(particleCount * 4);
+    const float* nx = cape.normalsX();
+    const float* ny = cape.normalsY();
+    const float* nz = cape.normalsZ();
+    for (size_t i = 0; i < particleCount; ++i) {
+        Vector3D p = store.getPosition(i);
+        Vector3D q = store.getPreviousPosition(i);
+        int row = static_cast<int>(i) / width;
+        int col = static_cast<int>(i) % width;
+        bool interior = row > 0 && row < segments - 1 && col > 0 && col < width - 1;
+        float* pos = &positions[i * 4];
+        float* prev = &previous[i * 4];
+        float* normal = &normals[i * 4];
+        pos[0] = p.x; pos[1] = p.y; pos[2] = p.z; pos[3] = store.inverseMasses()[i];
+        prev[0] = q.x; prev[1] = q.y; prev[2] = q.z; prev[3] = store.getMass(i);
+        normal[0] = nx[i]; normal[1] = ny[i]; normal[2] = nz[i];
+        normal[3] = interior && !store.isPinned(i) ? 1.0f : 0.0f;
+    }
+
+    // Constraints keep their batch order, so batches stay contiguous ranges
+    ClothDistanceView3D distances = cape.getConstraints().getDistanceView();
+    std::vector<GpuDistance> packedDistances(std::max<size_t>(distances.count, 1));
+    for (size_t i = 0; i < distances.count; ++i) {
+        packedDistances[i] = { distances.a[i], distances.b[i], distances.restLength[i],
+                               distances.weightA[i], distances.weightB[i], { 0, 0, 0 } };
+    }
+    ClothBendView3D bends = cape.getConstraints().getBendView();
+    std::vector<GpuBend> packedBends(std::max<size_t>(bends.count, 1));
+    for (size_t i = 0; i < bends.count; ++i) {
+        packedBends[i] = { bends.a[i], bends.b[i], bends.c[i], bends.restAngle[i], bends.stiffness[i], { 0, 0, 0 } };
+    }
+
+    distanceBatches.clear();
+    for (const ClothConstraintBatch& batch : cape.getConstraints().getDistanceBatches()) {
+        distanceBatches.push_back({ batch.begin, batch.end, batch.independent });
+    }
+    bendBatches.clear();
+    for (const ClothConstraintBatch& batch : cape.getConstraints().getBendBatches()) {
+        bendBatches.push_back({ batch.begin, batch.end, batch.independent });
+    }
+
+    unsigned int stateBytes = static_cast<unsigned int>(particleCount * 4 * sizeof(float));
+    positionBuffer = rlLoadShaderBuffer(stateBytes, positions.data(), RL_DYNAMIC_COPY);
+    previousBuffer = rlLoadShaderBuffer(stateBytes, previous.data(), RL_DYNAMIC_COPY);
+    normalBuffer = rlLoadShaderBuffer(stateBytes, normals.data(), RL_DYNAMIC_COPY);
+    distanceBuffer = rlLoadShaderBuffer(static_cast<unsigned int>(packedDistances.size() * sizeof(GpuDistance)),
+                                        packedDistances.data(), RL_DYNAMIC_COPY);
+    bendBuffer = rlLoadShaderBuffer(static_cast<unsigned int>(packedBends.size() * sizeof(GpuBend)),
+                                    packedBends.data(), RL_DYNAMIC_COPY);
+    if (config.readback) {
+        stagingBuffers[0] = rlLoadShaderBuffer(stateBytes, nullptr, RL_DYNAMIC_COPY);
+        stagingBuffers[1] = rlLoadShaderBuffer(stateBytes, nullptr, RL_DYNAMIC_COPY);
+    }
+    loaded = true;
+    if (positionBuffer == 0 || previousBuffer == 0 || normalBuffer == 0 || distanceBuffer == 0 || bendBuffer == 0 ||
+        (config.readback && (stagingBuffers[0] == 0 || stagingBuffers[1] == 0))) {
+        unload();
+        return false;
+    }
+
+    locStage = rlGetLocationUniform(program, "stage");
+    locGrid = rlGetLocationUniform(program, "grid");
+    locRange = rlGetLocationUniform(program, "range");
+    locSerial = rlGetLocationUniform(program, "serial");
+    locFrameParams = rlGetLocationUniform(program, "frameParams");
+    locAttachVelocity = rlGetLocationUniform(program, "attachVelocity");
+    locSwayAxis = rlGetLocationUniform(program, "swayAxis");
+    locAero = rlGetLocationUniform(program, "aero");
+    locWindOrigin = rlGetLocationUniform(program, "windOrigin");
+    locWindResolution = rlGetLocationUniform(program, "windResolution");
+    locWindFallback = rlGetLocationUniform(program, "windFallback");
+    locMeshBase = rlGetLocationUniform(program, "meshBase");
+
+    pinStaging.assign(static_cast<size_t>(width) * 4, 0.0f);
+    readbackStaging.assign(particleCount * 4, 0.0f);
+    windResolution = 0;
+    windRevision = 0;
+    lastStep = cape.getLastStep();
+    frame = 0;
+    readbackPending = false;
+    return true;
+}
+
+void GpuCloth::unload() {
+    if (!loaded && program == 0) return;
+    unsigned int* buffers[] = { &positionBuffer, &previousBuffer, &normalBuffer, &distanceBuffer,
+                                &bendBuffer, &windBuffer, &stagingBuffers[0], &stagingBuffers[1] };
+    for (unsigned int* buffer : buffers) {
+        if (*buffer != 0) rlUnloadShaderBuffer(*buffer);
+        *buffer = 0;
+    }
+    if (program != 0) rlUnloadShaderProgram(program);
+    program = 0;
+    distanceBatches.clear();
+    bendBatches.clear();
+    windResolution = 0;
+    readbackPending = false;
+    loaded = false;
+}
+
+void GpuCloth::uploadWind(const WindField3D& wind) {
+    WindGridView3D view;
+    windRevision = wind.getGridRevision();
+    if (!wind.getGridView(view)) {
+        windResolution = 0;
+        return;
+    }
+
+    const int n = view.resolution;
+    const size_t nodes = static_cast<size_t>(n) * n * n;
+    windStaging.resize(nodes * 3);
+    for (size_t i = 0; i < nodes; ++i) {
+        windStaging[i * 3 + 0] = view.vx[i];
+        windStaging[i * 3 + 1] = view.vy[i];
+        windStaging[i * 3 + 2] = view.vz[i];
+    }
+
+    unsigned int bytes = static_cast<unsigned int>(windStaging.size() * sizeof(float));
+    if (windBuffer == 0 || n != windResolution) {
+        if (windBuffer != 0) rlUnloadShaderBuffer(windBuffer);
+        windBuffer = rlLoadShaderBuffer(bytes, windStaging.data(), RL_DYNAMIC_COPY);
+    } else {
+        rlUpdateShaderBuffer(windBuffer, windStaging.data(), bytes, 0);
+    }
+    windResolution = windBuffer != 0 ? n : 0;
+    windOrigin = view.origin;
+    windCellSize = view.cellSize;
+}
+
+void GpuCloth::dispatch(int stage, uint32_t invocations) {
+    rlSetUniform(locStage, &stage, RL_SHADER_UNIFORM_INT, 1);
+    rlComputeShaderDispatch((invocations + kGroupSize - 1) / kGroupSize, 1, 1);
+    memoryBarrier(kStorageBarrier);
+}
+
+void GpuCloth::solveBatches(int stage, const std::vector<Batch>& batches) {
+    for (const Batch& batch : batches) {
+        if (batch.end <= batch.begin) continue;
+        int range[2] = { static_cast<int>(batch.begin), static_cast<int>(batch.end) };
+        int serial = batch.independent ? 0 : 1;
+        rlSetUniform(locRange, range, RL_SHADER_UNIFORM_IVEC2, 1);
+        rlSetUniform(locSerial, &serial, RL_SHADER_UNIFORM_INT, 1);
+        dispatch(stage, batch.independent ? batch.end - batch.begin : 1);
+    }
+}
+
+void GpuCloth::step(Cape3D& cape, float dt, const WindField3D& wind) {
+    if (!loaded || cape.getWidth() != width || cape.getSegments() != segments) return;
+    PROFILE_SCOPE("GpuCloth::step");
+
+    if (wind.getGridRevision() != windRevision || wind.isGridEnabled() != (windResolution > 0)) {
+        uploadWind(wind);
+    }
+
+    // The attach row follows the character; it is the only state uploaded per frame
+    const ClothParticles3D& store = cape.getParticleStore();
+    for (int col = 0; col < width; ++col) {
+        Vector3D p = store.getPosition(col);
+        float* out = &pinStaging[col * 4];
+        out[0] = p.x; out[1] = p.y; out[2] = p.z; out[3] = store.inverseMasses()[col];
+    }
+    rlUpdateShaderBuffer(positionBuffer, pinStaging.data(), static_cast<unsigned int>(pinStaging.size() * sizeof(float)), 0);
+
+    const CapeConfig3D& capeConfig = cape.getConfig();
+    const Vector3D& attach = cape.getAttachVelocity();
+    Vector3D sway = cape.getForward().cross(Vector3D(0, 1, 0));
+    Vector3D fallback = wind.getWindAt(store.getPosition(particleCount / 2));
+    int gridSize[2] = { width, segments };
+    float frameParams[4] = { dt, -capeConfig.gravity, attach.length(), dt * 3.0f };
+    // As Cape3D::beginStep: the stored velocity covers lastStep, so bring it to dt,
+    // and damp by the 1/60 s damping raised to this step's length
+    float velocityScale = cape.getStepDamping(dt) * (lastStep > 0.0f ? dt / lastStep : 1.0f);
+    lastStep = dt;
+    float attachVelocity[4] = { attach.x, attach.y, attach.z, velocityScale };
+    float swayAxis[3] = { sway.x, sway.y, sway.z };
+    float aero[4] = { capeConfig.windInfluence, capeConfig.aerodynamicDrag, capeConfig.liftCoefficient, 0.0f };
+    float origin[4] = { windOrigin.x, windOrigin.y, windOrigin.z, windCellSize };
+    float windFallback[3] = { fallback.x, fallback.y, fallback.z };
+    int noMesh = -1;
+
+    rlEnableShader(program);
+    rlSetUniform(locGrid, gridSize, RL_SHADER_UNIFORM_IVEC2, 1);
+    rlSetUniform(locFrameParams, frameParams, RL_SHADER_UNIFORM_VEC4, 1);
+    rlSetUniform(locAttachVelocity, attachVelocity, RL_SHADER_UNIFORM_VEC4, 1);
+    rlSetUniform(locSwayAxis, swayAxis, RL_SHADER_UNIFORM_VEC3, 1);
+    rlSetUniform(locAero, aero, RL_SHADER_UNIFORM_VEC4, 1);
+    rlSetUniform(locWindOrigin, origin, RL_SHADER_UNIFORM_VEC4, 1);
+    rlSetUniform(locWindResolution, &windResolution, RL_SHADER_UNIFORM_INT, 1);
+    rlSetUniform(locWindFallback, windFallback, RL_SHADER_UNIFORM_VEC3, 1);
+    rlSetUniform(locMeshBase, &noMesh, RL_SHADER_UNIFORM_INT, 1);
+
+    rlBindShaderBuffer(positionBuffer, 0);
+    rlBindShaderBuffer(previousBuffer, 1);
+    rlBindShaderBuffer(normalBuffer, 2);
+    rlBindShaderBuffer(distanceBuffer, 3);
+    rlBindShaderBuffer(bendBuffer, 4);
+    rlBindShaderBuffer(windBuffer, 5);
+
+    // Same schedule as Cape3D::solveConstraints: bends on every other iteration
+    dispatch(kStageIntegrate, static_cast<uint32_t>(particleCount));
+    for (int i = 0; i < config.iterations; ++i) {
+        solveBatches(kStageDistances, distanceBatches);
+        if (i % 2 == 0) solveBatches(kStageBends, bendBatches);
+    }
+    dispatch(kStageNormals, static_cast<uint32_t>(particleCount));
+    rlDisableShader();
+
+    if (!config.readback) return;
+
+    // Copy this frame out, then read the copy issued a frame ago, which the GPU has
+    // long finished, so the read does not wait on the solve just queued
+    unsigned int stateBytes = static_cast<unsigned int>(particleCount * 4 * sizeof(float));
+    memoryBarrier(kBufferUpdateBarrier);
+    rlCopyShaderBuffer(stagingBuffers[frame & 1], positionBuffer, 0, 0, stateBytes);
+    if (readbackPending) {
+        rlReadShaderBuffer(stagingBuffers[(frame + 1) & 1], readbackStaging.data(), stateBytes, 0);
+        cape.loadPositions(readbackStaging.data(), particleCount);
+    }
+    readbackPending = true;
+    frame++;
+}
+
+float GpuCloth::measureDivergence(const CapeConfig3D& capeConfig, const WindField3D& wind, int steps) {
+    CapeConfig3D config = capeConfig;
+    config.solver = ClothSolver3D::Iterative;
+    config.selfCollision = false;   // Not solved on the GPU
+    const Vector3D start(0, 100, 0);
+    const Vector3D forward(0, 0, 1);
+    Cape3D reference(start, forward, config);
+    Cape3D mirrored(start, forward, config);
+
+    GpuClothConfig gpuConfig;
+    gpuConfig.readback = false;
+    GpuCloth gpu(gpuConfig);
+    if (!gpu.load(mirrored)) return -1.0f;
+
+    // Step length flips every ten steps, as at ClothWorld's LOD boundaries
+    Vector3D point = start;
+    for (int i = 0; i < steps; ++i) {
+        float dt = (i / 10) % 2 == 0 ? 1.0f / 60.0f : 1.0f / 30.0f;
+        Vector3D next = start + Vector3D(std::sin(i * 0.1f) * 20.0f, 0.0f, i * 1.5f);
+        Vector3D velocity = (next - point) * (1.0f / dt);
+        point = next;
+        for (Cape3D* cape : { &reference, &mirrored }) {
+            cape->setAttachPoint(point, forward);
+            cape->setAttachVelocity(velocity);
+        }
+        reference.update(dt, wind);
+        reference.solveConstraints(gpu.config.iterations);
+        gpu.step(mirrored, dt, wind);
+    }
+
+    std::vector<float> positions(gpu.particleCount * 4);
+    rlReadShaderBuffer(gpu.positionBuffer, positions.data(),
+                       static_cast<unsigned int>(positions.size() * sizeof(float)), 0);
+    const ClothParticles3D& store = reference.getParticleStore();
+    float divergence = 0.0f;
+    for (size_t i = 0; i < gpu.particleCount; ++i) {
+        Vector3D p(positions[i * 4], positions[i * 4 + 1], positions[i * 4 + 2]);
+        divergence = std::max(divergence, (p - store.getPosition(i)).length());
+    }
+    return divergence;
+}
+
+void GpuCloth::writeMesh(unsigned int positionTarget, unsigned int normalTarget, int baseVertex) {
+    if (!loaded) return;
+    int gridSize[2] = { width, segments };
+
+    rlEnableShader(program);
+    rlSetUniform(locGrid, gridSize, RL_SHADER_UNIFORM_IVEC2, 1);
+    rlSetUniform(locMeshBase, &baseVertex, RL_SHADER_UNIFORM_INT, 1);
+    rlBindShaderBuffer(positionBuffer, 0);
+    rlBindShaderBuffer(normalBuffer, 2);
+    rlBindShaderBuffer(positionTarget, 6);
+    rlBindShaderBuffer(normalTarget, 7);
+    dispatch(kStageNormals, static_cast<uint32_t>(particleCount));
+    rlDisableShader();
+    memoryBarrier(kVertexAttribBarrier);
+}
+
+} // namespace ethereal
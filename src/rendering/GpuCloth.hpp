@@ -0,0 +1,108 @@
+#pragma once
+#include "physics/Cape3D.hpp"
+#include "physics/WindField3D.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace ethereal {
+
+struct GpuClothConfig {
+    int iterations = 5;
+    // Copy the solved positions back into the Cape3D, one frame late, so
+    // getParticles() and the other gameplay queries keep working
+    bool readback = true;
+};
+
+// Compute-shader backend for an Iterative-solver Cape3D. Particle state lives in
+// shader storage buffers; each step runs the force/Verlet pass, then one dispatch
+// per graph-colored constraint batch and iteration, then the normals. CapeMesh
+// reads the result straight into its vertex buffers (writeMesh), so nothing has to
+// come back for drawing. The pinned row is uploaded from the cape every step.
+// Self, body and ground collisions are not solved here; capes that need them stay
+// on the CPU path.
+class GpuCloth {
+public:
+    GpuCloth();
+    explicit GpuCloth(const GpuClothConfig& config);
+    ~GpuCloth();
+
+    GpuCloth(const GpuCloth&) = delete;
+    GpuCloth& operator=(const GpuCloth&) = delete;
+
+    // Requires an open window on raylib's OpenGL 4.3 backend and an Iterative cape;
+    // false leaves the cape to Cape3D::update / solveConstraints
+    bool load(const Cape3D& cape);
+    void unload();
+    bool isLoaded() const { return loaded; }
+
+    // Replaces cape.update() + cape.solveConstraints() for this frame
+    void step(Cape3D& cape, float dt, const WindField3D& wind);
+    // Current positions and normals into a mesh's position / normal VBOs, starting
+    // at vertex `baseVertex`. Issues the vertex-attribute barrier itself.
+    void writeMesh(unsigned int positionTarget, unsigned int normalTarget, int baseVertex);
+
+    // Parity check: steps a cape on the CPU and a copy here through the same
+    // attach path and changing step lengths, and returns the largest position
+    // difference in world units; negative when no compute context is available
+    static float measureDivergence(const CapeConfig3D& config, const WindField3D& wind, int steps = 60);
+
+    int getWidth() const { return width; }
+    int getSegments() const { return segments; }
+    size_t getParticleCount() const { return particleCount; }
+    const GpuClothConfig& getConfig() const { return config; }
+
+private:
+    struct Batch {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        bool independent = true;
+    };
+
+    GpuClothConfig config;
+    int width = 0;
+    int segments = 0;
+    size_t particleCount = 0;
+    bool loaded = false;
+
+    unsigned int program = 0;
+    unsigned int positionBuffer = 0;    // xyz, w = inverse mass
+    unsigned int previousBuffer = 0;    // xyz, w = mass
+    unsigned int normalBuffer = 0;      // xyz, w = aero mask
+    unsigned int distanceBuffer = 0;
+    unsigned int bendBuffer = 0;
+    unsigned int windBuffer = 0;
+    unsigned int stagingBuffers[2] = { 0, 0 };
+    std::vector<Batch> distanceBatches;
+    std::vector<Batch> bendBatches;
+
+    int windResolution = 0;
+    uint32_t windRevision = 0;
+    Vector3D windOrigin;
+    float windCellSize = 0.0f;
+    std::vector<float> windStaging;
+
+    std::vector<float> pinStaging;      // Row 0, xyzw
+    std::vector<float> readbackStaging;
+    int frame = 0;
+    bool readbackPending = false;
+    float lastStep = 0.0f;              // dt of the last step; the GPU velocity spans it
+
+    int locStage = -1;
+    int locGrid = -1;
+    int locRange = -1;
+    int locSerial = -1;
+    int locFrameParams = -1;
+    int locAttachVelocity = -1;
+    int locSwayAxis = -1;
+    int locAero = -1;
+    int locWindOrigin = -1;
+    int locWindResolution = -1;
+    int locWindFallback = -1;
+    int locMeshBase = -1;
+
+    void uploadWind(const WindField3D& wind);
+    void dispatch(int stage, uint32_t invocations);
+    void solveBatches(int stage, const std::vector<Batch>& batches);
+};
+
+} // namespace ethereal
@@ -47,9 +47,11 @@ void Renderer::shutdown() {
 
 void Renderer::beginFrame() {
     BeginDrawing();
+    shapes.begin();
 }
 
 void Renderer::endFrame() {
+    shapes.flush();
     EndDrawing();
 }
 
@@ -78,29 +80,87 @@ void Renderer::drawBackground(float time) {
 void Renderer::drawWindField(const WindField& wind, const Vector2D& cameraOffset) {
     if (!config.showWindField) return;
 
-    int gridSize = config.windGridSize;
-    
-    for (int x = 0; x < config.screenWidth; x += gridSize) {
-        for (int y = 0; y < config.screenHeight; y += gridSize) {
-            Vector2D worldPos(x + cameraOffset.x, y + cameraOffset.y);
-            Vector2D windVec = wind.getWindAt(worldPos);
+    updateWindOverlay(wind, cameraOffset);
+
+    const WindOverlay& overlay = windOverlay;
+    for (int row = 0; row < overlay.rows; ++row) {
+        for (int col = 0; col < overlay.cols; ++col) {
+            Vector2D windVec = overlay.samples[row * overlay.cols + col];
+            Vector2D start(static_cast<float>((overlay.originX + col) * overlay.gridSize) - cameraOffset.x,
+                           static_cast<float>((overlay.originY + row) * overlay.gridSize) - cameraOffset.y);
             
             float strength = std::min(windVec.length() / 100.0f, 1.0f);
             Vector2D dir = windVec.normalized();
             
             float lineLength = 10.0f + strength * 15.0f;
-            Vector2D end = Vector2D(x, y) + dir * lineLength;
+            Vector2D end = start + dir * lineLength;
             
             Color lineColor = config.windColor;
             lineColor.a = static_cast<unsigned char>(30 + strength * 50);
             
-            DrawLineEx(
-                {static_cast<float>(x), static_cast<float>(y)},
-                {end.x, end.y},
-                1.0f + strength,
-                lineColor
-            );
+            shapes.addLine(start, end, 1.0f + strength, lineColor);
+        }
+    }
+}
+
+void Renderer::updateWindOverlay(const WindField& wind, const Vector2D& cameraOffset) {
+    WindOverlay& overlay = windOverlay;
+    int gridSize = std::max(config.windGridSize, 4);
+    int cols = config.screenWidth / gridSize + 2;
+    int rows = config.screenHeight / gridSize + 2;
+    int originX = static_cast<int>(std::floor(cameraOffset.x / gridSize));
+    int originY = static_cast<int>(std::floor(cameraOffset.y / gridSize));
+
+    if (overlay.cols != cols || overlay.rows != rows || overlay.gridSize != gridSize) {
+        overlay.cols = cols;
+        overlay.rows = rows;
+        overlay.gridSize = gridSize;
+        overlay.originX = originX;
+        overlay.originY = originY;
+        overlay.nextRow = 0;
+        overlay.samples.assign(static_cast<size_t>(cols) * rows, Vector2D::zero());
+        for (int row = 0; row < rows; ++row) sampleWindRow(wind, row);
+        return;
+    }
+
+    if (originX != overlay.originX || originY != overlay.originY) {
+        // Scroll: keep the overlap, read only the cells that came into view
+        int shiftX = originX - overlay.originX;
+        int shiftY = originY - overlay.originY;
+        overlay.scratch.resize(overlay.samples.size());
+        for (int row = 0; row < rows; ++row) {
+            for (int col = 0; col < cols; ++col) {
+                int srcCol = col + shiftX;
+                int srcRow = row + shiftY;
+                Vector2D& out = overlay.scratch[row * cols + col];
+                if (srcCol >= 0 && srcCol < cols && srcRow >= 0 && srcRow < rows) {
+                    out = overlay.samples[srcRow * cols + srcCol];
+                } else {
+                    out = wind.getWindAt(static_cast<float>((originX + col) * gridSize),
+                                         static_cast<float>((originY + row) * gridSize));
+                }
+            }
         }
+        overlay.samples.swap(overlay.scratch);
+        overlay.originX = originX;
+        overlay.originY = originY;
+    }
+
+    // The field itself drifts slowly, so a few rows per frame keep it current
+    int frames = std::max(config.windRefreshFrames, 1);
+    int rowsPerFrame = (rows + frames - 1) / frames;
+    for (int i = 0; i < rowsPerFrame; ++i) {
+        sampleWindRow(wind, overlay.nextRow);
+        overlay.nextRow = (overlay.nextRow + 1) % rows;
+    }
+}
+
+void Renderer::sampleWindRow(const WindField& wind, int row) {
+    WindOverlay& overlay = windOverlay;
+    float y = static_cast<float>((overlay.originY + row) * overlay.gridSize);
+    for (int col = 0; col < overlay.cols; ++col) {
+        float x = static_cast<float>((overlay.originX + col) * overlay.gridSize);
+        overlay.samples[row * overlay.cols + col] = wind.getWindAt(x, y);
     }
 }
 
@@ -114,14 +174,7 @@ void Renderer::drawCapeSegment(const Vector2D& p1, const Vector2D& p2,
     Vector2D q3 = p3 - offset;
     Vector2D q4 = p4 - offset;
 
-    DrawTriangle(
-        {q1.x, q1.y}, {q3.x, q3.y}, {q2.x, q2.y},
-        color
-    );
-    DrawTriangle(
-        {q2.x, q2.y}, {q3.x, q3.y}, {q4.x, q4.y},
-        color
-    );
+    shapes.addQuad(q1, q2, q3, q4, color);
 }
 
 void Renderer::drawCape(const Cape& cape, const Vector2D& cameraOffset) {
@@ -143,19 +196,19 @@ void Renderer::drawCape(const Cape& cape, const Vector2D& cameraOffset) {
 
     Color edgeColor = {200, 160, 120, 180};
     for (int row = 0; row < segments - 1; ++row) {
-        const auto& pLeft1 = cape.getParticle(row, 0).position - cameraOffset;
-        const auto& pLeft2 = cape.getParticle(row + 1, 0).position - cameraOffset;
-        DrawLineEx({pLeft1.x, pLeft1.y}, {pLeft2.x, pLeft2.y}, 2.0f, edgeColor);
+        Vector2D pLeft1 = cape.getParticle(row, 0).position - cameraOffset;
+        Vector2D pLeft2 = cape.getParticle(row + 1, 0).position - cameraOffset;
+        shapes.addLine(pLeft1, pLeft2, 2.0f, edgeColor);
         
-        const auto& pRight1 = cape.getParticle(row, width - 1).position - cameraOffset;
-        const auto& pRight2 = cape.getParticle(row + 1, width - 1).position - cameraOffset;
-        DrawLineEx({pRight1.x, pRight1.y}, {pRight2.x, pRight2.y}, 2.0f, edgeColor);
+        Vector2D pRight1 = cape.getParticle(row, width - 1).position - cameraOffset;
+        Vector2D pRight2 = cape.getParticle(row + 1, width - 1).position - cameraOffset;
+        shapes.addLine(pRight1, pRight2, 2.0f, edgeColor);
     }
 
     for (int col = 0; col < width - 1; ++col) {
-        const auto& p1 = cape.getParticle(segments - 1, col).position - cameraOffset;
-        const auto& p2 = cape.getParticle(segments - 1, col + 1).position - cameraOffset;
-        DrawLineEx({p1.x, p1.y}, {p2.x, p2.y}, 2.0f, edgeColor);
+        Vector2D p1 = cape.getParticle(segments - 1, col).position - cameraOffset;
+        Vector2D p2 = cape.getParticle(segments - 1, col + 1).position - cameraOffset;
+        shapes.addLine(p1, p2, 2.0f, edgeColor);
     }
 }
 
@@ -166,21 +219,17 @@ void Renderer::drawCharacter(const Character& character, const Vector2D& cameraO
 
     Color glowColor = {255, 240, 220, 40};
     for (int i = 3; i > 0; --i) {
-        DrawCircle(static_cast<int>(pos.x), static_cast<int>(pos.y), 
-                  radius + i * 8, glowColor);
+        shapes.addCircle(pos, radius + i * 8, glowColor);
     }
 
-    DrawCircle(static_cast<int>(pos.x), static_cast<int>(pos.y), 
-              radius, config.characterColor);
+    shapes.addCircle(pos, radius, config.characterColor);
 
     Color innerColor = {255, 250, 245, 255};
-    DrawCircle(static_cast<int>(pos.x), static_cast<int>(pos.y), 
-              radius * 0.7f, innerColor);
+    shapes.addCircle(pos, radius * 0.7f, innerColor);
 
     Vector2D eyeOffset = Vector2D::fromAngle(angle, radius * 0.3f);
     Vector2D eyePos = pos + eyeOffset;
-    DrawCircle(static_cast<int>(eyePos.x), static_cast<int>(eyePos.y), 
-              radius * 0.15f, {60, 80, 100, 255});
+    shapes.addCircle(eyePos, radius * 0.15f, {60, 80, 100, 255});
 
     float speed = character.getSpeed();
     if (speed > 100.0f) {
@@ -190,13 +239,14 @@ void Renderer::drawCharacter(const Character& character, const Vector2D& cameraO
             Vector2D trailPos = pos + trailDir * (i * 15.0f);
             float alpha = 1.0f - (static_cast<float>(i) / (trailCount + 1));
             Color trailColor = {255, 240, 220, static_cast<unsigned char>(alpha * 100)};
-            DrawCircle(static_cast<int>(trailPos.x), static_cast<int>(trailPos.y),
-                      radius * (0.5f - i * 0.08f), trailColor);
+            shapes.addCircle(trailPos, radius * (0.5f - i * 0.08f), trailColor);
         }
     }
 }
 
 void Renderer::drawUI(const FlightController& flight, const PerformanceMonitor& perf) {
+    shapes.flush();
+
     DrawRectangle(10, 10, 300, 100, {0, 0, 0, 120});
     DrawRectangleLines(10, 10, 300, 100, {100, 100, 100, 150});
 
@@ -235,8 +285,7 @@ void Renderer::drawParticles(const WindField& wind, float time, const Vector2D&
         }
 
         Color particleColor = {255, 255, 255, static_cast<unsigned char>(p.alpha * 255)};
-        DrawCircle(static_cast<int>(screenPos.x), static_cast<int>(screenPos.y), 
-                  p.size, particleColor);
+        shapes.addCircle(screenPos, p.size, particleColor);
     }
 }
 
@@ -2,6 +2,7 @@
 #include "raylib.h"
 #include "core/Vector2D.hpp"
 #include "physics/Cape.hpp"
+#include "rendering/ShapeBatch2D.hpp"
 #include "physics/WindField.hpp"
 #include "entities/Character.hpp"
 #include "entities/FlightController.hpp"
@@ -21,6 +22,7 @@ struct RenderConfig {
     bool showWindField = true;
     bool showDebug = false;
     int windGridSize = 40;
+    int windRefreshFrames = 6;      // Overlay rows are re-sampled round-robin over this many frames
 };
 
 class Renderer {
@@ -51,6 +53,22 @@ public:
 private:
     RenderConfig config;
     bool initialized;
+    // Wind lines, particles, cape and character; flushed before the UI
+    ShapeBatch2D shapes;
+    
+    // Wind overlay samples on a world-aligned lattice, so a scrolling camera
+    // reuses every sample still on screen and only the newly exposed edge is read
+    struct WindOverlay {
+        int originX = 0;            // Lattice cell of the top-left sample
+        int originY = 0;
+        int cols = 0;
+        int rows = 0;
+        int gridSize = 0;
+        int nextRow = 0;            // Next row due for a refresh
+        std::vector<Vector2D> samples;
+        std::vector<Vector2D> scratch;
+    };
+    WindOverlay windOverlay;
     
     struct FloatingParticle {
         Vector2D position;
@@ -66,6 +84,8 @@ private:
                          float depth, const Vector2D& offset);
     Color lerpColor(Color a, Color b, float t) const;
     void updateParticles(float dt, const WindField& wind);
+    void updateWindOverlay(const WindField& wind, const Vector2D& cameraOffset);
+    void sampleWindRow(const WindField& wind, int row);
 };
 
 } // namespace ethereal
@@ -33,6 +33,13 @@ void Renderer3D::initialize() {
 
 void Renderer3D::shutdown() {
     if (initialized) {
+        // GPU resources must go before the GL context
+        gpuAtmosphere.reset();
+        sky.unload();
+        glow.unload();
+        capeMesh.unload();
+        terrainMesh.unload();
+        terrainShader.unload();
         CloseWindow();
         initialized = false;
     }
@@ -41,18 +48,34 @@ void Renderer3D::shutdown() {
 void Renderer3D::initParticles() {
     particles.clear();
     for (int i = 0; i < config.particleCount; ++i) {
-        AtmosphereParticle p;
-        p.position = Vector3D(
-            GetRandomValue(-500, 500),
-            GetRandomValue(0, 300),
-            GetRandomValue(-500, 500)
-        );
-        p.velocity = Vector3D::zero();
-        p.alpha = GetRandomValue(10, 40) / 255.0f;
-        p.size = GetRandomValue(5, 20) / 10.0f;
-        p.lifetime = GetRandomValue(0, 1000) / 100.0f;
-        p.type = GetRandomValue(0, 2);
-        particles.push_back(p);
+        particles.push_back(spawnParticle());
+    }
+}
+
+AtmosphereParticle Renderer3D::spawnParticle() const {
+    AtmosphereParticle p;
+    p.position = Vector3D(
+        GetRandomValue(-500, 500),
+        GetRandomValue(0, 300),
+        GetRandomValue(-500, 500)
+    );
+    p.velocity = Vector3D::zero();
+    p.alpha = GetRandomValue(10, 40) / 255.0f;
+    p.size = GetRandomValue(5, 20) / 10.0f;
+    p.lifetime = GetRandomValue(0, 1000) / 100.0f;
+    p.type = GetRandomValue(0, 2);
+    return p;
+}
+
+void Renderer3D::setParticleCount(int count) {
+    config.particleCount = std::max(count, 0);
+    if (!initialized) return;   // initialize() spawns them
+    size_t target = static_cast<size_t>(config.particleCount);
+    if (particles.size() > target) {
+        particles.resize(target);
+    }
+    while (particles.size() < target) {
+        particles.push_back(spawnParticle());
     }
 }
 
@@ -60,6 +83,10 @@ void Renderer3D::beginFrame(const FlightCamera& camera) {
     raylibCamera.position = { camera.getPosition().x, camera.getPosition().y, camera.getPosition().z };
     raylibCamera.target = { camera.getTarget().x, camera.getTarget().y, camera.getTarget().z };
     
+    float aspect = static_cast<float>(GetScreenWidth()) / std::max(GetScreenHeight(), 1);
+    culler.begin(camera, std::max(config.cullFov, raylibCamera.fovy), aspect,
+                 static_cast<float>(RL_CULL_DISTANCE_NEAR), static_cast<float>(RL_CULL_DISTANCE_FAR));
+    
     BeginDrawing();
     ClearBackground(config.skyColorBottom);
 }
@@ -69,38 +96,15 @@ void Renderer3D::endFrame() {
 }
 
 void Renderer3D::drawSky(const FlightCamera& camera, float time) {
-    // Draw gradient background
-    for (int y = 0; y < config.screenHeight; ++y) {
-        float t = static_cast<float>(y) / config.screenHeight;
-        Color lineColor = {
-            (unsigned char)(config.skyColorTop.r + (config.skyColorBottom.r - config.skyColorTop.r) * t),
-            (unsigned char)(config.skyColorTop.g + (config.skyColorBottom.g - config.skyColorTop.g) * t),
-            (unsigned char)(config.skyColorTop.b + (config.skyColorBottom.b - config.skyColorTop.b) * t),
-            255
-        };
-        DrawLine(0, y, config.screenWidth, y, lineColor);
-    }
-    
-    BeginMode3D(raylibCamera);
-    
-    rlDisableDepthMask();
-    rlDisableDepthTest();
-    
-    Vector3D camPos = camera.getPosition();
-    
-    // Sun with layered glow
-    Vector3D sunDir = config.sunDirection.normalized();
-    Vector3D sunPos = camPos + sunDir * 700.0f;
-    
-    DrawSphere({sunPos.x, sunPos.y, sunPos.z}, 120.0f, {255, 250, 235, 15});
-    DrawSphere({sunPos.x, sunPos.y, sunPos.z}, 80.0f, {255, 250, 230, 30});
-    DrawSphere({sunPos.x, sunPos.y, sunPos.z}, 50.0f, {255, 252, 240, 60});
-    DrawSphere({sunPos.x, sunPos.y, sunPos.z}, 30.0f, config.sunColor);
-    
-    rlEnableDepthTest();
-    rlEnableDepthMask();
-    
-    EndMode3D();
+    // Day sky: top-to-bottom gradient with the sun and its glow, no stars
+    SkyShading shading;
+    shading.zenithColor = config.skyColorTop;
+    shading.horizonColor = config.skyColorBottom;
+    shading.sunDirection = config.sunDirection;
+    shading.sunColor = config.sunColor;
+    
+    if (!sky.isLoaded()) sky.load();
+    sky.draw(camera.getPosition(), camera.getTarget(), raylibCamera.fovy, shading, time);
 }
 
 void Renderer3D::drawGround(const FlightCamera& camera) {
@@ -133,143 +137,94 @@ void Renderer3D::drawGround(const FlightCamera& camera) {
 }
 
 void Renderer3D::drawTerrain(const Terrain& terrain, const FlightCamera& camera) {
-    BeginMode3D(raylibCamera);
-    
-    const auto& vertices = terrain.getVertices();
-    const auto& indices = terrain.getIndices();
-    const auto& terrainConfig = terrain.getConfig();
+    // === LOW-POLY SMOOTH AESTHETIC ===
+    // Flat-shaded faces are uploaded once; lighting and fog run in the terrain shader
+    if (!terrainShader.isLoaded()) terrainShader.load();
+    if (terrainMesh.isStale(terrain)) {
+        terrainMesh.upload(terrain, [this](float normalizedHeight, const Vector3D&) {
+            return getTerrainColor(normalizedHeight);
+        });
+    }
     
-    Vector3D camPos = camera.getPosition();
-    Vector3D sunDir = config.sunDirection.normalized();
-    float viewDistance = 1000.0f;
-    float nearDistance = 100.0f;
+    TerrainShading shading;
+    shading.sunDirection = config.sunDirection;
+    shading.ambient = 0.4f;
+    shading.diffuse = 0.6f;
+    shading.rimStrength = 0.15f;
+    shading.rimPower = 2.0f;
+    shading.maxLight = 10.0f;   // Only the final color is clamped
+    shading.fogStart = 200.0f;
+    shading.fogEnd = 1000.0f;
+    shading.fogAmount = 0.85f;
+    shading.fogHeightRange = 200.0f;
+    // Fog color gradient based on height (atmospheric perspective)
+    shading.fogColorLow = config.skyColorBottom;
+    shading.fogColorHigh = {
+        (unsigned char)(config.skyColorBottom.r - 20),
+        (unsigned char)(config.skyColorBottom.g - 10),
+        (unsigned char)std::min(255, config.skyColorBottom.b + 10),
+        255
+    };
+    shading.viewDistance = 1000.0f;
     
-    // === LOW-POLY SMOOTH AESTHETIC ===
-    // Each triangle gets smooth color based on lighting + height + distance
-    
-    for (size_t i = 0; i < indices.size(); i += 3) {
-        const auto& v0 = vertices[indices[i]];
-        const auto& v1 = vertices[indices[i + 1]];
-        const auto& v2 = vertices[indices[i + 2]];
-        
-        Vector3D center = (v0.position + v1.position + v2.position) * (1.0f / 3.0f);
-        float dist = (center - camPos).length();
-        
-        if (dist > viewDistance) continue;
-        
-        // Calculate face normal for flat shading (low-poly look)
-        Vector3D edge1 = v1.position - v0.position;
-        Vector3D edge2 = v2.position - v0.position;
-        Vector3D faceNormal = edge1.cross(edge2).normalized();
-        
-        // === Lighting calculations ===
-        // Diffuse lighting from sun
-        float diffuse = std::max(0.0f, faceNormal.dot(sunDir));
-        diffuse = 0.4f + diffuse * 0.6f;  // Ambient + diffuse
-        
-        // Soft rim lighting for silhouette enhancement
-        Vector3D toCamera = (camPos - center).normalized();
-        float rim = 1.0f - std::max(0.0f, faceNormal.dot(toCamera));
-        rim = std::pow(rim, 2.0f) * 0.15f;
-        
-        // Height-based color with smooth gradients
-        float avgHeight = (v0.height + v1.height + v2.height) / 3.0f;
-        float normalizedHeight = (avgHeight - terrainConfig.baseHeight) / terrainConfig.maxHeight;
-        normalizedHeight = std::clamp(normalizedHeight, 0.0f, 1.0f);
-        
-        // === Smooth color palette (low-poly aesthetic) ===
-        Color baseColor;
-        
-        if (normalizedHeight > 0.85f) {
-            // Snow caps - soft white with slight blue tint
-            float t = (normalizedHeight - 0.85f) / 0.15f;
-            baseColor = {
-                (unsigned char)(220 + t * 35),
-                (unsigned char)(225 + t * 30),
-                (unsigned char)(235 + t * 20),
-                255
-            };
-        } else if (normalizedHeight > 0.6f) {
-            // Rocky slopes - warm gray transitioning to snow
-            float t = (normalizedHeight - 0.6f) / 0.25f;
-            baseColor = {
-                (unsigned char)(140 + t * 80),
-                (unsigned char)(130 + t * 95),
-                (unsigned char)(120 + t * 115),
-                255
-            };
-        } else if (normalizedHeight > 0.35f) {
-            // Mid elevation - earthy tones
-            float t = (normalizedHeight - 0.35f) / 0.25f;
-            baseColor = {
-                (unsigned char)(160 - t * 20),
-                (unsigned char)(145 - t * 15),
-                (unsigned char)(110 + t * 10),
-                255
-            };
-        } else if (normalizedHeight > 0.15f) {
-            // Lower slopes - warm sand/grass blend
-            float t = (normalizedHeight - 0.15f) / 0.2f;
-            baseColor = {
-                (unsigned char)(180 - t * 20),
-                (unsigned char)(175 - t * 30),
-                (unsigned char)(130 - t * 20),
-                255
-            };
-        } else {
-            // Valley floor - soft green-sand
-            float t = normalizedHeight / 0.15f;
-            baseColor = {
-                (unsigned char)(165 + t * 15),
-                (unsigned char)(180 - t * 5),
-                (unsigned char)(140 - t * 10),
-                255
-            };
-        }
-        
-        // Apply diffuse lighting
-        float lightFactor = diffuse + rim;
-        baseColor.r = (unsigned char)std::clamp((int)(baseColor.r * lightFactor), 0, 255);
-        baseColor.g = (unsigned char)std::clamp((int)(baseColor.g * lightFactor), 0, 255);
-        baseColor.b = (unsigned char)std::clamp((int)(baseColor.b * lightFactor), 0, 255);
-        
-        // === Smooth distance fog ===
-        float fogStart = 200.0f;
-        float fogFactor = std::clamp((dist - fogStart) / (viewDistance - fogStart), 0.0f, 1.0f);
-        fogFactor = fogFactor * fogFactor;  // Quadratic falloff for smoothness
-        
-        // Fog color gradient based on height (atmospheric perspective)
-        float heightFog = std::clamp(center.y / 200.0f, 0.0f, 1.0f);
-        Color fogColor = {
-            (unsigned char)(config.skyColorBottom.r - heightFog * 20),
-            (unsigned char)(config.skyColorBottom.g - heightFog * 10),
-            (unsigned char)(config.skyColorBottom.b + heightFog * 10),
+    BeginMode3D(raylibCamera);
+    terrainShader.apply(camera.getPosition(), shading);
+    terrainMesh.draw(terrainShader);
+    EndMode3D();
+}
+
+Color Renderer3D::getTerrainColor(float normalizedHeight) const {
+    // === Smooth color palette (low-poly aesthetic) ===
+    Color baseColor;
+    
+    if (normalizedHeight > 0.85f) {
+        // Snow caps - soft white with slight blue tint
+        float t = (normalizedHeight - 0.85f) / 0.15f;
+        baseColor = {
+            (unsigned char)(220 + t * 35),
+            (unsigned char)(225 + t * 30),
+            (unsigned char)(235 + t * 20),
             255
         };
-        
-        Color finalColor = {
-            (unsigned char)(baseColor.r + (fogColor.r - baseColor.r) * fogFactor * 0.85f),
-            (unsigned char)(baseColor.g + (fogColor.g - baseColor.g) * fogFactor * 0.85f),
-            (unsigned char)(baseColor.b + (fogColor.b - baseColor.b) * fogFactor * 0.85f),
+    } else if (normalizedHeight > 0.6f) {
+        // Rocky slopes - warm gray transitioning to snow
+        float t = (normalizedHeight - 0.6f) / 0.25f;
+        baseColor = {
+            (unsigned char)(140 + t * 80),
+            (unsigned char)(130 + t * 95),
+            (unsigned char)(120 + t * 115),
+            255
+        };
+    } else if (normalizedHeight > 0.35f) {
+        // Mid elevation - earthy tones
+        float t = (normalizedHeight - 0.35f) / 0.25f;
+        baseColor = {
+            (unsigned char)(160 - t * 20),
+            (unsigned char)(145 - t * 15),
+            (unsigned char)(110 + t * 10),
+            255
+        };
+    } else if (normalizedHeight > 0.15f) {
+        // Lower slopes - warm sand/grass blend
+        float t = (normalizedHeight - 0.15f) / 0.2f;
+        baseColor = {
+            (unsigned char)(180 - t * 20),
+            (unsigned char)(175 - t * 30),
+            (unsigned char)(130 - t * 20),
+            255
+        };
+    } else {
+        // Valley floor - soft green-sand
+        float t = normalizedHeight / 0.15f;
+        baseColor = {
+            (unsigned char)(165 + t * 15),
+            (unsigned char)(180 - t * 5),
+            (unsigned char)(140 - t * 10),
             255
         };
-        
-        // Draw both sides of the triangle
-        DrawTriangle3D(
-            {v0.position.x, v0.position.y, v0.position.z},
-            {v1.position.x, v1.position.y, v1.position.z},
-            {v2.position.x, v2.position.y, v2.position.z},
-            finalColor
-        );
-        DrawTriangle3D(
-            {v0.position.x, v0.position.y, v0.position.z},
-            {v2.position.x, v2.position.y, v2.position.z},
-            {v1.position.x, v1.position.y, v1.position.z},
-            finalColor
-        );
     }
     
-    EndMode3D();
+    return baseColor;
 }
 
 void Renderer3D::drawClouds(const FlightCamera& camera, float time) {
@@ -277,6 +232,9 @@ void Renderer3D::drawClouds(const FlightCamera& camera, float time) {
     
     Vector3D camPos = camera.getPosition();
     
+    if (!glow.isLoaded()) glow.load();
+    glow.begin();
+    
     // === LAYER 1: Distant horizon clouds (soft, painterly) ===
     for (int layer = 0; layer < 4; ++layer) {
         float layerHeight = 180.0f + layer * 60.0f;
@@ -300,14 +258,12 @@ void Renderer3D::drawClouds(const FlightCamera& camera, float time) {
             unsigned char b = (unsigned char)(248 - layer * 8);
             
             float baseSize = 50.0f + (i % 4) * 15.0f - layer * 8.0f;
+            // Puffs reach about 1.5 base sizes out from the body
+            if (!culler.isVisible(Vector3D(x, y, z), baseSize * 1.6f)) continue;
             
-            // Multi-layered cloud puff for volume
-            // Core (brightest)
-            DrawSphere({x, y, z}, baseSize * 0.6f, {r, g, b, (unsigned char)(baseAlpha * 1.2f)});
-            // Mid layer
-            DrawSphere({x, y, z}, baseSize * 0.85f, {r, g, b, (unsigned char)(baseAlpha * 0.7f)});
-            // Outer soft edge
-            DrawSphere({x, y, z}, baseSize * 1.1f, {r, g, b, (unsigned char)(baseAlpha * 0.3f)});
+            // Bright core fading into a soft outer edge for volume
+            glow.add({x, y, z}, baseSize * 0.7f, {r, g, b, (unsigned char)(baseAlpha * 1.7f)},
+                     baseSize * 1.1f, {r, g, b, (unsigned char)(baseAlpha * 1.0f)});
             
             // Organic puffs around main body
             for (int p = 0; p < 4; ++p) {
@@ -318,8 +274,8 @@ void Renderer3D::drawClouds(const FlightCamera& camera, float time) {
                 float py = y + std::sin(pAngle * 2.5f) * baseSize * 0.25f;
                 float pSize = baseSize * (0.4f + (p % 3) * 0.12f);
                 
-                DrawSphere({px, py, pz}, pSize * 0.7f, {r, g, b, (unsigned char)(baseAlpha * 0.8f)});
-                DrawSphere({px, py, pz}, pSize, {r, g, b, (unsigned char)(baseAlpha * 0.4f)});
+                glow.add({px, py, pz}, pSize * 0.7f, {r, g, b, (unsigned char)(baseAlpha * 1.1f)},
+                         pSize, {r, g, b, (unsigned char)(baseAlpha * 0.4f)});
             }
         }
     }
@@ -333,11 +289,10 @@ void Renderer3D::drawClouds(const FlightCamera& camera, float time) {
         float y = 140.0f + (i % 2) * 25.0f + std::sin(time * 0.15f + i) * 8.0f;
         
         float size = 35.0f + (i % 3) * 12.0f;
+        if (!culler.isVisible(Vector3D(x, y, z), size)) continue;
         
         // Brighter, more defined clouds
-        DrawSphere({x, y, z}, size * 0.5f, {255, 253, 250, 50});
-        DrawSphere({x, y, z}, size * 0.75f, {255, 252, 248, 30});
-        DrawSphere({x, y, z}, size, {255, 250, 245, 15});
+        glow.add({x, y, z}, size * 0.6f, {255, 253, 250, 70}, size, {255, 250, 245, 40});
     }
     
     // === LAYER 3: High-altitude wisps (cirrus-like) ===
@@ -350,64 +305,26 @@ void Renderer3D::drawClouds(const FlightCamera& camera, float time) {
         
         // Very soft, stretched wisps
         float wispSize = 70.0f + (i % 2) * 30.0f;
+        if (!culler.isVisible(Vector3D(x, y, z), wispSize)) continue;
         
         // Slight blue tint for high altitude
-        DrawSphere({x, y, z}, wispSize * 0.4f, {250, 252, 255, 18});
-        DrawSphere({x, y, z}, wispSize * 0.7f, {248, 250, 255, 10});
-        DrawSphere({x, y, z}, wispSize, {245, 248, 255, 5});
+        glow.add({x, y, z}, wispSize * 0.45f, {250, 252, 255, 25}, wispSize, {245, 248, 255, 14});
     }
     
+    // Translucent layers blend; keep them out of the depth buffer
+    rlDisableDepthMask();
+    glow.flush();
+    rlEnableDepthMask();
+    
     EndMode3D();
 }
 
-void Renderer3D::drawCapeMesh(const Cape3D& cape) {
+void Renderer3D::drawCapeGlow(const Cape3D& cape, float time) {
     int segments = cape.getSegments();
     int width = cape.getWidth();
     
-    static float time = 0;
-    time += GetFrameTime();
-    
     // === ORGANIC FLOWING ENERGY CAPE ===
-    // No visible attachment - energy streams that emanate naturally
-    
-    // === LAYER 1: Soft volumetric energy field (base glow) ===
-    for (int row = 0; row < segments; ++row) {
-        float rowRatio = static_cast<float>(row) / (segments - 1);
-        // Fade in from nothing at the top (organic emergence)
-        float emergeFade = std::min(rowRatio * 4.0f, 1.0f);  // First 25% fades in
-        float tipFade = 1.0f - std::pow(rowRatio, 1.5f) * 0.6f;
-        
-        for (int col = 0; col < width; ++col) {
-            float colRatio = static_cast<float>(col) / (width - 1);
-            float colCenter = 1.0f - std::abs(colRatio - 0.5f) * 1.6f;  // Stronger in center
-            
-            const Vector3D& p = cape.getParticle(row, col).position;
-            
-            // Organic wave modulation
-            float wave1 = std::sin(time * 1.2f + rowRatio * 5.0f + colRatio * 3.0f) * 0.3f + 0.7f;
-            float wave2 = std::sin(time * 0.7f + col * 0.8f) * 0.2f + 0.8f;
-            float organicPulse = wave1 * wave2;
-            
-            float intensity = emergeFade * tipFade * colCenter * organicPulse;
-            
-            if (intensity > 0.05f) {
-                // Color shifts organically - warm core to cool edges
-                float hueFlow = std::sin(time * 0.5f + rowRatio * 2.0f + colRatio) * 0.5f + 0.5f;
-                unsigned char r = (unsigned char)(255 - rowRatio * 20);
-                unsigned char g = (unsigned char)(230 - rowRatio * 50 + hueFlow * 20);
-                unsigned char b = (unsigned char)(200 + rowRatio * 40 + hueFlow * 30);
-                
-                // Soft, diffuse particles (no harsh edges)
-                float baseSize = (2.0f - rowRatio * 0.8f) * intensity;
-                unsigned char alpha = (unsigned char)(90 * intensity);
-                
-                // Multiple overlapping soft spheres for smooth appearance
-                DrawSphere({p.x, p.y, p.z}, baseSize * 1.5f, {r, g, b, (unsigned char)(alpha * 0.3f)});
-                DrawSphere({p.x, p.y, p.z}, baseSize * 1.0f, {r, g, b, (unsigned char)(alpha * 0.5f)});
-                DrawSphere({p.x, p.y, p.z}, baseSize * 0.6f, {r, g, b, alpha});
-            }
-        }
-    }
+    // The surface itself comes from capeMesh; these layers add energy on top
     
     // === LAYER 2: Flowing energy ribbons (smooth interpolated strands) ===
     for (int col = 0; col < width; ++col) {
@@ -420,8 +337,8 @@ void Renderer3D::drawCapeMesh(const Cape3D& cape) {
             float emergeFade = std::min(rowRatio * 5.0f, 1.0f);
             float tipFade = 1.0f - std::pow(rowRatio, 1.2f) * 0.7f;
             
-            const Vector3D& p1 = cape.getParticle(row, col).position;
-            const Vector3D& p2 = cape.getParticle(row + 1, col).position;
+            Vector3D p1 = cape.getParticlePosition(row, col);
+            Vector3D p2 = cape.getParticlePosition(row + 1, col);
             
             // Smooth interpolation along strand
             for (float t = 0.0f; t < 1.0f; t += 0.25f) {
@@ -440,7 +357,7 @@ void Renderer3D::drawCapeMesh(const Cape3D& cape) {
                     unsigned char alpha = (unsigned char)(140 * intensity * energyWave);
                     
                     // Warm golden energy
-                    DrawSphere({interp.x, interp.y, interp.z}, size, {255, 245, 220, alpha});
+                    glow.add(interp, size, {255, 245, 220, alpha});
                 }
             }
         }
@@ -453,8 +370,8 @@ void Renderer3D::drawCapeMesh(const Cape3D& cape) {
         
         for (int col = 0; col < width; ++col) {
             float colRatio = static_cast<float>(col) / (width - 1);
-            const Vector3D& p = cape.getParticle(row, col).position;
-            const Vector3D& pPrev = cape.getParticle(row - 1, col).position;
+            Vector3D p = cape.getParticlePosition(row, col);
+            Vector3D pPrev = cape.getParticlePosition(row - 1, col);
             
             // Velocity for wisp direction
             Vector3D vel = p - pPrev;
@@ -475,7 +392,7 @@ void Renderer3D::drawCapeMesh(const Cape3D& cape) {
                 unsigned char alpha = (unsigned char)(60 * wispIntensity * (1.0f - dissipation * 0.5f));
                 float size = 0.8f + dissipation * 0.5f;
                 
-                DrawSphere({wispPos.x, wispPos.y, wispPos.z}, size, {255, 240, 210, alpha});
+                glow.add(wispPos, size, {255, 240, 210, alpha});
             }
         }
     }
@@ -486,7 +403,7 @@ void Renderer3D::drawCapeMesh(const Cape3D& cape) {
         
         for (int row = segments * 2 / 3; row < segments; ++row) {
             float rowRatio = static_cast<float>(row) / (segments - 1);
-            const Vector3D& p = cape.getParticle(row, col).position;
+            Vector3D p = cape.getParticlePosition(row, col);
             
             // Sparkle timing
             float sparklePhase = time * 6.0f + row * 2.7f + col * 1.9f;
@@ -504,16 +421,50 @@ void Renderer3D::drawCapeMesh(const Cape3D& cape) {
                 unsigned char alpha = (unsigned char)(200 * intensity);
                 float size = 0.4f + intensity * 0.8f;
                 
-                DrawSphere({p.x + ox, p.y + oy, p.z + oz}, size, {255, 255, 250, alpha});
-                DrawSphere({p.x + ox, p.y + oy, p.z + oz}, size * 2.5f, {255, 230, 180, (unsigned char)(alpha / 4)});
+                glow.add(p + Vector3D(ox, oy, oz), size, {255, 255, 250, alpha},
+                         size * 2.5f, {255, 230, 180, (unsigned char)(alpha / 4)});
             }
         }
     }
 }
 
 void Renderer3D::drawCape(const Cape3D& cape) {
+    drawCapes({&cape});
+}
+
+void Renderer3D::drawCapes(const std::vector<const Cape3D*>& capes) {
+    static float time = 0;
+    time += GetFrameTime();
+    
+    if (!capeMesh.isLoaded()) capeMesh.load();
+    if (!glow.isLoaded()) glow.load();
+    
+    CapeMeshStyle style;
+    style.innerColor = config.capeColorInner;
+    style.outerColor = config.capeColorOuter;
+    style.sunDirection = config.sunDirection;
+    Vector3D camPos(raylibCamera.position.x, raylibCamera.position.y, raylibCamera.position.z);
+    
     BeginMode3D(raylibCamera);
-    drawCapeMesh(cape);
+    
+    // Surfaces sharing a grid size go out in one draw
+    capeMesh.begin();
+    for (const Cape3D* cape : capes) {
+        if (capeMesh.add(*cape)) continue;
+        capeMesh.draw(camPos, style, time);
+        capeMesh.begin();
+        capeMesh.add(*cape);
+    }
+    capeMesh.draw(camPos, style, time);
+    
+    glow.begin();
+    for (const Cape3D* cape : capes) {
+        drawCapeGlow(*cape, time);
+    }
+    rlDisableDepthMask();
+    glow.flush();
+    rlEnableDepthMask();
+    
     EndMode3D();
 }
 
@@ -648,12 +599,15 @@ void Renderer3D::drawCharacter(const Character3D& character) {
 }
 
 void Renderer3D::drawTrail(const Character3D& character) {
+    drawTrail(character.getTrail());
+}
+
+void Renderer3D::drawTrail(const TrailBuffer::View& trail) {
     BeginMode3D(raylibCamera);
     
     static float time = 0;
     time += GetFrameTime();
     
-    const auto& trail = character.getTrail();
     size_t trailSize = trail.size();
     
     if (trailSize < 2) {
@@ -807,7 +761,28 @@ void Renderer3D::updateParticles(float dt, const WindField3D& wind, const Flight
     }
 }
 
+bool Renderer3D::drawGpuAtmosphere(const WindField3D& wind, float dt, const FlightCamera& camera) {
+    if (!gpuAtmosphere || gpuAtmosphere->getParticleCount() != config.gpuParticleCount) {
+        GpuAtmosphereConfig gpuConfig;
+        gpuConfig.particleCount = config.gpuParticleCount;
+        gpuAtmosphere = std::make_unique<GpuAtmosphere>(gpuConfig);
+    }
+    if (!gpuAtmosphere->isLoaded() && !gpuAtmosphere->load(camera.getPosition())) {
+        config.gpuAtmosphere = false;   // Don't retry every frame
+        gpuAtmosphere.reset();
+        return false;
+    }
+    
+    gpuAtmosphere->update(dt, camera.getPosition(), wind);
+    BeginMode3D(raylibCamera);
+    gpuAtmosphere->draw(camera.getPosition());
+    EndMode3D();
+    return true;
+}
+
 void Renderer3D::drawAtmosphere(const WindField3D& wind, float dt, const FlightCamera& camera) {
+    if (config.gpuAtmosphere && drawGpuAtmosphere(wind, dt, camera)) return;
+    
     updateParticles(dt, wind, camera);
     
     static float time = 0;
@@ -817,6 +792,9 @@ void Renderer3D::drawAtmosphere(const WindField3D& wind, float dt, const FlightC
     
     Vector3D camPos = camera.getPosition();
     
+    if (!glow.isLoaded()) glow.load();
+    glow.begin();
+    
     for (size_t idx = 0; idx < particles.size(); ++idx) {
         const auto& p = particles[idx];
         
@@ -825,6 +803,8 @@ void Renderer3D::drawAtmosphere(const WindField3D& wind, float dt, const FlightC
         float distFade = 1.0f - std::pow(std::min(dist / 450.0f, 1.0f), 1.5f);
         
         if (distFade < 0.05f) continue;
+        // Largest halo of any particle type
+        if (!culler.isVisible(p.position, p.size * 3.0f)) continue;
         
         // Particle type determines behavior and appearance
         float typePhase = time * 2.0f + idx * 0.7f;
@@ -835,13 +815,9 @@ void Renderer3D::drawAtmosphere(const WindField3D& wind, float dt, const FlightC
             unsigned char alpha = (unsigned char)(p.alpha * distFade * 160 * pulse);
             
             if (alpha > 8) {
-                // Warm golden dust
-                Color dustColor = {255, 248, 235, alpha};
-                DrawSphere({p.position.x, p.position.y, p.position.z}, p.size * 0.8f, dustColor);
-                
-                // Soft glow halo
-                DrawSphere({p.position.x, p.position.y, p.position.z}, p.size * 1.8f, 
-                          {255, 240, 210, (unsigned char)(alpha / 4)});
+                // Warm golden dust in a soft glow halo
+                glow.add(p.position, p.size * 0.8f, {255, 248, 235, alpha},
+                         p.size * 1.8f, {255, 240, 210, (unsigned char)(alpha / 4)});
             }
         } 
         else if (p.type == 1) {
@@ -854,13 +830,10 @@ void Renderer3D::drawAtmosphere(const WindField3D& wind, float dt, const FlightC
                 unsigned char alpha = (unsigned char)(p.alpha * distFade * 220 * intensity);
                 
                 if (alpha > 15) {
-                    // Bright white-gold sparkle
+                    // Bright white-gold sparkle with a warm glow
                     float sparkleSize = p.size * 0.5f * (0.5f + intensity * 0.5f);
-                    DrawSphere({p.position.x, p.position.y, p.position.z}, sparkleSize, 
-                              {255, 255, 250, alpha});
-                    // Warm glow
-                    DrawSphere({p.position.x, p.position.y, p.position.z}, sparkleSize * 3.0f, 
-                              {255, 230, 180, (unsigned char)(alpha / 3)});
+                    glow.add(p.position, sparkleSize, {255, 255, 250, alpha},
+                             sparkleSize * 3.0f, {255, 230, 180, (unsigned char)(alpha / 3)});
                 }
             }
         }
@@ -875,23 +848,65 @@ void Renderer3D::drawAtmosphere(const WindField3D& wind, float dt, const FlightC
                 unsigned char g = (unsigned char)(245 + drift * 10);
                 unsigned char b = 255;
                 
-                DrawSphere({p.position.x, p.position.y, p.position.z}, p.size * 1.2f, 
-                          {r, g, b, alpha});
                 // Very soft outer glow
-                DrawSphere({p.position.x, p.position.y, p.position.z}, p.size * 2.5f, 
-                          {r, g, b, (unsigned char)(alpha / 5)});
+                glow.add(p.position, p.size * 1.2f, {r, g, b, alpha},
+                         p.size * 2.5f, {r, g, b, (unsigned char)(alpha / 5)});
             }
         }
     }
     
+    rlDisableDepthMask();
+    glow.flush();
+    rlEnableDepthMask();
+    
+    EndMode3D();
+}
+
+void Renderer3D::drawCrowd(const FlyerCrowdSnapshot3D& crowd, float alpha) {
+    if (crowd.size() == 0) return;
+    if (!glow.isLoaded()) glow.load();
+
+    BeginMode3D(raylibCamera);
+    glow.begin();
+
+    float radius = crowd.radius;
+    for (size_t i = 0; i < crowd.size(); ++i) {
+        Vector3D p = crowd.positionAt(i, alpha);
+        if (!culler.isVisible(p, radius * 4.0f)) continue;
+
+        // Tired flyers dim toward a cooler glow
+        float vigor = 0.45f + 0.55f * std::min(crowd.energy[i] / 100.0f, 1.0f);
+        unsigned char coreAlpha = (unsigned char)(200 * vigor);
+        glow.add(p, radius * 0.6f, {255, 245, 225, coreAlpha},
+                 radius * 2.2f, {255, (unsigned char)(200 + 30 * vigor), 170, (unsigned char)(coreAlpha / 4)});
+
+        const Vector3D& v = crowd.velocity[i];
+        float speed = v.length();
+        if (speed < 10.0f) continue;
+        Vector3D back = v * (-radius * 0.6f / speed);
+        for (int k = 1; k <= 3; ++k) {
+            float fade = 1.0f - k * 0.25f;
+            glow.add(p + back * static_cast<float>(k), radius * 0.7f * fade,
+                     {255, 225, 190, (unsigned char)(coreAlpha * 0.35f * fade)});
+        }
+    }
+
+    rlDisableDepthMask();
+    glow.flush();
+    rlEnableDepthMask();
+
     EndMode3D();
 }
 
 void Renderer3D::drawUI(const FlightController3D& flight, const PerformanceMonitor& perf, const FlightCamera& camera) {
+    drawUI(flight.getSnapshot(), perf, camera);
+}
+
+void Renderer3D::drawUI(const FlightSnapshot3D& flight, const PerformanceMonitor& perf, const FlightCamera& camera) {
     // Sky: Children of the Light style minimal HUD
     
     // Energy indicator - small arc in bottom left (like Sky's wing energy)
-    float energy = flight.getEnergy();
+    float energy = flight.energy;
     int centerX = 60;
     int centerY = config.screenHeight - 60;
     float radius = 35.0f;
@@ -925,7 +940,7 @@ void Renderer3D::drawUI(const FlightController3D& flight, const PerformanceMonit
     DrawCircle(centerX, centerY, 8, {255, 250, 240, 255});
     
     // Minimal altitude indicator - top right, very subtle
-    float altitude = flight.getAltitude();
+    float altitude = flight.altitude;
     Color altColor = {255, 255, 255, 120};
     DrawText(TextFormat("%.0f", altitude), config.screenWidth - 70, 25, 20, altColor);
     
@@ -935,9 +950,69 @@ void Renderer3D::drawUI(const FlightController3D& flight, const PerformanceMonit
     DrawTriangle({(float)wx, (float)wy}, {(float)wx-12, (float)wy+8}, {(float)wx-6, (float)wy}, {255, 255, 255, 100});
     DrawTriangle({(float)wx, (float)wy}, {(float)wx+12, (float)wy+8}, {(float)wx+6, (float)wy}, {255, 255, 255, 100});
     
+    if (config.showFrameGraph) {
+        drawFrameGraph(perf);
+    }
+    
     // Debug info only when TAB held (handled in main)
 }
 
+void Renderer3D::drawFrameGraph(const PerformanceMonitor& perf) {
+    const int graphWidth = 300;
+    const int graphHeight = 60;
+    const float graphScaleMs = 50.0f;  // Full height
+    int left = config.screenWidth - graphWidth - 20;
+    int top = 60;
+    
+    DrawRectangle(left, top, graphWidth, graphHeight, {0, 0, 0, 100});
+    
+    // Reference lines at 60 and 30 FPS
+    for (float ms : {16.7f, 33.3f}) {
+        int y = top + graphHeight - static_cast<int>(ms / graphScaleMs * graphHeight);
+        DrawLine(left, y, left + graphWidth, y, {255, 255, 255, 50});
+    }
+    
+    // Newest frame at the right edge, one pixel per frame
+    size_t count = perf.getHistoryCount();
+    size_t shown = std::min<size_t>(count, graphWidth);
+    for (size_t i = 0; i < shown; ++i) {
+        float ms = perf.getHistoryFrameMs(count - shown + i);
+        int barHeight = std::min(graphHeight, static_cast<int>(ms / graphScaleMs * graphHeight));
+        Color barColor = perf.isHitch(ms) ? Color{255, 90, 80, 230}
+                       : ms > 16.7f ? Color{255, 210, 120, 180} : Color{255, 255, 255, 120};
+        int x = left + graphWidth - static_cast<int>(shown) + static_cast<int>(i);
+        DrawLine(x, top + graphHeight, x, top + graphHeight - barHeight, barColor);
+    }
+    
+    DrawText(TextFormat("p50 %.1f  p95 %.1f  p99 %.1f  max %.1f ms",
+                        perf.getPercentileMs(0.5f), perf.getPercentileMs(0.95f),
+                        perf.getPercentileMs(0.99f), perf.getMaxFrameTimeMs()),
+             left, top + graphHeight + 4, 10, {255, 255, 255, 180});
+    if (MemoryTracker::isEnabled()) {
+        DrawText(TextFormat("hitches %llu  heap %.1f MB  allocs/frame %llu",
+                            static_cast<unsigned long long>(perf.getHitchCount()),
+                            perf.getEstimatedMemoryUsage() / (1024.0f * 1024.0f),
+                            static_cast<unsigned long long>(perf.getFrameAllocations())),
+                 left, top + graphHeight + 16, 10, {255, 255, 255, 140});
+    } else {
+        DrawText(TextFormat("hitches %llu", static_cast<unsigned long long>(perf.getHitchCount())),
+                 left, top + graphHeight + 16, 10, {255, 255, 255, 140});
+    }
+    
+    // Slowest scopes of the latest hitch
+    if (!perf.getHitches().empty()) {
+        const FrameHitch& hitch = perf.getHitches().back();
+        int lineY = top + graphHeight + 30;
+        DrawText(TextFormat("last hitch %.1f ms", hitch.frameMs), left, lineY, 10, {255, 140, 120, 200});
+        for (const auto& scope : hitch.scopes) {
+            if (scope.depth > 1) continue;
+            lineY += 12;
+            DrawText(TextFormat("%*s%s %.2f", scope.depth * 2, "", scope.name.c_str(), scope.ms),
+                     left, lineY, 10, {255, 255, 255, 140});
+        }
+    }
+}
+
 bool Renderer3D::shouldClose() const {
     return WindowShouldClose();
 }
@@ -8,8 +8,16 @@
 #include "entities/Camera3D.hpp"
 using FlightCamera = ethereal::FlightCamera;
 #include "entities/FlightController3D.hpp"
+#include "entities/FlyerCrowd3D.hpp"
 #include "environment/Terrain.hpp"
+#include "rendering/CapeMesh.hpp"
+#include "rendering/GlowBatch.hpp"
+#include "rendering/GpuAtmosphere.hpp"
+#include "rendering/SkyShader.hpp"
+#include "rendering/TerrainMesh.hpp"
+#include "rendering/ViewCuller.hpp"
 #include "utils/PerformanceMonitor.hpp"
+#include <memory>
 #include <vector>
 
 namespace ethereal {
@@ -28,9 +36,16 @@ struct RenderConfig3D {
     Color groundColor = {60, 80, 60, 255};
     bool showWindDebug = false;
     bool showWireframe = false;
+    bool showFrameGraph = false;
     int particleCount = 300;
+    // Simulate atmosphere particles on the GPU against the baked wind grid;
+    // falls back to the CPU path when float render targets are unavailable
+    bool gpuAtmosphere = false;
+    int gpuParticleCount = 32768;
     float fogDensity = 0.001f;
     Vector3D sunDirection = Vector3D(0.5f, 0.8f, 0.3f);
+    // Widest vertical fov any pass draws with; the frame's culler is built from it
+    float cullFov = 65.0f;
 };
 
 struct AtmosphereParticle {
@@ -51,6 +66,7 @@ public:
     void initialize();
     void shutdown();
     
+    // Also rebuilds the frame's view culler, shared with the other renderers
     void beginFrame(const FlightCamera& camera);
     void endFrame();
     
@@ -59,17 +75,26 @@ public:
     void drawTerrain(const Terrain& terrain, const FlightCamera& camera);
     void drawClouds(const FlightCamera& camera, float time);
     void drawCape(const Cape3D& cape);
+    // Capes with the same grid size share one surface draw call
+    void drawCapes(const std::vector<const Cape3D*>& capes);
     void drawCharacter(const Character3D& character);
     void drawTrail(const Character3D& character);
+    void drawTrail(const TrailBuffer::View& trail);
     void drawWindField(const WindField3D& wind, const Vector3D& center);
     void drawAtmosphere(const WindField3D& wind, float dt, const FlightCamera& camera);
+    // One glow sprite per flyer plus a short tail along its velocity, in a single batch
+    void drawCrowd(const FlyerCrowdSnapshot3D& crowd, float alpha);
     void drawUI(const FlightController3D& flight, const PerformanceMonitor& perf, const FlightCamera& camera);
+    void drawUI(const FlightSnapshot3D& flight, const PerformanceMonitor& perf, const FlightCamera& camera);
     
     bool shouldClose() const;
     float getAspectRatio() const;
     
     const RenderConfig3D& getConfig() const { return config; }
     void setConfig(const RenderConfig3D& cfg) { config = cfg; }
+    // Trims or tops up the CPU atmosphere particles without respawning the rest
+    void setParticleCount(int count);
+    ViewCuller& getViewCuller() { return culler; }
 
 private:
     RenderConfig3D config;
@@ -77,11 +102,22 @@ private:
     
     ::Camera3D raylibCamera;
     std::vector<AtmosphereParticle> particles;
+    TerrainShader terrainShader;
+    TerrainMesh terrainMesh;
+    GlowBatch glow;
+    SkyShader sky;
+    ViewCuller culler;
+    CapeMesh capeMesh;
+    std::unique_ptr<GpuAtmosphere> gpuAtmosphere;
     
     void initParticles();
+    AtmosphereParticle spawnParticle() const;
     void updateParticles(float dt, const WindField3D& wind, const FlightCamera& camera);
+    bool drawGpuAtmosphere(const WindField3D& wind, float dt, const FlightCamera& camera);
     Color applyFog(Color color, float distance) const;
-    void drawCapeMesh(const Cape3D& cape);
+    Color getTerrainColor(float normalizedHeight) const;
+    void drawCapeGlow(const Cape3D& cape, float time);
+    void drawFrameGraph(const PerformanceMonitor& perf);
 };
 
 } // namespace ethereal
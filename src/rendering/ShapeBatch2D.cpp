@@ -0,0 +1,87 @@
+#include "ShapeBatch2D.hpp"
+#include "rlgl.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ethereal {
+
+namespace {
+
+// Vertices issued between batch-limit checks; a multiple of 3 well under the
+// default rlgl buffer
+const size_t kChunkVertices = 3 * 1024;
+
+} // namespace
+
+ShapeBatch2D::ShapeBatch2D(size_t reserveTriangles) {
+    vertices.reserve(reserveTriangles * 3);
+}
+
+void ShapeBatch2D::begin() {
+    vertices.clear();
+    frameTriangles = 0;
+}
+
+void ShapeBatch2D::addTriangle(const Vector2D& a, const Vector2D& b, const Vector2D& c, Color color) {
+    vertices.push_back({ a.x, a.y, color });
+    vertices.push_back({ b.x, b.y, color });
+    vertices.push_back({ c.x, c.y, color });
+}
+
+void ShapeBatch2D::addQuad(const Vector2D& a, const Vector2D& b, const Vector2D& c, const Vector2D& d, Color color) {
+    addTriangle(a, c, b, color);
+    addTriangle(b, c, d, color);
+}
+
+void ShapeBatch2D::addLine(const Vector2D& from, const Vector2D& to, float thickness, Color color) {
+    Vector2D delta = to - from;
+    float length = delta.length();
+    if (length <= 0.0f) return;
+
+    Vector2D side = Vector2D(-delta.y, delta.x) * (thickness * 0.5f / length);
+    addQuad(from + side, from - side, to + side, to - side, color);
+}
+
+void ShapeBatch2D::addCircle(const Vector2D& center, float radius, Color color) {
+    if (radius <= 0.0f) return;
+    // Same segment budget as DrawCircle for large circles, far fewer for motes
+    int segments = std::clamp(static_cast<int>(radius * 1.5f), 8, 36);
+    float step = 6.2831853f / segments;
+    Vector2D previous(center.x + radius, center.y);
+    for (int i = 1; i <= segments; ++i) {
+        float angle = i * step;
+        Vector2D next(center.x + std::cos(angle) * radius, center.y + std::sin(angle) * radius);
+        addTriangle(center, previous, next, color);
+        previous = next;
+    }
+}
+
+void ShapeBatch2D::flush() {
+    if (vertices.empty()) return;
+
+    // Queued immediate-mode geometry draws first, under its own culling state.
+    // Lines and circles are emitted without a fixed winding, so culling is off
+    // for the batch (flipped cape quads now fill in instead of leaving holes).
+    rlDrawRenderBatchActive();
+    rlDisableBackfaceCulling();
+
+    for (size_t start = 0; start < vertices.size(); start += kChunkVertices) {
+        size_t end = std::min(start + kChunkVertices, vertices.size());
+        rlCheckRenderBatchLimit(static_cast<int>(end - start));
+        rlBegin(RL_TRIANGLES);
+        for (size_t i = start; i < end; ++i) {
+            const Vertex& v = vertices[i];
+            rlColor4ub(v.color.r, v.color.g, v.color.b, v.color.a);
+            rlVertex2f(v.x, v.y);
+        }
+        rlEnd();
+    }
+
+    rlDrawRenderBatchActive();
+    rlEnableBackfaceCulling();
+
+    frameTriangles += vertices.size() / 3;
+    vertices.clear();
+}
+
+} // namespace ethereal
@@ -0,0 +1,38 @@
+#pragma once
+#include "raylib.h"
+#include "core/Vector2D.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace ethereal {
+
+// Flat-colored screen-space triangles gathered across a frame and submitted in
+// one rlgl triangle stream per flush, instead of one DrawLineEx / DrawTriangle /
+// DrawCircle call (and its setup) per primitive. Shapes keep the order they were
+// added in, so layers stay correct as long as nothing else draws in between.
+class ShapeBatch2D {
+public:
+    explicit ShapeBatch2D(size_t reserveTriangles = 8192);
+
+    void begin();
+    void addTriangle(const Vector2D& a, const Vector2D& b, const Vector2D& c, Color color);
+    // Cape-style quad: top edge a-b, bottom edge c-d
+    void addQuad(const Vector2D& a, const Vector2D& b, const Vector2D& c, const Vector2D& d, Color color);
+    void addLine(const Vector2D& from, const Vector2D& to, float thickness, Color color);
+    void addCircle(const Vector2D& center, float radius, Color color);
+    // Call inside BeginDrawing(); empties the batch
+    void flush();
+
+    size_t getTriangleCount() const { return vertices.size() / 3; }
+    size_t getFrameTriangles() const { return frameTriangles; }
+
+private:
+    struct Vertex {
+        float x, y;
+        Color color;
+    };
+    std::vector<Vertex> vertices;
+    size_t frameTriangles = 0;
+};
+
+} // namespace ethereal
@@ -0,0 +1,224 @@
+#include "SkyShader.hpp"
+#include "rlgl.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ethereal {
+
+namespace {
+
+// Positions are already in clip space; the triangle overhangs the screen so one
+// primitive covers it without a diagonal seam
+const char* kSkyVertexShader = R"(#version 330
+in vec3 vertexPosition;
+
+out vec2 fragNdc;
+
+void main() {
+    fragNdc = vertexPosition.xy;
+    gl_Position = vec4(vertexPosition.xy, 1.0, 1.0);
+}
+)";
+
+const char* kSkyFragmentShader = R"(#version 330
+in vec2 fragNdc;
+
+uniform vec3 cameraRight;
+uniform vec3 cameraUp;
+uniform vec3 cameraForward;
+uniform vec2 projection;        // tan(fov / 2) * aspect, tan(fov / 2)
+uniform vec3 zenithColor;
+uniform vec3 horizonColor;
+uniform vec4 sunDir;            // xyz, w = enabled
+uniform vec3 sunColor;
+uniform vec2 sunSize;           // disc, glow: angular radii
+uniform vec4 moonDir;           // xyz, w = enabled
+uniform vec3 moonColor;
+uniform vec2 moonSize;
+uniform vec3 stars;             // per-cell probability, brightness, cells per radian
+uniform float time;
+uniform int scattering;
+
+out vec4 finalColor;
+
+float hash(vec3 p) {
+    p = fract(p * vec3(443.897, 441.423, 437.195));
+    p += dot(p, p.yzx + 19.19);
+    return fract((p.x + p.y) * p.z);
+}
+
+// Disc with a soft edge plus a glow falling off over glowRadius
+vec3 celestial(vec3 dir, vec3 body, vec3 color, vec2 size, float glowAmount) {
+    float angle = acos(clamp(dot(dir, body), -1.0, 1.0));
+    float disc = 1.0 - smoothstep(size.x * 0.85, size.x, angle);
+    float glow = exp(-angle / max(size.y, 1e-4) * 2.5) * glowAmount;
+    return color * (disc + glow);
+}
+
+vec3 starField(vec3 dir) {
+    if (stars.x <= 0.0 || dir.y < -0.1) return vec3(0.0);
+    vec3 p = dir * stars.z;
+    vec3 cell = floor(p);
+    float h = hash(cell);
+    if (h > stars.x) return vec3(0.0);
+
+    // One star per lit cell, jittered inside it
+    vec3 center = cell + 0.5 + (vec3(hash(cell + 17.0), hash(cell + 31.0), hash(cell + 47.0)) - 0.5) * 0.4;
+    center = normalize(center) * stars.z;
+    float d = length(p - center);
+    float brightness = 0.3 + 0.7 * hash(cell + 5.0);
+    float seed = hash(cell + 3.0);
+    float twinkle = sin(time * (2.0 + seed * 4.0) + seed * 60.0) * 0.3 + 0.7;
+    float size = 0.05 + brightness * 0.07;
+    float core = 1.0 - smoothstep(size * 0.5, size, d);
+    float halo = (1.0 - smoothstep(size, size * 2.5, d)) * 0.2;
+    return (vec3(core) + vec3(0.78, 0.86, 1.0) * halo) * brightness * twinkle * stars.y;
+}
+
+void main() {
+    vec3 dir = normalize(cameraForward + cameraRight * fragNdc.x * projection.x + cameraUp * fragNdc.y * projection.y);
+
+    float t = smoothstep(0.0, 0.8, max(dir.y, 0.0));
+    vec3 color = mix(horizonColor, zenithColor, t);
+
+    if (scattering != 0 && sunDir.w > 0.0) {
+        float mu = dot(dir, sunDir.xyz);
+        float rayleigh = 0.75 * (1.0 + mu * mu);
+        const float g = 0.76;
+        float mie = (1.0 - g * g) / pow(1.0 + g * g - 2.0 * g * mu, 1.5) * 0.08;
+        // More air toward the horizon, less light once the sun sets
+        float depth = 1.0 / (max(dir.y, 0.0) + 0.15);
+        float daylight = clamp(sunDir.y + 0.1, 0.0, 1.0);
+        vec3 extinction = exp(-vec3(0.116, 0.27, 0.662) * depth);
+        vec3 inscatter = vec3(0.18, 0.42, 1.0) * rayleigh * (1.0 - extinction) * 0.5 + vec3(mie * depth * 0.02);
+        color = color * mix(vec3(1.0), extinction, daylight) + sunColor * inscatter * daylight;
+    }
+
+    // Stars fade out as the sky behind them brightens
+    float skyLight = clamp((color.r + color.g + color.b) * 0.5, 0.0, 1.0);
+    color += starField(dir) * (1.0 - skyLight);
+
+    if (moonDir.w > 0.0) color += celestial(dir, moonDir.xyz, moonColor, moonSize, 0.35);
+    if (sunDir.w > 0.0) color += celestial(dir, sunDir.xyz, sunColor, sunSize, 0.5);
+
+    finalColor = vec4(min(color, vec3(1.0)), 1.0);
+}
+)";
+
+// Distance the sphere-stack sky was drawn at; sizes in SkyShading are relative to it
+const float kCelestialDistance = 700.0f;
+
+void toVec3(Color c, float out[3]) {
+    out[0] = c.r / 255.0f;
+    out[1] = c.g / 255.0f;
+    out[2] = c.b / 255.0f;
+}
+
+} // namespace
+
+SkyShader::~SkyShader() {
+    unload();
+}
+
+bool SkyShader::load() {
+    unload();
+
+    shader = LoadShaderFromMemory(kSkyVertexShader, kSkyFragmentShader);
+    if (shader.id == 0) return false;
+
+    locRight = GetShaderLocation(shader, "cameraRight");
+    locUp = GetShaderLocation(shader, "cameraUp");
+    locForward = GetShaderLocation(shader, "cameraForward");
+    locProjection = GetShaderLocation(shader, "projection");
+    locZenith = GetShaderLocation(shader, "zenithColor");
+    locHorizon = GetShaderLocation(shader, "horizonColor");
+    locSunDir = GetShaderLocation(shader, "sunDir");
+    locSunColor = GetShaderLocation(shader, "sunColor");
+    locSunSize = GetShaderLocation(shader, "sunSize");
+    locMoonDir = GetShaderLocation(shader, "moonDir");
+    locMoonColor = GetShaderLocation(shader, "moonColor");
+    locMoonSize = GetShaderLocation(shader, "moonSize");
+    locStars = GetShaderLocation(shader, "stars");
+    locTime = GetShaderLocation(shader, "time");
+    locScattering = GetShaderLocation(shader, "scattering");
+    loaded = true;
+    return true;
+}
+
+void SkyShader::unload() {
+    if (!loaded) return;
+    UnloadShader(shader);
+    shader = { 0 };
+    loaded = false;
+}
+
+void SkyShader::draw(const Vector3D& cameraPosition, const Vector3D& cameraTarget, float fovY,
+                     const SkyShading& shading, float time) {
+    if (!loaded) return;
+
+    // Same basis raylib builds for the 3D passes (world up = +y)
+    Vector3D forward = (cameraTarget - cameraPosition).normalized();
+    Vector3D right = forward.cross(Vector3D(0, 1, 0)).normalized();
+    if (right.lengthSquared() < 0.01f) right = Vector3D(1, 0, 0);
+    Vector3D up = right.cross(forward);
+
+    float tanHalf = std::tan(fovY * 0.5f * 3.14159265f / 180.0f);
+    float aspect = static_cast<float>(GetScreenWidth()) / std::max(GetScreenHeight(), 1);
+    float projection[2] = { tanHalf * aspect, tanHalf };
+
+    Vector3D sun = shading.sunDirection.normalized();
+    Vector3D moon = shading.moonDirection.normalized();
+    float sunDir[4] = { sun.x, sun.y, sun.z, shading.sunEnabled ? 1.0f : 0.0f };
+    float moonDir[4] = { moon.x, moon.y, moon.z, shading.moonEnabled ? 1.0f : 0.0f };
+    float sunSize[2] = { std::atan(shading.sunSize / kCelestialDistance),
+                         std::atan(shading.sunGlowSize / kCelestialDistance) };
+    float moonSize[2] = { std::atan(shading.moonSize / kCelestialDistance),
+                          std::atan(shading.moonGlowSize / kCelestialDistance) };
+
+    // Cells cut by the upper hemisphere at this density, about 3 * pi * cells^2
+    const float cellsPerRadian = 60.0f;
+    float starProbability = std::min(1.0f, shading.starCount / (3.0f * 3.14159265f * cellsPerRadian * cellsPerRadian));
+    float stars[3] = { starProbability, shading.starBrightness, cellsPerRadian };
+
+    float vRight[3] = { right.x, right.y, right.z };
+    float vUp[3] = { up.x, up.y, up.z };
+    float vForward[3] = { forward.x, forward.y, forward.z };
+    float zenith[3], horizon[3], sunColor[3], moonColor[3];
+    toVec3(shading.zenithColor, zenith);
+    toVec3(shading.horizonColor, horizon);
+    toVec3(shading.sunColor, sunColor);
+    toVec3(shading.moonColor, moonColor);
+    int scattering = shading.scattering ? 1 : 0;
+
+    rlDrawRenderBatchActive();
+    BeginShaderMode(shader);
+    SetShaderValue(shader, locRight, vRight, SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, locUp, vUp, SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, locForward, vForward, SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, locProjection, projection, SHADER_UNIFORM_VEC2);
+    SetShaderValue(shader, locZenith, zenith, SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, locHorizon, horizon, SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, locSunDir, sunDir, SHADER_UNIFORM_VEC4);
+    SetShaderValue(shader, locSunColor, sunColor, SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, locSunSize, sunSize, SHADER_UNIFORM_VEC2);
+    SetShaderValue(shader, locMoonDir, moonDir, SHADER_UNIFORM_VEC4);
+    SetShaderValue(shader, locMoonColor, moonColor, SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, locMoonSize, moonSize, SHADER_UNIFORM_VEC2);
+    SetShaderValue(shader, locStars, stars, SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, locTime, &time, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shader, locScattering, &scattering, SHADER_UNIFORM_INT);
+
+    rlDisableDepthTest();
+    rlDisableDepthMask();
+    rlBegin(RL_TRIANGLES);
+    rlVertex2f(-1.0f, -1.0f);
+    rlVertex2f(3.0f, -1.0f);
+    rlVertex2f(-1.0f, 3.0f);
+    rlEnd();
+    rlDrawRenderBatchActive();
+    rlEnableDepthMask();
+    rlEnableDepthTest();
+    EndShaderMode();
+}
+
+} // namespace ethereal
@@ -0,0 +1,74 @@
+#pragma once
+#include "raylib.h"
+#include "core/Vector3D.hpp"
+
+namespace ethereal {
+
+// Per-renderer look of the sky pass. Sun and moon sizes are world units at the
+// distance the old sphere stacks were drawn at, so existing configs carry over.
+struct SkyShading {
+    Color zenithColor = {70, 130, 180, 255};
+    Color horizonColor = {200, 220, 240, 255};
+
+    bool sunEnabled = true;
+    Vector3D sunDirection = Vector3D(0.5f, 0.8f, 0.3f);
+    Color sunColor = {255, 250, 240, 255};
+    float sunSize = 30.0f;
+    float sunGlowSize = 120.0f;
+
+    bool moonEnabled = false;
+    Vector3D moonDirection = Vector3D(-0.3f, 0.6f, 0.5f);
+    Color moonColor = {220, 230, 255, 255};
+    float moonSize = 25.0f;
+    float moonGlowSize = 80.0f;
+
+    int starCount = 0;              // Expected stars over the upper hemisphere
+    float starBrightness = 0.9f;
+
+    // Cheap analytic single scattering (Rayleigh + Mie) lit by the sun
+    bool scattering = false;
+};
+
+// Whole sky in one full-screen triangle: elevation gradient, sun and moon discs
+// with their glow, a hashed twinkling star field and optional scattering, all
+// evaluated per pixel from the view ray. Replaces the per-row DrawLine gradient
+// and the DrawSphere glow stacks.
+class SkyShader {
+public:
+    SkyShader() = default;
+    ~SkyShader();
+
+    SkyShader(const SkyShader&) = delete;
+    SkyShader& operator=(const SkyShader&) = delete;
+
+    // Requires an open window
+    bool load();
+    void unload();
+    bool isLoaded() const { return loaded; }
+
+    // Call outside BeginMode3D, before anything else in the frame
+    void draw(const Vector3D& cameraPosition, const Vector3D& cameraTarget, float fovY,
+              const SkyShading& shading, float time);
+
+private:
+    Shader shader = { 0 };
+    bool loaded = false;
+
+    int locRight = -1;
+    int locUp = -1;
+    int locForward = -1;
+    int locProjection = -1;
+    int locZenith = -1;
+    int locHorizon = -1;
+    int locSunDir = -1;
+    int locSunColor = -1;
+    int locSunSize = -1;
+    int locMoonDir = -1;
+    int locMoonColor = -1;
+    int locMoonSize = -1;
+    int locStars = -1;
+    int locTime = -1;
+    int locScattering = -1;
+};
+
+} // namespace ethereal
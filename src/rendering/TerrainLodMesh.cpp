@@ -0,0 +1,235 @@
+#include "TerrainLodMesh.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ethereal {
+
+bool TerrainLodMesh::build(const TerrainChunk& chunk, const TerrainConfig& terrainConfig,
+                           const TerrainMesh::Palette& palette, const TerrainLodSettings& lodSettings) {
+    unload();
+    settings = lodSettings;
+
+    const int resolution = static_cast<int>(std::lround(std::sqrt(static_cast<double>(chunk.vertices.size())))) - 1;
+    if (resolution < 1 || static_cast<size_t>((resolution + 1) * (resolution + 1)) != chunk.vertices.size()) {
+        return false;
+    }
+
+    // Morphing needs even patches that tile the chunk; otherwise draw it as one patch
+    int leafTiles = settings.leafTiles;
+    if (leafTiles < 2 || leafTiles % 2 != 0 || resolution % leafTiles != 0) {
+        leafTiles = resolution;
+    }
+
+    int rootTiles = leafTiles;
+    levelCount = 1;
+    while (rootTiles * 2 <= resolution && resolution % (rootTiles * 2) == 0) {
+        rootTiles *= 2;
+        ++levelCount;
+    }
+
+    // A drawn patch reaches at most one node diagonal past its level's range, and the
+    // coarser neighbour starts morphing at 2 * morphStart * range. Keeping the diagonal
+    // inside that gap is what makes the seams between levels exact.
+    settings.morphStart = std::clamp(settings.morphStart, 0.55f, 0.95f);
+    float leafDiagonal = leafTiles * terrainConfig.tileSize * 1.41421356f;
+    float firstRange = std::max(settings.baseRange, leafDiagonal / (2.0f * settings.morphStart - 1.0f));
+
+    ranges.resize(levelCount);
+    for (int level = 0; level < levelCount; ++level) {
+        ranges[level] = firstRange * static_cast<float>(1 << level);
+    }
+
+    // Complete quadtrees: roots * (4^levels - 1) / 3 nodes
+    const int rootsPerSide = resolution / rootTiles;
+    nodes.reserve(static_cast<size_t>(rootsPerSide) * rootsPerSide * (((1 << (2 * levelCount)) - 1) / 3));
+
+    for (int rz = 0; rz < rootsPerSide; ++rz) {
+        for (int rx = 0; rx < rootsPerSide; ++rx) {
+            roots.push_back(buildTree(chunk, resolution, rx * rootTiles, rz * rootTiles, levelCount - 1,
+                                      leafTiles, terrainConfig, palette));
+        }
+    }
+    return true;
+}
+
+void TerrainLodMesh::unload() {
+    nodes.clear();
+    roots.clear();
+    ranges.clear();
+    levelCount = 0;
+}
+
+int TerrainLodMesh::buildTree(const TerrainChunk& chunk, int resolution, int originX, int originZ, int level,
+                              int leafTiles, const TerrainConfig& terrainConfig, const TerrainMesh::Palette& palette) {
+    const int index = static_cast<int>(nodes.size());
+    nodes.emplace_back();
+    nodes[index].level = level;
+    buildNodeMesh(nodes[index], chunk, resolution, originX, originZ, leafTiles, terrainConfig, palette);
+
+    if (level > 0) {
+        const int half = (leafTiles << level) / 2;
+        for (int c = 0; c < 4; ++c) {
+            int child = buildTree(chunk, resolution, originX + (c % 2) * half, originZ + (c / 2) * half,
+                                  level - 1, leafTiles, terrainConfig, palette);
+            nodes[index].children[c] = child;
+        }
+    }
+    return index;
+}
+
+void TerrainLodMesh::buildNodeMesh(Node& node, const TerrainChunk& chunk, int resolution, int originX, int originZ,
+                                   int leafTiles, const TerrainConfig& terrainConfig, const TerrainMesh::Palette& palette) {
+    const int stride = 1 << node.level;
+    const bool coarsest = node.level == levelCount - 1;
+
+    auto vertexAt = [&](int gx, int gz) -> const TerrainVertex& {
+        return chunk.vertices[(originZ + gz * stride) * (resolution + 1) + (originX + gx * stride)];
+    };
+
+    // Height of the next-coarser level's surface at patch grid point (gx, gz). Even points
+    // are shared with that level; odd ones sit on a coarse edge or on the tr-bl diagonal
+    // that buildGridIndices uses to split each quad.
+    auto morphHeight = [&](int gx, int gz) {
+        if (coarsest) return vertexAt(gx, gz).height;
+        bool oddX = gx % 2 != 0;
+        bool oddZ = gz % 2 != 0;
+        if (oddX && oddZ) return 0.5f * (vertexAt(gx + 1, gz - 1).height + vertexAt(gx - 1, gz + 1).height);
+        if (oddX) return 0.5f * (vertexAt(gx - 1, gz).height + vertexAt(gx + 1, gz).height);
+        if (oddZ) return 0.5f * (vertexAt(gx, gz - 1).height + vertexAt(gx, gz + 1).height);
+        return vertexAt(gx, gz).height;
+    };
+
+    const int half = leafTiles / 2;
+    const int quadrantTriangles = half * half * 2;
+    ArenaVector<Vector3D> corners;
+    ArenaVector<float> morphHeights;
+    ArenaVector<Color> faceColors;
+
+    auto addTriangle = [&](int ax, int az, int bx, int bz, int cx, int cz) {
+        const TerrainVertex& a = vertexAt(ax, az);
+        const TerrainVertex& b = vertexAt(bx, bz);
+        const TerrainVertex& c = vertexAt(cx, cz);
+
+        Vector3D faceNormal = (b.position - a.position).cross(c.position - a.position).normalized();
+        float avgHeight = (a.height + b.height + c.height) / 3.0f;
+        float normalizedHeight = std::clamp((avgHeight - terrainConfig.baseHeight) / terrainConfig.maxHeight, 0.0f, 1.0f);
+        faceColors.push_back(palette(normalizedHeight, faceNormal));
+
+        corners.push_back(a.position);
+        corners.push_back(b.position);
+        corners.push_back(c.position);
+        morphHeights.push_back(morphHeight(ax, az));
+        morphHeights.push_back(morphHeight(bx, bz));
+        morphHeights.push_back(morphHeight(cx, cz));
+    };
+
+    node.boundsMin = vertexAt(0, 0).position;
+    node.boundsMax = node.boundsMin;
+    for (int gz = 0; gz <= leafTiles; ++gz) {
+        for (int gx = 0; gx <= leafTiles; ++gx) {
+            const Vector3D& p = vertexAt(gx, gz).position;
+            node.boundsMin = Vector3D(std::min(node.boundsMin.x, p.x), std::min(node.boundsMin.y, p.y), std::min(node.boundsMin.z, p.z));
+            node.boundsMax = Vector3D(std::max(node.boundsMax.x, p.x), std::max(node.boundsMax.y, p.y), std::max(node.boundsMax.z, p.z));
+        }
+    }
+
+    // Quadrant order matches the children (x fastest); same winding as Terrain::buildGridIndices
+    for (int q = 0; q < 4; ++q) {
+        corners.clear();
+        morphHeights.clear();
+        faceColors.clear();
+        corners.reserve(quadrantTriangles * 3);
+        morphHeights.reserve(quadrantTriangles * 3);
+        faceColors.reserve(quadrantTriangles);
+
+        const int startX = (q % 2) * half;
+        const int startZ = (q / 2) * half;
+        for (int gz = startZ; gz < startZ + half; ++gz) {
+            for (int gx = startX; gx < startX + half; ++gx) {
+                addTriangle(gx, gz, gx, gz + 1, gx + 1, gz);
+                addTriangle(gx + 1, gz, gx, gz + 1, gx + 1, gz + 1);
+            }
+        }
+
+        node.quadrants[q] = std::make_unique<TerrainMesh>();
+        node.quadrants[q]->uploadTriangles(corners, morphHeights, faceColors);
+    }
+    node.quadrantTriangles = quadrantTriangles;
+}
+
+int TerrainLodMesh::draw(const TerrainShader& shader, const Vector3D& cameraPosition, float viewDistance,
+                         const ViewCuller* culler) const {
+    int triangles = 0;
+    for (int root : roots) {
+        triangles += drawNode(root, shader, cameraPosition, viewDistance, culler);
+    }
+    shader.disableMorph();
+    return triangles;
+}
+
+int TerrainLodMesh::drawNode(int index, const TerrainShader& shader, const Vector3D& cameraPosition,
+                             float viewDistance, const ViewCuller* culler) const {
+    const Node& node = nodes[index];
+    float distanceSq = distanceSqToBounds(cameraPosition, node.boundsMin, node.boundsMax);
+    if (distanceSq > viewDistance * viewDistance) return 0;
+    if (culler && !culler->isVisible(node.boundsMin, node.boundsMax)) return 0;
+
+    // The coarsest level has nothing to morph into
+    if (node.level == levelCount - 1) {
+        shader.disableMorph();
+    } else {
+        float range = ranges[node.level];
+        shader.setMorphRange(range * settings.morphStart, range);
+    }
+
+    float finerRange = node.level > 0 ? ranges[node.level - 1] : 0.0f;
+    if (node.level == 0 || distanceSq >= finerRange * finerRange) {
+        int triangles = 0;
+        for (int q = 0; q < 4; ++q) {
+            triangles += drawQuadrant(node, q, shader, culler);
+        }
+        return triangles;
+    }
+
+    // Split: children inside the finer range recurse, the rest stay at this level
+    int triangles = 0;
+    for (int q = 0; q < 4; ++q) {
+        const Node& child = nodes[node.children[q]];
+        if (distanceSqToBounds(cameraPosition, child.boundsMin, child.boundsMax) < finerRange * finerRange) {
+            triangles += drawNode(node.children[q], shader, cameraPosition, viewDistance, culler);
+            // Restore this level's morph range for the remaining quadrants
+            if (node.level == levelCount - 1) {
+                shader.disableMorph();
+            } else {
+                shader.setMorphRange(ranges[node.level] * settings.morphStart, ranges[node.level]);
+            }
+        } else {
+            triangles += drawQuadrant(node, q, shader, culler);
+        }
+    }
+    return triangles;
+}
+
+int TerrainLodMesh::drawQuadrant(const Node& node, int quadrant, const TerrainShader& shader,
+                                 const ViewCuller* culler) const {
+    if (culler) {
+        // Quadrant footprint with the whole node's height range; morphing stays inside it
+        Vector3D mid = (node.boundsMin + node.boundsMax) * 0.5f;
+        Vector3D quadrantMin(quadrant % 2 ? mid.x : node.boundsMin.x, node.boundsMin.y,
+                             quadrant / 2 ? mid.z : node.boundsMin.z);
+        Vector3D quadrantMax(quadrant % 2 ? node.boundsMax.x : mid.x, node.boundsMax.y,
+                             quadrant / 2 ? node.boundsMax.z : mid.z);
+        if (!culler->isVisible(quadrantMin, quadrantMax)) return 0;
+    }
+    node.quadrants[quadrant]->draw(shader);
+    return node.quadrantTriangles;
+}
+
+float TerrainLodMesh::distanceSqToBounds(const Vector3D& point, const Vector3D& boundsMin, const Vector3D& boundsMax) {
+    float dx = std::max({boundsMin.x - point.x, 0.0f, point.x - boundsMax.x});
+    float dy = std::max({boundsMin.y - point.y, 0.0f, point.y - boundsMax.y});
+    float dz = std::max({boundsMin.z - point.z, 0.0f, point.z - boundsMax.z});
+    return dx * dx + dy * dy + dz * dz;
+}
+
+} // namespace ethereal
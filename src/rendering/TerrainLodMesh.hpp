@@ -0,0 +1,66 @@
+#pragma once
+#include "core/Vector3D.hpp"
+#include "environment/Terrain.hpp"
+#include "rendering/TerrainMesh.hpp"
+#include "rendering/ViewCuller.hpp"
+#include <memory>
+#include <vector>
+
+namespace ethereal {
+
+struct TerrainLodSettings {
+    int leafTiles = 8;          // Tiles along a leaf patch edge (even, divides the chunk resolution)
+    float baseRange = 400.0f;   // Camera distance covered by the finest level; doubles per level.
+                                // Raised if needed so patches stay crack-free (see build()).
+    float morphStart = 0.7f;    // Fraction of a level's range where it starts morphing to the next
+};
+
+// CDLOD-style quadtree over one streamed chunk. Every node is a leafTiles x leafTiles
+// patch; a level-l node samples the chunk grid with stride 2^l. A node is split while
+// its bounds touch the finer level's range; children that stay outside that range are
+// drawn as the parent's quadrant instead. Vertices morph to the coarser level's surface
+// towards the end of each range, which hides popping and the seams between levels.
+class TerrainLodMesh {
+public:
+    TerrainLodMesh() = default;
+
+    // Requires an open window; replaces any previous build
+    bool build(const TerrainChunk& chunk, const TerrainConfig& terrainConfig,
+               const TerrainMesh::Palette& palette, const TerrainLodSettings& settings);
+    void unload();
+    bool isLoaded() const { return !nodes.empty(); }
+
+    // Selects patches for this camera and draws them; returns the triangle count drawn.
+    // With a culler, nodes and quadrants outside its frustum or behind its horizon are skipped.
+    int draw(const TerrainShader& shader, const Vector3D& cameraPosition, float viewDistance,
+             const ViewCuller* culler = nullptr) const;
+
+    int getLevelCount() const { return levelCount; }
+
+private:
+    struct Node {
+        Vector3D boundsMin;
+        Vector3D boundsMax;
+        int level = 0;
+        int children[4] = { -1, -1, -1, -1 };
+        int quadrantTriangles = 0;
+        std::unique_ptr<TerrainMesh> quadrants[4];  // Patch split along its midlines
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int> roots;
+    std::vector<float> ranges;
+    TerrainLodSettings settings;
+    int levelCount = 0;
+
+    void buildNodeMesh(Node& node, const TerrainChunk& chunk, int resolution, int originX, int originZ,
+                       int leafTiles, const TerrainConfig& terrainConfig, const TerrainMesh::Palette& palette);
+    int buildTree(const TerrainChunk& chunk, int resolution, int originX, int originZ, int level,
+                  int leafTiles, const TerrainConfig& terrainConfig, const TerrainMesh::Palette& palette);
+    int drawNode(int index, const TerrainShader& shader, const Vector3D& cameraPosition, float viewDistance,
+                 const ViewCuller* culler) const;
+    int drawQuadrant(const Node& node, int quadrant, const TerrainShader& shader, const ViewCuller* culler) const;
+    static float distanceSqToBounds(const Vector3D& point, const Vector3D& boundsMin, const Vector3D& boundsMax);
+};
+
+} // namespace ethereal
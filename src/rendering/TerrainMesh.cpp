@@ -0,0 +1,263 @@
+#include "TerrainMesh.hpp"
+#include "utils/Telemetry.hpp"
+#include "rlgl.h"
+#include <algorithm>
+
+namespace ethereal {
+
+namespace {
+
+const char* kTerrainVertexShader = R"(#version 330
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;     // x = morph height
+in vec4 vertexColor;
+
+uniform mat4 mvp;
+uniform mat4 matModel;
+uniform vec3 viewPos;
+uniform vec2 morphRange;    // start, end camera distance
+
+out vec3 fragPosition;
+out vec4 fragColor;
+
+void main() {
+    vec3 position = vertexPosition;
+    float morph = clamp((distance(position, viewPos) - morphRange.x) / (morphRange.y - morphRange.x), 0.0, 1.0);
+    position.y = mix(position.y, vertexTexCoord.x, morph);
+
+    fragPosition = vec3(matModel * vec4(position, 1.0));
+    fragColor = vertexColor;
+    gl_Position = mvp * vec4(position, 1.0);
+}
+)";
+
+const char* kTerrainFragmentShader = R"(#version 330
+in vec3 fragPosition;
+in vec4 fragColor;
+
+uniform vec3 viewPos;
+uniform vec3 sunDir;
+uniform vec4 lighting;      // ambient, diffuse, rim strength, rim power
+uniform float maxLight;
+uniform vec4 fogParams;     // start, end, amount, height range
+uniform vec3 fogColorLow;
+uniform vec3 fogColorHigh;
+uniform float viewDistance;
+
+out vec4 finalColor;
+
+void main() {
+    vec3 toCamera = viewPos - fragPosition;
+    float dist = length(toCamera);
+    if (dist > viewDistance) discard;
+
+    // Flat face normal of the (possibly morphed) triangle; heightfield faces point up
+    vec3 normal = normalize(cross(dFdx(fragPosition), dFdy(fragPosition)));
+    if (normal.y < 0.0) normal = -normal;
+
+    float diffuse = lighting.x + max(dot(normal, sunDir), 0.0) * lighting.y;
+    float rim = pow(1.0 - max(dot(normal, toCamera / max(dist, 0.001)), 0.0), lighting.w) * lighting.z;
+    vec3 color = min(fragColor.rgb * min(diffuse + rim, maxLight), vec3(1.0));
+
+    float fog = clamp((dist - fogParams.x) / (fogParams.y - fogParams.x), 0.0, 1.0);
+    fog *= fog;
+    float heightFog = clamp(fragPosition.y / fogParams.w, 0.0, 1.0);
+    vec3 fogColor = mix(fogColorLow, fogColorHigh, heightFog);
+
+    finalColor = vec4(mix(color, fogColor, fog * fogParams.z), 1.0);
+}
+)";
+
+// Morph range that never starts blending
+const float kNoMorph[2] = { 1.0e9f, 2.0e9f };
+
+void colorToVec3(Color c, float* out) {
+    out[0] = c.r / 255.0f;
+    out[1] = c.g / 255.0f;
+    out[2] = c.b / 255.0f;
+}
+
+} // namespace
+
+// === TerrainShader ===
+
+TerrainShader::~TerrainShader() {
+    unload();
+}
+
+bool TerrainShader::load() {
+    unload();
+
+    shader = LoadShaderFromMemory(kTerrainVertexShader, kTerrainFragmentShader);
+    if (shader.id == 0) return false;
+
+    locViewPos = GetShaderLocation(shader, "viewPos");
+    locSunDir = GetShaderLocation(shader, "sunDir");
+    locLighting = GetShaderLocation(shader, "lighting");
+    locMaxLight = GetShaderLocation(shader, "maxLight");
+    locFogParams = GetShaderLocation(shader, "fogParams");
+    locFogColorLow = GetShaderLocation(shader, "fogColorLow");
+    locFogColorHigh = GetShaderLocation(shader, "fogColorHigh");
+    locViewDistance = GetShaderLocation(shader, "viewDistance");
+    locMorphRange = GetShaderLocation(shader, "morphRange");
+
+    material = LoadMaterialDefault();
+    material.shader = shader;
+    loaded = true;
+    return true;
+}
+
+void TerrainShader::unload() {
+    if (!loaded) return;
+    UnloadMaterial(material);   // also releases the shader
+    material = { 0 };
+    shader = { 0 };
+    loaded = false;
+}
+
+void TerrainShader::apply(const Vector3D& cameraPosition, const TerrainShading& shading) const {
+    if (!loaded) return;
+
+    Vector3D sun = shading.sunDirection.normalized();
+    float viewPos[3] = { cameraPosition.x, cameraPosition.y, cameraPosition.z };
+    float sunDir[3] = { sun.x, sun.y, sun.z };
+    float lighting[4] = { shading.ambient, shading.diffuse, shading.rimStrength, shading.rimPower };
+    float fogParams[4] = { shading.fogStart, shading.fogEnd, shading.fogAmount, shading.fogHeightRange };
+    float fogLow[3], fogHigh[3];
+    colorToVec3(shading.fogColorLow, fogLow);
+    colorToVec3(shading.fogColorHigh, fogHigh);
+
+    SetShaderValue(shader, locViewPos, viewPos, SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, locSunDir, sunDir, SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, locLighting, lighting, SHADER_UNIFORM_VEC4);
+    SetShaderValue(shader, locMaxLight, &shading.maxLight, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shader, locFogParams, fogParams, SHADER_UNIFORM_VEC4);
+    SetShaderValue(shader, locFogColorLow, fogLow, SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, locFogColorHigh, fogHigh, SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, locViewDistance, &shading.viewDistance, SHADER_UNIFORM_FLOAT);
+    disableMorph();
+}
+
+void TerrainShader::setMorphRange(float start, float end) const {
+    if (!loaded) return;
+    float range[2] = { start, std::max(end, start + 0.001f) };
+    SetShaderValue(shader, locMorphRange, range, SHADER_UNIFORM_VEC2);
+}
+
+void TerrainShader::disableMorph() const {
+    if (!loaded) return;
+    SetShaderValue(shader, locMorphRange, kNoMorph, SHADER_UNIFORM_VEC2);
+}
+
+void TerrainShader::draw(const Mesh& mesh) const {
+    if (!loaded) return;
+
+    // The CPU path drew both windings; keep the terrain visible from below
+    Matrix identity = { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1 };
+    rlDisableBackfaceCulling();
+    DrawMesh(mesh, material, identity);
+    rlEnableBackfaceCulling();
+    TELEMETRY_COUNT("render.drawCalls", 1);
+    TELEMETRY_COUNT("render.triangles", mesh.triangleCount);
+}
+
+// === TerrainMesh ===
+
+TerrainMesh::~TerrainMesh() {
+    unload();
+}
+
+bool TerrainMesh::upload(const Terrain& terrain, const Palette& palette) {
+    if (!build(terrain.getVertices(), terrain.getIndices(), terrain.getConfig(), palette)) return false;
+    source = &terrain;
+    sourceRevision = terrain.getRevision();
+    return true;
+}
+
+bool TerrainMesh::upload(const TerrainChunk& chunk, const TerrainConfig& terrainConfig, const Palette& palette) {
+    return build(chunk.vertices, chunk.indices, terrainConfig, palette);
+}
+
+bool TerrainMesh::build(const std::vector<TerrainVertex>& vertices, const std::vector<unsigned int>& indices,
+                        const TerrainConfig& terrainConfig, const Palette& palette) {
+    const size_t triangleCount = indices.size() / 3;
+    ArenaVector<Vector3D> corners(triangleCount * 3);
+    ArenaVector<float> morphHeights(triangleCount * 3);
+    ArenaVector<Color> faceColors(triangleCount);
+
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const TerrainVertex& v0 = vertices[indices[t * 3]];
+        const TerrainVertex& v1 = vertices[indices[t * 3 + 1]];
+        const TerrainVertex& v2 = vertices[indices[t * 3 + 2]];
+
+        Vector3D edge1 = v1.position - v0.position;
+        Vector3D edge2 = v2.position - v0.position;
+        Vector3D faceNormal = edge1.cross(edge2).normalized();
+
+        float avgHeight = (v0.height + v1.height + v2.height) / 3.0f;
+        float normalizedHeight = std::clamp((avgHeight - terrainConfig.baseHeight) / terrainConfig.maxHeight, 0.0f, 1.0f);
+        faceColors[t] = palette(normalizedHeight, faceNormal);
+
+        corners[t * 3] = v0.position;
+        corners[t * 3 + 1] = v1.position;
+        corners[t * 3 + 2] = v2.position;
+        // Never morphs; the shader still reads a morph height
+        morphHeights[t * 3] = v0.position.y;
+        morphHeights[t * 3 + 1] = v1.position.y;
+        morphHeights[t * 3 + 2] = v2.position.y;
+    }
+
+    return uploadTriangles(corners, morphHeights, faceColors);
+}
+
+bool TerrainMesh::uploadTriangles(const ArenaVector<Vector3D>& corners, const ArenaVector<float>& morphHeights,
+                                  const ArenaVector<Color>& faceColors) {
+    unload();
+
+    const int triangleCount = static_cast<int>(faceColors.size());
+    if (triangleCount == 0 || corners.size() < faceColors.size() * 3 || morphHeights.size() < corners.size()) {
+        return false;
+    }
+
+    mesh = { 0 };
+    mesh.triangleCount = triangleCount;
+    mesh.vertexCount = triangleCount * 3;
+    mesh.vertices = static_cast<float*>(MemAlloc(mesh.vertexCount * 3 * sizeof(float)));
+    mesh.texcoords = static_cast<float*>(MemAlloc(mesh.vertexCount * 2 * sizeof(float)));
+    mesh.colors = static_cast<unsigned char*>(MemAlloc(mesh.vertexCount * 4 * sizeof(unsigned char)));
+
+    for (int v = 0; v < mesh.vertexCount; ++v) {
+        const Color& color = faceColors[v / 3];
+        mesh.vertices[v * 3] = corners[v].x;
+        mesh.vertices[v * 3 + 1] = corners[v].y;
+        mesh.vertices[v * 3 + 2] = corners[v].z;
+        mesh.texcoords[v * 2] = morphHeights[v];
+        mesh.texcoords[v * 2 + 1] = 0.0f;
+        mesh.colors[v * 4] = color.r;
+        mesh.colors[v * 4 + 1] = color.g;
+        mesh.colors[v * 4 + 2] = color.b;
+        mesh.colors[v * 4 + 3] = 255;
+    }
+
+    UploadMesh(&mesh, false);
+    loaded = true;
+    return true;
+}
+
+void TerrainMesh::unload() {
+    if (!loaded) return;
+    UnloadMesh(mesh);
+    mesh = { 0 };
+    source = nullptr;
+    loaded = false;
+}
+
+bool TerrainMesh::isStale(const Terrain& terrain) const {
+    return !loaded || source != &terrain || sourceRevision != terrain.getRevision();
+}
+
+void TerrainMesh::draw(const TerrainShader& shader) const {
+    if (loaded) shader.draw(mesh);
+}
+
+} // namespace ethereal
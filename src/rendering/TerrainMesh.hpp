@@ -0,0 +1,110 @@
+#pragma once
+#include "raylib.h"
+#include "core/Vector3D.hpp"
+#include "environment/Terrain.hpp"
+#include "utils/FrameArena.hpp"
+#include <cstdint>
+#include <functional>
+
+namespace ethereal {
+
+// Per-renderer look of the terrain shader (lighting, fog and view range)
+struct TerrainShading {
+    Vector3D sunDirection = Vector3D(0.5f, 0.8f, 0.3f);
+    float ambient = 0.4f;
+    float diffuse = 0.6f;
+    float rimStrength = 0.15f;
+    float rimPower = 2.0f;
+    float maxLight = 10.0f;
+
+    float fogStart = 200.0f;
+    float fogEnd = 1000.0f;
+    float fogAmount = 0.85f;
+    float fogHeightRange = 200.0f;
+    Color fogColorLow = {200, 220, 240, 255};
+    Color fogColorHigh = {180, 210, 250, 255};
+
+    float viewDistance = 1000.0f;
+};
+
+// Lighting/fog program shared by every terrain mesh of a renderer. Vertices carry a
+// second "morph" height and blend toward it with camera distance (LOD geomorphing);
+// face normals come from screen-space derivatives so they follow the morph.
+class TerrainShader {
+public:
+    TerrainShader() = default;
+    ~TerrainShader();
+
+    TerrainShader(const TerrainShader&) = delete;
+    TerrainShader& operator=(const TerrainShader&) = delete;
+
+    // Requires an open window
+    bool load();
+    void unload();
+    bool isLoaded() const { return loaded; }
+
+    // Per-frame uniforms; also resets the morph range to "off"
+    void apply(const Vector3D& cameraPosition, const TerrainShading& shading) const;
+    // Vertices reach their morph height at `end` camera distance, starting at `start`
+    void setMorphRange(float start, float end) const;
+    void disableMorph() const;
+
+    // Call between BeginMode3D/EndMode3D
+    void draw(const Mesh& mesh) const;
+
+private:
+    Shader shader = { 0 };
+    Material material = { 0 };
+    bool loaded = false;
+
+    int locViewPos = -1;
+    int locSunDir = -1;
+    int locLighting = -1;
+    int locMaxLight = -1;
+    int locFogParams = -1;
+    int locFogColorLow = -1;
+    int locFogColorHigh = -1;
+    int locViewDistance = -1;
+    int locMorphRange = -1;
+};
+
+// Terrain uploaded once as a flat-shaded raylib Mesh. Each triangle gets its own
+// vertices carrying the palette color, so the low-poly look survives while
+// lighting and fog run in the shader.
+class TerrainMesh {
+public:
+    // Base color for a face from its normalized height (0..1) and face normal
+    using Palette = std::function<Color(float normalizedHeight, const Vector3D& faceNormal)>;
+
+    TerrainMesh() = default;
+    ~TerrainMesh();
+
+    TerrainMesh(const TerrainMesh&) = delete;
+    TerrainMesh& operator=(const TerrainMesh&) = delete;
+
+    // Requires an open window; replaces any previous upload
+    bool upload(const Terrain& terrain, const Palette& palette);
+    bool upload(const TerrainChunk& chunk, const TerrainConfig& terrainConfig, const Palette& palette);
+    // Raw triangle soup: 3 corners and 3 morph heights per triangle, one color per
+    // triangle. Built as frame scratch; only the raylib mesh outlives the call.
+    bool uploadTriangles(const ArenaVector<Vector3D>& corners, const ArenaVector<float>& morphHeights,
+                         const ArenaVector<Color>& faceColors);
+    void unload();
+
+    bool isLoaded() const { return loaded; }
+    // True when the terrain was regenerated since the last upload
+    bool isStale(const Terrain& terrain) const;
+
+    void draw(const TerrainShader& shader) const;
+
+private:
+    Mesh mesh = { 0 };
+    bool loaded = false;
+    const Terrain* source = nullptr;
+    uint32_t sourceRevision = 0;
+
+    bool build(const std::vector<TerrainVertex>& vertices, const std::vector<unsigned int>& indices,
+               const TerrainConfig& terrainConfig, const Palette& palette);
+};
+
+} // namespace ethereal
@@ -0,0 +1,344 @@
+#include "ViewCuller.hpp"
+#include "core/Simd.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace ethereal {
+
+namespace {
+
+// Monotonic stand-in for atan2 in [0, 4): one unit per quadrant ("diamond angle").
+// Bins only need a consistent ordering around the eye, not equal angular widths.
+float pseudoAngle(float dx, float dz) {
+    float sum = std::abs(dx) + std::abs(dz);
+    if (sum <= 0.0f) return 0.0f;
+    float t = dz / sum;
+    if (dx >= 0.0f) return dz >= 0.0f ? t : 4.0f + t;
+    return 2.0f - t;
+}
+
+float wrapPseudoAngle(float angle) {
+    if (angle > 2.0f) return angle - 4.0f;
+    if (angle <= -2.0f) return angle + 4.0f;
+    return angle;
+}
+
+} // namespace
+
+// === Frustum ===
+
+Frustum Frustum::fromViewProjection(const Matrix4& viewProjection) {
+    // Gribb-Hartmann: each plane is the last row plus or minus one of the others
+    const Matrix4& m = viewProjection;
+    const int rows[PlaneCount] = { 0, 0, 1, 1, 2, 2 };
+    const float signs[PlaneCount] = { 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f };
+
+    Frustum frustum;
+    for (int p = 0; p < PlaneCount; ++p) {
+        float a = m.at(3, 0) + signs[p] * m.at(rows[p], 0);
+        float b = m.at(3, 1) + signs[p] * m.at(rows[p], 1);
+        float c = m.at(3, 2) + signs[p] * m.at(rows[p], 2);
+        float w = m.at(3, 3) + signs[p] * m.at(rows[p], 3);
+        float length = std::sqrt(a * a + b * b + c * c);
+        float inv = length > 0.0f ? 1.0f / length : 0.0f;
+        frustum.nx[p] = a * inv;
+        frustum.ny[p] = b * inv;
+        frustum.nz[p] = c * inv;
+        frustum.d[p] = w * inv;
+    }
+    return frustum;
+}
+
+Frustum Frustum::fromCamera(const Vector3D& position, const Vector3D& target, float fovYDegrees,
+                            float aspect, float nearPlane, float farPlane) {
+    Matrix4 view = Matrix4::lookAt(position, target, Vector3D(0, 1, 0));
+    Matrix4 projection = Matrix4::perspective(fovYDegrees * 0.0174533f, aspect, nearPlane, farPlane);
+    return fromViewProjection(projection * view);
+}
+
+float Frustum::getDistance(int plane, const Vector3D& point) const {
+    return nx[plane] * point.x + ny[plane] * point.y + nz[plane] * point.z + d[plane];
+}
+
+bool Frustum::intersectsSphere(const Vector3D& center, float radius) const {
+    for (int p = 0; p < PlaneCount; ++p) {
+        if (getDistance(p, center) < -radius) return false;
+    }
+    return true;
+}
+
+bool Frustum::intersectsAabb(const Vector3D& boundsMin, const Vector3D& boundsMax) const {
+    // Only the corner furthest along each plane normal needs testing
+    for (int p = 0; p < PlaneCount; ++p) {
+        float x = nx[p] >= 0.0f ? boundsMax.x : boundsMin.x;
+        float y = ny[p] >= 0.0f ? boundsMax.y : boundsMin.y;
+        float z = nz[p] >= 0.0f ? boundsMax.z : boundsMin.z;
+        if (nx[p] * x + ny[p] * y + nz[p] * z + d[p] < 0.0f) return false;
+    }
+    return true;
+}
+
+size_t Frustum::testSpheres(const float* x, const float* y, const float* z, const float* radius,
+                            uint8_t* visible, size_t count) const {
+    size_t i = 0;
+    size_t visibleCount = 0;
+#if defined(LOOM_SIMD_SSE)
+    for (; i + 4 <= count; i += 4) {
+        __m128 px = _mm_loadu_ps(x + i);
+        __m128 py = _mm_loadu_ps(y + i);
+        __m128 pz = _mm_loadu_ps(z + i);
+        __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius + i));
+        __m128 outside = _mm_setzero_ps();
+        for (int p = 0; p < PlaneCount; ++p) {
+            __m128 dist = _mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(nx[p])), _mm_mul_ps(py, _mm_set1_ps(ny[p])));
+            dist = _mm_add_ps(dist, _mm_add_ps(_mm_mul_ps(pz, _mm_set1_ps(nz[p])), _mm_set1_ps(d[p])));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, negRadius));
+        }
+        int bits = _mm_movemask_ps(outside);
+        for (int lane = 0; lane < 4; ++lane) {
+            visible[i + lane] = (bits >> lane) & 1 ? 0 : 1;
+            visibleCount += visible[i + lane];
+        }
+    }
+#elif defined(LOOM_SIMD_NEON)
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t px = vld1q_f32(x + i);
+        float32x4_t py = vld1q_f32(y + i);
+        float32x4_t pz = vld1q_f32(z + i);
+        float32x4_t negRadius = vnegq_f32(vld1q_f32(radius + i));
+        uint32x4_t outside = vdupq_n_u32(0);
+        for (int p = 0; p < PlaneCount; ++p) {
+            float32x4_t dist = vmlaq_n_f32(vdupq_n_f32(d[p]), px, nx[p]);
+            dist = vmlaq_n_f32(dist, py, ny[p]);
+            dist = vmlaq_n_f32(dist, pz, nz[p]);
+            outside = vorrq_u32(outside, vcltq_f32(dist, negRadius));
+        }
+        uint32_t lanes[4];
+        vst1q_u32(lanes, outside);
+        for (int lane = 0; lane < 4; ++lane) {
+            visible[i + lane] = lanes[lane] ? 0 : 1;
+            visibleCount += visible[i + lane];
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        visible[i] = intersectsSphere(Vector3D(x[i], y[i], z[i]), radius[i]) ? 1 : 0;
+        visibleCount += visible[i];
+    }
+    return visibleCount;
+}
+
+// === ViewCuller ===
+
+ViewCuller::ViewCuller() : ViewCuller(ViewCullerConfig{}) {}
+
+ViewCuller::ViewCuller(const ViewCullerConfig& config) {
+    setConfig(config);
+}
+
+void ViewCuller::setConfig(const ViewCullerConfig& cfg) {
+    config = cfg;
+    config.azimuthBins = std::max(config.azimuthBins, 8);
+    config.distanceRings = std::max(config.distanceRings, 1);
+    config.firstRing = std::max(config.firstRing, 1.0f);
+    config.occlusionRange = std::max(config.occlusionRange, config.firstRing);
+    config.occluderCellsPerChunk = std::max(config.occluderCellsPerChunk, 1);
+
+    // Geometric spacing keeps depth resolution roughly proportional to distance
+    ringDistance.resize(config.distanceRings);
+    float growth = config.distanceRings > 1
+        ? std::pow(config.occlusionRange / config.firstRing, 1.0f / (config.distanceRings - 1))
+        : 1.0f;
+    float distance = config.firstRing;
+    for (int r = 0; r < config.distanceRings; ++r) {
+        ringDistance[r] = distance;
+        distance *= growth;
+    }
+    horizon.assign(static_cast<size_t>(config.azimuthBins) * config.distanceRings, -FLT_MAX);
+    horizonDirty = false;
+}
+
+void ViewCuller::begin(const Vector3D& position, const Vector3D& target, float fovYDegrees, float aspect,
+                       float nearPlane, float farPlane) {
+    frustum = Frustum::fromCamera(position, target, fovYDegrees, aspect, nearPlane, farPlane);
+    eye = position;
+    // Distance from the eye to the far corners bounds every point inside the frustum
+    float tanY = std::tan(fovYDegrees * 0.0174533f * 0.5f);
+    float tanX = tanY * aspect;
+    reach = farPlane * std::sqrt(1.0f + tanX * tanX + tanY * tanY);
+    stats = Stats{};
+    resetHorizon();
+}
+
+void ViewCuller::begin(const FlightCamera& camera, float fovYDegrees, float aspect, float nearPlane, float farPlane) {
+    begin(camera.getPosition(), camera.getTarget(), fovYDegrees, aspect, nearPlane, farPlane);
+}
+
+void ViewCuller::resetHorizon() {
+    std::fill(horizon.begin(), horizon.end(), -FLT_MAX);
+    horizonDirty = false;
+}
+
+void ViewCuller::resolveHorizon() const {
+    if (!horizonDirty) return;
+    // A ray blocked by a near column stays blocked for everything further out
+    const int rings = config.distanceRings;
+    for (int b = 0; b < config.azimuthBins; ++b) {
+        float* row = &horizon[static_cast<size_t>(b) * rings];
+        for (int r = 1; r < rings; ++r) {
+            row[r] = std::max(row[r], row[r - 1]);
+        }
+    }
+    horizonDirty = false;
+}
+
+bool ViewCuller::azimuthSpan(float minX, float minZ, float maxX, float maxZ, float& first, float& last) const {
+    if (eye.x >= minX && eye.x <= maxX && eye.z >= minZ && eye.z <= maxZ) return false;
+
+    // Outside a rectangle its corners span less than half a turn around the eye
+    float center = pseudoAngle(0.5f * (minX + maxX) - eye.x, 0.5f * (minZ + maxZ) - eye.z);
+    const float cornerX[4] = { minX, maxX, maxX, minX };
+    const float cornerZ[4] = { minZ, minZ, maxZ, maxZ };
+    float low = 0.0f;
+    float high = 0.0f;
+    for (int c = 0; c < 4; ++c) {
+        float offset = wrapPseudoAngle(pseudoAngle(cornerX[c] - eye.x, cornerZ[c] - eye.z) - center);
+        low = std::min(low, offset);
+        high = std::max(high, offset);
+    }
+    float binsPerUnit = config.azimuthBins * 0.25f;
+    first = (center + low) * binsPerUnit;
+    last = (center + high) * binsPerUnit;
+    return true;
+}
+
+void ViewCuller::horizontalRange(float minX, float minZ, float maxX, float maxZ,
+                                 float& nearDist, float& farDist) const {
+    float dx = std::max({ minX - eye.x, 0.0f, eye.x - maxX });
+    float dz = std::max({ minZ - eye.z, 0.0f, eye.z - maxZ });
+    float fx = std::max(std::abs(minX - eye.x), std::abs(maxX - eye.x));
+    float fz = std::max(std::abs(minZ - eye.z), std::abs(maxZ - eye.z));
+    nearDist = std::sqrt(dx * dx + dz * dz);
+    farDist = std::sqrt(fx * fx + fz * fz);
+}
+
+void ViewCuller::addOccluder(float minX, float minZ, float maxX, float maxZ, float topY) {
+    if (!config.enableOcclusion) return;
+    // Rays to anything inside the frustum stay inside it, so off-screen columns block nothing
+    if (!frustum.intersectsAabb(Vector3D(minX, eye.y - reach, minZ), Vector3D(maxX, topY, maxZ))) return;
+
+    float nearDist, farDist;
+    horizontalRange(minX, minZ, maxX, maxZ, nearDist, farDist);
+    if (farDist > ringDistance.back()) return;
+
+    float first, last;
+    if (!azimuthSpan(minX, minZ, maxX, maxZ, first, last)) return;
+    // Only bins the column covers edge to edge; a partial bin may have gaps
+    int firstBin = static_cast<int>(std::ceil(first));
+    int lastBin = static_cast<int>(std::floor(last)) - 1;
+    if (lastBin < firstBin) return;
+
+    // Every ray through the footprint below this slope hits the column
+    float rise = topY - eye.y;
+    float slope = rise > 0.0f ? rise / farDist : rise / std::max(nearDist, 1e-3f);
+    int ring = static_cast<int>(std::lower_bound(ringDistance.begin(), ringDistance.end(), farDist) - ringDistance.begin());
+
+    const int bins = config.azimuthBins;
+    const int rings = config.distanceRings;
+    for (int b = firstBin; b <= lastBin; ++b) {
+        int bin = ((b % bins) + bins) % bins;
+        float& blocked = horizon[static_cast<size_t>(bin) * rings + ring];
+        blocked = std::max(blocked, slope);
+    }
+    horizonDirty = true;
+    stats.occluders++;
+}
+
+void ViewCuller::addOccluders(const HeightTile& tile) {
+    if (!config.enableOcclusion || tile.resolution <= 0) return;
+
+    float size = tile.resolution * tile.spacing;
+    float nearDist, farDist;
+    horizontalRange(tile.originX, tile.originZ, tile.originX + size, tile.originZ + size, nearDist, farDist);
+    if (nearDist > ringDistance.back()) return;
+    if (!frustum.intersectsAabb(Vector3D(tile.originX, eye.y - reach, tile.originZ),
+                                Vector3D(tile.originX + size, eye.y + reach, tile.originZ + size))) return;
+
+    const int cells = std::min(config.occluderCellsPerChunk, tile.resolution);
+    const int stride = tile.resolution + 1;
+    for (int cz = 0; cz < cells; ++cz) {
+        int z0 = cz * tile.resolution / cells;
+        int z1 = (cz + 1) * tile.resolution / cells;
+        for (int cx = 0; cx < cells; ++cx) {
+            int x0 = cx * tile.resolution / cells;
+            int x1 = (cx + 1) * tile.resolution / cells;
+            // Lowest sample bounds the surface from below across the whole cell
+            float lowest = FLT_MAX;
+            for (int z = z0; z <= z1; ++z) {
+                const float* row = &tile.heights[static_cast<size_t>(z) * stride];
+                lowest = std::min(lowest, *std::min_element(row + x0, row + x1 + 1));
+            }
+            addOccluder(tile.originX + x0 * tile.spacing, tile.originZ + z0 * tile.spacing,
+                        tile.originX + x1 * tile.spacing, tile.originZ + z1 * tile.spacing, lowest);
+        }
+    }
+}
+
+bool ViewCuller::isOccluded(const Vector3D& boundsMin, const Vector3D& boundsMax) const {
+    if (!config.enableOcclusion || stats.occluders == 0) return false;
+
+    float nearDist, farDist;
+    horizontalRange(boundsMin.x, boundsMin.z, boundsMax.x, boundsMax.z, nearDist, farDist);
+    if (nearDist < ringDistance.front()) return false;
+
+    float first, last;
+    if (!azimuthSpan(boundsMin.x, boundsMin.z, boundsMax.x, boundsMax.z, first, last)) return false;
+
+    resolveHorizon();
+    // Deepest ring that is still entirely in front of the bounds
+    int ring = static_cast<int>(std::upper_bound(ringDistance.begin(), ringDistance.end(), nearDist) - ringDistance.begin()) - 1;
+
+    // Steepest ray from the eye to any point of the bounds
+    float rise = boundsMax.y - eye.y;
+    float topSlope = rise > 0.0f ? rise / nearDist : rise / farDist;
+
+    const int bins = config.azimuthBins;
+    const int rings = config.distanceRings;
+    int firstBin = static_cast<int>(std::floor(first));
+    int lastBin = static_cast<int>(std::floor(last));
+    for (int b = firstBin; b <= lastBin; ++b) {
+        int bin = ((b % bins) + bins) % bins;
+        if (horizon[static_cast<size_t>(bin) * rings + ring] <= topSlope) return false;
+    }
+    return true;
+}
+
+bool ViewCuller::isVisible(const Vector3D& boundsMin, const Vector3D& boundsMax) const {
+    stats.tested++;
+    if (!frustum.intersectsAabb(boundsMin, boundsMax)) {
+        stats.frustumCulled++;
+        return false;
+    }
+    if (isOccluded(boundsMin, boundsMax)) {
+        stats.occlusionCulled++;
+        return false;
+    }
+    return true;
+}
+
+bool ViewCuller::isVisible(const Vector3D& center, float radius) const {
+    stats.tested++;
+    if (!frustum.intersectsSphere(center, radius)) {
+        stats.frustumCulled++;
+        return false;
+    }
+    Vector3D extent(radius, radius, radius);
+    if (isOccluded(center - extent, center + extent)) {
+        stats.occlusionCulled++;
+        return false;
+    }
+    return true;
+}
+
+} // namespace ethereal
@@ -0,0 +1,104 @@
+#pragma once
+#include "core/Matrix4.hpp"
+#include "core/Vector3D.hpp"
+#include "entities/Camera3D.hpp"
+#include "environment/Terrain.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ethereal {
+
+// Six view planes in world space, stored by component so a batch of bounds can
+// be tested against one plane per SIMD lane group. A point p is inside a plane
+// when nx*p.x + ny*p.y + nz*p.z + d >= 0.
+class Frustum {
+public:
+    enum Plane { Left, Right, Bottom, Top, Near, Far, PlaneCount };
+
+    // Planes of a GL-style (column-vector) projection * view matrix
+    static Frustum fromViewProjection(const Matrix4& viewProjection);
+    // Same frustum raylib's BeginMode3D builds for this eye, target and vertical fov
+    static Frustum fromCamera(const Vector3D& position, const Vector3D& target, float fovYDegrees,
+                              float aspect, float nearPlane, float farPlane);
+
+    bool intersectsSphere(const Vector3D& center, float radius) const;
+    bool intersectsAabb(const Vector3D& boundsMin, const Vector3D& boundsMax) const;
+    // visible[i] = 1 if sphere i touches the frustum, else 0; returns the visible count
+    size_t testSpheres(const float* x, const float* y, const float* z, const float* radius,
+                       uint8_t* visible, size_t count) const;
+
+    float getDistance(int plane, const Vector3D& point) const;
+
+private:
+    float nx[PlaneCount] = {};
+    float ny[PlaneCount] = {};
+    float nz[PlaneCount] = {};
+    float d[PlaneCount] = {};
+};
+
+struct ViewCullerConfig {
+    bool enableOcclusion = true;
+    int azimuthBins = 256;          // Horizon resolution around the camera
+    int distanceRings = 16;         // Geometric depth slices of the horizon
+    float firstRing = 24.0f;        // Occluders nearer than this never hide anything
+    float occlusionRange = 2400.0f; // Objects beyond the last ring test against it
+    int occluderCellsPerChunk = 16; // Height columns per chunk edge fed by addOccluders()
+};
+
+// Per-frame visibility shared by the renderers. begin() extracts the frustum once;
+// terrain then feeds conservative occluders (solid columns under each cell's lowest
+// height), and isVisible() rejects bounds that are outside the frustum or whose
+// every view ray passes below that horizon. Occlusion is coarse: an object is only
+// hidden when a column fully covers each azimuth bin it spans and lies nearer than it.
+class ViewCuller {
+public:
+    ViewCuller();
+    explicit ViewCuller(const ViewCullerConfig& config);
+
+    void begin(const Vector3D& position, const Vector3D& target, float fovYDegrees, float aspect,
+               float nearPlane, float farPlane);
+    void begin(const FlightCamera& camera, float fovYDegrees, float aspect, float nearPlane, float farPlane);
+
+    // Solid column over [minX, maxX] x [minZ, maxZ] reaching up to topY
+    void addOccluder(float minX, float minZ, float maxX, float maxZ, float topY);
+    void addOccluders(const HeightTile& tile);
+
+    bool isVisible(const Vector3D& boundsMin, const Vector3D& boundsMax) const;
+    bool isVisible(const Vector3D& center, float radius) const;
+    bool isOccluded(const Vector3D& boundsMin, const Vector3D& boundsMax) const;
+
+    const Frustum& getFrustum() const { return frustum; }
+    const Vector3D& getPosition() const { return eye; }
+
+    struct Stats {
+        int occluders = 0;
+        int tested = 0;
+        int frustumCulled = 0;
+        int occlusionCulled = 0;
+    };
+    const Stats& getStats() const { return stats; }
+
+    void setConfig(const ViewCullerConfig& cfg);
+    const ViewCullerConfig& getConfig() const { return config; }
+
+private:
+    ViewCullerConfig config;
+    Frustum frustum;
+    Vector3D eye;
+    float reach = 0.0f;
+    std::vector<float> ringDistance;
+    // Steepest slope (rise / horizontal distance) a ray may have and still be blocked,
+    // per [bin * rings + ring]; a max over nearer rings once `horizonDirty` clears
+    mutable std::vector<float> horizon;
+    mutable bool horizonDirty = false;
+    mutable Stats stats;
+
+    void resetHorizon();
+    void resolveHorizon() const;
+    // Azimuth span of a footprint in bin units; false if the eye is inside it
+    bool azimuthSpan(float minX, float minZ, float maxX, float maxZ, float& first, float& last) const;
+    void horizontalRange(float minX, float minZ, float maxX, float maxZ, float& nearDist, float& farDist) const;
+};
+
+} // namespace ethereal
@@ -0,0 +1,45 @@
+#include "BitStream.hpp"
+
+namespace ethereal {
+
+void BitWriter::writeBits(uint32_t value, int bits) {
+    if (bits <= 0) return;
+    if (bits < 32) value &= (1u << bits) - 1u;
+
+    while (bits > 0) {
+        size_t bitOffset = bitCount & 7;
+        if (bitOffset == 0) data.push_back(0);
+        int chunk = static_cast<int>(8 - bitOffset);
+        if (chunk > bits) chunk = bits;
+
+        data.back() |= static_cast<uint8_t>((value & ((1u << chunk) - 1u)) << bitOffset);
+        value >>= chunk;
+        bits -= chunk;
+        bitCount += static_cast<size_t>(chunk);
+    }
+}
+
+uint32_t BitReader::readBits(int bits) {
+    if (bits <= 0) return 0;
+    if (bitPosition + static_cast<size_t>(bits) > bitSize) {
+        overflowed = true;
+        bitPosition = bitSize;
+        return 0;
+    }
+
+    uint32_t value = 0;
+    int written = 0;
+    while (written < bits) {
+        size_t bitOffset = bitPosition & 7;
+        int chunk = static_cast<int>(8 - bitOffset);
+        if (chunk > bits - written) chunk = bits - written;
+
+        uint32_t byte = data[bitPosition >> 3];
+        value |= ((byte >> bitOffset) & ((1u << chunk) - 1u)) << written;
+        written += chunk;
+        bitPosition += static_cast<size_t>(chunk);
+    }
+    return value;
+}
+
+} // namespace ethereal
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ethereal {
+
+// Packs values of any width from 1 to 32 bits, lowest bit first, into bytes.
+// The bytes are little-endian independent of the host, so both ends of a
+// connection read the same layout.
+class BitWriter {
+public:
+    void writeBits(uint32_t value, int bits);
+    void writeBool(bool value) { writeBits(value ? 1u : 0u, 1); }
+    // Zigzag-coded, so small magnitudes of either sign need few bits
+    void writeSigned(int32_t value, int bits) { writeBits(zigzag(value), bits); }
+
+    // Payload rounded up to whole bytes
+    const std::vector<uint8_t>& getData() const { return data; }
+    size_t getBitCount() const { return bitCount; }
+    size_t getByteCount() const { return data.size(); }
+    void clear() { data.clear(); bitCount = 0; }
+
+    // 0, -1, 1, -2, ... -> 0, 1, 2, 3, ...
+    static uint32_t zigzag(int32_t value) {
+        return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+    }
+    static int32_t unzigzag(uint32_t value) {
+        return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+    }
+
+private:
+    std::vector<uint8_t> data;
+    size_t bitCount = 0;
+};
+
+// Reads a BitWriter payload back. Reading past the end returns zeros and marks
+// the reader overflowed; callers check isOk() once after a whole message.
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t size) : data(data), bitSize(size * 8) {}
+
+    uint32_t readBits(int bits);
+    bool readBool() { return readBits(1) != 0; }
+    int32_t readSigned(int bits) { return BitWriter::unzigzag(readBits(bits)); }
+
+    bool isOk() const { return !overflowed; }
+    size_t getBitPosition() const { return bitPosition; }
+    size_t getBitsRemaining() const { return bitSize - bitPosition; }
+
+private:
+    const uint8_t* data;
+    size_t bitSize;
+    size_t bitPosition = 0;
+    bool overflowed = false;
+};
+
+} // namespace ethereal
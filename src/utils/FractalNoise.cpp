@@ -0,0 +1,41 @@
+#include "FractalNoise.hpp"
+
+namespace ethereal {
+
+namespace {
+
+template <typename Generator>
+constexpr FractalKernels makeKernels() {
+    return {
+        &Generator::sample,
+        &Generator::sample,
+        &Generator::sample,
+        &Generator::batch,
+        &Generator::batch,
+        &Generator::batch
+    };
+}
+
+template <typename Shape, int... I>
+constexpr std::array<FractalKernels, sizeof...(I)> makeRow(std::integer_sequence<int, I...>) {
+    return {{ makeKernels<FractalNoise<Shape, I + 1>>()... }};
+}
+
+using OctaveCounts = std::make_integer_sequence<int, kMaxFractalOctaves>;
+
+// Indexed by FractalType, then octaves - 1
+const std::array<FractalKernels, kMaxFractalOctaves> kKernels[] = {
+    makeRow<fractal::Plain>(OctaveCounts{}),
+    makeRow<fractal::Ridge>(OctaveCounts{}),
+    makeRow<fractal::Billow>(OctaveCounts{}),
+};
+
+} // namespace
+
+const FractalKernels& selectFractal(FractalType type, int octaves) {
+    size_t row = static_cast<size_t>(type);
+    if (row >= sizeof(kKernels) / sizeof(kKernels[0])) row = 0;
+    return kKernels[row][std::clamp(octaves, 1, kMaxFractalOctaves) - 1];
+}
+
+} // namespace ethereal
@@ -0,0 +1,250 @@
+#pragma once
+#include "utils/PerlinNoise.hpp"
+#include "core/Vector3D.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ratio>
+#include <type_traits>
+#include <utility>
+
+namespace ethereal {
+
+enum class FractalType : uint8_t {
+    Fbm,        // Plain octave sum, same values as PerlinNoise::octaveNoise
+    Ridged,     // Sharp crests where each octave crosses zero
+    Billow      // Rounded, cloud-like bumps
+};
+
+namespace fractal {
+
+// Per-octave shapes map a noise value in [-1, 1] back into [-1, 1];
+// slope() is d(apply)/dn, for the chain rule in the gradient variants
+struct Plain {
+    static float apply(float n) { return n; }
+    static float slope(float) { return 1.0f; }
+};
+
+struct Ridge {
+    static float apply(float n) { float r = 1.0f - std::abs(n); return 2.0f * r * r - 1.0f; }
+    static float slope(float n) { return std::copysign(4.0f * (1.0f - std::abs(n)), -n); }
+};
+
+struct Billow {
+    static float apply(float n) { return 2.0f * std::abs(n) - 1.0f; }
+    static float slope(float n) { return std::copysign(2.0f, n); }
+};
+
+// Frequencies, amplitudes and their sum, accumulated in the same float order as
+// the runtime loop so Plain sums are bit-identical to octaveNoise
+template <int Octaves, int Lacunarity, typename Persistence>
+struct OctaveTable {
+    static constexpr float kPersistence = static_cast<float>(Persistence::num) / static_cast<float>(Persistence::den);
+
+    static constexpr std::array<float, Octaves> makeFrequencies() {
+        std::array<float, Octaves> out{};
+        float frequency = 1.0f;
+        for (int i = 0; i < Octaves; ++i) { out[i] = frequency; frequency *= static_cast<float>(Lacunarity); }
+        return out;
+    }
+    static constexpr std::array<float, Octaves> makeAmplitudes() {
+        std::array<float, Octaves> out{};
+        float amplitude = 1.0f;
+        for (int i = 0; i < Octaves; ++i) { out[i] = amplitude; amplitude *= kPersistence; }
+        return out;
+    }
+    static constexpr float makeNorm() {
+        float sum = 0.0f;
+        for (float amplitude : makeAmplitudes()) sum += amplitude;
+        return sum;
+    }
+    static constexpr std::array<float, Octaves> makeGradientScales() {
+        std::array<float, Octaves> out{};
+        for (int i = 0; i < Octaves; ++i) out[i] = makeAmplitudes()[i] * makeFrequencies()[i];
+        return out;
+    }
+
+    static constexpr std::array<float, Octaves> kFrequency = makeFrequencies();
+    static constexpr std::array<float, Octaves> kAmplitude = makeAmplitudes();
+    static constexpr std::array<float, Octaves> kGradientScale = makeGradientScales();
+    static constexpr float kNorm = makeNorm();
+};
+
+} // namespace fractal
+
+// Octave noise with the octave count, lacunarity and persistence fixed at compile
+// time: the loop is unrolled and every frequency/amplitude is a constant, so each
+// octave is one noise call and a multiply-add. Values are normalized to [-1, 1]
+// by the amplitude sum, like PerlinNoise::octaveNoise.
+template <typename Shape, int Octaves, int Lacunarity = 2, typename Persistence = std::ratio<1, 2>>
+struct FractalNoise {
+    static_assert(Octaves >= 1, "at least one octave");
+    static_assert(Lacunarity >= 1, "lacunarity must be a positive integer");
+
+    using Table = fractal::OctaveTable<Octaves, Lacunarity, Persistence>;
+    using Octave = std::make_integer_sequence<int, Octaves>;
+
+    static float sample(const PerlinNoise& noise, float x, float y) {
+        return accumulate(Octave{}, [&](float f) { return noise.noise(x * f, y * f); }) / Table::kNorm;
+    }
+
+    static float sample(const PerlinNoise& noise, float x, float y, float z) {
+        return accumulate(Octave{}, [&](float f) { return noise.noise(x * f, y * f, z * f); }) / Table::kNorm;
+    }
+
+    static float sample(const PerlinNoise& noise, float x, float y, float z, Vector3D& gradient) {
+        return accumulateGradient(noise, x, y, z, gradient, Octave{});
+    }
+
+    // === Batch evaluation ===
+    // Same values as the scalar calls, through the SSE2 batch noise
+    static void batch(const PerlinNoise& noise, const float* xs, const float* ys, float* out, size_t n) {
+        float sx[kBlockSize], sy[kBlockSize], values[kBlockSize];
+        for (size_t begin = 0; begin < n; begin += kBlockSize) {
+            const size_t count = std::min(kBlockSize, n - begin);
+            float* total = out + begin;
+            std::fill(total, total + count, 0.0f);
+            forEachOctave(Octave{}, [&](float f, float a) {
+                for (size_t k = 0; k < count; ++k) {
+                    sx[k] = xs[begin + k] * f;
+                    sy[k] = ys[begin + k] * f;
+                }
+                noise.noise2(sx, sy, values, count);
+                for (size_t k = 0; k < count; ++k) total[k] += Shape::apply(values[k]) * a;
+            });
+            for (size_t k = 0; k < count; ++k) total[k] /= Table::kNorm;
+        }
+    }
+
+    static void batch(const PerlinNoise& noise, const float* xs, const float* ys, const float* zs,
+                      float* out, size_t n) {
+        float sx[kBlockSize], sy[kBlockSize], sz[kBlockSize], values[kBlockSize];
+        for (size_t begin = 0; begin < n; begin += kBlockSize) {
+            const size_t count = std::min(kBlockSize, n - begin);
+            float* total = out + begin;
+            std::fill(total, total + count, 0.0f);
+            forEachOctave(Octave{}, [&](float f, float a) {
+                for (size_t k = 0; k < count; ++k) {
+                    sx[k] = xs[begin + k] * f;
+                    sy[k] = ys[begin + k] * f;
+                    sz[k] = zs[begin + k] * f;
+                }
+                noise.noise3(sx, sy, sz, values, count);
+                for (size_t k = 0; k < count; ++k) total[k] += Shape::apply(values[k]) * a;
+            });
+            for (size_t k = 0; k < count; ++k) total[k] /= Table::kNorm;
+        }
+    }
+
+    // Batch value + gradient (gx, gy, gz may not alias the inputs)
+    static void batch(const PerlinNoise& noise, const float* xs, const float* ys, const float* zs,
+                      float* out, float* gx, float* gy, float* gz, size_t n) {
+        float sx[kBlockSize], sy[kBlockSize], sz[kBlockSize];
+        float values[kBlockSize], sgx[kBlockSize], sgy[kBlockSize], sgz[kBlockSize];
+        for (size_t begin = 0; begin < n; begin += kBlockSize) {
+            const size_t count = std::min(kBlockSize, n - begin);
+            float* total = out + begin;
+            float* tx = gx + begin;
+            float* ty = gy + begin;
+            float* tz = gz + begin;
+            std::fill(total, total + count, 0.0f);
+            std::fill(tx, tx + count, 0.0f);
+            std::fill(ty, ty + count, 0.0f);
+            std::fill(tz, tz + count, 0.0f);
+            forEachOctave(Octave{}, [&](float f, float a, float gradientScale) {
+                for (size_t k = 0; k < count; ++k) {
+                    sx[k] = xs[begin + k] * f;
+                    sy[k] = ys[begin + k] * f;
+                    sz[k] = zs[begin + k] * f;
+                }
+                noise.noise3(sx, sy, sz, values, sgx, sgy, sgz, count);
+                for (size_t k = 0; k < count; ++k) {
+                    float s = Shape::slope(values[k]) * gradientScale;
+                    total[k] += Shape::apply(values[k]) * a;
+                    tx[k] += sgx[k] * s;
+                    ty[k] += sgy[k] * s;
+                    tz[k] += sgz[k] * s;
+                }
+            });
+            for (size_t k = 0; k < count; ++k) {
+                total[k] /= Table::kNorm;
+                tx[k] /= Table::kNorm;
+                ty[k] /= Table::kNorm;
+                tz[k] /= Table::kNorm;
+            }
+        }
+    }
+
+private:
+    static constexpr size_t kBlockSize = 64;
+
+    template <int... I, typename Fn>
+    static float accumulate(std::integer_sequence<int, I...>, const Fn& octave) {
+        float total = 0.0f;
+        ((total += Shape::apply(octave(Table::kFrequency[I])) * Table::kAmplitude[I]), ...);
+        return total;
+    }
+
+    template <int... I>
+    static float accumulateGradient(const PerlinNoise& noise, float x, float y, float z, Vector3D& gradient,
+                                    std::integer_sequence<int, I...>) {
+        float total = 0.0f;
+        Vector3D gradientSum = Vector3D::zero();
+        auto octave = [&](float f, float a, float gradientScale) {
+            Vector3D g;
+            float n = noise.noise(x * f, y * f, z * f, g);
+            total += Shape::apply(n) * a;
+            gradientSum += g * (Shape::slope(n) * gradientScale);
+        };
+        (octave(Table::kFrequency[I], Table::kAmplitude[I], Table::kGradientScale[I]), ...);
+        gradient = gradientSum / Table::kNorm;
+        return total / Table::kNorm;
+    }
+
+    template <int... I, typename Fn>
+    static void forEachOctave(std::integer_sequence<int, I...>, const Fn& octave) {
+        if constexpr (std::is_invocable_v<Fn, float, float, float>) {
+            (octave(Table::kFrequency[I], Table::kAmplitude[I], Table::kGradientScale[I]), ...);
+        } else {
+            (octave(Table::kFrequency[I], Table::kAmplitude[I]), ...);
+        }
+    }
+};
+
+template <int Octaves, int Lacunarity = 2, typename Persistence = std::ratio<1, 2>>
+using Fbm = FractalNoise<fractal::Plain, Octaves, Lacunarity, Persistence>;
+
+template <int Octaves, int Lacunarity = 2, typename Persistence = std::ratio<1, 2>>
+using Ridged = FractalNoise<fractal::Ridge, Octaves, Lacunarity, Persistence>;
+
+template <int Octaves, int Lacunarity = 2, typename Persistence = std::ratio<1, 2>>
+using Billow = FractalNoise<fractal::Billow, Octaves, Lacunarity, Persistence>;
+
+// === Runtime selection ===
+// One instantiation per type and octave count (lacunarity 2, persistence 1/2),
+// for octave counts that come from a config
+using FractalSample2 = float (*)(const PerlinNoise&, float, float);
+using FractalSample3 = float (*)(const PerlinNoise&, float, float, float);
+using FractalSample3Gradient = float (*)(const PerlinNoise&, float, float, float, Vector3D&);
+using FractalBatch2 = void (*)(const PerlinNoise&, const float*, const float*, float*, size_t);
+using FractalBatch3 = void (*)(const PerlinNoise&, const float*, const float*, const float*, float*, size_t);
+using FractalBatch3Gradient = void (*)(const PerlinNoise&, const float*, const float*, const float*, float*,
+                                       float*, float*, float*, size_t);
+
+struct FractalKernels {
+    FractalSample2 sample2;
+    FractalSample3 sample3;
+    FractalSample3Gradient sample3Gradient;
+    FractalBatch2 batch2;
+    FractalBatch3 batch3;
+    FractalBatch3Gradient batch3Gradient;
+};
+
+constexpr int kMaxFractalOctaves = 8;
+
+// Octaves are clamped to [1, kMaxFractalOctaves]
+const FractalKernels& selectFractal(FractalType type, int octaves);
+
+} // namespace ethereal
@@ -0,0 +1,75 @@
+#include "FrameArena.hpp"
+#include <algorithm>
+
+namespace ethereal {
+
+namespace {
+
+thread_local FrameArena* currentArena = nullptr;
+
+uintptr_t alignUp(uintptr_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+FrameArena::FrameArena(size_t initialBytes) {
+    addBlock(std::max<size_t>(initialBytes, 4096));
+}
+
+void FrameArena::addBlock(size_t minimumBytes) {
+    Block block;
+    block.size = minimumBytes;
+    block.data.reset(new unsigned char[minimumBytes]);
+    blocks.push_back(std::move(block));
+}
+
+void* FrameArena::allocate(size_t bytes, size_t alignment) {
+    bytes = std::max<size_t>(bytes, 1);
+    Block* block = &blocks.back();
+    auto alignedOffset = [alignment](const Block& b) {
+        uintptr_t base = reinterpret_cast<uintptr_t>(b.data.get());
+        return alignUp(base + b.offset, alignment) - base;
+    };
+    size_t offset = alignedOffset(*block);
+    if (offset + bytes > block->size) {
+        overflows++;
+        addBlock(std::max(block->size * 2, bytes + alignment));
+        block = &blocks.back();
+        offset = alignedOffset(*block);
+    }
+    block->offset = offset + bytes;
+    used += bytes;
+    peak = std::max(peak, used);
+    return block->data.get() + offset;
+}
+
+void FrameArena::reset() {
+    if (blocks.size() > 1) {
+        // The frame overflowed: replace the chain with one block that holds it all
+        size_t total = getCapacity();
+        blocks.clear();
+        addBlock(total);
+    }
+    blocks.back().offset = 0;
+    used = 0;
+    overflows = 0;
+}
+
+size_t FrameArena::getCapacity() const {
+    size_t total = 0;
+    for (const Block& block : blocks) total += block.size;
+    return total;
+}
+
+FrameArena* FrameArena::setThreadArena(FrameArena* arena) {
+    FrameArena* previous = currentArena;
+    currentArena = arena;
+    return previous;
+}
+
+FrameArena* FrameArena::threadArena() {
+    return currentArena;
+}
+
+} // namespace ethereal
@@ -0,0 +1,111 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ethereal {
+
+// Bump allocator for memory that lives at most one frame. allocate() only moves
+// a cursor; nothing is freed until reset(), which rewinds everything at once.
+// Overflow chains an extra block from the heap, and the next reset() folds all
+// blocks into one sized for the high-water mark, so a frame that fits once keeps
+// fitting without touching the heap again. Not thread-safe: one arena per thread.
+class FrameArena {
+public:
+    explicit FrameArena(size_t initialBytes = 256 * 1024);
+    ~FrameArena() = default;
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+    // Invalidates every pointer handed out since the last reset
+    void reset();
+
+    // Trivially destructible types only; the arena never runs destructors
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        static_assert(std::is_trivially_destructible<T>::value, "arena objects are never destroyed");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    size_t getUsedBytes() const { return used; }
+    size_t getPeakBytes() const { return peak; }
+    size_t getCapacity() const;
+    // Allocations that missed the first block since the last reset
+    uint32_t getOverflowCount() const { return overflows; }
+
+    // Arena that ArenaAllocator falls back to on the calling thread; may be null
+    static FrameArena* setThreadArena(FrameArena* arena);
+    static FrameArena* threadArena();
+
+private:
+    struct Block {
+        std::unique_ptr<unsigned char[]> data;
+        size_t size = 0;
+        size_t offset = 0;
+    };
+
+    std::vector<Block> blocks;
+    size_t used = 0;
+    size_t peak = 0;
+    uint32_t overflows = 0;
+
+    void addBlock(size_t minimumBytes);
+};
+
+// Installs an arena for this thread's ArenaAllocators for the enclosing block
+class FrameArenaScope {
+public:
+    explicit FrameArenaScope(FrameArena* arena) : previous(FrameArena::setThreadArena(arena)) {}
+    ~FrameArenaScope() { FrameArena::setThreadArena(previous); }
+
+    FrameArenaScope(const FrameArenaScope&) = delete;
+    FrameArenaScope& operator=(const FrameArenaScope&) = delete;
+
+private:
+    FrameArena* previous;
+};
+
+// STL allocator over a FrameArena. deallocate() is a no-op; the memory comes back
+// at the arena's reset. Without an arena (none passed, none installed on the
+// thread) it behaves like std::allocator, so shared code works off the main thread.
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator() noexcept : arena(FrameArena::threadArena()) {}
+    explicit ArenaAllocator(FrameArena* arena) noexcept : arena(arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.getArena()) {}
+
+    T* allocate(size_t count) {
+        if (arena) return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T)));
+        return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, size_t) noexcept {
+        if (!arena) ::operator delete(pointer);
+    }
+
+    FrameArena* getArena() const noexcept { return arena; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena == other.getArena(); }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return arena != other.getArena(); }
+
+private:
+    FrameArena* arena;
+};
+
+// Scratch vector for one frame's work; must not outlive the arena's next reset
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace ethereal
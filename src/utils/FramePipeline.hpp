@@ -0,0 +1,79 @@
+#pragma once
+#include "utils/FrameArena.hpp"
+#include "utils/JobSystem.hpp"
+#include <array>
+#include <type_traits>
+#include <utility>
+
+namespace ethereal {
+
+// Overlaps the simulation of frame N+1 with the rendering of frame N. There are
+// two snapshot slots: a job fills back() on a worker while the main thread draws
+// from front(), and sync() joins the job and swaps the slots. Between sync() and
+// launch() nothing is in flight, so the main thread may touch the simulation.
+// Without workers launch() runs inline and the frame degrades to serial order.
+template <typename Snapshot>
+class FramePipeline {
+public:
+    explicit FramePipeline(JobSystem* jobs) : jobs(jobs) {}
+    ~FramePipeline() { join(); }
+
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    // Main thread. Waits for the launched simulation and publishes its snapshot.
+    void sync() {
+        join();
+        if (launched) {
+            frontIndex ^= 1;
+            launched = false;
+        }
+    }
+
+    // Main thread, after sync(). `job` fills the back snapshot and must not touch
+    // anything the main thread uses until the next sync(). The callable is parked
+    // in the pipeline's own arena, so launching allocates nothing per frame.
+    template <typename Job>
+    void launch(Job&& job) {
+        launched = true;
+        Snapshot& target = slots[frontIndex ^ 1];
+        if (!isPipelined()) {
+            job(target);
+            return;
+        }
+
+        using Stored = std::decay_t<Job>;
+        jobArena.reset();
+        Stored* stored = new (jobArena.allocate(sizeof(Stored), alignof(Stored))) Stored(std::forward<Job>(job));
+        destroyJob = [](void* pointer) { static_cast<Stored*>(pointer)->~Stored(); };
+        jobStorage = stored;
+        jobs->run(inFlight, [stored, &target]() { (*stored)(target); });
+    }
+
+    const Snapshot& front() const { return slots[frontIndex]; }
+    // Seeds both slots, e.g. before the first frame or after a teleport (after sync())
+    void reset(const Snapshot& snapshot) { slots[0] = snapshot; slots[1] = snapshot; }
+
+    bool isPipelined() const { return jobs && jobs->getWorkerCount() > 0; }
+
+private:
+    JobSystem* jobs;
+    JobGroup inFlight;
+    std::array<Snapshot, 2> slots{};
+    unsigned frontIndex = 0;
+    bool launched = false;
+    FrameArena jobArena{4096};
+    void* jobStorage = nullptr;
+    void (*destroyJob)(void*) = nullptr;
+
+    void join() {
+        if (jobs) jobs->wait(inFlight);
+        if (destroyJob) {
+            destroyJob(jobStorage);
+            destroyJob = nullptr;
+            jobStorage = nullptr;
+        }
+    }
+};
+
+} // namespace ethereal
@@ -0,0 +1,105 @@
+#include "InputLog.hpp"
+#include "utils/MappedFile.hpp"
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+namespace ethereal {
+
+namespace {
+
+const uint32_t kLogVersion = 1;
+const size_t kLogHeaderSize = 32;
+const uint8_t kMouseMoved = 1 << 7;     // Button-byte flag: two mouse floats follow
+const size_t kMinFrameBytes = 1 + sizeof(float);    // Buttons and frame time, no mouse
+
+struct LogHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t seed;
+    float stepRate;
+    uint64_t frameCount;
+    uint64_t checksum;
+};
+static_assert(sizeof(LogHeader) == kLogHeaderSize, "input log header layout");
+
+} // namespace
+
+void InputLog::begin(uint32_t newSeed, float newStepRate) {
+    seed = newSeed;
+    stepRate = newStepRate;
+    checksum = 0;
+    frames.clear();
+}
+
+bool InputLog::save(const std::string& path) const {
+    LogHeader header = {};
+    std::memcpy(header.magic, "LREC", 4);
+    header.version = kLogVersion;
+    header.seed = seed;
+    header.stepRate = stepRate;
+    header.frameCount = frames.size();
+    header.checksum = checksum;
+
+    std::vector<unsigned char> data;
+    data.reserve(frames.size() * 13);
+    auto put = [&data](const void* bytes, size_t size) {
+        const unsigned char* p = static_cast<const unsigned char*>(bytes);
+        data.insert(data.end(), p, p + size);
+    };
+    for (const InputFrame& frame : frames) {
+        bool moved = frame.mouseDeltaX != 0.0f || frame.mouseDeltaY != 0.0f;
+        uint8_t buttons = frame.buttons | (moved ? kMouseMoved : 0);
+        put(&buttons, 1);
+        put(&frame.frameTime, sizeof(float));
+        if (moved) {
+            put(&frame.mouseDeltaX, sizeof(float));
+            put(&frame.mouseDeltaY, sizeof(float));
+        }
+    }
+
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) return false;
+    bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1 &&
+              std::fwrite(data.data(), 1, data.size(), out) == data.size();
+    return std::fclose(out) == 0 && ok;
+}
+
+bool InputLog::load(const std::string& path) {
+    MappedFile file;
+    if (!file.open(path) || file.size() < kLogHeaderSize) return false;
+
+    LogHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, "LREC", 4) != 0 || header.version != kLogVersion) return false;
+    // Bound the count by what the file can hold before reserving for it
+    if (header.frameCount > (file.size() - kLogHeaderSize) / kMinFrameBytes) return false;
+
+    const unsigned char* cursor = file.data() + kLogHeaderSize;
+    const unsigned char* end = file.data() + file.size();
+    std::vector<InputFrame> loaded;
+    loaded.reserve(static_cast<size_t>(header.frameCount));
+    for (uint64_t i = 0; i < header.frameCount; ++i) {
+        if (end - cursor < static_cast<std::ptrdiff_t>(kMinFrameBytes)) return false;
+        InputFrame frame;
+        uint8_t buttons = *cursor++;
+        frame.buttons = buttons & ~kMouseMoved;
+        std::memcpy(&frame.frameTime, cursor, sizeof(float));
+        cursor += sizeof(float);
+        if (buttons & kMouseMoved) {
+            if (end - cursor < static_cast<std::ptrdiff_t>(2 * sizeof(float))) return false;
+            std::memcpy(&frame.mouseDeltaX, cursor, sizeof(float));
+            std::memcpy(&frame.mouseDeltaY, cursor + sizeof(float), sizeof(float));
+            cursor += 2 * sizeof(float);
+        }
+        loaded.push_back(frame);
+    }
+
+    seed = header.seed;
+    stepRate = header.stepRate;
+    checksum = header.checksum;
+    frames = std::move(loaded);
+    return true;
+}
+
+} // namespace ethereal
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ethereal {
+
+enum InputButton : uint8_t {
+    InputFlying = 1 << 0,           // Left mouse held
+    InputAscending = 1 << 1,        // Right mouse held
+    InputBoost = 1 << 2,            // Double-click this frame
+    InputReset = 1 << 3,            // Respawn this frame
+    InputToggleWindMap = 1 << 4
+};
+
+// Everything the simulation reads from one rendered frame. The frame time is kept
+// too, so a replay feeds the SimulationClock the same sequence and therefore runs
+// the same fixed steps with the same inputs.
+struct InputFrame {
+    float frameTime = 0.0f;
+    float mouseDeltaX = 0.0f;
+    float mouseDeltaY = 0.0f;
+    uint8_t buttons = 0;            // InputButton bits
+
+    bool has(InputButton button) const { return (buttons & button) != 0; }
+};
+
+// Recorded session: the seed and step rate it ran with, per-frame input, and a
+// checksum of the final simulation state to prove a replay matched bit for bit.
+//
+// File: 32-byte header ("LREC", version, seed, step rate, frame count, checksum),
+// then per frame one button byte, the frame time, and the mouse delta only when
+// the mouse moved (flagged in the button byte), so idle frames cost 5 bytes.
+class InputLog {
+public:
+    void begin(uint32_t seed, float stepRate);
+    void append(const InputFrame& frame) { frames.push_back(frame); }
+    void setChecksum(uint64_t value) { checksum = value; }
+
+    bool save(const std::string& path) const;
+    // Fails on missing files, other formats and truncated frame data
+    bool load(const std::string& path);
+
+    uint32_t getSeed() const { return seed; }
+    float getStepRate() const { return stepRate; }
+    uint64_t getChecksum() const { return checksum; }
+    const std::vector<InputFrame>& getFrames() const { return frames; }
+    size_t size() const { return frames.size(); }
+
+private:
+    uint32_t seed = 0;
+    float stepRate = 60.0f;
+    uint64_t checksum = 0;
+    std::vector<InputFrame> frames;
+};
+
+} // namespace ethereal
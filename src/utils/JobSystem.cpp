@@ -0,0 +1,180 @@
+#include "JobSystem.hpp"
+#include <algorithm>
+
+namespace ethereal {
+
+namespace {
+
+struct WorkerIdentity {
+    const JobSystem* owner = nullptr;
+    unsigned queueIndex = 0;
+};
+
+thread_local WorkerIdentity currentWorker;
+
+} // namespace
+
+JobSystem::JobSystem() : JobSystem(JobSystemConfig{}) {}
+
+JobSystem::JobSystem(const JobSystemConfig& config) {
+    unsigned count = config.workerCount;
+    if (count == 0) {
+        unsigned hardware = std::thread::hardware_concurrency();
+        count = hardware > 1 ? hardware - 1 : 0;
+    }
+
+    queues.reserve(count + 1);
+    for (unsigned i = 0; i <= count; ++i) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    workers.reserve(count);
+    for (unsigned i = 1; i <= count; ++i) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping.store(true);
+    }
+    wakeCondition.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+unsigned JobSystem::currentQueue() const {
+    return currentWorker.owner == this ? currentWorker.queueIndex : 0;
+}
+
+void JobSystem::run(JobGroup& group, std::function<void()> job) {
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+
+    WorkQueue& queue = *queues[currentQueue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.pushBack({std::move(job), &group});
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queuedJobs.fetch_add(1, std::memory_order_release);
+    }
+    wakeCondition.notify_one();
+}
+
+void JobSystem::wait(JobGroup& group) {
+    unsigned queueIndex = currentQueue();
+    while (!group.isDone()) {
+        if (!tryRunOne(queueIndex)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+    if (count == 0) return;
+
+    // A few chunks per thread keeps stealing effective when chunk costs vary
+    size_t targetChunks = static_cast<size_t>(getConcurrency()) * 4;
+    size_t chunkSize = std::max<size_t>(std::max<size_t>(grain, 1), (count + targetChunks - 1) / targetChunks);
+
+    if (chunkSize >= count || workers.empty()) {
+        fn(0, count);
+        return;
+    }
+
+    // Jobs capture two words so std::function keeps them inline instead of on the heap
+    struct Chunks {
+        const std::function<void(size_t, size_t)>& fn;
+        size_t chunkSize;
+        size_t count;
+    };
+    const Chunks chunks{fn, chunkSize, count};
+    const Chunks* shared = &chunks;
+
+    JobGroup group;
+    for (size_t begin = chunkSize; begin < count; begin += chunkSize) {
+        run(group, [shared, begin]() { shared->fn(begin, std::min(shared->count, begin + shared->chunkSize)); });
+    }
+    fn(0, chunkSize);
+    wait(group);
+}
+
+void JobSystem::workerLoop(unsigned queueIndex) {
+    currentWorker.owner = this;
+    currentWorker.queueIndex = queueIndex;
+
+    while (!stopping.load(std::memory_order_acquire)) {
+        if (tryRunOne(queueIndex)) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeCondition.wait(lock, [this]() {
+            return stopping.load() || queuedJobs.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
+
+bool JobSystem::tryRunOne(unsigned queueIndex) {
+    Job job;
+    if (!popLocal(queueIndex, job) && !steal(queueIndex, job)) {
+        return false;
+    }
+    queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+    execute(job);
+    return true;
+}
+
+bool JobSystem::popLocal(unsigned queueIndex, Job& job) {
+    WorkQueue& queue = *queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.count == 0) return false;
+    job = queue.popBack();
+    return true;
+}
+
+bool JobSystem::steal(unsigned thiefIndex, Job& job) {
+    const unsigned count = static_cast<unsigned>(queues.size());
+    for (unsigned offset = 1; offset < count; ++offset) {
+        WorkQueue& victim = *queues[(thiefIndex + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.count == 0) continue;
+        job = victim.popFront();
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::WorkQueue::pushBack(Job&& job) {
+    if (count == ring.size()) {
+        std::vector<Job> grown(std::max<size_t>(16, ring.size() * 2));
+        for (size_t i = 0; i < count; ++i) {
+            grown[i] = std::move(ring[(head + i) % ring.size()]);
+        }
+        ring.swap(grown);
+        head = 0;
+    }
+    ring[(head + count) % ring.size()] = std::move(job);
+    count++;
+}
+
+JobSystem::Job JobSystem::WorkQueue::popBack() {
+    count--;
+    return std::move(ring[(head + count) % ring.size()]);
+}
+
+JobSystem::Job JobSystem::WorkQueue::popFront() {
+    Job job = std::move(ring[head]);
+    head = (head + 1) % ring.size();
+    count--;
+    return job;
+}
+
+void JobSystem::execute(Job& job) {
+    job.fn();
+    job.group->pending.fetch_sub(1, std::memory_order_release);
+}
+
+} // namespace ethereal
@@ -0,0 +1,84 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ethereal {
+
+struct JobSystemConfig {
+    unsigned workerCount = 0;   // 0 = hardware threads - 1
+};
+
+// Tracks a set of submitted jobs so a caller can wait for all of them
+class JobGroup {
+public:
+    bool isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> pending{0};
+};
+
+// Work-stealing thread pool. Each worker owns a deque: it pops its newest job
+// and, when empty, steals the oldest job from another worker. Threads that wait
+// on a group run queued jobs instead of blocking, so nested waits cannot deadlock.
+class JobSystem {
+public:
+    JobSystem();
+    explicit JobSystem(const JobSystemConfig& config);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void run(JobGroup& group, std::function<void()> job);
+    void wait(JobGroup& group);
+
+    // Calls fn(begin, end) over [0, count) in chunks of at least `grain` items and waits
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
+    // Workers plus the calling thread
+    unsigned getConcurrency() const { return static_cast<unsigned>(workers.size()) + 1; }
+    unsigned getWorkerCount() const { return static_cast<unsigned>(workers.size()); }
+
+private:
+    struct Job {
+        std::function<void()> fn;
+        JobGroup* group;
+    };
+
+    // Growable ring; capacity is kept, so steady-state submits never allocate
+    struct WorkQueue {
+        std::mutex mutex;
+        std::vector<Job> ring;
+        size_t head = 0;    // Oldest job
+        size_t count = 0;
+
+        void pushBack(Job&& job);
+        Job popBack();
+        Job popFront();
+    };
+
+    // Queue 0 belongs to external threads, workers own queues 1..N
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeCondition;
+    std::atomic<int> queuedJobs{0};
+    std::atomic<bool> stopping{false};
+
+    void workerLoop(unsigned queueIndex);
+    bool tryRunOne(unsigned queueIndex);
+    bool popLocal(unsigned queueIndex, Job& job);
+    bool steal(unsigned thiefIndex, Job& job);
+    void execute(Job& job);
+    unsigned currentQueue() const;
+};
+
+} // namespace ethereal
@@ -0,0 +1,174 @@
+#include "MemoryTracker.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace ethereal {
+
+namespace {
+
+constexpr size_t kTagCount = static_cast<size_t>(MemoryTag::Count);
+
+struct TagCounters {
+    std::atomic<size_t> liveBytes{0};
+    std::atomic<size_t> peakBytes{0};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> frees{0};
+};
+
+// Constant-initialized, so usable by allocations made before main()
+TagCounters counters[kTagCount];
+std::atomic<uint64_t> totalAllocations{0};
+thread_local MemoryTag threadTag = MemoryTag::Untagged;
+
+} // namespace
+
+bool MemoryTracker::isEnabled() {
+#if defined(LOOM_TRACK_ALLOCATIONS)
+    return true;
+#else
+    return false;
+#endif
+}
+
+MemoryTagStats MemoryTracker::getStats(MemoryTag tag) {
+    const TagCounters& c = counters[static_cast<size_t>(tag)];
+    MemoryTagStats stats;
+    stats.liveBytes = c.liveBytes.load(std::memory_order_relaxed);
+    stats.peakBytes = c.peakBytes.load(std::memory_order_relaxed);
+    stats.allocations = c.allocations.load(std::memory_order_relaxed);
+    stats.frees = c.frees.load(std::memory_order_relaxed);
+    return stats;
+}
+
+MemoryTagStats MemoryTracker::getTotal() {
+    MemoryTagStats total;
+    for (size_t i = 0; i < kTagCount; ++i) {
+        MemoryTagStats stats = getStats(static_cast<MemoryTag>(i));
+        total.liveBytes += stats.liveBytes;
+        total.peakBytes += stats.peakBytes;     // Upper bound: tags peak at different times
+        total.allocations += stats.allocations;
+        total.frees += stats.frees;
+    }
+    return total;
+}
+
+const char* MemoryTracker::getTagName(MemoryTag tag) {
+    switch (tag) {
+        case MemoryTag::Untagged:  return "untagged";
+        case MemoryTag::Physics:   return "physics";
+        case MemoryTag::Terrain:   return "terrain";
+        case MemoryTag::Rendering: return "rendering";
+        case MemoryTag::Audio:     return "audio";
+        default:                   return "?";
+    }
+}
+
+MemoryTag MemoryTracker::setThreadTag(MemoryTag tag) {
+    MemoryTag previous = threadTag;
+    threadTag = tag;
+    return previous;
+}
+
+MemoryTag MemoryTracker::currentThreadTag() {
+    return threadTag;
+}
+
+uint64_t MemoryTracker::getAllocationCount() {
+    return totalAllocations.load(std::memory_order_relaxed);
+}
+
+void MemoryTracker::recordAllocation(MemoryTag tag, size_t bytes) {
+    TagCounters& c = counters[static_cast<size_t>(tag)];
+    size_t live = c.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    size_t peak = c.peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !c.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    c.allocations.fetch_add(1, std::memory_order_relaxed);
+    totalAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MemoryTracker::recordFree(MemoryTag tag, size_t bytes) {
+    TagCounters& c = counters[static_cast<size_t>(tag)];
+    c.liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+    c.frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace ethereal
+
+#if defined(LOOM_TRACK_ALLOCATIONS)
+
+// === Replaced global allocation functions ===
+// Each block carries a header right before the user pointer recording its size,
+// tag and distance back to the malloc'd base, so frees credit the tag that allocated.
+
+namespace {
+
+struct AllocationHeader {
+    size_t size;
+    uint32_t offset;
+    ethereal::MemoryTag tag;
+};
+
+constexpr size_t kHeaderSpace = 16;
+static_assert(sizeof(AllocationHeader) <= kHeaderSpace, "header must fit its reserved space");
+
+void* trackedAlloc(size_t size, size_t alignment) {
+    if (alignment < kHeaderSpace) alignment = kHeaderSpace;
+
+    // Room for the header plus worst-case alignment padding
+    size_t total = size + alignment + kHeaderSpace;
+    char* base = static_cast<char*>(std::malloc(total));
+    if (!base) return nullptr;
+
+    uintptr_t user = reinterpret_cast<uintptr_t>(base) + kHeaderSpace;
+    user = (user + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+
+    auto* header = reinterpret_cast<AllocationHeader*>(user - kHeaderSpace);
+    header->size = size;
+    header->offset = static_cast<uint32_t>(user - reinterpret_cast<uintptr_t>(base));
+    header->tag = ethereal::MemoryTracker::currentThreadTag();
+    ethereal::MemoryTracker::recordAllocation(header->tag, size);
+    return reinterpret_cast<void*>(user);
+}
+
+void trackedFree(void* ptr) {
+    if (!ptr) return;
+    auto* header = reinterpret_cast<AllocationHeader*>(static_cast<char*>(ptr) - kHeaderSpace);
+    ethereal::MemoryTracker::recordFree(header->tag, header->size);
+    std::free(static_cast<char*>(ptr) - header->offset);
+}
+
+void* trackedNew(size_t size, size_t alignment) {
+    for (;;) {
+        if (void* ptr = trackedAlloc(size, alignment)) return ptr;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+} // namespace
+
+void* operator new(size_t size) { return trackedNew(size, alignof(std::max_align_t)); }
+void* operator new[](size_t size) { return trackedNew(size, alignof(std::max_align_t)); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size, alignof(std::max_align_t)); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size, alignof(std::max_align_t)); }
+void* operator new(size_t size, std::align_val_t align) { return trackedNew(size, static_cast<size_t>(align)); }
+void* operator new[](size_t size, std::align_val_t align) { return trackedNew(size, static_cast<size_t>(align)); }
+void* operator new(size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return trackedAlloc(size, static_cast<size_t>(align)); }
+void* operator new[](size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return trackedAlloc(size, static_cast<size_t>(align)); }
+
+void operator delete(void* ptr) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { trackedFree(ptr); }
+
+#endif
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace ethereal {
+
+enum class MemoryTag : uint8_t {
+    Untagged,
+    Physics,
+    Terrain,
+    Rendering,
+    Audio,
+    Count
+};
+
+struct MemoryTagStats {
+    size_t liveBytes = 0;
+    size_t peakBytes = 0;
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+};
+
+// Heap accounting through replaced global operator new/delete. Only active when
+// built with LOOM_TRACK_ALLOCATIONS (CMake option LOOM_MEMORY_TRACKING); otherwise
+// every query reports zero and tag scopes compile away.
+class MemoryTracker {
+public:
+    static bool isEnabled();
+
+    static MemoryTagStats getStats(MemoryTag tag);
+    static MemoryTagStats getTotal();
+    static const char* getTagName(MemoryTag tag);
+
+    // Allocations the calling thread tags with `tag` until restored
+    static MemoryTag setThreadTag(MemoryTag tag);
+
+    // Every-thread allocation count since the process started
+    static uint64_t getAllocationCount();
+
+    // Hooks used by the replaced operators
+    static void recordAllocation(MemoryTag tag, size_t bytes);
+    static void recordFree(MemoryTag tag, size_t bytes);
+    static MemoryTag currentThreadTag();
+};
+
+// Tags heap allocations made by this thread for the enclosing block
+class MemoryTagScope {
+public:
+    explicit MemoryTagScope(MemoryTag tag) : previous(MemoryTracker::setThreadTag(tag)) {}
+    ~MemoryTagScope() { MemoryTracker::setThreadTag(previous); }
+
+    MemoryTagScope(const MemoryTagScope&) = delete;
+    MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+private:
+    MemoryTag previous;
+};
+
+} // namespace ethereal
+
+#if defined(LOOM_TRACK_ALLOCATIONS)
+#define LOOM_MEMORY_CONCAT_INNER(a, b) a##b
+#define LOOM_MEMORY_CONCAT(a, b) LOOM_MEMORY_CONCAT_INNER(a, b)
+#define MEMORY_TAG(tag) ::ethereal::MemoryTagScope LOOM_MEMORY_CONCAT(memoryTag_, __LINE__)(::ethereal::MemoryTag::tag)
+#else
+#define MEMORY_TAG(tag) ((void)0)
+#endif
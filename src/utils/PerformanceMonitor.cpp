@@ -1,33 +1,145 @@
 #include "PerformanceMonitor.hpp"
-#include <numeric>
+#include "utils/FrameArena.hpp"
+#include "utils/Telemetry.hpp"
+#include <algorithm>
+#include <cmath>
 #include <sstream>
 #include <iomanip>
 
 namespace ethereal {
 
-PerformanceMonitor::PerformanceMonitor()
-    : historySize(120)
+// ============================================================================
+// FrameTimeHistogram
+// ============================================================================
+
+int FrameTimeHistogram::bucketIndex(float ms) {
+    uint32_t us = static_cast<uint32_t>(std::clamp(ms * 1000.0f, 0.0f, 4.0e9f));
+    if (us < static_cast<uint32_t>(kSubBuckets)) return static_cast<int>(us);
+
+    // Range r covers [16 << (r-1), 16 << r) in sub-buckets of width 1 << (r-1)
+    int log2 = 0;
+    for (uint32_t v = us; v > 1; v >>= 1) ++log2;
+    int range = log2 - kSubBucketBits + 1;
+    if (range >= kRanges) return kBucketCount - 1;
+
+    int sub = static_cast<int>(us >> (range - 1)) - kSubBuckets;
+    return range * kSubBuckets + sub;
+}
+
+float FrameTimeHistogram::bucketUpperMs(int index) {
+    int range = index / kSubBuckets;
+    int sub = index % kSubBuckets;
+    if (range == 0) return (sub + 1) * 0.001f;
+    return static_cast<float>((kSubBuckets + sub + 1) << (range - 1)) * 0.001f;
+}
+
+void FrameTimeHistogram::add(float ms) {
+    buckets[bucketIndex(ms)]++;
+    count++;
+}
+
+void FrameTimeHistogram::remove(float ms) {
+    uint32_t& bucket = buckets[bucketIndex(ms)];
+    if (bucket > 0) {
+        bucket--;
+        count--;
+    }
+}
+
+void FrameTimeHistogram::clear() {
+    buckets.fill(0);
+    count = 0;
+}
+
+float FrameTimeHistogram::percentileMs(float fraction) const {
+    if (count == 0) return 0.0f;
+
+    uint32_t rank = static_cast<uint32_t>(std::ceil(std::clamp(fraction, 0.0f, 1.0f) * count));
+    rank = std::max<uint32_t>(rank, 1);
+
+    uint32_t seen = 0;
+    for (int i = 0; i < kBucketCount; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) return bucketUpperMs(i);
+    }
+    return bucketUpperMs(kBucketCount - 1);
+}
+
+// ============================================================================
+// PerformanceMonitor
+// ============================================================================
+
+PerformanceMonitor::PerformanceMonitor() : PerformanceMonitor(PerformanceMonitorConfig{}) {}
+
+PerformanceMonitor::PerformanceMonitor(const PerformanceMonitorConfig& cfg)
+    : config(cfg)
+    , frameTimeRing(std::max<size_t>(cfg.historySize, 1), 0.0f)
+    , historyNext(0)
+    , historyCount(0)
+    , historySum(0.0)
     , lastFrameTimeMs(0.0f)
+    , frameIndex(0)
     , estimatedMemory(0)
-    , cachedAverageFrameTime(0.0f)
-    , averageDirty(true) {}
+    , frameStartAllocations(0)
+    , lastFrameAllocations(0)
+    , hitchCount(0)
+    , cachedMaxFrameTime(0.0f)
+    , maxDirty(true) {}
 
 void PerformanceMonitor::beginFrame() {
     frameStart = std::chrono::high_resolution_clock::now();
+    frameWaitMs = 0.0f;
+    if (frameArena) frameArena->reset();
+    frameStartAllocations = MemoryTracker::getAllocationCount();
 }
 
 void PerformanceMonitor::endFrame() {
     frameEnd = std::chrono::high_resolution_clock::now();
-    
+
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(frameEnd - frameStart);
     lastFrameTimeMs = duration.count() / 1000.0f;
-    
-    frameTimeHistory.push_back(lastFrameTimeMs);
-    while (frameTimeHistory.size() > historySize) {
-        frameTimeHistory.pop_front();
+    lastBusyTimeMs = std::max(0.0f, lastFrameTimeMs - frameWaitMs);
+    lastFrameAllocations = MemoryTracker::getAllocationCount() - frameStartAllocations;
+
+    // Judge against the history before this frame joins it
+    bool hitch = isHitch(lastFrameTimeMs);
+
+    if (historyCount == frameTimeRing.size()) {
+        float oldest = frameTimeRing[historyNext];
+        historySum -= oldest;
+        histogram.remove(oldest);
+    } else {
+        historyCount++;
+    }
+    frameTimeRing[historyNext] = lastFrameTimeMs;
+    historyNext = (historyNext + 1) % frameTimeRing.size();
+    historySum += lastFrameTimeMs;
+    histogram.add(lastFrameTimeMs);
+    maxDirty = true;
+
+#if !defined(LOOM_DISABLE_PROFILER)
+    Profiler::instance().endFrame();
+#endif
+
+    if (hitch) {
+        recordHitch();
     }
-    
-    averageDirty = true;
+    TELEMETRY_COUNT("frame.count", 1);
+    TELEMETRY_COUNT("frame.allocations", lastFrameAllocations);
+    TELEMETRY_GAUGE("frame.ms", lastFrameTimeMs);
+    TELEMETRY_PEAK("frame.peakMs", lastFrameTimeMs);
+    TELEMETRY_GAUGE("frame.busyMs", lastBusyTimeMs);
+    frameIndex++;
+}
+
+void PerformanceMonitor::beginWait() {
+    waitStart = std::chrono::high_resolution_clock::now();
+}
+
+void PerformanceMonitor::endWait() {
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - waitStart);
+    frameWaitMs += duration.count() / 1000.0f;
 }
 
 float PerformanceMonitor::getFrameTimeMs() const {
@@ -35,12 +147,8 @@ float PerformanceMonitor::getFrameTimeMs() const {
 }
 
 float PerformanceMonitor::getAverageFrameTimeMs() const {
-    if (averageDirty && !frameTimeHistory.empty()) {
-        cachedAverageFrameTime = std::accumulate(frameTimeHistory.begin(), frameTimeHistory.end(), 0.0f) 
-                                 / frameTimeHistory.size();
-        averageDirty = false;
-    }
-    return cachedAverageFrameTime;
+    if (historyCount == 0) return 0.0f;
+    return static_cast<float>(historySum / historyCount);
 }
 
 float PerformanceMonitor::getFPS() const {
@@ -58,8 +166,54 @@ float PerformanceMonitor::getAverageFPS() const {
     return 0.0f;
 }
 
+float PerformanceMonitor::getPercentileMs(float fraction) const {
+    return histogram.percentileMs(fraction);
+}
+
+float PerformanceMonitor::getMaxFrameTimeMs() const {
+    if (maxDirty) {
+        cachedMaxFrameTime = 0.0f;
+        for (size_t i = 0; i < historyCount; ++i) {
+            cachedMaxFrameTime = std::max(cachedMaxFrameTime, frameTimeRing[i]);
+        }
+        maxDirty = false;
+    }
+    return cachedMaxFrameTime;
+}
+
+float PerformanceMonitor::getHistoryFrameMs(size_t index) const {
+    if (index >= historyCount) return 0.0f;
+    size_t oldest = historyCount == frameTimeRing.size() ? historyNext : 0;
+    return frameTimeRing[(oldest + index) % frameTimeRing.size()];
+}
+
+bool PerformanceMonitor::isHitch(float frameMs) const {
+    if (frameMs > config.hitchThresholdMs) return true;
+    // Relative test needs enough history for a stable median
+    if (historyCount < 30) return false;
+    return frameMs > histogram.percentileMs(0.5f) * config.hitchMedianFactor;
+}
+
+void PerformanceMonitor::recordHitch() {
+    hitchCount++;
+    if (config.maxHitchReports == 0) return;
+
+    FrameHitch report;
+    report.frameIndex = frameIndex;
+    report.frameMs = lastFrameTimeMs;
+    for (const auto& scope : getScopeStats()) {
+        if (scope.lastMs <= 0.0f) continue;
+        report.scopes.push_back({scope.name, scope.depth, scope.lastMs});
+    }
+
+    hitches.push_back(std::move(report));
+    while (hitches.size() > config.maxHitchReports) {
+        hitches.pop_front();
+    }
+}
+
 size_t PerformanceMonitor::getEstimatedMemoryUsage() const {
-    return estimatedMemory;
+    return MemoryTracker::getTotal().liveBytes + estimatedMemory;
 }
 
 void PerformanceMonitor::addMemoryAllocation(size_t bytes) {
@@ -77,16 +231,75 @@ std::string PerformanceMonitor::getStatsString() const {
     ss << std::fixed << std::setprecision(2);
     ss << "Frame: " << getFrameTimeMs() << "ms | ";
     ss << "Avg: " << getAverageFrameTimeMs() << "ms | ";
+    ss << "p99: " << getPercentileMs(0.99f) << "ms | ";
     ss << "FPS: " << static_cast<int>(getAverageFPS()) << " | ";
-    ss << "Mem: " << (estimatedMemory / 1024) << "KB";
+    ss << "Mem: " << (getEstimatedMemoryUsage() / 1024) << "KB";
+    if (MemoryTracker::isEnabled()) {
+        ss << " | Allocs: " << lastFrameAllocations;
+    }
+    return ss.str();
+}
+
+std::string PerformanceMonitor::getMemoryReport() const {
+    if (!MemoryTracker::isEnabled()) return "Memory tracking disabled (LOOM_MEMORY_TRACKING)\n";
+
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    for (int i = 0; i < static_cast<int>(MemoryTag::Count); ++i) {
+        MemoryTag tag = static_cast<MemoryTag>(i);
+        MemoryTagStats stats = MemoryTracker::getStats(tag);
+        ss << MemoryTracker::getTagName(tag)
+           << "  live " << stats.liveBytes / 1024.0f << "KB"
+           << "  peak " << stats.peakBytes / 1024.0f << "KB"
+           << "  allocs " << stats.allocations << "\n";
+    }
+    ss << "allocations last frame: " << lastFrameAllocations << "\n";
+    if (frameArena) {
+        ss << "frame arena  peak " << frameArena->getPeakBytes() / 1024.0f << "KB"
+           << "  capacity " << frameArena->getCapacity() / 1024.0f << "KB\n";
+    }
+    return ss.str();
+}
+
+std::vector<ProfileScopeStats> PerformanceMonitor::getScopeStats() const {
+#if !defined(LOOM_DISABLE_PROFILER)
+    return Profiler::instance().getScopeStats();
+#else
+    return {};
+#endif
+}
+
+std::string PerformanceMonitor::getProfileReport() const {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    for (const auto& scope : getScopeStats()) {
+        ss << std::string(scope.depth * 2, ' ') << scope.name
+           << "  avg " << scope.avgMs << "  min " << scope.minMs
+           << "  max " << scope.maxMs << "  p99 " << scope.p99Ms << " ms\n";
+    }
     return ss.str();
 }
 
 void PerformanceMonitor::setHistorySize(size_t size) {
-    historySize = size;
-    while (frameTimeHistory.size() > historySize) {
-        frameTimeHistory.pop_front();
+    // Keep the newest frames that still fit
+    size_t capacity = std::max<size_t>(size, 1);
+    size_t keep = std::min(historyCount, capacity);
+    std::vector<float> ring(capacity, 0.0f);
+    for (size_t i = 0; i < keep; ++i) {
+        ring[i] = getHistoryFrameMs(historyCount - keep + i);
+    }
+
+    config.historySize = capacity;
+    frameTimeRing = std::move(ring);
+    historyCount = keep;
+    historyNext = keep % capacity;
+    historySum = 0.0;
+    histogram.clear();
+    for (size_t i = 0; i < keep; ++i) {
+        historySum += frameTimeRing[i];
+        histogram.add(frameTimeRing[i]);
     }
+    maxDirty = true;
 }
 
 } // namespace ethereal
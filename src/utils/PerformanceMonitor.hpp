@@ -1,42 +1,142 @@
 #pragma once
+#include <array>
 #include <chrono>
+#include <cstdint>
 #include <deque>
 #include <string>
+#include <vector>
+#include "utils/MemoryTracker.hpp"
+#include "utils/Profiler.hpp"
 
 namespace ethereal {
 
+class FrameArena;
+
+struct PerformanceMonitorConfig {
+    size_t historySize = 300;           // Frames kept for percentiles and the graph
+    float hitchThresholdMs = 25.0f;     // Frames slower than this are hitches...
+    float hitchMedianFactor = 2.5f;     // ...as are frames this many times the median
+    size_t maxHitchReports = 16;
+};
+
+// Log-linear histogram in microseconds ("HDR" style): each power-of-two range
+// is split into equal sub-buckets, so relative precision is constant
+class FrameTimeHistogram {
+public:
+    void add(float ms);
+    void remove(float ms);
+    void clear();
+
+    // Upper edge of the bucket holding the given fraction (0-1) of samples
+    float percentileMs(float fraction) const;
+    uint32_t getCount() const { return count; }
+
+private:
+    static constexpr int kSubBucketBits = 4;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kRanges = 22;                  // Up to ~30 s
+    static constexpr int kBucketCount = kRanges * kSubBuckets;
+
+    std::array<uint32_t, kBucketCount> buckets{};
+    uint32_t count = 0;
+
+    static int bucketIndex(float ms);
+    static float bucketUpperMs(int index);
+};
+
+// Scope breakdown of one slow frame
+struct FrameHitch {
+    uint64_t frameIndex = 0;
+    float frameMs = 0.0f;
+    struct Scope {
+        std::string name;
+        int depth = 0;
+        float ms = 0.0f;
+    };
+    std::vector<Scope> scopes;
+};
+
 class PerformanceMonitor {
 public:
     PerformanceMonitor();
+    explicit PerformanceMonitor(const PerformanceMonitorConfig& config);
 
+    // beginFrame() also resets the frame arena, if one is set
     void beginFrame();
     void endFrame();
-    
+    // Main-thread scratch arena recycled every frame; not owned, may be null
+    void setFrameArena(FrameArena* arena) { frameArena = arena; }
+
+    // Blocking outside the frame's own work (vsync, the frame limiter) between these
+    // still counts toward the frame time but not toward its busy time
+    void beginWait();
+    void endWait();
+
     float getFrameTimeMs() const;
+    float getBusyTimeMs() const { return lastBusyTimeMs; }
     float getAverageFrameTimeMs() const;
     float getFPS() const;
     float getAverageFPS() const;
-    
+
+    // Over the frame history
+    float getPercentileMs(float fraction) const;
+    float getMaxFrameTimeMs() const;
+
+    // Frame history, 0 = oldest
+    size_t getHistoryCount() const { return historyCount; }
+    float getHistoryFrameMs(size_t index) const;
+    bool isHitch(float frameMs) const;
+
+    const std::deque<FrameHitch>& getHitches() const { return hitches; }
+    uint64_t getHitchCount() const { return hitchCount; }
+
+    // Tracked heap bytes (with LOOM_TRACK_ALLOCATIONS) plus any manual additions
     size_t getEstimatedMemoryUsage() const;
     void addMemoryAllocation(size_t bytes);
     void removeMemoryAllocation(size_t bytes);
     
+    // Heap allocations by every thread between the last beginFrame/endFrame pair
+    uint64_t getFrameAllocations() const { return lastFrameAllocations; }
+    std::string getMemoryReport() const;
+
     std::string getStatsString() const;
-    
+
+    // Scope timings from PROFILE_SCOPE, closed out by endFrame()
+    std::vector<ProfileScopeStats> getScopeStats() const;
+    std::string getProfileReport() const;
+
     void setHistorySize(size_t size);
 
 private:
+    PerformanceMonitorConfig config;
+
     std::chrono::high_resolution_clock::time_point frameStart;
     std::chrono::high_resolution_clock::time_point frameEnd;
-    
-    std::deque<float> frameTimeHistory;
-    size_t historySize;
-    
+    std::chrono::high_resolution_clock::time_point waitStart;
+    float frameWaitMs = 0.0f;
+    float lastBusyTimeMs = 0.0f;
+
+    // Ring of recent frame times with a running sum and matching histogram
+    std::vector<float> frameTimeRing;
+    size_t historyNext;
+    size_t historyCount;
+    double historySum;
+    FrameTimeHistogram histogram;
+
     float lastFrameTimeMs;
+    uint64_t frameIndex;
     size_t estimatedMemory;
-    
-    mutable float cachedAverageFrameTime;
-    mutable bool averageDirty;
+    uint64_t frameStartAllocations;
+    uint64_t lastFrameAllocations;
+    FrameArena* frameArena = nullptr;
+
+    std::deque<FrameHitch> hitches;
+    uint64_t hitchCount;
+
+    mutable float cachedMaxFrameTime;
+    mutable bool maxDirty;
+
+    void recordHitch();
 };
 
 } // namespace ethereal
@@ -1,11 +1,102 @@
 #include "PerlinNoise.hpp"
+#include "core/Simd.hpp"
 #include <algorithm>
 #include <numeric>
 #include <random>
 #include <cmath>
+#include <vector>
 
 namespace ethereal {
 
+namespace {
+
+// Points per stack-allocated block in the batched octave loops
+constexpr size_t kBlockSize = 64;
+
+#if defined(LOOM_SIMD_SSE)
+// floor() for |x| < 2^31, also returning the integer lattice coordinate
+inline __m128 floor4(__m128 x, __m128i& xi) {
+    __m128i t = _mm_cvttps_epi32(x);
+    __m128 tf = _mm_cvtepi32_ps(t);
+    __m128 above = _mm_cmpgt_ps(tf, x);
+    xi = _mm_add_epi32(t, _mm_castps_si128(above));
+    return _mm_sub_ps(tf, _mm_and_ps(above, _mm_set1_ps(1.0f)));
+}
+
+inline __m128 fade4(__m128 t) {
+    __m128 t3 = _mm_mul_ps(_mm_mul_ps(t, t), t);
+    __m128 inner = _mm_add_ps(_mm_mul_ps(t, _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f))),
+                              _mm_set1_ps(10.0f));
+    return _mm_mul_ps(t3, inner);
+}
+
+inline __m128 lerp4(__m128 t, __m128 a, __m128 b) {
+    return _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)));
+}
+
+inline __m128 select4(__m128i mask, __m128 a, __m128 b) {
+    __m128 m = _mm_castsi128_ps(mask);
+    return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+}
+
+// Flip the sign of v where hash bit (31 - Shift) is set
+template <int Shift>
+inline __m128 applySign(__m128i h, __m128 v) {
+    __m128i bit = _mm_and_si128(h, _mm_set1_epi32(1 << (31 - Shift)));
+    return _mm_xor_ps(v, _mm_castsi128_ps(_mm_slli_epi32(bit, Shift)));
+}
+
+inline __m128 grad4(__m128i hash, __m128 x, __m128 y, __m128 z) {
+    __m128i h = _mm_and_si128(hash, _mm_set1_epi32(15));
+    __m128 u = select4(_mm_cmplt_epi32(h, _mm_set1_epi32(8)), x, y);
+    __m128i xPick = _mm_or_si128(_mm_cmpeq_epi32(h, _mm_set1_epi32(12)), _mm_cmpeq_epi32(h, _mm_set1_epi32(14)));
+    __m128 v = select4(_mm_cmplt_epi32(h, _mm_set1_epi32(4)), y, select4(xPick, x, z));
+    return _mm_add_ps(applySign<31>(h, u), applySign<30>(h, v));
+}
+
+inline __m128 grad4(__m128i hash, __m128 x, __m128 y) {
+    __m128i h = _mm_and_si128(hash, _mm_set1_epi32(7));
+    __m128i low = _mm_cmplt_epi32(h, _mm_set1_epi32(4));
+    __m128 u = select4(low, x, y);
+    __m128 v = select4(low, y, x);
+    return _mm_add_ps(applySign<31>(h, u), applySign<30>(h, v));
+}
+
+// Gradient direction of grad4(): each component is -1, 0 or +1
+inline void gradVector4(__m128i hash, __m128& gx, __m128& gy, __m128& gz) {
+    __m128i h = _mm_and_si128(hash, _mm_set1_epi32(15));
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 su = applySign<31>(h, one);
+    __m128 sv = applySign<30>(h, one);
+    __m128i uIsX = _mm_cmplt_epi32(h, _mm_set1_epi32(8));
+    __m128i vIsY = _mm_cmplt_epi32(h, _mm_set1_epi32(4));
+    __m128i xPick = _mm_or_si128(_mm_cmpeq_epi32(h, _mm_set1_epi32(12)), _mm_cmpeq_epi32(h, _mm_set1_epi32(14)));
+    __m128i vIsX = _mm_andnot_si128(vIsY, xPick);
+    __m128i vIsZ = _mm_andnot_si128(_mm_or_si128(vIsY, xPick), _mm_set1_epi32(-1));
+    gx = _mm_add_ps(_mm_and_ps(_mm_castsi128_ps(uIsX), su), _mm_and_ps(_mm_castsi128_ps(vIsX), sv));
+    gy = _mm_add_ps(_mm_andnot_ps(_mm_castsi128_ps(uIsX), su), _mm_and_ps(_mm_castsi128_ps(vIsY), sv));
+    gz = _mm_and_ps(_mm_castsi128_ps(vIsZ), sv);
+}
+
+inline __m128 fadeDerivative4(__m128 t) {
+    __m128 inner = _mm_add_ps(_mm_mul_ps(t, _mm_sub_ps(t, _mm_set1_ps(2.0f))), _mm_set1_ps(1.0f));
+    return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(30.0f), t), t), inner);
+}
+
+// Trilinear blend of eight corner values in lattice order 000,100,010,110,001,101,011,111
+inline __m128 trilerp4(const __m128* c, __m128 u, __m128 v, __m128 w) {
+    return lerp4(w,
+        lerp4(v, lerp4(u, c[0], c[1]), lerp4(u, c[2], c[3])),
+        lerp4(v, lerp4(u, c[4], c[5]), lerp4(u, c[6], c[7])));
+}
+
+inline __m128i loadHash(const int32_t* h) {
+    return _mm_load_si128(reinterpret_cast<const __m128i*>(h));
+}
+#endif
+
+} // namespace
+
 PerlinNoise::PerlinNoise() : PerlinNoise(42) {}
 
 PerlinNoise::PerlinNoise(uint32_t seed) {
@@ -13,7 +104,6 @@ PerlinNoise::PerlinNoise(uint32_t seed) {
 }
 
 void PerlinNoise::reseed(uint32_t seed) {
-    p.resize(512);
     std::iota(p.begin(), p.begin() + 256, 0);
     
     std::default_random_engine engine(seed);
@@ -28,6 +118,10 @@ float PerlinNoise::fade(float t) {
     return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
 }
 
+float PerlinNoise::fadeDerivative(float t) {
+    return 30.0f * t * t * (t * (t - 2.0f) + 1.0f);
+}
+
 float PerlinNoise::lerp(float t, float a, float b) {
     return a + t * (b - a);
 }
@@ -39,6 +133,19 @@ float PerlinNoise::grad(int hash, float x, float y, float z) {
     return ((h & 1) ? -u : u) + ((h & 2) ? -v : v);
 }
 
+void PerlinNoise::gradVector(int hash, float& gx, float& gy, float& gz) {
+    int h = hash & 15;
+    float su = (h & 1) ? -1.0f : 1.0f;
+    float sv = (h & 2) ? -1.0f : 1.0f;
+    gx = 0.0f;
+    gy = 0.0f;
+    gz = 0.0f;
+    if (h < 8) gx = su; else gy = su;
+    if (h < 4) gy = sv;
+    else if (h == 12 || h == 14) gx = sv;
+    else gz = sv;
+}
+
 float PerlinNoise::grad(int hash, float x, float y) {
     int h = hash & 7;
     float u = h < 4 ? x : y;
@@ -137,6 +244,81 @@ float PerlinNoise::octaveNoise(float x, float y, float z, int octaves, float per
     return total / maxValue;
 }
 
+float PerlinNoise::noise(float x, float y, float z, Vector3D& gradient) const {
+    int X = static_cast<int>(std::floor(x)) & 255;
+    int Y = static_cast<int>(std::floor(y)) & 255;
+    int Z = static_cast<int>(std::floor(z)) & 255;
+
+    x -= std::floor(x);
+    y -= std::floor(y);
+    z -= std::floor(z);
+
+    float u = fade(x);
+    float v = fade(y);
+    float w = fade(z);
+
+    int A  = p[X] + Y;
+    int AA = p[A] + Z;
+    int AB = p[A + 1] + Z;
+    int B  = p[X + 1] + Y;
+    int BA = p[B] + Z;
+    int BB = p[B + 1] + Z;
+
+    const int hashes[8] = { p[AA], p[BA], p[AB], p[BB], p[AA + 1], p[BA + 1], p[AB + 1], p[BB + 1] };
+    float c[8];
+    float gx[8], gy[8], gz[8];
+    for (int i = 0; i < 8; ++i) {
+        float cx = (i & 1) ? x - 1 : x;
+        float cy = (i & 2) ? y - 1 : y;
+        float cz = (i & 4) ? z - 1 : z;
+        c[i] = grad(hashes[i], cx, cy, cz);
+        gradVector(hashes[i], gx[i], gy[i], gz[i]);
+    }
+
+    float x00 = lerp(u, c[0], c[1]);
+    float x10 = lerp(u, c[2], c[3]);
+    float x01 = lerp(u, c[4], c[5]);
+    float x11 = lerp(u, c[6], c[7]);
+    float y0 = lerp(v, x00, x10);
+    float y1 = lerp(v, x01, x11);
+
+    // d/dx = blended corner gradients + fade'(x) * d(value)/du, likewise for y and z
+    auto trilerp = [&](const float* k) {
+        return lerp(w, lerp(v, lerp(u, k[0], k[1]), lerp(u, k[2], k[3])),
+                       lerp(v, lerp(u, k[4], k[5]), lerp(u, k[6], k[7])));
+    };
+    float dValueDu = lerp(w, lerp(v, c[1] - c[0], c[3] - c[2]), lerp(v, c[5] - c[4], c[7] - c[6]));
+    float dValueDv = lerp(w, x10 - x00, x11 - x01);
+    float dValueDw = y1 - y0;
+
+    gradient = Vector3D(
+        trilerp(gx) + fadeDerivative(x) * dValueDu,
+        trilerp(gy) + fadeDerivative(y) * dValueDv,
+        trilerp(gz) + fadeDerivative(z) * dValueDw
+    );
+    return lerp(w, y0, y1);
+}
+
+float PerlinNoise::octaveNoise(float x, float y, float z, int octaves, float persistence, Vector3D& gradient) const {
+    float total = 0.0f;
+    float frequency = 1.0f;
+    float amplitude = 1.0f;
+    float maxValue = 0.0f;
+    Vector3D gradientSum = Vector3D::zero();
+
+    for (int i = 0; i < octaves; ++i) {
+        Vector3D g;
+        total += noise(x * frequency, y * frequency, z * frequency, g) * amplitude;
+        gradientSum += g * (amplitude * frequency);
+        maxValue += amplitude;
+        amplitude *= persistence;
+        frequency *= 2.0f;
+    }
+
+    gradient = gradientSum / maxValue;
+    return total / maxValue;
+}
+
 Vector2D PerlinNoise::curl(float x, float y, float epsilon) const {
     float dndx = (noise(x + epsilon, y) - noise(x - epsilon, y)) / (2.0f * epsilon);
     float dndy = (noise(x, y + epsilon) - noise(x, y - epsilon)) / (2.0f * epsilon);
@@ -144,4 +326,311 @@ Vector2D PerlinNoise::curl(float x, float y, float epsilon) const {
     return Vector2D(dndy, -dndx);
 }
 
+void PerlinNoise::noise2(const float* xs, const float* ys, float* out, size_t n) const {
+    size_t i = 0;
+
+#if defined(LOOM_SIMD_SSE)
+    const __m128i mask = _mm_set1_epi32(255);
+    const __m128 one = _mm_set1_ps(1.0f);
+    alignas(16) int32_t X[4], Y[4];
+    alignas(16) int32_t hAA[4], hBA[4], hAB[4], hBB[4];
+
+    for (; i + 4 <= n; i += 4) {
+        __m128 x = _mm_loadu_ps(xs + i);
+        __m128 y = _mm_loadu_ps(ys + i);
+        __m128i xi, yi;
+        x = _mm_sub_ps(x, floor4(x, xi));
+        y = _mm_sub_ps(y, floor4(y, yi));
+        _mm_store_si128(reinterpret_cast<__m128i*>(X), _mm_and_si128(xi, mask));
+        _mm_store_si128(reinterpret_cast<__m128i*>(Y), _mm_and_si128(yi, mask));
+
+        // Hashing stays scalar: four independent table walks per step
+        for (int k = 0; k < 4; ++k) {
+            int A = p[X[k]] + Y[k];
+            int B = p[X[k] + 1] + Y[k];
+            hAA[k] = p[p[A]];
+            hAB[k] = p[p[A + 1]];
+            hBA[k] = p[p[B]];
+            hBB[k] = p[p[B + 1]];
+        }
+
+        __m128 u = fade4(x);
+        __m128 v = fade4(y);
+        __m128 x1 = _mm_sub_ps(x, one);
+        __m128 y1 = _mm_sub_ps(y, one);
+
+        __m128 result = lerp4(v,
+            lerp4(u, grad4(loadHash(hAA), x, y), grad4(loadHash(hBA), x1, y)),
+            lerp4(u, grad4(loadHash(hAB), x, y1), grad4(loadHash(hBB), x1, y1)));
+        _mm_storeu_ps(out + i, result);
+    }
+#endif
+
+    for (; i < n; ++i) {
+        out[i] = noise(xs[i], ys[i]);
+    }
+}
+
+void PerlinNoise::noise3(const float* xs, const float* ys, const float* zs, float* out, size_t n) const {
+    size_t i = 0;
+
+#if defined(LOOM_SIMD_SSE)
+    const __m128i mask = _mm_set1_epi32(255);
+    const __m128 one = _mm_set1_ps(1.0f);
+    alignas(16) int32_t X[4], Y[4], Z[4];
+    alignas(16) int32_t h[8][4];
+
+    for (; i + 4 <= n; i += 4) {
+        __m128 x = _mm_loadu_ps(xs + i);
+        __m128 y = _mm_loadu_ps(ys + i);
+        __m128 z = _mm_loadu_ps(zs + i);
+        __m128i xi, yi, zi;
+        x = _mm_sub_ps(x, floor4(x, xi));
+        y = _mm_sub_ps(y, floor4(y, yi));
+        z = _mm_sub_ps(z, floor4(z, zi));
+        _mm_store_si128(reinterpret_cast<__m128i*>(X), _mm_and_si128(xi, mask));
+        _mm_store_si128(reinterpret_cast<__m128i*>(Y), _mm_and_si128(yi, mask));
+        _mm_store_si128(reinterpret_cast<__m128i*>(Z), _mm_and_si128(zi, mask));
+
+        for (int k = 0; k < 4; ++k) {
+            int A  = p[X[k]] + Y[k];
+            int AA = p[A] + Z[k];
+            int AB = p[A + 1] + Z[k];
+            int B  = p[X[k] + 1] + Y[k];
+            int BA = p[B] + Z[k];
+            int BB = p[B + 1] + Z[k];
+            h[0][k] = p[AA];
+            h[1][k] = p[BA];
+            h[2][k] = p[AB];
+            h[3][k] = p[BB];
+            h[4][k] = p[AA + 1];
+            h[5][k] = p[BA + 1];
+            h[6][k] = p[AB + 1];
+            h[7][k] = p[BB + 1];
+        }
+
+        __m128 u = fade4(x);
+        __m128 v = fade4(y);
+        __m128 w = fade4(z);
+        __m128 x1 = _mm_sub_ps(x, one);
+        __m128 y1 = _mm_sub_ps(y, one);
+        __m128 z1 = _mm_sub_ps(z, one);
+
+        __m128 result = lerp4(w,
+            lerp4(v,
+                lerp4(u, grad4(loadHash(h[0]), x, y, z), grad4(loadHash(h[1]), x1, y, z)),
+                lerp4(u, grad4(loadHash(h[2]), x, y1, z), grad4(loadHash(h[3]), x1, y1, z))),
+            lerp4(v,
+                lerp4(u, grad4(loadHash(h[4]), x, y, z1), grad4(loadHash(h[5]), x1, y, z1)),
+                lerp4(u, grad4(loadHash(h[6]), x, y1, z1), grad4(loadHash(h[7]), x1, y1, z1))));
+        _mm_storeu_ps(out + i, result);
+    }
+#endif
+
+    for (; i < n; ++i) {
+        out[i] = noise(xs[i], ys[i], zs[i]);
+    }
+}
+
+void PerlinNoise::noise3(const float* xs, const float* ys, const float* zs, float* out,
+                         float* gx, float* gy, float* gz, size_t n) const {
+    size_t i = 0;
+
+#if defined(LOOM_SIMD_SSE)
+    const __m128i mask = _mm_set1_epi32(255);
+    const __m128 one = _mm_set1_ps(1.0f);
+    alignas(16) int32_t X[4], Y[4], Z[4];
+    alignas(16) int32_t h[8][4];
+
+    for (; i + 4 <= n; i += 4) {
+        __m128 x = _mm_loadu_ps(xs + i);
+        __m128 y = _mm_loadu_ps(ys + i);
+        __m128 z = _mm_loadu_ps(zs + i);
+        __m128i xi, yi, zi;
+        x = _mm_sub_ps(x, floor4(x, xi));
+        y = _mm_sub_ps(y, floor4(y, yi));
+        z = _mm_sub_ps(z, floor4(z, zi));
+        _mm_store_si128(reinterpret_cast<__m128i*>(X), _mm_and_si128(xi, mask));
+        _mm_store_si128(reinterpret_cast<__m128i*>(Y), _mm_and_si128(yi, mask));
+        _mm_store_si128(reinterpret_cast<__m128i*>(Z), _mm_and_si128(zi, mask));
+
+        for (int k = 0; k < 4; ++k) {
+            int A  = p[X[k]] + Y[k];
+            int AA = p[A] + Z[k];
+            int AB = p[A + 1] + Z[k];
+            int B  = p[X[k] + 1] + Y[k];
+            int BA = p[B] + Z[k];
+            int BB = p[B + 1] + Z[k];
+            h[0][k] = p[AA];
+            h[1][k] = p[BA];
+            h[2][k] = p[AB];
+            h[3][k] = p[BB];
+            h[4][k] = p[AA + 1];
+            h[5][k] = p[BA + 1];
+            h[6][k] = p[AB + 1];
+            h[7][k] = p[BB + 1];
+        }
+
+        __m128 x1 = _mm_sub_ps(x, one);
+        __m128 y1 = _mm_sub_ps(y, one);
+        __m128 z1 = _mm_sub_ps(z, one);
+
+        __m128 c[8], cgx[8], cgy[8], cgz[8];
+        for (int k = 0; k < 8; ++k) {
+            __m128i hash = loadHash(h[k]);
+            c[k] = grad4(hash, (k & 1) ? x1 : x, (k & 2) ? y1 : y, (k & 4) ? z1 : z);
+            gradVector4(hash, cgx[k], cgy[k], cgz[k]);
+        }
+
+        __m128 u = fade4(x);
+        __m128 v = fade4(y);
+        __m128 w = fade4(z);
+        __m128 x00 = lerp4(u, c[0], c[1]);
+        __m128 x10 = lerp4(u, c[2], c[3]);
+        __m128 x01 = lerp4(u, c[4], c[5]);
+        __m128 x11 = lerp4(u, c[6], c[7]);
+        __m128 y0 = lerp4(v, x00, x10);
+        __m128 y1v = lerp4(v, x01, x11);
+
+        __m128 dValueDu = lerp4(w,
+            lerp4(v, _mm_sub_ps(c[1], c[0]), _mm_sub_ps(c[3], c[2])),
+            lerp4(v, _mm_sub_ps(c[5], c[4]), _mm_sub_ps(c[7], c[6])));
+        __m128 dValueDv = lerp4(w, _mm_sub_ps(x10, x00), _mm_sub_ps(x11, x01));
+        __m128 dValueDw = _mm_sub_ps(y1v, y0);
+
+        _mm_storeu_ps(out + i, lerp4(w, y0, y1v));
+        _mm_storeu_ps(gx + i, _mm_add_ps(trilerp4(cgx, u, v, w), _mm_mul_ps(fadeDerivative4(x), dValueDu)));
+        _mm_storeu_ps(gy + i, _mm_add_ps(trilerp4(cgy, u, v, w), _mm_mul_ps(fadeDerivative4(y), dValueDv)));
+        _mm_storeu_ps(gz + i, _mm_add_ps(trilerp4(cgz, u, v, w), _mm_mul_ps(fadeDerivative4(z), dValueDw)));
+    }
+#endif
+
+    for (; i < n; ++i) {
+        Vector3D g;
+        out[i] = noise(xs[i], ys[i], zs[i], g);
+        gx[i] = g.x;
+        gy[i] = g.y;
+        gz[i] = g.z;
+    }
+}
+
+void PerlinNoise::octaveNoise2(const float* xs, const float* ys, float* out, size_t n,
+                               int octaves, float persistence) const {
+    float sx[kBlockSize], sy[kBlockSize], sample[kBlockSize];
+
+    for (size_t begin = 0; begin < n; begin += kBlockSize) {
+        size_t count = std::min(kBlockSize, n - begin);
+        float* total = out + begin;
+        std::fill(total, total + count, 0.0f);
+
+        float frequency = 1.0f;
+        float amplitude = 1.0f;
+        float maxValue = 0.0f;
+        for (int o = 0; o < octaves; ++o) {
+            for (size_t k = 0; k < count; ++k) {
+                sx[k] = xs[begin + k] * frequency;
+                sy[k] = ys[begin + k] * frequency;
+            }
+            noise2(sx, sy, sample, count);
+            for (size_t k = 0; k < count; ++k) total[k] += sample[k] * amplitude;
+
+            maxValue += amplitude;
+            amplitude *= persistence;
+            frequency *= 2.0f;
+        }
+
+        for (size_t k = 0; k < count; ++k) total[k] /= maxValue;
+    }
+}
+
+void PerlinNoise::octaveNoise3(const float* xs, const float* ys, const float* zs, float* out, size_t n,
+                               int octaves, float persistence) const {
+    float sx[kBlockSize], sy[kBlockSize], sz[kBlockSize], sample[kBlockSize];
+
+    for (size_t begin = 0; begin < n; begin += kBlockSize) {
+        size_t count = std::min(kBlockSize, n - begin);
+        float* total = out + begin;
+        std::fill(total, total + count, 0.0f);
+
+        float frequency = 1.0f;
+        float amplitude = 1.0f;
+        float maxValue = 0.0f;
+        for (int o = 0; o < octaves; ++o) {
+            for (size_t k = 0; k < count; ++k) {
+                sx[k] = xs[begin + k] * frequency;
+                sy[k] = ys[begin + k] * frequency;
+                sz[k] = zs[begin + k] * frequency;
+            }
+            noise3(sx, sy, sz, sample, count);
+            for (size_t k = 0; k < count; ++k) total[k] += sample[k] * amplitude;
+
+            maxValue += amplitude;
+            amplitude *= persistence;
+            frequency *= 2.0f;
+        }
+
+        for (size_t k = 0; k < count; ++k) total[k] /= maxValue;
+    }
+}
+
+void PerlinNoise::octaveNoise3(const float* xs, const float* ys, const float* zs, float* out,
+                               float* gx, float* gy, float* gz, size_t n, int octaves, float persistence) const {
+    float sx[kBlockSize], sy[kBlockSize], sz[kBlockSize];
+    float sample[kBlockSize], sgx[kBlockSize], sgy[kBlockSize], sgz[kBlockSize];
+
+    for (size_t begin = 0; begin < n; begin += kBlockSize) {
+        size_t count = std::min(kBlockSize, n - begin);
+        float* total = out + begin;
+        float* tx = gx + begin;
+        float* ty = gy + begin;
+        float* tz = gz + begin;
+        std::fill(total, total + count, 0.0f);
+        std::fill(tx, tx + count, 0.0f);
+        std::fill(ty, ty + count, 0.0f);
+        std::fill(tz, tz + count, 0.0f);
+
+        float frequency = 1.0f;
+        float amplitude = 1.0f;
+        float maxValue = 0.0f;
+        for (int o = 0; o < octaves; ++o) {
+            for (size_t k = 0; k < count; ++k) {
+                sx[k] = xs[begin + k] * frequency;
+                sy[k] = ys[begin + k] * frequency;
+                sz[k] = zs[begin + k] * frequency;
+            }
+            noise3(sx, sy, sz, sample, sgx, sgy, sgz, count);
+
+            float gradientScale = amplitude * frequency;
+            for (size_t k = 0; k < count; ++k) {
+                total[k] += sample[k] * amplitude;
+                tx[k] += sgx[k] * gradientScale;
+                ty[k] += sgy[k] * gradientScale;
+                tz[k] += sgz[k] * gradientScale;
+            }
+
+            maxValue += amplitude;
+            amplitude *= persistence;
+            frequency *= 2.0f;
+        }
+
+        for (size_t k = 0; k < count; ++k) {
+            total[k] /= maxValue;
+            tx[k] /= maxValue;
+            ty[k] /= maxValue;
+            tz[k] /= maxValue;
+        }
+    }
+}
+
+void PerlinNoise::fillGrid2D(const float* xs, int width, const float* ys, int height, float* out,
+                             int octaves, float persistence) const {
+    if (width <= 0 || height <= 0) return;
+
+    std::vector<float> row(static_cast<size_t>(width));
+    for (int j = 0; j < height; ++j) {
+        std::fill(row.begin(), row.end(), ys[j]);
+        octaveNoise2(xs, row.data(), out + static_cast<size_t>(j) * width, width, octaves, persistence);
+    }
+}
+
 } // namespace ethereal
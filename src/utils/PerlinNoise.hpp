@@ -1,7 +1,9 @@
 #pragma once
-#include <vector>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include "core/Vector2D.hpp"
+#include "core/Vector3D.hpp"
 
 namespace ethereal {
 
@@ -19,12 +21,37 @@ public:
 
     Vector2D curl(float x, float y, float epsilon = 0.01f) const;
 
+    // Value plus analytic gradient from the same lattice walk; the value is
+    // identical to noise(x, y, z)
+    float noise(float x, float y, float z, Vector3D& gradient) const;
+    float octaveNoise(float x, float y, float z, int octaves, float persistence, Vector3D& gradient) const;
+
+    // === Batch evaluation ===
+    // Same values as the scalar calls, evaluated 4 points at a time with SSE2
+    void noise2(const float* xs, const float* ys, float* out, size_t n) const;
+    void noise3(const float* xs, const float* ys, const float* zs, float* out, size_t n) const;
+    void octaveNoise2(const float* xs, const float* ys, float* out, size_t n,
+                      int octaves, float persistence = 0.5f) const;
+    void octaveNoise3(const float* xs, const float* ys, const float* zs, float* out, size_t n,
+                      int octaves, float persistence = 0.5f) const;
+    // Batch value + gradient (gx, gy, gz may not alias the inputs)
+    void noise3(const float* xs, const float* ys, const float* zs, float* out,
+                float* gx, float* gy, float* gz, size_t n) const;
+    void octaveNoise3(const float* xs, const float* ys, const float* zs, float* out,
+                      float* gx, float* gy, float* gz, size_t n, int octaves, float persistence) const;
+
+    // Octave noise over the lattice xs[0..width) x ys[0..height), row-major into out
+    void fillGrid2D(const float* xs, int width, const float* ys, int height, float* out,
+                    int octaves = 1, float persistence = 0.5f) const;
+
     void reseed(uint32_t seed);
 
 private:
-    std::vector<int> p; // Permutation table
+    std::array<uint8_t, 512> p; // Permutation table, duplicated to avoid wrapping
 
     static float fade(float t);
+    static float fadeDerivative(float t);
+    static void gradVector(int hash, float& gx, float& gy, float& gz);
     static float lerp(float t, float a, float b);
     static float grad(int hash, float x, float y, float z);
     static float grad(int hash, float x, float y);
@@ -0,0 +1,221 @@
+#include "Profiler.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace ethereal {
+
+namespace {
+
+thread_local int scopeDepth = 0;
+
+void writeJsonString(std::ofstream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') out << '\\';
+        out << *c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler() : epochNs(now()) {}
+
+void Profiler::configure(const ProfilerConfig& newConfig) {
+    config = newConfig;
+    config.historyFrames = std::max<size_t>(config.historyFrames, 1);
+
+    for (auto& scope : scopes) {
+        scope.history.assign(config.historyFrames, 0.0f);
+        scope.callHistory.assign(config.historyFrames, 0);
+        scope.cursor = 0;
+        scope.filled = 0;
+    }
+}
+
+uint64_t Profiler::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+int& Profiler::threadDepth() {
+    return scopeDepth;
+}
+
+Profiler::ThreadRing& Profiler::localRing() {
+    thread_local ThreadRing* ring = nullptr;
+    if (!ring) {
+        auto created = std::make_unique<ThreadRing>();
+        created->events.resize(std::max<size_t>(config.eventsPerThread, 1));
+
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        created->threadId = static_cast<uint32_t>(rings.size());
+        ring = created.get();
+        rings.push_back(std::move(created));
+    }
+    return *ring;
+}
+
+void Profiler::record(const char* name, uint64_t startNs, uint64_t endNs, int depth) {
+    ThreadRing& ring = localRing();
+    size_t head = ring.head.load(std::memory_order_relaxed);
+    size_t tail = ring.tail.load(std::memory_order_acquire);
+
+    // Full until the frame thread drains; keep the older events
+    if (head - tail >= ring.events.size()) {
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ring.events[head % ring.events.size()] = {name, startNs, endNs, depth};
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+size_t Profiler::scopeIndex(const Event& event) {
+    const char* name = event.name;
+    int depth = event.depth;
+    auto byPointer = scopeByPointer.find(name);
+    if (byPointer != scopeByPointer.end()) {
+        Scope& scope = scopes[byPointer->second];
+        scope.depth = std::min(scope.depth, depth);
+        return byPointer->second;
+    }
+
+    // The same literal may live at different addresses in different translation units
+    size_t index;
+    auto byName = scopeByName.find(name);
+    if (byName != scopeByName.end()) {
+        index = byName->second;
+        scopes[index].depth = std::min(scopes[index].depth, depth);
+    } else {
+        index = scopes.size();
+        Scope scope;
+        scope.name = name;
+        scope.depth = depth;
+        scope.firstStartNs = event.startNs;
+        scope.history.assign(config.historyFrames, 0.0f);
+        scope.callHistory.assign(config.historyFrames, 0);
+        scopes.push_back(std::move(scope));
+        scopeByName.emplace(name, index);
+    }
+    scopeByPointer.emplace(name, index);
+    return index;
+}
+
+void Profiler::endFrame() {
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        for (auto& ring : rings) {
+            size_t head = ring->head.load(std::memory_order_acquire);
+            size_t tail = ring->tail.load(std::memory_order_relaxed);
+            size_t capacity = ring->events.size();
+
+            for (size_t i = tail; i != head; ++i) {
+                const Event& event = ring->events[i % capacity];
+                Scope& scope = scopes[scopeIndex(event)];
+                scope.frameMs += (event.endNs - event.startNs) * 1e-6f;
+                scope.frameCalls++;
+
+                if (tracing && traceEvents.size() < traceLimit) {
+                    traceEvents.push_back({event, ring->threadId});
+                }
+            }
+
+            ring->tail.store(head, std::memory_order_release);
+            droppedEvents += ring->dropped.exchange(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Close the frame for every known scope, including ones that did not run
+    for (auto& scope : scopes) {
+        scope.history[scope.cursor] = scope.frameMs;
+        scope.callHistory[scope.cursor] = scope.frameCalls;
+        scope.cursor = (scope.cursor + 1) % scope.history.size();
+        scope.filled = std::min(scope.filled + 1, scope.history.size());
+        scope.frameMs = 0.0f;
+        scope.frameCalls = 0;
+    }
+}
+
+std::vector<ProfileScopeStats> Profiler::getScopeStats() const {
+    // Parents start before their children, so this order reads top-down
+    std::vector<const Scope*> order;
+    for (const auto& scope : scopes) {
+        if (scope.filled > 0) order.push_back(&scope);
+    }
+    std::stable_sort(order.begin(), order.end(), [](const Scope* a, const Scope* b) {
+        return a->firstStartNs < b->firstStartNs;
+    });
+
+    std::vector<ProfileScopeStats> result;
+    result.reserve(order.size());
+
+    std::vector<float> sorted;
+    for (const Scope* scope : order) {
+        ProfileScopeStats stats;
+        stats.name = scope->name;
+        stats.depth = scope->depth;
+
+        size_t newest = (scope->cursor + scope->history.size() - 1) % scope->history.size();
+        stats.lastMs = scope->history[newest];
+
+        // The ring is filled from index 0, so the first `filled` entries are valid
+        sorted.assign(scope->history.begin(), scope->history.begin() + scope->filled);
+        std::sort(sorted.begin(), sorted.end());
+
+        float total = 0.0f;
+        int calls = 0;
+        for (size_t i = 0; i < scope->filled; ++i) {
+            total += sorted[i];
+            calls += scope->callHistory[i];
+        }
+
+        stats.minMs = sorted.front();
+        stats.maxMs = sorted.back();
+        stats.avgMs = total / scope->filled;
+        stats.p99Ms = sorted[std::min(scope->filled - 1, static_cast<size_t>(scope->filled * 0.99f))];
+        stats.callsPerFrame = static_cast<float>(calls) / scope->filled;
+        result.push_back(std::move(stats));
+    }
+    return result;
+}
+
+void Profiler::beginTrace(size_t maxEvents) {
+    traceEvents.clear();
+    traceEvents.reserve(std::min<size_t>(maxEvents, 1 << 16));
+    traceLimit = maxEvents;
+    tracing = true;
+}
+
+bool Profiler::endTrace(const std::string& path) {
+    if (!tracing) return false;
+    tracing = false;
+
+    std::ofstream out(path);
+    if (!out) return false;
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (size_t i = 0; i < traceEvents.size(); ++i) {
+        const Event& event = traceEvents[i].event;
+        if (i > 0) out << ',';
+        out << "\n{\"name\":";
+        writeJsonString(out, event.name);
+        out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << traceEvents[i].threadId
+            << ",\"ts\":" << static_cast<int64_t>(event.startNs - epochNs) * 1e-3
+            << ",\"dur\":" << (event.endNs - event.startNs) * 1e-3 << '}';
+    }
+    out << "\n]}\n";
+
+    traceEvents.clear();
+    traceEvents.shrink_to_fit();
+    return static_cast<bool>(out);
+}
+
+} // namespace ethereal
@@ -0,0 +1,142 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ethereal {
+
+// Per-scope timing over the recent frame history (milliseconds per frame)
+struct ProfileScopeStats {
+    std::string name;
+    int depth = 0;              // Shallowest nesting level the scope was seen at
+    float lastMs = 0.0f;
+    float minMs = 0.0f;
+    float avgMs = 0.0f;
+    float maxMs = 0.0f;
+    float p99Ms = 0.0f;
+    float callsPerFrame = 0.0f;
+};
+
+struct ProfilerConfig {
+    size_t eventsPerThread = 1 << 14;   // Ring capacity; events past it are dropped
+    size_t historyFrames = 120;
+};
+
+// Collects named, nestable scope timings. Any thread may record through
+// ScopedTimer; each thread writes only its own ring buffer, and the frame
+// thread drains every ring in endFrame().
+class Profiler {
+public:
+    static Profiler& instance();
+
+    // Ring capacity applies to threads that start recording after the call
+    void configure(const ProfilerConfig& config);
+
+    // Frame thread only
+    void endFrame();
+    std::vector<ProfileScopeStats> getScopeStats() const;
+    size_t getDroppedEvents() const { return droppedEvents; }
+
+    // Chrome trace / Perfetto JSON ("Trace Event Format" complete events)
+    void beginTrace(size_t maxEvents = 1 << 20);
+    bool endTrace(const std::string& path);
+    bool isTracing() const { return tracing; }
+
+    // Recording (any thread)
+    static uint64_t now();
+    void record(const char* name, uint64_t startNs, uint64_t endNs, int depth);
+    static int& threadDepth();
+
+private:
+    struct Event {
+        const char* name;
+        uint64_t startNs;
+        uint64_t endNs;
+        int depth;
+    };
+
+    struct ThreadRing {
+        std::vector<Event> events;
+        std::atomic<size_t> head{0};    // Written by the owning thread
+        std::atomic<size_t> tail{0};    // Written by the frame thread
+        std::atomic<size_t> dropped{0};
+        uint32_t threadId = 0;
+    };
+
+    struct TraceEvent {
+        Event event;
+        uint32_t threadId;
+    };
+
+    struct Scope {
+        std::string name;
+        int depth = 0;
+        uint64_t firstStartNs = 0;      // Orders the report parent-first
+        float frameMs = 0.0f;
+        int frameCalls = 0;
+        std::vector<float> history;     // Ring of per-frame totals
+        std::vector<int> callHistory;
+        size_t cursor = 0;
+        size_t filled = 0;
+    };
+
+    Profiler();
+    ThreadRing& localRing();
+
+    ProfilerConfig config;
+    uint64_t epochNs;
+
+    mutable std::mutex ringsMutex;      // Guards registration only
+    std::vector<std::unique_ptr<ThreadRing>> rings;
+
+    std::unordered_map<const char*, size_t> scopeByPointer;
+    std::unordered_map<std::string, size_t> scopeByName;
+    std::vector<Scope> scopes;
+    size_t droppedEvents = 0;
+
+    bool tracing = false;
+    size_t traceLimit = 0;
+    std::vector<TraceEvent> traceEvents;
+
+    size_t scopeIndex(const Event& event);
+};
+
+// Records the enclosing block under `name` (a string literal)
+class ScopedTimer {
+public:
+    explicit ScopedTimer(const char* name)
+        : name(name)
+        , depth(Profiler::threadDepth()++)
+        , startNs(Profiler::now()) {}
+
+    ~ScopedTimer() {
+        uint64_t endNs = Profiler::now();
+        --Profiler::threadDepth();
+        Profiler::instance().record(name, startNs, endNs, depth);
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    const char* name;
+    int depth;
+    uint64_t startNs;
+};
+
+} // namespace ethereal
+
+// Building with -DLOOM_DISABLE_PROFILER compiles every scope out
+#if !defined(LOOM_DISABLE_PROFILER)
+#define LOOM_PROFILE_CONCAT_INNER(a, b) a##b
+#define LOOM_PROFILE_CONCAT(a, b) LOOM_PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ::ethereal::ScopedTimer LOOM_PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#endif
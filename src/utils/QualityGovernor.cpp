@@ -0,0 +1,140 @@
+#include "QualityGovernor.hpp"
+#include <algorithm>
+
+namespace ethereal {
+
+QualityGovernor::QualityGovernor() : QualityGovernor(QualityGovernorConfig{}) {}
+
+QualityGovernor::QualityGovernor(const QualityGovernorConfig& config)
+    : config(config)
+    , restoreWindowsNeeded(std::max(config.restoreWindows, 1)) {}
+
+int QualityGovernor::registerKnob(const std::string& name, float value, float minValue, float maxValue,
+                                  float step, int priority, ApplyFn apply) {
+    Knob knob;
+    knob.name = name;
+    knob.minValue = std::min(minValue, maxValue);
+    knob.maxValue = std::max(minValue, maxValue);
+    knob.value = std::clamp(value, knob.minValue, knob.maxValue);
+    knob.step = std::max(step, 1e-6f);
+    knob.priority = priority;
+    knob.apply = std::move(apply);
+    knobs.push_back(std::move(knob));
+    return static_cast<int>(knobs.size()) - 1;
+}
+
+void QualityGovernor::setKnobBounds(int knob, float minValue, float maxValue) {
+    Knob& k = knobs[knob];
+    k.minValue = std::min(minValue, maxValue);
+    k.maxValue = std::max(minValue, maxValue);
+    setValue(k, std::clamp(k.value, k.minValue, k.maxValue));
+}
+
+void QualityGovernor::update(const PerformanceMonitor& monitor) {
+    update(monitor.getFrameTimeMs(), monitor.getBusyTimeMs());
+}
+
+void QualityGovernor::update(float frameMs, float busyMs) {
+    if (!enabled) return;
+    frameWindow.add(frameMs);
+    busyWindow.add(busyMs);
+    if (frameWindow.getCount() >= static_cast<uint32_t>(std::max(config.windowFrames, 1))) {
+        evaluateWindow();
+    }
+}
+
+void QualityGovernor::evaluateWindow() {
+    windowFrameMs = frameWindow.percentileMs(config.percentile);
+    windowBusyMs = busyWindow.percentileMs(config.percentile);
+    restartWindow();
+
+    const bool wasRestore = restoredLastWindow;
+    restoredLastWindow = false;
+
+    if (windowFrameMs > config.targetFrameMs * config.degradeAbove) {
+        goodWindows = 0;
+        // The last restore did not fit: wait longer before trying it again
+        if (wasRestore) {
+            restoreWindowsNeeded = std::min(restoreWindowsNeeded * 2, std::max(config.maxRestoreWindows, 1));
+        }
+        degrade();
+        return;
+    }
+
+    if (wasRestore) {
+        // The restore held; ease the backoff
+        restoreWindowsNeeded = std::max(restoreWindowsNeeded / 2, std::max(config.restoreWindows, 1));
+    }
+
+    if (windowBusyMs < config.targetFrameMs * config.restoreBelow) {
+        if (++goodWindows >= restoreWindowsNeeded) {
+            goodWindows = 0;
+            restoredLastWindow = restore();
+        }
+    } else {
+        goodWindows = 0;    // Inside the band: hold
+    }
+}
+
+bool QualityGovernor::degrade() {
+    Knob* pick = nullptr;
+    for (Knob& knob : knobs) {
+        if (knob.value <= knob.minValue) continue;
+        if (!pick || knob.priority < pick->priority) pick = &knob;
+    }
+    if (!pick) return false;
+    setValue(*pick, std::max(pick->minValue, pick->value - pick->step));
+    return true;
+}
+
+bool QualityGovernor::restore() {
+    Knob* pick = nullptr;
+    for (Knob& knob : knobs) {
+        if (knob.value >= knob.maxValue) continue;
+        if (!pick || knob.priority > pick->priority) pick = &knob;
+    }
+    if (!pick) return false;
+    setValue(*pick, std::min(pick->maxValue, pick->value + pick->step));
+    return true;
+}
+
+void QualityGovernor::setValue(Knob& knob, float value) {
+    if (value == knob.value) return;
+    knob.value = value;
+    if (knob.apply) knob.apply(value);
+    changeCount++;
+    // Frames from before the change say nothing about the new setting
+    restartWindow();
+}
+
+void QualityGovernor::restartWindow() {
+    frameWindow.clear();
+    busyWindow.clear();
+}
+
+void QualityGovernor::setEnabled(bool isEnabled) {
+    enabled = isEnabled;
+    restartWindow();
+    goodWindows = 0;
+    restoredLastWindow = false;
+}
+
+void QualityGovernor::restoreAll() {
+    for (Knob& knob : knobs) setValue(knob, knob.maxValue);
+    goodWindows = 0;
+    restoredLastWindow = false;
+    restoreWindowsNeeded = std::max(config.restoreWindows, 1);
+}
+
+float QualityGovernor::getQualityLevel() const {
+    float range = 0.0f, level = 0.0f;
+    for (const Knob& knob : knobs) {
+        float span = knob.maxValue - knob.minValue;
+        if (span <= 0.0f) continue;
+        range += 1.0f;
+        level += (knob.value - knob.minValue) / span;
+    }
+    return range > 0.0f ? level / range : 1.0f;
+}
+
+} // namespace ethereal
@@ -0,0 +1,96 @@
+#pragma once
+#include "utils/PerformanceMonitor.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ethereal {
+
+struct QualityGovernorConfig {
+    float targetFrameMs = 1000.0f / 60.0f;
+    float percentile = 0.9f;        // Each window is judged on this percentile
+    int windowFrames = 60;          // Frames per decision; the window restarts after a change
+
+    // Hysteresis band: cut above target * degradeAbove (full frame time, so GPU stalls
+    // and missed vsyncs count), restore below target * restoreBelow (busy time only)
+    float degradeAbove = 1.08f;
+    float restoreBelow = 0.75f;
+
+    // Good windows in a row before a restore; doubles, up to the maximum, whenever
+    // a restore is cut again in the very next window
+    int restoreWindows = 3;
+    int maxRestoreWindows = 48;
+};
+
+// Holds a target frame time by trading quality budgets. Subsystems register
+// knobs (a value, its bounds and step, and a callback that applies it); every
+// window of frames the governor lowers one knob when the frame-time percentile
+// is over budget and raises one back when there is clear headroom. Knobs with a
+// lower priority are cut first and restored last.
+class QualityGovernor {
+public:
+    using ApplyFn = std::function<void(float value)>;
+
+    QualityGovernor();
+    explicit QualityGovernor(const QualityGovernorConfig& config);
+
+    // `value` is the knob's current setting; apply() is called only on changes.
+    // Returns the knob's handle.
+    int registerKnob(const std::string& name, float value, float minValue, float maxValue,
+                     float step, int priority, ApplyFn apply);
+    void setKnobBounds(int knob, float minValue, float maxValue);
+
+    // Once per frame, after PerformanceMonitor::endFrame()
+    void update(const PerformanceMonitor& monitor);
+    void update(float frameMs, float busyMs);
+
+    // Disabled: knobs hold their values and the window keeps restarting
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled; }
+    // Every knob back to its maximum
+    void restoreAll();
+
+    size_t getKnobCount() const { return knobs.size(); }
+    const std::string& getKnobName(int knob) const { return knobs[knob].name; }
+    float getValue(int knob) const { return knobs[knob].value; }
+    // 0 = every knob at its minimum, 1 = every knob at its maximum
+    float getQualityLevel() const;
+    // Percentiles of the last completed window
+    float getWindowFrameMs() const { return windowFrameMs; }
+    float getWindowBusyMs() const { return windowBusyMs; }
+    uint32_t getChangeCount() const { return changeCount; }
+
+    const QualityGovernorConfig& getConfig() const { return config; }
+    void setConfig(const QualityGovernorConfig& cfg) { config = cfg; }
+
+private:
+    struct Knob {
+        std::string name;
+        float value = 0.0f;
+        float minValue = 0.0f;
+        float maxValue = 0.0f;
+        float step = 1.0f;
+        int priority = 0;
+        ApplyFn apply;
+    };
+
+    QualityGovernorConfig config;
+    std::vector<Knob> knobs;
+    FrameTimeHistogram frameWindow;
+    FrameTimeHistogram busyWindow;
+    float windowFrameMs = 0.0f;
+    float windowBusyMs = 0.0f;
+    int goodWindows = 0;
+    int restoreWindowsNeeded = 0;
+    bool restoredLastWindow = false;
+    bool enabled = true;
+    uint32_t changeCount = 0;
+
+    void evaluateWindow();
+    bool degrade();
+    bool restore();
+    void setValue(Knob& knob, float value);
+    void restartWindow();
+};
+
+} // namespace ethereal
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace ethereal {
+
+// PCG32 (O'Neill's XSH-RR variant): 64-bit state, 32-bit output, cheap enough
+// to run per audio sample. Distinct streams give independent sequences from
+// the same seed, so subsystems can derive their generators from one value.
+class Pcg32 {
+public:
+    Pcg32() : Pcg32(0x853c49e6748fea9bull) {}
+    explicit Pcg32(uint64_t seed, uint64_t stream = 0) { reseed(seed, stream); }
+
+    void reseed(uint64_t seed, uint64_t stream = 0) {
+        state = 0;
+        increment = (stream << 1) | 1u;
+        next();
+        state += seed;
+        next();
+    }
+
+    uint32_t next() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ull + increment;
+        uint32_t xorShifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        uint32_t rot = static_cast<uint32_t>(old >> 59);
+        return (xorShifted >> rot) | (xorShifted << ((32 - rot) & 31));
+    }
+
+    // [0, 1)
+    float nextFloat() { return (next() >> 8) * (1.0f / 16777216.0f); }
+    // [-1, 1)
+    float nextSigned() { return static_cast<int32_t>(next()) * (1.0f / 2147483648.0f); }
+    // [lo, hi)
+    float range(float lo, float hi) { return lo + (hi - lo) * nextFloat(); }
+
+    void fillSigned(float* out, size_t count) {
+        for (size_t i = 0; i < count; ++i) out[i] = nextSigned();
+    }
+
+private:
+    uint64_t state;
+    uint64_t increment;
+};
+
+// SplitMix64 finalizer: derives well-separated seeds from one base seed
+inline uint64_t mixSeed(uint64_t seed, uint64_t salt) {
+    uint64_t z = seed + (salt + 1) * 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+} // namespace ethereal
@@ -0,0 +1,47 @@
+#include "SimulationClock.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ethereal {
+
+SimulationClock::SimulationClock() : SimulationClock(SimulationClockConfig{}) {}
+
+SimulationClock::SimulationClock(const SimulationClockConfig& config) {
+    setConfig(config);
+}
+
+void SimulationClock::setConfig(const SimulationClockConfig& cfg) {
+    config = cfg;
+    config.stepRate = std::max(config.stepRate, 1.0f);
+    config.maxSubsteps = std::max(config.maxSubsteps, 1);
+    step = 1.0f / config.stepRate;
+    accumulator = std::min(accumulator, step);
+}
+
+void SimulationClock::reset() {
+    accumulator = 0.0f;
+    simulatedTime = 0.0;
+    lastSubsteps = 0;
+    droppedSteps = 0;
+}
+
+int SimulationClock::advance(float frameTime) {
+    accumulator += std::clamp(frameTime, 0.0f, config.maxFrameTime);
+
+    int steps = static_cast<int>(accumulator / step);
+    if (steps > config.maxSubsteps) {
+        // Running behind: drop whole steps rather than spiral, keep the phase
+        droppedSteps += steps - config.maxSubsteps;
+        accumulator -= (steps - config.maxSubsteps) * step;
+        steps = config.maxSubsteps;
+    }
+    accumulator -= steps * step;
+    // Float drift can leave the accumulator a hair outside [0, step)
+    accumulator = std::clamp(accumulator, 0.0f, std::nextafter(step, 0.0f));
+
+    simulatedTime += static_cast<double>(steps) * step;
+    lastSubsteps = steps;
+    return steps;
+}
+
+} // namespace ethereal
@@ -0,0 +1,42 @@
+#pragma once
+
+namespace ethereal {
+
+struct SimulationClockConfig {
+    float stepRate = 60.0f;         // Fixed simulation steps per second
+    int maxSubsteps = 5;            // Per frame; time beyond this is dropped
+    float maxFrameTime = 0.25f;     // Longer frames (breakpoints, window drags) are clamped
+};
+
+// Fixed-timestep accumulator. Each frame advance() reports how many fixed steps to
+// simulate; getAlpha() is how far the leftover time reaches into the next step,
+// used to interpolate between the last two simulated states when rendering.
+class SimulationClock {
+public:
+    SimulationClock();
+    explicit SimulationClock(const SimulationClockConfig& config);
+
+    // Adds a frame's real time and returns the number of steps to run (may be 0)
+    int advance(float frameTime);
+    void reset();
+
+    float getStep() const { return step; }
+    float getAlpha() const { return accumulator / step; }
+    double getSimulatedTime() const { return simulatedTime; }
+    int getLastSubsteps() const { return lastSubsteps; }
+    // Steps discarded because a frame needed more than maxSubsteps
+    long long getDroppedSteps() const { return droppedSteps; }
+
+    void setConfig(const SimulationClockConfig& cfg);
+    const SimulationClockConfig& getConfig() const { return config; }
+
+private:
+    SimulationClockConfig config;
+    float step;
+    float accumulator = 0.0f;
+    double simulatedTime = 0.0;
+    int lastSubsteps = 0;
+    long long droppedSteps = 0;
+};
+
+} // namespace ethereal
@@ -0,0 +1,121 @@
+#include "StartupGraph.hpp"
+#include "utils/Profiler.hpp"
+
+namespace ethereal {
+
+namespace {
+
+float millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+StartupGraph::StartupGraph(JobSystem* jobs) : jobs(jobs) {}
+
+StartupGraph::~StartupGraph() {
+    // CPU steps reference the caller's objects; none may outlive the graph
+    if (!jobs) return;
+    for (auto& task : tasks) {
+        if (task->state == State::Running) jobs->wait(task->group);
+    }
+}
+
+int StartupGraph::add(const std::string& name, TaskFn work, TaskFn finish, const std::vector<int>& dependencies) {
+    auto task = std::make_unique<Task>();
+    task->name = name;
+    task->work = std::move(work);
+    task->finish = std::move(finish);
+    // Only earlier tasks, so the graph cannot hold a cycle
+    for (int dependency : dependencies) {
+        if (dependency >= 0 && dependency < static_cast<int>(tasks.size())) {
+            task->dependencies.push_back(dependency);
+        }
+    }
+    tasks.push_back(std::move(task));
+    return static_cast<int>(tasks.size()) - 1;
+}
+
+bool StartupGraph::poll() {
+    if (!started) {
+        started = true;
+        startTime = std::chrono::steady_clock::now();
+    }
+
+    bool progressed = true;
+    while (progressed) {
+        progressed = false;
+        for (auto& task : tasks) {
+            if (task->state == State::Running && task->group.isDone()) {
+                finish(*task);
+                progressed = true;
+            }
+        }
+        for (auto& task : tasks) {
+            if (task->state != State::Waiting || !isReady(*task)) continue;
+            launch(*task);
+            // Inline work: hand back to the caller so a loading frame can draw
+            if (!isPipelined()) return false;
+        }
+    }
+    return isDone();
+}
+
+void StartupGraph::wait() {
+    while (!poll()) {
+        for (auto& task : tasks) {
+            if (task->state != State::Running) continue;
+            if (jobs) jobs->wait(task->group);
+            break;
+        }
+    }
+}
+
+float StartupGraph::getProgress() const {
+    return tasks.empty() ? 1.0f : static_cast<float>(finishedCount) / static_cast<float>(tasks.size());
+}
+
+const std::string& StartupGraph::getCurrentName() const {
+    static const std::string none;
+    for (const auto& task : tasks) {
+        if (task->state == State::Running) return task->name;
+    }
+    for (const auto& task : tasks) {
+        if (task->state == State::Waiting) return task->name;
+    }
+    return none;
+}
+
+bool StartupGraph::isReady(const Task& task) const {
+    for (int dependency : task.dependencies) {
+        if (tasks[dependency]->state != State::Finished) return false;
+    }
+    return true;
+}
+
+void StartupGraph::launch(Task& task) {
+    task.state = State::Running;
+    if (!task.work) return;
+
+    Task* target = &task;
+    auto run = [target]() {
+        PROFILE_SCOPE("StartupGraph::work");
+        auto start = std::chrono::steady_clock::now();
+        target->work();
+        target->workMs = millisecondsSince(start);
+    };
+    if (isPipelined()) jobs->run(task.group, run);
+    else run();
+}
+
+void StartupGraph::finish(Task& task) {
+    if (task.finish) {
+        auto start = std::chrono::steady_clock::now();
+        task.finish();
+        task.finishMs = millisecondsSince(start);
+    }
+    task.state = State::Finished;
+    if (++finishedCount == tasks.size()) elapsedMs = millisecondsSince(startTime);
+}
+
+} // namespace ethereal
@@ -0,0 +1,75 @@
+#pragma once
+#include "utils/JobSystem.hpp"
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ethereal {
+
+// Startup work as a graph of tasks. Each task has an optional CPU step that runs
+// on a job system worker and an optional finish step that runs on the main thread
+// (GPU uploads, device setup) once the CPU step is done. A task starts when every
+// task it depends on has finished both steps. The main thread drives the graph
+// with poll() between loading frames, or blocks in wait() when there is nothing
+// to draw. Without workers each poll() runs one CPU step inline.
+class StartupGraph {
+public:
+    using TaskFn = std::function<void()>;
+
+    explicit StartupGraph(JobSystem* jobs);
+    ~StartupGraph();
+
+    StartupGraph(const StartupGraph&) = delete;
+    StartupGraph& operator=(const StartupGraph&) = delete;
+
+    // Before the first poll(); `dependencies` are handles returned by earlier add() calls
+    int add(const std::string& name, TaskFn work, TaskFn finish = {}, const std::vector<int>& dependencies = {});
+
+    // Main thread. Finishes completed tasks and launches ready ones; true once all are done.
+    bool poll();
+    // Main thread. Polls until every task is done, helping the workers meanwhile.
+    void wait();
+
+    bool isDone() const { return finishedCount == tasks.size(); }
+    // Finished tasks over all tasks
+    float getProgress() const;
+    // A task still in progress, for the loading screen; empty once done
+    const std::string& getCurrentName() const;
+
+    size_t getTaskCount() const { return tasks.size(); }
+    const std::string& getTaskName(int task) const { return tasks[task]->name; }
+    float getWorkMs(int task) const { return tasks[task]->workMs; }
+    float getFinishMs(int task) const { return tasks[task]->finishMs; }
+    // From the first poll() to the last finish step
+    float getElapsedMs() const { return elapsedMs; }
+
+private:
+    enum class State { Waiting, Running, Finished };
+
+    struct Task {
+        std::string name;
+        TaskFn work;
+        TaskFn finish;
+        std::vector<int> dependencies;
+        State state = State::Waiting;
+        JobGroup group;
+        float workMs = 0.0f;
+        float finishMs = 0.0f;
+    };
+
+    JobSystem* jobs;
+    std::vector<std::unique_ptr<Task>> tasks;
+    size_t finishedCount = 0;
+    bool started = false;
+    std::chrono::steady_clock::time_point startTime;
+    float elapsedMs = 0.0f;
+
+    bool isReady(const Task& task) const;
+    void launch(Task& task);
+    void finish(Task& task);
+    bool isPipelined() const { return jobs && jobs->getWorkerCount() > 0; }
+};
+
+} // namespace ethereal
@@ -0,0 +1,205 @@
+#include "Telemetry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace ethereal {
+
+namespace {
+
+static_assert(sizeof(sockaddr_in) <= 16, "address storage");
+
+const char* kindSuffix(CounterKind kind) {
+    return kind == CounterKind::Count ? "|c" : "|g";
+}
+
+} // namespace
+
+Telemetry& Telemetry::instance() {
+    static Telemetry telemetry;
+    return telemetry;
+}
+
+Telemetry::~Telemetry() {
+    stopExport();
+}
+
+int Telemetry::registerCounter(const char* name, CounterKind kind) {
+    std::lock_guard<std::mutex> lock(registerMutex);
+    size_t count = slotCount.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        if (slots[i].name == name) return static_cast<int>(i);
+    }
+    if (count == kMaxCounters) return -1;
+
+    slots[count].name = name;
+    slots[count].kind = kind;
+    slots[count].bits.store(0, std::memory_order_relaxed);
+    // Readers see the name and kind before the slot
+    slotCount.store(count + 1, std::memory_order_release);
+    return static_cast<int>(count);
+}
+
+void Telemetry::peak(int counter, double value) {
+    if (counter < 0) return;
+    std::atomic<int64_t>& bits = slots[counter].bits;
+    int64_t current = bits.load(std::memory_order_relaxed);
+    while (fromBits(current) < value &&
+           !bits.compare_exchange_weak(current, toBits(value), std::memory_order_relaxed)) {}
+}
+
+void Telemetry::snapshot(std::vector<TelemetrySample>& out, bool reset) {
+    size_t count = slotCount.load(std::memory_order_acquire);
+    out.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        Slot& slot = slots[i];
+        TelemetrySample& sample = out[i];
+        if (sample.name != slot.name) sample.name = slot.name;
+        sample.kind = slot.kind;
+        bool clears = reset && slot.kind != CounterKind::Gauge;
+        int64_t bits = clears ? slot.bits.exchange(0, std::memory_order_relaxed)
+                              : slot.bits.load(std::memory_order_relaxed);
+        sample.value = slot.kind == CounterKind::Count ? static_cast<double>(bits) : fromBits(bits);
+    }
+}
+
+int64_t Telemetry::toBits(double value) {
+    int64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double Telemetry::fromBits(int64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// === Export ===
+
+bool Telemetry::startExport(const TelemetryConfig& config) {
+    stopExport();
+
+    sockaddr_in target = {};
+    target.sin_family = AF_INET;
+    target.sin_port = htons(config.port);
+    if (inet_pton(AF_INET, config.host.c_str(), &target.sin_addr) != 1) return false;
+
+#if defined(_WIN32)
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) return false;
+    SOCKET handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (handle == INVALID_SOCKET) {
+        WSACleanup();
+        return false;
+    }
+    u_long nonBlocking = 1;
+    ioctlsocket(handle, FIONBIO, &nonBlocking);
+    socketHandle = static_cast<intptr_t>(handle);
+#else
+    int handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (handle < 0) return false;
+    fcntl(handle, F_SETFL, fcntl(handle, F_GETFL, 0) | O_NONBLOCK);
+    socketHandle = handle;
+#endif
+
+    std::memcpy(address.data(), &target, sizeof(target));
+    exportConfig = config;
+    exportConfig.maxPacketBytes = std::max<size_t>(config.maxPacketBytes, 64);
+    stopRequested = false;
+    exporting.store(true, std::memory_order_relaxed);
+    exportThread = std::thread(&Telemetry::exportLoop, this);
+    return true;
+}
+
+void Telemetry::stopExport() {
+    if (!exportThread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(exportMutex);
+        stopRequested = true;
+    }
+    exportWake.notify_all();
+    exportThread.join();
+    closeSocket();
+    exporting.store(false, std::memory_order_relaxed);
+}
+
+void Telemetry::closeSocket() {
+    if (socketHandle < 0) return;
+#if defined(_WIN32)
+    closesocket(static_cast<SOCKET>(socketHandle));
+    WSACleanup();
+#else
+    ::close(static_cast<int>(socketHandle));
+#endif
+    socketHandle = -1;
+}
+
+void Telemetry::exportLoop() {
+    auto interval = std::chrono::duration<float>(std::max(exportConfig.intervalSeconds, 0.05f));
+    std::vector<TelemetrySample> samples;
+    std::string packet;
+    packet.reserve(exportConfig.maxPacketBytes);
+
+    std::unique_lock<std::mutex> lock(exportMutex);
+    while (!stopRequested) {
+        exportWake.wait_for(lock, interval, [this] { return stopRequested; });
+        lock.unlock();
+        flush(samples, packet);     // Also on stop, so the last interval is not lost
+        lock.lock();
+    }
+}
+
+void Telemetry::flush(std::vector<TelemetrySample>& samples, std::string& packet) {
+    snapshot(samples, true);
+    packet.clear();
+    char line[192];
+    for (const TelemetrySample& sample : samples) {
+        const char* format = sample.kind == CounterKind::Count ? "%s%s:%.0f%s\n" : "%s%s:%.6g%s\n";
+        int length = std::snprintf(line, sizeof(line), format, exportConfig.prefix.c_str(),
+                                   sample.name.c_str(), sample.value, kindSuffix(sample.kind));
+        if (length <= 0 || static_cast<size_t>(length) >= sizeof(line)) continue;
+        // Lines never straddle datagrams
+        if (!packet.empty() && packet.size() + length > exportConfig.maxPacketBytes) {
+            send(packet);
+            packet.clear();
+        }
+        packet.append(line, static_cast<size_t>(length));
+    }
+    if (!packet.empty()) send(packet);
+}
+
+void Telemetry::send(const std::string& packet) {
+    // statsd lines are newline-separated; the trailing one is dropped
+    size_t size = packet.size() - (packet.back() == '\n' ? 1 : 0);
+    sockaddr_in storage;
+    std::memcpy(&storage, address.data(), sizeof(storage));
+    const sockaddr* target = reinterpret_cast<const sockaddr*>(&storage);
+#if defined(_WIN32)
+    int sent = sendto(static_cast<SOCKET>(socketHandle), packet.data(), static_cast<int>(size), 0,
+                      target, sizeof(sockaddr_in));
+    bool ok = sent != SOCKET_ERROR;
+#else
+    ssize_t sent = sendto(static_cast<int>(socketHandle), packet.data(), size, MSG_DONTWAIT,
+                          target, sizeof(sockaddr_in));
+    bool ok = sent >= 0;
+#endif
+    if (ok) packetsSent.fetch_add(1, std::memory_order_relaxed);
+    else packetsDropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace ethereal
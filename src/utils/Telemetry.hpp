@@ -0,0 +1,119 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ethereal {
+
+enum class CounterKind : uint8_t {
+    Count,      // Summed, reset each export (statsd "c")
+    Gauge,      // Last value set (statsd "g")
+    Peak        // Largest value since the last export, reset each export (statsd "g")
+};
+
+struct TelemetryConfig {
+    std::string host = "127.0.0.1";     // Numeric IPv4 address of the statsd agent
+    uint16_t port = 8125;
+    std::string prefix = "loom.";
+    float intervalSeconds = 1.0f;
+    size_t maxPacketBytes = 1432;       // Fits an Ethernet MTU after IP/UDP headers
+};
+
+struct TelemetrySample {
+    std::string name;
+    CounterKind kind = CounterKind::Count;
+    double value = 0.0;
+};
+
+// Process-wide registry of named counters. Publishing is one relaxed atomic
+// operation on a fixed slot, safe from any thread (workers, the audio callback);
+// only the first registration of a name takes a lock. An optional background
+// thread drains the registry into statsd datagrams over a non-blocking UDP
+// socket; a full socket drops the packet rather than wait.
+class Telemetry {
+public:
+    static Telemetry& instance();
+
+    static constexpr size_t kMaxCounters = 128;
+
+    // Same handle for the same name; -1 once the registry is full
+    int registerCounter(const char* name, CounterKind kind);
+
+    void add(int counter, int64_t delta) {
+        if (counter >= 0) slots[counter].bits.fetch_add(delta, std::memory_order_relaxed);
+    }
+    void set(int counter, double value) {
+        if (counter >= 0) slots[counter].bits.store(toBits(value), std::memory_order_relaxed);
+    }
+    void peak(int counter, double value);
+
+    // Current values; `reset` clears counts and peaks as an export does
+    void snapshot(std::vector<TelemetrySample>& out, bool reset = false);
+
+    bool startExport(const TelemetryConfig& config);
+    void stopExport();
+    bool isExporting() const { return exporting.load(std::memory_order_relaxed); }
+    uint64_t getPacketsSent() const { return packetsSent.load(std::memory_order_relaxed); }
+    uint64_t getPacketsDropped() const { return packetsDropped.load(std::memory_order_relaxed); }
+
+    ~Telemetry();
+
+private:
+    Telemetry() = default;
+    Telemetry(const Telemetry&) = delete;
+    Telemetry& operator=(const Telemetry&) = delete;
+
+    struct Slot {
+        std::atomic<int64_t> bits{0};   // Integer for counts, double bits for gauges and peaks
+        CounterKind kind = CounterKind::Count;
+        std::string name;
+    };
+
+    std::array<Slot, kMaxCounters> slots;
+    std::atomic<size_t> slotCount{0};
+    std::mutex registerMutex;
+
+    // === Export thread ===
+    TelemetryConfig exportConfig;
+    std::thread exportThread;
+    std::mutex exportMutex;
+    std::condition_variable exportWake;
+    bool stopRequested = false;
+    std::atomic<bool> exporting{false};
+    std::atomic<uint64_t> packetsSent{0};
+    std::atomic<uint64_t> packetsDropped{0};
+    intptr_t socketHandle = -1;
+    std::array<unsigned char, 16> address{};    // sockaddr_in, kept opaque here
+
+    void exportLoop();
+    void flush(std::vector<TelemetrySample>& samples, std::string& packet);
+    void send(const std::string& packet);
+    void closeSocket();
+
+    static int64_t toBits(double value);
+    static double fromBits(int64_t bits);
+};
+
+} // namespace ethereal
+
+// Building with -DLOOM_DISABLE_TELEMETRY compiles every counter out.
+// `name` is a string literal; the handle is looked up once per call site.
+#if !defined(LOOM_DISABLE_TELEMETRY)
+#define LOOM_TELEMETRY(name, kind, op, value) do { \
+        static const int loomCounter = ::ethereal::Telemetry::instance().registerCounter(name, kind); \
+        ::ethereal::Telemetry::instance().op(loomCounter, value); \
+    } while (0)
+#define TELEMETRY_COUNT(name, delta) LOOM_TELEMETRY(name, ::ethereal::CounterKind::Count, add, static_cast<int64_t>(delta))
+#define TELEMETRY_GAUGE(name, value) LOOM_TELEMETRY(name, ::ethereal::CounterKind::Gauge, set, static_cast<double>(value))
+#define TELEMETRY_PEAK(name, value) LOOM_TELEMETRY(name, ::ethereal::CounterKind::Peak, peak, static_cast<double>(value))
+#else
+#define TELEMETRY_COUNT(name, delta) ((void)0)
+#define TELEMETRY_GAUGE(name, value) ((void)0)
+#define TELEMETRY_PEAK(name, value) ((void)0)
+#endif
@@ -0,0 +1,41 @@
+#pragma once
+#include <array>
+#include <atomic>
+
+namespace ethereal {
+
+// Lock-free single-producer/single-consumer handoff of the latest value.
+// The producer fills the back slot and publishes it; the consumer swaps in the
+// newest published slot. Neither side ever blocks or sees a torn value, and
+// intermediate values the consumer never picked up are simply dropped.
+template <typename T>
+class TripleBuffer {
+public:
+    // === Producer side ===
+    T& back() { return slots[backIndex]; }
+
+    void publish() {
+        backIndex = middle.exchange(backIndex | kFresh, std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    // === Consumer side ===
+    // Returns true if a newer value was swapped in since the last call
+    bool acquire() {
+        if ((middle.load(std::memory_order_relaxed) & kFresh) == 0) return false;
+        frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & kIndexMask;
+        return true;
+    }
+
+    const T& front() const { return slots[frontIndex]; }
+
+private:
+    static constexpr unsigned kIndexMask = 3;
+    static constexpr unsigned kFresh = 4;
+
+    std::array<T, 3> slots{};
+    std::atomic<unsigned> middle{1};
+    unsigned backIndex = 0;     // Producer only
+    unsigned frontIndex = 2;    // Consumer only
+};
+
+} // namespace ethereal
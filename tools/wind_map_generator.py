@@ -8,12 +8,14 @@ This demonstrates a Python -> C++ pipeline workflow.
 Usage:
     python wind_map_generator.py --output ../assets/windmaps/default.wind
     python wind_map_generator.py --width 128 --height 128 --octaves 4
+    python wind_map_generator.py --layers 8 --keyframes 12 --format-version 2
 """
 
 import argparse
 import struct
 import math
 import random
+import zlib
 from dataclasses import dataclass
 from pathlib import Path
 from typing import List, Tuple
@@ -30,6 +32,13 @@ class WindMapConfig:
     seed: int = 42
     base_strength: float = 50.0
     gust_strength: float = 80.0
+    # v2 only
+    layers: int = 1
+    keyframes: int = 1
+    cell_size: float = 16.0
+    layer_height: float = 32.0
+    keyframe_interval: float = 4.0
+    wrap: bool = False
 
 
 class PerlinNoise:
@@ -114,6 +123,73 @@ def generate_wind_map(config: WindMapConfig) -> List[Tuple[float, float]]:
     return wind_data
 
 
+def generate_wind_volume(config: WindMapConfig) -> List[Tuple[float, float, float]]:
+    """Generate keyframes x layers x height x width 3D wind vectors (x fastest)."""
+    noise = PerlinNoise(config.seed)
+    wind_data = []
+    
+    for k in range(config.keyframes):
+        # Keyframes drift through the noise field so consecutive frames blend smoothly
+        drift = k * 0.35
+        for layer in range(config.layers):
+            # Wind picks up with altitude
+            altitude_gain = 1.0 + layer * 0.15
+            lz = layer * 3.7
+            for y in range(config.height):
+                for x in range(config.width):
+                    nx = x * config.scale + drift
+                    ny = y * config.scale + lz
+                    
+                    wind_x = noise.octave_noise(nx, ny, config.octaves, config.persistence)
+                    wind_z = noise.octave_noise(nx + 100, ny + 100, config.octaves, config.persistence)
+                    wind_y = noise.octave_noise(nx + 200, ny + 200, config.octaves, config.persistence)
+                    
+                    wind_x = (wind_x * config.gust_strength + config.base_strength) * altitude_gain
+                    wind_z = wind_z * config.gust_strength * 0.3 * altitude_gain
+                    wind_y = wind_y * config.gust_strength * 0.1
+                    
+                    wind_data.append((wind_x, wind_y, wind_z))
+    
+    return wind_data
+
+
+def save_wind_map_v2(wind_data: List[Tuple[float, float, float]], config: WindMapConfig, filepath: Path):
+    """
+    Save a 3D, keyframed wind map (read by src/physics/WindMap.cpp).
+    
+    Format (little-endian):
+    - Header (64 bytes):
+        - Magic number: 4 bytes ("WIND")
+        - Version: uint32 (2)
+        - Width, height (z), layers (y), keyframes: uint32 each
+        - Components per vector: uint32 (3)
+        - Flags: uint32 (bit 0 = wrap horizontally)
+        - Origin x, y, z: float32 each (world position of cell 0)
+        - Cell size, layer height, keyframe interval (seconds): float32 each
+        - CRC-32 of the data block: uint32
+        - Reserved: uint32
+    - Data: keyframes x layers x height x width x (wind_x, wind_y, wind_z) float32
+    """
+    filepath.parent.mkdir(parents=True, exist_ok=True)
+    
+    payload = b''.join(struct.pack('<fff', *w) for w in wind_data)
+    origin_x = -(config.width - 1) * config.cell_size * 0.5
+    origin_z = -(config.height - 1) * config.cell_size * 0.5
+    
+    with open(filepath, 'wb') as f:
+        f.write(b'WIND')
+        f.write(struct.pack('<IIIIIII', 2, config.width, config.height, config.layers,
+                            config.keyframes, 3, 1 if config.wrap else 0))
+        f.write(struct.pack('<ffffff', origin_x, 0.0, origin_z, config.cell_size,
+                            config.layer_height, config.keyframe_interval))
+        f.write(struct.pack('<II', zlib.crc32(payload) & 0xffffffff, 0))
+        f.write(payload)
+    
+    print(f"Wind map saved: {filepath}")
+    print(f"  Size: {config.width}x{config.height}x{config.layers}, {config.keyframes} keyframes")
+    print(f"  Data size: {len(payload)} bytes")
+
+
 def save_wind_map(wind_data: List[Tuple[float, float]], config: WindMapConfig, filepath: Path):
     """
     Save wind map to binary file format.
@@ -219,6 +295,14 @@ Examples:
     parser.add_argument('--seed', type=int, default=42, help='Random seed')
     parser.add_argument('--base-strength', type=float, default=50.0, help='Base wind strength')
     parser.add_argument('--gust-strength', type=float, default=80.0, help='Gust strength')
+    parser.add_argument('--format-version', type=int, choices=[1, 2], default=1,
+                       help='1 = 2D slice, 2 = 3D layers with keyframes and checksum')
+    parser.add_argument('--layers', type=int, default=1, help='Vertical layers (v2)')
+    parser.add_argument('--keyframes', type=int, default=1, help='Time keyframes (v2)')
+    parser.add_argument('--cell-size', type=float, default=16.0, help='World units between cells (v2)')
+    parser.add_argument('--layer-height', type=float, default=32.0, help='World units between layers (v2)')
+    parser.add_argument('--keyframe-interval', type=float, default=4.0, help='Seconds between keyframes (v2)')
+    parser.add_argument('--wrap', action='store_true', help='Tile the map horizontally (v2)')
     parser.add_argument('--json', action='store_true', help='Also output JSON file')
     parser.add_argument('--visualize', '-v', action='store_true', help='Generate ASCII visualization')
     
@@ -232,15 +316,26 @@ Examples:
         scale=args.scale,
         seed=args.seed,
         base_strength=args.base_strength,
-        gust_strength=args.gust_strength
+        gust_strength=args.gust_strength,
+        layers=args.layers,
+        keyframes=args.keyframes,
+        cell_size=args.cell_size,
+        layer_height=args.layer_height,
+        keyframe_interval=args.keyframe_interval,
+        wrap=args.wrap
     )
     
     print("Generating wind map...")
     print(f"  Config: {config.width}x{config.height}, {config.octaves} octaves, seed={config.seed}")
     
-    wind_data = generate_wind_map(config)
-    
     output_path = Path(args.output)
+    
+    if args.format_version == 2:
+        save_wind_map_v2(generate_wind_volume(config), config, output_path)
+        print("\nDone! Wind map ready for use in Ethereal Flight Demo.")
+        return
+    
+    wind_data = generate_wind_map(config)
     save_wind_map(wind_data, config, output_path)
     
     if args.json: